@@ -0,0 +1,354 @@
+// MIT License
+//
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+// Google Benchmark
+#include "benchmark/benchmark.h"
+// CmdParser
+#include "cmdparser.hpp"
+#include "benchmark_utils.hpp"
+
+// HIP API
+#include <hip/hip_runtime.h>
+#include <hip/hip_hcc.h>
+
+// rocPRIM
+#include <rocprim/rocprim.hpp>
+
+#define HIP_CHECK(condition)         \
+  {                                  \
+    hipError_t error = condition;    \
+    if(error != hipSuccess){         \
+        std::cout << "HIP error: " << error << " line: " << __LINE__ << std::endl; \
+        exit(error); \
+    } \
+  }
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 32;
+#endif
+
+namespace rp = rocprim;
+
+const unsigned int batch_size = 10;
+const unsigned int warmup_size = 5;
+
+// Keys with duplicates, custom_type keys are compared by both members
+template<class Key>
+auto generate_keys(size_t size)
+    -> typename std::enable_if<!is_custom_type<Key>::value, std::vector<Key>>::type
+{
+    return get_random_data<Key>(size, Key(-1000), Key(1000));
+}
+
+template<class Key>
+auto generate_keys(size_t size)
+    -> typename std::enable_if<is_custom_type<Key>::value, std::vector<Key>>::type
+{
+    using first_type = typename Key::first_type;
+    using second_type = typename Key::second_type;
+    return get_random_data<Key>(
+        size,
+        Key(first_type(-1000), second_type(-1000)),
+        Key(first_type(1000), second_type(1000))
+    );
+}
+
+template<class Key>
+void run_sort_keys_benchmark(benchmark::State& state, hipStream_t stream, size_t size)
+{
+    using key_type = Key;
+
+    // Generate data
+    std::vector<key_type> keys_input = generate_keys<key_type>(size);
+
+    key_type * d_keys_input;
+    key_type * d_keys_output;
+    HIP_CHECK(hipMalloc(&d_keys_input, size * sizeof(key_type)));
+    HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(key_type)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_keys_input, keys_input.data(),
+            size * sizeof(key_type),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    void * d_temporary_storage = nullptr;
+    size_t temporary_storage_bytes = 0;
+    HIP_CHECK(
+        rp::merge_sort(
+            d_temporary_storage, temporary_storage_bytes,
+            d_keys_input, d_keys_output, size,
+            rp::less<key_type>(),
+            stream, false
+        )
+    );
+
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Warm-up
+    for(size_t i = 0; i < warmup_size; i++)
+    {
+        HIP_CHECK(
+            rp::merge_sort(
+                d_temporary_storage, temporary_storage_bytes,
+                d_keys_input, d_keys_output, size,
+                rp::less<key_type>(),
+                stream, false
+            )
+        );
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    for (auto _ : state)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(
+                rp::merge_sort(
+                    d_temporary_storage, temporary_storage_bytes,
+                    d_keys_input, d_keys_output, size,
+                    rp::less<key_type>(),
+                    stream, false
+                )
+            );
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+    state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(key_type));
+    state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_keys_input));
+    HIP_CHECK(hipFree(d_keys_output));
+}
+
+template<class Key, class Value>
+void run_sort_pairs_benchmark(benchmark::State& state, hipStream_t stream, size_t size)
+{
+    using key_type = Key;
+    using value_type = Value;
+
+    // Generate data
+    std::vector<key_type> keys_input = generate_keys<key_type>(size);
+
+    std::vector<value_type> values_input(size);
+
+    key_type * d_keys_input;
+    key_type * d_keys_output;
+    HIP_CHECK(hipMalloc(&d_keys_input, size * sizeof(key_type)));
+    HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(key_type)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_keys_input, keys_input.data(),
+            size * sizeof(key_type),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    value_type * d_values_input;
+    value_type * d_values_output;
+    HIP_CHECK(hipMalloc(&d_values_input, size * sizeof(value_type)));
+    HIP_CHECK(hipMalloc(&d_values_output, size * sizeof(value_type)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_values_input, values_input.data(),
+            size * sizeof(value_type),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    void * d_temporary_storage = nullptr;
+    size_t temporary_storage_bytes = 0;
+    HIP_CHECK(
+        rp::merge_sort(
+            d_temporary_storage, temporary_storage_bytes,
+            d_keys_input, d_keys_output, d_values_input, d_values_output, size,
+            rp::less<key_type>(),
+            stream, false
+        )
+    );
+
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Warm-up
+    for(size_t i = 0; i < warmup_size; i++)
+    {
+        HIP_CHECK(
+            rp::merge_sort(
+                d_temporary_storage, temporary_storage_bytes,
+                d_keys_input, d_keys_output, d_values_input, d_values_output, size,
+                rp::less<key_type>(),
+                stream, false
+            )
+        );
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    for (auto _ : state)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(
+                rp::merge_sort(
+                    d_temporary_storage, temporary_storage_bytes,
+                    d_keys_input, d_keys_output, d_values_input, d_values_output, size,
+                    rp::less<key_type>(),
+                    stream, false
+                )
+            );
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+    state.SetBytesProcessed(
+        state.iterations() * batch_size * size * (sizeof(key_type) + sizeof(value_type))
+    );
+    state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_keys_input));
+    HIP_CHECK(hipFree(d_keys_output));
+    HIP_CHECK(hipFree(d_values_input));
+    HIP_CHECK(hipFree(d_values_output));
+}
+
+#define CREATE_SORT_KEYS_BENCHMARK(Key) \
+benchmark::RegisterBenchmark( \
+    (std::string("sort_keys") + "<" #Key ">").c_str(), \
+    [=](benchmark::State& state) { run_sort_keys_benchmark<Key>(state, stream, size); } \
+)
+
+void add_sort_keys_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmarks,
+                              hipStream_t stream,
+                              size_t size)
+{
+    using custom_float2 = custom_type<float, float>;
+    using custom_double2 = custom_type<double, double>;
+
+    std::vector<benchmark::internal::Benchmark*> bs =
+    {
+        CREATE_SORT_KEYS_BENCHMARK(int),
+        CREATE_SORT_KEYS_BENCHMARK(long long),
+        CREATE_SORT_KEYS_BENCHMARK(float),
+        CREATE_SORT_KEYS_BENCHMARK(double),
+
+        CREATE_SORT_KEYS_BENCHMARK(custom_float2),
+        CREATE_SORT_KEYS_BENCHMARK(custom_double2),
+    };
+    benchmarks.insert(benchmarks.end(), bs.begin(), bs.end());
+}
+
+#define CREATE_SORT_PAIRS_BENCHMARK(Key, Value) \
+benchmark::RegisterBenchmark( \
+    (std::string("sort_pairs") + "<" #Key ", " #Value ">").c_str(), \
+    [=](benchmark::State& state) { run_sort_pairs_benchmark<Key, Value>(state, stream, size); } \
+)
+
+void add_sort_pairs_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmarks,
+                               hipStream_t stream,
+                               size_t size)
+{
+    using custom_float2 = custom_type<float, float>;
+    using custom_double2 = custom_type<double, double>;
+
+    std::vector<benchmark::internal::Benchmark*> bs =
+    {
+        CREATE_SORT_PAIRS_BENCHMARK(int, float),
+        CREATE_SORT_PAIRS_BENCHMARK(long long, double),
+
+        CREATE_SORT_PAIRS_BENCHMARK(int, custom_float2),
+        CREATE_SORT_PAIRS_BENCHMARK(long long, custom_double2),
+
+        CREATE_SORT_PAIRS_BENCHMARK(custom_float2, int),
+        CREATE_SORT_PAIRS_BENCHMARK(custom_double2, long long),
+    };
+    benchmarks.insert(benchmarks.end(), bs.begin(), bs.end());
+}
+
+int main(int argc, char *argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size = parser.get<size_t>("size");
+    const int trials = parser.get<int>("trials");
+
+    // HIP
+    hipStream_t stream = 0; // default
+    hipDeviceProp_t devProp;
+    int device_id = 0;
+    HIP_CHECK(hipGetDevice(&device_id));
+    HIP_CHECK(hipGetDeviceProperties(&devProp, device_id));
+    std::cout << "[HIP] Device name: " << devProp.name << std::endl;
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks;
+    add_sort_keys_benchmarks(benchmarks, stream, size);
+    add_sort_pairs_benchmarks(benchmarks, stream, size);
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
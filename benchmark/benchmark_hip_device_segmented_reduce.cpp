@@ -26,6 +26,10 @@
 #include <locale>
 #include <string>
 #include <limits>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <numeric>
 
 // Google Benchmark
 #include "benchmark/benchmark.h"
@@ -58,13 +62,11 @@ namespace rp = rocprim;
 const unsigned int batch_size = 10;
 const unsigned int warmup_size = 5;
 
-template<class T>
-void run_benchmark(benchmark::State& state, size_t desired_segments, hipStream_t stream, size_t size)
-{
-    using offset_type = int;
-    using value_type = T;
+using offset_type = int;
 
-    // Generate data
+// Segment lengths are uniformly distributed in [0, 2 * average length]
+std::vector<offset_type> get_uniform_offsets(size_t desired_segments, size_t size)
+{
     const unsigned int seed = 123;
     std::default_random_engine gen(seed);
 
@@ -72,16 +74,47 @@ void run_benchmark(benchmark::State& state, size_t desired_segments, hipStream_t
     std::uniform_real_distribution<double> segment_length_dis(0, avg_segment_length * 2);
 
     std::vector<offset_type> offsets;
-    unsigned int segments_count = 0;
     size_t offset = 0;
     while(offset < size)
     {
         const size_t segment_length = std::round(segment_length_dis(gen));
         offsets.push_back(offset);
-        segments_count++;
         offset += segment_length;
     }
     offsets.push_back(size);
+    return offsets;
+}
+
+// Segment lengths follow a power law (Pareto distribution with the minimum 1 shifted to 0):
+// most segments are empty or very short, few are huge. Smaller alpha gives a heavier tail.
+std::vector<offset_type> get_power_law_offsets(double alpha, size_t size)
+{
+    const unsigned int seed = 123;
+    std::default_random_engine gen(seed);
+    std::uniform_real_distribution<double> dis(0.0, 1.0);
+
+    std::vector<offset_type> offsets;
+    size_t offset = 0;
+    while(offset < size)
+    {
+        const double length = std::pow(1.0 - dis(gen), -1.0 / alpha) - 1.0;
+        const size_t segment_length = static_cast<size_t>(std::min(length, static_cast<double>(size)));
+        offsets.push_back(offset);
+        offset += segment_length;
+    }
+    offsets.push_back(size);
+    return offsets;
+}
+
+template<class T, class Config>
+void run_benchmark(benchmark::State& state,
+                   const std::vector<offset_type>& offsets,
+                   hipStream_t stream,
+                   size_t size)
+{
+    using value_type = T;
+
+    const unsigned int segments_count = offsets.size() - 1;
 
     std::vector<value_type> values_input(size);
     std::iota(values_input.begin(), values_input.end(), 0);
@@ -116,7 +149,7 @@ void run_benchmark(benchmark::State& state, size_t desired_segments, hipStream_t
     size_t temporary_storage_bytes = 0;
 
     HIP_CHECK(
-        rp::segmented_reduce(
+        rp::segmented_reduce<Config>(
             d_temporary_storage, temporary_storage_bytes,
             d_values_input, d_aggregates_output,
             segments_count,
@@ -133,7 +166,7 @@ void run_benchmark(benchmark::State& state, size_t desired_segments, hipStream_t
     for(size_t i = 0; i < warmup_size; i++)
     {
         HIP_CHECK(
-            rp::segmented_reduce(
+            rp::segmented_reduce<Config>(
                 d_temporary_storage, temporary_storage_bytes,
                 d_values_input, d_aggregates_output,
                 segments_count,
@@ -152,7 +185,7 @@ void run_benchmark(benchmark::State& state, size_t desired_segments, hipStream_t
         for(size_t i = 0; i < batch_size; i++)
         {
             HIP_CHECK(
-                rp::segmented_reduce(
+                rp::segmented_reduce<Config>(
                     d_temporary_storage, temporary_storage_bytes,
                     d_values_input, d_aggregates_output,
                     segments_count,
@@ -178,13 +211,25 @@ void run_benchmark(benchmark::State& state, size_t desired_segments, hipStream_t
     HIP_CHECK(hipFree(d_aggregates_output));
 }
 
+// Load-balanced mode
+using balanced_config = rp::segmented_reduce_config<256, 8>;
+
 #define CREATE_BENCHMARK(T, SEGMENTS) \
 benchmark::RegisterBenchmark( \
     (std::string("segmented_reduce") + "<" #T ">" + \
         "(~" + std::to_string(SEGMENTS) + " segments)" \
     ).c_str(), \
-    run_benchmark<T>, \
-    SEGMENTS, stream, size \
+    [=](benchmark::State& state) \
+    { run_benchmark<T, rp::default_config>(state, get_uniform_offsets(SEGMENTS, size), stream, size); } \
+)
+
+#define CREATE_POWER_LAW_BENCHMARK(T, CONFIG, ALPHA) \
+benchmark::RegisterBenchmark( \
+    (std::string("segmented_reduce") + "<" #T ", " #CONFIG ">" + \
+        "(power law, alpha = " #ALPHA ")" \
+    ).c_str(), \
+    [=](benchmark::State& state) \
+    { run_benchmark<T, CONFIG>(state, get_power_law_offsets(ALPHA, size), stream, size); } \
 )
 
 void add_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmarks,
@@ -223,6 +268,24 @@ void add_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmarks,
         CREATE_BENCHMARK(custom_double2, 1000),
         CREATE_BENCHMARK(custom_double2, 10000),
         CREATE_BENCHMARK(custom_double2, 100000),
+
+        CREATE_POWER_LAW_BENCHMARK(float, rp::default_config, 0.5),
+        CREATE_POWER_LAW_BENCHMARK(float, balanced_config, 0.5),
+        CREATE_POWER_LAW_BENCHMARK(float, rp::default_config, 1.0),
+        CREATE_POWER_LAW_BENCHMARK(float, balanced_config, 1.0),
+        CREATE_POWER_LAW_BENCHMARK(float, rp::default_config, 1.5),
+        CREATE_POWER_LAW_BENCHMARK(float, balanced_config, 1.5),
+        CREATE_POWER_LAW_BENCHMARK(float, rp::default_config, 2.0),
+        CREATE_POWER_LAW_BENCHMARK(float, balanced_config, 2.0),
+
+        CREATE_POWER_LAW_BENCHMARK(double, rp::default_config, 0.5),
+        CREATE_POWER_LAW_BENCHMARK(double, balanced_config, 0.5),
+        CREATE_POWER_LAW_BENCHMARK(double, rp::default_config, 1.0),
+        CREATE_POWER_LAW_BENCHMARK(double, balanced_config, 1.0),
+        CREATE_POWER_LAW_BENCHMARK(double, rp::default_config, 1.5),
+        CREATE_POWER_LAW_BENCHMARK(double, balanced_config, 1.5),
+        CREATE_POWER_LAW_BENCHMARK(double, rp::default_config, 2.0),
+        CREATE_POWER_LAW_BENCHMARK(double, balanced_config, 2.0),
     };
 
     benchmarks.insert(benchmarks.end(), bs.begin(), bs.end());
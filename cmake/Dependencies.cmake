@@ -29,7 +29,9 @@ if (NOT Git_FOUND)
 endif()
 
 # HIP and nvcc configuration
-find_package(HIP REQUIRED)
+if(NOT ROCPRIM_CPU_ONLY)
+  find_package(HIP REQUIRED)
+endif()
 if(HIP_PLATFORM STREQUAL "nvcc")
   include(cmake/NVCC.cmake)
 elseif(HIP_PLATFORM STREQUAL "hcc")
@@ -42,6 +44,9 @@ elseif(HIP_PLATFORM STREQUAL "hcc")
   find_package(hip REQUIRED CONFIG PATHS /opt/rocm)
 endif()
 
+# Threads for CPU backend
+find_package(Threads REQUIRED)
+
 # For downloading, building, and installing required dependencies
 include(cmake/DownloadProject.cmake)
 
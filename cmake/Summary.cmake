@@ -31,6 +31,7 @@ function(print_configuration_summary)
   message(STATUS "  Build type            : ${CMAKE_BUILD_TYPE}")
   message(STATUS "  Install prefix        : ${CMAKE_INSTALL_PREFIX}")
   message(STATUS "")
+  message(STATUS "  ROCPRIM_CPU_ONLY      : ${ROCPRIM_CPU_ONLY}")
   message(STATUS "  BUILD_TEST            : ${BUILD_TEST}")
   message(STATUS "  BUILD_BENCHMARK       : ${BUILD_BENCHMARK}")
   message(STATUS "  BUILD_EXAMPLE         : ${BUILD_EXAMPLE}")
@@ -35,6 +35,7 @@ END_HIPCUB_NAMESPACE
 // Device functions must be wrapped so they return
 // hipError_t instead of cudaError_t
 #include "device/device_histogram.hpp"
+#include "device/device_partition.hpp"
 #include "device/device_radix_sort.hpp"
 #include "device/device_reduce.hpp"
 #include "device/device_run_length_encode.hpp"
@@ -49,6 +49,7 @@
 
 // Device
 #include "device/device_histogram.hpp"
+#include "device/device_partition.hpp"
 #include "device/device_radix_sort.hpp"
 #include "device/device_reduce.hpp"
 #include "device/device_run_length_encode.hpp"
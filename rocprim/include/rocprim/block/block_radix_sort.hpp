@@ -26,7 +26,7 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 #include "../detail/radix_sort.hpp"
-#include "../warp/detail/warp_scan_shuffle.hpp"
+#include "../warp/warp_scan.hpp"
 
 #include "../intrinsics.hpp"
 #include "../functional.hpp"
@@ -135,9 +135,9 @@ class block_bit_plus_scan
 
     // typedef of warp_scan primitive that will be used to get prefix values for
     // each warp (scanned carry-outs from warps before it)
-    // warp_scan_shuffle is an implementation of warp_scan that does not need storage,
+    // warp_scan_crosslane is an implementation of warp_scan that does not need storage,
     // but requires logical warp size to be a power of two.
-    using warp_scan_prefix_type = ::rocprim::detail::warp_scan_shuffle<T, detail::next_power_of_two(warps_no)>;
+    using warp_scan_prefix_type = ::rocprim::detail::warp_scan_crosslane<T, detail::next_power_of_two(warps_no)>;
 
 public:
 
@@ -145,7 +145,7 @@ public:
     {
         T warp_prefixes[warps_no];
         // ---------- Shared memory optimisation ----------
-        // Since we use warp_scan_shuffle for warp scan, we don't need to allocate
+        // Since we use warp_scan_crosslane for warp scan, we don't need to allocate
         // any temporary memory for it.
     };
 
@@ -224,7 +224,7 @@ public:
 ///
 /// \par Overview
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
-/// type).
+/// type) or a type with a specialization of \ref rocprim::radix_key_decomposer.
 /// * Performance depends on \p BlockSize, \p ItemsPerThread and \p RadixBits.
 ///   * It is usually better of \p BlockSize is a multiple of the size of the hardware warp.
 ///   * It is usually increased when \p ItemsPerThread is greater than one. However, when there
@@ -1178,6 +1178,10 @@ private:
 
         const unsigned int flat_id = ::rocprim::flat_block_thread_id();
 
+        // Bits above key_bits (e.g. padding of decomposed keys) are equal in all keys
+        constexpr unsigned int key_bits = key_codec::key_bits;
+        end_bit = ::rocprim::min(end_bit, key_bits);
+
         bit_key_type bit_keys[ItemsPerThread];
         for(unsigned int i = 0; i < ItemsPerThread; i++)
         {
@@ -36,6 +36,19 @@
 
 BEGIN_ROCPRIM_NAMESPACE
 
+namespace detail
+{
+
+// Output iterators with void value_type (e.g. transform_output_iterator) can be
+// assigned any value their dereferenced proxy accepts
+template<class T, class OutputValue>
+struct is_output_assignable : std::is_convertible<T, OutputValue> { };
+
+template<class T>
+struct is_output_assignable<T, void> : std::true_type { };
+
+} // end namespace detail
+
 /// \brief \p block_store_method enumerates the methods available to store a striped arrangement
 /// of items into a blocked/striped arrangement on continuous memory
 enum class block_store_method
@@ -177,7 +190,7 @@ public:
                T (&items)[ItemsPerThread])
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         const unsigned int flat_id = ::rocprim::flat_block_thread_id();
@@ -204,7 +217,7 @@ public:
                unsigned int valid)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         const unsigned int flat_id = ::rocprim::flat_block_thread_id();
@@ -252,7 +265,7 @@ public:
                storage_type& storage)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         (void) storage;
@@ -303,7 +316,7 @@ public:
                storage_type& storage)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         (void) storage;
@@ -347,7 +360,7 @@ public:
                U (&items)[ItemsPerThread])
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         const unsigned int flat_id = ::rocprim::flat_block_thread_id();
@@ -361,7 +374,7 @@ public:
                unsigned int valid)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         const unsigned int flat_id = ::rocprim::flat_block_thread_id();
@@ -384,7 +397,7 @@ public:
                storage_type& storage)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         (void) storage;
@@ -399,7 +412,7 @@ public:
                storage_type& storage)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         (void) storage;
@@ -426,7 +439,7 @@ public:
                T (&items)[ItemsPerThread])
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         ROCPRIM_SHARED_MEMORY storage_type storage;
@@ -442,7 +455,7 @@ public:
                unsigned int valid)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         ROCPRIM_SHARED_MEMORY storage_type storage;
@@ -458,7 +471,7 @@ public:
                storage_type& storage)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         const unsigned int flat_id = ::rocprim::flat_block_thread_id();
@@ -474,7 +487,7 @@ public:
                storage_type& storage)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         const unsigned int flat_id = ::rocprim::flat_block_thread_id();
@@ -505,7 +518,7 @@ public:
                T (&items)[ItemsPerThread])
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         ROCPRIM_SHARED_MEMORY storage_type storage;
@@ -521,7 +534,7 @@ public:
                unsigned int valid)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         ROCPRIM_SHARED_MEMORY storage_type storage;
@@ -537,7 +550,7 @@ public:
                storage_type& storage)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         const unsigned int flat_id = ::rocprim::flat_block_thread_id();
@@ -553,7 +566,7 @@ public:
                storage_type& storage)
     {
         using value_type = typename std::iterator_traits<OutputIterator>::value_type;
-        static_assert(std::is_convertible<T, value_type>::value,
+        static_assert(detail::is_output_assignable<T, value_type>::value,
                       "The type T must be such that an object of type OutputIterator "
                       "can be dereferenced and assigned a value of type T.");
         const unsigned int flat_id = ::rocprim::flat_block_thread_id();
@@ -46,11 +46,11 @@ class block_scan_reduce_then_scan
     static constexpr unsigned int thread_reduction_size_ =
         (BlockSize + ::rocprim::warp_size() - 1)/ ::rocprim::warp_size();
 
-    // Warp scan, warp_scan_shuffle does not require shared memory (storage), but
+    // Warp scan, warp_scan_crosslane does not require shared memory (storage), but
     // logical warp size must be a power of two.
     static constexpr unsigned int warp_size_ =
         detail::get_min_warp_size(BlockSize, ::rocprim::warp_size());
-    using warp_scan_prefix_type = ::rocprim::detail::warp_scan_shuffle<T, warp_size_>;
+    using warp_scan_prefix_type = ::rocprim::detail::warp_scan_crosslane<T, warp_size_>;
 
     // Minimize LDS bank conflicts
     static constexpr unsigned int banks_no_ = ::rocprim::detail::get_lds_banks_no();
@@ -27,7 +27,9 @@
 #define END_ROCPRIM_NAMESPACE \
     } /* rocprim */
 
-#if defined(__HCC_HC__) && !defined(ROCPRIM_HIP_API)
+#if defined(ROCPRIM_CPU_API)
+    // Host-only backend, HIP and HC are not used
+#elif defined(__HCC_HC__) && !defined(ROCPRIM_HIP_API)
     #ifndef ROCPRIM_HC_API
         #define ROCPRIM_HC_API
     #endif
@@ -37,7 +39,18 @@
     #endif
 #endif
 
-#if defined(ROCPRIM_HC_API)
+#if defined(ROCPRIM_CPU_API)
+    // Device-level primitives are executed by a pool of host threads,
+    // warp-level and block-level primitives are not available
+    #include <cstddef>
+
+    #ifndef ROCPRIM_DEVICE
+        #define ROCPRIM_DEVICE
+        #define ROCPRIM_HOST
+        #define ROCPRIM_HOST_DEVICE
+        #define ROCPRIM_SHARED_MEMORY
+    #endif
+#elif defined(ROCPRIM_HC_API)
     #include <hcc/hc.hpp>
     #include <hcc/hc_short_vector.hpp>
 
@@ -61,7 +74,22 @@
     #define ROCPRIM_HOST
     #define ROCPRIM_HOST_DEVICE
     #define ROCPRIM_SHARED_MEMORY
-    #error "HIP and HC APIs are not available"
+    #error "HIP and HC APIs are not available (define ROCPRIM_CPU_API to use the CPU backend)"
+#endif
+
+// Warp-level primitives use DPP (data parallel primitives) instructions of
+// gfx8 and gfx9 for 32-bit and 64-bit arithmetic types. rocPRIM CMake targets
+// (including the installed package) define it as 1 when all target architectures
+// support DPP; 0 forces ds_bpermute-based shuffles.
+#ifndef ROCPRIM_USE_DPP
+    #define ROCPRIM_USE_DPP 0
+#endif
+
+// Maximum number of items processed on the host by device-level primitives
+// which support host fallback, unless their config is host_fallback_config.
+// 0 disables host fallback (operators are not required to be host-callable).
+#ifndef ROCPRIM_HOST_FALLBACK_SIZE
+    #define ROCPRIM_HOST_FALLBACK_SIZE 0
 #endif
 
 #endif // ROCPRIM_CONFIG_HPP_
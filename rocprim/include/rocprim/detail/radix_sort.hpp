@@ -22,8 +22,11 @@
 #define ROCPRIM_DETAIL_RADIX_SORT_HPP_
 
 #include <type_traits>
+#include <cstring>
 
 #include "../config.hpp"
+#include "../types/radix_key_decomposer.hpp"
+#include "../types/tuple.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 namespace detail
@@ -32,46 +35,70 @@ namespace detail
 // Encode and decode integral and floating point values for radix sort in such a way that preserves
 // correct order of negative and positive keys (i.e. negative keys go before positive ones,
 // which is not true for a simple reinterpetation of the key's bits).
+// key_bits is the number of meaningful (low) bits of bit_key_type, only these bits need sorting.
+
+// Reinterprets bits of a key, memcpy avoids violation of strict aliasing rules on the host
+template<class To, class From>
+ROCPRIM_DEVICE inline
+To radix_key_bit_cast(From from)
+{
+    static_assert(sizeof(To) == sizeof(From), "Types must have the same size");
+#ifdef ROCPRIM_CPU_API
+    To to;
+    std::memcpy(&to, &from, sizeof(To));
+    return to;
+#else
+    return *reinterpret_cast<To *>(&from);
+#endif
+}
+
+// std::is_signed is false for 128-bit integers in strict standard modes
+template<class Key>
+struct radix_key_is_signed : std::integral_constant<bool, (Key(-1) < Key(0))> { };
 
 template<class Key, class BitKey, class Enable = void>
 struct radix_key_codec_integral { };
 
 template<class Key, class BitKey>
-struct radix_key_codec_integral<Key, BitKey, typename std::enable_if<std::is_unsigned<Key>::value>::type>
+struct radix_key_codec_integral<Key, BitKey, typename std::enable_if<!radix_key_is_signed<Key>::value>::type>
 {
     using bit_key_type = BitKey;
 
+    static constexpr unsigned int key_bits = 8 * sizeof(Key);
+
     ROCPRIM_DEVICE inline
     static bit_key_type encode(Key key)
     {
-        return *reinterpret_cast<bit_key_type *>(&key);
+        return radix_key_bit_cast<bit_key_type>(key);
     }
 
     ROCPRIM_DEVICE inline
     static Key decode(bit_key_type bit_key)
     {
-        return *reinterpret_cast<Key *>(&bit_key);
+        return radix_key_bit_cast<Key>(bit_key);
     }
 };
 
 template<class Key, class BitKey>
-struct radix_key_codec_integral<Key, BitKey, typename std::enable_if<std::is_signed<Key>::value>::type>
+struct radix_key_codec_integral<Key, BitKey, typename std::enable_if<radix_key_is_signed<Key>::value>::type>
 {
     using bit_key_type = BitKey;
 
+    static constexpr unsigned int key_bits = 8 * sizeof(Key);
+
     static constexpr bit_key_type sign_bit = bit_key_type(1) << (sizeof(bit_key_type) * 8 - 1);
 
     ROCPRIM_DEVICE inline
     static bit_key_type encode(Key key)
     {
-        return sign_bit ^ *reinterpret_cast<bit_key_type *>(&key);
+        return sign_bit ^ radix_key_bit_cast<bit_key_type>(key);
     }
 
     ROCPRIM_DEVICE inline
     static Key decode(bit_key_type bit_key)
     {
         bit_key ^= sign_bit;
-        return *reinterpret_cast<Key *>(&bit_key);
+        return radix_key_bit_cast<Key>(bit_key);
     }
 };
 
@@ -80,12 +107,14 @@ struct radix_key_codec_floating
 {
     using bit_key_type = BitKey;
 
+    static constexpr unsigned int key_bits = 8 * sizeof(Key);
+
     static constexpr bit_key_type sign_bit = bit_key_type(1) << (sizeof(bit_key_type) * 8 - 1);
 
     ROCPRIM_DEVICE inline
     static bit_key_type encode(Key key)
     {
-        bit_key_type bit_key = *reinterpret_cast<bit_key_type *>(&key);
+        bit_key_type bit_key = radix_key_bit_cast<bit_key_type>(key);
         bit_key ^= (sign_bit & bit_key) == 0 ? sign_bit : bit_key_type(-1);
         return bit_key;
     }
@@ -94,23 +123,161 @@ struct radix_key_codec_floating
     static Key decode(bit_key_type bit_key)
     {
         bit_key ^= (sign_bit & bit_key) == 0 ? bit_key_type(-1) : sign_bit;
-        return *reinterpret_cast<Key *>(&bit_key);
+        return radix_key_bit_cast<Key>(bit_key);
     }
 };
 
+// The smallest unsigned type that can hold Bits bits
+template<unsigned int Bits>
+struct radix_bit_key_type
+{
+#ifdef __SIZEOF_INT128__
+    static_assert(Bits <= 128, "Decomposed radix sort keys must not exceed 128 bits");
+#else
+    static_assert(Bits <= 64, "Decomposed radix sort keys must not exceed 64 bits");
+#endif
+
+    using type =
+        typename std::conditional<(Bits <= 8), unsigned char,
+        typename std::conditional<(Bits <= 16), unsigned short,
+        typename std::conditional<(Bits <= 32), unsigned int,
+#ifdef __SIZEOF_INT128__
+        typename std::conditional<(Bits <= 64), unsigned long long, unsigned __int128>::type
+#else
+        unsigned long long
+#endif
+        >::type>::type>::type;
+};
+
 template<class Key, class Enable = void>
-struct radix_key_codec_base
+struct radix_key_codec_base;
+
+// Returns the type of references to fields of Key if radix_key_decomposer<Key> is specialized,
+// otherwise tuple<> (and is_decomposable is false)
+template<class Key, class Enable = void>
+struct radix_key_fields
 {
-    static_assert(sizeof(Key) == 0,
-        "Only integral (except bool) and floating point types supported as radix sort keys");
+    static constexpr bool is_decomposable = false;
+    using type = ::rocprim::tuple<>;
 };
 
+template<class Key>
+struct radix_key_fields<
+    Key,
+    typename std::enable_if<
+        (::rocprim::tuple_size<
+            decltype(std::declval<const ::rocprim::radix_key_decomposer<Key>&>()(std::declval<Key&>()))
+        >::value > 0)
+    >::type
+>
+{
+    static constexpr bool is_decomposable = true;
+    using type = decltype(std::declval<const ::rocprim::radix_key_decomposer<Key>&>()(std::declval<Key&>()));
+};
+
+// Encodes fields [Index; tuple_size<Fields>) into the low key_bits bits of a bit key,
+// the first field goes to the most significant bits
+template<
+    class Fields,
+    size_t Index = 0,
+    size_t Size = ::rocprim::tuple_size<Fields>::value
+>
+struct radix_key_fields_codec
+{
+    using field_type = typename std::remove_reference<::rocprim::tuple_element_t<Index, Fields>>::type;
+    using field_codec = radix_key_codec_base<field_type>;
+    using next_codec = radix_key_fields_codec<Fields, Index + 1, Size>;
+
+    static constexpr unsigned int key_bits = field_codec::key_bits + next_codec::key_bits;
+
+    template<class BitKey>
+    ROCPRIM_DEVICE inline
+    static BitKey encode(const Fields& fields)
+    {
+        const BitKey field_bit_key = field_codec::encode(::rocprim::get<Index>(fields));
+        return (field_bit_key << next_codec::key_bits) | next_codec::template encode<BitKey>(fields);
+    }
+
+    template<class BitKey>
+    ROCPRIM_DEVICE inline
+    static void decode(BitKey bit_key, const Fields& fields)
+    {
+        using field_bit_key_type = typename field_codec::bit_key_type;
+        ::rocprim::get<Index>(fields) =
+            field_codec::decode(static_cast<field_bit_key_type>(bit_key >> next_codec::key_bits));
+        next_codec::decode(bit_key, fields);
+    }
+};
+
+template<class Fields, size_t Size>
+struct radix_key_fields_codec<Fields, Size, Size>
+{
+    static constexpr unsigned int key_bits = 0;
+
+    template<class BitKey>
+    ROCPRIM_DEVICE inline
+    static BitKey encode(const Fields&)
+    {
+        return BitKey(0);
+    }
+
+    template<class BitKey>
+    ROCPRIM_DEVICE inline
+    static void decode(BitKey, const Fields&)
+    {
+    }
+};
+
+// Codec of custom keys exposed as a sequence of fields by radix_key_decomposer,
+// all fields are packed into one bit key and sorted at once
+template<class Key>
+struct radix_key_codec_decomposed
+{
+    static_assert(radix_key_fields<Key>::is_decomposable,
+        "Only integral (except bool) and floating point types, and types with "
+        "a specialization of rocprim::radix_key_decomposer are supported as radix sort keys");
+
+    using decomposer_type = ::rocprim::radix_key_decomposer<Key>;
+    using fields_type = typename radix_key_fields<Key>::type;
+    using fields_codec = radix_key_fields_codec<fields_type>;
+
+    using bit_key_type = typename radix_bit_key_type<fields_codec::key_bits>::type;
+
+    static constexpr unsigned int key_bits = fields_codec::key_bits;
+
+    ROCPRIM_DEVICE inline
+    static bit_key_type encode(Key key)
+    {
+        return fields_codec::template encode<bit_key_type>(decomposer_type()(key));
+    }
+
+    ROCPRIM_DEVICE inline
+    static Key decode(bit_key_type bit_key)
+    {
+        Key key;
+        fields_codec::decode(bit_key, decomposer_type()(key));
+        return key;
+    }
+};
+
+template<class Key, class Enable>
+struct radix_key_codec_base : radix_key_codec_decomposed<Key> { };
+
 template<class Key>
 struct radix_key_codec_base<
     Key,
     typename std::enable_if<std::is_integral<Key>::value && !std::is_same<bool, Key>::value>::type
 > : radix_key_codec_integral<Key, typename std::make_unsigned<Key>::type> { };
 
+#ifdef __SIZEOF_INT128__
+template<>
+struct radix_key_codec_base<__int128> : radix_key_codec_integral<__int128, unsigned __int128> { };
+
+template<>
+struct radix_key_codec_base<unsigned __int128>
+    : radix_key_codec_integral<unsigned __int128, unsigned __int128> { };
+#endif
+
 template<>
 struct radix_key_codec_base<float> : radix_key_codec_floating<float, unsigned int> { };
 
@@ -125,6 +292,8 @@ class radix_key_codec : protected radix_key_codec_base<Key>
 public:
     using bit_key_type = typename base_type::bit_key_type;
 
+    static constexpr unsigned int key_bits = base_type::key_bits;
+
     ROCPRIM_DEVICE inline
     static bit_key_type encode(Key key)
     {
@@ -140,6 +309,27 @@ public:
     }
 };
 
+// Intermediate passes of radix sort read keys (values) back from the output range,
+// it's possible only if the output iterator is a pointer to the key (value) type.
+// Other output iterators (e.g. transform_output_iterator) are written only by the last
+// pass, intermediate results are stored in an additional temporary buffer instead.
+template<class OutputIterator, class T>
+struct radix_sort_output_is_buffer : std::is_same<OutputIterator, T *> { };
+
+template<class T, class OutputIterator>
+inline
+T * radix_sort_output_buffer(OutputIterator, T * buffer)
+{
+    return buffer;
+}
+
+template<class T>
+inline
+T * radix_sort_output_buffer(T * output, T *)
+{
+    return output;
+}
+
 } // end namespace detail
 END_ROCPRIM_NAMESPACE
 
@@ -82,6 +82,14 @@ struct is_warpsize_shuffleable {
     static const bool value = detail::is_power_of_two(WarpSize);
 };
 
+// DPP-based warp-level primitives are used for 32-bit and 64-bit arithmetic types
+template<class T>
+struct is_warp_dpp_type {
+    static const bool value = ROCPRIM_USE_DPP
+        && std::is_arithmetic<T>::value
+        && (sizeof(T) == 4 || sizeof(T) == 8);
+};
+
 // Selects an appropriate vector_type based on the input T and size N.
 // The byte size is calculated and used to select an appropriate vector_type.
 template<class T, unsigned int N>
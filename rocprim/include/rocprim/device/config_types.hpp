@@ -0,0 +1,128 @@
+// Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_CONFIG_TYPES_HPP_
+#define ROCPRIM_DEVICE_CONFIG_TYPES_HPP_
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../config.hpp"
+
+/// \addtogroup devicemodule_configs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Special type used to show that the given device-level operation
+/// will be executed with the default configuration, selected by sizes of
+/// the processed types.
+struct default_config
+{
+
+};
+
+/// \brief Configuration of a single kernel: number of threads in a block and
+/// number of items processed by each thread.
+///
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam ItemsPerThread - number of items processed by each thread.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread
+>
+struct kernel_config
+{
+    /// \brief Number of threads in a block.
+    static constexpr unsigned int block_size = BlockSize;
+    /// \brief Number of items processed by each thread.
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+};
+
+/// \brief Configuration of a device-level operation which is executed on the host
+/// (after synchronizing the stream) when it processes at most \p MaxSize items and
+/// all its input and output ranges are host-accessible (pinned host or managed memory).
+///
+/// Operators used with such operation must be callable on the host.
+///
+/// Supported by scan, reduce, segmented reduce (where \p MaxSize limits the number
+/// of segments), select, unique and partition.
+///
+/// \tparam MaxSize - maximum number of items processed on the host.
+/// \tparam Config - configuration used when the operation is executed on the device.
+template<
+    size_t MaxSize,
+    class Config = default_config
+>
+struct host_fallback_config
+{
+    /// \brief Maximum number of items processed on the host.
+    static constexpr size_t max_size = MaxSize;
+    /// \brief Configuration used when the operation is executed on the device.
+    using device_config = Config;
+};
+
+namespace detail
+{
+
+// Config if it's not default_config, otherwise Default
+template<class Config, class Default>
+using default_or_custom_config =
+    typename std::conditional<
+        std::is_same<Config, default_config>::value,
+        Default,
+        Config
+    >::type;
+
+// Number of items per thread for values of type Value, such that every thread
+// processes about as many bytes as with ItemsPerThread 4-byte values.
+template<
+    unsigned int ItemsPerThread,
+    class Value,
+    unsigned int MaxItemsPerThread = 16
+>
+struct scale_items_per_thread
+{
+    static constexpr unsigned int scaled = ItemsPerThread * 4 / sizeof(Value);
+    static constexpr unsigned int value =
+        scaled < 1 ? 1 : (scaled > MaxItemsPerThread ? MaxItemsPerThread : scaled);
+};
+
+// Configuration of a kernel with BlockSize threads, ItemsPerThread is
+// scaled to the size of Value
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class Value,
+    unsigned int MaxItemsPerThread = 16
+>
+using scaled_kernel_config = kernel_config<
+    BlockSize,
+    scale_items_per_thread<ItemsPerThread, Value, MaxItemsPerThread>::value
+>;
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule_configs
+
+#endif // ROCPRIM_DEVICE_CONFIG_TYPES_HPP_
@@ -0,0 +1,63 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_CPU_TYPES_HPP_
+#define ROCPRIM_DEVICE_CPU_TYPES_HPP_
+
+#include "../config.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_cpu
+/// @{
+
+/// \brief Error code returned by device-level functions of the CPU backend,
+/// the counterpart of \p hipError_t.
+///
+/// Functions of the CPU backend return the same codes as their HIP counterparts,
+/// so code written for the HIP backend which checks returned errors works without changes.
+enum error_t
+{
+    /// \brief The operation completed successfully (the counterpart of \p hipSuccess).
+    success = 0,
+    /// \brief An argument is invalid (the counterpart of \p hipErrorInvalidValue).
+    invalid_value = 1
+};
+
+namespace detail
+{
+
+struct cpu_stream;
+
+} // end namespace detail
+
+/// \brief Stream type of the CPU backend, the counterpart of \p hipStream_t.
+///
+/// Device-level functions of the CPU backend finish all work before returning,
+/// so streams are accepted only for compatibility with the HIP backend and ignored.
+/// Like \p hipStream_t, it is a pointer and \p 0 means the default stream.
+using stream_t = detail::cpu_stream *;
+
+/// @}
+// end of group devicemodule_cpu
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_CPU_TYPES_HPP_
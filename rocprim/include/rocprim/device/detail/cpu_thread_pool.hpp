@@ -0,0 +1,242 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_CPU_THREAD_POOL_HPP_
+#define ROCPRIM_DEVICE_DETAIL_CPU_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../config.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Fixed pool of host threads executing parallel loops of the CPU backend.
+// Blocks of a loop are not assigned to threads in advance: every thread (including
+// the calling one) takes the next block from a shared counter, so threads which finish
+// early take over remaining work of slower ones.
+class cpu_thread_pool
+{
+public:
+    explicit cpu_thread_pool(unsigned int threads)
+        : stop_(false), generation_(0), pending_(0), blocks_(0), next_block_(0)
+    {
+        // The calling thread is a worker too
+        for(unsigned int i = 1; i < threads; i++)
+        {
+            workers_.emplace_back(&cpu_thread_pool::worker, this);
+        }
+    }
+
+    ~cpu_thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for(auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    cpu_thread_pool(const cpu_thread_pool&) = delete;
+    cpu_thread_pool& operator=(const cpu_thread_pool&) = delete;
+
+    unsigned int size() const
+    {
+        return static_cast<unsigned int>(workers_.size()) + 1;
+    }
+
+    // Calls function(block) for every block in [0, blocks) and waits for all of them,
+    // the first exception thrown by function is rethrown
+    template<class Function>
+    void parallel_for(size_t blocks, Function function)
+    {
+        // Nested loops are executed by the thread which calls them
+        if(blocks < 2 || workers_.empty() || is_pool_thread())
+        {
+            for(size_t block = 0; block < blocks; block++)
+            {
+                function(block);
+            }
+            return;
+        }
+
+        // Loops from different user threads are executed one after another
+        std::lock_guard<std::mutex> loop_lock(loop_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = [&function](size_t block) { function(block); };
+            blocks_ = blocks;
+            next_block_ = 0;
+            pending_ = workers_.size();
+            error_ = nullptr;
+            generation_++;
+        }
+        start_.notify_all();
+
+        is_pool_thread() = true;
+        run_blocks();
+        is_pool_thread() = false;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        task_ = nullptr;
+        if(error_)
+        {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    static bool& is_pool_thread()
+    {
+        static thread_local bool value = false;
+        return value;
+    }
+
+    void worker()
+    {
+        is_pool_thread() = true;
+        unsigned long long generation = 0;
+        while(true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != generation; });
+                if(stop_) return;
+                generation = generation_;
+            }
+            run_blocks();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if(--pending_ == 0)
+                {
+                    done_.notify_one();
+                }
+            }
+        }
+    }
+
+    void run_blocks()
+    {
+        size_t block;
+        while((block = next_block_.fetch_add(1)) < blocks_)
+        {
+            try
+            {
+                task_(block);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if(!error_) error_ = std::current_exception();
+                // Remaining blocks are skipped
+                next_block_ = blocks_;
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex loop_mutex_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    bool stop_;
+    unsigned long long generation_;
+    size_t pending_;
+    std::function<void(size_t)> task_;
+    size_t blocks_;
+    std::atomic<size_t> next_block_;
+    std::exception_ptr error_;
+};
+
+// Number of threads is taken from ROCPRIM_CPU_THREADS environment variable,
+// all hardware threads are used by default
+inline
+unsigned int get_cpu_threads()
+{
+    const char * env = std::getenv("ROCPRIM_CPU_THREADS");
+    if(env != nullptr && std::atoi(env) > 0)
+    {
+        return static_cast<unsigned int>(std::atoi(env));
+    }
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+inline
+cpu_thread_pool& get_cpu_thread_pool()
+{
+    static cpu_thread_pool pool(get_cpu_threads());
+    return pool;
+}
+
+// Split of [0, size) into blocks of consecutive items for parallel loops,
+// there are several blocks per thread for load balancing but blocks are large
+// enough for vectorized inner loops
+struct cpu_partition
+{
+    size_t size;
+    size_t blocks;
+    size_t block_size;
+
+    cpu_partition(size_t size, size_t min_block_size = 4096)
+        : size(size)
+    {
+        const size_t max_blocks = 4 * get_cpu_thread_pool().size();
+        block_size = std::max(min_block_size, (size + max_blocks - 1) / max_blocks);
+        blocks = (size + block_size - 1) / block_size;
+    }
+
+    size_t begin(size_t block) const
+    {
+        return block * block_size;
+    }
+
+    size_t end(size_t block) const
+    {
+        return std::min(size, (block + 1) * block_size);
+    }
+};
+
+template<class Function>
+inline
+void cpu_parallel_for(size_t blocks, Function function)
+{
+    get_cpu_thread_pool().parallel_for(blocks, function);
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_CPU_THREAD_POOL_HPP_
@@ -0,0 +1,285 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_BATCHED_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_BATCHED_HPP_
+
+#include <type_traits>
+#include <iterator>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../functional.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_load.hpp"
+#include "../../block/block_store.hpp"
+#include "../../block/block_scan.hpp"
+
+#include "device_scan_lookback.hpp"
+#include "lookback_scan_state.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Tiles of all problems are numbered consecutively, tile_offsets[i] is the first tile
+// of i-th problem (exclusive prefix sum of tile counts). Returns the problem of the tile,
+// i.e. the last problem with tile_offsets[problem] <= tile (empty problems have no tiles).
+ROCPRIM_DEVICE inline
+unsigned int batched_find_problem(const size_t * tile_offsets,
+                                  unsigned int problems,
+                                  size_t tile)
+{
+    unsigned int begin = 0;
+    unsigned int end = problems;
+    while(end - begin > 1)
+    {
+        const unsigned int mid = begin + (end - begin) / 2;
+        if(tile_offsets[mid] <= tile)
+        {
+            begin = mid;
+        }
+        else
+        {
+            end = mid;
+        }
+    }
+    return begin;
+}
+
+// Scan: stores the tile to the output of the problem
+template<
+    bool Reduce,
+    unsigned int BlockSize,
+    class BlockStore,
+    class OutputIterators,
+    class T,
+    unsigned int ItemsPerThread
+>
+ROCPRIM_DEVICE inline
+auto batched_store(OutputIterators outputs,
+                   unsigned int problem,
+                   size_t tile_offset,
+                   T (&values)[ItemsPerThread],
+                   unsigned int valid_count,
+                   bool /* last_tile */,
+                   T /* initial_value */,
+                   typename BlockStore::storage_type& storage)
+    -> typename std::enable_if<!Reduce>::type
+{
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    auto output = outputs[problem] + tile_offset;
+    if(valid_count == items_per_block)
+    {
+        BlockStore().store(output, values, storage);
+    }
+    else
+    {
+        BlockStore().store(output, values, valid_count, storage);
+    }
+}
+
+// Reduce: the inclusive scan of the last item of the last tile is the reduction
+// of the problem
+template<
+    bool Reduce,
+    unsigned int BlockSize,
+    class BlockStore,
+    class OutputIterators,
+    class T,
+    unsigned int ItemsPerThread
+>
+ROCPRIM_DEVICE inline
+auto batched_store(OutputIterators outputs,
+                   unsigned int problem,
+                   size_t /* tile_offset */,
+                   T (&values)[ItemsPerThread],
+                   unsigned int valid_count,
+                   bool last_tile,
+                   T initial_value,
+                   typename BlockStore::storage_type& /* storage */)
+    -> typename std::enable_if<Reduce>::type
+{
+    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+    if(valid_count == 0)
+    {
+        if(flat_id == 0)
+        {
+            outputs[problem] = initial_value;
+        }
+    }
+    else if(last_tile && flat_id == (valid_count - 1) / ItemsPerThread)
+    {
+        outputs[problem] = values[(valid_count - 1) % ItemsPerThread];
+    }
+}
+
+// Processes one tile of one of many independent problems. Tiles are assigned in
+// the order of ordered_bid, so look-back over lookback_scan_state works as in
+// lookback_scan_kernel_impl: the first tile of every problem publishes a complete
+// prefix, hence look-back never goes past it into the previous problem.
+// Reduce is an inclusive scan that only stores the last item (empty problems of
+// reduce have one tile to store initial_value).
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    bool Exclusive,
+    bool Reduce,
+    class InputIterators,
+    class OutputIterators,
+    class ResultType,
+    class BinaryFunction,
+    class LookbackScanState
+>
+ROCPRIM_DEVICE inline
+void batched_scan_kernel_impl(InputIterators inputs,
+                              OutputIterators outputs,
+                              const size_t * tile_offsets,
+                              const size_t * sizes,
+                              unsigned int problems,
+                              ResultType initial_value,
+                              BinaryFunction scan_op,
+                              LookbackScanState scan_state,
+                              ordered_block_id<unsigned int> ordered_bid)
+{
+    using result_type = ResultType;
+    static_assert(
+        std::is_same<result_type, typename LookbackScanState::value_type>::value,
+        "value_type of LookbackScanState must be result_type"
+    );
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    using block_load_type = ::rocprim::block_load<
+        result_type, BlockSize, ItemsPerThread,
+        ::rocprim::block_load_method::block_load_transpose
+    >;
+    using block_store_type = ::rocprim::block_store<
+        result_type, BlockSize, ItemsPerThread,
+        ::rocprim::block_store_method::block_store_transpose
+    >;
+    using block_scan_type = ::rocprim::block_scan<
+        result_type, BlockSize,
+        ::rocprim::block_scan_algorithm::using_warp_scan
+    >;
+    using ordered_block_id_type = ordered_block_id<unsigned int>;
+    using lookback_scan_prefix_op_type = lookback_scan_prefix_op<
+        result_type, BinaryFunction, LookbackScanState
+    >;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename ordered_block_id_type::storage_type ordered_bid;
+        union
+        {
+            typename block_load_type::storage_type load;
+            typename block_store_type::storage_type store;
+            typename block_scan_type::storage_type scan;
+        };
+    } storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int tile = ordered_bid.get(flat_id, storage.ordered_bid);
+
+    const unsigned int problem = batched_find_problem(tile_offsets, problems, tile);
+    const size_t tile_in_problem = tile - tile_offsets[problem];
+    const bool first_tile = tile_in_problem == 0;
+    const bool last_tile = tile_offsets[problem + 1] == size_t(tile) + 1;
+    const size_t tile_offset = tile_in_problem * items_per_block;
+    const unsigned int valid_count = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(items_per_block, sizes[problem] - tile_offset)
+    );
+
+    result_type values[ItemsPerThread];
+
+    if(valid_count == 0)
+    {
+        // Empty problem of reduce, its prefix is still read by look-back of next tiles
+        if(flat_id == 0)
+        {
+            scan_state.set_complete(tile, initial_value);
+        }
+        batched_store<Reduce, BlockSize, block_store_type>(
+            outputs, problem, tile_offset, values, valid_count, last_tile,
+            initial_value, storage.store
+        );
+        return;
+    }
+
+    auto input = inputs[problem] + tile_offset;
+    if(valid_count == items_per_block)
+    {
+        block_load_type().load(input, values, storage.load);
+    }
+    else
+    {
+        block_load_type().load(input, values, valid_count, storage.load);
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    if(first_tile)
+    {
+        if(Reduce && flat_id == 0)
+        {
+            values[0] = scan_op(initial_value, values[0]);
+        }
+        result_type reduction;
+        lookback_block_scan<Exclusive, block_scan_type>(
+            values, // input/output
+            initial_value,
+            reduction,
+            storage.scan,
+            scan_op
+        );
+        if(flat_id == 0)
+        {
+            scan_state.set_complete(tile, reduction);
+        }
+    }
+    else
+    {
+        auto prefix_op = lookback_scan_prefix_op_type(
+            tile, scan_op, scan_state
+        );
+        lookback_block_scan<Exclusive, block_scan_type>(
+            values, // input/output
+            storage.scan,
+            prefix_op,
+            scan_op
+        );
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    batched_store<Reduce, BlockSize, block_store_type>(
+        outputs, problem, tile_offset, values, valid_count, last_tile,
+        initial_value, storage.store
+    );
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_BATCHED_HPP_
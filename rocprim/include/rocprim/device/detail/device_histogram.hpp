@@ -277,13 +277,17 @@ void init_histogram(fixed_array<Counter *, ActiveChannels> histogram,
     }
 }
 
+// Bins of all active channels are concatenated and split into tiles of tile_bins bins,
+// blocks with block_id<2> == t count only bins of tile t. Each block keeps histograms
+// copies of its tile in shared memory, warps are spread between them to reduce contention
+// of atomic operations when samples are skewed. Blocks write their counts to
+// partial_histograms, they are merged by histogram_shared_merge.
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
     unsigned int Channels,
     unsigned int ActiveChannels,
     class SampleIterator,
-    class Counter,
     class SampleToBinOp
 >
 ROCPRIM_DEVICE inline
@@ -291,9 +295,11 @@ void histogram_shared(SampleIterator samples,
                       unsigned int columns,
                       unsigned int rows,
                       unsigned int row_stride,
-                      fixed_array<Counter *, ActiveChannels> histogram,
+                      unsigned int * partial_histograms,
                       fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
                       fixed_array<unsigned int, ActiveChannels> bins,
+                      unsigned int tile_bins,
+                      unsigned int histograms,
                       unsigned int * block_histogram_start)
 {
     using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
@@ -304,19 +310,26 @@ void histogram_shared(SampleIterator samples,
     const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
     const unsigned int block_id0 = ::rocprim::detail::block_id<0>();
     const unsigned int block_id1 = ::rocprim::detail::block_id<1>();
+    const unsigned int tile_id = ::rocprim::detail::block_id<2>();
     const unsigned int grid_size0 = ::rocprim::detail::grid_size<0>();
     const unsigned int grid_size1 = ::rocprim::detail::grid_size<1>();
     const unsigned int rows_per_block = ::rocprim::detail::ceiling_div(rows, grid_size1);
 
-    unsigned int * block_histogram[ActiveChannels];
+    unsigned int channel_offsets[ActiveChannels];
+    unsigned int total_bins = 0;
     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
     {
-        block_histogram[channel] = block_histogram_start;
-        block_histogram_start += bins[channel];
-        for(unsigned int bin = flat_id; bin < bins[channel]; bin += BlockSize)
-        {
-            block_histogram[channel][bin] = 0;
-        }
+        channel_offsets[channel] = total_bins;
+        total_bins += bins[channel];
+    }
+    const unsigned int tile_begin = tile_id * tile_bins;
+    const unsigned int tile_size = ::rocprim::min(tile_bins, total_bins - tile_begin);
+
+    unsigned int * block_histogram = block_histogram_start + (::rocprim::warp_id() % histograms) * tile_size;
+
+    for(unsigned int bin = flat_id; bin < histograms * tile_size; bin += BlockSize)
+    {
+        block_histogram_start[bin] = 0;
     }
     ::rocprim::syncthreads();
 
@@ -350,9 +363,11 @@ void histogram_shared(SampleIterator samples,
                     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
                     {
                         const int bin = sample_to_bin_op[channel](values[i].values[channel]);
-                        if(bin != -1)
+                        // Bins of other tiles wrap around to large values
+                        const unsigned int tile_bin = channel_offsets[channel] + bin - tile_begin;
+                        if(bin != -1 && tile_bin < tile_size)
                         {
-                            ::rocprim::detail::atomic_add(&block_histogram[channel][bin], 1);
+                            ::rocprim::atomic_add(&block_histogram[tile_bin], 1);
                         }
                     }
                 }
@@ -363,15 +378,53 @@ void histogram_shared(SampleIterator samples,
     }
     ::rocprim::syncthreads();
 
+    const unsigned int block_index = (tile_id * grid_size1 + block_id1) * grid_size0 + block_id0;
+    partial_histograms += block_index * tile_bins;
+    for(unsigned int tile_bin = flat_id; tile_bin < tile_size; tile_bin += BlockSize)
+    {
+        unsigned int count = 0;
+        for(unsigned int i = 0; i < histograms; i++)
+        {
+            count += block_histogram_start[i * tile_size + tile_bin];
+        }
+        partial_histograms[tile_bin] = count;
+    }
+}
+
+// Sums counts of all blocks_per_tile blocks of a tile in a fixed order, so the result
+// does not depend on scheduling of blocks
+template<
+    unsigned int BlockSize,
+    unsigned int ActiveChannels,
+    class Counter
+>
+ROCPRIM_DEVICE inline
+void histogram_shared_merge(const unsigned int * partial_histograms,
+                            unsigned int blocks_per_tile,
+                            unsigned int tile_bins,
+                            fixed_array<Counter *, ActiveChannels> histogram,
+                            fixed_array<unsigned int, ActiveChannels> bins)
+{
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+
+    unsigned int bin = block_id * BlockSize + flat_id;
+    const unsigned int tile_id = bin / tile_bins;
+    const unsigned int tile_bin = bin - tile_id * tile_bins;
+    partial_histograms += tile_id * blocks_per_tile * tile_bins + tile_bin;
     for(unsigned int channel = 0; channel < ActiveChannels; channel++)
     {
-        for(unsigned int bin = flat_id; bin < bins[channel]; bin += BlockSize)
+        if(bin < bins[channel])
         {
-            if(block_histogram[channel][bin] > 0)
+            unsigned int count = 0;
+            for(unsigned int i = 0; i < blocks_per_tile; i++)
             {
-                ::rocprim::detail::atomic_add(&histogram[channel][bin], block_histogram[channel][bin]);
+                count += partial_histograms[i * tile_bins];
             }
+            histogram[channel][bin] = count;
+            return;
         }
+        bin -= bins[channel];
     }
 }
 
@@ -438,13 +491,94 @@ void histogram_global(SampleIterator samples,
                 {
                     // Write the number of lanes having this bin,
                     // if the current lane is the first (and maybe only) lane with this bin.
-                    ::rocprim::detail::atomic_add(&histogram[channel][bin], same_bin_count);
+                    ::rocprim::atomic_add(&histogram[channel][bin], same_bin_count);
                 }
             }
         }
     }
 }
 
+// Sort implementation: bins of samples are written as keys (bins of all active channels
+// are concatenated, samples outside of bins get the key total_bins), sorted and
+// run-length-encoded, then counts of runs are written to the histogram.
+template<
+    unsigned int BlockSize,
+    unsigned int Channels,
+    unsigned int ActiveChannels,
+    class SampleIterator,
+    class SampleToBinOp
+>
+ROCPRIM_DEVICE inline
+void histogram_sort_keys(SampleIterator samples,
+                         unsigned int columns,
+                         unsigned int rows,
+                         unsigned int row_stride,
+                         fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
+                         fixed_array<unsigned int, ActiveChannels> bins,
+                         unsigned int * keys)
+{
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id0 = ::rocprim::detail::block_id<0>();
+    const unsigned int row = ::rocprim::detail::block_id<1>();
+
+    const unsigned int column = block_id0 * BlockSize + flat_id;
+    if(column >= columns)
+    {
+        return;
+    }
+
+    unsigned int total_bins = 0;
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        total_bins += bins[channel];
+    }
+
+    const unsigned int channel_size = columns * rows;
+    samples += row * row_stride + Channels * column;
+    keys += row * columns + column;
+    unsigned int channel_offset = 0;
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        const int bin = sample_to_bin_op[channel](samples[channel]);
+        keys[channel * channel_size] = bin != -1 ? channel_offset + bin : total_bins;
+        channel_offset += bins[channel];
+    }
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ActiveChannels,
+    class Counter
+>
+ROCPRIM_DEVICE inline
+void histogram_sort_counts(const unsigned int * unique_keys,
+                           const unsigned int * counts,
+                           const unsigned int * runs_count,
+                           fixed_array<Counter *, ActiveChannels> histogram,
+                           fixed_array<unsigned int, ActiveChannels> bins)
+{
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+
+    const unsigned int index = block_id * BlockSize + flat_id;
+    if(index >= *runs_count)
+    {
+        return;
+    }
+
+    // Keys of samples outside of bins (the last run, if any) are not found in any channel
+    unsigned int bin = unique_keys[index];
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        if(bin < bins[channel])
+        {
+            histogram[channel][bin] = counts[index];
+            return;
+        }
+        bin -= bins[channel];
+    }
+}
+
 } // end of detail namespace
 
 END_ROCPRIM_NAMESPACE
@@ -0,0 +1,443 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_HOST_FALLBACK_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_HOST_FALLBACK_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+
+#include "../config_types.hpp"
+#include "device_select.hpp"
+
+#ifdef ROCPRIM_HC_API
+    #include <hcc/hc_am.hpp>
+#endif
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Host fallback size and device config of Config
+template<class Config>
+struct host_fallback_traits
+{
+    static constexpr size_t max_size = ROCPRIM_HOST_FALLBACK_SIZE;
+    using config = Config;
+};
+
+template<size_t MaxSize, class Config>
+struct host_fallback_traits<host_fallback_config<MaxSize, Config>>
+{
+    static constexpr size_t max_size = MaxSize;
+    using config = Config;
+};
+
+// Fancy iterators may wrap device memory, only pointers are checked
+template<class Iterator>
+inline
+bool is_host_accessible(Iterator)
+{
+    return false;
+}
+
+template<class T>
+inline
+bool is_host_accessible(T * ptr)
+{
+#ifdef ROCPRIM_HC_API
+    hc::accelerator acc;
+    hc::AmPointerInfo info(nullptr, nullptr, 0, acc, false, false);
+    if(hc::am_memtracker_getinfo(&info, ptr) != AM_SUCCESS)
+    {
+        return false;
+    }
+    return !info._isInDeviceMem || info._isAmManaged;
+#else
+    hipPointerAttribute_t attributes;
+    if(hipPointerGetAttributes(&attributes, ptr) != hipSuccess)
+    {
+        // Memory unknown to HIP (pageable), reset the error
+        (void) hipGetLastError();
+        return false;
+    }
+    return attributes.memoryType == hipMemoryTypeHost || attributes.isManaged;
+#endif
+}
+
+inline
+bool are_host_accessible()
+{
+    return true;
+}
+
+template<class Iterator, class... Iterators>
+inline
+bool are_host_accessible(Iterator iterator, Iterators... iterators)
+{
+    return is_host_accessible(iterator) && are_host_accessible(iterators...);
+}
+
+// All input and output ranges of the operation (iterators) must be host-accessible
+template<class... Iterators>
+inline
+bool use_host_fallback(std::true_type /* enabled */,
+                       const size_t max_size,
+                       const size_t size,
+                       Iterators... iterators)
+{
+    return size <= max_size && are_host_accessible(iterators...);
+}
+
+// The host path is not instantiated when fallback is disabled, so operators
+// do not have to be host-callable
+template<class... Iterators>
+inline
+bool use_host_fallback(std::false_type /* enabled */,
+                       const size_t,
+                       const size_t,
+                       Iterators...)
+{
+    return false;
+}
+
+// Host implementation of scan
+template<
+    bool Exclusive,
+    class InputIterator,
+    class OutputIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void host_scan(InputIterator input,
+               OutputIterator output,
+               const size_t size,
+               ResultType initial_value,
+               BinaryFunction scan_op)
+{
+    if(size == 0) return;
+
+    ResultType value = Exclusive ? initial_value : static_cast<ResultType>(input[0]);
+    if(!Exclusive) output[0] = value;
+    for(size_t i = Exclusive ? 0 : 1; i < size; i++)
+    {
+        // Input is read before output is written, so scan can be in-place
+        const ResultType next = scan_op(value, input[i]);
+        output[i] = Exclusive ? value : next;
+        value = next;
+    }
+}
+
+template<
+    bool Exclusive,
+    class InputIterator,
+    class OutputIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void host_scan(std::false_type /* enabled */,
+               InputIterator, OutputIterator, const size_t, ResultType, BinaryFunction)
+{
+
+}
+
+template<
+    bool Exclusive,
+    class InputIterator,
+    class OutputIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void host_scan(std::true_type /* enabled */,
+               InputIterator input,
+               OutputIterator output,
+               const size_t size,
+               ResultType initial_value,
+               BinaryFunction scan_op)
+{
+    host_scan<Exclusive>(input, output, size, initial_value, scan_op);
+}
+
+// Host implementation of reduction
+template<
+    bool WithInitialValue,
+    class InputIterator,
+    class OutputIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void host_reduce(InputIterator input,
+                 OutputIterator output,
+                 const size_t size,
+                 ResultType initial_value,
+                 BinaryFunction reduce_op)
+{
+    if(size == 0)
+    {
+        if(WithInitialValue) output[0] = initial_value;
+        return;
+    }
+
+    ResultType value = static_cast<ResultType>(input[0]);
+    for(size_t i = 1; i < size; i++)
+    {
+        value = reduce_op(value, input[i]);
+    }
+    output[0] = WithInitialValue ? reduce_op(initial_value, value) : value;
+}
+
+template<
+    bool WithInitialValue,
+    class InputIterator,
+    class OutputIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void host_reduce(std::false_type /* enabled */,
+                 InputIterator, OutputIterator, const size_t, ResultType, BinaryFunction)
+{
+
+}
+
+template<
+    bool WithInitialValue,
+    class InputIterator,
+    class OutputIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void host_reduce(std::true_type /* enabled */,
+                 InputIterator input,
+                 OutputIterator output,
+                 const size_t size,
+                 ResultType initial_value,
+                 BinaryFunction reduce_op)
+{
+    host_reduce<WithInitialValue>(input, output, size, initial_value, reduce_op);
+}
+
+// Host implementation of segmented reduction, results of empty segments are initial_value
+template<
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void host_segmented_reduce(InputIterator input,
+                           OutputIterator output,
+                           const unsigned int segments,
+                           OffsetIterator begin_offsets,
+                           OffsetIterator end_offsets,
+                           ResultType initial_value,
+                           BinaryFunction reduce_op)
+{
+    for(unsigned int segment_id = 0; segment_id < segments; segment_id++)
+    {
+        const size_t begin_offset = begin_offsets[segment_id];
+        const size_t end_offset = end_offsets[segment_id];
+        ResultType value = initial_value;
+        for(size_t i = begin_offset; i < end_offset; i++)
+        {
+            value = reduce_op(value, input[i]);
+        }
+        output[segment_id] = value;
+    }
+}
+
+template<
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void host_segmented_reduce(std::false_type /* enabled */,
+                           InputIterator, OutputIterator, const unsigned int,
+                           OffsetIterator, OffsetIterator, ResultType, BinaryFunction)
+{
+
+}
+
+template<
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void host_segmented_reduce(std::true_type /* enabled */,
+                           InputIterator input,
+                           OutputIterator output,
+                           const unsigned int segments,
+                           OffsetIterator begin_offsets,
+                           OffsetIterator end_offsets,
+                           ResultType initial_value,
+                           BinaryFunction reduce_op)
+{
+    host_segmented_reduce(
+        input, output, segments, begin_offsets, end_offsets,
+        initial_value, reduce_op
+    );
+}
+
+// Only the flag method reads flags, they are not checked for other methods
+template<select_method SelectMethod, class FlagIterator>
+inline
+bool are_flags_host_accessible(FlagIterator flags)
+{
+    return SelectMethod != select_method::flag || is_host_accessible(flags);
+}
+
+template<select_method SelectMethod, class InputIterator, class FlagIterator, class SelectOp, class InequalityOp>
+inline
+auto host_partition_is_selected(InputIterator /* input */,
+                                FlagIterator flags,
+                                const size_t i,
+                                SelectOp /* select_op */,
+                                InequalityOp /* inequality_op */)
+    -> typename std::enable_if<SelectMethod == select_method::flag, bool>::type
+{
+    return static_cast<bool>(flags[i]);
+}
+
+template<select_method SelectMethod, class InputIterator, class FlagIterator, class SelectOp, class InequalityOp>
+inline
+auto host_partition_is_selected(InputIterator input,
+                                FlagIterator /* flags */,
+                                const size_t i,
+                                SelectOp select_op,
+                                InequalityOp /* inequality_op */)
+    -> typename std::enable_if<SelectMethod == select_method::predicate, bool>::type
+{
+    return select_op(input[i]);
+}
+
+template<select_method SelectMethod, class InputIterator, class FlagIterator, class SelectOp, class InequalityOp>
+inline
+auto host_partition_is_selected(InputIterator input,
+                                FlagIterator /* flags */,
+                                const size_t i,
+                                SelectOp /* select_op */,
+                                InequalityOp inequality_op)
+    -> typename std::enable_if<SelectMethod == select_method::unique, bool>::type
+{
+    return i == 0 || inequality_op(input[i - 1], input[i]);
+}
+
+// Host implementation of select, unique and partition (if OnlySelected is false,
+// rejected items are written in reverse order to the back of output)
+template<
+    select_method SelectMethod,
+    bool OnlySelected,
+    class InputIterator,
+    class FlagIterator,
+    class OutputIterator,
+    class SelectedCountOutputIterator,
+    class SelectOp,
+    class InequalityOp
+>
+inline
+void host_partition(InputIterator input,
+                    FlagIterator flags,
+                    OutputIterator output,
+                    SelectedCountOutputIterator selected_count_output,
+                    const size_t size,
+                    SelectOp select_op,
+                    InequalityOp inequality_op)
+{
+    size_t selected_count = 0;
+    size_t rejected_count = 0;
+    for(size_t i = 0; i < size; i++)
+    {
+        if(host_partition_is_selected<SelectMethod>(input, flags, i, select_op, inequality_op))
+        {
+            output[selected_count++] = input[i];
+        }
+        else if(!OnlySelected)
+        {
+            output[size - 1 - rejected_count++] = input[i];
+        }
+    }
+    selected_count_output[0] = selected_count;
+}
+
+template<
+    select_method SelectMethod,
+    bool OnlySelected,
+    class InputIterator,
+    class FlagIterator,
+    class OutputIterator,
+    class SelectedCountOutputIterator,
+    class SelectOp,
+    class InequalityOp
+>
+inline
+void host_partition(std::false_type /* enabled */,
+                    InputIterator, FlagIterator, OutputIterator, SelectedCountOutputIterator,
+                    const size_t, SelectOp, InequalityOp)
+{
+
+}
+
+template<
+    select_method SelectMethod,
+    bool OnlySelected,
+    class InputIterator,
+    class FlagIterator,
+    class OutputIterator,
+    class SelectedCountOutputIterator,
+    class SelectOp,
+    class InequalityOp
+>
+inline
+void host_partition(std::true_type /* enabled */,
+                    InputIterator input,
+                    FlagIterator flags,
+                    OutputIterator output,
+                    SelectedCountOutputIterator selected_count_output,
+                    const size_t size,
+                    SelectOp select_op,
+                    InequalityOp inequality_op)
+{
+    host_partition<SelectMethod, OnlySelected>(
+        input, flags, output, selected_count_output, size,
+        select_op, inequality_op
+    );
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_HOST_FALLBACK_HPP_
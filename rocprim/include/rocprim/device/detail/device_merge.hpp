@@ -0,0 +1,349 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_MERGE_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_MERGE_HPP_
+
+#include <type_traits>
+#include <iterator>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../functional.hpp"
+#include "../../types.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Returns the number of items of the first range among the first diagonal
+// items of the merged sequence. Equivalent keys from the first range go before
+// keys from the second range, so merging is stable.
+template<
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class Offset,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+Offset merge_path(KeysInputIterator1 keys1,
+                  KeysInputIterator2 keys2,
+                  const Offset size1,
+                  const Offset size2,
+                  const Offset diagonal,
+                  BinaryFunction compare_function)
+{
+    Offset begin = diagonal > size2 ? diagonal - size2 : 0;
+    Offset end = ::rocprim::min(diagonal, size1);
+    while(begin < end)
+    {
+        const Offset a = (begin + end) / 2;
+        const Offset b = diagonal - 1 - a;
+        if(!compare_function(keys2[b], keys1[a]))
+        {
+            begin = a + 1;
+        }
+        else
+        {
+            end = a;
+        }
+    }
+    return begin;
+}
+
+// Merges ItemsPerThread items of sorted ranges [begin1, end1) and [begin2, end2)
+// of keys stored in shared memory starting from merge path point (begin1, begin2).
+// Indices of merged items are written to indices, when both ranges are exhausted
+// remaining indices are not valid.
+template<
+    unsigned int ItemsPerThread,
+    class Key,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void serial_merge(const Key * keys_shared,
+                  unsigned int begin1,
+                  const unsigned int end1,
+                  unsigned int begin2,
+                  const unsigned int end2,
+                  unsigned int (&indices)[ItemsPerThread],
+                  BinaryFunction compare_function)
+{
+    #pragma unroll
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        const bool from_first = begin2 >= end2
+            || (begin1 < end1 && !compare_function(keys_shared[begin2], keys_shared[begin1]));
+        indices[i] = from_first ? begin1++ : begin2++;
+    }
+}
+
+// Loads count1 items of the first range followed by count2 items of the second range
+// to shared memory, global reads are striped (coalesced).
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class InputIterator1,
+    class InputIterator2,
+    class T
+>
+ROCPRIM_DEVICE inline
+void merge_load_to_shared(InputIterator1 input1,
+                          InputIterator2 input2,
+                          const unsigned int count1,
+                          const unsigned int count2,
+                          T * shared)
+{
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+
+    #pragma unroll
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        const unsigned int index = i * BlockSize + flat_id;
+        if(index < count1)
+        {
+            shared[index] = input1[index];
+        }
+        else if(index < count1 + count2)
+        {
+            shared[index] = input2[index - count1];
+        }
+    }
+}
+
+// Stores valid_count items of the block in blocked arrangement through
+// shared memory, global writes are striped (coalesced).
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class OutputIterator,
+    class T
+>
+ROCPRIM_DEVICE inline
+void merge_store_from_shared(OutputIterator output,
+                             T (&items)[ItemsPerThread],
+                             T * shared,
+                             const unsigned int valid_count)
+{
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+
+    #pragma unroll
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        const unsigned int index = flat_id * ItemsPerThread + i;
+        if(index < valid_count)
+        {
+            shared[index] = items[i];
+        }
+    }
+    ::rocprim::syncthreads();
+
+    #pragma unroll
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        const unsigned int index = i * BlockSize + flat_id;
+        if(index < valid_count)
+        {
+            output[index] = shared[index];
+        }
+    }
+}
+
+// Merges count1 sorted items of the first range and count2 sorted items
+// of the second range (count1 + count2 <= BlockSize * ItemsPerThread) and stores
+// the result to the output. Values are moved together with their keys.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class Key,
+    class Value,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void merge_tile(KeysInputIterator1 keys_input1,
+                KeysInputIterator2 keys_input2,
+                KeysOutputIterator keys_output,
+                ValuesInputIterator1 values_input1,
+                ValuesInputIterator2 values_input2,
+                ValuesOutputIterator values_output,
+                const unsigned int count1,
+                const unsigned int count2,
+                Key * keys_shared,
+                Value * values_shared,
+                BinaryFunction compare_function)
+{
+    constexpr bool with_values = !std::is_same<Value, ::rocprim::empty_type>::value;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int valid_count = count1 + count2;
+
+    merge_load_to_shared<BlockSize, ItemsPerThread>(
+        keys_input1, keys_input2, count1, count2, keys_shared
+    );
+    if(with_values)
+    {
+        merge_load_to_shared<BlockSize, ItemsPerThread>(
+            values_input1, values_input2, count1, count2, values_shared
+        );
+    }
+    ::rocprim::syncthreads();
+
+    const unsigned int diagonal = ::rocprim::min(flat_id * ItemsPerThread, valid_count);
+    const unsigned int split = merge_path(
+        keys_shared, keys_shared + count1,
+        count1, count2, diagonal,
+        compare_function
+    );
+    unsigned int indices[ItemsPerThread];
+    serial_merge(
+        keys_shared,
+        split, count1,
+        count1 + diagonal - split, valid_count,
+        indices, compare_function
+    );
+
+    Key keys[ItemsPerThread];
+    Value values[ItemsPerThread];
+    #pragma unroll
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        if(diagonal + i < valid_count)
+        {
+            keys[i] = keys_shared[indices[i]];
+            if(with_values)
+            {
+                values[i] = values_shared[indices[i]];
+            }
+        }
+    }
+    ::rocprim::syncthreads();
+
+    merge_store_from_shared<BlockSize, ItemsPerThread>(
+        keys_output, keys, keys_shared, valid_count
+    );
+    if(with_values)
+    {
+        merge_store_from_shared<BlockSize, ItemsPerThread>(
+            values_output, values, values_shared, valid_count
+        );
+    }
+}
+
+// Finds the merge path split of the first item of every tile (and the end of the
+// last tile), so every block merges exactly items_per_block items.
+template<
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void merge_partition_kernel_impl(size_t * splits,
+                                 KeysInputIterator1 keys_input1,
+                                 KeysInputIterator2 keys_input2,
+                                 const size_t size1,
+                                 const size_t size2,
+                                 const unsigned int items_per_block,
+                                 const unsigned int number_of_splits,
+                                 BinaryFunction compare_function)
+{
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+    const unsigned int block_size = ::rocprim::detail::block_size<0>();
+    const unsigned int block_thread_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int id = (block_id * block_size) + block_thread_id;
+    if(id >= number_of_splits)
+    {
+        return;
+    }
+
+    const size_t diagonal = ::rocprim::min(static_cast<size_t>(id) * items_per_block, size1 + size2);
+    splits[id] = merge_path(keys_input1, keys_input2, size1, size2, diagonal, compare_function);
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void merge_kernel_impl(const size_t * splits,
+                       KeysInputIterator1 keys_input1,
+                       KeysInputIterator2 keys_input2,
+                       KeysOutputIterator keys_output,
+                       ValuesInputIterator1 values_input1,
+                       ValuesInputIterator2 values_input2,
+                       ValuesOutputIterator values_output,
+                       const size_t size1,
+                       const size_t size2,
+                       BinaryFunction compare_function)
+{
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    using key_type = typename std::iterator_traits<KeysInputIterator1>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator1>::value_type;
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        key_type keys[items_per_block];
+        value_type values[with_values ? items_per_block : 1];
+    } storage;
+
+    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+    const size_t block_offset = static_cast<size_t>(flat_block_id) * items_per_block;
+    const unsigned int valid_count = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(size1 + size2 - block_offset, items_per_block)
+    );
+
+    const size_t begin1 = splits[flat_block_id];
+    const size_t begin2 = block_offset - begin1;
+    const unsigned int count1 = static_cast<unsigned int>(splits[flat_block_id + 1] - begin1);
+    const unsigned int count2 = valid_count - count1;
+
+    merge_tile<BlockSize, ItemsPerThread>(
+        keys_input1 + begin1, keys_input2 + begin2,
+        keys_output + block_offset,
+        values_input1 + begin1, values_input2 + begin2,
+        values_output + block_offset,
+        count1, count2,
+        storage.keys, storage.values,
+        compare_function
+    );
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_MERGE_HPP_
@@ -0,0 +1,326 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_MERGE_SORT_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_MERGE_SORT_HPP_
+
+#include <type_traits>
+#include <iterator>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../functional.hpp"
+#include "../../types.hpp"
+
+#include "device_merge.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Stable sort of valid_count keys (and values) of the thread, keys are swapped
+// only if they are strictly out of order, invalid items remain at the end.
+template<
+    unsigned int ItemsPerThread,
+    class Key,
+    class Value,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void thread_sort(Key (&keys)[ItemsPerThread],
+                 Value (&values)[ItemsPerThread],
+                 const unsigned int valid_count,
+                 BinaryFunction compare_function)
+{
+    constexpr bool with_values = !std::is_same<Value, ::rocprim::empty_type>::value;
+
+    // Odd-even transposition sort
+    #pragma unroll
+    for(unsigned int round = 0; round < ItemsPerThread; round++)
+    {
+        #pragma unroll
+        for(unsigned int i = round % 2; i + 1 < ItemsPerThread; i += 2)
+        {
+            if(i + 1 < valid_count && compare_function(keys[i + 1], keys[i]))
+            {
+                ::rocprim::swap(keys[i], keys[i + 1]);
+                if(with_values)
+                {
+                    ::rocprim::swap(values[i], values[i + 1]);
+                }
+            }
+        }
+    }
+}
+
+// Sorts valid_count items of the block in blocked arrangement: every thread sorts
+// its items, then sorted runs are merged in shared memory until the whole tile is sorted.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class Key,
+    class Value,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void block_merge_sort(Key (&keys)[ItemsPerThread],
+                      Value (&values)[ItemsPerThread],
+                      Key * keys_shared,
+                      Value * values_shared,
+                      const unsigned int valid_count,
+                      BinaryFunction compare_function)
+{
+    constexpr bool with_values = !std::is_same<Value, ::rocprim::empty_type>::value;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int thread_offset = flat_id * ItemsPerThread;
+    const unsigned int thread_valid_count = thread_offset < valid_count
+        ? ::rocprim::min(valid_count - thread_offset, ItemsPerThread)
+        : 0;
+
+    thread_sort(keys, values, thread_valid_count, compare_function);
+
+    // Sorted runs of width items are merged pairwise
+    for(unsigned int width = ItemsPerThread; width < valid_count; width *= 2)
+    {
+        #pragma unroll
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            if(i < thread_valid_count)
+            {
+                keys_shared[thread_offset + i] = keys[i];
+                if(with_values)
+                {
+                    values_shared[thread_offset + i] = values[i];
+                }
+            }
+        }
+        ::rocprim::syncthreads();
+
+        if(thread_valid_count > 0)
+        {
+            const unsigned int begin1 = thread_offset / (2 * width) * (2 * width);
+            const unsigned int end1 = ::rocprim::min(begin1 + width, valid_count);
+            const unsigned int end2 = ::rocprim::min(begin1 + 2 * width, valid_count);
+            const unsigned int diagonal = thread_offset - begin1;
+            const unsigned int split = merge_path(
+                keys_shared + begin1, keys_shared + end1,
+                end1 - begin1, end2 - end1, diagonal,
+                compare_function
+            );
+
+            unsigned int indices[ItemsPerThread];
+            serial_merge(
+                keys_shared,
+                begin1 + split, end1,
+                end1 + diagonal - split, end2,
+                indices, compare_function
+            );
+
+            #pragma unroll
+            for(unsigned int i = 0; i < ItemsPerThread; i++)
+            {
+                if(i < thread_valid_count)
+                {
+                    keys[i] = keys_shared[indices[i]];
+                    if(with_values)
+                    {
+                        values[i] = values_shared[indices[i]];
+                    }
+                }
+            }
+        }
+        ::rocprim::syncthreads();
+    }
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void merge_sort_block_sort_kernel_impl(KeysInputIterator keys_input,
+                                       KeysOutputIterator keys_output,
+                                       ValuesInputIterator values_input,
+                                       ValuesOutputIterator values_output,
+                                       const size_t size,
+                                       BinaryFunction compare_function)
+{
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        key_type keys[items_per_block];
+        value_type values[with_values ? items_per_block : 1];
+    } storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+    const size_t block_offset = static_cast<size_t>(flat_block_id) * items_per_block;
+    const unsigned int valid_count = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(size - block_offset, items_per_block)
+    );
+
+    merge_load_to_shared<BlockSize, ItemsPerThread>(
+        keys_input + block_offset, keys_input + block_offset,
+        valid_count, 0, storage.keys
+    );
+    if(with_values)
+    {
+        merge_load_to_shared<BlockSize, ItemsPerThread>(
+            values_input + block_offset, values_input + block_offset,
+            valid_count, 0, storage.values
+        );
+    }
+    ::rocprim::syncthreads();
+
+    key_type keys[ItemsPerThread];
+    value_type values[ItemsPerThread];
+    #pragma unroll
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        const unsigned int index = flat_id * ItemsPerThread + i;
+        if(index < valid_count)
+        {
+            keys[i] = storage.keys[index];
+            if(with_values)
+            {
+                values[i] = storage.values[index];
+            }
+        }
+    }
+    ::rocprim::syncthreads();
+
+    block_merge_sort<BlockSize, ItemsPerThread>(
+        keys, values, storage.keys, storage.values,
+        valid_count, compare_function
+    );
+
+    merge_store_from_shared<BlockSize, ItemsPerThread>(
+        keys_output + block_offset, keys, storage.keys, valid_count
+    );
+    if(with_values)
+    {
+        merge_store_from_shared<BlockSize, ItemsPerThread>(
+            values_output + block_offset, values, storage.values, valid_count
+        );
+    }
+}
+
+// Merges pairs of sorted runs of width items, every block produces one tile
+// of the merged sequence: the begin and end of its subranges are found by
+// merge path search in global memory, then the subranges are merged in shared memory.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void merge_sort_merge_kernel_impl(KeysInputIterator keys_input,
+                                  KeysOutputIterator keys_output,
+                                  ValuesInputIterator values_input,
+                                  ValuesOutputIterator values_output,
+                                  const size_t size,
+                                  const size_t width,
+                                  BinaryFunction compare_function)
+{
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        size_t begin1;
+        size_t end1;
+        key_type keys[items_per_block];
+        value_type values[with_values ? items_per_block : 1];
+    } storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+    const size_t block_offset = static_cast<size_t>(flat_block_id) * items_per_block;
+    const unsigned int valid_count = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(size - block_offset, items_per_block)
+    );
+
+    // Runs [group_begin, group_middle) and [group_middle, group_end) are merged
+    const size_t group_begin = block_offset / (2 * width) * (2 * width);
+    const size_t group_middle = ::rocprim::min(group_begin + width, size);
+    const size_t group_end = ::rocprim::min(group_begin + 2 * width, size);
+    const size_t size1 = group_middle - group_begin;
+    const size_t size2 = group_end - group_middle;
+    const size_t diagonal_begin = block_offset - group_begin;
+    const size_t diagonal_end = diagonal_begin + valid_count;
+
+    if(flat_id == 0)
+    {
+        storage.begin1 = merge_path(
+            keys_input + group_begin, keys_input + group_middle,
+            size1, size2, diagonal_begin, compare_function
+        );
+    }
+    if(flat_id == BlockSize - 1)
+    {
+        storage.end1 = merge_path(
+            keys_input + group_begin, keys_input + group_middle,
+            size1, size2, diagonal_end, compare_function
+        );
+    }
+    ::rocprim::syncthreads();
+
+    const size_t begin1 = storage.begin1;
+    const size_t begin2 = diagonal_begin - begin1;
+    const unsigned int count1 = static_cast<unsigned int>(storage.end1 - begin1);
+    const unsigned int count2 = valid_count - count1;
+
+    merge_tile<BlockSize, ItemsPerThread>(
+        keys_input + group_begin + begin1, keys_input + group_middle + begin2,
+        keys_output + block_offset,
+        values_input + group_begin + begin1, values_input + group_middle + begin2,
+        values_output + block_offset,
+        count1, count2,
+        storage.keys, storage.values,
+        compare_function
+    );
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_MERGE_SORT_HPP_
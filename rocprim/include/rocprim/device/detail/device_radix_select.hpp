@@ -0,0 +1,607 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_RADIX_SELECT_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_RADIX_SELECT_HPP_
+
+#include <type_traits>
+#include <iterator>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+#include "../../detail/radix_sort.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../functional.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_load_func.hpp"
+#include "../../block/block_reduce.hpp"
+#include "../../block/block_scan.hpp"
+
+#include "device_radix_sort.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Radix select looks for the key of rank k (1-based) in the order of encoded keys:
+// digits of the key found so far and the rank of the key among keys having these digits
+template<class BitKey>
+struct radix_select_state
+{
+    BitKey prefix;
+    size_t remaining;
+};
+
+// Mask of digits at bit and above
+template<class BitKey>
+ROCPRIM_HOST_DEVICE inline
+BitKey radix_select_prefix_mask(unsigned int bit)
+{
+    return bit >= sizeof(BitKey) * 8
+        ? BitKey(0)
+        : static_cast<BitKey>(~((BitKey(1) << bit) - 1));
+}
+
+// Accepts encoded keys that have the digits found in previous passes
+template<class BitKey>
+struct radix_select_prefix_filter
+{
+    BitKey mask;
+    BitKey prefix;
+
+    ROCPRIM_DEVICE inline
+    bool operator()(BitKey bit_key) const
+    {
+        return (bit_key & mask) == prefix;
+    }
+};
+
+template<
+    unsigned int BlockSize,
+    unsigned int RadixBits
+>
+struct radix_select_digit_helper
+{
+    static constexpr unsigned int radix_size = 1 << RadixBits;
+    static_assert(radix_size <= BlockSize, "Radix size must not exceed BlockSize");
+
+    using scan_type = ::rocprim::block_scan<size_t, BlockSize>;
+    using storage_type = typename scan_type::storage_type;
+
+    // i-th thread provides the count of i-th digit (0 if i >= radix_size). Returns true in
+    // the thread whose digit contains the remaining-th key, and its rank within the digit
+    // in remaining.
+    ROCPRIM_DEVICE inline
+    bool find_digit(size_t digit_count,
+                    size_t& remaining,
+                    storage_type& storage)
+    {
+        size_t digit_start;
+        scan_type().exclusive_scan(digit_count, digit_start, size_t(0), storage);
+        const bool found = digit_start < remaining && remaining <= digit_start + digit_count;
+        remaining -= digit_start;
+        return found;
+    }
+};
+
+template<class BitKey>
+ROCPRIM_DEVICE inline
+void radix_select_init(radix_select_state<BitKey> * state,
+                       unsigned long long * digit_counts,
+                       unsigned int radix_size,
+                       size_t k)
+{
+    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+    if(flat_id < radix_size)
+    {
+        digit_counts[flat_id] = 0;
+    }
+    if(flat_id == 0)
+    {
+        state->prefix = 0;
+        state->remaining = k;
+    }
+}
+
+// Every block counts digits of candidates in its range of items_per_range keys
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    bool Descending,
+    class KeysInputIterator,
+    class BitKey
+>
+ROCPRIM_DEVICE inline
+void radix_select_count_digits(KeysInputIterator keys_input,
+                               size_t size,
+                               unsigned int items_per_range,
+                               unsigned int bit,
+                               unsigned int current_radix_bits,
+                               BitKey prefix_mask,
+                               const radix_select_state<BitKey> * state,
+                               unsigned long long * digit_counts)
+{
+    constexpr unsigned int radix_size = 1 << RadixBits;
+
+    using count_helper_type = radix_digit_count_helper<BlockSize, ItemsPerThread, RadixBits, Descending>;
+
+    ROCPRIM_SHARED_MEMORY typename count_helper_type::storage_type storage;
+
+    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+    const size_t range_offset = static_cast<size_t>(::rocprim::detail::block_id<0>()) * items_per_range;
+    const unsigned int range_size = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(items_per_range, size - range_offset)
+    );
+
+    radix_select_prefix_filter<BitKey> filter;
+    filter.mask = prefix_mask;
+    filter.prefix = state->prefix;
+
+    unsigned int digit_count;
+    count_helper_type().count_digits(
+        keys_input + range_offset, 0, range_size,
+        bit, current_radix_bits,
+        filter,
+        storage, digit_count
+    );
+
+    if(flat_id < radix_size && digit_count > 0)
+    {
+        ::rocprim::atomic_add(&digit_counts[flat_id], static_cast<unsigned long long>(digit_count));
+    }
+}
+
+// Single block: appends the digit containing the searched key to the prefix and
+// resets counts for the next pass
+template<
+    unsigned int BlockSize,
+    unsigned int RadixBits,
+    class BitKey
+>
+ROCPRIM_DEVICE inline
+void radix_select_find_digit(unsigned long long * digit_counts,
+                             radix_select_state<BitKey> * state,
+                             unsigned int bit)
+{
+    constexpr unsigned int radix_size = 1 << RadixBits;
+
+    using digit_helper_type = radix_select_digit_helper<BlockSize, RadixBits>;
+
+    ROCPRIM_SHARED_MEMORY typename digit_helper_type::storage_type storage;
+
+    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+
+    size_t digit_count = 0;
+    if(flat_id < radix_size)
+    {
+        digit_count = digit_counts[flat_id];
+        digit_counts[flat_id] = 0;
+    }
+    size_t remaining = state->remaining;
+    if(digit_helper_type().find_digit(digit_count, remaining, storage))
+    {
+        state->prefix |= BitKey(flat_id) << bit;
+        state->remaining = remaining;
+    }
+}
+
+// Decodes keys found by radix select, one state per thread
+template<
+    unsigned int BlockSize,
+    bool Descending,
+    class Key,
+    class KeysOutputIterator,
+    class BitKey
+>
+ROCPRIM_DEVICE inline
+void radix_select_store_keys(const radix_select_state<BitKey> * states,
+                             unsigned int count,
+                             KeysOutputIterator keys_output)
+{
+    using key_codec = radix_key_codec<Key, Descending>;
+
+    const unsigned int id = ::rocprim::detail::block_id<0>() * BlockSize + ::rocprim::flat_block_thread_id();
+    if(id < count)
+    {
+        keys_output[id] = key_codec::decode(states[id].prefix);
+    }
+}
+
+// 0-based rank of the quantile p (0 <= p <= 1) among size keys: the lower of
+// the two keys nearest to the exact position p * (size - 1)
+inline
+size_t quantile_rank(double p, size_t size)
+{
+    const size_t rank = static_cast<size_t>(p * static_cast<double>(size - 1));
+    return ::rocprim::min(rank, size - 1);
+}
+
+// Counts keys that are selected entirely (less than the found key) and keys equal to it
+// in every block of items
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    bool Descending,
+    class KeysInputIterator,
+    class BitKey
+>
+ROCPRIM_DEVICE inline
+void radix_select_count_selected(KeysInputIterator keys_input,
+                                 size_t size,
+                                 const radix_select_state<BitKey> * state,
+                                 size_t * less_counts,
+                                 size_t * equal_counts)
+{
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, Descending>;
+    using reduce_type = ::rocprim::block_reduce<unsigned int, BlockSize>;
+
+    ROCPRIM_SHARED_MEMORY typename reduce_type::storage_type storage;
+
+    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+    const size_t block_offset = static_cast<size_t>(flat_block_id) * items_per_block;
+    const unsigned int valid_count = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(items_per_block, size - block_offset)
+    );
+    const BitKey threshold = state->prefix;
+
+    // Order of items is irrelevant, only totals matter
+    key_type keys[ItemsPerThread];
+    block_load_direct_striped<BlockSize>(flat_id, keys_input + block_offset, keys, valid_count);
+
+    unsigned int less = 0;
+    unsigned int equal = 0;
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        if(i * BlockSize + flat_id < valid_count)
+        {
+            const BitKey bit_key = key_codec::encode(keys[i]);
+            less += bit_key < threshold ? 1 : 0;
+            equal += bit_key == threshold ? 1 : 0;
+        }
+    }
+
+    unsigned int block_less;
+    reduce_type().reduce(less, block_less, storage);
+    ::rocprim::syncthreads();
+    unsigned int block_equal;
+    reduce_type().reduce(equal, block_equal, storage);
+
+    if(flat_id == 0)
+    {
+        less_counts[flat_block_id] = block_less;
+        equal_counts[flat_block_id] = block_equal;
+    }
+}
+
+// Writes selected keys (and values) preserving their order in the input:
+// all keys less than the found key and the first remaining keys equal to it
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class BitKey
+>
+ROCPRIM_DEVICE inline
+void radix_select_scatter(KeysInputIterator keys_input,
+                          KeysOutputIterator keys_output,
+                          ValuesInputIterator values_input,
+                          ValuesOutputIterator values_output,
+                          size_t size,
+                          size_t k,
+                          const radix_select_state<BitKey> * state,
+                          const size_t * less_offsets,
+                          const size_t * equal_offsets)
+{
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, Descending>;
+    using scan_type = ::rocprim::block_scan<unsigned int, BlockSize>;
+
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    ROCPRIM_SHARED_MEMORY typename scan_type::storage_type storage;
+
+    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+    const size_t block_offset = static_cast<size_t>(flat_block_id) * items_per_block;
+    const unsigned int valid_count = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(items_per_block, size - block_offset)
+    );
+    const BitKey threshold = state->prefix;
+    const size_t remaining = state->remaining;
+    const size_t less_total = k - remaining;
+
+    key_type keys[ItemsPerThread];
+    block_load_direct_blocked(flat_id, keys_input + block_offset, keys, valid_count);
+
+    unsigned int less_flags[ItemsPerThread];
+    unsigned int equal_flags[ItemsPerThread];
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        const bool valid = flat_id * ItemsPerThread + i < valid_count;
+        const BitKey bit_key = key_codec::encode(keys[i]);
+        less_flags[i] = valid && bit_key < threshold ? 1 : 0;
+        equal_flags[i] = valid && bit_key == threshold ? 1 : 0;
+    }
+
+    unsigned int less_ranks[ItemsPerThread];
+    unsigned int equal_ranks[ItemsPerThread];
+    scan_type().exclusive_scan(less_flags, less_ranks, 0u, storage);
+    ::rocprim::syncthreads();
+    scan_type().exclusive_scan(equal_flags, equal_ranks, 0u, storage);
+
+    const size_t less_offset = less_offsets[flat_block_id];
+    const size_t equal_offset = equal_offsets[flat_block_id];
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        size_t position;
+        if(less_flags[i])
+        {
+            position = less_offset + less_ranks[i];
+        }
+        else if(equal_flags[i] && equal_offset + equal_ranks[i] < remaining)
+        {
+            position = less_total + equal_offset + equal_ranks[i];
+        }
+        else
+        {
+            continue;
+        }
+        keys_output[position] = keys[i];
+        if(with_values)
+        {
+            values_output[position] = values_input[block_offset + flat_id * ItemsPerThread + i];
+        }
+    }
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    bool Descending,
+    class Key,
+    class Value
+>
+struct segmented_radix_select_helper
+{
+    static constexpr unsigned int radix_size = 1 << RadixBits;
+    static constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    using key_type = Key;
+    using value_type = Value;
+    using key_codec = radix_key_codec<key_type, Descending>;
+    using bit_key_type = typename key_codec::bit_key_type;
+    using count_helper_type = radix_digit_count_helper<BlockSize, ItemsPerThread, RadixBits, Descending>;
+    using digit_helper_type = radix_select_digit_helper<BlockSize, RadixBits>;
+    using scan_type = ::rocprim::block_scan<unsigned int, BlockSize>;
+
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    struct storage_type
+    {
+        union
+        {
+            typename count_helper_type::storage_type count;
+            typename digit_helper_type::storage_type digit;
+            typename scan_type::storage_type scan;
+        };
+        radix_select_state<bit_key_type> state;
+    };
+
+    template<
+        class KeysInputIterator,
+        class KeysOutputIterator,
+        class ValuesInputIterator,
+        class ValuesOutputIterator
+    >
+    ROCPRIM_DEVICE inline
+    void select(KeysInputIterator keys_input,
+                KeysOutputIterator keys_output,
+                ValuesInputIterator values_input,
+                ValuesOutputIterator values_output,
+                unsigned int segment_size,
+                unsigned int selected_count,
+                storage_type& storage)
+    {
+        const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+
+        if(selected_count == 0)
+        {
+            return;
+        }
+        if(selected_count == segment_size)
+        {
+            for(unsigned int i = flat_id; i < segment_size; i += BlockSize)
+            {
+                keys_output[i] = keys_input[i];
+                if(with_values)
+                {
+                    values_output[i] = values_input[i];
+                }
+            }
+            return;
+        }
+
+        // Find the selected_count-th key digit by digit, every pass counts only keys
+        // with already found digits
+        bit_key_type prefix = 0;
+        size_t remaining = selected_count;
+        for(unsigned int bit = key_codec::key_bits; bit > 0; )
+        {
+            const unsigned int current_radix_bits = ::rocprim::min(RadixBits, bit);
+            bit -= current_radix_bits;
+
+            radix_select_prefix_filter<bit_key_type> filter;
+            filter.mask = radix_select_prefix_mask<bit_key_type>(bit + current_radix_bits);
+            filter.prefix = prefix;
+
+            unsigned int digit_count;
+            count_helper_type().count_digits(
+                keys_input, 0, segment_size,
+                bit, current_radix_bits,
+                filter,
+                storage.count, digit_count
+            );
+            ::rocprim::syncthreads();
+
+            size_t digit_remaining = remaining;
+            if(digit_helper_type().find_digit(digit_count, digit_remaining, storage.digit))
+            {
+                storage.state.prefix = prefix | (bit_key_type(flat_id) << bit);
+                storage.state.remaining = digit_remaining;
+            }
+            ::rocprim::syncthreads();
+            prefix = storage.state.prefix;
+            remaining = storage.state.remaining;
+        }
+
+        const unsigned int less_total = selected_count - static_cast<unsigned int>(remaining);
+        unsigned int less_offset = 0;
+        unsigned int equal_offset = 0;
+        for(unsigned int block_offset = 0; block_offset < segment_size; block_offset += items_per_block)
+        {
+            const unsigned int valid_count = ::rocprim::min(items_per_block, segment_size - block_offset);
+
+            key_type keys[ItemsPerThread];
+            block_load_direct_blocked(flat_id, keys_input + block_offset, keys, valid_count);
+
+            unsigned int less_flags[ItemsPerThread];
+            unsigned int equal_flags[ItemsPerThread];
+            for(unsigned int i = 0; i < ItemsPerThread; i++)
+            {
+                const bool valid = flat_id * ItemsPerThread + i < valid_count;
+                const bit_key_type bit_key = key_codec::encode(keys[i]);
+                less_flags[i] = valid && bit_key < prefix ? 1 : 0;
+                equal_flags[i] = valid && bit_key == prefix ? 1 : 0;
+            }
+
+            unsigned int less_ranks[ItemsPerThread];
+            unsigned int equal_ranks[ItemsPerThread];
+            unsigned int less_count;
+            unsigned int equal_count;
+            scan_type().exclusive_scan(less_flags, less_ranks, 0u, less_count, storage.scan);
+            ::rocprim::syncthreads();
+            scan_type().exclusive_scan(equal_flags, equal_ranks, 0u, equal_count, storage.scan);
+            ::rocprim::syncthreads();
+
+            for(unsigned int i = 0; i < ItemsPerThread; i++)
+            {
+                unsigned int position;
+                if(less_flags[i])
+                {
+                    position = less_offset + less_ranks[i];
+                }
+                else if(equal_flags[i] && equal_offset + equal_ranks[i] < remaining)
+                {
+                    position = less_total + equal_offset + equal_ranks[i];
+                }
+                else
+                {
+                    continue;
+                }
+                keys_output[position] = keys[i];
+                if(with_values)
+                {
+                    values_output[position] = values_input[block_offset + flat_id * ItemsPerThread + i];
+                }
+            }
+            less_offset += less_count;
+            equal_offset += equal_count;
+        }
+    }
+};
+
+// One block selects k keys of a segment, they are written to k positions starting
+// from segment_id * k. Ranges of selected keys are written to selected_begin_offsets
+// and selected_end_offsets (if not null) for sorting.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator
+>
+ROCPRIM_DEVICE inline
+void segmented_radix_select(KeysInputIterator keys_input,
+                            KeysOutputIterator keys_output,
+                            ValuesInputIterator values_input,
+                            ValuesOutputIterator values_output,
+                            OffsetIterator begin_offsets,
+                            OffsetIterator end_offsets,
+                            unsigned int k,
+                            unsigned int * selected_begin_offsets,
+                            unsigned int * selected_end_offsets)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using select_helper = segmented_radix_select_helper<
+        BlockSize, ItemsPerThread, RadixBits, Descending,
+        key_type, value_type
+    >;
+
+    ROCPRIM_SHARED_MEMORY typename select_helper::storage_type storage;
+
+    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+    const unsigned int segment_id = ::rocprim::detail::block_id<0>();
+
+    const size_t begin_offset = begin_offsets[segment_id];
+    const unsigned int segment_size = static_cast<unsigned int>(end_offsets[segment_id] - begin_offset);
+    const unsigned int selected_count = ::rocprim::min(k, segment_size);
+    const size_t output_offset = static_cast<size_t>(segment_id) * k;
+
+    if(flat_id == 0 && selected_begin_offsets != nullptr)
+    {
+        selected_begin_offsets[segment_id] = static_cast<unsigned int>(output_offset);
+        selected_end_offsets[segment_id] = static_cast<unsigned int>(output_offset + selected_count);
+    }
+
+    select_helper().select(
+        keys_input + begin_offset, keys_output + output_offset,
+        values_input + begin_offset, values_output + output_offset,
+        segment_size, selected_count,
+        storage
+    );
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_RADIX_SELECT_HPP_
@@ -39,11 +39,23 @@
 #include "../../block/block_scan.hpp"
 #include "../../block/block_radix_sort.hpp"
 
+#include "lookback_scan_state.hpp"
+
 BEGIN_ROCPRIM_NAMESPACE
 
 namespace detail
 {
 
+struct radix_digit_count_all
+{
+    template<class BitKey>
+    ROCPRIM_DEVICE inline
+    bool operator()(BitKey) const
+    {
+        return true;
+    }
+};
+
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
@@ -73,6 +85,26 @@ struct radix_digit_count_helper
                       unsigned int current_radix_bits,
                       storage_type& storage,
                       unsigned int& digit_count)  // i-th thread will get i-th digit's value
+    {
+        count_digits(
+            keys_input, begin_offset, end_offset,
+            bit, current_radix_bits,
+            radix_digit_count_all(),
+            storage, digit_count
+        );
+    }
+
+    // Counts digits only of keys whose encoded (bit) keys pass filter
+    template<class KeysInputIterator, class KeyFilter>
+    ROCPRIM_DEVICE inline
+    void count_digits(KeysInputIterator keys_input,
+                      unsigned int begin_offset,
+                      unsigned int end_offset,
+                      unsigned int bit,
+                      unsigned int current_radix_bits,
+                      KeyFilter filter,
+                      storage_type& storage,
+                      unsigned int& digit_count)  // i-th thread will get i-th digit's value
     {
         constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
 
@@ -121,7 +153,8 @@ struct radix_digit_count_helper
             {
                 const unsigned int digit = (bit_keys[i] >> bit) & radix_mask;
                 const unsigned int pos = i * BlockSize + flat_id;
-                unsigned long long same_digit_lanes_mask = ::rocprim::ballot(pos < valid_count);
+                unsigned long long same_digit_lanes_mask =
+                    ::rocprim::ballot(pos < valid_count && filter(bit_keys[i]));
                 for(unsigned int b = 0; b < RadixBits; b++)
                 {
                     const unsigned int bit_set = digit & (1u << b);
@@ -157,7 +190,8 @@ template<
     unsigned int RadixBits,
     bool Descending,
     class Key,
-    class Value
+    class Value,
+    class Offset = unsigned int
 >
 struct radix_sort_and_scatter_helper
 {
@@ -197,7 +231,7 @@ struct radix_sort_and_scatter_helper
         unsigned short starts[radix_size];
         unsigned short ends[radix_size];
 
-        unsigned int digit_starts[radix_size];
+        Offset digit_starts[radix_size];
     };
 
     template<
@@ -364,31 +398,77 @@ struct radix_sort_and_scatter_helper
     }
 };
 
+// Number of digit places (passes) needed to sort keys with RadixBits-bit digits
+template<class Key, unsigned int RadixBits>
+struct radix_sort_max_iterations
+{
+    static constexpr unsigned int value = (radix_key_codec<Key, false>::key_bits + RadixBits - 1) / RadixBits;
+};
+
+// Resets digit counts of all passes (before the histogram kernel) and the state
+// of look-back over tile digit counts (before every onesweep pass).
+template<class LookbackScanState, class Offset>
+ROCPRIM_DEVICE inline
+void onesweep_init_kernel_impl(LookbackScanState lookback_state,
+                               unsigned int number_of_prefixes,
+                               ordered_block_id<unsigned int> ordered_bid,
+                               Offset * digit_counts,
+                               unsigned int digit_counts_size)
+{
+    const unsigned int id = ::rocprim::detail::block_id<0>() * ::rocprim::detail::block_size<0>()
+        + ::rocprim::detail::block_thread_id<0>();
+    if(id < digit_counts_size)
+    {
+        digit_counts[id] = 0;
+    }
+    init_lookback_scan_state_kernel_impl(lookback_state, number_of_prefixes, ordered_bid);
+}
+
+// Counts digits of all passes in a single read of keys. Every block processes
+// a batch of consecutive tiles and adds its totals to digit_counts
+// (iterations rows of radix_size counters).
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
     unsigned int RadixBits,
     bool Descending,
-    class KeysInputIterator
+    class KeysInputIterator,
+    class Offset
 >
 ROCPRIM_DEVICE inline
-void fill_digit_counts(KeysInputIterator keys_input,
-                       unsigned int size,
-                       unsigned int * batch_digit_counts,
-                       unsigned int bit,
-                       unsigned int current_radix_bits,
-                       unsigned int blocks_per_full_batch,
-                       unsigned int full_batches)
+void onesweep_histograms(KeysInputIterator keys_input,
+                         unsigned int size,
+                         Offset * digit_counts,
+                         unsigned int begin_bit,
+                         unsigned int end_bit,
+                         unsigned int blocks_per_full_batch,
+                         unsigned int full_batches)
 {
     constexpr unsigned int radix_size = 1 << RadixBits;
     constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
 
-    using count_helper_type = radix_digit_count_helper<BlockSize, ItemsPerThread, RadixBits, Descending>;
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, Descending>;
+    using bit_key_type = typename key_codec::bit_key_type;
 
-    ROCPRIM_SHARED_MEMORY typename count_helper_type::storage_type storage;
+    constexpr unsigned int max_iterations = radix_sort_max_iterations<key_type, RadixBits>::value;
+
+    static_assert(radix_size <= BlockSize, "Radix size must not exceed BlockSize");
+
+    ROCPRIM_SHARED_MEMORY unsigned int block_digit_counts[max_iterations][radix_size];
 
     const unsigned int flat_id = ::rocprim::flat_block_thread_id();
     const unsigned int batch_id = ::rocprim::detail::block_id<0>();
+    const unsigned int iterations = ::rocprim::detail::ceiling_div(end_bit - begin_bit, RadixBits);
+
+    if(flat_id < radix_size)
+    {
+        for(unsigned int i = 0; i < max_iterations; i++)
+        {
+            block_digit_counts[i][flat_id] = 0;
+        }
+    }
+    ::rocprim::syncthreads();
 
     unsigned int block_offset;
     unsigned int blocks_per_batch;
@@ -403,79 +483,97 @@ void fill_digit_counts(KeysInputIterator keys_input,
         block_offset = batch_id * blocks_per_batch + full_batches;
     }
     block_offset *= items_per_block;
+    const unsigned int end_offset = ::rocprim::min(size, block_offset + blocks_per_batch * items_per_block);
 
-    unsigned int digit_count;
-    count_helper_type().count_digits(
-        keys_input,
-        block_offset, std::min(size, block_offset + blocks_per_batch * items_per_block),
-        bit, current_radix_bits,
-        storage,
-        digit_count
-    );
-
-    if(flat_id < radix_size)
+    for(; block_offset < end_offset; block_offset += items_per_block)
     {
-        batch_digit_counts[batch_id * radix_size + flat_id] = digit_count;
-    }
-}
-
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    unsigned int RadixBits
->
-ROCPRIM_DEVICE inline
-void scan_batches(unsigned int * batch_digit_counts,
-                  unsigned int * digit_counts,
-                  unsigned int batches)
-{
-    constexpr unsigned int radix_size = 1 << RadixBits;
-
-    using scan_type = typename ::rocprim::block_scan<unsigned int, BlockSize>;
-
-    const unsigned int digit = ::rocprim::detail::block_id<0>();
-    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
-
-    unsigned int values[ItemsPerThread];
-    for(unsigned int i = 0; i < ItemsPerThread; i++)
-    {
-        const unsigned int batch_id = flat_id * ItemsPerThread + i;
-        values[i] = (batch_id < batches ? batch_digit_counts[batch_id * radix_size + digit] : 0);
-    }
-
-    unsigned int digit_count;
-    scan_type().exclusive_scan(values, values, 0, digit_count);
+        key_type keys[ItemsPerThread];
+        unsigned int valid_count;
+        // Use loading into a striped arrangement because an order of items is irrelevant,
+        // only totals matter
+        if(block_offset + items_per_block <= end_offset)
+        {
+            valid_count = items_per_block;
+            block_load_direct_striped<BlockSize>(flat_id, keys_input + block_offset, keys);
+        }
+        else
+        {
+            valid_count = end_offset - block_offset;
+            block_load_direct_striped<BlockSize>(flat_id, keys_input + block_offset, keys, valid_count);
+        }
 
-    for(unsigned int i = 0; i < ItemsPerThread; i++)
-    {
-        const unsigned int batch_id = flat_id * ItemsPerThread + i;
-        if(batch_id < batches)
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
         {
-            batch_digit_counts[batch_id * radix_size + digit] = values[i];
+            if(i * BlockSize + flat_id < valid_count)
+            {
+                const bit_key_type bit_key = key_codec::encode(keys[i]);
+                for(unsigned int iteration = 0; iteration < iterations; iteration++)
+                {
+                    const unsigned int bit = begin_bit + iteration * RadixBits;
+                    const unsigned int current_radix_bits = ::rocprim::min(RadixBits, end_bit - bit);
+                    const unsigned int digit = (bit_key >> bit) & ((1u << current_radix_bits) - 1);
+                    ::rocprim::atomic_add(&block_digit_counts[iteration][digit], 1);
+                }
+            }
         }
     }
+    ::rocprim::syncthreads();
 
-    if(flat_id == 0)
+    if(flat_id < radix_size)
     {
-        digit_counts[digit] = digit_count;
+        for(unsigned int iteration = 0; iteration < iterations; iteration++)
+        {
+            const unsigned int count = block_digit_counts[iteration][flat_id];
+            if(count != 0)
+            {
+                ::rocprim::atomic_add(&digit_counts[iteration * radix_size + flat_id], Offset(count));
+            }
+        }
     }
 }
 
-template<unsigned int RadixBits>
+// Converts digit counts of every pass into digit starts (one block per pass).
+// Keys are counted in chunks (chunks * grid size rows of radix_size counters),
+// start of digit d of chunk c is the total count of smaller digits plus counts
+// of digit d in preceding chunks. Counts of all passes are scanned at once only
+// for one chunk, several chunks are counted and scanned before every pass.
+template<unsigned int RadixBits, class Offset>
 ROCPRIM_DEVICE inline
-void scan_digits(unsigned int * digit_counts)
+void onesweep_scan_digits(Offset * digit_counts,
+                          unsigned int chunks)
 {
     constexpr unsigned int radix_size = 1 << RadixBits;
 
-    using scan_type = typename ::rocprim::block_scan<unsigned int, radix_size>;
+    using scan_type = typename ::rocprim::block_scan<Offset, radix_size>;
 
     const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+    const unsigned int iteration = ::rocprim::detail::block_id<0>();
+    const unsigned int iterations = ::rocprim::detail::grid_size<0>();
+    const unsigned int chunk_stride = iterations * radix_size;
+    const unsigned int index = iteration * radix_size + flat_id;
 
-    unsigned int value = digit_counts[flat_id];
-    scan_type().exclusive_scan(value, value, 0);
-    digit_counts[flat_id] = value;
+    Offset total = 0;
+    for(unsigned int chunk = 0; chunk < chunks; chunk++)
+    {
+        total += digit_counts[chunk * chunk_stride + index];
+    }
+    Offset start;
+    scan_type().exclusive_scan(total, start, 0);
+    for(unsigned int chunk = 0; chunk < chunks; chunk++)
+    {
+        const Offset count = digit_counts[chunk * chunk_stride + index];
+        digit_counts[chunk * chunk_stride + index] = start;
+        start += count;
+    }
 }
 
+// Single pass of onesweep radix sort: every block sorts one tile by the current
+// digit and gets the global offset of each of its digits by chained look-back
+// over counts of the same digit in preceding tiles. lookback_state must have
+// (number of tiles * radix_size) prefixes: the prefix of digit d of tile t
+// is stored at t * radix_size + d.
+// Inputs are a chunk of at most UINT_MAX keys (positions within the chunk are
+// 32-bit), Offset is the type of positions in outputs.
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
@@ -484,20 +582,21 @@ template<
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
-    class ValuesOutputIterator
+    class ValuesOutputIterator,
+    class Offset,
+    class LookbackScanState
 >
 ROCPRIM_DEVICE inline
-void sort_and_scatter(KeysInputIterator keys_input,
-                      KeysOutputIterator keys_output,
-                      ValuesInputIterator values_input,
-                      ValuesOutputIterator values_output,
-                      unsigned int size,
-                      const unsigned int * batch_digit_starts,
-                      const unsigned int * digit_starts,
-                      unsigned int bit,
-                      unsigned int current_radix_bits,
-                      unsigned int blocks_per_full_batch,
-                      unsigned int full_batches)
+void onesweep_sort_and_scatter(KeysInputIterator keys_input,
+                               KeysOutputIterator keys_output,
+                               ValuesInputIterator values_input,
+                               ValuesOutputIterator values_output,
+                               unsigned int size,
+                               const Offset * digit_starts,
+                               unsigned int bit,
+                               unsigned int current_radix_bits,
+                               LookbackScanState lookback_state,
+                               ordered_block_id<unsigned int> ordered_bid)
 {
     constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
     constexpr unsigned int radix_size = 1 << RadixBits;
@@ -505,43 +604,169 @@ void sort_and_scatter(KeysInputIterator keys_input,
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
 
-    using sort_and_scatter_helper = radix_sort_and_scatter_helper<
+    using helper_type = radix_sort_and_scatter_helper<
         BlockSize, ItemsPerThread, RadixBits, Descending,
-        key_type, value_type
+        key_type, value_type, Offset
     >;
+    using key_codec = typename helper_type::key_codec;
+    using bit_key_type = typename helper_type::bit_key_type;
+    using flag_type = typename LookbackScanState::flag_type;
+    using ordered_block_id_type = ordered_block_id<unsigned int>;
 
-    ROCPRIM_SHARED_MEMORY typename sort_and_scatter_helper::storage_type storage;
+    constexpr bool with_values = helper_type::with_values;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename ordered_block_id_type::storage_type ordered_bid;
+        typename helper_type::storage_type helper;
+    } storage;
+
+    const unsigned int radix_mask = (1u << current_radix_bits) - 1;
 
     const unsigned int flat_id = ::rocprim::flat_block_thread_id();
-    const unsigned int batch_id = ::rocprim::detail::block_id<0>();
+    const unsigned int block_id = ordered_bid.get(flat_id, storage.ordered_bid);
+    const unsigned int block_offset = block_id * items_per_block;
 
-    unsigned int block_offset;
-    unsigned int blocks_per_batch;
-    if(batch_id < full_batches)
+    key_type keys[ItemsPerThread];
+    value_type values[ItemsPerThread];
+    unsigned int valid_count;
+    if(block_offset + items_per_block <= size)
     {
-        blocks_per_batch = blocks_per_full_batch;
-        block_offset = batch_id * blocks_per_batch;
+        valid_count = items_per_block;
+        typename helper_type::keys_load_type().load(keys_input + block_offset, keys, storage.helper.keys_load);
+        if(with_values)
+        {
+            ::rocprim::syncthreads();
+            typename helper_type::values_load_type().load(values_input + block_offset, values, storage.helper.values_load);
+        }
     }
     else
     {
-        blocks_per_batch = blocks_per_full_batch - 1;
-        block_offset = batch_id * blocks_per_batch + full_batches;
+        valid_count = size - block_offset;
+        // Sort will leave "invalid" (out of size) items at the end of the sorted sequence
+        const key_type out_of_bounds = key_codec::decode(bit_key_type(-1));
+        typename helper_type::keys_load_type().load(keys_input + block_offset, keys, valid_count, out_of_bounds, storage.helper.keys_load);
+        if(with_values)
+        {
+            ::rocprim::syncthreads();
+            typename helper_type::values_load_type().load(values_input + block_offset, values, valid_count, storage.helper.values_load);
+        }
     }
-    block_offset *= items_per_block;
+    bit_key_type bit_keys[ItemsPerThread];
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        bit_keys[i] = key_codec::encode(keys[i]);
+    }
+
+    if(flat_id < radix_size)
+    {
+        storage.helper.starts[flat_id] = valid_count;
+        storage.helper.ends[flat_id] = valid_count;
+    }
+
+    ::rocprim::syncthreads();
+    helper_type().sort_block(bit_keys, values, storage.helper, bit, bit + current_radix_bits);
+
+    unsigned int digits[ItemsPerThread];
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        digits[i] = (bit_keys[i] >> bit) & radix_mask;
+    }
+
+    bool head_flags[ItemsPerThread];
+    bool tail_flags[ItemsPerThread];
+    ::rocprim::not_equal_to<unsigned int> flag_op;
 
-    unsigned int digit_start = 0;
+    ::rocprim::syncthreads();
+    typename helper_type::discontinuity_type().flag_heads_and_tails(
+        head_flags, tail_flags, digits, flag_op, storage.helper.discontinuity
+    );
+
+    // Fill start and end position of subsequence for every digit
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        const unsigned int digit = digits[i];
+        const unsigned int pos = flat_id * ItemsPerThread + i;
+        if(head_flags[i])
+        {
+            storage.helper.starts[digit] = pos;
+        }
+        if(tail_flags[i])
+        {
+            storage.helper.ends[digit] = pos;
+        }
+    }
+    ::rocprim::syncthreads();
+
+    // Publish digit counts of the tile as early as possible, so succeeding
+    // tiles can continue their look-back
+    unsigned int digit_count = 0;
     if(flat_id < radix_size)
     {
-        digit_start = digit_starts[flat_id] + batch_digit_starts[batch_id * radix_size + flat_id];
+        const unsigned int start = storage.helper.starts[flat_id];
+        const unsigned int end = storage.helper.ends[flat_id];
+        if(start < valid_count)
+        {
+            digit_count = ::rocprim::min(valid_count - 1, end) - start + 1;
+        }
+        if(block_id == 0)
+        {
+            lookback_state.set_complete(flat_id, digit_count);
+        }
+        else
+        {
+            lookback_state.set_partial(block_id * radix_size + flat_id, digit_count);
+        }
     }
 
-    sort_and_scatter_helper().sort_and_scatter(
-        keys_input, keys_output, values_input, values_output,
-        block_offset, std::min(size, block_offset + blocks_per_batch * items_per_block),
-        bit, current_radix_bits,
-        digit_start,
-        storage
+    // Rearrange to striped arrangement to have faster coalesced writes instead of
+    // scattering of blocked-arranged items
+    typename helper_type::bit_keys_exchange_type().blocked_to_striped(
+        bit_keys, bit_keys, storage.helper.bit_keys_exchange
     );
+    if(with_values)
+    {
+        ::rocprim::syncthreads();
+        typename helper_type::values_exchange_type().blocked_to_striped(
+            values, values, storage.helper.values_exchange
+        );
+    }
+
+    // i-th thread looks back over counts of i-th digit in preceding tiles
+    if(flat_id < radix_size)
+    {
+        unsigned int prefix = 0;
+        if(block_id > 0)
+        {
+            unsigned int previous_block_id = block_id - 1;
+            flag_type flag;
+            do
+            {
+                unsigned int count;
+                lookback_state.get(previous_block_id * radix_size + flat_id, flag, count);
+                prefix += count;
+                previous_block_id--;
+            } while(flag != PREFIX_COMPLETE);
+            lookback_state.set_complete(block_id * radix_size + flat_id, prefix + digit_count);
+        }
+        storage.helper.digit_starts[flat_id] = digit_starts[flat_id] + prefix;
+    }
+    ::rocprim::syncthreads();
+
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        const unsigned int digit = (bit_keys[i] >> bit) & radix_mask;
+        const unsigned int pos = i * BlockSize + flat_id;
+        if(pos < valid_count)
+        {
+            const Offset dst = storage.helper.digit_starts[digit] + (pos - storage.helper.starts[digit]);
+            keys_output[dst] = key_codec::decode(bit_keys[i]);
+            if(with_values)
+            {
+                values_output[dst] = values[i];
+            }
+        }
+    }
 }
 
 } // end namespace detail
@@ -22,7 +22,7 @@
 #define ROCPRIM_DEVICE_DETAIL_DEVICE_REDUCE_BY_KEY_HPP_
 
 #include <iterator>
-#include <utility>
+#include <type_traits>
 
 #include "../../config.hpp"
 #include "../../detail/various.hpp"
@@ -35,20 +35,13 @@
 #include "../../block/block_store.hpp"
 #include "../../block/block_scan.hpp"
 
+#include "lookback_scan_state.hpp"
+
 BEGIN_ROCPRIM_NAMESPACE
 
 namespace detail
 {
 
-template<class Key, class Value>
-struct carry_out
-{
-    Key key;
-    Value value;
-    unsigned int destination;
-    unsigned int is_final_aggregate;
-};
-
 template<class Value>
 struct scan_by_key_pair
 {
@@ -101,191 +94,12 @@ struct key_flag_op
     }
 };
 
-// This wrapper processes only part of items and flags (valid_count - 1)th item (for tails)
-// and (valid_count)th item (for heads), all items after valid_count are unflagged.
-template<class Key, class KeyCompareFunction>
-struct guarded_key_flag_op
-{
-    KeyCompareFunction key_compare_op;
-    unsigned int valid_count;
-
-    ROCPRIM_DEVICE inline
-    guarded_key_flag_op(KeyCompareFunction key_compare_op, unsigned int valid_count)
-        : key_compare_op(key_compare_op), valid_count(valid_count)
-    {}
-
-    ROCPRIM_DEVICE inline
-    bool operator()(const Key& a, const Key& b, unsigned int b_index) const
-    {
-        return (b_index < valid_count && !key_compare_op(a, b)) || b_index == valid_count;
-    }
-};
-
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class KeysInputIterator,
-    class KeyCompareFunction
->
-ROCPRIM_DEVICE inline
-void fill_unique_counts(KeysInputIterator keys_input,
-                        unsigned int size,
-                        unsigned int * unique_counts,
-                        KeyCompareFunction key_compare_op,
-                        unsigned int blocks_per_full_batch,
-                        unsigned int full_batches,
-                        unsigned int blocks)
-{
-    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
-    constexpr unsigned int warp_size = ::rocprim::warp_size();
-    constexpr unsigned int warps_no = BlockSize / warp_size;
-
-    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
-
-    using keys_load_type = ::rocprim::block_load<
-        key_type, BlockSize, ItemsPerThread,
-        ::rocprim::block_load_method::block_load_transpose>;
-    using discontinuity_type = ::rocprim::block_discontinuity<key_type, BlockSize>;
-
-    ROCPRIM_SHARED_MEMORY struct
-    {
-        union
-        {
-            typename keys_load_type::storage_type keys_load;
-            typename discontinuity_type::storage_type discontinuity;
-        };
-        unsigned int unique_counts[warps_no];
-    } storage;
-
-    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
-    const unsigned int batch_id = ::rocprim::detail::block_id<0>();
-    const unsigned int lane_id = ::rocprim::lane_id();
-    const unsigned int warp_id = ::rocprim::warp_id();
-
-    unsigned int block_id;
-    unsigned int blocks_per_batch;
-    if(batch_id < full_batches)
-    {
-        blocks_per_batch = blocks_per_full_batch;
-        block_id = batch_id * blocks_per_batch;
-    }
-    else
-    {
-        blocks_per_batch = blocks_per_full_batch - 1;
-        block_id = batch_id * blocks_per_batch + full_batches;
-    }
-
-    unsigned int warp_unique_count = 0;
-
-    for(unsigned int bi = 0; bi < blocks_per_batch; bi++)
-    {
-        const unsigned int block_offset = block_id * items_per_block;
-
-        key_type keys[ItemsPerThread];
-        unsigned int valid_count;
-        if(block_offset + items_per_block <= size)
-        {
-            valid_count = items_per_block;
-            keys_load_type().load(keys_input + block_offset, keys, storage.keys_load);
-        }
-        else
-        {
-            valid_count = size - block_offset;
-            keys_load_type().load(keys_input + block_offset, keys, valid_count, storage.keys_load);
-        }
-
-        bool tail_flags[ItemsPerThread];
-        key_type successor_key = keys[ItemsPerThread - 1];
-        ::rocprim::syncthreads();
-        if(block_id == blocks - 1)
-        {
-            discontinuity_type().flag_tails(
-                tail_flags, successor_key, keys,
-                guarded_key_flag_op<key_type, KeyCompareFunction>(key_compare_op, valid_count),
-                storage.discontinuity
-            );
-        }
-        else
-        {
-            if(flat_id == BlockSize - 1)
-            {
-                successor_key = keys_input[block_offset + items_per_block];
-            }
-            discontinuity_type().flag_tails(
-                tail_flags, successor_key, keys,
-                key_flag_op<key_type, KeyCompareFunction>(key_compare_op),
-                storage.discontinuity
-            );
-        }
-
-        for(unsigned int i = 0; i < ItemsPerThread; i++)
-        {
-            warp_unique_count += ::rocprim::bit_count(::rocprim::ballot(tail_flags[i]));
-        }
-
-        block_id++;
-    }
-
-    if(lane_id == 0)
-    {
-        storage.unique_counts[warp_id] = warp_unique_count;
-    }
-    ::rocprim::syncthreads();
-
-    if(flat_id == 0)
-    {
-        unsigned int batch_unique_count = 0;
-        for(unsigned int w = 0; w < warps_no; w++)
-        {
-            batch_unique_count += storage.unique_counts[w];
-        }
-        unique_counts[batch_id] = batch_unique_count;
-    }
-}
-
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class UniqueCountOutputIterator
->
-ROCPRIM_DEVICE inline
-void scan_unique_counts(unsigned int * unique_counts,
-                        UniqueCountOutputIterator unique_count_output,
-                        unsigned int batches)
-{
-    using load_type = ::rocprim::block_load<
-        unsigned int, BlockSize, ItemsPerThread,
-        ::rocprim::block_load_method::block_load_transpose>;
-    using store_type = ::rocprim::block_store<
-        unsigned int, BlockSize, ItemsPerThread,
-        ::rocprim::block_store_method::block_store_transpose>;
-    using scan_type = typename ::rocprim::block_scan<unsigned int, BlockSize>;
-
-    ROCPRIM_SHARED_MEMORY union
-    {
-        typename load_type::storage_type load;
-        typename store_type::storage_type store;
-        typename scan_type::storage_type scan;
-    } storage;
-
-    const unsigned int flat_id = ::rocprim::flat_block_thread_id();
-
-    unsigned int values[ItemsPerThread];
-    load_type().load(unique_counts, values, batches, 0, storage.load);
-
-    unsigned int unique_count;
-    ::rocprim::syncthreads();
-    scan_type().exclusive_scan(values, values, 0, unique_count);
-
-    ::rocprim::syncthreads();
-    store_type().store(unique_counts, values, batches, storage.store);
-
-    if(flat_id == 0)
-    {
-        *unique_count_output = unique_count;
-    }
-}
-
+// Single-pass reduce-by-key: every block flags heads of segments in its tile and scans
+// pairs (number of heads, reduction since the last head) with decoupled look-back.
+// The exclusive prefix of a head gives the index of its unique key and the aggregate
+// of the previous segment, including values from preceding tiles (carry-in), so keys
+// are read only once and no separate passes over unique counts or carry-outs are needed.
+// The last block writes the aggregate of the last segment and the number of unique keys.
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
@@ -293,28 +107,33 @@ template<
     class ValuesInputIterator,
     class UniqueOutputIterator,
     class AggregatesOutputIterator,
-    class CarryOut,
+    class UniqueCountOutputIterator,
     class KeyCompareFunction,
-    class BinaryFunction
+    class BinaryFunction,
+    class LookbackScanState
 >
 ROCPRIM_DEVICE inline
-void reduce_by_key(KeysInputIterator keys_input,
-                   ValuesInputIterator values_input,
-                   unsigned int size,
-                   const unsigned int * unique_starts,
-                   CarryOut * carry_outs,
-                   UniqueOutputIterator unique_output,
-                   AggregatesOutputIterator aggregates_output,
-                   KeyCompareFunction key_compare_op,
-                   BinaryFunction reduce_op,
-                   unsigned int blocks_per_full_batch,
-                   unsigned int full_batches,
-                   unsigned int blocks)
+void reduce_by_key_kernel_impl(KeysInputIterator keys_input,
+                               ValuesInputIterator values_input,
+                               const unsigned int size,
+                               UniqueOutputIterator unique_output,
+                               AggregatesOutputIterator aggregates_output,
+                               UniqueCountOutputIterator unique_count_output,
+                               KeyCompareFunction key_compare_op,
+                               BinaryFunction reduce_op,
+                               LookbackScanState scan_state,
+                               const unsigned int number_of_blocks,
+                               ordered_block_id<unsigned int> ordered_bid)
 {
     constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
 
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using pair_type = scan_by_key_pair<value_type>;
+    static_assert(
+        std::is_same<pair_type, typename LookbackScanState::value_type>::value,
+        "value_type of LookbackScanState must be scan_by_key_pair<value_type>"
+    );
 
     using keys_load_type = ::rocprim::block_load<
         key_type, BlockSize, ItemsPerThread,
@@ -323,10 +142,16 @@ void reduce_by_key(KeysInputIterator keys_input,
         value_type, BlockSize, ItemsPerThread,
         ::rocprim::block_load_method::block_load_transpose>;
     using discontinuity_type = ::rocprim::block_discontinuity<key_type, BlockSize>;
-    using scan_type = ::rocprim::block_scan<scan_by_key_pair<value_type>, BlockSize>;
+    using scan_type = ::rocprim::block_scan<pair_type, BlockSize>;
+    using scan_op_type = scan_by_key_op<pair_type, BinaryFunction>;
+    using ordered_block_id_type = ordered_block_id<unsigned int>;
+    using lookback_scan_prefix_op_type = lookback_scan_prefix_op<
+        pair_type, scan_op_type, LookbackScanState
+    >;
 
     ROCPRIM_SHARED_MEMORY struct
     {
+        typename ordered_block_id_type::storage_type ordered_bid;
         union
         {
             typename keys_load_type::storage_type keys_load;
@@ -334,279 +159,127 @@ void reduce_by_key(KeysInputIterator keys_input,
             typename discontinuity_type::storage_type discontinuity;
             typename scan_type::storage_type scan;
         };
-        unsigned int unique_count;
-        bool has_carry_out;
-        value_type carry_out;
     } storage;
 
     const unsigned int flat_id = ::rocprim::flat_block_thread_id();
-    const unsigned int batch_id = ::rocprim::detail::block_id<0>();
+    const unsigned int block_id = ordered_bid.get(flat_id, storage.ordered_bid);
+    const unsigned int block_offset = block_id * items_per_block;
+    const bool is_last_block = block_id == number_of_blocks - 1;
+    const unsigned int valid_count = is_last_block ? size - block_offset : items_per_block;
 
-    unsigned int block_id;
-    unsigned int blocks_per_batch;
-    if(batch_id < full_batches)
+    key_type keys[ItemsPerThread];
+    if(is_last_block)
     {
-        blocks_per_batch = blocks_per_full_batch;
-        block_id = batch_id * blocks_per_batch;
+        keys_load_type().load(keys_input + block_offset, keys, valid_count, storage.keys_load);
     }
     else
     {
-        blocks_per_batch = blocks_per_full_batch - 1;
-        block_id = batch_id * blocks_per_batch + full_batches;
+        keys_load_type().load(keys_input + block_offset, keys, storage.keys_load);
     }
-    unsigned int block_start = unique_starts[batch_id];
 
-    if(flat_id == 0)
+    bool head_flags[ItemsPerThread];
+    ::rocprim::syncthreads();
+    if(block_id == 0)
     {
-        storage.has_carry_out = (block_id > 0 && blocks_per_batch > 0) &&
-            key_compare_op(
-                keys_input[block_id * items_per_block - 1],
-                keys_input[block_id * items_per_block]
-            );
+        discontinuity_type().flag_heads(
+            head_flags, keys,
+            key_flag_op<key_type, KeyCompareFunction>(key_compare_op),
+            storage.discontinuity
+        );
     }
-
-    for(unsigned int bi = 0; bi < blocks_per_batch; bi++)
+    else
     {
-        const unsigned int block_offset = block_id * items_per_block;
-
-        key_type keys[ItemsPerThread];
-        unsigned int valid_count;
-        if(block_offset + items_per_block <= size)
-        {
-            valid_count = items_per_block;
-            keys_load_type().load(keys_input + block_offset, keys, storage.keys_load);
-        }
-        else
-        {
-            valid_count = size - block_offset;
-            keys_load_type().load(keys_input + block_offset, keys, valid_count, storage.keys_load);
-        }
-
-        bool head_flags[ItemsPerThread];
-        bool tail_flags[ItemsPerThread];
-        key_type successor_key = keys[ItemsPerThread - 1];
-        ::rocprim::syncthreads();
-        if(block_id == blocks - 1)
-        {
-            discontinuity_type().flag_heads_and_tails(
-                head_flags, tail_flags, successor_key, keys,
-                guarded_key_flag_op<key_type, KeyCompareFunction>(key_compare_op, valid_count),
-                storage.discontinuity
-            );
-        }
-        else
-        {
-            if(flat_id == BlockSize - 1)
-            {
-                successor_key = keys_input[block_offset + items_per_block];
-            }
-            discontinuity_type().flag_heads_and_tails(
-                head_flags, tail_flags, successor_key, keys,
-                key_flag_op<key_type, KeyCompareFunction>(key_compare_op),
-                storage.discontinuity
-            );
-        }
-
-        value_type values[ItemsPerThread];
-        ::rocprim::syncthreads();
-        if(block_offset + items_per_block <= size)
-        {
-            values_load_type().load(values_input + block_offset, values, storage.values_load);
-        }
-        else
-        {
-            values_load_type().load(values_input + block_offset, values, valid_count, storage.values_load);
-        }
-
-        // Build pairs and run non-commutative inclusive scan to calculate scan-by-key
-        // and indices (ranks) of each segment:
-        // input:
-        //   keys          | 1 1 1 2 3 3 4 4 |
-        //   head_flags    | +     + +   +   |
-        //   values        | 2 0 1 4 2 3 1 5 |
-        // result:
-        //   scan values   | 2 2 3 4 2 5 1 6 |
-        //   scan keys     | 1 1 1 2 3 3 4 4 |
-        //   ranks (key-1) | 0 0 0 1 2 2 3 3 |
-        scan_by_key_pair<value_type> pairs[ItemsPerThread];
-        for(unsigned int i = 0; i < ItemsPerThread; i++)
-        {
-            pairs[i].key = head_flags[i];
-            pairs[i].value = values[i];
-        }
-        scan_by_key_op<scan_by_key_pair<value_type>, BinaryFunction> scan_op(reduce_op);
-        ::rocprim::syncthreads();
-        scan_type().inclusive_scan(pairs, pairs, storage.scan, scan_op);
-
-        unsigned int ranks[ItemsPerThread];
-        for(unsigned int i = 0; i < ItemsPerThread; i++)
-        {
-            ranks[i] = pairs[i].key - 1; // The first item is always flagged as head, so indices start from 1
-            values[i] = pairs[i].value;
-        }
-
-        if(flat_id == BlockSize - 1)
-        {
-            storage.unique_count = ranks[ItemsPerThread - 1] + (tail_flags[ItemsPerThread - 1] ? 1 : 0);
-        }
-
-        if(bi > 0 && storage.has_carry_out)
-        {
-            // Apply carry-out of the previous block as carry-in for the first segment
-            for(unsigned int i = 0; i < ItemsPerThread; i++)
-            {
-                if(ranks[i] == 0)
-                {
-                    values[i] = reduce_op(storage.carry_out, values[i]);
-                }
-            }
-        }
-
-        ::rocprim::syncthreads();
-        const unsigned int unique_count = storage.unique_count;
-        if(flat_id == 0)
-        {
-            // The first item must be written only if it is the first item of the current segment
-            // (otherwise it is written by one of previous blocks)
-            head_flags[0] = !storage.has_carry_out;
-        }
-        if(block_id == blocks - 1)
-        {
-            // Unflag the head after the last segment as it will be write out of bounds
-            for(unsigned int i = 0; i < ItemsPerThread; i++)
-            {
-                if(ranks[i] >= unique_count)
-                {
-                    head_flags[i] = false;
-                }
-            }
-        }
-
-        ::rocprim::syncthreads();
-        if(flat_id == BlockSize - 1)
-        {
-            if(bi == blocks_per_batch - 1)
-            {
-                // Save carry-out of the last block of the current batch
-                carry_outs[batch_id].key = keys[ItemsPerThread - 1];
-                carry_outs[batch_id].value = values[ItemsPerThread - 1];
-                carry_outs[batch_id].destination = block_start + ranks[ItemsPerThread - 1];
-                carry_outs[batch_id].is_final_aggregate = tail_flags[ItemsPerThread - 1];
-            }
-            else
-            {
-                // Save carry-out to use it as carry-in for the next block of the current batch
-                storage.has_carry_out = !tail_flags[ItemsPerThread - 1];
-                storage.carry_out = values[ItemsPerThread - 1];
-            }
-        }
-
-        // Save unique keys and aggregates (some aggregates contains partial values
-        // and will be updated later by calculating scan-by-key of carry-outs)
-        for(unsigned int i = 0; i < ItemsPerThread; i++)
-        {
-            if(head_flags[i])
-            {
-                // Write the key of the first item of the segment as a unique key
-                unique_output[block_start + ranks[i]] = keys[i];
-            }
-            if(tail_flags[i])
-            {
-                // Write the scanned value of the last item of the segment as an aggregate (reduction of the segment)
-                aggregates_output[block_start + ranks[i]] = values[i];
-            }
-        }
-
-        block_id++;
-        block_start += unique_count;
+        // The first segment of the tile may continue the last segment of the previous tile
+        const key_type predecessor_key = keys_input[block_offset - 1];
+        discontinuity_type().flag_heads(
+            head_flags, predecessor_key, keys,
+            key_flag_op<key_type, KeyCompareFunction>(key_compare_op),
+            storage.discontinuity
+        );
     }
-}
-
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class AggregatesOutputIterator,
-    class CarryOut,
-    class KeyCompareFunction,
-    class BinaryFunction
->
-ROCPRIM_DEVICE inline
-void scan_and_scatter_carry_outs(const CarryOut * carry_outs,
-                                 AggregatesOutputIterator aggregates_output,
-                                 KeyCompareFunction key_compare_op,
-                                 BinaryFunction reduce_op,
-                                 unsigned int batches)
-{
-    using key_type = decltype(std::declval<CarryOut>().key);
-    using value_type = decltype(std::declval<CarryOut>().value);
-
-    using load_type = ::rocprim::block_load<
-        CarryOut, BlockSize, ItemsPerThread,
-        ::rocprim::block_load_method::block_load_transpose>;
-    using discontinuity_type = ::rocprim::block_discontinuity<key_type, BlockSize>;
-    using scan_type = ::rocprim::block_scan<scan_by_key_pair<value_type>, BlockSize>;
 
-    ROCPRIM_SHARED_MEMORY union
-    {
-        typename load_type::storage_type load;
-        typename discontinuity_type::storage_type discontinuity;
-        typename scan_type::storage_type scan;
-    } storage;
-
-    CarryOut cs[ItemsPerThread];
-    load_type().load(carry_outs, cs, batches - 1, storage.load);
-
-    key_type keys[ItemsPerThread];
     value_type values[ItemsPerThread];
-    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    ::rocprim::syncthreads();
+    if(is_last_block)
     {
-        keys[i] = cs[i].key;
-        values[i] = cs[i].value;
+        values_load_type().load(values_input + block_offset, values, valid_count, storage.values_load);
+    }
+    else
+    {
+        values_load_type().load(values_input + block_offset, values, storage.values_load);
     }
 
-    bool head_flags[ItemsPerThread];
-    bool tail_flags[ItemsPerThread];
-    const key_type successor_key = keys[ItemsPerThread - 1]; // Do not always flag the last item in the block
-
-    ::rocprim::syncthreads();
-    discontinuity_type().flag_heads_and_tails(
-        head_flags, tail_flags,
-        successor_key, keys,
-        guarded_key_flag_op<key_type, KeyCompareFunction>(key_compare_op, batches - 1),
-        storage.discontinuity
-    );
-
-    scan_by_key_pair<value_type> pairs[ItemsPerThread];
+    // Build pairs and run non-commutative exclusive scan to calculate indices of
+    // segments and partial aggregates:
+    // input:
+    //   keys          | 1 1 1 2 3 3 4 4 |
+    //   head_flags    | +     + +   +   |
+    //   values        | 2 0 1 4 2 3 1 5 |
+    // result (exclusive):
+    //   scan keys     | 0 1 1 1 2 3 3 4 |
+    //   scan values   | - 2 2 3 4 2 5 1 |
+    // The prefix of a head holds the index of its segment (key) and the aggregate of
+    // the previous segment (value), items after the end of input are never heads.
+    pair_type pairs[ItemsPerThread];
     for(unsigned int i = 0; i < ItemsPerThread; i++)
     {
-        pairs[i].key = head_flags[i];
+        const unsigned int item = flat_id * ItemsPerThread + i;
+        pairs[i].key = (head_flags[i] && item < valid_count) ? 1 : 0;
         pairs[i].value = values[i];
     }
 
-    scan_by_key_op<scan_by_key_pair<value_type>, BinaryFunction> scan_op(reduce_op);
+    scan_op_type scan_op(reduce_op);
+    pair_type prefixes[ItemsPerThread];
     ::rocprim::syncthreads();
-    scan_type().inclusive_scan(pairs, pairs, storage.scan, scan_op);
+    if(block_id == 0)
+    {
+        // The first item is always a head, so the value of init is never used
+        pair_type init;
+        init.key = 0;
+        init.value = value_type();
+        pair_type reduction;
+        scan_type().exclusive_scan(pairs, prefixes, init, reduction, storage.scan, scan_op);
+        if(flat_id == 0)
+        {
+            scan_state.set_complete(block_id, reduction);
+        }
+    }
+    else
+    {
+        auto prefix_op = lookback_scan_prefix_op_type(block_id, scan_op, scan_state);
+        scan_type().exclusive_scan(pairs, prefixes, storage.scan, prefix_op, scan_op);
+    }
 
-    // Scatter the last carry-out of each segment as carry-ins
     for(unsigned int i = 0; i < ItemsPerThread; i++)
     {
-        if(tail_flags[i])
+        const unsigned int item = flat_id * ItemsPerThread + i;
+        if(pairs[i].key != 0)
         {
-            const unsigned int dst = cs[i].destination;
-            const value_type aggregate = pairs[i].value;
-            if(cs[i].is_final_aggregate)
-            {
-                // Overwrite the aggregate because the next block starts with a different key
-                aggregates_output[dst] = aggregate;
-            }
-            else
+            // Write the key of the first item of the segment as a unique key
+            unique_output[prefixes[i].key] = keys[i];
+            if(block_offset + item > 0)
             {
-                aggregates_output[dst] = reduce_op(aggregate, aggregates_output[dst]);
+                // The previous segment ends just before this head
+                aggregates_output[prefixes[i].key - 1] = prefixes[i].value;
             }
         }
+        if(is_last_block && item == valid_count - 1)
+        {
+            const pair_type last = scan_op(prefixes[i], pairs[i]);
+            aggregates_output[last.key - 1] = last.value;
+            *unique_count_output = last.key;
+        }
     }
 }
 
+// Empty input produces no unique keys, the count must be written anyway
+template<class UniqueCountOutputIterator>
+ROCPRIM_DEVICE inline
+void reduce_by_key_empty_kernel_impl(UniqueCountOutputIterator unique_count_output)
+{
+    *unique_count_output = 0;
+}
+
 } // end of detail namespace
 
 END_ROCPRIM_NAMESPACE
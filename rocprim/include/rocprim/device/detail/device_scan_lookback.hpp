@@ -0,0 +1,307 @@
+// Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_SCAN_LOOKBACK_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_SCAN_LOOKBACK_HPP_
+
+#include <type_traits>
+#include <iterator>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../functional.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_load.hpp"
+#include "../../block/block_store.hpp"
+#include "../../block/block_scan.hpp"
+
+#include "lookback_scan_state.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Helper functions for performing exclusive or inclusive
+// block scan in single-pass look-back scan.
+template<
+    bool Exclusive,
+    class BlockScan,
+    class T,
+    unsigned int ItemsPerThread,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+auto lookback_block_scan(T (&values)[ItemsPerThread],
+                         T initial_value,
+                         T& reduction,
+                         typename BlockScan::storage_type& storage,
+                         BinaryFunction scan_op)
+    -> typename std::enable_if<Exclusive>::type
+{
+    BlockScan()
+        .exclusive_scan(
+            values, // input
+            values, // output
+            initial_value,
+            reduction,
+            storage,
+            scan_op
+        );
+    // Include initial value in the prefix for the next blocks
+    reduction = scan_op(initial_value, reduction);
+}
+
+template<
+    bool Exclusive,
+    class BlockScan,
+    class T,
+    unsigned int ItemsPerThread,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+auto lookback_block_scan(T (&values)[ItemsPerThread],
+                         T initial_value,
+                         T& reduction,
+                         typename BlockScan::storage_type& storage,
+                         BinaryFunction scan_op)
+    -> typename std::enable_if<!Exclusive>::type
+{
+    (void) initial_value;
+    BlockScan()
+        .inclusive_scan(
+            values, // input
+            values, // output
+            reduction,
+            storage,
+            scan_op
+        );
+}
+
+template<
+    bool Exclusive,
+    class BlockScan,
+    class T,
+    unsigned int ItemsPerThread,
+    class PrefixCallback,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+auto lookback_block_scan(T (&values)[ItemsPerThread],
+                         typename BlockScan::storage_type& storage,
+                         PrefixCallback& prefix_callback_op,
+                         BinaryFunction scan_op)
+    -> typename std::enable_if<Exclusive>::type
+{
+    // Initial value is already included in the prefix
+    // published by the first block
+    BlockScan()
+        .exclusive_scan(
+            values, // input
+            values, // output
+            storage,
+            prefix_callback_op,
+            scan_op
+        );
+}
+
+template<
+    bool Exclusive,
+    class BlockScan,
+    class T,
+    unsigned int ItemsPerThread,
+    class PrefixCallback,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+auto lookback_block_scan(T (&values)[ItemsPerThread],
+                         typename BlockScan::storage_type& storage,
+                         PrefixCallback& prefix_callback_op,
+                         BinaryFunction scan_op)
+    -> typename std::enable_if<!Exclusive>::type
+{
+    BlockScan()
+        .inclusive_scan(
+            values, // input
+            values, // output
+            storage,
+            prefix_callback_op,
+            scan_op
+        );
+}
+
+// Single-pass scan: every element is read from global memory once, block
+// prefixes are resolved with decoupled look-back over lookback_scan_state.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    bool Exclusive,
+    class InputIterator,
+    class OutputIterator,
+    class BinaryFunction,
+    class ResultType,
+    class LookbackScanState
+>
+ROCPRIM_DEVICE inline
+void lookback_scan_kernel_impl(InputIterator input,
+                               OutputIterator output,
+                               const size_t size,
+                               ResultType initial_value,
+                               BinaryFunction scan_op,
+                               LookbackScanState scan_state,
+                               const unsigned int number_of_blocks,
+                               ordered_block_id<unsigned int> ordered_bid)
+{
+    using result_type = ResultType;
+    static_assert(
+        std::is_same<result_type, typename LookbackScanState::value_type>::value,
+        "value_type of LookbackScanState must be result_type"
+    );
+
+    constexpr auto items_per_block = BlockSize * ItemsPerThread;
+
+    using block_load_type = ::rocprim::block_load<
+        result_type, BlockSize, ItemsPerThread,
+        ::rocprim::block_load_method::block_load_transpose
+    >;
+    using block_store_type = ::rocprim::block_store<
+        result_type, BlockSize, ItemsPerThread,
+        ::rocprim::block_store_method::block_store_transpose
+    >;
+    using block_scan_type = ::rocprim::block_scan<
+        result_type, BlockSize,
+        ::rocprim::block_scan_algorithm::using_warp_scan
+    >;
+    using ordered_block_id_type = ordered_block_id<unsigned int>;
+    using lookback_scan_prefix_op_type = lookback_scan_prefix_op<
+        result_type, BinaryFunction, LookbackScanState
+    >;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename ordered_block_id_type::storage_type ordered_bid;
+        union
+        {
+            typename block_load_type::storage_type load;
+            typename block_store_type::storage_type store;
+            typename block_scan_type::storage_type scan;
+        };
+    } storage;
+
+    // It's assumed kernel is executed in 1D
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id = ordered_bid.get(flat_id, storage.ordered_bid);
+    const unsigned int block_offset = flat_block_id * items_per_block;
+    const auto valid_in_last_block = size - size_t(items_per_block) * (number_of_blocks - 1);
+
+    // For input values
+    result_type values[ItemsPerThread];
+
+    // load input values into values
+    if(flat_block_id == (number_of_blocks - 1)) // last block
+    {
+        block_load_type()
+            .load(
+                input + block_offset,
+                values,
+                valid_in_last_block,
+                storage.load
+            );
+    }
+    else
+    {
+        block_load_type()
+            .load(
+                input + block_offset,
+                values,
+                storage.load
+            );
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    if(flat_block_id == 0)
+    {
+        result_type reduction;
+        lookback_block_scan<Exclusive, block_scan_type>(
+            values, // input/output
+            initial_value,
+            reduction,
+            storage.scan,
+            scan_op
+        );
+        if(flat_id == 0)
+        {
+            scan_state.set_complete(flat_block_id, reduction);
+        }
+    }
+    else
+    {
+        auto prefix_op = lookback_scan_prefix_op_type(
+            flat_block_id, scan_op, scan_state
+        );
+        lookback_block_scan<Exclusive, block_scan_type>(
+            values, // input/output
+            storage.scan,
+            prefix_op,
+            scan_op
+        );
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    // Save values into output array
+    if(flat_block_id == (number_of_blocks - 1)) // last block
+    {
+        block_store_type()
+            .store(
+                output + block_offset,
+                values,
+                valid_in_last_block,
+                storage.store
+            );
+    }
+    else
+    {
+        block_store_type()
+            .store(
+                output + block_offset,
+                values,
+                storage.store
+            );
+    }
+}
+
+// Returns size of temporary storage in bytes.
+template<class LookbackScanState>
+size_t lookback_scan_get_temporary_storage_bytes(const unsigned int number_of_blocks)
+{
+    return ::rocprim::detail::align_size(
+            LookbackScanState::get_storage_size(number_of_blocks)
+        )
+        + ordered_block_id<unsigned int>::get_storage_size();
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_SCAN_LOOKBACK_HPP_
@@ -34,7 +34,6 @@
 #include "../../block/block_load.hpp"
 #include "../../block/block_store.hpp"
 #include "../../block/block_scan.hpp"
-#include "../../block/block_reduce.hpp"
 
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -162,272 +161,6 @@ void single_scan_kernel_impl(InputIterator input,
         );
 }
 
-// Calculates block prefixes that will be used in final_scan
-// when performing block scan operations.
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class InputIterator,
-    class BinaryFunction,
-    class ResultType
->
-ROCPRIM_DEVICE inline
-void block_reduce_kernel_impl(InputIterator input,
-                              BinaryFunction scan_op,
-                              ResultType * block_prefixes)
-{
-    using result_type = ResultType;
-    using block_reduce_type = ::rocprim::block_reduce<
-        result_type, BlockSize,
-        ::rocprim::block_reduce_algorithm::using_warp_reduce
-    >;
-    using block_load_type = ::rocprim::block_load<
-        result_type, BlockSize, ItemsPerThread,
-        ::rocprim::block_load_method::block_load_transpose
-    >;
-
-    ROCPRIM_SHARED_MEMORY union
-    {
-        typename block_load_type::storage_type load;
-        typename block_reduce_type::storage_type reduce;
-    } storage;
-
-    // It's assumed kernel is executed in 1D
-    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
-    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
-    const unsigned int block_offset = flat_block_id * ItemsPerThread * BlockSize;
-
-    // For input values
-    result_type values[ItemsPerThread];
-    result_type block_prefix;
-
-    block_load_type()
-        .load(
-            input + block_offset,
-            values,
-            storage.load
-        );
-    ::rocprim::syncthreads(); // sync threads to reuse shared memory
-
-    block_reduce_type()
-        .reduce(
-            values, // input
-            block_prefix, // output
-            storage.reduce,
-            scan_op
-        );
-
-    // Save block prefix
-    if(flat_id == 0)
-    {
-        block_prefixes[flat_block_id] = block_prefix;
-    }
-}
-
-// Helper functions for performing exclusive or inclusive
-// block scan operation in final_scan
-template<
-    bool Exclusive,
-    class BlockScan,
-    class T,
-    unsigned int ItemsPerThread,
-    class ResultType,
-    class BinaryFunction
->
-ROCPRIM_DEVICE inline
-auto final_scan_block_scan(const unsigned int flat_block_id,
-                           T (&input)[ItemsPerThread],
-                           T (&output)[ItemsPerThread],
-                           T initial_value,
-                           ResultType * block_prefixes,
-                           typename BlockScan::storage_type& storage,
-                           BinaryFunction scan_op)
-    -> typename std::enable_if<Exclusive>::type
-{
-    if(flat_block_id != 0)
-    {
-        // Include initial value in block prefix
-        initial_value = scan_op(
-            initial_value, block_prefixes[flat_block_id - 1]
-        );
-    }
-    BlockScan()
-        .exclusive_scan(
-            input, // input
-            output, // output
-            initial_value,
-            storage,
-            scan_op
-        );
-}
-
-template<
-    bool Exclusive,
-    class BlockScan,
-    class T,
-    unsigned int ItemsPerThread,
-    class ResultType,
-    class BinaryFunction
->
-ROCPRIM_DEVICE inline
-auto final_scan_block_scan(const unsigned int flat_block_id,
-                           T (&input)[ItemsPerThread],
-                           T (&output)[ItemsPerThread],
-                           T initial_value,
-                           ResultType * block_prefixes,
-                           typename BlockScan::storage_type& storage,
-                           BinaryFunction scan_op)
-    -> typename std::enable_if<!Exclusive>::type
-{
-    (void) initial_value;
-    if(flat_block_id == 0)
-    {
-        BlockScan()
-            .inclusive_scan(
-                input, // input
-                output, // output
-                storage,
-                scan_op
-            );
-    }
-    else
-    {
-        auto block_prefix_op =
-            [&block_prefixes, &flat_block_id](const T& /*not used*/)
-            {
-                return block_prefixes[flat_block_id - 1];
-            };
-        BlockScan()
-            .inclusive_scan(
-                input, // input
-                output, // output
-                storage,
-                block_prefix_op,
-                scan_op
-            );
-    }
-}
-
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    bool Exclusive,
-    class InputIterator,
-    class OutputIterator,
-    class BinaryFunction,
-    class ResultType
->
-ROCPRIM_DEVICE inline
-void final_scan_kernel_impl(InputIterator input,
-                            const size_t input_size,
-                            OutputIterator output,
-                            const ResultType initial_value,
-                            BinaryFunction scan_op,
-                            ResultType * block_prefixes)
-{
-    using result_type = ResultType;
-
-    using block_load_type = ::rocprim::block_load<
-        result_type, BlockSize, ItemsPerThread,
-        ::rocprim::block_load_method::block_load_transpose
-    >;
-    using block_store_type = ::rocprim::block_store<
-        result_type, BlockSize, ItemsPerThread,
-        ::rocprim::block_store_method::block_store_transpose
-    >;
-    using block_scan_type = ::rocprim::block_scan<
-        result_type, BlockSize,
-        ::rocprim::block_scan_algorithm::using_warp_scan
-    >;
-
-    ROCPRIM_SHARED_MEMORY union
-    {
-        typename block_load_type::storage_type load;
-        typename block_store_type::storage_type store;
-        typename block_scan_type::storage_type scan;
-    } storage;
-
-    // It's assumed kernel is executed in 1D
-    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
-
-    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
-    const unsigned int block_offset = flat_block_id * items_per_block;
-    // TODO: number_of_blocks can be calculated on host
-    const unsigned int number_of_blocks = (input_size + items_per_block - 1)/items_per_block;
-
-    // For input values
-    result_type values[ItemsPerThread];
-
-    // TODO: valid_in_last_block can be calculated on host
-    auto valid_in_last_block = input_size - items_per_block * (number_of_blocks - 1);
-    // load input values into values
-    if(flat_block_id == (number_of_blocks - 1)) // last block
-    {
-        block_load_type()
-            .load(
-                input + block_offset,
-                values,
-                valid_in_last_block,
-                storage.load
-            );
-    }
-    else
-    {
-        block_load_type()
-            .load(
-                input + block_offset,
-                values,
-                storage.load
-            );
-    }
-    ::rocprim::syncthreads(); // sync threads to reuse shared memory
-
-    final_scan_block_scan<Exclusive, block_scan_type>(
-        flat_block_id,
-        values, // input
-        values, // output
-        initial_value,
-        block_prefixes,
-        storage.scan,
-        scan_op
-    );
-    ::rocprim::syncthreads(); // sync threads to reuse shared memory
-
-    // Save values into output array
-    if(flat_block_id == (number_of_blocks - 1)) // last block
-    {
-        block_store_type()
-            .store(
-                output + block_offset,
-                values,
-                valid_in_last_block,
-                storage.store
-            );
-    }
-    else
-    {
-        block_store_type()
-            .store(
-                output + block_offset,
-                values,
-                storage.store
-            );
-    }
-}
-
-// Returns size of temporary storage in bytes.
-template<class T>
-size_t scan_get_temporary_storage_bytes(size_t input_size,
-                                        size_t items_per_block)
-{
-    if(input_size <= items_per_block)
-    {
-        return 0;
-    }
-    auto size = (input_size + items_per_block - 1)/(items_per_block);
-    return size * sizeof(T) + scan_get_temporary_storage_bytes<T>(size, items_per_block);
-}
-
 } // end of detail namespace
 
 END_ROCPRIM_NAMESPACE
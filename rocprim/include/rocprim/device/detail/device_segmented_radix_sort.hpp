@@ -31,7 +31,11 @@
 #include "../../functional.hpp"
 #include "../../types.hpp"
 
+#include "../../block/block_load.hpp"
+#include "../../block/block_radix_sort.hpp"
 #include "../../block/block_scan.hpp"
+#include "../../block/block_store_func.hpp"
+#include "../../warp/warp_sort.hpp"
 
 #include "device_radix_sort.hpp"
 
@@ -56,8 +60,11 @@ void segmented_sort(KeysInputIterator keys_input,
                     KeysOutputIterator keys_output,
                     ValuesInputIterator values_input,
                     ValuesOutputIterator values_output,
+                    const unsigned int * segment_indices,
+                    const unsigned int * counts,
                     OffsetIterator begin_offsets,
                     OffsetIterator end_offsets,
+                    size_t huge_segment_size,
                     unsigned int bit,
                     unsigned int current_radix_bits)
 {
@@ -79,22 +86,33 @@ void segmented_sort(KeysInputIterator keys_input,
         typename sort_and_scatter_helper::storage_type sort_and_scatter;
     } storage;
 
+    // The grid is sized for the maximum possible number of large segments,
+    // the actual number (counts[0]) is known only on the device
+    const unsigned int index = ::rocprim::detail::block_id<0>();
+    if(index >= counts[0])
+    {
+        return;
+    }
+
     const unsigned int flat_id = ::rocprim::flat_block_thread_id();
-    const unsigned int segment_id = ::rocprim::detail::block_id<0>();
+    const unsigned int segment_id = segment_indices[index];
 
-    const unsigned int begin_offset = begin_offsets[segment_id];
-    const unsigned int end_offset = end_offsets[segment_id];
+    // Offsets of segments may exceed 32 bits, positions within a segment are 32-bit
+    const size_t begin_offset = begin_offsets[segment_id];
+    const size_t end_offset = end_offsets[segment_id];
 
-    // Empty segment
-    if(end_offset <= begin_offset)
+    // Empty segment or a huge one, which is sorted by device-wide radix sort
+    if(end_offset <= begin_offset || end_offset - begin_offset > huge_segment_size)
     {
         return;
     }
 
+    const unsigned int segment_size = static_cast<unsigned int>(end_offset - begin_offset);
+
     unsigned int digit_count;
     count_helper_type().count_digits(
-        keys_input,
-        begin_offset, end_offset,
+        keys_input + begin_offset,
+        0, segment_size,
         bit, current_radix_bits,
         storage.count_helper,
         digit_count
@@ -102,20 +120,340 @@ void segmented_sort(KeysInputIterator keys_input,
 
     unsigned int digit_start;
     scan_type().exclusive_scan(digit_count, digit_start, 0);
-    if(flat_id < radix_size)
-    {
-        digit_start += begin_offset;
-    }
 
     sort_and_scatter_helper().sort_and_scatter(
-        keys_input, keys_output, values_input, values_output,
-        begin_offset, end_offset,
+        keys_input + begin_offset, keys_output + begin_offset,
+        values_input + begin_offset, values_output + begin_offset,
+        0, segment_size,
         bit, current_radix_bits,
         digit_start,
         storage.sort_and_scatter
     );
 }
 
+// Sorts a segment that fits into one tile by one block in a single run over all bits
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    bool Descending,
+    class Key,
+    class Value
+>
+struct segmented_sort_medium_helper
+{
+    using key_type = Key;
+    using value_type = Value;
+
+    using key_codec = radix_key_codec<key_type, Descending>;
+    using bit_key_type = typename key_codec::bit_key_type;
+    using keys_load_type = ::rocprim::block_load<
+        key_type, BlockSize, ItemsPerThread,
+        ::rocprim::block_load_method::block_load_transpose>;
+    using values_load_type = ::rocprim::block_load<
+        value_type, BlockSize, ItemsPerThread,
+        ::rocprim::block_load_method::block_load_transpose>;
+    using sort_type = ::rocprim::block_radix_sort<key_type, BlockSize, ItemsPerThread, value_type>;
+
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    union storage_type
+    {
+        typename keys_load_type::storage_type keys_load;
+        typename values_load_type::storage_type values_load;
+        typename sort_type::storage_type sort;
+    };
+
+    template<
+        class KeysInputIterator,
+        class KeysOutputIterator,
+        class ValuesInputIterator,
+        class ValuesOutputIterator
+    >
+    ROCPRIM_DEVICE inline
+    void sort(KeysInputIterator keys_input,
+              KeysOutputIterator keys_output,
+              ValuesInputIterator values_input,
+              ValuesOutputIterator values_output,
+              unsigned int segment_size,
+              unsigned int begin_bit,
+              unsigned int end_bit,
+              storage_type& storage)
+    {
+        const unsigned int flat_id = ::rocprim::flat_block_thread_id();
+
+        key_type keys[ItemsPerThread];
+        value_type values[ItemsPerThread];
+        // Sort will leave "invalid" (out of size) items at the end of the sorted sequence
+        const key_type out_of_bounds = key_codec::decode(bit_key_type(-1));
+        keys_load_type().load(keys_input, keys, segment_size, out_of_bounds, storage.keys_load);
+        if(with_values)
+        {
+            ::rocprim::syncthreads();
+            values_load_type().load(values_input, values, segment_size, storage.values_load);
+        }
+
+        ::rocprim::syncthreads();
+        sort_block(keys, values, storage, begin_bit, end_bit);
+
+        block_store_direct_striped<BlockSize>(flat_id, keys_output, keys, segment_size);
+        if(with_values)
+        {
+            block_store_direct_striped<BlockSize>(flat_id, values_output, values, segment_size);
+        }
+    }
+
+    // Wrapping functions that allow to call proper methods (with or without values)
+    template<class SortValue>
+    ROCPRIM_DEVICE inline
+    void sort_block(key_type (&keys)[ItemsPerThread],
+                    SortValue (&values)[ItemsPerThread],
+                    storage_type& storage,
+                    unsigned int begin_bit,
+                    unsigned int end_bit)
+    {
+        if(Descending)
+        {
+            sort_type().sort_desc_to_striped(keys, values, storage.sort, begin_bit, end_bit);
+        }
+        else
+        {
+            sort_type().sort_to_striped(keys, values, storage.sort, begin_bit, end_bit);
+        }
+    }
+
+    ROCPRIM_DEVICE inline
+    void sort_block(key_type (&keys)[ItemsPerThread],
+                    ::rocprim::empty_type (&values)[ItemsPerThread],
+                    storage_type& storage,
+                    unsigned int begin_bit,
+                    unsigned int end_bit)
+    {
+        (void) values;
+        if(Descending)
+        {
+            sort_type().sort_desc_to_striped(keys, storage.sort, begin_bit, end_bit);
+        }
+        else
+        {
+            sort_type().sort_to_striped(keys, storage.sort, begin_bit, end_bit);
+        }
+    }
+};
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator
+>
+ROCPRIM_DEVICE inline
+void segmented_sort_medium(KeysInputIterator keys_input,
+                           KeysOutputIterator keys_output,
+                           ValuesInputIterator values_input,
+                           ValuesOutputIterator values_output,
+                           const unsigned int * segment_indices,
+                           const unsigned int * counts,
+                           OffsetIterator begin_offsets,
+                           OffsetIterator end_offsets,
+                           unsigned int begin_bit,
+                           unsigned int end_bit)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using sort_helper = segmented_sort_medium_helper<
+        BlockSize, ItemsPerThread, Descending,
+        key_type, value_type
+    >;
+
+    ROCPRIM_SHARED_MEMORY typename sort_helper::storage_type storage;
+
+    // The grid is sized for the maximum possible number of medium segments
+    const unsigned int index = ::rocprim::detail::block_id<0>();
+    if(index >= counts[1])
+    {
+        return;
+    }
+
+    const unsigned int segment_id = segment_indices[index];
+
+    const size_t begin_offset = begin_offsets[segment_id];
+    const unsigned int segment_size = static_cast<unsigned int>(end_offsets[segment_id] - begin_offset);
+
+    sort_helper().sort(
+        keys_input + begin_offset, keys_output + begin_offset,
+        values_input + begin_offset, values_output + begin_offset,
+        segment_size,
+        begin_bit, end_bit,
+        storage
+    );
+}
+
+// Key of warp sort of small segments: bits [begin_bit; end_bit) of the key and its position
+// in the segment, which makes the sort stable
+template<class BitKey>
+struct segmented_warp_sort_key
+{
+    BitKey bit_key;
+    unsigned int index;
+};
+
+template<class BitKey>
+struct segmented_warp_sort_less
+{
+    ROCPRIM_DEVICE inline
+    bool operator()(const segmented_warp_sort_key<BitKey>& lhs,
+                    const segmented_warp_sort_key<BitKey>& rhs) const
+    {
+        return lhs.bit_key < rhs.bit_key || (lhs.bit_key == rhs.bit_key && lhs.index < rhs.index);
+    }
+};
+
+// Sorts segments of at most WarpSortSize items, one segment per logical warp
+template<
+    unsigned int BlockSize,
+    unsigned int WarpSortSize,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator
+>
+ROCPRIM_DEVICE inline
+void segmented_sort_small(KeysInputIterator keys_input,
+                          KeysOutputIterator keys_output,
+                          ValuesInputIterator values_input,
+                          ValuesOutputIterator values_output,
+                          const unsigned int * segment_indices,
+                          const unsigned int * counts,
+                          unsigned int segments,
+                          OffsetIterator begin_offsets,
+                          OffsetIterator end_offsets,
+                          unsigned int begin_bit,
+                          unsigned int end_bit)
+{
+    static_assert(BlockSize % WarpSortSize == 0, "BlockSize must be divisible by WarpSortSize");
+    constexpr unsigned int warps_per_block = BlockSize / WarpSortSize;
+
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using key_codec = radix_key_codec<key_type, Descending>;
+    using bit_key_type = typename key_codec::bit_key_type;
+    using sort_key_type = segmented_warp_sort_key<bit_key_type>;
+    using sort_type = ::rocprim::warp_sort<sort_key_type, WarpSortSize>;
+
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    const unsigned int lane_id = ::rocprim::detail::logical_lane_id<WarpSortSize>();
+    const unsigned int index = ::rocprim::detail::block_id<0>() * warps_per_block
+        + ::rocprim::detail::logical_warp_id<WarpSortSize>();
+    // Segments that are neither large nor medium are small, all threads
+    // of a logical warp exit together
+    if(index >= segments - counts[0] - counts[1])
+    {
+        return;
+    }
+
+    const unsigned int segment_id = segment_indices[index];
+    const size_t begin_offset = begin_offsets[segment_id];
+    const size_t end_offset = end_offsets[segment_id];
+    if(end_offset <= begin_offset)
+    {
+        return;
+    }
+    const unsigned int segment_size = static_cast<unsigned int>(end_offset - begin_offset);
+
+    const unsigned int bits = end_bit - begin_bit;
+    const bit_key_type mask = bits < 8 * sizeof(bit_key_type)
+        ? static_cast<bit_key_type>((bit_key_type(1) << bits) - 1)
+        : bit_key_type(-1);
+
+    key_type key;
+    value_type value;
+    // Out of size items go after all valid items
+    sort_key_type sort_key = { mask, lane_id };
+    if(lane_id < segment_size)
+    {
+        key = keys_input[begin_offset + lane_id];
+        if(with_values)
+        {
+            value = values_input[begin_offset + lane_id];
+        }
+        sort_key.bit_key = static_cast<bit_key_type>(key_codec::encode(key) >> begin_bit) & mask;
+    }
+
+    sort_type().sort(sort_key, segmented_warp_sort_less<bit_key_type>());
+
+    // Take keys and values from their original lanes
+    key = ::rocprim::warp_shuffle(key, sort_key.index, WarpSortSize);
+    if(with_values)
+    {
+        value = ::rocprim::warp_shuffle(value, sort_key.index, WarpSortSize);
+    }
+    if(lane_id < segment_size)
+    {
+        keys_output[begin_offset + lane_id] = key;
+        if(with_values)
+        {
+            values_output[begin_offset + lane_id] = value;
+        }
+    }
+}
+
+// Writes bounds of large segments, they are read by the host (together with counts)
+// to find huge segments
+template<class OffsetIterator>
+ROCPRIM_DEVICE inline
+void segmented_sort_large_bounds(const unsigned int * segment_indices,
+                                 const unsigned int * counts,
+                                 unsigned int max_segments,
+                                 OffsetIterator begin_offsets,
+                                 OffsetIterator end_offsets,
+                                 size_t * bounds)
+{
+    const unsigned int index = ::rocprim::detail::block_thread_id<0>()
+        + ::rocprim::detail::block_id<0>() * ::rocprim::detail::block_size<0>();
+    if(index < ::rocprim::min(counts[0], max_segments))
+    {
+        const unsigned int segment_id = segment_indices[index];
+        bounds[index * 2] = begin_offsets[segment_id];
+        bounds[index * 2 + 1] = end_offsets[segment_id];
+    }
+}
+
+// Selects segments larger than size, used for partitioning segments into size classes
+template<class OffsetIterator>
+struct segment_size_greater
+{
+    OffsetIterator begin_offsets;
+    OffsetIterator end_offsets;
+    size_t size;
+
+    ROCPRIM_HOST_DEVICE inline
+    bool operator()(unsigned int segment_id) const
+    {
+        const size_t begin_offset = begin_offsets[segment_id];
+        const size_t end_offset = end_offsets[segment_id];
+        return end_offset > begin_offset && end_offset - begin_offset > size;
+    }
+};
+
+template<class T>
+struct segmented_sort_copy_op
+{
+    ROCPRIM_HOST_DEVICE inline
+    T operator()(const T& value) const
+    {
+        return value;
+    }
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
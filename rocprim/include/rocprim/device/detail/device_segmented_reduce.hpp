@@ -32,52 +32,35 @@
 
 #include "../../block/block_load_func.hpp"
 #include "../../block/block_reduce.hpp"
+#include "../../warp/warp_reduce.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
 namespace detail
 {
 
+// Reduces items [begin_offset, end_offset) of a non-empty range by the whole block,
+// the result is valid in thread 0 only
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
     class ResultType,
     class InputIterator,
-    class OutputIterator,
-    class OffsetIterator,
-    class InitValueType,
     class BinaryFunction
 >
 ROCPRIM_DEVICE inline
-void segmented_reduce(InputIterator input,
-                      OutputIterator output,
-                      OffsetIterator begin_offsets,
-                      OffsetIterator end_offsets,
-                      BinaryFunction reduce_op,
-                      InitValueType initial_value)
+ResultType segmented_reduce_range(InputIterator input,
+                                  const unsigned int begin_offset,
+                                  const unsigned int end_offset,
+                                  BinaryFunction reduce_op,
+                                  typename ::rocprim::block_reduce<ResultType, BlockSize>::storage_type& reduce_storage)
 {
     constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
 
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
     using reduce_type = ::rocprim::block_reduce<ResultType, BlockSize>;
 
-    ROCPRIM_SHARED_MEMORY typename reduce_type::storage_type reduce_storage;
-
     const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
-    const unsigned int segment_id = ::rocprim::detail::block_id<0>();
-
-    const unsigned int begin_offset = begin_offsets[segment_id];
-    const unsigned int end_offset = end_offsets[segment_id];
-
-    // Empty segment
-    if(end_offset <= begin_offset)
-    {
-        if(flat_id == 0)
-        {
-            output[segment_id] = initial_value;
-        }
-        return;
-    }
 
     ResultType result;
     unsigned int block_offset = begin_offset;
@@ -150,6 +133,50 @@ void segmented_reduce(InputIterator input,
         // Reduce threads' reductions to compute the final result
         reduce_type().reduce(result, result, reduce_storage, reduce_op);
     }
+    return result;
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void segmented_reduce(InputIterator input,
+                      OutputIterator output,
+                      OffsetIterator begin_offsets,
+                      OffsetIterator end_offsets,
+                      BinaryFunction reduce_op,
+                      InitValueType initial_value)
+{
+    using reduce_type = ::rocprim::block_reduce<ResultType, BlockSize>;
+
+    ROCPRIM_SHARED_MEMORY typename reduce_type::storage_type reduce_storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int segment_id = ::rocprim::detail::block_id<0>();
+
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int end_offset = end_offsets[segment_id];
+
+    // Empty segment
+    if(end_offset <= begin_offset)
+    {
+        if(flat_id == 0)
+        {
+            output[segment_id] = initial_value;
+        }
+        return;
+    }
+
+    const ResultType result = segmented_reduce_range<BlockSize, ItemsPerThread, ResultType>(
+        input, begin_offset, end_offset, reduce_op, reduce_storage
+    );
 
     if(flat_id == 0)
     {
@@ -157,6 +184,297 @@ void segmented_reduce(InputIterator input,
     }
 }
 
+// Load-balanced segmented reduction.
+//
+// Segments of at most SmallSegmentSize items (including empty ones) are reduced by
+// logical warps. Longer segments are split into tiles of BlockSize * ItemsPerThread items,
+// tile_offsets (an exclusive scan of numbers of tiles of all segments) maps tiles to their
+// segments. Tiles are distributed evenly among blocks, so every block reduces a contiguous
+// range of tiles, which may cover parts of several segments. A block that reduces a whole
+// segment writes its result directly, otherwise it stores a partial result: "head" for a
+// segment started by previous blocks, "tail" for a segment continued by next blocks.
+// The partial results are combined by a separate fix-up kernel.
+
+// Number of tiles of a segment reduced in the load-balanced mode, zero for small segments
+// and for the last item (segment_id == segments), so the scan computes the total number of tiles
+template<class OffsetIterator>
+struct segmented_reduce_tiles_op
+{
+    OffsetIterator begin_offsets;
+    OffsetIterator end_offsets;
+    unsigned int segments;
+    unsigned int small_segment_size;
+    unsigned int items_per_tile;
+
+    ROCPRIM_HOST_DEVICE inline
+    unsigned int operator()(unsigned int segment_id) const
+    {
+        if(segment_id >= segments)
+        {
+            return 0;
+        }
+        const unsigned int begin_offset = begin_offsets[segment_id];
+        const unsigned int end_offset = end_offsets[segment_id];
+        if(end_offset <= begin_offset || end_offset - begin_offset <= small_segment_size)
+        {
+            return 0;
+        }
+        return ::rocprim::detail::ceiling_div(end_offset - begin_offset, items_per_tile);
+    }
+};
+
+// Number of tiles reduced by each block of the tiles kernel
+ROCPRIM_DEVICE inline
+unsigned int segmented_reduce_tiles_per_block(const unsigned int tiles,
+                                              const unsigned int tiles_grid_size)
+{
+    return ::rocprim::detail::ceiling_div(tiles, tiles_grid_size);
+}
+
+// Returns the segment of tile, i.e. the last one with tile_offsets[segment_id] <= tile
+// (segments without tiles have the same offset as the next one)
+ROCPRIM_DEVICE inline
+unsigned int segmented_tiles_find_segment(const unsigned int * tile_offsets,
+                                          const unsigned int segments,
+                                          const unsigned int tile)
+{
+    unsigned int segment_id = 0;
+    unsigned int count = segments;
+    while(count > 0)
+    {
+        const unsigned int step = count / 2;
+        if(tile_offsets[segment_id + step + 1] <= tile)
+        {
+            segment_id += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    return segment_id;
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int WarpReduceSize,
+    unsigned int SmallSegmentSize,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void segmented_reduce_small(InputIterator input,
+                            OutputIterator output,
+                            const unsigned int segments,
+                            OffsetIterator begin_offsets,
+                            OffsetIterator end_offsets,
+                            BinaryFunction reduce_op,
+                            InitValueType initial_value)
+{
+    static_assert(BlockSize % WarpReduceSize == 0, "BlockSize must be divisible by WarpReduceSize");
+    constexpr unsigned int warps_per_block = BlockSize / WarpReduceSize;
+
+    using reduce_type = ::rocprim::warp_reduce<ResultType, WarpReduceSize>;
+
+    ROCPRIM_SHARED_MEMORY typename reduce_type::storage_type reduce_storage[warps_per_block];
+
+    const unsigned int lane_id = ::rocprim::detail::logical_lane_id<WarpReduceSize>();
+    const unsigned int warp_id = ::rocprim::detail::logical_warp_id<WarpReduceSize>();
+    const unsigned int segment_id = ::rocprim::detail::block_id<0>() * warps_per_block + warp_id;
+    // All threads of a logical warp exit together
+    if(segment_id >= segments)
+    {
+        return;
+    }
+
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int end_offset = end_offsets[segment_id];
+
+    // Empty segment
+    if(end_offset <= begin_offset)
+    {
+        if(lane_id == 0)
+        {
+            output[segment_id] = initial_value;
+        }
+        return;
+    }
+
+    const unsigned int valid_count = end_offset - begin_offset;
+    // Long segments are reduced by tiles
+    if(valid_count > SmallSegmentSize)
+    {
+        return;
+    }
+
+    ResultType result;
+    if(lane_id < valid_count)
+    {
+        unsigned int offset = begin_offset + lane_id;
+        result = input[offset];
+        offset += WarpReduceSize;
+        while(offset < end_offset)
+        {
+            result = reduce_op(result, input[offset]);
+            offset += WarpReduceSize;
+        }
+    }
+    reduce_type().reduce(
+        result, result,
+        ::rocprim::min(valid_count, WarpReduceSize),
+        reduce_storage[warp_id], reduce_op
+    );
+
+    if(lane_id == 0)
+    {
+        output[segment_id] = reduce_op(initial_value, result);
+    }
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void segmented_reduce_tiles(InputIterator input,
+                            OutputIterator output,
+                            const unsigned int segments,
+                            OffsetIterator begin_offsets,
+                            OffsetIterator end_offsets,
+                            const unsigned int * tile_offsets,
+                            ResultType * partials,
+                            BinaryFunction reduce_op,
+                            InitValueType initial_value)
+{
+    constexpr unsigned int items_per_tile = BlockSize * ItemsPerThread;
+
+    using reduce_type = ::rocprim::block_reduce<ResultType, BlockSize>;
+
+    ROCPRIM_SHARED_MEMORY typename reduce_type::storage_type reduce_storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+
+    const unsigned int tiles = tile_offsets[segments];
+    const unsigned int tiles_per_block =
+        segmented_reduce_tiles_per_block(tiles, ::rocprim::detail::grid_size<0>());
+    const unsigned int begin_tile = ::rocprim::min(tiles, block_id * tiles_per_block);
+    const unsigned int end_tile = ::rocprim::min(tiles, begin_tile + tiles_per_block);
+    // All threads of the block exit together
+    if(begin_tile == end_tile)
+    {
+        return;
+    }
+
+    unsigned int segment_id = segmented_tiles_find_segment(tile_offsets, segments, begin_tile);
+    unsigned int tile = begin_tile;
+    while(tile < end_tile)
+    {
+        // Skip small segments
+        while(tile_offsets[segment_id + 1] <= tile)
+        {
+            segment_id++;
+        }
+        const unsigned int segment_begin_tile = tile_offsets[segment_id];
+        const unsigned int segment_end_tile = tile_offsets[segment_id + 1];
+        const unsigned int next_tile = ::rocprim::min(segment_end_tile, end_tile);
+
+        const unsigned int segment_begin_offset = begin_offsets[segment_id];
+        const unsigned int segment_end_offset = end_offsets[segment_id];
+        const unsigned int begin_offset = segment_begin_offset + (tile - segment_begin_tile) * items_per_tile;
+        const unsigned int end_offset = ::rocprim::min(
+            segment_end_offset,
+            segment_begin_offset + (next_tile - segment_begin_tile) * items_per_tile
+        );
+
+        const ResultType result = segmented_reduce_range<BlockSize, ItemsPerThread, ResultType>(
+            input, begin_offset, end_offset, reduce_op, reduce_storage
+        );
+
+        if(flat_id == 0)
+        {
+            if(tile > segment_begin_tile)
+            {
+                // The segment is started by previous blocks
+                partials[2 * block_id] = result;
+            }
+            else if(segment_end_tile > end_tile)
+            {
+                // The segment is continued by next blocks
+                partials[2 * block_id + 1] = result;
+            }
+            else
+            {
+                output[segment_id] = reduce_op(initial_value, result);
+            }
+        }
+        ::rocprim::syncthreads();
+
+        tile = next_tile;
+    }
+}
+
+// Combines partial results of segments reduced by several blocks, one thread per segment
+template<
+    unsigned int BlockSize,
+    class ResultType,
+    class OutputIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void segmented_reduce_fixup(OutputIterator output,
+                            const unsigned int segments,
+                            const unsigned int * tile_offsets,
+                            const unsigned int tiles_grid_size,
+                            const ResultType * partials,
+                            BinaryFunction reduce_op,
+                            InitValueType initial_value)
+{
+    const unsigned int segment_id = ::rocprim::detail::block_id<0>() * BlockSize
+        + ::rocprim::detail::block_thread_id<0>();
+    if(segment_id >= segments)
+    {
+        return;
+    }
+
+    const unsigned int segment_begin_tile = tile_offsets[segment_id];
+    const unsigned int segment_end_tile = tile_offsets[segment_id + 1];
+    // Small segment
+    if(segment_begin_tile == segment_end_tile)
+    {
+        return;
+    }
+
+    const unsigned int tiles_per_block =
+        segmented_reduce_tiles_per_block(tile_offsets[segments], tiles_grid_size);
+    const unsigned int first_block = segment_begin_tile / tiles_per_block;
+    const unsigned int last_block = (segment_end_tile - 1) / tiles_per_block;
+    // The segment is reduced by one block, the result is already stored
+    if(first_block == last_block)
+    {
+        return;
+    }
+
+    ResultType result = partials[2 * first_block + 1];
+    for(unsigned int block_id = first_block + 1; block_id <= last_block; block_id++)
+    {
+        result = reduce_op(result, partials[2 * block_id]);
+    }
+    output[segment_id] = reduce_op(initial_value, result);
+}
+
 } // end of detail namespace
 
 END_ROCPRIM_NAMESPACE
@@ -33,51 +33,17 @@
 #include "../../block/block_load.hpp"
 #include "../../block/block_store.hpp"
 #include "../../block/block_scan.hpp"
+#include "../../block/block_reduce.hpp"
+#include "../../warp/warp_scan.hpp"
+
+#include "device_segmented_reduce.hpp"
+#include "segmented_scan_flag_wrapper_op.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
 namespace detail
 {
 
-template<class V, class F, class BinaryFunction>
-struct segmented_scan_flag_wrapper_op
-{
-    #ifdef __cpp_lib_is_invocable
-    using result_type = typename std::invoke_result<BinaryFunction, V, V>::type;
-    #else
-    using result_type = typename std::result_of<BinaryFunction(V, V)>::type;
-    #endif
-
-    ROCPRIM_HOST_DEVICE inline
-    segmented_scan_flag_wrapper_op() = default;
-
-    ROCPRIM_HOST_DEVICE inline
-    segmented_scan_flag_wrapper_op(BinaryFunction scan_op)
-        : scan_op_(scan_op)
-    {
-    }
-
-    ROCPRIM_HOST_DEVICE inline
-    ~segmented_scan_flag_wrapper_op() = default;
-
-    ROCPRIM_HOST_DEVICE inline
-    rocprim::tuple<result_type, F> operator()(const rocprim::tuple<result_type, F>& t1,
-                                              const rocprim::tuple<result_type, F>& t2) const
-    {
-        if(!rocprim::get<1>(t2))
-        {
-            return rocprim::make_tuple(
-                scan_op_(rocprim::get<0>(t1), rocprim::get<0>(t2)),
-                static_cast<F>(rocprim::get<1>(t1) || rocprim::get<1>(t2))
-            );
-        }
-        return t2;
-    }
-
-private:
-    BinaryFunction scan_op_;
-};
-
 template<
     bool Exclusive,
     bool UsePrefix,
@@ -147,6 +113,114 @@ auto segmented_scan_block_scan(T (&input)[ItemsPerThread],
         );
 }
 
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class ResultType
+>
+struct segmented_scan_block_helper
+{
+    using block_load_type = ::rocprim::block_load<
+        ResultType, BlockSize, ItemsPerThread,
+        ::rocprim::block_load_method::block_load_transpose
+    >;
+    using block_store_type = ::rocprim::block_store<
+        ResultType, BlockSize, ItemsPerThread,
+        ::rocprim::block_store_method::block_store_transpose
+    >;
+    using block_scan_type = ::rocprim::block_scan<
+        ResultType, BlockSize,
+        ::rocprim::block_scan_algorithm::using_warp_scan
+    >;
+
+    union storage_type
+    {
+        typename block_load_type::storage_type load;
+        typename block_store_type::storage_type store;
+        typename block_scan_type::storage_type scan;
+    };
+};
+
+// Scans items [begin_offset, end_offset) of a non-empty range by the whole block.
+// If use_prefix is true, prefix is combined with all results: the reduction of preceding
+// items of the segment (inclusive scan) or the initial value combined with it (exclusive
+// scan, which always uses prefix).
+template<
+    bool Exclusive,
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void segmented_scan_range(InputIterator input,
+                          OutputIterator output,
+                          const unsigned int begin_offset,
+                          const unsigned int end_offset,
+                          ResultType prefix,
+                          bool use_prefix,
+                          BinaryFunction scan_op,
+                          typename segmented_scan_block_helper<BlockSize, ItemsPerThread, ResultType>::storage_type& storage)
+{
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    using helper = segmented_scan_block_helper<BlockSize, ItemsPerThread, ResultType>;
+    using block_load_type = typename helper::block_load_type;
+    using block_store_type = typename helper::block_store_type;
+    using block_scan_type = typename helper::block_scan_type;
+
+    // Input values
+    ResultType values[ItemsPerThread];
+
+    unsigned int block_offset = begin_offset;
+    while(block_offset < end_offset)
+    {
+        const unsigned int valid_count = end_offset - block_offset;
+        const bool is_full_block = valid_count >= items_per_block;
+
+        // Load the (probably partial) block
+        if(is_full_block)
+        {
+            block_load_type().load(input + block_offset, values, storage.load);
+        }
+        else
+        {
+            block_load_type().load(input + block_offset, values, valid_count, storage.load);
+        }
+        ::rocprim::syncthreads();
+        // Perform scan operation
+        if(use_prefix)
+        {
+            segmented_scan_block_scan<Exclusive, true, block_scan_type>(
+                values, values, prefix, storage.scan, scan_op
+            );
+        }
+        else
+        {
+            segmented_scan_block_scan<Exclusive, false, block_scan_type>(
+                values, values, prefix, storage.scan, scan_op
+            );
+        }
+        ::rocprim::syncthreads();
+        // Store the (probably partial) block
+        if(is_full_block)
+        {
+            block_store_type().store(output + block_offset, values, storage.store);
+        }
+        else
+        {
+            block_store_type().store(output + block_offset, values, valid_count, storage.store);
+        }
+        ::rocprim::syncthreads();
+
+        block_offset += items_per_block;
+        // The next blocks continue scanning with the reduction of the previous ones
+        use_prefix = true;
+    }
+}
+
 template<
     bool Exclusive,
     unsigned int BlockSize,
@@ -166,28 +240,9 @@ void segmented_scan(InputIterator input,
                     InitValueType initial_value,
                     BinaryFunction scan_op)
 {
-    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    using helper = segmented_scan_block_helper<BlockSize, ItemsPerThread, ResultType>;
 
-    using result_type = ResultType;
-    using block_load_type = ::rocprim::block_load<
-        result_type, BlockSize, ItemsPerThread,
-        ::rocprim::block_load_method::block_load_transpose
-    >;
-    using block_store_type = ::rocprim::block_store<
-        result_type, BlockSize, ItemsPerThread,
-        ::rocprim::block_store_method::block_store_transpose
-    >;
-    using block_scan_type = ::rocprim::block_scan<
-        result_type, BlockSize,
-        ::rocprim::block_scan_algorithm::using_warp_scan
-    >;
-
-    ROCPRIM_SHARED_MEMORY union
-    {
-        typename block_load_type::storage_type load;
-        typename block_store_type::storage_type store;
-        typename block_scan_type::storage_type scan;
-    } storage;
+    ROCPRIM_SHARED_MEMORY typename helper::storage_type storage;
 
     const unsigned int segment_id = ::rocprim::detail::block_id<0>();
     const unsigned int begin_offset = begin_offsets[segment_id];
@@ -199,70 +254,279 @@ void segmented_scan(InputIterator input,
         return;
     }
 
-    // Input values
-    result_type values[ItemsPerThread];
-    result_type prefix = initial_value;
+    segmented_scan_range<Exclusive, BlockSize, ItemsPerThread>(
+        input, output, begin_offset, end_offset,
+        static_cast<ResultType>(initial_value), Exclusive,
+        scan_op, storage
+    );
+}
 
-    unsigned int block_offset = begin_offset;
-    if(block_offset + items_per_block > end_offset)
+// Load-balanced segmented scan, segments are split into the same size classes and tiles
+// as in load-balanced segmented reduction (see device_segmented_reduce.hpp).
+//
+// Small segments are scanned by logical warps. Tiles of longer segments are distributed
+// evenly among blocks, each block scans a contiguous range of tiles. Before that, every
+// block whose last segment is continued by next blocks stores the reduction of its part
+// of the segment, a block that continues a segment combines these partial reductions of
+// previous blocks into the carry of the segment.
+
+template<
+    bool Exclusive,
+    unsigned int BlockSize,
+    unsigned int WarpScanSize,
+    unsigned int SmallSegmentSize,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void segmented_scan_small(InputIterator input,
+                          OutputIterator output,
+                          const unsigned int segments,
+                          OffsetIterator begin_offsets,
+                          OffsetIterator end_offsets,
+                          InitValueType initial_value,
+                          BinaryFunction scan_op)
+{
+    static_assert(BlockSize % WarpScanSize == 0, "BlockSize must be divisible by WarpScanSize");
+    constexpr unsigned int warps_per_block = BlockSize / WarpScanSize;
+
+    // Power-of-two logical warps use the shuffle-based implementation, so the storage
+    // can be reused without block-wide barriers
+    using scan_type = ::rocprim::warp_scan<ResultType, WarpScanSize>;
+
+    ROCPRIM_SHARED_MEMORY typename scan_type::storage_type scan_storage[warps_per_block];
+
+    const unsigned int lane_id = ::rocprim::detail::logical_lane_id<WarpScanSize>();
+    const unsigned int warp_id = ::rocprim::detail::logical_warp_id<WarpScanSize>();
+    const unsigned int segment_id = ::rocprim::detail::block_id<0>() * warps_per_block + warp_id;
+    // All threads of a logical warp exit together
+    if(segment_id >= segments)
     {
-        // Segment is shorter than items_per_block
+        return;
+    }
 
-        // Load the partial block
-        const unsigned int valid_count = end_offset - block_offset;
-        block_load_type().load(input + block_offset, values, valid_count, storage.load);
-        ::rocprim::syncthreads();
-        // Perform scan operation
-        segmented_scan_block_scan<Exclusive, false, block_scan_type>(
-            values, values, prefix, storage.scan, scan_op
-        );
-        ::rocprim::syncthreads();
-        // Store the partial block
-        block_store_type().store(output + block_offset, values, valid_count, storage.store);
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int end_offset = end_offsets[segment_id];
+    // Empty segments are skipped, long segments are scanned by tiles
+    if(end_offset <= begin_offset || end_offset - begin_offset > SmallSegmentSize)
+    {
+        return;
     }
-    else
+
+    ResultType prefix = static_cast<ResultType>(initial_value);
+    bool use_prefix = Exclusive;
+    for(unsigned int offset = begin_offset; offset < end_offset; offset += WarpScanSize)
     {
-        // Long segments
+        const bool is_valid = offset + lane_id < end_offset;
+        ResultType value;
+        if(is_valid)
+        {
+            value = input[offset + lane_id];
+        }
+        // Reduction includes values of invalid lanes, but it is used only when all lanes are valid
+        ResultType reduction;
+        if(Exclusive)
+        {
+            scan_type().exclusive_scan(value, value, prefix, reduction, scan_storage[warp_id], scan_op);
+            prefix = scan_op(prefix, reduction);
+        }
+        else
+        {
+            scan_type().inclusive_scan(value, value, reduction, scan_storage[warp_id], scan_op);
+            if(use_prefix)
+            {
+                value = scan_op(prefix, value);
+                prefix = scan_op(prefix, reduction);
+            }
+            else
+            {
+                prefix = reduction;
+            }
+            use_prefix = true;
+        }
+        if(is_valid)
+        {
+            output[offset + lane_id] = value;
+        }
+    }
+}
 
-        // Load the first block of input values
-        block_load_type().load(input + block_offset, values, storage.load);
-        ::rocprim::syncthreads();
-        // Perform scan operation
-        segmented_scan_block_scan<Exclusive, false, block_scan_type>(
-            values, values, prefix, storage.scan, scan_op
+// Stores the reduction of the part of the last segment of the block's range of tiles
+// if the segment is continued by next blocks.
+// Unlike segmented_reduce_range (which loads items striped), tiles are loaded blocked and
+// reduced in order of items, so scan_op is not required to be commutative.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class ResultType,
+    class InputIterator,
+    class OffsetIterator,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void segmented_scan_tiles_reduce(InputIterator input,
+                                 const unsigned int segments,
+                                 OffsetIterator begin_offsets,
+                                 const unsigned int * tile_offsets,
+                                 ResultType * partials,
+                                 BinaryFunction scan_op)
+{
+    constexpr unsigned int items_per_tile = BlockSize * ItemsPerThread;
+
+    using block_load_type = typename segmented_scan_block_helper<BlockSize, ItemsPerThread, ResultType>::block_load_type;
+    using reduce_type = ::rocprim::block_reduce<ResultType, BlockSize>;
+
+    union storage_type
+    {
+        typename block_load_type::storage_type load;
+        typename reduce_type::storage_type reduce;
+    };
+
+    ROCPRIM_SHARED_MEMORY storage_type storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+
+    const unsigned int tiles = tile_offsets[segments];
+    const unsigned int tiles_per_block =
+        segmented_reduce_tiles_per_block(tiles, ::rocprim::detail::grid_size<0>());
+    const unsigned int begin_tile = ::rocprim::min(tiles, block_id * tiles_per_block);
+    const unsigned int end_tile = ::rocprim::min(tiles, begin_tile + tiles_per_block);
+    // All threads of the block exit together
+    if(begin_tile == end_tile)
+    {
+        return;
+    }
+
+    const unsigned int segment_id = segmented_tiles_find_segment(tile_offsets, segments, end_tile - 1);
+    const unsigned int segment_begin_tile = tile_offsets[segment_id];
+    // The last segment ends in this block
+    if(tile_offsets[segment_id + 1] <= end_tile)
+    {
+        return;
+    }
+
+    // The part of the segment consists of full tiles
+    const unsigned int segment_begin_offset = begin_offsets[segment_id];
+    const unsigned int first_tile = ::rocprim::max(begin_tile, segment_begin_tile);
+
+    ResultType values[ItemsPerThread];
+    // Valid in thread 0 only
+    ResultType result;
+    for(unsigned int tile = first_tile; tile < end_tile; tile++)
+    {
+        block_load_type().load(
+            input + segment_begin_offset + (tile - segment_begin_tile) * items_per_tile,
+            values, storage.load
         );
         ::rocprim::syncthreads();
-        // Store
-        block_store_type().store(output + block_offset, values, storage.store);
+        ResultType tile_result;
+        reduce_type().reduce(values, tile_result, storage.reduce, scan_op);
         ::rocprim::syncthreads();
-        block_offset += items_per_block;
+        if(tile == first_tile)
+        {
+            result = tile_result;
+        }
+        else
+        {
+            result = scan_op(result, tile_result);
+        }
+    }
+    if(flat_id == 0)
+    {
+        partials[block_id] = result;
+    }
+}
 
-        // Load next full blocks and continue scanning
-        while(block_offset + items_per_block < end_offset)
+template<
+    bool Exclusive,
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE inline
+void segmented_scan_tiles(InputIterator input,
+                          OutputIterator output,
+                          const unsigned int segments,
+                          OffsetIterator begin_offsets,
+                          OffsetIterator end_offsets,
+                          const unsigned int * tile_offsets,
+                          const ResultType * partials,
+                          InitValueType initial_value,
+                          BinaryFunction scan_op)
+{
+    constexpr unsigned int items_per_tile = BlockSize * ItemsPerThread;
+
+    using helper = segmented_scan_block_helper<BlockSize, ItemsPerThread, ResultType>;
+
+    ROCPRIM_SHARED_MEMORY typename helper::storage_type storage;
+
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+
+    const unsigned int tiles = tile_offsets[segments];
+    const unsigned int tiles_per_block =
+        segmented_reduce_tiles_per_block(tiles, ::rocprim::detail::grid_size<0>());
+    const unsigned int begin_tile = ::rocprim::min(tiles, block_id * tiles_per_block);
+    const unsigned int end_tile = ::rocprim::min(tiles, begin_tile + tiles_per_block);
+    // All threads of the block exit together
+    if(begin_tile == end_tile)
+    {
+        return;
+    }
+
+    unsigned int segment_id = segmented_tiles_find_segment(tile_offsets, segments, begin_tile);
+    unsigned int tile = begin_tile;
+    while(tile < end_tile)
+    {
+        // Skip small segments
+        while(tile_offsets[segment_id + 1] <= tile)
         {
-            block_load_type().load(input + block_offset, values, storage.load);
-            ::rocprim::syncthreads();
-            // Perform scan operation
-            segmented_scan_block_scan<Exclusive, true, block_scan_type>(
-                values, values, prefix, storage.scan, scan_op
-            );
-            ::rocprim::syncthreads();
-            block_store_type().store(output + block_offset, values, storage.store);
-            ::rocprim::syncthreads();
-            block_offset += items_per_block;
+            segment_id++;
         }
+        const unsigned int segment_begin_tile = tile_offsets[segment_id];
+        const unsigned int segment_end_tile = tile_offsets[segment_id + 1];
+        const unsigned int next_tile = ::rocprim::min(segment_end_tile, end_tile);
 
-        // Load the last (probably partial) block and continue scanning
-        const unsigned int valid_count = end_offset - block_offset;
-        block_load_type().load(input + block_offset, values, valid_count, storage.load);
-        ::rocprim::syncthreads();
-        // Perform scan operation
-        segmented_scan_block_scan<Exclusive, true, block_scan_type>(
-            values, values, prefix, storage.scan, scan_op
+        const unsigned int segment_begin_offset = begin_offsets[segment_id];
+        const unsigned int segment_end_offset = end_offsets[segment_id];
+        const unsigned int begin_offset = segment_begin_offset + (tile - segment_begin_tile) * items_per_tile;
+        const unsigned int end_offset = ::rocprim::min(
+            segment_end_offset,
+            segment_begin_offset + (next_tile - segment_begin_tile) * items_per_tile
         );
-        ::rocprim::syncthreads();
-        // Store the partial block
-        block_store_type().store(output + block_offset, values, valid_count, storage.store);
+
+        ResultType prefix = static_cast<ResultType>(initial_value);
+        bool use_prefix = Exclusive;
+        if(tile > segment_begin_tile)
+        {
+            // The segment is started by previous blocks, all of them have stored
+            // reductions of their parts of the segment
+            const unsigned int first_block = segment_begin_tile / tiles_per_block;
+            ResultType carry = partials[first_block];
+            for(unsigned int previous_block_id = first_block + 1; previous_block_id < block_id; previous_block_id++)
+            {
+                carry = scan_op(carry, partials[previous_block_id]);
+            }
+            prefix = Exclusive ? scan_op(prefix, carry) : carry;
+            use_prefix = true;
+        }
+
+        segmented_scan_range<Exclusive, BlockSize, ItemsPerThread>(
+            input, output, begin_offset, end_offset,
+            prefix, use_prefix,
+            scan_op, storage
+        );
+
+        tile = next_tile;
     }
 }
 
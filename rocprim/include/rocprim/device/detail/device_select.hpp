@@ -32,244 +32,488 @@
 #include "../../types.hpp"
 
 #include "../../block/block_load.hpp"
-#include "../../block/block_store.hpp"
+#include "../../block/block_scan.hpp"
 #include "../../block/block_discontinuity.hpp"
 
+#include "lookback_scan_state.hpp"
+
 BEGIN_ROCPRIM_NAMESPACE
 
 namespace detail
 {
 
+enum class select_method
+{
+    flag,
+    predicate,
+    unique
+};
+
+// Selection flags are read from flags range
 template<
+    select_method SelectMethod,
     unsigned int BlockSize,
-    unsigned int ItemsPerThread,
+    class BlockLoadFlagsType,
+    class BlockDiscontinuityType,
     class InputIterator,
     class FlagIterator,
-    class OutputIterator,
-    class SelectedCountOutputIterator
+    class ValueType,
+    unsigned int ItemsPerThread,
+    class SelectOp,
+    class InequalityOp,
+    class StorageType
 >
 ROCPRIM_DEVICE inline
-void scatter_kernel_impl(InputIterator input,
-                         size_t input_size,
-                         FlagIterator flags,
-                         unsigned int * output_indices,
-                         OutputIterator output,
-                         SelectedCountOutputIterator selected_count_output)
+auto partition_block_load_flags(InputIterator /* block_predecessor */,
+                                FlagIterator block_flags,
+                                ValueType (&/* values */)[ItemsPerThread],
+                                bool (&is_selected)[ItemsPerThread],
+                                SelectOp /* select_op */,
+                                InequalityOp /* inequality_op */,
+                                StorageType& storage,
+                                const unsigned int /* block_id */,
+                                const bool is_last_block,
+                                const unsigned int valid_in_last_block)
+    -> typename std::enable_if<SelectMethod == select_method::flag>::type
 {
-    using input_type = typename std::iterator_traits<InputIterator>::value_type;
-    using output_type = typename std::iterator_traits<OutputIterator>::value_type;
-    using value_type = typename std::conditional<
-        std::is_same<void, output_type>::value,
-        input_type,
-        typename std::conditional<
-            (sizeof(output_type) > sizeof(input_type)),
-            input_type,
-            output_type
-        >::type
-    >::type;
-    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
-
-    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
-    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
-    const unsigned int block_offset = flat_block_id * items_per_block;
-    const unsigned int number_of_blocks = (input_size + items_per_block - 1)/items_per_block;
-    auto valid_in_last_block = input_size - items_per_block * (number_of_blocks - 1);
-
-    value_type values[ItemsPerThread];
-    unsigned int out_indices[ItemsPerThread];
-    bool is_selected[ItemsPerThread];
-
-    // load input values into values
-    if(flat_block_id == (number_of_blocks - 1)) // last block
+    if(is_last_block)
     {
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            input + block_offset,
-            values,
-            valid_in_last_block
-        );
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            output_indices + block_offset,
-            out_indices,
-            valid_in_last_block
-        );
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            flags + block_offset,
-            is_selected,
-            valid_in_last_block
-        );
+        BlockLoadFlagsType()
+            .load(
+                block_flags,
+                is_selected,
+                valid_in_last_block,
+                false,
+                storage.load_flags
+            );
     }
     else
     {
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            input + block_offset,
-            values
-        );
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            output_indices + block_offset,
-            out_indices
-        );
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            flags + block_offset,
-            is_selected
-        );
+        BlockLoadFlagsType()
+            .load(
+                block_flags,
+                is_selected,
+                storage.load_flags
+            );
     }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+}
 
-    // Scatter
-    unsigned int index = block_offset + flat_id;
+// Selection flags are computed by select_op
+template<
+    select_method SelectMethod,
+    unsigned int BlockSize,
+    class BlockLoadFlagsType,
+    class BlockDiscontinuityType,
+    class InputIterator,
+    class FlagIterator,
+    class ValueType,
+    unsigned int ItemsPerThread,
+    class SelectOp,
+    class InequalityOp,
+    class StorageType
+>
+ROCPRIM_DEVICE inline
+auto partition_block_load_flags(InputIterator /* block_predecessor */,
+                                FlagIterator /* block_flags */,
+                                ValueType (&values)[ItemsPerThread],
+                                bool (&is_selected)[ItemsPerThread],
+                                SelectOp select_op,
+                                InequalityOp /* inequality_op */,
+                                StorageType& /* storage */,
+                                const unsigned int /* block_id */,
+                                const bool is_last_block,
+                                const unsigned int valid_in_last_block)
+    -> typename std::enable_if<SelectMethod == select_method::predicate>::type
+{
+    const unsigned int offset = ::rocprim::detail::block_thread_id<0>() * ItemsPerThread;
     #pragma unroll
-    for(auto i = 0U; i < ItemsPerThread; i++)
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
     {
-        if(index < input_size)
-        {
-            if(is_selected[i])
-            {
-                output[out_indices[i]] = values[i];
-            }
-        }
-        index += BlockSize;
+        is_selected[i] = (!is_last_block || (offset + i) < valid_in_last_block)
+            && select_op(values[i]);
     }
+}
 
-    // First thread in first block updates total number of selected values
-    if((flat_id + block_offset) == 0)
+// Selection flags are heads of runs of equal values
+template<
+    select_method SelectMethod,
+    unsigned int BlockSize,
+    class BlockLoadFlagsType,
+    class BlockDiscontinuityType,
+    class InputIterator,
+    class FlagIterator,
+    class ValueType,
+    unsigned int ItemsPerThread,
+    class SelectOp,
+    class InequalityOp,
+    class StorageType
+>
+ROCPRIM_DEVICE inline
+auto partition_block_load_flags(InputIterator block_predecessor,
+                                FlagIterator /* block_flags */,
+                                ValueType (&values)[ItemsPerThread],
+                                bool (&is_selected)[ItemsPerThread],
+                                SelectOp /* select_op */,
+                                InequalityOp inequality_op,
+                                StorageType& storage,
+                                const unsigned int block_id,
+                                const bool is_last_block,
+                                const unsigned int valid_in_last_block)
+    -> typename std::enable_if<SelectMethod == select_method::unique>::type
+{
+    if(block_id > 0)
     {
-        *selected_count_output = output_indices[input_size - 1] + flags[input_size - 1];
+        const ValueType predecessor = *block_predecessor;
+        BlockDiscontinuityType()
+            .flag_heads(
+                is_selected,
+                predecessor,
+                values,
+                inequality_op,
+                storage.discontinuity
+            );
+    }
+    else
+    {
+        BlockDiscontinuityType()
+            .flag_heads(
+                is_selected,
+                values,
+                inequality_op,
+                storage.discontinuity
+            );
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    // Out-of-bound items are never selected
+    if(is_last_block)
+    {
+        const unsigned int offset = ::rocprim::detail::block_thread_id<0>() * ItemsPerThread;
+        #pragma unroll
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            is_selected[i] = is_selected[i] && (offset + i) < valid_in_last_block;
+        }
     }
 }
 
+// Single-pass select/partition: every input item (and flag) is read from global
+// memory once, output positions of selected items are computed with decoupled
+// look-back over per-block selected counts. Selected items are compacted in shared
+// memory and written to output with coalesced stores. If OnlySelected is false,
+// rejected items are written in reverse order to the back of output (partition).
+// The last block writes the total number of selected items.
 template<
+    select_method SelectMethod,
+    bool OnlySelected,
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
     class InputIterator,
+    class FlagIterator,
     class OutputIterator,
     class SelectedCountOutputIterator,
-    class SelectOp
+    class SelectOp,
+    class InequalityOp,
+    class LookbackScanState
 >
 ROCPRIM_DEVICE inline
-void scatter_if_kernel_impl(InputIterator input,
-                            size_t input_size,
-                            unsigned int * output_indices,
-                            OutputIterator output,
-                            SelectedCountOutputIterator selected_count_output,
-                            SelectOp select_op)
+void partition_kernel_impl(InputIterator input,
+                           FlagIterator flags,
+                           OutputIterator output,
+                           SelectedCountOutputIterator selected_count_output,
+                           const size_t size,
+                           SelectOp select_op,
+                           InequalityOp inequality_op,
+                           LookbackScanState scan_state,
+                           const unsigned int number_of_blocks,
+                           ordered_block_id<unsigned int> ordered_bid)
 {
-    using input_type = typename std::iterator_traits<InputIterator>::value_type;
-    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    constexpr auto items_per_block = BlockSize * ItemsPerThread;
+
+    using offset_type = unsigned int;
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+    static_assert(
+        std::is_same<offset_type, typename LookbackScanState::value_type>::value,
+        "value_type of LookbackScanState must be unsigned int"
+    );
+
+    using block_load_type = ::rocprim::block_load<
+        value_type, BlockSize, ItemsPerThread,
+        ::rocprim::block_load_method::block_load_transpose
+    >;
+    using block_load_flags_type = ::rocprim::block_load<
+        bool, BlockSize, ItemsPerThread,
+        ::rocprim::block_load_method::block_load_transpose
+    >;
+    using block_discontinuity_type = ::rocprim::block_discontinuity<
+        value_type, BlockSize
+    >;
+    using block_scan_type = ::rocprim::block_scan<
+        offset_type, BlockSize,
+        ::rocprim::block_scan_algorithm::using_warp_scan
+    >;
+    using ordered_block_id_type = ordered_block_id<unsigned int>;
+    using lookback_scan_prefix_op_type = lookback_scan_prefix_op<
+        offset_type, ::rocprim::plus<offset_type>, LookbackScanState
+    >;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename ordered_block_id_type::storage_type ordered_bid;
+        offset_type selected_prefix;
+        offset_type selected_end;
+        union
+        {
+            typename block_load_type::storage_type load;
+            typename block_load_flags_type::storage_type load_flags;
+            typename block_discontinuity_type::storage_type discontinuity;
+            typename block_scan_type::storage_type scan;
+            value_type exchange[items_per_block];
+        };
+    } storage;
 
+    // It's assumed kernel is executed in 1D
     const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
-    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+    const unsigned int flat_block_id = ordered_bid.get(flat_id, storage.ordered_bid);
     const unsigned int block_offset = flat_block_id * items_per_block;
-    const unsigned int number_of_blocks = (input_size + items_per_block - 1)/items_per_block;
-    auto valid_in_last_block = input_size - items_per_block * (number_of_blocks - 1);
+    const bool is_last_block = flat_block_id == (number_of_blocks - 1);
+    const unsigned int valid_in_last_block =
+        size - size_t(items_per_block) * (number_of_blocks - 1);
 
-    input_type values[ItemsPerThread];
-    unsigned int out_indices[ItemsPerThread];
+    value_type values[ItemsPerThread];
+    bool is_selected[ItemsPerThread];
+    offset_type output_indices[ItemsPerThread];
 
     // load input values into values
-    if(flat_block_id == (number_of_blocks - 1)) // last block
+    if(is_last_block)
     {
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            input + block_offset,
-            values,
-            valid_in_last_block
-        );
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            output_indices + block_offset,
-            out_indices,
-            valid_in_last_block
-        );
+        block_load_type()
+            .load(
+                input + block_offset,
+                values,
+                valid_in_last_block,
+                storage.load
+            );
     }
     else
     {
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            input + block_offset,
-            values
-        );
-        block_load_direct_striped<BlockSize>(
-            flat_id,
-            output_indices + block_offset,
-            out_indices
+        block_load_type()
+            .load(
+                input + block_offset,
+                values,
+                storage.load
+            );
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    partition_block_load_flags<
+        SelectMethod, BlockSize,
+        block_load_flags_type, block_discontinuity_type
+    >(
+        input + block_offset - (flat_block_id > 0 ? 1 : 0),
+        flags + block_offset,
+        values,
+        is_selected,
+        select_op,
+        inequality_op,
+        storage,
+        flat_block_id,
+        is_last_block,
+        valid_in_last_block
+    );
+
+    #pragma unroll
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        output_indices[i] = is_selected[i] ? 1 : 0;
+    }
+
+    // Global exclusive prefix of selected items
+    if(flat_block_id == 0)
+    {
+        offset_type reduction;
+        block_scan_type()
+            .exclusive_scan(
+                output_indices, // input
+                output_indices, // output
+                offset_type(0),
+                reduction,
+                storage.scan,
+                ::rocprim::plus<offset_type>()
+            );
+        if(flat_id == 0)
+        {
+            scan_state.set_complete(flat_block_id, reduction);
+        }
+    }
+    else
+    {
+        auto prefix_op = lookback_scan_prefix_op_type(
+            flat_block_id, ::rocprim::plus<offset_type>(), scan_state
         );
+        block_scan_type()
+            .exclusive_scan(
+                output_indices, // input
+                output_indices, // output
+                storage.scan,
+                prefix_op,
+                ::rocprim::plus<offset_type>()
+            );
     }
 
-    // Scatter
-    unsigned int index = block_offset + flat_id;
+    // First and last threads know the range of output positions of this block
+    if(flat_id == 0)
+    {
+        storage.selected_prefix = output_indices[0];
+    }
+    if(flat_id == BlockSize - 1)
+    {
+        storage.selected_end = output_indices[ItemsPerThread - 1]
+            + (is_selected[ItemsPerThread - 1] ? 1 : 0);
+    }
+    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+    const offset_type selected_prefix = storage.selected_prefix;
+    const offset_type selected_in_block = storage.selected_end - selected_prefix;
+
+    const unsigned int valid_in_block = is_last_block ? valid_in_last_block : items_per_block;
+
+    // Compact selected values in shared memory, rejected values (if needed)
+    // are placed after them
     #pragma unroll
-    for(auto i = 0U; i < ItemsPerThread; i++)
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
     {
-        if(index < input_size)
+        const unsigned int item_id = flat_id * ItemsPerThread + i;
+        const unsigned int selected_id = output_indices[i] - selected_prefix;
+        if(is_selected[i])
+        {
+            storage.exchange[selected_id] = values[i];
+        }
+        else if(!OnlySelected && item_id < valid_in_block)
         {
-            if(select_op(values[i]))
-            {
-                output[out_indices[i]] = values[i];
-            }
+            storage.exchange[selected_in_block + item_id - selected_id] = values[i];
         }
-        index += BlockSize;
     }
+    ::rocprim::syncthreads();
 
-    // First thread in first block updates total number of selected values
-    if((flat_id + block_offset) == 0)
+    // Coalesced store of selected values and reversed rejected values
+    const unsigned int store_size = OnlySelected ? selected_in_block : valid_in_block;
+    const size_t rejected_prefix = size_t(block_offset) - selected_prefix;
+    for(unsigned int i = flat_id; i < store_size; i += BlockSize)
     {
-        *selected_count_output =
-            output_indices[input_size - 1] + select_op(input[input_size - 1]);
+        if(i < selected_in_block)
+        {
+            output[selected_prefix + i] = storage.exchange[i];
+        }
+        else
+        {
+            output[size - 1 - rejected_prefix - (i - selected_in_block)] = storage.exchange[i];
+        }
     }
+
+    // Last block updates total number of selected values
+    if(is_last_block && flat_id == 0)
+    {
+        *selected_count_output = selected_prefix + selected_in_block;
+    }
+}
+
+// Numbers of items in the first and the second part of three-way partition
+struct partition_three_way_offset
+{
+    unsigned int first;
+    unsigned int second;
+};
+
+ROCPRIM_HOST_DEVICE inline
+partition_three_way_offset operator+(const partition_three_way_offset& a,
+                                     const partition_three_way_offset& b)
+{
+    return partition_three_way_offset { a.first + b.first, a.second + b.second };
 }
 
+// Single-pass three-way partition: items for which select_first_part_op returns true
+// go to the first part, remaining items for which select_second_part_op returns true
+// go to the second part, all other items are unselected. Relative order is kept
+// in all three outputs. Per-block sizes of both parts are scanned together with
+// decoupled look-back.
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
     class InputIterator,
-    class OutputFlagIterator,
-    class InequalityOp
+    class FirstOutputIterator,
+    class SecondOutputIterator,
+    class UnselectedOutputIterator,
+    class SelectedCountOutputIterator,
+    class FirstUnaryPredicate,
+    class SecondUnaryPredicate,
+    class LookbackScanState
 >
 ROCPRIM_DEVICE inline
-void flag_unique_kernel_impl(InputIterator input,
-                             size_t input_size,
-                             OutputFlagIterator output_flags,
-                             InequalityOp inequality_op)
+void partition_three_way_kernel_impl(InputIterator input,
+                                     FirstOutputIterator output_first_part,
+                                     SecondOutputIterator output_second_part,
+                                     UnselectedOutputIterator output_unselected,
+                                     SelectedCountOutputIterator selected_count_output,
+                                     const size_t size,
+                                     FirstUnaryPredicate select_first_part_op,
+                                     SecondUnaryPredicate select_second_part_op,
+                                     LookbackScanState scan_state,
+                                     const unsigned int number_of_blocks,
+                                     ordered_block_id<unsigned int> ordered_bid)
 {
-    using input_type = typename std::iterator_traits<InputIterator>::value_type;
-    // using flag_type = typename std::iterator_traits<OutputFlagIterator>::value_type;
+    constexpr auto items_per_block = BlockSize * ItemsPerThread;
 
-    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    using offset_type = partition_three_way_offset;
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+    static_assert(
+        std::is_same<offset_type, typename LookbackScanState::value_type>::value,
+        "value_type of LookbackScanState must be partition_three_way_offset"
+    );
 
     using block_load_type = ::rocprim::block_load<
-        input_type, BlockSize, ItemsPerThread,
+        value_type, BlockSize, ItemsPerThread,
         ::rocprim::block_load_method::block_load_transpose
     >;
-    using block_store_type = ::rocprim::block_store<
-        bool, BlockSize, ItemsPerThread,
-        ::rocprim::block_store_method::block_store_transpose
+    using block_scan_type = ::rocprim::block_scan<
+        offset_type, BlockSize,
+        ::rocprim::block_scan_algorithm::using_warp_scan
     >;
-    using block_discontinuity_type = ::rocprim::block_discontinuity<
-        input_type, BlockSize
+    using ordered_block_id_type = ordered_block_id<unsigned int>;
+    using lookback_scan_prefix_op_type = lookback_scan_prefix_op<
+        offset_type, ::rocprim::plus<offset_type>, LookbackScanState
     >;
 
-    ROCPRIM_SHARED_MEMORY union
+    ROCPRIM_SHARED_MEMORY struct
     {
-        typename block_load_type::storage_type load;
-        typename block_store_type::storage_type store;
-        typename block_discontinuity_type::storage_type discontinuity;
+        typename ordered_block_id_type::storage_type ordered_bid;
+        offset_type selected_prefix;
+        offset_type selected_end;
+        union
+        {
+            typename block_load_type::storage_type load;
+            typename block_scan_type::storage_type scan;
+            value_type exchange[items_per_block];
+        };
     } storage;
 
-    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+    // It's assumed kernel is executed in 1D
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id = ordered_bid.get(flat_id, storage.ordered_bid);
     const unsigned int block_offset = flat_block_id * items_per_block;
-    const unsigned int number_of_blocks = (input_size + items_per_block - 1)/items_per_block;
-    auto valid_in_last_block = input_size - items_per_block * (number_of_blocks - 1);
+    const bool is_last_block = flat_block_id == (number_of_blocks - 1);
+    const unsigned int valid_in_last_block =
+        size - size_t(items_per_block) * (number_of_blocks - 1);
+    const unsigned int valid_in_block = is_last_block ? valid_in_last_block : items_per_block;
 
-    input_type values[ItemsPerThread];
-    input_type predecessor;
+    value_type values[ItemsPerThread];
+    bool is_first[ItemsPerThread];
+    bool is_second[ItemsPerThread];
+    offset_type output_indices[ItemsPerThread];
 
     // load input values into values
-    if(flat_block_id == (number_of_blocks - 1)) // last block
+    if(is_last_block)
     {
         block_load_type()
             .load(
@@ -290,48 +534,125 @@ void flag_unique_kernel_impl(InputIterator input,
     }
     ::rocprim::syncthreads(); // sync threads to reuse shared memory
 
-    bool flags[ItemsPerThread];
-    if(flat_block_id > 0)
+    #pragma unroll
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
     {
-        predecessor = input[block_offset - 1];
-        block_discontinuity_type()
-            .flag_heads(
-                flags,
-                predecessor,
-                values,
-                inequality_op
+        const bool is_valid = (flat_id * ItemsPerThread + i) < valid_in_block;
+        is_first[i] = is_valid && select_first_part_op(values[i]);
+        is_second[i] = is_valid && !is_first[i] && select_second_part_op(values[i]);
+        output_indices[i] = offset_type { is_first[i] ? 1U : 0U, is_second[i] ? 1U : 0U };
+    }
+
+    // Global exclusive prefixes of both parts
+    if(flat_block_id == 0)
+    {
+        offset_type reduction;
+        block_scan_type()
+            .exclusive_scan(
+                output_indices, // input
+                output_indices, // output
+                offset_type { 0, 0 },
+                reduction,
+                storage.scan,
+                ::rocprim::plus<offset_type>()
             );
+        if(flat_id == 0)
+        {
+            scan_state.set_complete(flat_block_id, reduction);
+        }
     }
     else
     {
-        block_discontinuity_type()
-            .flag_heads(
-                flags,
-                values,
-                inequality_op
+        auto prefix_op = lookback_scan_prefix_op_type(
+            flat_block_id, ::rocprim::plus<offset_type>(), scan_state
+        );
+        block_scan_type()
+            .exclusive_scan(
+                output_indices, // input
+                output_indices, // output
+                storage.scan,
+                prefix_op,
+                ::rocprim::plus<offset_type>()
             );
     }
+
+    // First and last threads know the ranges of output positions of this block
+    if(flat_id == 0)
+    {
+        storage.selected_prefix = output_indices[0];
+    }
+    if(flat_id == BlockSize - 1)
+    {
+        storage.selected_end = output_indices[ItemsPerThread - 1] + offset_type {
+            is_first[ItemsPerThread - 1] ? 1U : 0U,
+            is_second[ItemsPerThread - 1] ? 1U : 0U
+        };
+    }
     ::rocprim::syncthreads(); // sync threads to reuse shared memory
 
-    // Save values into output array
-    if(flat_block_id == (number_of_blocks - 1)) // last block
+    const offset_type selected_prefix = storage.selected_prefix;
+    const unsigned int first_in_block = storage.selected_end.first - selected_prefix.first;
+    const unsigned int second_in_block = storage.selected_end.second - selected_prefix.second;
+    const unsigned int selected_in_block = first_in_block + second_in_block;
+
+    // Compact values in shared memory: first part, second part, unselected
+    #pragma unroll
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
     {
-        block_store_type()
-            .store(
-                output_flags + block_offset,
-                flags,
-                valid_in_last_block,
-                storage.store
-            );
+        const unsigned int item_id = flat_id * ItemsPerThread + i;
+        const unsigned int first_id = output_indices[i].first - selected_prefix.first;
+        const unsigned int second_id = output_indices[i].second - selected_prefix.second;
+        if(is_first[i])
+        {
+            storage.exchange[first_id] = values[i];
+        }
+        else if(is_second[i])
+        {
+            storage.exchange[first_in_block + second_id] = values[i];
+        }
+        else if(item_id < valid_in_block)
+        {
+            storage.exchange[selected_in_block + item_id - first_id - second_id] = values[i];
+        }
     }
-    else
+    ::rocprim::syncthreads();
+
+    // Coalesced store of all three parts
+    const size_t unselected_prefix =
+        size_t(block_offset) - selected_prefix.first - selected_prefix.second;
+    for(unsigned int i = flat_id; i < valid_in_block; i += BlockSize)
     {
-        block_store_type()
-            .store(
-                output_flags + block_offset,
-                flags,
-                storage.store
-            );
+        if(i < first_in_block)
+        {
+            output_first_part[selected_prefix.first + i] = storage.exchange[i];
+        }
+        else if(i < selected_in_block)
+        {
+            output_second_part[selected_prefix.second + i - first_in_block] = storage.exchange[i];
+        }
+        else
+        {
+            output_unselected[unselected_prefix + i - selected_in_block] = storage.exchange[i];
+        }
+    }
+
+    // Last block updates sizes of the first and the second part
+    if(is_last_block && flat_id == 0)
+    {
+        selected_count_output[0] = selected_prefix.first + first_in_block;
+        selected_count_output[1] = selected_prefix.second + second_in_block;
+    }
+}
+
+// Empty input selects nothing, Count selected counts (1 or 2 for three-way partition)
+// must be written anyway
+template<unsigned int Count, class SelectedCountOutputIterator>
+ROCPRIM_DEVICE inline
+void partition_empty_kernel_impl(SelectedCountOutputIterator selected_count_output)
+{
+    for(unsigned int i = 0; i < Count; i++)
+    {
+        selected_count_output[i] = 0;
     }
 }
 
@@ -85,7 +85,19 @@ void transform_kernel_impl(InputIterator input,
                            UnaryFunction transform_op)
 {
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
-    using output_type = typename std::iterator_traits<OutputIterator>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<UnaryFunction, input_type>::type;
+    #else
+    using result_type = typename std::result_of<UnaryFunction(input_type)>::type;
+    #endif
+    using output_value_type = typename std::iterator_traits<OutputIterator>::value_type;
+    // Output iterators with void value_type (e.g. transform_output_iterator)
+    // are assigned results of transform_op
+    using output_type = typename std::conditional<
+        std::is_same<output_value_type, void>::value,
+        result_type,
+        output_value_type
+    >::type;
     constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
 
     const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
@@ -0,0 +1,458 @@
+// Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_LOOKBACK_SCAN_STATE_HPP_
+#define ROCPRIM_DEVICE_DETAIL_LOOKBACK_SCAN_STATE_HPP_
+
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../types.hpp"
+
+#include "../../warp/warp_reduce.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Status of a block (tile) prefix in decoupled look-back scan
+enum prefix_flag
+{
+    // flag for padding, values should be discarded
+    PREFIX_INVALID = -1,
+    // initialized, not result in value
+    PREFIX_EMPTY = 0,
+    // partial prefix value (from single block)
+    PREFIX_PARTIAL = 1,
+    // final prefix value
+    PREFIX_COMPLETE = 2
+};
+
+// Per-block prefixes for decoupled look-back scan. Every block publishes
+// its reduction (partial prefix) and then its inclusive prefix (complete
+// prefix), so later blocks can resolve their own prefix without waiting
+// for all preceding blocks.
+//
+// Prefixes are preceded by warp_size() padding entries flagged as PREFIX_INVALID,
+// so a warp of block N can always read prefixes of blocks N-1, ..., N-warp_size()
+// (indices wrap around into padding for N < warp_size()).
+template<class T, bool IsSmall = (sizeof(T) <= 4)>
+struct lookback_scan_state;
+
+// Flag and prefix value are packed together and stored/loaded with
+// a single atomic operation.
+template<class T>
+struct lookback_scan_state<T, true>
+{
+private:
+    using flag_type_ = char;
+
+    // Type used in atomic store/load operations of block prefix (flag and value)
+    using prefix_underlying_type =
+        typename std::conditional<
+            (sizeof(T) > 2),
+            unsigned long long,
+            unsigned int
+        >::type;
+
+    struct alignas(sizeof(prefix_underlying_type)) prefix_type
+    {
+        flag_type_ flag;
+        T value;
+    };
+    static_assert(sizeof(prefix_underlying_type) == sizeof(prefix_type), "");
+
+public:
+    using flag_type = flag_type_;
+    using value_type = T;
+
+    // temp_storage must point to allocation of get_storage_size(number_of_blocks) bytes
+    ROCPRIM_HOST static inline
+    lookback_scan_state create(void * temp_storage, const unsigned int number_of_blocks)
+    {
+        (void) number_of_blocks;
+        lookback_scan_state state;
+        state.prefixes = reinterpret_cast<prefix_underlying_type*>(temp_storage);
+        return state;
+    }
+
+    ROCPRIM_HOST static inline
+    size_t get_storage_size(const unsigned int number_of_blocks)
+    {
+        return sizeof(prefix_underlying_type) * (::rocprim::warp_size() + number_of_blocks);
+    }
+
+    ROCPRIM_DEVICE inline
+    void initialize_prefix(const unsigned int block_id,
+                           const unsigned int number_of_blocks)
+    {
+        constexpr unsigned int padding = ::rocprim::warp_size();
+        if(block_id < number_of_blocks)
+        {
+            prefix_type prefix;
+            prefix.flag = PREFIX_EMPTY;
+            prefix_underlying_type p;
+            __builtin_memcpy(&p, &prefix, sizeof(prefix_type));
+            prefixes[padding + block_id] = p;
+        }
+        if(block_id < padding)
+        {
+            prefix_type prefix;
+            prefix.flag = PREFIX_INVALID;
+            prefix_underlying_type p;
+            __builtin_memcpy(&p, &prefix, sizeof(prefix_type));
+            prefixes[block_id] = p;
+        }
+    }
+
+    ROCPRIM_DEVICE inline
+    void set_partial(const unsigned int block_id, const T value)
+    {
+        this->set(block_id, PREFIX_PARTIAL, value);
+    }
+
+    ROCPRIM_DEVICE inline
+    void set_complete(const unsigned int block_id, const T value)
+    {
+        this->set(block_id, PREFIX_COMPLETE, value);
+    }
+
+    // Spins until prefix of block block_id is not empty
+    ROCPRIM_DEVICE inline
+    void get(const unsigned int block_id, flag_type& flag, T& value)
+    {
+        constexpr unsigned int padding = ::rocprim::warp_size();
+
+        prefix_type prefix;
+        do
+        {
+            // atomic_add(..., 0) is used to load values atomically
+            prefix_underlying_type p =
+                ::rocprim::atomic_add(&prefixes[padding + block_id], 0);
+            __builtin_memcpy(&prefix, &p, sizeof(prefix_type));
+        } while(prefix.flag == PREFIX_EMPTY);
+
+        flag = prefix.flag;
+        value = prefix.value;
+    }
+
+private:
+    ROCPRIM_DEVICE inline
+    void set(const unsigned int block_id, const flag_type flag, const T value)
+    {
+        constexpr unsigned int padding = ::rocprim::warp_size();
+
+        prefix_type prefix;
+        prefix.flag = flag;
+        prefix.value = value;
+        prefix_underlying_type p;
+        __builtin_memcpy(&p, &prefix, sizeof(prefix_type));
+        ::rocprim::atomic_exch(&prefixes[padding + block_id], p);
+    }
+
+    prefix_underlying_type * prefixes;
+};
+
+// Flags, partial and complete prefixes are stored in separate arrays. Consistency
+// is ensured by memory fences between flag and prefix value store/load operations.
+template<class T>
+struct lookback_scan_state<T, false>
+{
+    using flag_type = char;
+    using value_type = T;
+
+    // temp_storage must point to allocation of get_storage_size(number_of_blocks) bytes
+    ROCPRIM_HOST static inline
+    lookback_scan_state create(void * temp_storage, const unsigned int number_of_blocks)
+    {
+        const auto n = ::rocprim::warp_size() + number_of_blocks;
+        lookback_scan_state state;
+
+        auto ptr = static_cast<char*>(temp_storage);
+
+        state.prefixes_flags = reinterpret_cast<flag_type*>(ptr);
+        ptr += ::rocprim::detail::align_size(n * sizeof(flag_type));
+
+        state.prefixes_partial_values = reinterpret_cast<T*>(ptr);
+        ptr += ::rocprim::detail::align_size(n * sizeof(T));
+
+        state.prefixes_complete_values = reinterpret_cast<T*>(ptr);
+        return state;
+    }
+
+    ROCPRIM_HOST static inline
+    size_t get_storage_size(const unsigned int number_of_blocks)
+    {
+        const auto n = ::rocprim::warp_size() + number_of_blocks;
+        size_t size = ::rocprim::detail::align_size(n * sizeof(flag_type));
+        size += 2 * ::rocprim::detail::align_size(n * sizeof(T));
+        return size;
+    }
+
+    ROCPRIM_DEVICE inline
+    void initialize_prefix(const unsigned int block_id,
+                           const unsigned int number_of_blocks)
+    {
+        constexpr unsigned int padding = ::rocprim::warp_size();
+        if(block_id < number_of_blocks)
+        {
+            prefixes_flags[padding + block_id] = PREFIX_EMPTY;
+        }
+        if(block_id < padding)
+        {
+            prefixes_flags[block_id] = PREFIX_INVALID;
+        }
+    }
+
+    ROCPRIM_DEVICE inline
+    void set_partial(const unsigned int block_id, const T value)
+    {
+        constexpr unsigned int padding = ::rocprim::warp_size();
+
+        store_volatile(&prefixes_partial_values[padding + block_id], value);
+        ::rocprim::detail::memory_fence_device();
+        store_volatile<flag_type>(&prefixes_flags[padding + block_id], PREFIX_PARTIAL);
+    }
+
+    ROCPRIM_DEVICE inline
+    void set_complete(const unsigned int block_id, const T value)
+    {
+        constexpr unsigned int padding = ::rocprim::warp_size();
+
+        store_volatile(&prefixes_complete_values[padding + block_id], value);
+        ::rocprim::detail::memory_fence_device();
+        store_volatile<flag_type>(&prefixes_flags[padding + block_id], PREFIX_COMPLETE);
+    }
+
+    // Spins until prefix of block block_id is not empty
+    ROCPRIM_DEVICE inline
+    void get(const unsigned int block_id, flag_type& flag, T& value)
+    {
+        constexpr unsigned int padding = ::rocprim::warp_size();
+
+        do
+        {
+            flag = load_volatile(&prefixes_flags[padding + block_id]);
+            ::rocprim::detail::memory_fence_device();
+        } while(flag == PREFIX_EMPTY);
+
+        if(flag == PREFIX_PARTIAL)
+            value = load_volatile(&prefixes_partial_values[padding + block_id]);
+        else
+            value = load_volatile(&prefixes_complete_values[padding + block_id]);
+    }
+
+private:
+    flag_type * prefixes_flags;
+    // We need to separate arrays for partial and final prefixes, because
+    // value can be overwritten before flag is changed (flag and value are
+    // not stored in single instruction).
+    T * prefixes_partial_values;
+    T * prefixes_complete_values;
+};
+
+// Block prefix callback for block_scan. It must be called by the whole first
+// warp of a block, block_id must be greater than 0.
+template<class T, class BinaryFunction, class LookbackScanState>
+class lookback_scan_prefix_op
+{
+    using flag_type = typename LookbackScanState::flag_type;
+    static_assert(
+        std::is_same<T, typename LookbackScanState::value_type>::value,
+        "T must be LookbackScanState::value_type"
+    );
+
+    // Prefixes read by consecutive lanes belong to blocks with decreasing ids,
+    // so the operands of scan_op must be swapped during the warp reduction.
+    struct reverse_scan_op
+    {
+        BinaryFunction scan_op;
+
+        ROCPRIM_DEVICE inline
+        T operator()(const T& a, const T& b)
+        {
+            return scan_op(b, a);
+        }
+    };
+
+public:
+    ROCPRIM_DEVICE inline
+    lookback_scan_prefix_op(unsigned int block_id,
+                            BinaryFunction scan_op,
+                            LookbackScanState &scan_state)
+        : block_id_(block_id),
+          scan_op_(scan_op),
+          scan_state_(scan_state)
+    {
+    }
+
+    ROCPRIM_DEVICE inline
+    T operator()(T reduction)
+    {
+        // Set partial prefix for next block
+        if(::rocprim::lane_id() == 0)
+        {
+            scan_state_.set_partial(block_id_, reduction);
+        }
+
+        // Get prefix
+        auto prefix = get_prefix();
+
+        // Set complete prefix for next block
+        if(::rocprim::lane_id() == 0)
+        {
+            scan_state_.set_complete(block_id_, scan_op_(prefix, reduction));
+        }
+        return prefix;
+    }
+
+private:
+    // Reduces prefixes of blocks previous_block_id, previous_block_id - 1, ...,
+    // up to the first complete prefix or warp_size() prefixes. Returns true
+    // if a complete prefix was found. Result is valid only in lane 0.
+    ROCPRIM_DEVICE inline
+    bool reduce_partial_prefixes(unsigned int previous_block_id,
+                                 T& partial_prefix)
+    {
+        using warp_reduce_prefix_type = warp_reduce_crosslane<T, ::rocprim::warp_size(), false>;
+
+        flag_type flag;
+        T block_prefix;
+        scan_state_.get(previous_block_id, flag, block_prefix);
+
+        // Lowest lane with complete prefix closes the look-back window
+        const unsigned long long complete_mask = ::rocprim::ballot(flag == PREFIX_COMPLETE);
+        const unsigned long long first_complete = complete_mask & (~complete_mask + 1);
+        const unsigned int valid_items = complete_mask == 0
+            ? ::rocprim::warp_size()
+            : ::rocprim::bit_count(first_complete - 1) + 1;
+
+        warp_reduce_prefix_type()
+            .reduce(
+                block_prefix,
+                partial_prefix,
+                valid_items,
+                reverse_scan_op { scan_op_ }
+            );
+        return complete_mask != 0;
+    }
+
+    ROCPRIM_DEVICE inline
+    T get_prefix()
+    {
+        T partial_prefix;
+        unsigned int previous_block_id = block_id_ - ::rocprim::lane_id() - 1;
+
+        // Reduce last warp_size() prefixes to get the complete prefix for this block
+        bool complete = reduce_partial_prefixes(previous_block_id, partial_prefix);
+        T prefix = partial_prefix;
+
+        // While complete prefix is not found, move the window and reduce partial prefixes
+        while(!complete)
+        {
+            previous_block_id -= ::rocprim::warp_size();
+            complete = reduce_partial_prefixes(previous_block_id, partial_prefix);
+            prefix = scan_op_(partial_prefix, prefix);
+        }
+        return prefix;
+    }
+
+    unsigned int block_id_;
+    BinaryFunction scan_op_;
+    LookbackScanState& scan_state_;
+};
+
+// Returns consecutive block ids in the order in which blocks start their
+// execution. Decoupled look-back requires that all blocks with lower ids are
+// already running (otherwise a block could wait for a block that can never
+// be scheduled), which is not guaranteed for hardware block ids.
+template<class T = unsigned int>
+struct ordered_block_id
+{
+    static_assert(std::is_integral<T>::value, "T must be integer");
+    using id_type = T;
+
+    // shared memory temporary storage type
+    struct storage_type
+    {
+        id_type id;
+    };
+
+    ROCPRIM_HOST static inline
+    ordered_block_id create(id_type * id)
+    {
+        ordered_block_id ordered_id;
+        ordered_id.id = id;
+        return ordered_id;
+    }
+
+    ROCPRIM_HOST static inline
+    size_t get_storage_size()
+    {
+        return sizeof(id_type);
+    }
+
+    ROCPRIM_DEVICE inline
+    void reset()
+    {
+        *id = static_cast<id_type>(0);
+    }
+
+    ROCPRIM_DEVICE inline
+    id_type get(unsigned int tid, storage_type& storage)
+    {
+        if(tid == 0)
+        {
+            storage.id = ::rocprim::atomic_add(this->id, 1);
+        }
+        ::rocprim::syncthreads();
+        return storage.id;
+    }
+
+    id_type * id;
+};
+
+// Resets look-back scan state and ordered block id before the scan kernel
+template<class LookbackScanState>
+ROCPRIM_DEVICE inline
+void init_lookback_scan_state_kernel_impl(LookbackScanState lookback_scan_state,
+                                          const unsigned int number_of_blocks,
+                                          ordered_block_id<unsigned int> ordered_bid)
+{
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+    const unsigned int block_size = ::rocprim::detail::block_size<0>();
+    const unsigned int block_thread_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int id = (block_id * block_size) + block_thread_id;
+    if(id == 0)
+    {
+        ordered_bid.reset();
+    }
+    lookback_scan_state.initialize_prefix(id, number_of_blocks);
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_LOOKBACK_SCAN_STATE_HPP_
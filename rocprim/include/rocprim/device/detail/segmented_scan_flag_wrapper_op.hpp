@@ -0,0 +1,80 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_SEGMENTED_SCAN_FLAG_WRAPPER_OP_HPP_
+#define ROCPRIM_DEVICE_DETAIL_SEGMENTED_SCAN_FLAG_WRAPPER_OP_HPP_
+
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../types/tuple.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Turns scan_op into an operator on (value, head flag) pairs, so segmented scan with
+// head flags is a regular scan. It does not depend on block-level primitives and is
+// shared by all backends.
+template<class V, class F, class BinaryFunction>
+struct segmented_scan_flag_wrapper_op
+{
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<BinaryFunction, V, V>::type;
+    #else
+    using result_type = typename std::result_of<BinaryFunction(V, V)>::type;
+    #endif
+
+    ROCPRIM_HOST_DEVICE inline
+    segmented_scan_flag_wrapper_op() = default;
+
+    ROCPRIM_HOST_DEVICE inline
+    segmented_scan_flag_wrapper_op(BinaryFunction scan_op)
+        : scan_op_(scan_op)
+    {
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    ~segmented_scan_flag_wrapper_op() = default;
+
+    ROCPRIM_HOST_DEVICE inline
+    rocprim::tuple<result_type, F> operator()(const rocprim::tuple<result_type, F>& t1,
+                                              const rocprim::tuple<result_type, F>& t2) const
+    {
+        if(!rocprim::get<1>(t2))
+        {
+            return rocprim::make_tuple(
+                scan_op_(rocprim::get<0>(t1), rocprim::get<0>(t2)),
+                static_cast<F>(rocprim::get<1>(t1) || rocprim::get<1>(t2))
+            );
+        }
+        return t2;
+    }
+
+private:
+    BinaryFunction scan_op_;
+};
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_SEGMENTED_SCAN_FLAG_WRAPPER_OP_HPP_
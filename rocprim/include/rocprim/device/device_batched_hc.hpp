@@ -0,0 +1,389 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_BATCHED_HC_HPP_
+#define ROCPRIM_DEVICE_DEVICE_BATCHED_HC_HPP_
+
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "../functional.hpp"
+
+#include "device_scan_config.hpp"
+#include "detail/device_batched.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_hc
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_HC_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            acc_view.wait(); \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<
+    bool Exclusive,
+    bool Reduce,
+    class Config,
+    class InputIterators,
+    class OutputIterators,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+void batched_scan_impl(void * temporary_storage,
+                       size_t& storage_size,
+                       InputIterators inputs,
+                       OutputIterators outputs,
+                       const size_t * sizes,
+                       unsigned int problems,
+                       const InitValueType initial_value,
+                       BinaryFunction scan_op,
+                       hc::accelerator_view acc_view,
+                       bool debug_synchronous)
+{
+    using input_iterator_type = typename std::iterator_traits<InputIterators>::value_type;
+    using input_type = typename std::iterator_traits<input_iterator_type>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<BinaryFunction, input_type, input_type>::type;
+    #else
+    using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
+    #endif
+
+    using scan_state_type = detail::lookback_scan_state<result_type>;
+    using ordered_block_id_type = detail::ordered_block_id<unsigned int>;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_scan_config<result_type>
+    >;
+
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
+    constexpr auto items_per_block = block_size * items_per_thread;
+
+    // Blocks are mapped to problems by the prefix sum of tile counts, it is computed
+    // on host and copied to the device together with sizes of problems
+    std::vector<size_t> problems_info(2 * problems + 1);
+    size_t number_of_tiles = 0;
+    for(unsigned int i = 0; i < problems; i++)
+    {
+        size_t tiles = ::rocprim::detail::ceiling_div<size_t>(sizes[i], items_per_block);
+        // Reduction of an empty problem is initial_value, it is stored by its only tile
+        if(Reduce) tiles = ::rocprim::max<size_t>(tiles, 1);
+        problems_info[i] = number_of_tiles;
+        problems_info[problems + 1 + i] = sizes[i];
+        number_of_tiles += tiles;
+    }
+    problems_info[problems] = number_of_tiles;
+    const unsigned int number_of_blocks = static_cast<unsigned int>(number_of_tiles);
+
+    const size_t problems_info_bytes = ::rocprim::detail::align_size(problems_info.size() * sizeof(size_t));
+    const size_t scan_state_bytes =
+        ::rocprim::detail::align_size(scan_state_type::get_storage_size(number_of_blocks));
+
+    // Calculate required temporary storage
+    if(temporary_storage == nullptr)
+    {
+        storage_size = problems_info_bytes + scan_state_bytes + ordered_block_id_type::get_storage_size();
+        // Make sure user won't try to allocate 0 bytes memory
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return;
+    }
+
+    if(number_of_blocks == 0) return;
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous)
+    {
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "problems " << problems << '\n';
+        std::cout << "number of blocks " << number_of_blocks << '\n';
+        std::cout << "items_per_block " << items_per_block << '\n';
+    }
+
+    auto ptr = reinterpret_cast<char*>(temporary_storage);
+    size_t * tile_offsets = reinterpret_cast<size_t *>(ptr);
+    const size_t * device_sizes = tile_offsets + problems + 1;
+    ptr += problems_info_bytes;
+    auto scan_state = scan_state_type::create(ptr, number_of_blocks);
+    ptr += scan_state_bytes;
+    auto ordered_bid = ordered_block_id_type::create(
+        reinterpret_cast<ordered_block_id_type::id_type*>(ptr)
+    );
+
+    hc::array<size_t> device_problems_info(hc::extent<1>(problems_info.size()), acc_view, tile_offsets);
+    hc::copy(problems_info.data(), problems_info.data() + problems_info.size(), device_problems_info);
+
+    // Padding of look-back state must be initialized too
+    const unsigned int init_size = ::rocprim::max(number_of_blocks, ::rocprim::warp_size());
+    auto grid_size = ((init_size + block_size - 1)/block_size) * block_size;
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(grid_size, block_size),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            init_lookback_scan_state_kernel_impl(
+                scan_state, number_of_blocks, ordered_bid
+            );
+        }
+    );
+    ROCPRIM_DETAIL_HC_SYNC("init_batched_scan_state_kernel", number_of_blocks, start)
+
+    grid_size = number_of_blocks * block_size;
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(grid_size, block_size),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            batched_scan_kernel_impl<block_size, items_per_thread, Exclusive, Reduce>(
+                inputs, outputs, tile_offsets, device_sizes, problems,
+                static_cast<result_type>(initial_value),
+                scan_op, scan_state, ordered_bid
+            );
+        }
+    );
+    ROCPRIM_DETAIL_HC_SYNC("batched_scan_kernel", problems, start)
+}
+
+#undef ROCPRIM_DETAIL_HC_SYNC
+
+} // end of detail namespace
+
+/// \brief HC parallel batched inclusive scan primitive for device level.
+///
+/// batched_inclusive_scan function performs inclusive scans of many independent
+/// problems (input and output ranges) in a single kernel launch. It is meant for
+/// a large number of small problems, where launching inclusive_scan for every one
+/// of them is dominated by the launch overhead. Unlike segmented_inclusive_scan,
+/// ranges of problems do not need to be parts of one buffer.
+///
+/// \par Overview
+/// * Supports non-commutative scan operators. However, a scan operator should be
+/// associative.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer. The size depends on \p sizes.
+/// * Every problem is split into tiles, blocks are mapped to tiles of all problems.
+/// * \p inputs and \p outputs must be device-accessible, \p sizes is a host array
+/// which is read before the function returns.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
+/// \tparam InputIterators - random-access iterator type of the range of input iterators
+/// of problems (e.g. <tt>int **</tt>).
+/// \tparam OutputIterators - random-access iterator type of the range of output iterators
+/// of problems.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of input iterators.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] inputs - iterator to the first input iterator, i-th input iterator points to
+/// the first element of i-th problem.
+/// \param [out] outputs - iterator to the first output iterator, i-th output iterator points
+/// to the first element of the output range of i-th problem.
+/// \param [in] sizes - host pointer to the first element of the array of problem sizes.
+/// \param [in] problems - number of problems.
+/// \param [in] scan_op - binary operation function object that will be used for scan.
+/// The signature of the function should be equivalent to the following:
+/// <tt>T f(const T &a, const T &b);</tt>. The default value is \p BinaryFunction().
+/// \param [in] acc_view - [optional] \p hc::accelerator_view object. The default value
+/// is \p hc::accelerator().get_default_view() (default view of the default accelerator).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is \p false.
+///
+/// \par Example
+/// \parblock
+/// In this example two arrays of \p int values are scanned in one launch.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// hc::accelerator_view acc_view = ...;
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// hc::array<int> a_input;         // e.g., [1, 2, 3]
+/// hc::array<int> b_input;         // e.g., [4, 5]
+/// hc::array<int> a_output;        // empty array of 3 elements
+/// hc::array<int> b_output;        // empty array of 2 elements
+/// hc::array<int *> inputs;        // [a_input.accelerator_pointer(), b_input.accelerator_pointer()]
+/// hc::array<int *> outputs;       // [a_output.accelerator_pointer(), b_output.accelerator_pointer()]
+/// size_t sizes[] = { 3, 2 };
+///
+/// size_t temporary_storage_size_bytes;
+/// // Get required size of the temporary storage
+/// rocprim::batched_inclusive_scan(
+///     nullptr, temporary_storage_size_bytes,
+///     inputs.accelerator_pointer(), outputs.accelerator_pointer(), sizes, 2,
+///     rocprim::plus<int>(), acc_view
+/// );
+///
+/// // allocate temporary storage
+/// hc::array<char> temporary_storage(temporary_storage_size_bytes, acc_view);
+///
+/// // perform scans
+/// rocprim::batched_inclusive_scan(
+///     temporary_storage.accelerator_pointer(), temporary_storage_size_bytes,
+///     inputs.accelerator_pointer(), outputs.accelerator_pointer(), sizes, 2,
+///     rocprim::plus<int>(), acc_view
+/// );
+/// // a_output: [1, 3, 6]
+/// // b_output: [4, 9]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class InputIterators,
+    class OutputIterators,
+    class BinaryFunction = ::rocprim::plus<
+        typename std::iterator_traits<typename std::iterator_traits<InputIterators>::value_type>::value_type
+    >
+>
+inline
+void batched_inclusive_scan(void * temporary_storage,
+                            size_t& storage_size,
+                            InputIterators inputs,
+                            OutputIterators outputs,
+                            const size_t * sizes,
+                            unsigned int problems,
+                            BinaryFunction scan_op = BinaryFunction(),
+                            hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
+                            bool debug_synchronous = false)
+{
+    using input_iterator_type = typename std::iterator_traits<InputIterators>::value_type;
+    using input_type = typename std::iterator_traits<input_iterator_type>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<BinaryFunction, input_type, input_type>::type;
+    #else
+    using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
+    #endif
+
+    detail::batched_scan_impl<false, false, Config>(
+        temporary_storage, storage_size,
+        // result_type() is a dummy initial value (not used)
+        inputs, outputs, sizes, problems, result_type(),
+        scan_op, acc_view, debug_synchronous
+    );
+}
+
+/// \brief HC parallel batched exclusive scan primitive for device level.
+///
+/// batched_exclusive_scan function performs exclusive scans of many independent
+/// problems in a single kernel launch, every scan starts with \p initial_value.
+/// See batched_inclusive_scan for details.
+///
+/// \param [in] initial_value - initial value to start the scan of every problem.
+template<
+    class Config = default_config,
+    class InputIterators,
+    class OutputIterators,
+    class InitValueType,
+    class BinaryFunction = ::rocprim::plus<
+        typename std::iterator_traits<typename std::iterator_traits<InputIterators>::value_type>::value_type
+    >
+>
+inline
+void batched_exclusive_scan(void * temporary_storage,
+                            size_t& storage_size,
+                            InputIterators inputs,
+                            OutputIterators outputs,
+                            const size_t * sizes,
+                            unsigned int problems,
+                            const InitValueType initial_value,
+                            BinaryFunction scan_op = BinaryFunction(),
+                            hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
+                            bool debug_synchronous = false)
+{
+    detail::batched_scan_impl<true, false, Config>(
+        temporary_storage, storage_size,
+        inputs, outputs, sizes, problems, initial_value,
+        scan_op, acc_view, debug_synchronous
+    );
+}
+
+/// \brief HC parallel batched reduction primitive for device level.
+///
+/// batched_reduce function reduces many independent problems in a single kernel
+/// launch, the result of i-th problem is written to <tt>outputs[i]</tt>. The reduction
+/// of an empty problem is \p initial_value. See batched_inclusive_scan for details.
+///
+/// \tparam OutputIterator - random-access iterator type of the range of results.
+///
+/// \param [out] outputs - iterator to the first element in the range of results of problems,
+/// it must have at least \p problems elements.
+/// \param [in] initial_value - initial value of the reduction of every problem.
+/// \param [in] reduce_op - binary operation function object that will be used for reduction.
+template<
+    class Config = default_config,
+    class InputIterators,
+    class OutputIterator,
+    class InitValueType,
+    class BinaryFunction = ::rocprim::plus<
+        typename std::iterator_traits<typename std::iterator_traits<InputIterators>::value_type>::value_type
+    >
+>
+inline
+void batched_reduce(void * temporary_storage,
+                    size_t& storage_size,
+                    InputIterators inputs,
+                    OutputIterator outputs,
+                    const size_t * sizes,
+                    unsigned int problems,
+                    const InitValueType initial_value,
+                    BinaryFunction reduce_op = BinaryFunction(),
+                    hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
+                    bool debug_synchronous = false)
+{
+    detail::batched_scan_impl<false, true, Config>(
+        temporary_storage, storage_size,
+        inputs, outputs, sizes, problems, initial_value,
+        reduce_op, acc_view, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule_hc
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_BATCHED_HC_HPP_
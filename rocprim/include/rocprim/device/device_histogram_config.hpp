@@ -0,0 +1,102 @@
+// Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_HISTOGRAM_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_HISTOGRAM_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup devicemodule_configs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level histogram operation.
+///
+/// \tparam HistogramConfig - configuration of histogram kernels. Must be \p kernel_config.
+/// \tparam MaxGridSize - maximum number of blocks to launch for the shared memory
+/// implementation, \p 0 means no limit. The grid is sized from the number of compute units
+/// of the device and the occupancy of the shared memory kernel.
+/// \tparam SharedImplMaxBins - maximum total number of bins for all active channels
+/// for the shared memory histogram implementation (samples -> shared memory bins -> global
+/// memory bins) with one tile of bins. When exceeded, bins are split into tiles that fit
+/// into shared memory of the device, and if more than \p TiledImplMaxTiles tiles are needed,
+/// the global memory implementation is used (samples -> global memory bins).
+/// \tparam SharedImplHistograms - maximum number of copies of the shared memory histogram
+/// per block. Warps of a block are spread between copies, which reduces contention of
+/// atomic operations when samples are skewed. The actual number of copies is limited by
+/// the number of warps and the size of shared memory.
+/// \tparam TiledImplMaxTiles - maximum number of tiles of bins for the shared memory
+/// implementation. All samples are read once per tile.
+/// \tparam SortImplMinBins - minimum total number of bins for all active channels for
+/// the sort implementation (samples -> sorted bins -> run-length-encoded bins -> global memory
+/// bins), which is used instead of the global memory implementation when the shared memory
+/// implementation cannot be used.
+template<
+    class HistogramConfig,
+    unsigned int MaxGridSize = 0,
+    unsigned int SharedImplMaxBins = 1024,
+    unsigned int SharedImplHistograms = 4,
+    unsigned int TiledImplMaxTiles = 4,
+    unsigned int SortImplMinBins = (1 << 16)
+>
+struct histogram_config
+{
+    /// \brief Configuration of histogram kernels.
+    using histogram = HistogramConfig;
+
+    /// \brief Maximum number of blocks to launch for the shared memory implementation
+    /// (\p 0 means no limit).
+    static constexpr unsigned int max_grid_size = MaxGridSize;
+    /// \brief Maximum total number of bins for the shared memory histogram implementation
+    /// with one tile of bins.
+    static constexpr unsigned int shared_impl_max_bins = SharedImplMaxBins;
+    /// \brief Maximum number of copies of the shared memory histogram per block.
+    static constexpr unsigned int shared_impl_histograms = SharedImplHistograms;
+    /// \brief Maximum number of tiles of bins for the shared memory implementation.
+    static constexpr unsigned int tiled_impl_max_tiles = TiledImplMaxTiles;
+    /// \brief Minimum total number of bins for the sort implementation.
+    static constexpr unsigned int sort_impl_min_bins = SortImplMinBins;
+};
+
+namespace detail
+{
+
+// Default configuration of histogram for samples of type Sample
+template<class Sample>
+struct default_histogram_config
+    : histogram_config<scaled_kernel_config<256, 8, Sample>>
+{
+
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule_configs
+
+#endif // ROCPRIM_DEVICE_DEVICE_HISTOGRAM_CONFIG_HPP_
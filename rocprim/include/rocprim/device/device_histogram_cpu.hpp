@@ -0,0 +1,274 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_HISTOGRAM_CPU_HPP_
+#define ROCPRIM_DEVICE_DEVICE_HISTOGRAM_CPU_HPP_
+
+#include <algorithm>
+#include <type_traits>
+#include <iterator>
+#include <chrono>
+#include <iostream>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+#include "cpu_types.hpp"
+#include "detail/cpu_thread_pool.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_cpu
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_CPU_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<
+    class SampleIterator,
+    class Counter,
+    class Level
+>
+inline
+error_t histogram_even_impl(void * temporary_storage,
+                            size_t& storage_size,
+                            SampleIterator samples,
+                            const unsigned int columns,
+                            const unsigned int rows,
+                            const size_t row_stride_bytes,
+                            Counter * histogram,
+                            const unsigned int levels,
+                            const Level lower_level,
+                            const Level upper_level,
+                            const stream_t /* stream */,
+                            const bool debug_synchronous)
+{
+    if(levels < 2)
+    {
+        // Histogram must have at least 1 bin
+        return invalid_value;
+    }
+
+    using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+    if(row_stride_bytes % sizeof(sample_type) != 0)
+    {
+        // Row stride must be a whole multiple of the sample data type size
+        return invalid_value;
+    }
+
+    const size_t row_stride = row_stride_bytes / sizeof(sample_type);
+    // Samples of all rows are partitioned as one range of columns * rows elements
+    const size_t size = size_t(columns) * rows;
+    const unsigned int bins = levels - 1;
+    // Every block has its own histogram, so blocks are not smaller than histograms
+    const cpu_partition partition(size, std::max<size_t>(4096, bins));
+
+    if(temporary_storage == nullptr)
+    {
+        storage_size = ::rocprim::detail::align_size(partition.blocks * bins * sizeof(Counter));
+        // Make sure user won't try to allocate 0 bytes memory
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return success;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        std::cout << "threads " << get_cpu_thread_pool().size() << '\n';
+        std::cout << "blocks " << partition.blocks << '\n';
+        std::cout << "block_size " << partition.block_size << '\n';
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    // The same binning as sample_to_bin_even of the device implementation
+    const Level scale = (upper_level - lower_level) / bins;
+
+    Counter * block_histograms = reinterpret_cast<Counter *>(temporary_storage);
+    cpu_parallel_for(
+        partition.blocks,
+        [&](size_t block)
+        {
+            Counter * block_histogram = block_histograms + block * bins;
+            std::fill(block_histogram, block_histogram + bins, Counter(0));
+            const size_t begin = partition.begin(block);
+            size_t row = begin / columns;
+            size_t column = begin - row * columns;
+            for(size_t i = begin; i < partition.end(block); i++)
+            {
+                const Level s = static_cast<Level>(samples[row * row_stride + column]);
+                if(++column == columns)
+                {
+                    column = 0;
+                    row++;
+                }
+                if(s >= lower_level && s < upper_level)
+                {
+                    const unsigned int bin = static_cast<unsigned int>((s - lower_level) / scale);
+                    block_histogram[std::min(bin, bins - 1)]++;
+                }
+            }
+        }
+    );
+
+    // Histograms of blocks are merged in the same order for all bins, so results are deterministic
+    const cpu_partition bins_partition(bins, 1024);
+    cpu_parallel_for(
+        bins_partition.blocks,
+        [&](size_t bins_block)
+        {
+            for(size_t bin = bins_partition.begin(bins_block); bin < bins_partition.end(bins_block); bin++)
+            {
+                Counter count = 0;
+                for(size_t block = 0; block < partition.blocks; block++)
+                {
+                    count += block_histograms[block * bins + bin];
+                }
+                histogram[bin] = count;
+            }
+        }
+    );
+    ROCPRIM_DETAIL_CPU_SYNC("histogram_even", size, start)
+    return success;
+}
+
+#undef ROCPRIM_DETAIL_CPU_SYNC
+
+} // end of detail namespace
+
+/// \brief Computes a histogram from a sequence of samples using equal-width bins
+/// on host threads.
+///
+/// \par
+/// * The number of histogram bins is (\p levels - 1).
+/// * Bins are evenly-segmented and include the same width of sample values:
+/// (\p upper_level - \p lower_level) / (\p levels - 1).
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam SampleIterator - random-access iterator type of the input range.
+/// \tparam Counter - integer type for histogram bin counters.
+/// \tparam Level - type of histogram boundaries (levels)
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] samples - iterator to the first element in the range of input samples.
+/// \param [in] size - number of elements in the samples range.
+/// \param [out] histogram - pointer to the first element in the histogram range.
+/// \param [in] levels - number of boundaries (levels) for histogram bins.
+/// \param [in] lower_level - lower sample value bound (inclusive) for the first histogram bin.
+/// \param [in] upper_level - upper sample value bound (exclusive) for the last histogram bin.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0) after successful histogram operation;
+/// \p rocprim::invalid_value if \p levels is less than \p 2.
+template<
+    class Config = default_config,
+    class SampleIterator,
+    class Counter,
+    class Level
+>
+inline
+error_t histogram_even(void * temporary_storage,
+                       size_t& storage_size,
+                       SampleIterator samples,
+                       unsigned int size,
+                       Counter * histogram,
+                       unsigned int levels,
+                       Level lower_level,
+                       Level upper_level,
+                       stream_t stream = 0,
+                       bool debug_synchronous = false)
+{
+    using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+    return detail::histogram_even_impl(
+        temporary_storage, storage_size,
+        samples, size, 1, size * sizeof(sample_type),
+        histogram, levels, lower_level, upper_level,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Computes a histogram from a two-dimensional region of samples using equal-width bins
+/// on host threads.
+///
+/// \par
+/// * The two-dimensional region of interest within \p samples can be specified using
+/// the \p columns, \p rows and \p row_stride_bytes parameters.
+/// * Other parameters and the result are the same as in the one-dimensional \p histogram_even.
+///
+/// \param [in] columns - number of elements in each row of the region.
+/// \param [in] rows - number of rows of the region.
+/// \param [in] row_stride_bytes - number of bytes between starts of consecutive rows of the region.
+///
+/// \returns \p rocprim::success (\p 0) after successful histogram operation;
+/// \p rocprim::invalid_value if \p levels is less than \p 2 or \p row_stride_bytes is not
+/// a multiple of the sample size.
+template<
+    class Config = default_config,
+    class SampleIterator,
+    class Counter,
+    class Level
+>
+inline
+error_t histogram_even(void * temporary_storage,
+                       size_t& storage_size,
+                       SampleIterator samples,
+                       unsigned int columns,
+                       unsigned int rows,
+                       size_t row_stride_bytes,
+                       Counter * histogram,
+                       unsigned int levels,
+                       Level lower_level,
+                       Level upper_level,
+                       stream_t stream = 0,
+                       bool debug_synchronous = false)
+{
+    return detail::histogram_even_impl(
+        temporary_storage, storage_size,
+        samples, columns, rows, row_stride_bytes,
+        histogram, levels, lower_level, upper_level,
+        stream, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule_cpu
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_HISTOGRAM_CPU_HPP_
@@ -21,14 +21,19 @@
 #ifndef ROCPRIM_DEVICE_DEVICE_HISTOGRAM_HC_HPP_
 #define ROCPRIM_DEVICE_DEVICE_HISTOGRAM_HC_HPP_
 
+#include <algorithm>
 #include <cmath>
 #include <type_traits>
 #include <iterator>
+#include <limits>
 
 #include "../config.hpp"
 #include "../functional.hpp"
 #include "../detail/various.hpp"
 
+#include "device_histogram_config.hpp"
+#include "device_radix_sort_hc.hpp"
+#include "device_run_length_encode_hc.hpp"
 #include "detail/device_histogram.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -52,6 +57,7 @@ namespace detail
     }
 
 template<
+    class Config,
     unsigned int Channels,
     unsigned int ActiveChannels,
     class SampleIterator,
@@ -73,10 +79,19 @@ void histogram_impl(void * temporary_storage,
 {
     using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
 
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 8;
-    constexpr unsigned int max_grid_size = 1024;
-    constexpr unsigned int shared_impl_max_bins = 1024;
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_histogram_config<sample_type>
+    >;
+
+    constexpr unsigned int block_size = config::histogram::block_size;
+    constexpr unsigned int items_per_thread = config::histogram::items_per_thread;
+    constexpr unsigned int max_grid_size = config::max_grid_size;
+    constexpr unsigned int shared_impl_max_bins = config::shared_impl_max_bins;
+    constexpr unsigned int shared_impl_histograms = config::shared_impl_histograms;
+    constexpr unsigned int tiled_impl_max_tiles = config::tiled_impl_max_tiles;
+    constexpr unsigned int sort_impl_min_bins = config::sort_impl_min_bins;
 
     constexpr unsigned int items_per_block = block_size * items_per_thread;
 
@@ -98,11 +113,103 @@ void histogram_impl(void * temporary_storage,
     const unsigned int blocks_x = ::rocprim::detail::ceiling_div(columns, items_per_block);
     const unsigned int row_stride = row_stride_bytes / sizeof(sample_type);
 
+    unsigned int bins[ActiveChannels];
+    unsigned int bins_bits[ActiveChannels];
+    unsigned int total_bins = 0;
+    unsigned int max_bins = 0;
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        bins[channel] = levels[channel] - 1;
+        bins_bits[channel] = static_cast<unsigned int>(std::log2(detail::next_power_of_two(bins[channel])));
+        total_bins += bins[channel];
+        max_bins = std::max(max_bins, bins[channel]);
+    }
+
+    const size_t shared_memory_bytes = acc_view.get_accelerator().get_max_tile_static_size();
+    const unsigned int compute_units = acc_view.get_accelerator().get_cu_count();
+    // One block uses at most a half of shared memory, so at least two blocks can run
+    // on the same compute unit
+    const unsigned int shared_bins = shared_memory_bytes / 2 / sizeof(unsigned int);
+    const unsigned int tiles = total_bins <= shared_impl_max_bins
+        ? 1 : ::rocprim::detail::ceiling_div(total_bins, shared_bins);
+
+    const bool with_shared_impl = tiles <= tiled_impl_max_tiles;
+
+    const unsigned int tile_bins = ::rocprim::detail::ceiling_div(total_bins, tiles);
+    const unsigned int histograms = std::max(1u, std::min({
+        shared_impl_histograms, block_size / ::rocprim::warp_size(), shared_bins / tile_bins
+    }));
+    const size_t block_histogram_bytes = histograms * tile_bins * sizeof(unsigned int);
+    // Enough blocks to fill all compute units, occupancy is limited by shared memory
+    // and by the number of wavefronts (at most 40) that a compute unit can run
+    constexpr unsigned int max_cu_threads = 40 * ::rocprim::warp_size();
+    const unsigned int blocks_per_cu = std::max(1u, std::min<unsigned int>(
+        shared_memory_bytes / block_histogram_bytes, max_cu_threads / block_size
+    ));
+    unsigned int blocks_per_tile = std::max(1u, compute_units * blocks_per_cu / tiles);
+    if(max_grid_size > 0)
+    {
+        blocks_per_tile = std::min(blocks_per_tile, std::max(1u, max_grid_size / tiles));
+    }
+    const unsigned int grid_size_x = std::max(1u, std::min(blocks_per_tile, blocks_x));
+    const unsigned int grid_size_y = std::max(1u, std::min(rows, blocks_per_tile / grid_size_x));
+    blocks_per_tile = grid_size_x * grid_size_y;
+    // Each block writes its counts of bins of its tile, they are merged later
+    const size_t partial_histograms_bytes =
+        ::rocprim::detail::align_size(size_t(tiles) * blocks_per_tile * tile_bins * sizeof(unsigned int));
+
+    // Samples of all active channels are sorted at once
+    const size_t sort_size = static_cast<size_t>(columns) * rows * ActiveChannels;
+    const bool with_sort_impl = !with_shared_impl
+        && total_bins >= sort_impl_min_bins
+        && sort_size > 0
+        && sort_size <= std::numeric_limits<unsigned int>::max();
+
+    // The key total_bins is used for samples outside of bins
+    const unsigned int sort_bits = static_cast<unsigned int>(std::log2(detail::next_power_of_two(total_bins + 1)));
+    const unsigned int max_runs = static_cast<unsigned int>(std::min<size_t>(sort_size, total_bins + 1));
+    unsigned int * keys = nullptr;
+    unsigned int * sorted_keys = nullptr;
+    unsigned int * counts = nullptr;
+    unsigned int * runs_count = nullptr;
+    size_t sort_bytes = 0;
+    size_t encode_bytes = 0;
+    const size_t keys_bytes = ::rocprim::detail::align_size(sort_size * sizeof(unsigned int));
+    const size_t counts_bytes = ::rocprim::detail::align_size(max_runs * sizeof(unsigned int));
+    const size_t runs_count_bytes = ::rocprim::detail::align_size(sizeof(unsigned int));
+    if(with_sort_impl)
+    {
+        ::rocprim::radix_sort_keys(
+            nullptr, sort_bytes,
+            keys, sorted_keys, sort_size,
+            0, sort_bits,
+            acc_view, debug_synchronous
+        );
+        ::rocprim::run_length_encode(
+            nullptr, encode_bytes,
+            sorted_keys, sort_size,
+            keys, counts, runs_count,
+            acc_view, debug_synchronous
+        );
+    }
+    const size_t nested_bytes = ::rocprim::detail::align_size(std::max(sort_bytes, encode_bytes));
+
     if(temporary_storage == nullptr)
     {
-        // Make sure user won't try to allocate 0 bytes memory, otherwise
-        // user may again pass nullptr as temporary_storage
-        storage_size = 4;
+        if(with_shared_impl)
+        {
+            storage_size = partial_histograms_bytes;
+        }
+        else if(with_sort_impl)
+        {
+            storage_size = nested_bytes + 2 * keys_bytes + counts_bytes + runs_count_bytes;
+        }
+        else
+        {
+            // Make sure user won't try to allocate 0 bytes memory, otherwise
+            // user may again pass nullptr as temporary_storage
+            storage_size = 4;
+        }
         return;
     }
 
@@ -114,18 +221,6 @@ void histogram_impl(void * temporary_storage,
         acc_view.wait();
     }
 
-    unsigned int bins[ActiveChannels];
-    unsigned int bins_bits[ActiveChannels];
-    unsigned int total_bins = 0;
-    unsigned int max_bins = 0;
-    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
-    {
-        bins[channel] = levels[channel] - 1;
-        bins_bits[channel] = static_cast<unsigned int>(std::log2(detail::next_power_of_two(bins[channel])));
-        total_bins += bins[channel];
-        max_bins = std::max(max_bins, bins[channel]);
-    }
-
     fixed_array<Counter *, ActiveChannels> histogram_fixed(histogram);
     fixed_array<unsigned int, ActiveChannels> bins_fixed(bins);
     fixed_array<unsigned int, ActiveChannels> bins_bits_fixed(bins_bits);
@@ -141,27 +236,38 @@ void histogram_impl(void * temporary_storage,
 
     std::chrono::high_resolution_clock::time_point start;
 
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hc::parallel_for_each(
-        acc_view,
-        hc::tiled_extent<1>(::rocprim::detail::ceiling_div(max_bins, block_size) * block_size, block_size),
-        [=](hc::tiled_index<1>) [[hc]]
-        {
-            init_histogram<block_size, ActiveChannels>(histogram_fixed, bins_fixed);
-        }
-    );
-    ROCPRIM_DETAIL_HC_SYNC("init_histogram", max_bins, start);
-
-    if(total_bins <= shared_impl_max_bins)
+    if(!with_shared_impl)
     {
-        const unsigned int grid_size_x = std::min(max_grid_size, blocks_x);
-        const unsigned int grid_size_y = std::min(rows, max_grid_size / grid_size_x);
-        const size_t block_histogram_bytes = total_bins * sizeof(unsigned int);
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hc::parallel_for_each(
             acc_view,
-            hc::tiled_extent<2>(grid_size_y, grid_size_x * block_size, 1, block_size, block_histogram_bytes),
-            [=](hc::tiled_index<2>) [[hc]]
+            hc::tiled_extent<1>(::rocprim::detail::ceiling_div(max_bins, block_size) * block_size, block_size),
+            [=](hc::tiled_index<1>) [[hc]]
+            {
+                init_histogram<block_size, ActiveChannels>(histogram_fixed, bins_fixed);
+            }
+        );
+        ROCPRIM_DETAIL_HC_SYNC("init_histogram", max_bins, start);
+    }
+
+    if(with_shared_impl)
+    {
+        unsigned int * partial_histograms = reinterpret_cast<unsigned int *>(temporary_storage);
+
+        if(debug_synchronous)
+        {
+            std::cout << "tiles " << tiles << '\n';
+            std::cout << "histograms " << histograms << '\n';
+            start = std::chrono::high_resolution_clock::now();
+        }
+        hc::parallel_for_each(
+            acc_view,
+            hc::tiled_extent<3>(
+                tiles, grid_size_y, grid_size_x * block_size,
+                1, 1, block_size,
+                block_histogram_bytes
+            ),
+            [=](hc::tiled_index<3>) [[hc]]
             {
                 fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op_fixed(
                     sample_to_bin_op0, sample_to_bin_op1, sample_to_bin_op2, sample_to_bin_op3
@@ -173,14 +279,92 @@ void histogram_impl(void * temporary_storage,
 
                 histogram_shared<block_size, items_per_thread, Channels, ActiveChannels>(
                     samples, columns, rows, row_stride,
-                    histogram_fixed,
+                    partial_histograms,
                     sample_to_bin_op_fixed,
                     bins_fixed,
+                    tile_bins, histograms,
                     block_histogram
                 );
             }
         );
-        ROCPRIM_DETAIL_HC_SYNC("histogram_shared", grid_size_x * grid_size_y * block_size, start);
+        ROCPRIM_DETAIL_HC_SYNC("histogram_shared", grid_size_x * grid_size_y * tiles * block_size, start);
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hc::parallel_for_each(
+            acc_view,
+            hc::tiled_extent<1>(::rocprim::detail::ceiling_div(total_bins, block_size) * block_size, block_size),
+            [=](hc::tiled_index<1>) [[hc]]
+            {
+                histogram_shared_merge<block_size, ActiveChannels>(
+                    partial_histograms, blocks_per_tile, tile_bins,
+                    histogram_fixed, bins_fixed
+                );
+            }
+        );
+        ROCPRIM_DETAIL_HC_SYNC("histogram_shared_merge", total_bins, start);
+    }
+    else if(with_sort_impl)
+    {
+        char * ptr = reinterpret_cast<char *>(temporary_storage);
+        void * nested_storage = ptr;
+        ptr += nested_bytes;
+        keys = reinterpret_cast<unsigned int *>(ptr);
+        ptr += keys_bytes;
+        sorted_keys = reinterpret_cast<unsigned int *>(ptr);
+        ptr += keys_bytes;
+        counts = reinterpret_cast<unsigned int *>(ptr);
+        ptr += counts_bytes;
+        runs_count = reinterpret_cast<unsigned int *>(ptr);
+
+        const unsigned int keys_blocks_x = ::rocprim::detail::ceiling_div(columns, block_size);
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hc::parallel_for_each(
+            acc_view,
+            hc::tiled_extent<2>(rows, keys_blocks_x * block_size, 1, block_size),
+            [=](hc::tiled_index<2>) [[hc]]
+            {
+                fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op_fixed(
+                    sample_to_bin_op0, sample_to_bin_op1, sample_to_bin_op2, sample_to_bin_op3
+                );
+
+                histogram_sort_keys<block_size, Channels, ActiveChannels>(
+                    samples, columns, rows, row_stride,
+                    sample_to_bin_op_fixed,
+                    bins_fixed,
+                    keys
+                );
+            }
+        );
+        ROCPRIM_DETAIL_HC_SYNC("histogram_sort_keys", sort_size, start);
+
+        ::rocprim::radix_sort_keys(
+            nested_storage, sort_bytes,
+            keys, sorted_keys, sort_size,
+            0, sort_bits,
+            acc_view, debug_synchronous
+        );
+
+        // Unique keys overwrite unsorted ones
+        ::rocprim::run_length_encode(
+            nested_storage, encode_bytes,
+            sorted_keys, sort_size,
+            keys, counts, runs_count,
+            acc_view, debug_synchronous
+        );
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hc::parallel_for_each(
+            acc_view,
+            hc::tiled_extent<1>(::rocprim::detail::ceiling_div(max_runs, block_size) * block_size, block_size),
+            [=](hc::tiled_index<1>) [[hc]]
+            {
+                histogram_sort_counts<block_size, ActiveChannels>(
+                    keys, counts, runs_count,
+                    histogram_fixed, bins_fixed
+                );
+            }
+        );
+        ROCPRIM_DETAIL_HC_SYNC("histogram_sort_counts", max_runs, start);
     }
     else
     {
@@ -207,6 +391,7 @@ void histogram_impl(void * temporary_storage,
 }
 
 template<
+    class Config,
     unsigned int Channels,
     unsigned int ActiveChannels,
     class SampleIterator,
@@ -236,7 +421,7 @@ void histogram_even_impl(void * temporary_storage,
         );
     }
 
-    histogram_impl<Channels, ActiveChannels>(
+    histogram_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram,
@@ -246,6 +431,7 @@ void histogram_even_impl(void * temporary_storage,
 }
 
 template<
+    class Config,
     unsigned int Channels,
     unsigned int ActiveChannels,
     class SampleIterator,
@@ -274,7 +460,7 @@ void histogram_range_impl(void * temporary_storage,
         );
     }
 
-    histogram_impl<Channels, ActiveChannels>(
+    histogram_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram,
@@ -296,6 +482,8 @@ void histogram_range_impl(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -356,6 +544,7 @@ void histogram_range_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -377,7 +566,7 @@ void histogram_even(void * temporary_storage,
     Level lower_level_single[1] = { lower_level };
     Level upper_level_single[1] = { upper_level };
 
-    detail::histogram_even_impl<1, 1>(
+    detail::histogram_even_impl<Config, 1, 1>(
         temporary_storage, storage_size,
         samples, size, 1, 0,
         histogram_single,
@@ -399,6 +588,8 @@ void histogram_even(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -463,6 +654,7 @@ void histogram_even(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -486,7 +678,7 @@ void histogram_even(void * temporary_storage,
     Level lower_level_single[1] = { lower_level };
     Level upper_level_single[1] = { upper_level };
 
-    detail::histogram_even_impl<1, 1>(
+    detail::histogram_even_impl<Config, 1, 1>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram_single,
@@ -510,6 +702,8 @@ void histogram_even(void * temporary_storage,
 ///
 /// \tparam Channels - number of channels interleaved in the input samples.
 /// \tparam ActiveChannels - number of channels being used for computing histograms.
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -577,6 +771,7 @@ void histogram_even(void * temporary_storage,
 template<
     unsigned int Channels,
     unsigned int ActiveChannels,
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -593,7 +788,7 @@ void multi_histogram_even(void * temporary_storage,
                           hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                           bool debug_synchronous = false)
 {
-    detail::histogram_even_impl<Channels, ActiveChannels>(
+    detail::histogram_even_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, size, 1, 0,
         histogram,
@@ -621,6 +816,8 @@ void multi_histogram_even(void * temporary_storage,
 ///
 /// \tparam Channels - number of channels interleaved in the input samples.
 /// \tparam ActiveChannels - number of channels being used for computing histograms.
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -692,6 +889,7 @@ void multi_histogram_even(void * temporary_storage,
 template<
     unsigned int Channels,
     unsigned int ActiveChannels,
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -710,7 +908,7 @@ void multi_histogram_even(void * temporary_storage,
                           hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                           bool debug_synchronous = false)
 {
-    detail::histogram_even_impl<Channels, ActiveChannels>(
+    detail::histogram_even_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram,
@@ -727,6 +925,8 @@ void multi_histogram_even(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -785,6 +985,7 @@ void multi_histogram_even(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -804,7 +1005,7 @@ void histogram_range(void * temporary_storage,
     unsigned int levels_single[1] = { levels };
     Level * level_values_single[1] = { level_values };
 
-    detail::histogram_range_impl<1, 1>(
+    detail::histogram_range_impl<Config, 1, 1>(
         temporary_storage, storage_size,
         samples, size, 1, 0,
         histogram_single,
@@ -825,6 +1026,8 @@ void histogram_range(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -887,6 +1090,7 @@ void histogram_range(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -908,7 +1112,7 @@ void histogram_range(void * temporary_storage,
     unsigned int levels_single[1] = { levels };
     Level * level_values_single[1] = { level_values };
 
-    detail::histogram_range_impl<1, 1>(
+    detail::histogram_range_impl<Config, 1, 1>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram_single,
@@ -932,6 +1136,8 @@ void histogram_range(void * temporary_storage,
 ///
 /// \tparam Channels - number of channels interleaved in the input samples.
 /// \tparam ActiveChannels - number of channels being used for computing histograms.
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -996,6 +1202,7 @@ void histogram_range(void * temporary_storage,
 template<
     unsigned int Channels,
     unsigned int ActiveChannels,
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -1011,7 +1218,7 @@ void multi_histogram_range(void * temporary_storage,
                            hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                            bool debug_synchronous = false)
 {
-    detail::histogram_range_impl<Channels, ActiveChannels>(
+    detail::histogram_range_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, size, 1, 0,
         histogram,
@@ -1040,6 +1247,8 @@ void multi_histogram_range(void * temporary_storage,
 ///
 /// \tparam Channels - number of channels interleaved in the input samples.
 /// \tparam ActiveChannels - number of channels being used for computing histograms.
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -1109,6 +1318,7 @@ void multi_histogram_range(void * temporary_storage,
 template<
     unsigned int Channels,
     unsigned int ActiveChannels,
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -1126,7 +1336,7 @@ void multi_histogram_range(void * temporary_storage,
                            hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                            bool debug_synchronous = false)
 {
-    detail::histogram_range_impl<Channels, ActiveChannels>(
+    detail::histogram_range_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram,
@@ -21,14 +21,19 @@
 #ifndef ROCPRIM_DEVICE_DEVICE_HISTOGRAM_HIP_HPP_
 #define ROCPRIM_DEVICE_DEVICE_HISTOGRAM_HIP_HPP_
 
+#include <algorithm>
 #include <cmath>
 #include <type_traits>
 #include <iterator>
+#include <limits>
 
 #include "../config.hpp"
 #include "../functional.hpp"
 #include "../detail/various.hpp"
 
+#include "device_histogram_config.hpp"
+#include "device_radix_sort_hip.hpp"
+#include "device_run_length_encode_hip.hpp"
 #include "detail/device_histogram.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -57,7 +62,6 @@ template<
     unsigned int Channels,
     unsigned int ActiveChannels,
     class SampleIterator,
-    class Counter,
     class SampleToBinOp
 >
 __global__
@@ -65,20 +69,41 @@ void histogram_shared_kernel(SampleIterator samples,
                              unsigned int columns,
                              unsigned int rows,
                              unsigned int row_stride,
-                             fixed_array<Counter *, ActiveChannels> histogram,
+                             unsigned int * partial_histograms,
                              fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
-                             fixed_array<unsigned int, ActiveChannels> bins)
+                             fixed_array<unsigned int, ActiveChannels> bins,
+                             unsigned int tile_bins,
+                             unsigned int histograms)
 {
     HIP_DYNAMIC_SHARED(unsigned int, block_histogram);
 
     histogram_shared<BlockSize, ItemsPerThread, Channels, ActiveChannels>(
         samples, columns, rows, row_stride,
-        histogram,
+        partial_histograms,
         sample_to_bin_op, bins,
+        tile_bins, histograms,
         block_histogram
     );
 }
 
+template<
+    unsigned int BlockSize,
+    unsigned int ActiveChannels,
+    class Counter
+>
+__global__
+void histogram_shared_merge_kernel(const unsigned int * partial_histograms,
+                                   unsigned int blocks_per_tile,
+                                   unsigned int tile_bins,
+                                   fixed_array<Counter *, ActiveChannels> histogram,
+                                   fixed_array<unsigned int, ActiveChannels> bins)
+{
+    histogram_shared_merge<BlockSize, ActiveChannels>(
+        partial_histograms, blocks_per_tile, tile_bins,
+        histogram, bins
+    );
+}
+
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
@@ -103,6 +128,64 @@ void histogram_global_kernel(SampleIterator samples,
     );
 }
 
+template<
+    unsigned int BlockSize,
+    unsigned int Channels,
+    unsigned int ActiveChannels,
+    class SampleIterator,
+    class SampleToBinOp
+>
+__global__
+void histogram_sort_keys_kernel(SampleIterator samples,
+                                unsigned int columns,
+                                unsigned int rows,
+                                unsigned int row_stride,
+                                fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
+                                fixed_array<unsigned int, ActiveChannels> bins,
+                                unsigned int * keys)
+{
+    histogram_sort_keys<BlockSize, Channels, ActiveChannels>(
+        samples, columns, rows, row_stride,
+        sample_to_bin_op, bins,
+        keys
+    );
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ActiveChannels,
+    class Counter
+>
+__global__
+void histogram_sort_counts_kernel(const unsigned int * unique_keys,
+                                  const unsigned int * counts,
+                                  const unsigned int * runs_count,
+                                  fixed_array<Counter *, ActiveChannels> histogram,
+                                  fixed_array<unsigned int, ActiveChannels> bins)
+{
+    histogram_sort_counts<BlockSize, ActiveChannels>(
+        unique_keys, counts, runs_count,
+        histogram, bins
+    );
+}
+
+inline
+hipError_t get_device_properties(size_t& shared_memory_bytes,
+                                 unsigned int& compute_units)
+{
+    int device_id;
+    hipError_t error = hipGetDevice(&device_id);
+    if(error != hipSuccess) return error;
+    int value;
+    error = hipDeviceGetAttribute(&value, hipDeviceAttributeMaxSharedMemoryPerBlock, device_id);
+    if(error != hipSuccess) return error;
+    shared_memory_bytes = value;
+    error = hipDeviceGetAttribute(&value, hipDeviceAttributeMultiprocessorCount, device_id);
+    if(error != hipSuccess) return error;
+    compute_units = value;
+    return hipSuccess;
+}
+
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
     { \
         auto error = hipPeekAtLastError(); \
@@ -119,6 +202,7 @@ void histogram_global_kernel(SampleIterator samples,
     }
 
 template<
+    class Config,
     unsigned int Channels,
     unsigned int ActiveChannels,
     class SampleIterator,
@@ -140,10 +224,19 @@ hipError_t histogram_impl(void * temporary_storage,
 {
     using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
 
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 8;
-    constexpr unsigned int max_grid_size = 1024;
-    constexpr unsigned int shared_impl_max_bins = 1024;
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_histogram_config<sample_type>
+    >;
+
+    constexpr unsigned int block_size = config::histogram::block_size;
+    constexpr unsigned int items_per_thread = config::histogram::items_per_thread;
+    constexpr unsigned int max_grid_size = config::max_grid_size;
+    constexpr unsigned int shared_impl_max_bins = config::shared_impl_max_bins;
+    constexpr unsigned int shared_impl_histograms = config::shared_impl_histograms;
+    constexpr unsigned int tiled_impl_max_tiles = config::tiled_impl_max_tiles;
+    constexpr unsigned int sort_impl_min_bins = config::sort_impl_min_bins;
 
     constexpr unsigned int items_per_block = block_size * items_per_thread;
 
@@ -165,11 +258,109 @@ hipError_t histogram_impl(void * temporary_storage,
     const unsigned int blocks_x = ::rocprim::detail::ceiling_div(columns, items_per_block);
     const unsigned int row_stride = row_stride_bytes / sizeof(sample_type);
 
+    unsigned int bins[ActiveChannels];
+    unsigned int bins_bits[ActiveChannels];
+    unsigned int total_bins = 0;
+    unsigned int max_bins = 0;
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        bins[channel] = levels[channel] - 1;
+        bins_bits[channel] = static_cast<unsigned int>(std::log2(detail::next_power_of_two(bins[channel])));
+        total_bins += bins[channel];
+        max_bins = std::max(max_bins, bins[channel]);
+    }
+
+    size_t shared_memory_bytes;
+    unsigned int compute_units;
+    hipError_t error = get_device_properties(shared_memory_bytes, compute_units);
+    if(error != hipSuccess) return error;
+    // One block uses at most a half of shared memory, so at least two blocks can run
+    // on the same compute unit
+    const unsigned int shared_bins = shared_memory_bytes / 2 / sizeof(unsigned int);
+    const unsigned int tiles = total_bins <= shared_impl_max_bins
+        ? 1 : ::rocprim::detail::ceiling_div(total_bins, shared_bins);
+
+    const bool with_shared_impl = tiles <= tiled_impl_max_tiles;
+
+    const unsigned int tile_bins = ::rocprim::detail::ceiling_div(total_bins, tiles);
+    const unsigned int histograms = std::max(1u, std::min({
+        shared_impl_histograms, block_size / ::rocprim::warp_size(), shared_bins / tile_bins
+    }));
+    const size_t block_histogram_bytes = histograms * tile_bins * sizeof(unsigned int);
+    // Enough blocks to fill all compute units, occupancy is limited by shared memory
+    // and by the number of wavefronts (at most 40) that a compute unit can run
+    constexpr unsigned int max_cu_threads = 40 * ::rocprim::warp_size();
+    const unsigned int blocks_per_cu = std::max(1u, std::min<unsigned int>(
+        shared_memory_bytes / block_histogram_bytes, max_cu_threads / block_size
+    ));
+    unsigned int blocks_per_tile = std::max(1u, compute_units * blocks_per_cu / tiles);
+    if(max_grid_size > 0)
+    {
+        blocks_per_tile = std::min(blocks_per_tile, std::max(1u, max_grid_size / tiles));
+    }
+    dim3 grid_size;
+    grid_size.x = std::max(1u, std::min(blocks_per_tile, blocks_x));
+    grid_size.y = std::max(1u, std::min(rows, blocks_per_tile / grid_size.x));
+    grid_size.z = tiles;
+    blocks_per_tile = grid_size.x * grid_size.y;
+    // Each block writes its counts of bins of its tile, they are merged later
+    const size_t partial_histograms_bytes =
+        ::rocprim::detail::align_size(size_t(tiles) * blocks_per_tile * tile_bins * sizeof(unsigned int));
+
+    // Samples of all active channels are sorted at once
+    const size_t sort_size = static_cast<size_t>(columns) * rows * ActiveChannels;
+    const bool with_sort_impl = !with_shared_impl
+        && total_bins >= sort_impl_min_bins
+        && sort_size > 0
+        && sort_size <= std::numeric_limits<unsigned int>::max();
+
+    // The key total_bins is used for samples outside of bins
+    const unsigned int sort_bits = static_cast<unsigned int>(std::log2(detail::next_power_of_two(total_bins + 1)));
+    const unsigned int max_runs = static_cast<unsigned int>(std::min<size_t>(sort_size, total_bins + 1));
+    unsigned int * keys = nullptr;
+    unsigned int * sorted_keys = nullptr;
+    unsigned int * counts = nullptr;
+    unsigned int * runs_count = nullptr;
+    size_t sort_bytes = 0;
+    size_t encode_bytes = 0;
+    const size_t keys_bytes = ::rocprim::detail::align_size(sort_size * sizeof(unsigned int));
+    const size_t counts_bytes = ::rocprim::detail::align_size(max_runs * sizeof(unsigned int));
+    const size_t runs_count_bytes = ::rocprim::detail::align_size(sizeof(unsigned int));
+    if(with_sort_impl)
+    {
+        error = ::rocprim::radix_sort_keys(
+            nullptr, sort_bytes,
+            keys, sorted_keys, sort_size,
+            0, sort_bits,
+            stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+        error = ::rocprim::run_length_encode(
+            nullptr, encode_bytes,
+            sorted_keys, sort_size,
+            keys, counts, runs_count,
+            stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+    }
+    const size_t nested_bytes = ::rocprim::detail::align_size(std::max(sort_bytes, encode_bytes));
+
     if(temporary_storage == nullptr)
     {
-        // Make sure user won't try to allocate 0 bytes memory, because
-        // hipMalloc will return nullptr.
-        storage_size = 4;
+        if(with_shared_impl)
+        {
+            storage_size = partial_histograms_bytes;
+        }
+        else if(with_sort_impl)
+        {
+            storage_size = nested_bytes + 2 * keys_bytes + counts_bytes + runs_count_bytes;
+        }
+        else
+        {
+            // Make sure user won't try to allocate 0 bytes memory, because
+            // hipMalloc will return nullptr.
+            storage_size = 4;
+        }
         return hipSuccess;
     }
 
@@ -178,49 +369,106 @@ hipError_t histogram_impl(void * temporary_storage,
         std::cout << "columns " << columns << '\n';
         std::cout << "rows " << rows << '\n';
         std::cout << "blocks_x " << blocks_x << '\n';
-        hipError_t error = hipStreamSynchronize(stream);
+        error = hipStreamSynchronize(stream);
         if(error != hipSuccess) return error;
     }
 
-    unsigned int bins[ActiveChannels];
-    unsigned int bins_bits[ActiveChannels];
-    unsigned int total_bins = 0;
-    unsigned int max_bins = 0;
-    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
-    {
-        bins[channel] = levels[channel] - 1;
-        bins_bits[channel] = static_cast<unsigned int>(std::log2(detail::next_power_of_two(bins[channel])));
-        total_bins += bins[channel];
-        max_bins = std::max(max_bins, bins[channel]);
-    }
-
     std::chrono::high_resolution_clock::time_point start;
 
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(init_histogram_kernel<block_size, ActiveChannels>),
-        dim3(::rocprim::detail::ceiling_div(max_bins, block_size)), dim3(block_size), 0, stream,
-        fixed_array<Counter *, ActiveChannels>(histogram),
-        fixed_array<unsigned int, ActiveChannels>(bins)
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_histogram", max_bins, start);
-
-    if(total_bins <= shared_impl_max_bins)
+    if(!with_shared_impl)
     {
-        dim3 grid_size;
-        grid_size.x = std::min(max_grid_size, blocks_x);
-        grid_size.y = std::min(rows, max_grid_size / grid_size.x);
-        const size_t block_histogram_bytes = total_bins * sizeof(unsigned int);
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(init_histogram_kernel<block_size, ActiveChannels>),
+            dim3(::rocprim::detail::ceiling_div(max_bins, block_size)), dim3(block_size), 0, stream,
+            fixed_array<Counter *, ActiveChannels>(histogram),
+            fixed_array<unsigned int, ActiveChannels>(bins)
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_histogram", max_bins, start);
+    }
+
+    if(with_shared_impl)
+    {
+        unsigned int * partial_histograms = reinterpret_cast<unsigned int *>(temporary_storage);
+
+        if(debug_synchronous)
+        {
+            std::cout << "tiles " << tiles << '\n';
+            std::cout << "histograms " << histograms << '\n';
+            start = std::chrono::high_resolution_clock::now();
+        }
         hipLaunchKernelGGL(
             HIP_KERNEL_NAME(histogram_shared_kernel<block_size, items_per_thread, Channels, ActiveChannels>),
             grid_size, dim3(block_size, 1), block_histogram_bytes, stream,
             samples, columns, rows, row_stride,
+            partial_histograms,
+            fixed_array<SampleToBinOp, ActiveChannels>(sample_to_bin_op),
+            fixed_array<unsigned int, ActiveChannels>(bins),
+            tile_bins, histograms
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_shared", grid_size.x * grid_size.y * grid_size.z * block_size, start);
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(histogram_shared_merge_kernel<block_size, ActiveChannels>),
+            dim3(::rocprim::detail::ceiling_div(total_bins, block_size)), dim3(block_size), 0, stream,
+            partial_histograms, blocks_per_tile, tile_bins,
             fixed_array<Counter *, ActiveChannels>(histogram),
+            fixed_array<unsigned int, ActiveChannels>(bins)
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_shared_merge", total_bins, start);
+    }
+    else if(with_sort_impl)
+    {
+        char * ptr = reinterpret_cast<char *>(temporary_storage);
+        void * nested_storage = ptr;
+        ptr += nested_bytes;
+        keys = reinterpret_cast<unsigned int *>(ptr);
+        ptr += keys_bytes;
+        sorted_keys = reinterpret_cast<unsigned int *>(ptr);
+        ptr += keys_bytes;
+        counts = reinterpret_cast<unsigned int *>(ptr);
+        ptr += counts_bytes;
+        runs_count = reinterpret_cast<unsigned int *>(ptr);
+
+        const unsigned int keys_blocks_x = ::rocprim::detail::ceiling_div(columns, block_size);
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(histogram_sort_keys_kernel<block_size, Channels, ActiveChannels>),
+            dim3(keys_blocks_x, rows), dim3(block_size, 1), 0, stream,
+            samples, columns, rows, row_stride,
             fixed_array<SampleToBinOp, ActiveChannels>(sample_to_bin_op),
+            fixed_array<unsigned int, ActiveChannels>(bins),
+            keys
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_sort_keys", sort_size, start);
+
+        error = ::rocprim::radix_sort_keys(
+            nested_storage, sort_bytes,
+            keys, sorted_keys, sort_size,
+            0, sort_bits,
+            stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+
+        // Unique keys overwrite unsorted ones
+        error = ::rocprim::run_length_encode(
+            nested_storage, encode_bytes,
+            sorted_keys, sort_size,
+            keys, counts, runs_count,
+            stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(histogram_sort_counts_kernel<block_size, ActiveChannels>),
+            dim3(::rocprim::detail::ceiling_div(max_runs, block_size)), dim3(block_size), 0, stream,
+            keys, counts, runs_count,
+            fixed_array<Counter *, ActiveChannels>(histogram),
             fixed_array<unsigned int, ActiveChannels>(bins)
         );
-        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_shared", grid_size.x * grid_size.y * block_size, start);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_sort_counts", max_runs, start);
     }
     else
     {
@@ -240,6 +488,7 @@ hipError_t histogram_impl(void * temporary_storage,
 }
 
 template<
+    class Config,
     unsigned int Channels,
     unsigned int ActiveChannels,
     class SampleIterator,
@@ -269,7 +518,7 @@ hipError_t histogram_even_impl(void * temporary_storage,
         );
     }
 
-    return histogram_impl<Channels, ActiveChannels>(
+    return histogram_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram,
@@ -279,6 +528,7 @@ hipError_t histogram_even_impl(void * temporary_storage,
 }
 
 template<
+    class Config,
     unsigned int Channels,
     unsigned int ActiveChannels,
     class SampleIterator,
@@ -307,7 +557,7 @@ hipError_t histogram_range_impl(void * temporary_storage,
         );
     }
 
-    return histogram_impl<Channels, ActiveChannels>(
+    return histogram_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram,
@@ -329,6 +579,8 @@ hipError_t histogram_range_impl(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -388,6 +640,7 @@ hipError_t histogram_range_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -409,7 +662,7 @@ hipError_t histogram_even(void * temporary_storage,
     Level lower_level_single[1] = { lower_level };
     Level upper_level_single[1] = { upper_level };
 
-    return detail::histogram_even_impl<1, 1>(
+    return detail::histogram_even_impl<Config, 1, 1>(
         temporary_storage, storage_size,
         samples, size, 1, 0,
         histogram_single,
@@ -431,6 +684,8 @@ hipError_t histogram_even(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -494,6 +749,7 @@ hipError_t histogram_even(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -517,7 +773,7 @@ hipError_t histogram_even(void * temporary_storage,
     Level lower_level_single[1] = { lower_level };
     Level upper_level_single[1] = { upper_level };
 
-    return detail::histogram_even_impl<1, 1>(
+    return detail::histogram_even_impl<Config, 1, 1>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram_single,
@@ -541,6 +797,8 @@ hipError_t histogram_even(void * temporary_storage,
 ///
 /// \tparam Channels - number of channels interleaved in the input samples.
 /// \tparam ActiveChannels - number of channels being used for computing histograms.
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -605,6 +863,7 @@ hipError_t histogram_even(void * temporary_storage,
 template<
     unsigned int Channels,
     unsigned int ActiveChannels,
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -621,7 +880,7 @@ hipError_t multi_histogram_even(void * temporary_storage,
                                 hipStream_t stream = 0,
                                 bool debug_synchronous = false)
 {
-    return detail::histogram_even_impl<Channels, ActiveChannels>(
+    return detail::histogram_even_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, size, 1, 0,
         histogram,
@@ -649,6 +908,8 @@ hipError_t multi_histogram_even(void * temporary_storage,
 ///
 /// \tparam Channels - number of channels interleaved in the input samples.
 /// \tparam ActiveChannels - number of channels being used for computing histograms.
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -717,6 +978,7 @@ hipError_t multi_histogram_even(void * temporary_storage,
 template<
     unsigned int Channels,
     unsigned int ActiveChannels,
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -735,7 +997,7 @@ hipError_t multi_histogram_even(void * temporary_storage,
                                 hipStream_t stream = 0,
                                 bool debug_synchronous = false)
 {
-    return detail::histogram_even_impl<Channels, ActiveChannels>(
+    return detail::histogram_even_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram,
@@ -752,6 +1014,8 @@ hipError_t multi_histogram_even(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -809,6 +1073,7 @@ hipError_t multi_histogram_even(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -828,7 +1093,7 @@ hipError_t histogram_range(void * temporary_storage,
     unsigned int levels_single[1] = { levels };
     Level * level_values_single[1] = { level_values };
 
-    return detail::histogram_range_impl<1, 1>(
+    return detail::histogram_range_impl<Config, 1, 1>(
         temporary_storage, storage_size,
         samples, size, 1, 0,
         histogram_single,
@@ -849,6 +1114,8 @@ hipError_t histogram_range(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -910,6 +1177,7 @@ hipError_t histogram_range(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -931,7 +1199,7 @@ hipError_t histogram_range(void * temporary_storage,
     unsigned int levels_single[1] = { levels };
     Level * level_values_single[1] = { level_values };
 
-    return detail::histogram_range_impl<1, 1>(
+    return detail::histogram_range_impl<Config, 1, 1>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram_single,
@@ -955,6 +1223,8 @@ hipError_t histogram_range(void * temporary_storage,
 ///
 /// \tparam Channels - number of channels interleaved in the input samples.
 /// \tparam ActiveChannels - number of channels being used for computing histograms.
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -1015,6 +1285,7 @@ hipError_t histogram_range(void * temporary_storage,
 template<
     unsigned int Channels,
     unsigned int ActiveChannels,
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -1030,7 +1301,7 @@ hipError_t multi_histogram_range(void * temporary_storage,
                                  hipStream_t stream = 0,
                                  bool debug_synchronous = false)
 {
-    return detail::histogram_range_impl<Channels, ActiveChannels>(
+    return detail::histogram_range_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, size, 1, 0,
         histogram,
@@ -1059,6 +1330,8 @@ hipError_t multi_histogram_range(void * temporary_storage,
 ///
 /// \tparam Channels - number of channels interleaved in the input samples.
 /// \tparam ActiveChannels - number of channels being used for computing histograms.
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p histogram_config or a custom class with the same members.
 /// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam Counter - integer type for histogram bin counters.
@@ -1123,6 +1396,7 @@ hipError_t multi_histogram_range(void * temporary_storage,
 template<
     unsigned int Channels,
     unsigned int ActiveChannels,
+    class Config = default_config,
     class SampleIterator,
     class Counter,
     class Level
@@ -1140,7 +1414,7 @@ hipError_t multi_histogram_range(void * temporary_storage,
                                  hipStream_t stream = 0,
                                  bool debug_synchronous = false)
 {
-    return detail::histogram_range_impl<Channels, ActiveChannels>(
+    return detail::histogram_range_impl<Config, Channels, ActiveChannels>(
         temporary_storage, storage_size,
         samples, columns, rows, row_stride_bytes,
         histogram,
@@ -0,0 +1,468 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_MERGE_HIP_HPP_
+#define ROCPRIM_DEVICE_DEVICE_MERGE_HIP_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "../intrinsics.hpp"
+#include "../functional.hpp"
+#include "../types.hpp"
+
+#include "device_merge_config.hpp"
+#include "detail/device_merge.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_hip
+/// @{
+
+namespace detail
+{
+
+template<
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class BinaryFunction
+>
+__global__
+void merge_partition_kernel(size_t * splits,
+                            KeysInputIterator1 keys_input1,
+                            KeysInputIterator2 keys_input2,
+                            const size_t size1,
+                            const size_t size2,
+                            const unsigned int items_per_block,
+                            const unsigned int number_of_splits,
+                            BinaryFunction compare_function)
+{
+    merge_partition_kernel_impl(
+        splits, keys_input1, keys_input2, size1, size2,
+        items_per_block, number_of_splits, compare_function
+    );
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+__global__
+void merge_kernel(const size_t * splits,
+                  KeysInputIterator1 keys_input1,
+                  KeysInputIterator2 keys_input2,
+                  KeysOutputIterator keys_output,
+                  ValuesInputIterator1 values_input1,
+                  ValuesInputIterator2 values_input2,
+                  ValuesOutputIterator values_output,
+                  const size_t size1,
+                  const size_t size2,
+                  BinaryFunction compare_function)
+{
+    merge_kernel_impl<BlockSize, ItemsPerThread>(
+        splits,
+        keys_input1, keys_input2, keys_output,
+        values_input1, values_input2, values_output,
+        size1, size2, compare_function
+    );
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
+    { \
+        auto error = hipPeekAtLastError(); \
+        if(error != hipSuccess) return error; \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto error = hipStreamSynchronize(stream); \
+            if(error != hipSuccess) return error; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<
+    class Config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+inline
+hipError_t merge_impl(void * temporary_storage,
+                      size_t& storage_size,
+                      KeysInputIterator1 keys_input1,
+                      KeysInputIterator2 keys_input2,
+                      KeysOutputIterator keys_output,
+                      ValuesInputIterator1 values_input1,
+                      ValuesInputIterator2 values_input2,
+                      ValuesOutputIterator values_output,
+                      const size_t size1,
+                      const size_t size2,
+                      BinaryFunction compare_function,
+                      const hipStream_t stream,
+                      const bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator1>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator1>::value_type;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_merge_config<key_type, value_type>
+    >;
+
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
+    constexpr unsigned int items_per_block = block_size * items_per_thread;
+
+    const size_t size = size1 + size2;
+    const unsigned int number_of_blocks = static_cast<unsigned int>(
+        ::rocprim::detail::ceiling_div<size_t>(size, items_per_block)
+    );
+    const unsigned int number_of_splits = number_of_blocks + 1;
+
+    if(temporary_storage == nullptr)
+    {
+        storage_size = ::rocprim::detail::align_size(number_of_splits * sizeof(size_t));
+        return hipSuccess;
+    }
+
+    if(size == 0)
+    {
+        return hipSuccess;
+    }
+
+    size_t * splits = reinterpret_cast<size_t *>(temporary_storage);
+
+    if(debug_synchronous)
+    {
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "number of blocks " << number_of_blocks << '\n';
+        hipError_t error = hipStreamSynchronize(stream);
+        if(error != hipSuccess) return error;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    constexpr unsigned int partition_block_size = 256;
+    const unsigned int partition_grid_size =
+        ::rocprim::detail::ceiling_div(number_of_splits, partition_block_size);
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(merge_partition_kernel<
+            KeysInputIterator1, KeysInputIterator2, BinaryFunction
+        >),
+        dim3(partition_grid_size), dim3(partition_block_size), 0, stream,
+        splits, keys_input1, keys_input2, size1, size2,
+        items_per_block, number_of_splits, compare_function
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("merge_partition_kernel", number_of_splits, start)
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(merge_kernel<block_size, items_per_thread>),
+        dim3(number_of_blocks), dim3(block_size), 0, stream,
+        splits,
+        keys_input1, keys_input2, keys_output,
+        values_input1, values_input2, values_output,
+        size1, size2, compare_function
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("merge_kernel", size, start)
+
+    return hipSuccess;
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end of detail namespace
+
+/// \brief HIP parallel merge primitive for device level.
+///
+/// \p merge function performs a device-wide merge of two sorted ranges of keys.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the merging function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Both input ranges must be sorted according to \p compare_function.
+/// * The merge is stable: when keys from both ranges are equivalent, keys from
+/// \p keys_input1 go first, the order of equivalent keys within each range is kept.
+/// * Ranges specified by \p keys_input1 and \p keys_input2 must have at least \p size1
+/// and \p size2 elements respectively, range specified by \p keys_output must have at
+/// least <tt>size1 + size2</tt> elements.
+/// * Input is partitioned by merge path search, so every block merges the same number
+/// of keys regardless of their distribution. Temporary storage grows only with the
+/// number of blocks.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first input range. Must meet
+/// the requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second input range. Must meet
+/// the requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for comparison. Default type
+/// is \p rocprim::less<Key>, where \p Key is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the merge operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first element in the first range to merge.
+/// \param [in] keys_input2 - iterator to the first element in the second range to merge.
+/// \param [out] keys_output - iterator to the first element in the output range.
+/// \param [in] size1 - number of element in the first input range.
+/// \param [in] size2 - number of element in the second input range.
+/// \param [in] compare_function - [optional] binary operation function object that returns
+/// \p true if the first argument is ordered before the second one (strict weak ordering).
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// Default is \p rocprim::less<Key>.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful merge; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level ascending merge is performed on two arrays of
+/// \p int values.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size1;     // e.g., 4
+/// size_t input_size2;     // e.g., 4
+/// int * input1;           // e.g., [0, 1, 2, 3]
+/// int * input2;           // e.g., [0, 1, 2, 3]
+/// int * output;           // empty array of 8 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::merge(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, input_size1, input_size2
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform merge
+/// rocprim::merge(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, input_size1, input_size2
+/// );
+/// // output: [0, 0, 1, 1, 2, 2, 3, 3]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t merge(void * temporary_storage,
+                 size_t& storage_size,
+                 KeysInputIterator1 keys_input1,
+                 KeysInputIterator2 keys_input2,
+                 KeysOutputIterator keys_output,
+                 const size_t size1,
+                 const size_t size2,
+                 BinaryFunction compare_function = BinaryFunction(),
+                 const hipStream_t stream = 0,
+                 const bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::merge_impl<Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values, values, values,
+        size1, size2, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel merge primitive for device level.
+///
+/// \p merge function performs a device-wide merge of two sorted ranges of
+/// (key, value) pairs, using binary comparison function \p compare_function applied to keys.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the merging function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Both input ranges of keys must be sorted according to \p compare_function.
+/// * The merge is stable: when keys from both ranges are equivalent, pairs from
+/// the first range go first, the order of equivalent keys within each range is kept.
+/// * Ranges specified by \p keys_input1 and \p values_input1 must have at least \p size1
+/// elements, ranges specified by \p keys_input2 and \p values_input2 must have at least
+/// \p size2 elements, ranges specified by \p keys_output and \p values_output must have
+/// at least <tt>size1 + size2</tt> elements.
+/// * Input is partitioned by merge path search, so every block merges the same number
+/// of pairs regardless of distribution of keys. Temporary storage grows only with the
+/// number of blocks.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first input range. Must meet
+/// the requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second input range. Must meet
+/// the requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator1 - random-access iterator type of the first input range. Must meet
+/// the requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator2 - random-access iterator type of the second input range. Must meet
+/// the requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for comparison. Default type
+/// is \p rocprim::less<Key>, where \p Key is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the merge operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first key in the first range to merge.
+/// \param [in] keys_input2 - iterator to the first key in the second range to merge.
+/// \param [out] keys_output - iterator to the first key in the output range.
+/// \param [in] values_input1 - iterator to the first value in the first range to merge.
+/// \param [in] values_input2 - iterator to the first value in the second range to merge.
+/// \param [out] values_output - iterator to the first value in the output range.
+/// \param [in] size1 - number of element in the first input range.
+/// \param [in] size2 - number of element in the second input range.
+/// \param [in] compare_function - [optional] binary operation function object that returns
+/// \p true if the first key is ordered before the second one (strict weak ordering).
+/// Default is \p rocprim::less<Key>.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful merge; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level descending merge is performed where input keys are
+/// represented by arrays of integers and input values by arrays of <tt>double</tt>s.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size1;         // e.g., 3
+/// size_t input_size2;         // e.g., 4
+/// int * keys_input1;          // e.g., [9, 5, 1]
+/// double * values_input1;     // e.g., [1, 2, 3]
+/// int * keys_input2;          // e.g., [8, 5, 4, 0]
+/// double * values_input2;     // e.g., [4, 5, 6, 7]
+/// int * keys_output;          // empty array of 7 elements
+/// double * values_output;     // empty array of 7 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::merge(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys_input1, keys_input2, keys_output,
+///     values_input1, values_input2, values_output,
+///     input_size1, input_size2, rocprim::greater<int>()
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform merge
+/// rocprim::merge(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys_input1, keys_input2, keys_output,
+///     values_input1, values_input2, values_output,
+///     input_size1, input_size2, rocprim::greater<int>()
+/// );
+/// // keys_output:   [9, 8, 5, 5, 4, 1, 0]
+/// // values_output: [1, 4, 2, 5, 6, 3, 7]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t merge(void * temporary_storage,
+                 size_t& storage_size,
+                 KeysInputIterator1 keys_input1,
+                 KeysInputIterator2 keys_input2,
+                 KeysOutputIterator keys_output,
+                 ValuesInputIterator1 values_input1,
+                 ValuesInputIterator2 values_input2,
+                 ValuesOutputIterator values_output,
+                 const size_t size1,
+                 const size_t size2,
+                 BinaryFunction compare_function = BinaryFunction(),
+                 const hipStream_t stream = 0,
+                 const bool debug_synchronous = false)
+{
+    return detail::merge_impl<Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values_input1, values_input2, values_output,
+        size1, size2, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule_hip
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_MERGE_HIP_HPP_
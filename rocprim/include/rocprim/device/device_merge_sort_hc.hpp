@@ -0,0 +1,448 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_MERGE_SORT_HC_HPP_
+#define ROCPRIM_DEVICE_DEVICE_MERGE_SORT_HC_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "../intrinsics.hpp"
+#include "../functional.hpp"
+#include "../types.hpp"
+
+#include "device_merge_sort_config.hpp"
+#include "detail/device_merge_sort.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_hc
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_HC_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            acc_view.wait(); \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+// Tiles are sorted by blocks, then pairs of sorted runs are merged in log2(number
+// of tiles) passes. Passes alternate between the output and the temporary buffers,
+// the block sort writes to the buffer chosen such that the last pass writes to the output.
+template<
+    class Config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+inline
+void merge_sort_impl(void * temporary_storage,
+                     size_t& storage_size,
+                     KeysInputIterator keys_input,
+                     KeysOutputIterator keys_output,
+                     ValuesInputIterator values_input,
+                     ValuesOutputIterator values_output,
+                     const size_t size,
+                     BinaryFunction compare_function,
+                     hc::accelerator_view acc_view,
+                     const bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_merge_sort_config<key_type, value_type>
+    >;
+
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
+    constexpr unsigned int items_per_block = block_size * items_per_thread;
+
+    const size_t keys_bytes = ::rocprim::detail::align_size(size * sizeof(key_type));
+    const size_t values_bytes = with_values ? ::rocprim::detail::align_size(size * sizeof(value_type)) : 0;
+    if(temporary_storage == nullptr)
+    {
+        storage_size = keys_bytes + values_bytes;
+        // Make sure user won't try to allocate 0 bytes memory
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return;
+    }
+
+    if(size == 0)
+    {
+        return;
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    key_type * keys_tmp = reinterpret_cast<key_type *>(ptr);
+    ptr += keys_bytes;
+    value_type * values_tmp = reinterpret_cast<value_type *>(ptr);
+
+    const unsigned int number_of_blocks = static_cast<unsigned int>(
+        ::rocprim::detail::ceiling_div<size_t>(size, items_per_block)
+    );
+    unsigned int passes = 0;
+    for(size_t width = items_per_block; width < size; width *= 2)
+    {
+        passes++;
+    }
+
+    if(debug_synchronous)
+    {
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "number of blocks " << number_of_blocks << '\n';
+        std::cout << "passes " << passes << '\n';
+        acc_view.wait();
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    bool to_output = passes % 2 == 0;
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    if(to_output)
+    {
+        hc::parallel_for_each(
+            acc_view,
+            hc::tiled_extent<1>(number_of_blocks * block_size, block_size),
+            [=](hc::tiled_index<1>) [[hc]]
+            {
+                merge_sort_block_sort_kernel_impl<block_size, items_per_thread>(
+                    keys_input, keys_output, values_input, values_output,
+                    size, compare_function
+                );
+            }
+        );
+    }
+    else
+    {
+        hc::parallel_for_each(
+            acc_view,
+            hc::tiled_extent<1>(number_of_blocks * block_size, block_size),
+            [=](hc::tiled_index<1>) [[hc]]
+            {
+                merge_sort_block_sort_kernel_impl<block_size, items_per_thread>(
+                    keys_input, keys_tmp, values_input, values_tmp,
+                    size, compare_function
+                );
+            }
+        );
+    }
+    ROCPRIM_DETAIL_HC_SYNC("merge_sort_block_sort_kernel", size, start)
+
+    for(unsigned int pass = 0; pass < passes; pass++)
+    {
+        const size_t width = static_cast<size_t>(items_per_block) << pass;
+        to_output = !to_output;
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        if(to_output)
+        {
+            hc::parallel_for_each(
+                acc_view,
+                hc::tiled_extent<1>(number_of_blocks * block_size, block_size),
+                [=](hc::tiled_index<1>) [[hc]]
+                {
+                    merge_sort_merge_kernel_impl<block_size, items_per_thread>(
+                        keys_tmp, keys_output, values_tmp, values_output,
+                        size, width, compare_function
+                    );
+                }
+            );
+        }
+        else
+        {
+            hc::parallel_for_each(
+                acc_view,
+                hc::tiled_extent<1>(number_of_blocks * block_size, block_size),
+                [=](hc::tiled_index<1>) [[hc]]
+                {
+                    merge_sort_merge_kernel_impl<block_size, items_per_thread>(
+                        keys_output, keys_tmp, values_output, values_tmp,
+                        size, width, compare_function
+                    );
+                }
+            );
+        }
+        ROCPRIM_DETAIL_HC_SYNC("merge_sort_merge_kernel", size, start)
+    }
+}
+
+#undef ROCPRIM_DETAIL_HC_SYNC
+
+} // end of detail namespace
+
+/// \brief HC parallel merge sort primitive for device level.
+///
+/// \p merge_sort function performs a device-wide stable sort of keys using
+/// binary comparison function \p compare_function.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Unlike \p radix_sort_keys, \p Key type (a \p value_type of \p KeysInputIterator
+/// and \p KeysOutputIterator) can be any type (for example, a tuple or a custom struct)
+/// which can be ordered by \p compare_function.
+/// * The sort is stable: keys that are equivalent according to \p compare_function
+/// keep their relative order.
+/// * Ranges specified by \p keys_input and \p keys_output must have at least \p size elements.
+/// * \p keys_output is also used as an intermediate buffer, so it must allow reading.
+/// * Temporary storage grows linearly with \p size.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for comparison. Default type
+/// is \p rocprim::less<Key>, where \p Key is a \p value_type of \p KeysInputIterator.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] compare_function - [optional] binary operation function object that returns
+/// \p true if the first argument is ordered before the second one (strict weak ordering).
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// Default is \p rocprim::less<Key>.
+/// \param [in] acc_view - [optional] \p hc::accelerator_view object. The default value
+/// is \p hc::accelerator().get_default_view() (default view of the default accelerator).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level merge sort is performed on an array of
+/// <tt>rocprim::tuple<int, float></tt> values, sorting by the second element.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// using key_type = rocprim::tuple<int, float>;
+///
+/// struct compare_second
+/// {
+///     [[hc]]
+///     bool operator()(const key_type& a, const key_type& b) const
+///     {
+///         return rocprim::get<1>(a) < rocprim::get<1>(b);
+///     }
+/// };
+///
+/// hc::accelerator_view acc_view = ...;
+///
+/// // Prepare input and output (declare arrays, allocate device memory etc.)
+/// size_t input_size;                                       // e.g., 4
+/// hc::array<key_type> input(hc::extent<1>(input_size), ...);
+/// // e.g., [{0, 0.6}, {1, 0.3}, {2, 0.6}, {3, 0.1}]
+/// hc::array<key_type> output(hc::extent<1>(input_size), ...); // empty array of 4 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// // Get required size of the temporary storage
+/// rocprim::merge_sort(
+///     nullptr, temporary_storage_size_bytes,
+///     input.accelerator_pointer(), output.accelerator_pointer(),
+///     input_size, compare_second(), acc_view
+/// );
+///
+/// // allocate temporary storage
+/// hc::array<char> temporary_storage(temporary_storage_size_bytes, acc_view);
+///
+/// // perform sort
+/// rocprim::merge_sort(
+///     temporary_storage.accelerator_pointer(), temporary_storage_size_bytes,
+///     input.accelerator_pointer(), output.accelerator_pointer(),
+///     input_size, compare_second(), acc_view
+/// );
+/// // output: [{3, 0.1}, {1, 0.3}, {0, 0.6}, {2, 0.6}]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator>::value_type>
+>
+inline
+void merge_sort(void * temporary_storage,
+                  size_t& storage_size,
+                  KeysInputIterator keys_input,
+                  KeysOutputIterator keys_output,
+                  const size_t size,
+                  BinaryFunction compare_function = BinaryFunction(),
+                  hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
+                  const bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    detail::merge_sort_impl<Config>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values, values,
+        size, compare_function,
+        acc_view, debug_synchronous
+    );
+}
+
+/// \brief HC parallel merge sort primitive for device level.
+///
+/// \p merge_sort function performs a device-wide stable sort of (key, value) pairs
+/// using binary comparison function \p compare_function applied to keys.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * \p Key type (a \p value_type of \p KeysInputIterator and \p KeysOutputIterator) can be
+/// any type which can be ordered by \p compare_function.
+/// * The sort is stable: pairs with keys that are equivalent according to
+/// \p compare_function keep their relative order.
+/// * Ranges specified by \p keys_input, \p keys_output, \p values_input and \p values_output
+/// must have at least \p size elements.
+/// * \p keys_output and \p values_output are also used as intermediate buffers,
+/// so they must allow reading.
+/// * Temporary storage grows linearly with \p size.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for comparison. Default type
+/// is \p rocprim::less<Key>, where \p Key is a \p value_type of \p KeysInputIterator.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] values_input - pointer to the first element in the range to sort.
+/// \param [out] values_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] compare_function - [optional] binary operation function object that returns
+/// \p true if the first key is ordered before the second one (strict weak ordering).
+/// Default is \p rocprim::less<Key>.
+/// \param [in] acc_view - [optional] \p hc::accelerator_view object. The default value
+/// is \p hc::accelerator().get_default_view() (default view of the default accelerator).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level descending merge sort is performed where input keys are
+/// represented by an array of integers and input values by an array of <tt>double</tt>s.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// hc::accelerator_view acc_view = ...;
+///
+/// // Prepare input and output (declare arrays, allocate device memory etc.)
+/// size_t input_size;                                           // e.g., 8
+/// hc::array<int> keys_input(hc::extent<1>(input_size), ...);      // e.g., [ 6, 3,  5, 4,  1,  8,  2, 5]
+/// hc::array<double> values_input(hc::extent<1>(input_size), ...); // e.g., [-5, 2, -4, 3, -1, -8, -2, 7]
+/// hc::array<int> keys_output(hc::extent<1>(input_size), ...);     // empty array of 8 elements
+/// hc::array<double> values_output(hc::extent<1>(input_size), ...); // empty array of 8 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// // Get required size of the temporary storage
+/// rocprim::merge_sort(
+///     nullptr, temporary_storage_size_bytes,
+///     keys_input.accelerator_pointer(), keys_output.accelerator_pointer(),
+///     values_input.accelerator_pointer(), values_output.accelerator_pointer(),
+///     input_size, rocprim::greater<int>(), acc_view
+/// );
+///
+/// // allocate temporary storage
+/// hc::array<char> temporary_storage(temporary_storage_size_bytes, acc_view);
+///
+/// // perform sort
+/// rocprim::merge_sort(
+///     temporary_storage.accelerator_pointer(), temporary_storage_size_bytes,
+///     keys_input.accelerator_pointer(), keys_output.accelerator_pointer(),
+///     values_input.accelerator_pointer(), values_output.accelerator_pointer(),
+///     input_size, rocprim::greater<int>(), acc_view
+/// );
+/// // keys_output:   [ 8, 6,  5, 5, 4, 3,  2,  1]
+/// // values_output: [-8, -5, -4, 7, 3, 2, -2, -1]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator>::value_type>
+>
+inline
+void merge_sort(void * temporary_storage,
+                  size_t& storage_size,
+                  KeysInputIterator keys_input,
+                  KeysOutputIterator keys_output,
+                  ValuesInputIterator values_input,
+                  ValuesOutputIterator values_output,
+                  const size_t size,
+                  BinaryFunction compare_function = BinaryFunction(),
+                  hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
+                  const bool debug_synchronous = false)
+{
+    detail::merge_sort_impl<Config>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output,
+        size, compare_function,
+        acc_view, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule_hc
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_MERGE_SORT_HC_HPP_
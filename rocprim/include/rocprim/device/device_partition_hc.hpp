@@ -0,0 +1,508 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_PARTITION_HC_HPP_
+#define ROCPRIM_DEVICE_DEVICE_PARTITION_HC_HPP_
+
+#include <type_traits>
+#include <iterator>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "device_select_config.hpp"
+#include "detail/device_select.hpp"
+#include "device_select_hc.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_hc
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_HC_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            acc_view.wait(); \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+} // end detail namespace
+
+/// \brief HC parallel partition primitive for device level using range of flags.
+///
+/// Performs a device-wide partition based on input \p flags. Values from \p input
+/// with positive flags are copied to the beginning of \p output range in their original
+/// order, all other values are copied to the end of \p output range in reverse order.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input, \p flags and \p output must have at least \p size elements.
+/// * Range specified by \p selected_count_output must have at least 1 element.
+/// * Values of \p flag range should be implicitly convertible to `bool` type.
+/// * Temporary storage does not depend on \p size, it grows only with the number of
+/// blocks (input is partitioned in a single pass).
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small partitions
+/// of host-accessible pointers are performed on the host.
+/// \tparam InputIterator - random-access iterator type of the input range. It can be
+/// a simple pointer type.
+/// \tparam FlagIterator - random-access iterator type of the flag range. It can be
+/// a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output range. It can be
+/// a simple pointer type.
+/// \tparam SelectedCountOutputIterator - random-access iterator type of the selected_count_output
+/// value. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the partition operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to partition.
+/// \param [in] flags - iterator to the selection flag corresponding to the first element from \p input range.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [out] selected_count_output - iterator to the total number of selected values.
+/// \param [in] size - number of element in the input range.
+/// \param [in] acc_view - [optional] \p hc::accelerator_view object. The default value
+/// is \p hc::accelerator().get_default_view() (default view of the default accelerator).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced. Default value is \p false.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level partition operation is performed on an array of
+/// integer values with array of <tt>char</tt>s used as flags.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// hc::accelerator_view acc_view = ...;
+///
+/// // Prepare input and output (declare arrays, allocate device memory etc.)
+/// size_t size;                                           // e.g., 8
+/// hc::array<int> input(hc::extent<1>(size), ...);        // e.g., [1, 2, 3, 4, 5, 6, 7, 8]
+/// hc::array<char> flags(hc::extent<1>(size), ...);       // e.g., [0, 1, 1, 0, 0, 1, 0, 1]
+/// hc::array<int> output(hc::extent<1>(size), ...);       // empty array of 8 elements
+/// hc::array<size_t> output_count(hc::extent<1>(1), ...); // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// // Get required size of the temporary storage
+/// rocprim::partition(
+///     nullptr, temporary_storage_size_bytes,
+///     input.accelerator_pointer(), flags.accelerator_pointer(),
+///     output.accelerator_pointer(), output_count.accelerator_pointer(),
+///     size, acc_view, false
+/// );
+///
+/// // allocate temporary storage
+/// hc::array<char> temporary_storage(temporary_storage_size_bytes, acc_view);
+///
+/// // perform partition
+/// rocprim::partition(
+///     temporary_storage.accelerator_pointer(), temporary_storage_size_bytes,
+///     input.accelerator_pointer(), flags.accelerator_pointer(),
+///     output.accelerator_pointer(), output_count.accelerator_pointer(),
+///     size, acc_view, false
+/// );
+/// // output: [2, 3, 6, 8, 7, 5, 4, 1]
+/// // output_count: 4
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class InputIterator,
+    class FlagIterator,
+    class OutputIterator,
+    class SelectedCountOutputIterator
+>
+inline
+void partition(void * temporary_storage,
+                 size_t& storage_size,
+                 InputIterator input,
+                 FlagIterator flags,
+                 OutputIterator output,
+                 SelectedCountOutputIterator selected_count_output,
+                 const size_t size,
+                 hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
+                 const bool debug_synchronous = false)
+{
+    detail::partition_impl<detail::select_method::flag, false, Config>(
+        temporary_storage, storage_size, input, flags, output, selected_count_output,
+        size, ::rocprim::empty_type(), ::rocprim::empty_type(), acc_view, debug_synchronous
+    );
+}
+
+/// \brief HC parallel partition primitive for device level using selection operator.
+///
+/// Performs a device-wide partition using selection operator. Values \p x from \p input
+/// for which <tt>select_op(x)</tt> is \p true are copied to the beginning of \p output
+/// range in their original order, all other values are copied to the end of \p output
+/// range in reverse order.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input and \p output must have at least \p size elements.
+/// * Range specified by \p selected_count_output must have at least 1 element.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small partitions
+/// of host-accessible pointers are performed on the host.
+/// \tparam InputIterator - random-access iterator type of the input range. It can be
+/// a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output range. It can be
+/// a simple pointer type.
+/// \tparam SelectedCountOutputIterator - random-access iterator type of the selected_count_output
+/// value. It can be a simple pointer type.
+/// \tparam SelectOp - type of an unary selection operator.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the partition operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to partition.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [out] selected_count_output - iterator to the total number of selected values.
+/// \param [in] size - number of element in the input range.
+/// \param [in] select_op - unary function object that will be used for selecting values.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the object passed to it.
+/// \param [in] acc_view - [optional] \p hc::accelerator_view object. The default value
+/// is \p hc::accelerator().get_default_view() (default view of the default accelerator).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced. Default value is \p false.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level partition operation is performed on an array of
+/// integer values, even values are selected.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// auto select_op =
+///     [](int a) [[hc]] -> bool
+///     {
+///         return (a%2) == 0;
+///     };
+///
+/// hc::accelerator_view acc_view = ...;
+///
+/// // Prepare input and output (declare arrays, allocate device memory etc.)
+/// size_t size;                                           // e.g., 8
+/// hc::array<int> input(hc::extent<1>(size), ...);        // e.g., [1, 2, 3, 4, 5, 6, 7, 8]
+/// hc::array<int> output(hc::extent<1>(size), ...);       // empty array of 8 elements
+/// hc::array<size_t> output_count(hc::extent<1>(1), ...); // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// // Get required size of the temporary storage
+/// rocprim::partition(
+///     nullptr, temporary_storage_size_bytes,
+///     input.accelerator_pointer(), output.accelerator_pointer(),
+///     output_count.accelerator_pointer(),
+///     size, select_op, acc_view, false
+/// );
+///
+/// // allocate temporary storage
+/// hc::array<char> temporary_storage(temporary_storage_size_bytes, acc_view);
+///
+/// // perform partition
+/// rocprim::partition(
+///     temporary_storage.accelerator_pointer(), temporary_storage_size_bytes,
+///     input.accelerator_pointer(), output.accelerator_pointer(),
+///     output_count.accelerator_pointer(),
+///     size, select_op, acc_view, false
+/// );
+/// // output: [2, 4, 6, 8, 7, 5, 3, 1]
+/// // output_count: 4
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class SelectedCountOutputIterator,
+    class SelectOp
+>
+inline
+void partition(void * temporary_storage,
+                 size_t& storage_size,
+                 InputIterator input,
+                 OutputIterator output,
+                 SelectedCountOutputIterator selected_count_output,
+                 const size_t size,
+                 SelectOp select_op,
+                 hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
+                 const bool debug_synchronous = false)
+{
+    // Flags are not used, input is passed as a dummy flag iterator
+    detail::partition_impl<detail::select_method::predicate, false, Config>(
+        temporary_storage, storage_size, input, input, output, selected_count_output,
+        size, select_op, ::rocprim::empty_type(), acc_view, debug_synchronous
+    );
+}
+
+/// \brief HC parallel three-way partition primitive for device level.
+///
+/// Performs a device-wide partition into three parts using two selection operators.
+/// Values \p x from \p input for which <tt>select_first_part_op(x)</tt> is \p true are
+/// copied to \p output_first_part, remaining values for which
+/// <tt>select_second_part_op(x)</tt> is \p true are copied to \p output_second_part,
+/// all other values are copied to \p output_unselected. Relative order of values is
+/// preserved in all three output ranges.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p input must have at least \p size elements.
+/// * Ranges specified by \p output_first_part, \p output_second_part and
+/// \p output_unselected must have at least so many elements, that all values of
+/// corresponding parts can be copied into them.
+/// * Range specified by \p selected_count_output must have at least 2 elements, sizes
+/// of the first and the second part are written to them.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small partitions
+/// of host-accessible pointers are performed on the host.
+/// \tparam InputIterator - random-access iterator type of the input range. It can be
+/// a simple pointer type.
+/// \tparam FirstOutputIterator - random-access iterator type of the first output range.
+/// It can be a simple pointer type.
+/// \tparam SecondOutputIterator - random-access iterator type of the second output range.
+/// It can be a simple pointer type.
+/// \tparam UnselectedOutputIterator - random-access iterator type of the unselected output
+/// range. It can be a simple pointer type.
+/// \tparam SelectedCountOutputIterator - random-access iterator type of the selected_count_output
+/// values. It can be a simple pointer type.
+/// \tparam FirstUnaryPredicate - type of an unary selection operator of the first part.
+/// \tparam SecondUnaryPredicate - type of an unary selection operator of the second part.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the partition operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to partition.
+/// \param [out] output_first_part - iterator to the first element in the first output range.
+/// \param [out] output_second_part - iterator to the first element in the second output range.
+/// \param [out] output_unselected - iterator to the first element in the unselected output range.
+/// \param [out] selected_count_output - iterator to the sizes of the first and the second part.
+/// \param [in] size - number of element in the input range.
+/// \param [in] select_first_part_op - unary function object that will be used for selecting
+/// values of the first part. The signature of the function should be equivalent to the
+/// following: <tt>bool f(const T &a);</tt>.
+/// \param [in] select_second_part_op - unary function object that will be used for selecting
+/// values of the second part. The signature of the function should be equivalent to the
+/// following: <tt>bool f(const T &a);</tt>.
+/// \param [in] acc_view - [optional] \p hc::accelerator_view object. The default value
+/// is \p hc::accelerator().get_default_view() (default view of the default accelerator).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced. Default value is \p false.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level three-way partition operation is performed on an
+/// array of integer values: values less than 3 and values less than 6.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// auto less_than_3 = [](int a) [[hc]] -> bool { return a < 3; };
+/// auto less_than_6 = [](int a) [[hc]] -> bool { return a < 6; };
+///
+/// hc::accelerator_view acc_view = ...;
+///
+/// // Prepare input and output (declare arrays, allocate device memory etc.)
+/// size_t size;                                            // e.g., 8
+/// hc::array<int> input(hc::extent<1>(size), ...);         // e.g., [1, 7, 2, 6, 3, 8, 4, 5]
+/// hc::array<int> output_first(hc::extent<1>(size), ...);  // empty array of 8 elements
+/// hc::array<int> output_second(hc::extent<1>(size), ...); // empty array of 8 elements
+/// hc::array<int> output_unselected(hc::extent<1>(size), ...); // empty array of 8 elements
+/// hc::array<size_t> output_count(hc::extent<1>(2), ...);  // empty array of 2 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// // Get required size of the temporary storage
+/// rocprim::partition_three_way(
+///     nullptr, temporary_storage_size_bytes,
+///     input.accelerator_pointer(),
+///     output_first.accelerator_pointer(), output_second.accelerator_pointer(),
+///     output_unselected.accelerator_pointer(), output_count.accelerator_pointer(),
+///     size, less_than_3, less_than_6, acc_view, false
+/// );
+///
+/// // allocate temporary storage
+/// hc::array<char> temporary_storage(temporary_storage_size_bytes, acc_view);
+///
+/// // perform partition
+/// rocprim::partition_three_way(
+///     temporary_storage.accelerator_pointer(), temporary_storage_size_bytes,
+///     input.accelerator_pointer(),
+///     output_first.accelerator_pointer(), output_second.accelerator_pointer(),
+///     output_unselected.accelerator_pointer(), output_count.accelerator_pointer(),
+///     size, less_than_3, less_than_6, acc_view, false
+/// );
+/// // output_first: [1, 2]
+/// // output_second: [3, 4, 5]
+/// // output_unselected: [7, 6, 8]
+/// // output_count: [2, 3]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class InputIterator,
+    class FirstOutputIterator,
+    class SecondOutputIterator,
+    class UnselectedOutputIterator,
+    class SelectedCountOutputIterator,
+    class FirstUnaryPredicate,
+    class SecondUnaryPredicate
+>
+inline
+void partition_three_way(void * temporary_storage,
+                           size_t& storage_size,
+                           InputIterator input,
+                           FirstOutputIterator output_first_part,
+                           SecondOutputIterator output_second_part,
+                           UnselectedOutputIterator output_unselected,
+                           SelectedCountOutputIterator selected_count_output,
+                           const size_t size,
+                           FirstUnaryPredicate select_first_part_op,
+                           SecondUnaryPredicate select_second_part_op,
+                           hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
+                           const bool debug_synchronous = false)
+{
+    using offset_type = detail::partition_three_way_offset;
+    using scan_state_type = detail::lookback_scan_state<offset_type>;
+    using ordered_block_id_type = detail::ordered_block_id<unsigned int>;
+
+    // Get default config if Config is default_config
+    using config = detail::default_or_custom_config<
+        Config,
+        detail::default_select_config<
+            typename std::iterator_traits<InputIterator>::value_type
+        >
+    >;
+
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
+    constexpr auto items_per_block = block_size * items_per_thread;
+    const unsigned int number_of_blocks = (size + items_per_block - 1)/items_per_block;
+
+    // Calculate required temporary storage
+    if(temporary_storage == nullptr)
+    {
+        storage_size = detail::lookback_scan_get_temporary_storage_bytes<scan_state_type>(number_of_blocks);
+        // Make sure user won't try to allocate 0 bytes memory, otherwise
+        // user may again pass nullptr as temporary_storage
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return;
+    }
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(size == 0)
+    {
+        // Only the number of selected items (zero) is written for empty input
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hc::parallel_for_each(
+            acc_view,
+            hc::tiled_extent<1>(1, 1),
+            [=](hc::tiled_index<1>) [[hc]]
+            {
+                detail::partition_empty_kernel_impl<2>(selected_count_output);
+            }
+        );
+        ROCPRIM_DETAIL_HC_SYNC("partition_empty_kernel", size, start)
+        return;
+    }
+
+    if(debug_synchronous)
+    {
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "number of blocks " << number_of_blocks << '\n';
+        std::cout << "items_per_block " << items_per_block << '\n';
+        std::cout << "temporary storage size " << storage_size << '\n';
+    }
+
+    // Create and initialize lookback_scan_state obj
+    auto scan_state = scan_state_type::create(temporary_storage, number_of_blocks);
+    // Create and initialize ordered_block_id obj
+    auto ptr = reinterpret_cast<char*>(temporary_storage);
+    auto ordered_bid = ordered_block_id_type::create(
+        reinterpret_cast<ordered_block_id_type::id_type*>(
+            ptr + ::rocprim::detail::align_size(scan_state_type::get_storage_size(number_of_blocks))
+        )
+    );
+
+    // Padding of look-back state must be initialized too
+    const unsigned int init_size = ::rocprim::max(number_of_blocks, ::rocprim::warp_size());
+    auto grid_size = ((init_size + block_size - 1)/block_size) * block_size;
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(grid_size, block_size),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            detail::init_lookback_scan_state_kernel_impl(
+                scan_state, number_of_blocks, ordered_bid
+            );
+        }
+    );
+    ROCPRIM_DETAIL_HC_SYNC("init_lookback_scan_state_kernel", number_of_blocks, start)
+
+    grid_size = number_of_blocks * block_size;
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(grid_size, block_size),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            detail::partition_three_way_kernel_impl<block_size, items_per_thread>(
+                input, output_first_part, output_second_part, output_unselected,
+                selected_count_output, size, select_first_part_op, select_second_part_op,
+                scan_state, number_of_blocks, ordered_bid
+            );
+        }
+    );
+    ROCPRIM_DETAIL_HC_SYNC("partition_three_way_kernel", size, start)
+
+}
+
+#undef ROCPRIM_DETAIL_HC_SYNC
+
+/// @}
+// end of group devicemodule_hc
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_PARTITION_HC_HPP_
@@ -0,0 +1,79 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_RADIX_SELECT_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_RADIX_SELECT_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup devicemodule_configs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level radix select operations (top-k).
+///
+/// \tparam RadixBits - number of bits of keys examined in each pass.
+/// \tparam BlockSize - number of threads in a block. Must not be less than <tt>1 << RadixBits</tt>.
+/// \tparam ItemsPerThread - number of items processed by each thread.
+/// \tparam SortConfig - configuration of radix sort used for sorted results.
+/// Must be \p radix_sort_config or \p default_config.
+template<
+    unsigned int RadixBits,
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class SortConfig = default_config
+>
+struct radix_select_config
+{
+    /// \brief Number of bits examined in each pass.
+    static constexpr unsigned int radix_bits = RadixBits;
+    /// \brief Number of threads in a block.
+    static constexpr unsigned int block_size = BlockSize;
+    /// \brief Number of items processed by each thread.
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+    /// \brief Configuration of radix sort used for sorted results.
+    using sort = SortConfig;
+};
+
+namespace detail
+{
+
+// Default configuration of radix select of keys of type Key
+template<class Key>
+struct default_radix_select_config
+    : radix_select_config<8, 256, scale_items_per_thread<8, Key>::value>
+{
+
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule_configs
+
+#endif // ROCPRIM_DEVICE_DEVICE_RADIX_SELECT_CONFIG_HPP_
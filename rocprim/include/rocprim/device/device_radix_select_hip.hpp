@@ -0,0 +1,1300 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_RADIX_SELECT_HIP_HPP_
+#define ROCPRIM_DEVICE_DEVICE_RADIX_SELECT_HIP_HPP_
+
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../detail/radix_sort.hpp"
+
+#include "../intrinsics.hpp"
+#include "../functional.hpp"
+#include "../types.hpp"
+
+#include "device_radix_select_config.hpp"
+#include "device_radix_sort_hip.hpp"
+#include "device_scan_hip.hpp"
+#include "device_segmented_radix_sort_hip.hpp"
+#include "detail/device_radix_select.hpp"
+
+/// \addtogroup devicemodule_hip
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+template<class BitKey>
+__global__
+void radix_select_init_kernel(radix_select_state<BitKey> * state,
+                              unsigned long long * digit_counts,
+                              unsigned int radix_size,
+                              size_t k)
+{
+    radix_select_init(state, digit_counts, radix_size, k);
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    bool Descending,
+    class KeysInputIterator,
+    class BitKey
+>
+__global__
+void radix_select_count_digits_kernel(KeysInputIterator keys_input,
+                                      size_t size,
+                                      unsigned int items_per_range,
+                                      unsigned int bit,
+                                      unsigned int current_radix_bits,
+                                      BitKey prefix_mask,
+                                      const radix_select_state<BitKey> * state,
+                                      unsigned long long * digit_counts)
+{
+    radix_select_count_digits<BlockSize, ItemsPerThread, RadixBits, Descending>(
+        keys_input, size, items_per_range,
+        bit, current_radix_bits, prefix_mask,
+        state, digit_counts
+    );
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int RadixBits,
+    class BitKey
+>
+__global__
+void radix_select_find_digit_kernel(unsigned long long * digit_counts,
+                                    radix_select_state<BitKey> * state,
+                                    unsigned int bit)
+{
+    radix_select_find_digit<BlockSize, RadixBits>(digit_counts, state, bit);
+}
+
+template<
+    unsigned int BlockSize,
+    bool Descending,
+    class Key,
+    class KeysOutputIterator,
+    class BitKey
+>
+__global__
+void radix_select_store_keys_kernel(const radix_select_state<BitKey> * states,
+                                    unsigned int count,
+                                    KeysOutputIterator keys_output)
+{
+    radix_select_store_keys<BlockSize, Descending, Key>(states, count, keys_output);
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    bool Descending,
+    class KeysInputIterator,
+    class BitKey
+>
+__global__
+void radix_select_count_selected_kernel(KeysInputIterator keys_input,
+                                        size_t size,
+                                        const radix_select_state<BitKey> * state,
+                                        size_t * less_counts,
+                                        size_t * equal_counts)
+{
+    radix_select_count_selected<BlockSize, ItemsPerThread, Descending>(
+        keys_input, size, state, less_counts, equal_counts
+    );
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class BitKey
+>
+__global__
+void radix_select_scatter_kernel(KeysInputIterator keys_input,
+                                 KeysOutputIterator keys_output,
+                                 ValuesInputIterator values_input,
+                                 ValuesOutputIterator values_output,
+                                 size_t size,
+                                 size_t k,
+                                 const radix_select_state<BitKey> * state,
+                                 const size_t * less_offsets,
+                                 const size_t * equal_offsets)
+{
+    radix_select_scatter<BlockSize, ItemsPerThread, Descending>(
+        keys_input, keys_output, values_input, values_output,
+        size, k, state, less_offsets, equal_offsets
+    );
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator
+>
+__global__
+void segmented_radix_select_kernel(KeysInputIterator keys_input,
+                                   KeysOutputIterator keys_output,
+                                   ValuesInputIterator values_input,
+                                   ValuesOutputIterator values_output,
+                                   OffsetIterator begin_offsets,
+                                   OffsetIterator end_offsets,
+                                   unsigned int k,
+                                   unsigned int * selected_begin_offsets,
+                                   unsigned int * selected_end_offsets)
+{
+    segmented_radix_select<BlockSize, ItemsPerThread, RadixBits, Descending>(
+        keys_input, keys_output, values_input, values_output,
+        begin_offsets, end_offsets, k,
+        selected_begin_offsets, selected_end_offsets
+    );
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
+    { \
+        auto error = hipPeekAtLastError(); \
+        if(error != hipSuccess) return error; \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto error = hipStreamSynchronize(stream); \
+            if(error != hipSuccess) return error; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+// Finds digits of the key of rank k (1-based), they are stored in state->prefix
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    bool Descending,
+    class KeysInputIterator,
+    class BitKey
+>
+inline
+hipError_t radix_select_find_key(KeysInputIterator keys_input,
+                                 size_t size,
+                                 size_t k,
+                                 radix_select_state<BitKey> * state,
+                                 unsigned long long * digit_counts,
+                                 hipStream_t stream,
+                                 bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, Descending>;
+
+    constexpr unsigned int radix_size = 1 << RadixBits;
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    constexpr unsigned int max_count_blocks = 1024;
+
+    const unsigned int blocks = static_cast<unsigned int>(
+        ::rocprim::detail::ceiling_div<size_t>(size, items_per_block)
+    );
+    // Digits are counted by at most max_count_blocks blocks, each processes a range
+    // of consecutive tiles
+    const unsigned int items_per_range =
+        ::rocprim::detail::ceiling_div(blocks, max_count_blocks) * items_per_block;
+    const unsigned int count_blocks = static_cast<unsigned int>(
+        ::rocprim::detail::ceiling_div<size_t>(size, items_per_range)
+    );
+
+    if(debug_synchronous)
+    {
+        std::cout << "count_blocks " << count_blocks << '\n';
+        hipError_t error = hipStreamSynchronize(stream);
+        if(error != hipSuccess) return error;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(radix_select_init_kernel<BitKey>),
+        dim3(1), dim3(BlockSize), 0, stream,
+        state, digit_counts, radix_size, k
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("radix_select_init", k, start)
+
+    // Every pass finds the next digit of the k-th key looking only at keys that have
+    // the same higher digits
+    for(unsigned int bit = key_codec::key_bits; bit > 0; )
+    {
+        const unsigned int current_radix_bits = ::rocprim::min(RadixBits, bit);
+        bit -= current_radix_bits;
+        const BitKey prefix_mask = radix_select_prefix_mask<BitKey>(bit + current_radix_bits);
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(radix_select_count_digits_kernel<
+                BlockSize, ItemsPerThread, RadixBits, Descending
+            >),
+            dim3(count_blocks), dim3(BlockSize), 0, stream,
+            keys_input, size, items_per_range,
+            bit, current_radix_bits, prefix_mask,
+            state, digit_counts
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("radix_select_count_digits", size, start)
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(radix_select_find_digit_kernel<BlockSize, RadixBits>),
+            dim3(1), dim3(BlockSize), 0, stream,
+            digit_counts, state, bit
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("radix_select_find_digit", radix_size, start)
+    }
+
+    return hipSuccess;
+}
+
+template<
+    class Config,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator
+>
+inline
+hipError_t radix_select_impl(void * temporary_storage,
+                             size_t& storage_size,
+                             KeysInputIterator keys_input,
+                             KeysOutputIterator keys_output,
+                             ValuesInputIterator values_input,
+                             ValuesOutputIterator values_output,
+                             size_t size,
+                             size_t k,
+                             bool sorted,
+                             hipStream_t stream,
+                             bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, Descending>;
+    using bit_key_type = typename key_codec::bit_key_type;
+    using state_type = radix_select_state<bit_key_type>;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_radix_select_config<key_type>
+    >;
+
+    constexpr unsigned int radix_bits = config::radix_bits;
+    constexpr unsigned int radix_size = 1 << radix_bits;
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
+    constexpr unsigned int items_per_block = block_size * items_per_thread;
+
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    k = ::rocprim::min(k, size);
+    const unsigned int blocks = static_cast<unsigned int>(
+        ::rocprim::detail::ceiling_div<size_t>(size, items_per_block)
+    );
+
+    // Scans of per-block counts and the sort of selected keys use the same storage
+    size_t scan_bytes;
+    hipError_t error = ::rocprim::exclusive_scan(
+        nullptr, scan_bytes,
+        static_cast<size_t *>(nullptr), static_cast<size_t *>(nullptr),
+        size_t(0), blocks, ::rocprim::plus<size_t>(),
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+    size_t sort_bytes = 0;
+    if(sorted)
+    {
+        bool ignored;
+        error = radix_sort<typename config::sort, Descending>(
+            nullptr, sort_bytes,
+            static_cast<key_type *>(nullptr), nullptr, keys_output,
+            static_cast<value_type *>(nullptr), nullptr, values_output,
+            k, ignored,
+            0, key_codec::key_bits,
+            stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+    }
+
+    const size_t state_bytes = ::rocprim::detail::align_size(sizeof(state_type));
+    const size_t digit_counts_bytes = ::rocprim::detail::align_size(radix_size * sizeof(unsigned long long));
+    const size_t block_counts_bytes = ::rocprim::detail::align_size(blocks * sizeof(size_t));
+    const size_t nested_bytes = ::rocprim::detail::align_size(::rocprim::max(scan_bytes, sort_bytes));
+    const size_t selected_keys_bytes = sorted ? ::rocprim::detail::align_size(k * sizeof(key_type)) : 0;
+    const size_t selected_values_bytes =
+        sorted && with_values ? ::rocprim::detail::align_size(k * sizeof(value_type)) : 0;
+    if(temporary_storage == nullptr)
+    {
+        storage_size = state_bytes + digit_counts_bytes + 4 * block_counts_bytes + nested_bytes
+            + selected_keys_bytes + selected_values_bytes;
+        return hipSuccess;
+    }
+
+    if(k == 0) return hipSuccess;
+
+    if(debug_synchronous)
+    {
+        std::cout << "blocks " << blocks << '\n';
+        error = hipStreamSynchronize(stream);
+        if(error != hipSuccess) return error;
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    state_type * state = reinterpret_cast<state_type *>(ptr);
+    ptr += state_bytes;
+    unsigned long long * digit_counts = reinterpret_cast<unsigned long long *>(ptr);
+    ptr += digit_counts_bytes;
+    size_t * less_counts = reinterpret_cast<size_t *>(ptr);
+    ptr += block_counts_bytes;
+    size_t * equal_counts = reinterpret_cast<size_t *>(ptr);
+    ptr += block_counts_bytes;
+    size_t * less_offsets = reinterpret_cast<size_t *>(ptr);
+    ptr += block_counts_bytes;
+    size_t * equal_offsets = reinterpret_cast<size_t *>(ptr);
+    ptr += block_counts_bytes;
+    void * nested_temporary_storage = ptr;
+    ptr += nested_bytes;
+    key_type * selected_keys = reinterpret_cast<key_type *>(ptr);
+    ptr += selected_keys_bytes;
+    value_type * selected_values = reinterpret_cast<value_type *>(ptr);
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    error = radix_select_find_key<block_size, items_per_thread, radix_bits, Descending>(
+        keys_input, size, k, state, digit_counts,
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(radix_select_count_selected_kernel<block_size, items_per_thread, Descending>),
+        dim3(blocks), dim3(block_size), 0, stream,
+        keys_input, size, state, less_counts, equal_counts
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("radix_select_count_selected", size, start)
+
+    error = ::rocprim::exclusive_scan(
+        nested_temporary_storage, scan_bytes,
+        less_counts, less_offsets,
+        size_t(0), blocks, ::rocprim::plus<size_t>(),
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+    error = ::rocprim::exclusive_scan(
+        nested_temporary_storage, scan_bytes,
+        equal_counts, equal_offsets,
+        size_t(0), blocks, ::rocprim::plus<size_t>(),
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    if(sorted)
+    {
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(radix_select_scatter_kernel<block_size, items_per_thread, Descending>),
+            dim3(blocks), dim3(block_size), 0, stream,
+            keys_input, selected_keys, values_input, selected_values,
+            size, k, state, less_offsets, equal_offsets
+        );
+    }
+    else
+    {
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(radix_select_scatter_kernel<block_size, items_per_thread, Descending>),
+            dim3(blocks), dim3(block_size), 0, stream,
+            keys_input, keys_output, values_input, values_output,
+            size, k, state, less_offsets, equal_offsets
+        );
+    }
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("radix_select_scatter", size, start)
+
+    if(sorted)
+    {
+        bool ignored;
+        error = radix_sort<typename config::sort, Descending>(
+            nested_temporary_storage, sort_bytes,
+            selected_keys, nullptr, keys_output,
+            selected_values, nullptr, values_output,
+            k, ignored,
+            0, key_codec::key_bits,
+            stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+    }
+
+    return hipSuccess;
+}
+
+// Finds keys of the given 0-based ranks in ascending order, every rank costs a few
+// passes of digit counting
+template<
+    class Config,
+    class KeysInputIterator,
+    class KeysOutputIterator
+>
+inline
+hipError_t radix_select_ranks_impl(void * temporary_storage,
+                                   size_t& storage_size,
+                                   KeysInputIterator keys_input,
+                                   KeysOutputIterator keys_output,
+                                   size_t size,
+                                   const size_t * ranks,
+                                   unsigned int ranks_count,
+                                   hipStream_t stream,
+                                   bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, false>;
+    using bit_key_type = typename key_codec::bit_key_type;
+    using state_type = radix_select_state<bit_key_type>;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_radix_select_config<key_type>
+    >;
+
+    constexpr unsigned int radix_bits = config::radix_bits;
+    constexpr unsigned int radix_size = 1 << radix_bits;
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
+
+    const size_t states_bytes = ::rocprim::detail::align_size(ranks_count * sizeof(state_type));
+    const size_t digit_counts_bytes = ::rocprim::detail::align_size(radix_size * sizeof(unsigned long long));
+    if(temporary_storage == nullptr)
+    {
+        storage_size = states_bytes + digit_counts_bytes;
+        // Make sure user won't try to allocate 0 bytes memory
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return hipSuccess;
+    }
+
+    if(size == 0 || ranks_count == 0) return hipSuccess;
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    state_type * states = reinterpret_cast<state_type *>(ptr);
+    ptr += states_bytes;
+    unsigned long long * digit_counts = reinterpret_cast<unsigned long long *>(ptr);
+
+    for(unsigned int i = 0; i < ranks_count; i++)
+    {
+        hipError_t error = radix_select_find_key<block_size, items_per_thread, radix_bits, false>(
+            keys_input, size, ranks[i] + 1, states + i, digit_counts,
+            stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(radix_select_store_keys_kernel<block_size, false, key_type>),
+        dim3(::rocprim::detail::ceiling_div(ranks_count, block_size)), dim3(block_size), 0, stream,
+        states, ranks_count, keys_output
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("radix_select_store_keys", ranks_count, start)
+
+    return hipSuccess;
+}
+
+template<
+    class Config,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator
+>
+inline
+hipError_t segmented_radix_select_impl(void * temporary_storage,
+                                       size_t& storage_size,
+                                       KeysInputIterator keys_input,
+                                       KeysOutputIterator keys_output,
+                                       ValuesInputIterator values_input,
+                                       ValuesOutputIterator values_output,
+                                       unsigned int segments,
+                                       OffsetIterator begin_offsets,
+                                       OffsetIterator end_offsets,
+                                       unsigned int k,
+                                       bool sorted,
+                                       hipStream_t stream,
+                                       bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, Descending>;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_radix_select_config<key_type>
+    >;
+
+    constexpr unsigned int radix_bits = config::radix_bits;
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
+
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    const size_t selected_size = static_cast<size_t>(segments) * k;
+
+    // Selected keys of every segment are sorted as a segment of the output
+    size_t sort_bytes = 0;
+    if(sorted)
+    {
+        bool ignored;
+        hipError_t error = segmented_radix_sort_impl<typename config::sort, Descending>(
+            nullptr, sort_bytes,
+            static_cast<key_type *>(nullptr), nullptr, keys_output,
+            static_cast<value_type *>(nullptr), nullptr, values_output,
+            selected_size, ignored,
+            segments, static_cast<unsigned int *>(nullptr), static_cast<unsigned int *>(nullptr),
+            0, key_codec::key_bits,
+            stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+    }
+
+    const size_t offsets_bytes = sorted ? ::rocprim::detail::align_size(segments * sizeof(unsigned int)) : 0;
+    const size_t selected_keys_bytes = sorted ? ::rocprim::detail::align_size(selected_size * sizeof(key_type)) : 0;
+    const size_t selected_values_bytes =
+        sorted && with_values ? ::rocprim::detail::align_size(selected_size * sizeof(value_type)) : 0;
+    const size_t nested_bytes = ::rocprim::detail::align_size(sort_bytes);
+    if(temporary_storage == nullptr)
+    {
+        storage_size = 2 * offsets_bytes + selected_keys_bytes + selected_values_bytes + nested_bytes;
+        // Make sure user won't try to allocate 0 bytes memory, because
+        // hipMalloc will return nullptr when size is zero.
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return hipSuccess;
+    }
+
+    if(segments == 0 || k == 0) return hipSuccess;
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    unsigned int * selected_begin_offsets = sorted ? reinterpret_cast<unsigned int *>(ptr) : nullptr;
+    ptr += offsets_bytes;
+    unsigned int * selected_end_offsets = sorted ? reinterpret_cast<unsigned int *>(ptr) : nullptr;
+    ptr += offsets_bytes;
+    key_type * selected_keys = reinterpret_cast<key_type *>(ptr);
+    ptr += selected_keys_bytes;
+    value_type * selected_values = reinterpret_cast<value_type *>(ptr);
+    ptr += selected_values_bytes;
+    void * nested_temporary_storage = ptr;
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    if(sorted)
+    {
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(segmented_radix_select_kernel<
+                block_size, items_per_thread, radix_bits, Descending
+            >),
+            dim3(segments), dim3(block_size), 0, stream,
+            keys_input, selected_keys, values_input, selected_values,
+            begin_offsets, end_offsets, k,
+            selected_begin_offsets, selected_end_offsets
+        );
+    }
+    else
+    {
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(segmented_radix_select_kernel<
+                block_size, items_per_thread, radix_bits, Descending
+            >),
+            dim3(segments), dim3(block_size), 0, stream,
+            keys_input, keys_output, values_input, values_output,
+            begin_offsets, end_offsets, k,
+            selected_begin_offsets, selected_end_offsets
+        );
+    }
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_radix_select", segments, start)
+
+    if(sorted)
+    {
+        bool ignored;
+        hipError_t error = segmented_radix_sort_impl<typename config::sort, Descending>(
+            nested_temporary_storage, sort_bytes,
+            selected_keys, nullptr, keys_output,
+            selected_values, nullptr, values_output,
+            selected_size, ignored,
+            segments, selected_begin_offsets, selected_end_offsets,
+            0, key_codec::key_bits,
+            stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+    }
+
+    return hipSuccess;
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end namespace detail
+
+/// \brief HIP parallel top-k primitive for device level.
+///
+/// topk_keys function selects \p k largest keys of the input range using radix select:
+/// every pass counts digits only of keys that may still be selected, so the cost is a few
+/// reads of keys instead of a full sort.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Accepts the same key types as radix_sort_keys (including keys decomposed with
+/// \p radix_key_decomposer).
+/// * \p keys_output must have at least <tt>min(k, size)</tt> elements.
+/// * If \p sorted is false, selected keys are written in the order they have in the input
+/// (among keys equal to the smallest selected key, the first ones in the input are selected).
+/// Otherwise they are sorted in descending order.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p radix_select_config
+/// or a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range of keys.
+/// \param [out] keys_output - pointer to the first element in the output range of selected keys.
+/// \param [in] size - number of elements in the input range.
+/// \param [in] k - number of keys to select.
+/// \param [in] sorted - [optional] if true, selected keys are sorted. Default value is \p false.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful selection; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example 3 largest keys of an array of \p float values are selected.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 8
+/// float * input;          // e.g., [0.6, 0.3, 0.65, 0.4, 0.2, 0.08, 1, 0.7]
+/// float * output;         // empty array of 3 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::topk_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, 3, true
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // select
+/// rocprim::topk_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, 3, true
+/// );
+/// // output: [1, 0.7, 0.65]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator
+>
+inline
+hipError_t topk_keys(void * temporary_storage,
+                     size_t& storage_size,
+                     KeysInputIterator keys_input,
+                     KeysOutputIterator keys_output,
+                     size_t size,
+                     size_t k,
+                     bool sorted = false,
+                     hipStream_t stream = 0,
+                     bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::radix_select_impl<Config, true>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values, values,
+        size, k, sorted,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel top-k primitive for device level, selects \p k smallest keys.
+///
+/// The same as topk_keys except that \p k smallest keys are selected and, if \p sorted
+/// is true, they are sorted in ascending order.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator
+>
+inline
+hipError_t bottomk_keys(void * temporary_storage,
+                        size_t& storage_size,
+                        KeysInputIterator keys_input,
+                        KeysOutputIterator keys_output,
+                        size_t size,
+                        size_t k,
+                        bool sorted = false,
+                        hipStream_t stream = 0,
+                        bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::radix_select_impl<Config, false>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values, values,
+        size, k, sorted,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel top-k primitive for device level, selects (key, value) pairs with
+/// \p k largest keys.
+///
+/// The same as topk_keys, values of selected keys are written to \p values_output
+/// in the same order as keys.
+///
+/// \par Example
+/// \parblock
+/// In this example indices of 2 largest scores are selected.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;              // e.g., 6
+/// float * scores;                 // e.g., [0.5, 0.1, 0.9, 0.3, 0.8, 0.2]
+/// float * top_scores;             // empty array of 2 elements
+/// rocprim::counting_iterator<int> indices(0);
+/// int * top_indices;              // empty array of 2 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::topk_pairs(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     scores, top_scores, indices, top_indices,
+///     input_size, 2, true
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // select
+/// rocprim::topk_pairs(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     scores, top_scores, indices, top_indices,
+///     input_size, 2, true
+/// );
+/// // top_scores:  [0.9, 0.8]
+/// // top_indices: [2, 4]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator
+>
+inline
+hipError_t topk_pairs(void * temporary_storage,
+                      size_t& storage_size,
+                      KeysInputIterator keys_input,
+                      KeysOutputIterator keys_output,
+                      ValuesInputIterator values_input,
+                      ValuesOutputIterator values_output,
+                      size_t size,
+                      size_t k,
+                      bool sorted = false,
+                      hipStream_t stream = 0,
+                      bool debug_synchronous = false)
+{
+    return detail::radix_select_impl<Config, true>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output,
+        size, k, sorted,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel top-k primitive for device level, selects (key, value) pairs with
+/// \p k smallest keys.
+///
+/// The same as topk_pairs except that \p k smallest keys are selected and, if \p sorted
+/// is true, they are sorted in ascending order.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator
+>
+inline
+hipError_t bottomk_pairs(void * temporary_storage,
+                         size_t& storage_size,
+                         KeysInputIterator keys_input,
+                         KeysOutputIterator keys_output,
+                         ValuesInputIterator values_input,
+                         ValuesOutputIterator values_output,
+                         size_t size,
+                         size_t k,
+                         bool sorted = false,
+                         hipStream_t stream = 0,
+                         bool debug_synchronous = false)
+{
+    return detail::radix_select_impl<Config, false>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output,
+        size, k, sorted,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel segmented top-k primitive for device level.
+///
+/// segmented_topk_keys function selects \p k largest keys of every segment. Each segment
+/// is processed by one block, which is efficient for many segments of moderate size
+/// (e.g. rows of a matrix of scores).
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
+/// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
+/// <tt>offsets + 1</tt> for \p end_offsets.
+/// * Selected keys of segment \p i are written to <tt>keys_output[i * k]</tt>, ...,
+/// <tt>keys_output[i * k + min(k, segment size) - 1]</tt>; the remaining positions of
+/// segments shorter than \p k are not modified. \p keys_output must have at least
+/// <tt>segments * k</tt> elements and <tt>segments * k</tt> must fit into <tt>unsigned int</tt>.
+/// * Order of selected keys is the same as in topk_keys.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p radix_select_config
+/// or a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range of keys.
+/// \param [out] keys_output - pointer to the first element in the output range of selected keys.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] k - number of keys to select in every segment.
+/// \param [in] sorted - [optional] if true, selected keys of every segment are sorted.
+/// Default value is \p false.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful selection; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class OffsetIterator
+>
+inline
+hipError_t segmented_topk_keys(void * temporary_storage,
+                               size_t& storage_size,
+                               KeysInputIterator keys_input,
+                               KeysOutputIterator keys_output,
+                               unsigned int segments,
+                               OffsetIterator begin_offsets,
+                               OffsetIterator end_offsets,
+                               unsigned int k,
+                               bool sorted = false,
+                               hipStream_t stream = 0,
+                               bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::segmented_radix_select_impl<Config, true>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values, values,
+        segments, begin_offsets, end_offsets,
+        k, sorted,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel segmented top-k primitive for device level, selects \p k smallest
+/// keys of every segment.
+///
+/// The same as segmented_topk_keys except that \p k smallest keys are selected and,
+/// if \p sorted is true, they are sorted in ascending order.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class OffsetIterator
+>
+inline
+hipError_t segmented_bottomk_keys(void * temporary_storage,
+                                  size_t& storage_size,
+                                  KeysInputIterator keys_input,
+                                  KeysOutputIterator keys_output,
+                                  unsigned int segments,
+                                  OffsetIterator begin_offsets,
+                                  OffsetIterator end_offsets,
+                                  unsigned int k,
+                                  bool sorted = false,
+                                  hipStream_t stream = 0,
+                                  bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::segmented_radix_select_impl<Config, false>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values, values,
+        segments, begin_offsets, end_offsets,
+        k, sorted,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel segmented top-k primitive for device level, selects (key, value)
+/// pairs with \p k largest keys of every segment.
+///
+/// The same as segmented_topk_keys, values of selected keys are written to
+/// \p values_output at the same positions as keys.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator
+>
+inline
+hipError_t segmented_topk_pairs(void * temporary_storage,
+                                size_t& storage_size,
+                                KeysInputIterator keys_input,
+                                KeysOutputIterator keys_output,
+                                ValuesInputIterator values_input,
+                                ValuesOutputIterator values_output,
+                                unsigned int segments,
+                                OffsetIterator begin_offsets,
+                                OffsetIterator end_offsets,
+                                unsigned int k,
+                                bool sorted = false,
+                                hipStream_t stream = 0,
+                                bool debug_synchronous = false)
+{
+    return detail::segmented_radix_select_impl<Config, true>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output,
+        segments, begin_offsets, end_offsets,
+        k, sorted,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel segmented top-k primitive for device level, selects (key, value)
+/// pairs with \p k smallest keys of every segment.
+///
+/// The same as segmented_topk_pairs except that \p k smallest keys are selected and,
+/// if \p sorted is true, they are sorted in ascending order.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator
+>
+inline
+hipError_t segmented_bottomk_pairs(void * temporary_storage,
+                                   size_t& storage_size,
+                                   KeysInputIterator keys_input,
+                                   KeysOutputIterator keys_output,
+                                   ValuesInputIterator values_input,
+                                   ValuesOutputIterator values_output,
+                                   unsigned int segments,
+                                   OffsetIterator begin_offsets,
+                                   OffsetIterator end_offsets,
+                                   unsigned int k,
+                                   bool sorted = false,
+                                   hipStream_t stream = 0,
+                                   bool debug_synchronous = false)
+{
+    return detail::segmented_radix_select_impl<Config, false>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output,
+        segments, begin_offsets, end_offsets,
+        k, sorted,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel selection of the n-th smallest key for device level.
+///
+/// nth_element function finds the key that would be at position \p n if the input range
+/// was sorted in ascending order. Like topk_keys it uses radix select: every pass counts
+/// digits only of keys whose higher digits match the digits found so far, so the input
+/// is read a few times instead of being sorted.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Accepts the same key types as radix_sort_keys.
+/// * Only the found key is written to \p nth_output, the input is not partitioned
+/// as in \p std::nth_element.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p radix_select_config
+/// or a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range of keys.
+/// \param [out] nth_output - pointer to the element where the found key is written.
+/// \param [in] size - number of elements in the input range.
+/// \param [in] n - 0-based position of the key in the sorted range, must be less than \p size.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful selection; \p hipErrorInvalidValue if
+/// \p n is not less than \p size; otherwise a HIP runtime error of type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example the median of an array of \p int values is found.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 7
+/// int * input;            // e.g., [8, 1, 6, 3, 5, 2, 9]
+/// int * output;           // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::nth_element(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, input_size / 2
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // select
+/// rocprim::nth_element(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, input_size / 2
+/// );
+/// // output: [5]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator
+>
+inline
+hipError_t nth_element(void * temporary_storage,
+                       size_t& storage_size,
+                       KeysInputIterator keys_input,
+                       KeysOutputIterator nth_output,
+                       size_t size,
+                       size_t n,
+                       hipStream_t stream = 0,
+                       bool debug_synchronous = false)
+{
+    if(n >= size)
+    {
+        return hipErrorInvalidValue;
+    }
+    return detail::radix_select_ranks_impl<Config>(
+        temporary_storage, storage_size,
+        keys_input, nth_output, size,
+        &n, 1,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief HIP parallel quantiles primitive for device level.
+///
+/// quantiles function finds keys at the given quantiles of the input range using
+/// the same radix select as nth_element. The quantile \p p (<tt>0 <= p <= 1</tt>) is
+/// the key at position <tt>floor(p * (size - 1))</tt> of the range sorted in ascending order.
+/// Every quantile costs a few passes of digit counting, which is much cheaper than
+/// sorting the range when the number of quantiles is small (e.g. p50, p99 and p999).
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Accepts the same key types as radix_sort_keys.
+/// * \p probabilities is a host array, it is read before the function returns.
+/// * \p quantiles_output must have at least \p quantiles_count elements.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p radix_select_config
+/// or a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range of keys.
+/// \param [out] quantiles_output - pointer to the first element in the output range of keys
+/// at the quantiles.
+/// \param [in] size - number of elements in the input range.
+/// \param [in] probabilities - host pointer to the first element of the array of quantiles,
+/// every one must be in range [0, 1].
+/// \param [in] quantiles_count - number of quantiles.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful selection; \p hipErrorInvalidValue if
+/// any of \p probabilities is out of range [0, 1]; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example p50, p99 and p999 of an array of latencies are found.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 1000000
+/// float * input;          // e.g., latencies in ms
+/// float * output;         // empty array of 3 elements
+/// const double probabilities[] = { 0.5, 0.99, 0.999 };
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::quantiles(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, probabilities, 3
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // select
+/// rocprim::quantiles(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, probabilities, 3
+/// );
+/// // output: [p50, p99, p999]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator
+>
+inline
+hipError_t quantiles(void * temporary_storage,
+                     size_t& storage_size,
+                     KeysInputIterator keys_input,
+                     KeysOutputIterator quantiles_output,
+                     size_t size,
+                     const double * probabilities,
+                     unsigned int quantiles_count,
+                     hipStream_t stream = 0,
+                     bool debug_synchronous = false)
+{
+    std::vector<size_t> ranks(quantiles_count);
+    for(unsigned int i = 0; i < quantiles_count; i++)
+    {
+        const double p = probabilities[i];
+        if(!(p >= 0.0 && p <= 1.0))
+        {
+            return hipErrorInvalidValue;
+        }
+        ranks[i] = size > 0 ? detail::quantile_rank(p, size) : 0;
+    }
+    return detail::radix_select_ranks_impl<Config>(
+        temporary_storage, storage_size,
+        keys_input, quantiles_output, size,
+        ranks.data(), quantiles_count,
+        stream, debug_synchronous
+    );
+}
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule_hip
+
+#endif // ROCPRIM_DEVICE_DEVICE_RADIX_SELECT_HIP_HPP_
@@ -0,0 +1,169 @@
+// Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_RADIX_SORT_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_RADIX_SORT_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../types.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup devicemodule_configs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level radix sort operation.
+///
+/// \tparam RadixBits - number of bits of keys sorted in one pass. \p 1 << \p RadixBits
+/// must not be greater than \p SortConfig::block_size.
+/// \tparam SortConfig - configuration of the sort-and-scatter kernel. Must be \p kernel_config.
+/// \tparam ChunkSize - [optional] maximum number of keys sorted by one launch of
+/// the sort-and-scatter kernel, it is rounded down to whole tiles. \p 0 means the largest
+/// number of whole tiles with 32-bit positions (inputs of more than 4G keys are sorted in
+/// chunks). Smaller values are only useful for testing.
+template<
+    unsigned int RadixBits,
+    class SortConfig,
+    unsigned int ChunkSize = 0
+>
+struct radix_sort_config
+{
+    /// \brief Number of bits of keys sorted in one pass.
+    static constexpr unsigned int radix_bits = RadixBits;
+    /// \brief Configuration of the sort-and-scatter kernel.
+    using sort = SortConfig;
+    /// \brief Maximum number of keys sorted by one launch of the sort-and-scatter kernel.
+    static constexpr unsigned int chunk_size = ChunkSize;
+};
+
+/// \brief Configuration of device-level segmented radix sort operation.
+///
+/// Segments are sorted by different kernels depending on their sizes: segments of at most
+/// \p WarpSortSize items are sorted by a logical warp each, segments that fit into
+/// one tile of \p SortConfig (<tt>block_size * items_per_thread</tt> items) are sorted by
+/// one block in a single pass, larger segments are sorted by one block per pass
+/// of \p RadixBits bits, and segments larger than \p HugeSegmentSize are sorted by
+/// device-wide radix sort.
+///
+/// \tparam RadixBits - number of bits of keys sorted in one pass. \p 1 << \p RadixBits
+/// must not be greater than \p SortConfig::block_size.
+/// \tparam SortConfig - configuration of the sort kernels. Must be \p kernel_config.
+/// \tparam WarpSortSize - size of logical warps sorting small segments. Must be a power
+/// of two not greater than the hardware warp size.
+/// \tparam HugeSegmentSize - size of the largest segment sorted by one block.
+template<
+    unsigned int RadixBits,
+    class SortConfig,
+    unsigned int WarpSortSize = 32,
+    unsigned int HugeSegmentSize = (1 << 17)
+>
+struct segmented_radix_sort_config : radix_sort_config<RadixBits, SortConfig>
+{
+    /// \brief Size of logical warps sorting small segments.
+    static constexpr unsigned int warp_sort_size = WarpSortSize;
+    /// \brief Size of the largest segment sorted by one block.
+    static constexpr unsigned int huge_segment_size = HugeSegmentSize;
+};
+
+namespace detail
+{
+
+// Size of items that are moved by radix sort: keys or, in pairs sort,
+// the larger of keys and values
+template<class Key, class Value>
+struct radix_sort_item_type
+{
+    using type = typename std::conditional<
+        std::is_same<Value, ::rocprim::empty_type>::value || (sizeof(Key) >= sizeof(Value)),
+        Key, Value
+    >::type;
+};
+
+// Default configuration of radix sort for keys of type Key and values of
+// type Value (empty_type when only keys are sorted)
+template<class Key, class Value>
+struct default_radix_sort_config
+    : radix_sort_config<
+        8,
+        scaled_kernel_config<256, 11, typename radix_sort_item_type<Key, Value>::type>
+    >
+{
+
+};
+
+template<class Key, class Value>
+struct default_segmented_radix_sort_config
+    : segmented_radix_sort_config<
+        8,
+        scaled_kernel_config<256, 11, typename radix_sort_item_type<Key, Value>::type>
+    >
+{
+
+};
+
+// Size classes of segmented radix sort, defaults are used when Config is
+// radix_sort_config instead of segmented_radix_sort_config
+template<class Config, class Enable = void>
+struct segmented_radix_sort_size_classes
+{
+    static constexpr unsigned int warp_sort_size = 32;
+    static constexpr unsigned int huge_segment_size = (1 << 17);
+};
+
+template<class Config>
+struct segmented_radix_sort_size_classes<
+    Config,
+    typename std::enable_if<(sizeof(Config::warp_sort_size) + sizeof(Config::huge_segment_size) > 0)>::type
+>
+{
+    static constexpr unsigned int warp_sort_size = Config::warp_sort_size;
+    static constexpr unsigned int huge_segment_size = Config::huge_segment_size;
+};
+
+// Maximum chunk size of radix sort, 0 (the largest chunk) is used when Config
+// is a custom class without chunk_size
+template<class Config, class Enable = void>
+struct radix_sort_chunk_size
+{
+    static constexpr unsigned int value = 0;
+};
+
+template<class Config>
+struct radix_sort_chunk_size<
+    Config,
+    typename std::enable_if<(sizeof(Config::chunk_size) > 0)>::type
+>
+{
+    static constexpr unsigned int value = Config::chunk_size;
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule_configs
+
+#endif // ROCPRIM_DEVICE_DEVICE_RADIX_SORT_CONFIG_HPP_
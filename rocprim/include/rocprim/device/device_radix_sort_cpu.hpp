@@ -0,0 +1,636 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_RADIX_SORT_CPU_HPP_
+#define ROCPRIM_DEVICE_DEVICE_RADIX_SORT_CPU_HPP_
+
+#include <algorithm>
+#include <type_traits>
+#include <iterator>
+#include <chrono>
+#include <iostream>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../detail/radix_sort.hpp"
+#include "../types.hpp"
+
+#include "config_types.hpp"
+#include "cpu_types.hpp"
+#include "detail/cpu_thread_pool.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_cpu
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_CPU_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+constexpr unsigned int cpu_radix_bits = 8;
+constexpr unsigned int cpu_radix_size = 1 << cpu_radix_bits;
+
+template<class Codec, class Key>
+inline
+unsigned int cpu_radix_digit(Key key, unsigned int bit, unsigned int bits)
+{
+    return static_cast<unsigned int>(Codec::encode(key) >> bit) & ((1u << bits) - 1);
+}
+
+// One counting sort pass over [begin, end) split into blocks of block_size items, each block
+// has its own histogram. Keys with equal digits keep their order, so the sort is stable.
+template<
+    class Codec,
+    bool WithValues,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator
+>
+inline
+void cpu_radix_sort_pass(KeysInputIterator keys_input,
+                         KeysOutputIterator keys_output,
+                         ValuesInputIterator values_input,
+                         ValuesOutputIterator values_output,
+                         const size_t begin,
+                         const size_t end,
+                         const size_t block_size,
+                         size_t * histograms,
+                         const unsigned int bit,
+                         const unsigned int bits)
+{
+    const size_t blocks = (end - begin + block_size - 1) / block_size;
+    const unsigned int radix_size = 1u << bits;
+
+    cpu_parallel_for(
+        blocks,
+        [&](size_t block)
+        {
+            size_t * histogram = histograms + block * cpu_radix_size;
+            std::fill(histogram, histogram + radix_size, size_t(0));
+            const size_t block_end = std::min(end, begin + (block + 1) * block_size);
+            for(size_t i = begin + block * block_size; i < block_end; i++)
+            {
+                histogram[cpu_radix_digit<Codec>(keys_input[i], bit, bits)]++;
+            }
+        }
+    );
+
+    // Starts of digits of all blocks, ordered by digit then by block
+    size_t offset = begin;
+    for(unsigned int digit = 0; digit < radix_size; digit++)
+    {
+        for(size_t block = 0; block < blocks; block++)
+        {
+            const size_t count = histograms[block * cpu_radix_size + digit];
+            histograms[block * cpu_radix_size + digit] = offset;
+            offset += count;
+        }
+    }
+
+    cpu_parallel_for(
+        blocks,
+        [&](size_t block)
+        {
+            size_t * starts = histograms + block * cpu_radix_size;
+            const size_t block_end = std::min(end, begin + (block + 1) * block_size);
+            for(size_t i = begin + block * block_size; i < block_end; i++)
+            {
+                const size_t position = starts[cpu_radix_digit<Codec>(keys_input[i], bit, bits)]++;
+                keys_output[position] = keys_input[i];
+                if(WithValues)
+                {
+                    values_output[position] = values_input[i];
+                }
+            }
+        }
+    );
+}
+
+// LSD radix sort of [begin, end), passes alternate between the temporary buffers
+// and the output buffers, so the last one writes to the output. Output buffers are
+// the outputs themselves unless these can't be read back (see radix_sort_output_buffer)
+template<
+    class Codec,
+    bool WithValues,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Key,
+    class Value,
+    class KeysBuffer,
+    class ValuesBuffer
+>
+inline
+void cpu_radix_sort(KeysInputIterator keys_input,
+                    Key * keys_tmp,
+                    KeysOutputIterator keys_output,
+                    KeysBuffer keys_buffer,
+                    ValuesInputIterator values_input,
+                    Value * values_tmp,
+                    ValuesOutputIterator values_output,
+                    ValuesBuffer values_buffer,
+                    const size_t begin,
+                    const size_t end,
+                    const size_t block_size,
+                    size_t * histograms,
+                    const unsigned int begin_bit,
+                    const unsigned int end_bit)
+{
+    const unsigned int passes = ceiling_div(end_bit - begin_bit, cpu_radix_bits);
+    if(passes == 0)
+    {
+        std::copy(keys_input + begin, keys_input + end, keys_output + begin);
+        if(WithValues)
+        {
+            std::copy(values_input + begin, values_input + end, values_output + begin);
+        }
+        return;
+    }
+
+    for(unsigned int pass = 0; pass < passes; pass++)
+    {
+        const unsigned int bit = begin_bit + pass * cpu_radix_bits;
+        const unsigned int bits = std::min(cpu_radix_bits, end_bit - bit);
+        const bool to_output = (passes - pass) % 2 == 1;
+        const bool is_last_pass = (pass == passes - 1);
+        if(pass == 0 && !to_output)
+        {
+            cpu_radix_sort_pass<Codec, WithValues>(
+                keys_input, keys_tmp, values_input, values_tmp,
+                begin, end, block_size, histograms, bit, bits
+            );
+        }
+        else if(pass == 0 && is_last_pass)
+        {
+            cpu_radix_sort_pass<Codec, WithValues>(
+                keys_input, keys_output, values_input, values_output,
+                begin, end, block_size, histograms, bit, bits
+            );
+        }
+        else if(pass == 0)
+        {
+            cpu_radix_sort_pass<Codec, WithValues>(
+                keys_input, keys_buffer, values_input, values_buffer,
+                begin, end, block_size, histograms, bit, bits
+            );
+        }
+        else if(!to_output)
+        {
+            cpu_radix_sort_pass<Codec, WithValues>(
+                keys_buffer, keys_tmp, values_buffer, values_tmp,
+                begin, end, block_size, histograms, bit, bits
+            );
+        }
+        else if(is_last_pass)
+        {
+            cpu_radix_sort_pass<Codec, WithValues>(
+                keys_tmp, keys_output, values_tmp, values_output,
+                begin, end, block_size, histograms, bit, bits
+            );
+        }
+        else
+        {
+            cpu_radix_sort_pass<Codec, WithValues>(
+                keys_tmp, keys_buffer, values_tmp, values_buffer,
+                begin, end, block_size, histograms, bit, bits
+            );
+        }
+    }
+}
+
+template<
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator
+>
+inline
+error_t radix_sort_impl(void * temporary_storage,
+                        size_t& storage_size,
+                        KeysInputIterator keys_input,
+                        KeysOutputIterator keys_output,
+                        ValuesInputIterator values_input,
+                        ValuesOutputIterator values_output,
+                        const size_t size,
+                        unsigned int begin_bit,
+                        unsigned int end_bit,
+                        stream_t /* stream */,
+                        bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using codec = radix_key_codec<key_type, Descending>;
+
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    const cpu_partition partition(size);
+
+    // Intermediate passes can't be read back from outputs which are not pointers,
+    // additional buffers are used for them
+    constexpr bool keys_output_is_buffer =
+        radix_sort_output_is_buffer<KeysOutputIterator, key_type>::value;
+    constexpr bool values_output_is_buffer =
+        !with_values || radix_sort_output_is_buffer<ValuesOutputIterator, value_type>::value;
+
+    const size_t histograms_bytes =
+        ::rocprim::detail::align_size(partition.blocks * cpu_radix_size * sizeof(size_t));
+    const size_t keys_bytes = ::rocprim::detail::align_size(size * sizeof(key_type));
+    const size_t values_bytes = with_values ? ::rocprim::detail::align_size(size * sizeof(value_type)) : 0;
+    const size_t keys_output_bytes = keys_output_is_buffer ? 0 : keys_bytes;
+    const size_t values_output_bytes = values_output_is_buffer ? 0 : values_bytes;
+    if(temporary_storage == nullptr)
+    {
+        storage_size = histograms_bytes + keys_bytes + values_bytes;
+        storage_size += keys_output_bytes + values_output_bytes;
+        // Make sure user won't try to allocate 0 bytes memory
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return success;
+    }
+
+    if(size == 0) return success;
+
+    // Bits above key_bits (e.g. padding of decomposed keys) are equal in all keys
+    constexpr unsigned int key_bits = codec::key_bits;
+    end_bit = std::min(end_bit, key_bits);
+    begin_bit = std::min(begin_bit, end_bit);
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        std::cout << "threads " << get_cpu_thread_pool().size() << '\n';
+        std::cout << "blocks " << partition.blocks << '\n';
+        std::cout << "block_size " << partition.block_size << '\n';
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    size_t * histograms = reinterpret_cast<size_t *>(ptr);
+    ptr += histograms_bytes;
+    key_type * keys_tmp = reinterpret_cast<key_type *>(ptr);
+    ptr += keys_bytes;
+    value_type * values_tmp = reinterpret_cast<value_type *>(ptr);
+    ptr += values_bytes;
+    key_type * keys_buffer = radix_sort_output_buffer(keys_output, reinterpret_cast<key_type *>(ptr));
+    ptr += keys_output_bytes;
+    value_type * values_buffer = radix_sort_output_buffer(values_output, reinterpret_cast<value_type *>(ptr));
+
+    cpu_radix_sort<codec, with_values>(
+        keys_input, keys_tmp, keys_output, keys_buffer,
+        values_input, values_tmp, values_output, values_buffer,
+        0, size, partition.block_size, histograms,
+        begin_bit, end_bit
+    );
+    ROCPRIM_DETAIL_CPU_SYNC("radix_sort", size, start)
+    return success;
+}
+
+#undef ROCPRIM_DETAIL_CPU_SYNC
+
+} // end namespace detail
+
+/// \brief CPU parallel ascending radix sort primitive for device level.
+///
+/// \p radix_sort_keys function performs a device-wide radix sort of keys
+/// on host threads. Function sorts input keys in ascending order.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * \p Key type must be an arithmetic type or a type with a specialization
+/// of \ref rocprim::radix_key_decomposer.
+/// * Ranges specified by \p keys_input and \p keys_output must have at least \p size elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam KeysInputIterator - random-access iterator type of the input range.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Default value: \p <tt>8 * sizeof(Key)</tt>.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+>
+inline
+error_t radix_sort_keys(void * temporary_storage,
+                        size_t& storage_size,
+                        KeysInputIterator keys_input,
+                        KeysOutputIterator keys_output,
+                        size_t size,
+                        unsigned int begin_bit = 0,
+                        unsigned int end_bit = 8 * sizeof(Key),
+                        stream_t stream = 0,
+                        bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::radix_sort_impl<false>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values, values,
+        size, begin_bit, end_bit, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel descending radix sort primitive for device level.
+///
+/// \p radix_sort_keys_desc function performs a device-wide radix sort of keys
+/// on host threads. Function sorts input keys in descending order.
+/// Parameters are the same as in \p radix_sort_keys.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+>
+inline
+error_t radix_sort_keys_desc(void * temporary_storage,
+                             size_t& storage_size,
+                             KeysInputIterator keys_input,
+                             KeysOutputIterator keys_output,
+                             size_t size,
+                             unsigned int begin_bit = 0,
+                             unsigned int end_bit = 8 * sizeof(Key),
+                             stream_t stream = 0,
+                             bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::radix_sort_impl<true>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values, values,
+        size, begin_bit, end_bit, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel ascending radix sort-by-key primitive for device level.
+///
+/// \p radix_sort_pairs function performs a device-wide radix sort of (key, value) pairs
+/// on host threads. Function sorts input pairs in ascending order of keys, the sort is stable.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input, \p keys_output, \p values_input and \p values_output must
+/// have at least \p size elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam KeysInputIterator - random-access iterator type of the input range.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] values_input - pointer to the first element in the range to sort.
+/// \param [out] values_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Default value: \p <tt>8 * sizeof(Key)</tt>.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+>
+inline
+error_t radix_sort_pairs(void * temporary_storage,
+                         size_t& storage_size,
+                         KeysInputIterator keys_input,
+                         KeysOutputIterator keys_output,
+                         ValuesInputIterator values_input,
+                         ValuesOutputIterator values_output,
+                         size_t size,
+                         unsigned int begin_bit = 0,
+                         unsigned int end_bit = 8 * sizeof(Key),
+                         stream_t stream = 0,
+                         bool debug_synchronous = false)
+{
+    return detail::radix_sort_impl<false>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output,
+        size, begin_bit, end_bit, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel descending radix sort-by-key primitive for device level.
+///
+/// \p radix_sort_pairs_desc function performs a device-wide radix sort of (key, value) pairs
+/// on host threads. Function sorts input pairs in descending order of keys.
+/// Parameters are the same as in \p radix_sort_pairs.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+>
+inline
+error_t radix_sort_pairs_desc(void * temporary_storage,
+                              size_t& storage_size,
+                              KeysInputIterator keys_input,
+                              KeysOutputIterator keys_output,
+                              ValuesInputIterator values_input,
+                              ValuesOutputIterator values_output,
+                              size_t size,
+                              unsigned int begin_bit = 0,
+                              unsigned int end_bit = 8 * sizeof(Key),
+                              stream_t stream = 0,
+                              bool debug_synchronous = false)
+{
+    return detail::radix_sort_impl<true>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output,
+        size, begin_bit, end_bit, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel radix sort primitive for device level, double-buffer variant.
+///
+/// \p radix_sort_keys sorts keys from \p current() of the double-buffer into
+/// \p alternate() and swaps the buffer, so \p current() points to the sorted range
+/// after the call. The input range is not altered.
+/// Other parameters are the same as in \p radix_sort_keys.
+template<class Config = default_config, class Key>
+inline
+error_t radix_sort_keys(void * temporary_storage,
+                        size_t& storage_size,
+                        double_buffer<Key>& keys,
+                        size_t size,
+                        unsigned int begin_bit = 0,
+                        unsigned int end_bit = 8 * sizeof(Key),
+                        stream_t stream = 0,
+                        bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    const error_t error = detail::radix_sort_impl<false>(
+        temporary_storage, storage_size,
+        keys.current(), keys.alternate(), values, values,
+        size, begin_bit, end_bit, stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr)
+    {
+        keys.swap();
+    }
+    return error;
+}
+
+/// \brief CPU parallel radix sort primitive for device level, double-buffer variant.
+///
+/// \p radix_sort_keys_desc sorts keys from \p current() of the double-buffer into
+/// \p alternate() and swaps the buffer, so \p current() points to the sorted range
+/// after the call. The input range is not altered.
+/// Other parameters are the same as in \p radix_sort_keys_desc.
+template<class Config = default_config, class Key>
+inline
+error_t radix_sort_keys_desc(void * temporary_storage,
+                             size_t& storage_size,
+                             double_buffer<Key>& keys,
+                             size_t size,
+                             unsigned int begin_bit = 0,
+                             unsigned int end_bit = 8 * sizeof(Key),
+                             stream_t stream = 0,
+                             bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    const error_t error = detail::radix_sort_impl<true>(
+        temporary_storage, storage_size,
+        keys.current(), keys.alternate(), values, values,
+        size, begin_bit, end_bit, stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr)
+    {
+        keys.swap();
+    }
+    return error;
+}
+
+/// \brief CPU parallel radix sort primitive for device level, double-buffer variant.
+///
+/// \p radix_sort_pairs sorts (key, value) pairs from \p current() of the double-buffers into
+/// \p alternate() and swaps the buffers, so \p current() points to the sorted range
+/// after the call. The input range is not altered.
+/// Other parameters are the same as in \p radix_sort_pairs.
+template<class Config = default_config, class Key, class Value>
+inline
+error_t radix_sort_pairs(void * temporary_storage,
+                         size_t& storage_size,
+                         double_buffer<Key>& keys,
+                         double_buffer<Value>& values,
+                         size_t size,
+                         unsigned int begin_bit = 0,
+                         unsigned int end_bit = 8 * sizeof(Key),
+                         stream_t stream = 0,
+                         bool debug_synchronous = false)
+{
+    const error_t error = detail::radix_sort_impl<false>(
+        temporary_storage, storage_size,
+        keys.current(), keys.alternate(), values.current(), values.alternate(),
+        size, begin_bit, end_bit, stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr)
+    {
+        keys.swap();
+        values.swap();
+    }
+    return error;
+}
+
+/// \brief CPU parallel radix sort primitive for device level, double-buffer variant.
+///
+/// \p radix_sort_pairs_desc sorts (key, value) pairs from \p current() of the double-buffers into
+/// \p alternate() and swaps the buffers, so \p current() points to the sorted range
+/// after the call. The input range is not altered.
+/// Other parameters are the same as in \p radix_sort_pairs_desc.
+template<class Config = default_config, class Key, class Value>
+inline
+error_t radix_sort_pairs_desc(void * temporary_storage,
+                              size_t& storage_size,
+                              double_buffer<Key>& keys,
+                              double_buffer<Value>& values,
+                              size_t size,
+                              unsigned int begin_bit = 0,
+                              unsigned int end_bit = 8 * sizeof(Key),
+                              stream_t stream = 0,
+                              bool debug_synchronous = false)
+{
+    const error_t error = detail::radix_sort_impl<true>(
+        temporary_storage, storage_size,
+        keys.current(), keys.alternate(), values.current(), values.alternate(),
+        size, begin_bit, end_bit, stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr)
+    {
+        keys.swap();
+        values.swap();
+    }
+    return error;
+}
+
+/// @}
+// end of group devicemodule_cpu
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_RADIX_SORT_CPU_HPP_
@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
@@ -34,6 +35,7 @@
 #include "../functional.hpp"
 #include "../types.hpp"
 
+#include "device_radix_sort_config.hpp"
 #include "detail/device_radix_sort.hpp"
 
 /// \addtogroup devicemodule_hc
@@ -44,6 +46,90 @@ BEGIN_ROCPRIM_NAMESPACE
 namespace detail
 {
 
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Offset,
+    class LookbackScanState
+>
+inline
+void onesweep_sort_and_scatter_launch(KeysInputIterator keys_input,
+                                      KeysOutputIterator keys_output,
+                                      ValuesInputIterator values_input,
+                                      ValuesOutputIterator values_output,
+                                      unsigned int size,
+                                      const Offset * digit_starts,
+                                      unsigned int bit,
+                                      unsigned int current_radix_bits,
+                                      LookbackScanState lookback_state,
+                                      ordered_block_id<unsigned int> ordered_bid,
+                                      hc::accelerator_view& acc_view)
+{
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    const unsigned int blocks = ::rocprim::detail::ceiling_div(size, items_per_block);
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(blocks * BlockSize, BlockSize),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            onesweep_sort_and_scatter<BlockSize, ItemsPerThread, RadixBits, Descending>(
+                keys_input, keys_output,
+                values_input, values_output,
+                size, digit_starts,
+                bit, current_radix_bits,
+                lookback_state, ordered_bid
+            );
+        }
+    );
+}
+
+// Digits of the chunk are counted by at most MaxHistogramBlocks blocks,
+// each processes a batch of consecutive tiles
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    bool Descending,
+    unsigned int MaxHistogramBlocks,
+    class KeysInputIterator,
+    class Offset
+>
+inline
+void onesweep_histograms_launch(KeysInputIterator keys_input,
+                                unsigned int size,
+                                Offset * digit_counts,
+                                unsigned int begin_bit,
+                                unsigned int end_bit,
+                                hc::accelerator_view& acc_view)
+{
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    const unsigned int blocks = ::rocprim::detail::ceiling_div(size, items_per_block);
+    const unsigned int blocks_per_full_batch = ::rocprim::detail::ceiling_div(blocks, MaxHistogramBlocks);
+    const unsigned int full_batches = blocks % MaxHistogramBlocks != 0
+        ? blocks % MaxHistogramBlocks
+        : MaxHistogramBlocks;
+    const unsigned int batches = (blocks_per_full_batch == 1 ? full_batches : MaxHistogramBlocks);
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(batches * BlockSize, BlockSize),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            onesweep_histograms<BlockSize, ItemsPerThread, RadixBits, Descending>(
+                keys_input, size,
+                digit_counts,
+                begin_bit, end_bit,
+                blocks_per_full_batch, full_batches
+            );
+        }
+    );
+}
+
 #define ROCPRIM_DETAIL_HC_SYNC(name, size, start) \
     { \
         if(debug_synchronous) \
@@ -56,258 +142,427 @@ namespace detail
         } \
     }
 
+// Offset is the type of positions of keys in the whole input and of digit starts,
+// keys are processed in chunks, so positions within a chunk are always 32-bit.
 template<
+    class Config,
     bool Descending,
+    class Offset,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
     class ValuesOutputIterator
 >
 inline
-void radix_sort(void * temporary_storage,
-                size_t& storage_size,
-                KeysInputIterator keys_input,
-                typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
-                KeysOutputIterator keys_output,
-                ValuesInputIterator values_input,
-                typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
-                ValuesOutputIterator values_output,
-                unsigned int size,
-                bool& is_result_in_output,
-                unsigned int begin_bit,
-                unsigned int end_bit,
-                hc::accelerator_view& acc_view,
-                bool debug_synchronous)
+void radix_sort_impl(void * temporary_storage,
+                     size_t& storage_size,
+                     KeysInputIterator keys_input,
+                     typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                     KeysOutputIterator keys_output,
+                     ValuesInputIterator values_input,
+                     typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                     ValuesOutputIterator values_output,
+                     size_t size,
+                     bool& is_result_in_output,
+                     unsigned int begin_bit,
+                     unsigned int end_bit,
+                     hc::accelerator_view& acc_view,
+                     bool debug_synchronous)
 {
-    constexpr unsigned int radix_bits = 8;
-    constexpr unsigned int radix_size = 1 << radix_bits;
-
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
 
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_radix_sort_config<key_type, value_type>
+    >;
+
+    constexpr unsigned int radix_bits = config::radix_bits;
+    constexpr unsigned int radix_size = 1 << radix_bits;
+    using lookback_state_type = ::rocprim::detail::lookback_scan_state<unsigned int>;
+    using ordered_block_id_type = ::rocprim::detail::ordered_block_id<unsigned int>;
+
     constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
 
-    constexpr unsigned int scan_block_size = 256;
-    constexpr unsigned int scan_items_per_thread = 4;
+    constexpr unsigned int max_histogram_blocks = 1024;
+    constexpr unsigned int init_block_size = 256;
 
-    constexpr unsigned int sort_block_size = 256;
-    constexpr unsigned int sort_items_per_thread = 11;
+    constexpr unsigned int sort_block_size = config::sort::block_size;
+    constexpr unsigned int sort_items_per_thread = config::sort::items_per_thread;
 
-    constexpr unsigned int scan_size = scan_block_size * scan_items_per_thread;
     constexpr unsigned int sort_size = sort_block_size * sort_items_per_thread;
 
-    const unsigned int blocks = ::rocprim::detail::ceiling_div(static_cast<unsigned int>(size), sort_size);
-    const unsigned int blocks_per_full_batch = ::rocprim::detail::ceiling_div(blocks, scan_size);
-    const unsigned int full_batches = blocks % scan_size != 0
-        ? blocks % scan_size
-        : scan_size;
-    const unsigned int batches = (blocks_per_full_batch == 1 ? full_batches : scan_size);
+    // The largest chunk of whole tiles whose positions fit into unsigned int,
+    // or a smaller one set by the config
+    constexpr unsigned int config_chunk_size = radix_sort_chunk_size<config>::value;
+    constexpr size_t max_chunk_size =
+        static_cast<size_t>(
+            config_chunk_size == 0
+                ? std::numeric_limits<unsigned int>::max() / sort_size
+                : (config_chunk_size < sort_size ? 1 : config_chunk_size / sort_size)
+        ) * sort_size;
+
+    const unsigned int chunks = static_cast<unsigned int>(
+        ::rocprim::max<size_t>(1, ::rocprim::detail::ceiling_div(size, max_chunk_size))
+    );
+    // All chunks share the look-back state which is large enough for the first (largest) chunk
+    const unsigned int blocks = ::rocprim::detail::ceiling_div(
+        static_cast<unsigned int>(::rocprim::min(size, max_chunk_size)), sort_size
+    );
+    // Bits above key_bits (e.g. padding of decomposed keys) are equal in all keys
+    constexpr unsigned int key_bits = radix_key_codec<key_type>::key_bits;
+    end_bit = ::rocprim::min(end_bit, key_bits);
+    begin_bit = ::rocprim::min(begin_bit, end_bit);
     const unsigned int iterations = ::rocprim::detail::ceiling_div(end_bit - begin_bit, radix_bits);
+    // Look-back prefix of digit d of tile t is stored at t * radix_size + d
+    const unsigned int prefixes = blocks * radix_size;
+    // Digits of all passes are counted in a single read of keys only when there is
+    // one chunk: after the first pass chunks contain other keys than in the input,
+    // so digits of every chunk are counted again before each pass
+    const bool recount_digits = chunks > 1;
+    // Digit counts (and then starts) of all passes (one chunk) or of all chunks
+    // of the current pass
+    const unsigned int digit_counts_size = (recount_digits ? chunks : iterations) * radix_size;
     const bool with_double_buffer = keys_tmp != nullptr;
+    // Intermediate passes can't be read back from outputs which are not pointers,
+    // additional buffers are used for them
+    const bool with_output_buffers = !with_double_buffer && iterations > 1;
+    constexpr bool keys_output_is_buffer =
+        radix_sort_output_is_buffer<KeysOutputIterator, key_type>::value;
+    constexpr bool values_output_is_buffer =
+        !with_values || radix_sort_output_is_buffer<ValuesOutputIterator, value_type>::value;
 
-    const size_t batch_digit_counts_bytes = ::rocprim::detail::align_size(batches * radix_size * sizeof(unsigned int));
-    const size_t digit_counts_bytes = ::rocprim::detail::align_size(radix_size * sizeof(unsigned int));
+    const size_t digit_counts_bytes = ::rocprim::detail::align_size(digit_counts_size * sizeof(Offset));
+    const size_t lookback_state_bytes = ::rocprim::detail::align_size(lookback_state_type::get_storage_size(prefixes));
+    const size_t ordered_bid_bytes = ::rocprim::detail::align_size(ordered_block_id_type::get_storage_size());
     const size_t keys_bytes = ::rocprim::detail::align_size(size * sizeof(key_type));
     const size_t values_bytes = with_values ? ::rocprim::detail::align_size(size * sizeof(value_type)) : 0;
+    const size_t keys_output_bytes = with_output_buffers && !keys_output_is_buffer ? keys_bytes : 0;
+    const size_t values_output_bytes = with_output_buffers && !values_output_is_buffer ? values_bytes : 0;
     if(temporary_storage == nullptr)
     {
-        storage_size = batch_digit_counts_bytes + digit_counts_bytes;
+        storage_size = digit_counts_bytes + lookback_state_bytes + ordered_bid_bytes;
         if(!with_double_buffer)
         {
             storage_size += keys_bytes + values_bytes;
         }
+        storage_size += keys_output_bytes + values_output_bytes;
+        return;
+    }
+
+    if(size == 0 || iterations == 0)
+    {
+        is_result_in_output = false;
         return;
     }
 
     if(debug_synchronous)
     {
+        std::cout << "chunks " << chunks << '\n';
         std::cout << "blocks " << blocks << '\n';
-        std::cout << "blocks_per_full_batch " << blocks_per_full_batch << '\n';
-        std::cout << "full_batches " << full_batches << '\n';
-        std::cout << "batches " << batches << '\n';
         std::cout << "iterations " << iterations << '\n';
         acc_view.wait();
     }
 
     char * ptr = reinterpret_cast<char *>(temporary_storage);
-    unsigned int * batch_digit_counts = reinterpret_cast<unsigned int *>(ptr);
-    ptr += batch_digit_counts_bytes;
-    unsigned int * digit_counts = reinterpret_cast<unsigned int *>(ptr);
+    Offset * digit_counts = reinterpret_cast<Offset *>(ptr);
     ptr += digit_counts_bytes;
+    auto lookback_state = lookback_state_type::create(ptr, prefixes);
+    ptr += lookback_state_bytes;
+    auto ordered_bid = ordered_block_id_type::create(
+        reinterpret_cast<ordered_block_id_type::id_type *>(ptr)
+    );
+    ptr += ordered_bid_bytes;
     if(!with_double_buffer)
     {
         keys_tmp = reinterpret_cast<key_type *>(ptr);
         ptr += keys_bytes;
         values_tmp = with_values ? reinterpret_cast<value_type *>(ptr) : nullptr;
+        ptr += values_bytes;
     }
+    // Intermediate passes to the output go to keys_buffer and values_buffer,
+    // they are keys_output and values_output when these are pointers
+    key_type * keys_buffer = radix_sort_output_buffer(keys_output, reinterpret_cast<key_type *>(ptr));
+    ptr += keys_output_bytes;
+    value_type * values_buffer = radix_sort_output_buffer(values_output, reinterpret_cast<value_type *>(ptr));
 
-    bool to_output = with_double_buffer || (iterations - 1) % 2 == 0;
-    for(unsigned int bit = begin_bit; bit < end_bit; bit += radix_bits)
-    {
-        // Handle cases when (end_bit - bit) is not divisible by radix_bits, i.e. the last
-        // iteration has a shorter mask.
-        const unsigned int current_radix_bits = ::rocprim::min(radix_bits, end_bit - bit);
-
-        const bool is_first_iteration = (bit == begin_bit);
+    // Initialization of the look-back state also resets digit counts before the first pass
+    const unsigned int init_grid_size = ::rocprim::detail::ceiling_div(
+        ::rocprim::max(prefixes, ::rocprim::max(digit_counts_size, ::rocprim::warp_size())),
+        init_block_size
+    );
 
-        std::chrono::high_resolution_clock::time_point start;
+    std::chrono::high_resolution_clock::time_point start;
 
-        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-        if(is_first_iteration)
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(init_grid_size * init_block_size, init_block_size),
+        [=](hc::tiled_index<1>) [[hc]]
         {
-            hc::parallel_for_each(
-                acc_view,
-                hc::tiled_extent<1>(batches * sort_block_size, sort_block_size),
-                [=](hc::tiled_index<1>) [[hc]]
-                {
-                    fill_digit_counts<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
-                        keys_input, size,
-                        batch_digit_counts,
-                        bit, current_radix_bits,
-                        blocks_per_full_batch, full_batches
-                    );
-                }
+            onesweep_init_kernel_impl(
+                lookback_state, prefixes, ordered_bid,
+                digit_counts, digit_counts_size
             );
         }
-        else
-        {
-            if(to_output)
-            {
-                hc::parallel_for_each(
-                    acc_view,
-                    hc::tiled_extent<1>(batches * sort_block_size, sort_block_size),
-                    [=](hc::tiled_index<1>) [[hc]]
-                    {
-                        fill_digit_counts<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
-                            keys_tmp, size,
-                            batch_digit_counts,
-                            bit, current_radix_bits,
-                            blocks_per_full_batch, full_batches
-                        );
-                    }
-                );
-            }
-            else
-            {
-                hc::parallel_for_each(
-                    acc_view,
-                    hc::tiled_extent<1>(batches * sort_block_size, sort_block_size),
-                    [=](hc::tiled_index<1>) [[hc]]
-                    {
-                        fill_digit_counts<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
-                            keys_output, size,
-                            batch_digit_counts,
-                            bit, current_radix_bits,
-                            blocks_per_full_batch, full_batches
-                        );
-                    }
-                );
-            }
-        }
-        ROCPRIM_DETAIL_HC_SYNC("fill_digit_counts", size, start)
+    );
+    ROCPRIM_DETAIL_HC_SYNC("onesweep_init", prefixes, start)
 
+    if(!recount_digits)
+    {
+        // Digits of all passes are counted in a single read of keys
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-        hc::parallel_for_each(
-            acc_view,
-            hc::tiled_extent<1>(radix_size * scan_block_size, scan_block_size),
-            [=](hc::tiled_index<1>) [[hc]]
-            {
-                scan_batches<scan_block_size, scan_items_per_thread, radix_bits>(
-                    batch_digit_counts, digit_counts, batches
-                );
-            }
+        onesweep_histograms_launch<sort_block_size, sort_items_per_thread, radix_bits, Descending, max_histogram_blocks>(
+            keys_input, static_cast<unsigned int>(size),
+            digit_counts,
+            begin_bit, end_bit,
+            acc_view
         );
-        ROCPRIM_DETAIL_HC_SYNC("scan_batches", radix_size * scan_block_size, start)
+        ROCPRIM_DETAIL_HC_SYNC("onesweep_histograms", size, start)
 
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hc::parallel_for_each(
             acc_view,
-            hc::tiled_extent<1>(radix_size, radix_size),
+            hc::tiled_extent<1>(iterations * radix_size, radix_size),
             [=](hc::tiled_index<1>) [[hc]]
             {
-                scan_digits<radix_bits>(digit_counts);
+                onesweep_scan_digits<radix_bits>(digit_counts, 1U);
             }
         );
-        ROCPRIM_DETAIL_HC_SYNC("scan_digits", radix_size, start)
+        ROCPRIM_DETAIL_HC_SYNC("onesweep_scan_digits", iterations * radix_size, start)
+    }
 
-        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-        if(is_first_iteration)
+    bool to_output = with_double_buffer || (iterations - 1) % 2 == 0;
+    for(unsigned int iteration = 0; iteration < iterations; iteration++)
+    {
+        const unsigned int bit = begin_bit + iteration * radix_bits;
+        // Handle cases when (end_bit - bit) is not divisible by radix_bits, i.e. the last
+        // iteration has a shorter mask.
+        const unsigned int current_radix_bits = ::rocprim::min(radix_bits, end_bit - bit);
+
+        const bool is_first_iteration = (iteration == 0);
+        const bool is_last_iteration = (iteration == iterations - 1);
+
+        if(recount_digits)
         {
-            if(to_output)
+            if(!is_first_iteration)
             {
+                if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
                 hc::parallel_for_each(
                     acc_view,
-                    hc::tiled_extent<1>(batches * sort_block_size, sort_block_size),
+                    hc::tiled_extent<1>(init_grid_size * init_block_size, init_block_size),
                     [=](hc::tiled_index<1>) [[hc]]
                     {
-                        sort_and_scatter<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
-                            keys_input, keys_output, values_input, values_output, size,
-                            batch_digit_counts, digit_counts,
-                            bit, current_radix_bits,
-                            blocks_per_full_batch, full_batches
+                        onesweep_init_kernel_impl(
+                            lookback_state, prefixes, ordered_bid,
+                            digit_counts, digit_counts_size
                         );
                     }
                 );
+                ROCPRIM_DETAIL_HC_SYNC("onesweep_init", prefixes, start)
             }
-            else
+
+            // Keys of the current pass are in the input (the first pass), in keys_buffer
+            // (when the pass writes to keys_tmp) or in keys_tmp
+            for(unsigned int chunk = 0; chunk < chunks; chunk++)
             {
-                hc::parallel_for_each(
-                    acc_view,
-                    hc::tiled_extent<1>(batches * sort_block_size, sort_block_size),
-                    [=](hc::tiled_index<1>) [[hc]]
-                    {
-                        sort_and_scatter<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
-                            keys_input, keys_tmp, values_input, values_tmp, size,
-                            batch_digit_counts, digit_counts,
-                            bit, current_radix_bits,
-                            blocks_per_full_batch, full_batches
-                        );
-                    }
+                const size_t chunk_offset = chunk * max_chunk_size;
+                const unsigned int chunk_size = static_cast<unsigned int>(
+                    ::rocprim::min(size - chunk_offset, max_chunk_size)
                 );
+
+                if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+                if(is_first_iteration)
+                {
+                    onesweep_histograms_launch<sort_block_size, sort_items_per_thread, radix_bits, Descending, max_histogram_blocks>(
+                        keys_input + chunk_offset, chunk_size,
+                        digit_counts + chunk * radix_size,
+                        bit, bit + current_radix_bits,
+                        acc_view
+                    );
+                }
+                else
+                {
+                    onesweep_histograms_launch<sort_block_size, sort_items_per_thread, radix_bits, Descending, max_histogram_blocks>(
+                        (to_output ? keys_tmp : keys_buffer) + chunk_offset, chunk_size,
+                        digit_counts + chunk * radix_size,
+                        bit, bit + current_radix_bits,
+                        acc_view
+                    );
+                }
+                ROCPRIM_DETAIL_HC_SYNC("onesweep_histograms", chunk_size, start)
             }
+
+            if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+            hc::parallel_for_each(
+                acc_view,
+                hc::tiled_extent<1>(radix_size, radix_size),
+                [=](hc::tiled_index<1>) [[hc]]
+                {
+                    onesweep_scan_digits<radix_bits>(digit_counts, chunks);
+                }
+            );
+            ROCPRIM_DETAIL_HC_SYNC("onesweep_scan_digits", chunks * radix_size, start)
         }
-        else
+
+        for(unsigned int chunk = 0; chunk < chunks; chunk++)
         {
-            if(to_output)
+            const size_t chunk_offset = chunk * max_chunk_size;
+            const unsigned int chunk_size = static_cast<unsigned int>(
+                ::rocprim::min(size - chunk_offset, max_chunk_size)
+            );
+            const Offset * digit_starts = digit_counts + (recount_digits ? chunk : iteration) * radix_size;
+
+            // The look-back state is already initialized for the first chunk of every
+            // pass when digits are recounted
+            if(chunk > 0 || (!is_first_iteration && !recount_digits))
             {
+                if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
                 hc::parallel_for_each(
                     acc_view,
-                    hc::tiled_extent<1>(batches * sort_block_size, sort_block_size),
+                    hc::tiled_extent<1>(init_grid_size * init_block_size, init_block_size),
                     [=](hc::tiled_index<1>) [[hc]]
                     {
-                        sort_and_scatter<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
-                            keys_tmp, keys_output, values_tmp, values_output, size,
-                            batch_digit_counts, digit_counts,
-                            bit, current_radix_bits,
-                            blocks_per_full_batch, full_batches
+                        onesweep_init_kernel_impl(
+                            lookback_state, prefixes, ordered_bid,
+                            static_cast<Offset *>(nullptr), 0U
                         );
                     }
                 );
+                ROCPRIM_DETAIL_HC_SYNC("onesweep_init", prefixes, start)
+            }
+
+            if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+            if(is_first_iteration)
+            {
+                if(!to_output)
+                {
+                    onesweep_sort_and_scatter_launch<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
+                        keys_input + chunk_offset, keys_tmp,
+                        values_input + chunk_offset, values_tmp,
+                        chunk_size, digit_starts,
+                        bit, current_radix_bits,
+                        lookback_state, ordered_bid,
+                        acc_view
+                    );
+                }
+                else if(is_last_iteration)
+                {
+                    onesweep_sort_and_scatter_launch<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
+                        keys_input + chunk_offset, keys_output,
+                        values_input + chunk_offset, values_output,
+                        chunk_size, digit_starts,
+                        bit, current_radix_bits,
+                        lookback_state, ordered_bid,
+                        acc_view
+                    );
+                }
+                else
+                {
+                    onesweep_sort_and_scatter_launch<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
+                        keys_input + chunk_offset, keys_buffer,
+                        values_input + chunk_offset, values_buffer,
+                        chunk_size, digit_starts,
+                        bit, current_radix_bits,
+                        lookback_state, ordered_bid,
+                        acc_view
+                    );
+                }
             }
             else
             {
-                hc::parallel_for_each(
-                    acc_view,
-                    hc::tiled_extent<1>(batches * sort_block_size, sort_block_size),
-                    [=](hc::tiled_index<1>) [[hc]]
-                    {
-                        sort_and_scatter<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
-                            keys_output, keys_tmp, values_output, values_tmp, size,
-                            batch_digit_counts, digit_counts,
-                            bit, current_radix_bits,
-                            blocks_per_full_batch, full_batches
-                        );
-                    }
-                );
+                if(!to_output)
+                {
+                    onesweep_sort_and_scatter_launch<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
+                        keys_buffer + chunk_offset, keys_tmp,
+                        values_buffer + chunk_offset, values_tmp,
+                        chunk_size, digit_starts,
+                        bit, current_radix_bits,
+                        lookback_state, ordered_bid,
+                        acc_view
+                    );
+                }
+                else if(is_last_iteration)
+                {
+                    onesweep_sort_and_scatter_launch<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
+                        keys_tmp + chunk_offset, keys_output,
+                        values_tmp + chunk_offset, values_output,
+                        chunk_size, digit_starts,
+                        bit, current_radix_bits,
+                        lookback_state, ordered_bid,
+                        acc_view
+                    );
+                }
+                else
+                {
+                    onesweep_sort_and_scatter_launch<sort_block_size, sort_items_per_thread, radix_bits, Descending>(
+                        keys_tmp + chunk_offset, keys_buffer,
+                        values_tmp + chunk_offset, values_buffer,
+                        chunk_size, digit_starts,
+                        bit, current_radix_bits,
+                        lookback_state, ordered_bid,
+                        acc_view
+                    );
+                }
             }
+            ROCPRIM_DETAIL_HC_SYNC("onesweep_sort_and_scatter", chunk_size, start)
         }
-        ROCPRIM_DETAIL_HC_SYNC("sort_and_scatter", size, start)
 
         is_result_in_output = to_output;
         to_output = !to_output;
     }
 }
 
+template<
+    class Config,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator
+>
+inline
+void radix_sort(void * temporary_storage,
+                size_t& storage_size,
+                KeysInputIterator keys_input,
+                typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                KeysOutputIterator keys_output,
+                ValuesInputIterator values_input,
+                typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                ValuesOutputIterator values_output,
+                size_t size,
+                bool& is_result_in_output,
+                unsigned int begin_bit,
+                unsigned int end_bit,
+                hc::accelerator_view& acc_view,
+                bool debug_synchronous)
+{
+    // 32-bit positions and digit starts are enough when size fits into unsigned int
+    if(size <= std::numeric_limits<unsigned int>::max())
+    {
+        radix_sort_impl<Config, Descending, unsigned int>(
+            temporary_storage, storage_size,
+            keys_input, keys_tmp, keys_output,
+            values_input, values_tmp, values_output,
+            size, is_result_in_output,
+            begin_bit, end_bit,
+            acc_view, debug_synchronous
+        );
+    }
+    else
+    {
+        radix_sort_impl<Config, Descending, unsigned long long>(
+            temporary_storage, storage_size,
+            keys_input, keys_tmp, keys_output,
+            values_input, values_tmp, values_output,
+            size, is_result_in_output,
+            begin_bit, end_bit,
+            acc_view, debug_synchronous
+        );
+    }
+}
+
 #undef ROCPRIM_DETAIL_HC_SYNC
 
 } // end namespace detail
@@ -322,12 +577,15 @@ void radix_sort(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 /// * \p Key type (a \p value_type of \p KeysInputIterator and \p KeysOutputIterator) must be
-/// an arithmetic type (that is, an integral type or a floating-point type).
+/// an arithmetic type (that is, an integral type or a floating-point type) or a type with
+/// a specialization of \ref rocprim::radix_key_decomposer.
 /// * Ranges specified by \p keys_input and \p keys_output must have at least \p size elements.
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p radix_sort_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
@@ -386,6 +644,7 @@ void radix_sort(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class Key = typename std::iterator_traits<KeysInputIterator>::value_type
@@ -395,7 +654,7 @@ void radix_sort_keys(void * temporary_storage,
                      size_t& storage_size,
                      KeysInputIterator keys_input,
                      KeysOutputIterator keys_output,
-                     unsigned int size,
+                     size_t size,
                      unsigned int begin_bit = 0,
                      unsigned int end_bit = 8 * sizeof(Key),
                      hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
@@ -403,7 +662,7 @@ void radix_sort_keys(void * temporary_storage,
 {
     empty_type * values = nullptr;
     bool ignored;
-    detail::radix_sort<false>(
+    detail::radix_sort<Config, false>(
         temporary_storage, storage_size,
         keys_input, nullptr, keys_output,
         values, nullptr, values,
@@ -423,12 +682,15 @@ void radix_sort_keys(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 /// * \p Key type (a \p value_type of \p KeysInputIterator and \p KeysOutputIterator) must be
-/// an arithmetic type (that is, an integral type or a floating-point type).
+/// an arithmetic type (that is, an integral type or a floating-point type) or a type with
+/// a specialization of \ref rocprim::radix_key_decomposer.
 /// * Ranges specified by \p keys_input and \p keys_output must have at least \p size elements.
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p radix_sort_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
@@ -487,6 +749,7 @@ void radix_sort_keys(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class Key = typename std::iterator_traits<KeysInputIterator>::value_type
@@ -496,7 +759,7 @@ void radix_sort_keys_desc(void * temporary_storage,
                           size_t& storage_size,
                           KeysInputIterator keys_input,
                           KeysOutputIterator keys_output,
-                          unsigned int size,
+                          size_t size,
                           unsigned int begin_bit = 0,
                           unsigned int end_bit = 8 * sizeof(Key),
                           hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
@@ -504,7 +767,7 @@ void radix_sort_keys_desc(void * temporary_storage,
 {
     empty_type * values = nullptr;
     bool ignored;
-    detail::radix_sort<true>(
+    detail::radix_sort<Config, true>(
         temporary_storage, storage_size,
         keys_input, nullptr, keys_output,
         values, nullptr, values,
@@ -524,13 +787,16 @@ void radix_sort_keys_desc(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 /// * \p Key type (a \p value_type of \p KeysInputIterator and \p KeysOutputIterator) must be
-/// an arithmetic type (that is, an integral type or a floating-point type).
+/// an arithmetic type (that is, an integral type or a floating-point type) or a type with
+/// a specialization of \ref rocprim::radix_key_decomposer.
 /// * Ranges specified by \p keys_input, \p keys_output, \p values_input and \p values_output must
 /// have at least \p size elements.
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p radix_sort_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
@@ -604,6 +870,7 @@ void radix_sort_keys_desc(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
@@ -617,14 +884,14 @@ void radix_sort_pairs(void * temporary_storage,
                       KeysOutputIterator keys_output,
                       ValuesInputIterator values_input,
                       ValuesOutputIterator values_output,
-                      unsigned int size,
+                      size_t size,
                       unsigned int begin_bit = 0,
                       unsigned int end_bit = 8 * sizeof(Key),
                       hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                       bool debug_synchronous = false)
 {
     bool ignored;
-    detail::radix_sort<false>(
+    detail::radix_sort<Config, false>(
         temporary_storage, storage_size,
         keys_input, nullptr, keys_output,
         values_input, nullptr, values_output,
@@ -644,13 +911,16 @@ void radix_sort_pairs(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 /// * \p Key type (a \p value_type of \p KeysInputIterator and \p KeysOutputIterator) must be
-/// an arithmetic type (that is, an integral type or a floating-point type).
+/// an arithmetic type (that is, an integral type or a floating-point type) or a type with
+/// a specialization of \ref rocprim::radix_key_decomposer.
 /// * Ranges specified by \p keys_input, \p keys_output, \p values_input and \p values_output must
 /// have at least \p size elements.
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p radix_sort_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
@@ -720,6 +990,7 @@ void radix_sort_pairs(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
@@ -733,14 +1004,14 @@ void radix_sort_pairs_desc(void * temporary_storage,
                            KeysOutputIterator keys_output,
                            ValuesInputIterator values_input,
                            ValuesOutputIterator values_output,
-                           unsigned int size,
+                           size_t size,
                            unsigned int begin_bit = 0,
                            unsigned int end_bit = 8 * sizeof(Key),
                            hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                            bool debug_synchronous = false)
 {
     bool ignored;
-    detail::radix_sort<true>(
+    detail::radix_sort<Config, true>(
         temporary_storage, storage_size,
         keys_input, nullptr, keys_output,
         values_input, nullptr, values_output,
@@ -765,12 +1036,14 @@ void radix_sort_pairs_desc(void * temporary_storage,
 /// * The function requires small \p temporary_storage as it does not need
 /// a temporary buffer of \p size elements.
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
-/// type).
+/// type) or a type with a specialization of \ref rocprim::radix_key_decomposer.
 /// * Buffers of \p keys must have at least \p size elements.
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p radix_sort_config or a custom class with the same members.
 /// \tparam Key - key type. Must be an integral type or a floating-point type.
 ///
 /// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
@@ -826,12 +1099,12 @@ void radix_sort_pairs_desc(void * temporary_storage,
 /// // keys.current(): [0.08, 0.2, 0.3, 0.4, 0.6, 0.65, 0.7, 1]
 /// \endcode
 /// \endparblock
-template<class Key>
+template<class Config = default_config, class Key>
 inline
 void radix_sort_keys(void * temporary_storage,
                      size_t& storage_size,
                      double_buffer<Key>& keys,
-                     unsigned int size,
+                     size_t size,
                      unsigned int begin_bit = 0,
                      unsigned int end_bit = 8 * sizeof(Key),
                      hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
@@ -839,7 +1112,7 @@ void radix_sort_keys(void * temporary_storage,
 {
     empty_type * values = nullptr;
     bool is_result_in_output;
-    detail::radix_sort<false>(
+    detail::radix_sort<Config, false>(
         temporary_storage, storage_size,
         keys.current(), keys.current(), keys.alternate(),
         values, values, values,
@@ -868,12 +1141,14 @@ void radix_sort_keys(void * temporary_storage,
 /// * The function requires small \p temporary_storage as it does not need
 /// a temporary buffer of \p size elements.
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
-/// type).
+/// type) or a type with a specialization of \ref rocprim::radix_key_decomposer.
 /// * Buffers of \p keys must have at least \p size elements.
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p radix_sort_config or a custom class with the same members.
 /// \tparam Key - key type. Must be an integral type or a floating-point type.
 ///
 /// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
@@ -929,12 +1204,12 @@ void radix_sort_keys(void * temporary_storage,
 /// // keys.current(): [8, 7, 6, 5, 4, 3, 2, 1]
 /// \endcode
 /// \endparblock
-template<class Key>
+template<class Config = default_config, class Key>
 inline
 void radix_sort_keys_desc(void * temporary_storage,
                           size_t& storage_size,
                           double_buffer<Key>& keys,
-                          unsigned int size,
+                          size_t size,
                           unsigned int begin_bit = 0,
                           unsigned int end_bit = 8 * sizeof(Key),
                           hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
@@ -942,7 +1217,7 @@ void radix_sort_keys_desc(void * temporary_storage,
 {
     empty_type * values = nullptr;
     bool is_result_in_output;
-    detail::radix_sort<true>(
+    detail::radix_sort<Config, true>(
         temporary_storage, storage_size,
         keys.current(), keys.current(), keys.alternate(),
         values, values, values,
@@ -971,12 +1246,14 @@ void radix_sort_keys_desc(void * temporary_storage,
 /// * The function requires small \p temporary_storage as it does not need
 /// a temporary buffer of \p size elements.
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
-/// type).
+/// type) or a type with a specialization of \ref rocprim::radix_key_decomposer.
 /// * Buffers of \p keys must have at least \p size elements.
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p radix_sort_config or a custom class with the same members.
 /// \tparam Key - key type. Must be an integral type or a floating-point type.
 /// \tparam Value - value type.
 ///
@@ -1044,20 +1321,20 @@ void radix_sort_keys_desc(void * temporary_storage,
 /// // values.current(): [-1, -2, 2, 3, -4, -5, 7, -8]
 /// \endcode
 /// \endparblock
-template<class Key, class Value>
+template<class Config = default_config, class Key, class Value>
 inline
 void radix_sort_pairs(void * temporary_storage,
                       size_t& storage_size,
                       double_buffer<Key>& keys,
                       double_buffer<Value>& values,
-                      unsigned int size,
+                      size_t size,
                       unsigned int begin_bit = 0,
                       unsigned int end_bit = 8 * sizeof(Key),
                       hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                       bool debug_synchronous = false)
 {
     bool is_result_in_output;
-    detail::radix_sort<false>(
+    detail::radix_sort<Config, false>(
         temporary_storage, storage_size,
         keys.current(), keys.current(), keys.alternate(),
         values.current(), values.current(), values.alternate(),
@@ -1087,12 +1364,14 @@ void radix_sort_pairs(void * temporary_storage,
 /// * The function requires small \p temporary_storage as it does not need
 /// a temporary buffer of \p size elements.
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
-/// type).
+/// type) or a type with a specialization of \ref rocprim::radix_key_decomposer.
 /// * Buffers of \p keys must have at least \p size elements.
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p radix_sort_config or a custom class with the same members.
 /// \tparam Key - key type. Must be an integral type or a floating-point type.
 /// \tparam Value - value type.
 ///
@@ -1156,20 +1435,20 @@ void radix_sort_pairs(void * temporary_storage,
 /// // values.current(): [-8, 7, -5, -4, 3, 2, -1, -2]
 /// \endcode
 /// \endparblock
-template<class Key, class Value>
+template<class Config = default_config, class Key, class Value>
 inline
 void radix_sort_pairs_desc(void * temporary_storage,
                            size_t& storage_size,
                            double_buffer<Key>& keys,
                            double_buffer<Value>& values,
-                           unsigned int size,
+                           size_t size,
                            unsigned int begin_bit = 0,
                            unsigned int end_bit = 8 * sizeof(Key),
                            hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                            bool debug_synchronous = false)
 {
     bool is_result_in_output;
-    detail::radix_sort<true>(
+    detail::radix_sort<Config, true>(
         temporary_storage, storage_size,
         keys.current(), keys.current(), keys.alternate(),
         values.current(), values.current(), values.alternate(),
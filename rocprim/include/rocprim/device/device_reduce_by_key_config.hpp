@@ -0,0 +1,79 @@
+// Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_REDUCE_BY_KEY_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_REDUCE_BY_KEY_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup devicemodule_configs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level reduce-by-key operation.
+///
+/// \tparam ReduceConfig - configuration of the single-pass reduce-by-key kernel.
+/// Must be \p kernel_config.
+/// \tparam ScanConfig - unused, unique counts and carry-outs are propagated between
+/// blocks with decoupled look-back. Kept for source compatibility.
+template<
+    class ReduceConfig,
+    class ScanConfig = kernel_config<256, 1>
+>
+struct reduce_by_key_config
+{
+    /// \brief Configuration of the single-pass reduce-by-key kernel.
+    using reduce = ReduceConfig;
+    /// \brief Unused, kept for source compatibility.
+    using scan = ScanConfig;
+};
+
+namespace detail
+{
+
+// Default configuration of reduce-by-key for keys of type Key and values
+// of type Value
+template<class Key, class Value>
+struct default_reduce_by_key_config
+    : reduce_by_key_config<
+        scaled_kernel_config<
+            256, 7,
+            typename std::conditional<(sizeof(Key) > sizeof(Value)), Key, Value>::type,
+            15
+        >
+    >
+{
+
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule_configs
+
+#endif // ROCPRIM_DEVICE_DEVICE_REDUCE_BY_KEY_CONFIG_HPP_
@@ -0,0 +1,285 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_REDUCE_BY_KEY_CPU_HPP_
+#define ROCPRIM_DEVICE_DEVICE_REDUCE_BY_KEY_CPU_HPP_
+
+#include <type_traits>
+#include <iterator>
+#include <chrono>
+#include <iostream>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../functional.hpp"
+
+#include "config_types.hpp"
+#include "cpu_types.hpp"
+#include "detail/cpu_thread_pool.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_cpu
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_CPU_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<
+    class KeysInputIterator,
+    class ValuesInputIterator,
+    class UniqueOutputIterator,
+    class AggregatesOutputIterator,
+    class UniqueCountOutputIterator,
+    class BinaryFunction,
+    class KeyCompareFunction
+>
+inline
+error_t reduce_by_key_impl(void * temporary_storage,
+                           size_t& storage_size,
+                           KeysInputIterator keys_input,
+                           ValuesInputIterator values_input,
+                           const unsigned int size,
+                           UniqueOutputIterator unique_output,
+                           AggregatesOutputIterator aggregates_output,
+                           UniqueCountOutputIterator unique_count_output,
+                           BinaryFunction reduce_op,
+                           KeyCompareFunction key_compare_op,
+                           const stream_t /* stream */,
+                           const bool debug_synchronous)
+{
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    const cpu_partition partition(size);
+
+    const size_t offsets_bytes = ::rocprim::detail::align_size((partition.blocks + 1) * sizeof(size_t));
+    const size_t values_bytes = ::rocprim::detail::align_size(partition.blocks * sizeof(value_type));
+    if(temporary_storage == nullptr)
+    {
+        storage_size = offsets_bytes + 2 * values_bytes;
+        return success;
+    }
+
+    if(size == 0)
+    {
+        *unique_count_output = 0;
+        return success;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        std::cout << "threads " << get_cpu_thread_pool().size() << '\n';
+        std::cout << "blocks " << partition.blocks << '\n';
+        std::cout << "block_size " << partition.block_size << '\n';
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    size_t * offsets = reinterpret_cast<size_t *>(ptr);
+    ptr += offsets_bytes;
+    // Reductions of values preceding the first head of each block
+    value_type * carries = reinterpret_cast<value_type *>(ptr);
+    ptr += values_bytes;
+    // Reductions of values of the last group starting in each block
+    value_type * tails = reinterpret_cast<value_type *>(ptr);
+
+    auto is_head = [&](size_t i) -> bool
+    {
+        return i == 0 || !key_compare_op(keys_input[i - 1], keys_input[i]);
+    };
+
+    cpu_parallel_for(
+        partition.blocks,
+        [&](size_t block)
+        {
+            size_t count = 0;
+            for(size_t i = partition.begin(block); i < partition.end(block); i++)
+            {
+                count += is_head(i) ? 1 : 0;
+            }
+            offsets[block] = count;
+        }
+    );
+
+    size_t unique_count = 0;
+    for(size_t block = 0; block < partition.blocks; block++)
+    {
+        const size_t count = offsets[block];
+        offsets[block] = unique_count;
+        unique_count += count;
+    }
+    offsets[partition.blocks] = unique_count;
+
+    // Groups which start and end in the same block are reduced by this block,
+    // partial reductions of groups spanning several blocks are combined later
+    cpu_parallel_for(
+        partition.blocks,
+        [&](size_t block)
+        {
+            const size_t begin = partition.begin(block);
+            size_t group = offsets[block];
+            bool before_head = true;
+            value_type value = values_input[begin];
+            for(size_t i = begin; i < partition.end(block); i++)
+            {
+                if(is_head(i))
+                {
+                    if(i > begin)
+                    {
+                        if(before_head) carries[block] = value;
+                        else aggregates_output[group - 1] = value;
+                    }
+                    before_head = false;
+                    unique_output[group++] = keys_input[i];
+                    value = values_input[i];
+                }
+                else if(i > begin)
+                {
+                    value = reduce_op(value, values_input[i]);
+                }
+            }
+            if(before_head) carries[block] = value;
+            else tails[block] = value;
+        }
+    );
+
+    // The first block always starts with a head
+    value_type value = tails[0];
+    for(size_t block = 1; block < partition.blocks; block++)
+    {
+        if(!is_head(partition.begin(block)))
+        {
+            value = reduce_op(value, carries[block]);
+        }
+        if(offsets[block + 1] > offsets[block])
+        {
+            aggregates_output[offsets[block] - 1] = value;
+            value = tails[block];
+        }
+    }
+    aggregates_output[unique_count - 1] = value;
+    *unique_count_output = unique_count;
+    ROCPRIM_DETAIL_CPU_SYNC("reduce_by_key", size, start)
+    return success;
+}
+
+#undef ROCPRIM_DETAIL_CPU_SYNC
+
+} // end of detail namespace
+
+/// \brief CPU parallel reduce-by-key primitive for device level.
+///
+/// reduce_by_key function performs a device-wide reduction operation of groups
+/// of consecutive values having the same key using binary \p reduce_op operator on host threads.
+/// The first key of each group is copied to \p unique_output and reduction of the group is written
+/// to \p aggregates_output. The total number of group is written to \p unique_count_output.
+///
+/// \par Overview
+/// * Supports non-commutative reduction operators. However, a reduction operator should be
+/// associative.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input and \p values_input must have at least \p size elements.
+/// * Range specified by \p unique_count_output must have at least 1 element.
+/// * Ranges specified by \p unique_output and \p aggregates_output must have at least
+/// <tt>*unique_count_output</tt> (i.e. the number of unique keys) elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam KeysInputIterator - random-access iterator type of the input range.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range.
+/// \tparam UniqueOutputIterator - random-access iterator type of the output range.
+/// \tparam AggregatesOutputIterator - random-access iterator type of the output range.
+/// \tparam UniqueCountOutputIterator - random-access iterator type of the output range.
+/// \tparam BinaryFunction - type of binary function used for reduction. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of \p ValuesInputIterator.
+/// \tparam KeyCompareFunction - type of binary function used to determine keys equality. Default type
+/// is \p rocprim::equal_to<T>, where \p T is a \p value_type of \p KeysInputIterator.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - iterator to the first element in the range of keys.
+/// \param [in] values_input - iterator to the first element in the range of values to reduce.
+/// \param [in] size - number of element in the input range.
+/// \param [out] unique_output - iterator to the first element in the output range of unique keys.
+/// \param [out] aggregates_output - iterator to the first element in the output range of reductions.
+/// \param [out] unique_count_output - iterator to total number of groups.
+/// \param [in] reduce_op - binary operation function object that will be used for reduction.
+/// Default is BinaryFunction().
+/// \param [in] key_compare_op - binary operation function object that will be used to determine
+/// keys equality. Default is KeyCompareFunction().
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class ValuesInputIterator,
+    class UniqueOutputIterator,
+    class AggregatesOutputIterator,
+    class UniqueCountOutputIterator,
+    class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<ValuesInputIterator>::value_type>,
+    class KeyCompareFunction = ::rocprim::equal_to<typename std::iterator_traits<KeysInputIterator>::value_type>
+>
+inline
+error_t reduce_by_key(void * temporary_storage,
+                      size_t& storage_size,
+                      KeysInputIterator keys_input,
+                      ValuesInputIterator values_input,
+                      unsigned int size,
+                      UniqueOutputIterator unique_output,
+                      AggregatesOutputIterator aggregates_output,
+                      UniqueCountOutputIterator unique_count_output,
+                      BinaryFunction reduce_op = BinaryFunction(),
+                      KeyCompareFunction key_compare_op = KeyCompareFunction(),
+                      stream_t stream = 0,
+                      bool debug_synchronous = false)
+{
+    return detail::reduce_by_key_impl(
+        temporary_storage, storage_size,
+        keys_input, values_input, size,
+        unique_output, aggregates_output, unique_count_output,
+        reduce_op, key_compare_op,
+        stream, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule_cpu
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_REDUCE_BY_KEY_CPU_HPP_
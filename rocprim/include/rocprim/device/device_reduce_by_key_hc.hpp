@@ -29,6 +29,7 @@
 
 #include "../functional.hpp"
 
+#include "device_reduce_by_key_config.hpp"
 #include "detail/device_reduce_by_key.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -52,6 +53,7 @@ namespace detail
     }
 
 template<
+    class Config,
     class KeysInputIterator,
     class ValuesInputIterator,
     class UniqueOutputIterator,
@@ -76,29 +78,47 @@ void reduce_by_key_impl(void * temporary_storage,
 {
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
-    using carry_out_type = carry_out<key_type, value_type>;
+    using scan_state_type = detail::lookback_scan_state<scan_by_key_pair<value_type>>;
+    using ordered_block_id_type = detail::ordered_block_id<unsigned int>;
 
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 7;
-
-    constexpr unsigned int scan_block_size = 256;
-    constexpr unsigned int scan_items_per_thread = 7;
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_reduce_by_key_config<key_type, value_type>
+    >;
 
+    constexpr unsigned int block_size = config::reduce::block_size;
+    constexpr unsigned int items_per_thread = config::reduce::items_per_thread;
     constexpr unsigned int items_per_block = block_size * items_per_thread;
-    constexpr unsigned int scan_items_per_block = scan_block_size * scan_items_per_thread;
 
-    const unsigned int blocks = ::rocprim::detail::ceiling_div(static_cast<unsigned int>(size), items_per_block);
-    const unsigned int blocks_per_full_batch = ::rocprim::detail::ceiling_div(blocks, scan_items_per_block);
-    const unsigned int full_batches = blocks % scan_items_per_block != 0
-        ? blocks % scan_items_per_block
-        : scan_items_per_block;
-    const unsigned int batches = (blocks_per_full_batch == 1 ? full_batches : scan_items_per_block);
+    const unsigned int number_of_blocks = ::rocprim::detail::ceiling_div(size, items_per_block);
 
-    const size_t unique_counts_bytes = ::rocprim::detail::align_size(batches * sizeof(unsigned int));
-    const size_t carry_outs_bytes = ::rocprim::detail::align_size(batches * sizeof(carry_out_type));
+    // Only look-back state of blocks and ordered block id counter are needed
+    const size_t scan_state_bytes =
+        ::rocprim::detail::align_size(scan_state_type::get_storage_size(number_of_blocks));
+    const size_t ordered_bid_bytes = ordered_block_id_type::get_storage_size();
     if(temporary_storage == nullptr)
     {
-        storage_size = unique_counts_bytes + carry_outs_bytes;
+        storage_size = scan_state_bytes + ordered_bid_bytes;
+        return;
+    }
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(size == 0)
+    {
+        // Only the number of unique keys (zero) is written for empty input
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hc::parallel_for_each(
+            acc_view,
+            hc::tiled_extent<1>(1, 1),
+            [=](hc::tiled_index<1>) [[hc]]
+            {
+                reduce_by_key_empty_kernel_impl(unique_count_output);
+            }
+        );
+        ROCPRIM_DETAIL_HC_SYNC("reduce_by_key_empty_kernel", size, start)
         return;
     }
 
@@ -106,82 +126,48 @@ void reduce_by_key_impl(void * temporary_storage,
     {
         std::cout << "block_size " << block_size << '\n';
         std::cout << "items_per_thread " << items_per_thread << '\n';
-        std::cout << "blocks " << blocks << '\n';
-        std::cout << "blocks_per_full_batch " << blocks_per_full_batch << '\n';
-        std::cout << "full_batches " << full_batches << '\n';
-        std::cout << "batches " << batches << '\n';
+        std::cout << "number of blocks " << number_of_blocks << '\n';
         std::cout << "storage_size " << storage_size << '\n';
         acc_view.wait();
     }
 
     char * ptr = reinterpret_cast<char *>(temporary_storage);
-    unsigned int * unique_counts = reinterpret_cast<unsigned int *>(ptr);
-    ptr += unique_counts_bytes;
-    carry_out_type * carry_outs = reinterpret_cast<carry_out_type *>(ptr);
-
-    // Start point for time measurements
-    std::chrono::high_resolution_clock::time_point start;
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hc::parallel_for_each(
-        acc_view,
-        hc::tiled_extent<1>(batches * block_size, block_size),
-        [=](hc::tiled_index<1>) [[hc]]
-        {
-            fill_unique_counts<block_size, items_per_thread>(
-                keys_input, size, unique_counts, key_compare_op,
-                blocks_per_full_batch, full_batches, blocks
-            );
-        }
+    auto scan_state = scan_state_type::create(ptr, number_of_blocks);
+    ptr += scan_state_bytes;
+    auto ordered_bid = ordered_block_id_type::create(
+        reinterpret_cast<ordered_block_id_type::id_type *>(ptr)
     );
-    ROCPRIM_DETAIL_HC_SYNC("fill_unique_counts", size, start)
 
+    // Padding of look-back state must be initialized too
+    const unsigned int init_size = ::rocprim::max(number_of_blocks, ::rocprim::warp_size());
     if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
     hc::parallel_for_each(
         acc_view,
-        hc::tiled_extent<1>(scan_block_size, scan_block_size),
+        hc::tiled_extent<1>(::rocprim::detail::ceiling_div(init_size, block_size) * block_size, block_size),
         [=](hc::tiled_index<1>) [[hc]]
         {
-            scan_unique_counts<scan_block_size, scan_items_per_thread>(
-                unique_counts, unique_count_output,
-                batches
+            init_lookback_scan_state_kernel_impl(
+                scan_state, number_of_blocks, ordered_bid
             );
         }
     );
-    ROCPRIM_DETAIL_HC_SYNC("scan_unique_counts", scan_block_size, start)
+    ROCPRIM_DETAIL_HC_SYNC("init_lookback_scan_state_kernel", number_of_blocks, start)
 
     if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
     hc::parallel_for_each(
         acc_view,
-        hc::tiled_extent<1>(batches * block_size, block_size),
+        hc::tiled_extent<1>(number_of_blocks * block_size, block_size),
         [=](hc::tiled_index<1>) [[hc]]
         {
-            reduce_by_key<block_size, items_per_thread>(
+            reduce_by_key_kernel_impl<block_size, items_per_thread>(
                 keys_input, values_input, size,
-                unique_counts, carry_outs,
-                unique_output, aggregates_output,
+                unique_output, aggregates_output, unique_count_output,
                 key_compare_op, reduce_op,
-                blocks_per_full_batch, full_batches, blocks
+                scan_state, number_of_blocks, ordered_bid
             );
         }
     );
     ROCPRIM_DETAIL_HC_SYNC("reduce_by_key", size, start)
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hc::parallel_for_each(
-        acc_view,
-        hc::tiled_extent<1>(scan_block_size, scan_block_size),
-        [=](hc::tiled_index<1>) [[hc]]
-        {
-            scan_and_scatter_carry_outs<scan_block_size, scan_items_per_thread>(
-                carry_outs,
-                aggregates_output,
-                key_compare_op, reduce_op,
-                batches
-            );
-        }
-    );
-    ROCPRIM_DETAIL_HC_SYNC("scan_and_scatter_carry_outs", scan_block_size, start)
 }
 
 #undef ROCPRIM_DETAIL_HC_SYNC
@@ -206,6 +192,8 @@ void reduce_by_key_impl(void * temporary_storage,
 /// * Ranges specified by \p unique_output and \p aggregates_output must have at least
 /// <tt>*unique_count_output</tt> (i.e. the number of unique keys) elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p reduce_by_key_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam ValuesInputIterator - random-access iterator type of the input range. Must meet the
@@ -289,6 +277,7 @@ void reduce_by_key_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class ValuesInputIterator,
     class UniqueOutputIterator,
@@ -311,7 +300,7 @@ void reduce_by_key(void * temporary_storage,
                    hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                    bool debug_synchronous = false)
 {
-    detail::reduce_by_key_impl(
+    detail::reduce_by_key_impl<Config>(
         temporary_storage, storage_size,
         keys_input, values_input, size,
         unique_output, aggregates_output, unique_count_output,
@@ -29,7 +29,9 @@
 
 #include "../functional.hpp"
 
+#include "device_reduce_by_key_config.hpp"
 #include "detail/device_reduce_by_key.hpp"
+#include "device_scan_hip.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -39,42 +41,6 @@ BEGIN_ROCPRIM_NAMESPACE
 namespace detail
 {
 
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class KeysInputIterator,
-    class KeyCompareFunction
->
-__global__
-void fill_unique_counts_kernel(KeysInputIterator keys_input,
-                               unsigned int size,
-                               unsigned int * unique_counts,
-                               KeyCompareFunction key_compare_op,
-                               unsigned int blocks_per_full_batch,
-                               unsigned int full_batches,
-                               unsigned int blocks)
-{
-    fill_unique_counts<BlockSize, ItemsPerThread>(
-        keys_input, size,
-        unique_counts,
-        key_compare_op,
-        blocks_per_full_batch, full_batches, blocks
-    );
-}
-
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class UniqueCountOutputIterator
->
-__global__
-void scan_unique_counts_kernel(unsigned int * unique_counts,
-                               UniqueCountOutputIterator unique_count_output,
-                               unsigned int batches)
-{
-    scan_unique_counts<BlockSize, ItemsPerThread>(unique_counts, unique_count_output, batches);
-}
-
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
@@ -82,53 +48,37 @@ template<
     class ValuesInputIterator,
     class UniqueOutputIterator,
     class AggregatesOutputIterator,
-    class CarryOut,
+    class UniqueCountOutputIterator,
     class KeyCompareFunction,
-    class BinaryFunction
+    class BinaryFunction,
+    class LookbackScanState
 >
 __global__
 void reduce_by_key_kernel(KeysInputIterator keys_input,
                           ValuesInputIterator values_input,
-                          unsigned int size,
-                          const unsigned int * unique_starts,
-                          CarryOut * carry_outs,
+                          const unsigned int size,
                           UniqueOutputIterator unique_output,
                           AggregatesOutputIterator aggregates_output,
+                          UniqueCountOutputIterator unique_count_output,
                           KeyCompareFunction key_compare_op,
                           BinaryFunction reduce_op,
-                          unsigned int blocks_per_full_batch,
-                          unsigned int full_batches,
-                          unsigned int blocks)
+                          LookbackScanState scan_state,
+                          const unsigned int number_of_blocks,
+                          ordered_block_id<unsigned int> ordered_bid)
 {
-    reduce_by_key<BlockSize, ItemsPerThread>(
+    reduce_by_key_kernel_impl<BlockSize, ItemsPerThread>(
         keys_input, values_input, size,
-        unique_starts, carry_outs,
-        unique_output, aggregates_output,
+        unique_output, aggregates_output, unique_count_output,
         key_compare_op, reduce_op,
-        blocks_per_full_batch, full_batches, blocks
+        scan_state, number_of_blocks, ordered_bid
     );
 }
 
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class AggregatesOutputIterator,
-    class CarryOut,
-    class KeyCompareFunction,
-    class BinaryFunction
->
+template<class UniqueCountOutputIterator>
 __global__
-void scan_and_scatter_carry_outs_kernel(const CarryOut * carry_outs,
-                                        AggregatesOutputIterator aggregates_output,
-                                        KeyCompareFunction key_compare_op,
-                                        BinaryFunction reduce_op,
-                                        unsigned int batches)
+void reduce_by_key_empty_kernel(UniqueCountOutputIterator unique_count_output)
 {
-    scan_and_scatter_carry_outs<BlockSize, ItemsPerThread>(
-        carry_outs, aggregates_output,
-        key_compare_op, reduce_op,
-        batches
-    );
+    reduce_by_key_empty_kernel_impl(unique_count_output);
 }
 
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
@@ -147,6 +97,7 @@ void scan_and_scatter_carry_outs_kernel(const CarryOut * carry_outs,
     }
 
 template<
+    class Config,
     class KeysInputIterator,
     class ValuesInputIterator,
     class UniqueOutputIterator,
@@ -171,29 +122,44 @@ hipError_t reduce_by_key_impl(void * temporary_storage,
 {
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
-    using carry_out_type = carry_out<key_type, value_type>;
-
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 7;
+    using scan_state_type = detail::lookback_scan_state<scan_by_key_pair<value_type>>;
+    using ordered_block_id_type = detail::ordered_block_id<unsigned int>;
 
-    constexpr unsigned int scan_block_size = 256;
-    constexpr unsigned int scan_items_per_thread = 7;
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_reduce_by_key_config<key_type, value_type>
+    >;
 
+    constexpr unsigned int block_size = config::reduce::block_size;
+    constexpr unsigned int items_per_thread = config::reduce::items_per_thread;
     constexpr unsigned int items_per_block = block_size * items_per_thread;
-    constexpr unsigned int scan_items_per_block = scan_block_size * scan_items_per_thread;
 
-    const unsigned int blocks = ::rocprim::detail::ceiling_div(static_cast<unsigned int>(size), items_per_block);
-    const unsigned int blocks_per_full_batch = ::rocprim::detail::ceiling_div(blocks, scan_items_per_block);
-    const unsigned int full_batches = blocks % scan_items_per_block != 0
-        ? blocks % scan_items_per_block
-        : scan_items_per_block;
-    const unsigned int batches = (blocks_per_full_batch == 1 ? full_batches : scan_items_per_block);
+    const unsigned int number_of_blocks = ::rocprim::detail::ceiling_div(size, items_per_block);
 
-    const size_t unique_counts_bytes = ::rocprim::detail::align_size(batches * sizeof(unsigned int));
-    const size_t carry_outs_bytes = ::rocprim::detail::align_size(batches * sizeof(carry_out_type));
+    // Only look-back state of blocks and ordered block id counter are needed
+    const size_t scan_state_bytes =
+        ::rocprim::detail::align_size(scan_state_type::get_storage_size(number_of_blocks));
+    const size_t ordered_bid_bytes = ordered_block_id_type::get_storage_size();
     if(temporary_storage == nullptr)
     {
-        storage_size = unique_counts_bytes + carry_outs_bytes;
+        storage_size = scan_state_bytes + ordered_bid_bytes;
+        return hipSuccess;
+    }
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(size == 0)
+    {
+        // Only the number of unique keys (zero) is written for empty input
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(reduce_by_key_empty_kernel<UniqueCountOutputIterator>),
+            dim3(1), dim3(1), 0, stream,
+            unique_count_output
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("reduce_by_key_empty_kernel", size, start)
         return hipSuccess;
     }
 
@@ -201,64 +167,40 @@ hipError_t reduce_by_key_impl(void * temporary_storage,
     {
         std::cout << "block_size " << block_size << '\n';
         std::cout << "items_per_thread " << items_per_thread << '\n';
-        std::cout << "blocks " << blocks << '\n';
-        std::cout << "blocks_per_full_batch " << blocks_per_full_batch << '\n';
-        std::cout << "full_batches " << full_batches << '\n';
-        std::cout << "batches " << batches << '\n';
+        std::cout << "number of blocks " << number_of_blocks << '\n';
         std::cout << "storage_size " << storage_size << '\n';
         hipError_t error = hipStreamSynchronize(stream);
         if(error != hipSuccess) return error;
     }
 
     char * ptr = reinterpret_cast<char *>(temporary_storage);
-    unsigned int * unique_counts = reinterpret_cast<unsigned int *>(ptr);
-    ptr += unique_counts_bytes;
-    carry_out_type * carry_outs = reinterpret_cast<carry_out_type *>(ptr);
-
-    // Start point for time measurements
-    std::chrono::high_resolution_clock::time_point start;
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(fill_unique_counts_kernel<block_size, items_per_thread>),
-        dim3(batches), dim3(block_size), 0, stream,
-        keys_input, size, unique_counts, key_compare_op,
-        blocks_per_full_batch, full_batches, blocks
+    auto scan_state = scan_state_type::create(ptr, number_of_blocks);
+    ptr += scan_state_bytes;
+    auto ordered_bid = ordered_block_id_type::create(
+        reinterpret_cast<ordered_block_id_type::id_type *>(ptr)
     );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("fill_unique_counts", size, start)
 
+    // Padding of look-back state must be initialized too
+    const unsigned int init_size = ::rocprim::max(number_of_blocks, ::rocprim::warp_size());
     if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
     hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(scan_unique_counts_kernel<scan_block_size, scan_items_per_thread>),
-        dim3(1), dim3(scan_block_size), 0, stream,
-        unique_counts, unique_count_output,
-        batches
+        HIP_KERNEL_NAME(init_lookback_scan_state_kernel<scan_state_type>),
+        dim3(::rocprim::detail::ceiling_div(init_size, block_size)), dim3(block_size), 0, stream,
+        scan_state, number_of_blocks, ordered_bid
     );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("scan_unique_counts", scan_block_size, start)
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state_kernel", number_of_blocks, start)
 
     if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
     hipLaunchKernelGGL(
         HIP_KERNEL_NAME(reduce_by_key_kernel<block_size, items_per_thread>),
-        dim3(batches), dim3(block_size), 0, stream,
+        dim3(number_of_blocks), dim3(block_size), 0, stream,
         keys_input, values_input, size,
-        const_cast<const unsigned int *>(unique_counts), carry_outs,
-        unique_output, aggregates_output,
+        unique_output, aggregates_output, unique_count_output,
         key_compare_op, reduce_op,
-        blocks_per_full_batch, full_batches, blocks
+        scan_state, number_of_blocks, ordered_bid
     );
     ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("reduce_by_key", size, start)
 
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(scan_and_scatter_carry_outs_kernel<scan_block_size, scan_items_per_thread>),
-        dim3(1), dim3(scan_block_size), 0, stream,
-        const_cast<const carry_out_type *>(carry_outs),
-        aggregates_output,
-        key_compare_op, reduce_op,
-        batches
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("scan_and_scatter_carry_outs", scan_block_size, start)
-
     return hipSuccess;
 }
 
@@ -284,6 +226,8 @@ hipError_t reduce_by_key_impl(void * temporary_storage,
 /// * Ranges specified by \p unique_output and \p aggregates_output must have at least
 /// <tt>*unique_count_output</tt> (i.e. the number of unique keys) elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p reduce_by_key_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam ValuesInputIterator - random-access iterator type of the input range. Must meet the
@@ -366,6 +310,7 @@ hipError_t reduce_by_key_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class ValuesInputIterator,
     class UniqueOutputIterator,
@@ -388,7 +333,7 @@ hipError_t reduce_by_key(void * temporary_storage,
                          hipStream_t stream = 0,
                          bool debug_synchronous = false)
 {
-    return detail::reduce_by_key_impl(
+    return detail::reduce_by_key_impl<Config>(
         temporary_storage, storage_size,
         keys_input, values_input, size,
         unique_output, aggregates_output, unique_count_output,
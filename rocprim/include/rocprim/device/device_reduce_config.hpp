@@ -0,0 +1,111 @@
+// Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_REDUCE_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_REDUCE_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup devicemodule_configs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level segmented reduction in the load-balanced mode.
+///
+/// By default every segment is reduced by one block. In the load-balanced mode segments
+/// are reduced by different kernels depending on their sizes: segments of at most
+/// \p SmallSegmentSize items are reduced by a logical warp of \p WarpReduceSize threads each,
+/// longer segments are split into tiles of <tt>BlockSize * ItemsPerThread</tt> items, which
+/// are evenly distributed among blocks, and partial results of segments spanning several
+/// blocks are combined by an additional kernel.
+///
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam ItemsPerThread - number of items processed by each thread.
+/// \tparam WarpReduceSize - size of logical warps reducing small segments. Must be a power
+/// of two not greater than the hardware warp size.
+/// \tparam SmallSegmentSize - size of the largest segment reduced by a logical warp.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int WarpReduceSize = 32,
+    unsigned int SmallSegmentSize = 256
+>
+struct segmented_reduce_config : kernel_config<BlockSize, ItemsPerThread>
+{
+    /// \brief Size of logical warps reducing small segments.
+    static constexpr unsigned int warp_reduce_size = WarpReduceSize;
+    /// \brief Size of the largest segment reduced by a logical warp.
+    static constexpr unsigned int small_segment_size = SmallSegmentSize;
+};
+
+namespace detail
+{
+
+// Default configuration of reduce and segmented reduce for values
+// of type Value
+template<class Value>
+struct default_reduce_config
+    : scaled_kernel_config<256, 4, Value>
+{
+
+};
+
+template<class Value>
+struct default_segmented_reduce_config
+    : scaled_kernel_config<256, 8, Value>
+{
+
+};
+
+// Segmented reduction is load-balanced when Config has size classes of segments
+// (e.g. segmented_reduce_config), otherwise every segment is reduced by one block
+template<class Config, class Enable = void>
+struct segmented_reduce_load_balancing
+{
+    static constexpr bool enabled = false;
+    static constexpr unsigned int warp_reduce_size = 1;
+    static constexpr unsigned int small_segment_size = 0;
+};
+
+template<class Config>
+struct segmented_reduce_load_balancing<
+    Config,
+    typename std::enable_if<(sizeof(Config::warp_reduce_size) + sizeof(Config::small_segment_size) > 0)>::type
+>
+{
+    static constexpr bool enabled = true;
+    static constexpr unsigned int warp_reduce_size = Config::warp_reduce_size;
+    static constexpr unsigned int small_segment_size = Config::small_segment_size;
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule_configs
+
+#endif // ROCPRIM_DEVICE_DEVICE_REDUCE_CONFIG_HPP_
@@ -27,7 +27,9 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 
+#include "device_reduce_config.hpp"
 #include "detail/device_reduce.hpp"
+#include "detail/device_host_fallback.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -50,9 +52,8 @@ namespace detail
     }
 
 template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
     bool WithInitialValue, // true when inital_value should be used in reduction
+    class Config,
     class InputIterator,
     class OutputIterator,
     class InitValueType,
@@ -76,8 +77,18 @@ void reduce_impl(void * temporary_storage,
     using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
     #endif
 
-    constexpr unsigned int block_size = BlockSize;
-    constexpr unsigned int items_per_thread = ItemsPerThread;
+    // Small problems with host-accessible data may be processed on the host
+    using host_fallback = detail::host_fallback_traits<Config>;
+    using host_fallback_enabled = std::integral_constant<bool, (host_fallback::max_size > 0)>;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        typename host_fallback::config,
+        default_reduce_config<result_type>
+    >;
+
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
     constexpr auto items_per_block = block_size * items_per_thread;
 
     // Calculate required temporary storage
@@ -93,6 +104,24 @@ void reduce_impl(void * temporary_storage,
     // Start point for time measurements
     std::chrono::high_resolution_clock::time_point start;
 
+    if(detail::use_host_fallback(host_fallback_enabled(), host_fallback::max_size, size, input, output))
+    {
+        // Results of preceding operations in the accelerator view must be visible on the host
+        acc_view.wait();
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        host_reduce<WithInitialValue>(
+            host_fallback_enabled(),
+            input, output, size, static_cast<result_type>(initial_value), reduce_op
+        );
+        if(debug_synchronous)
+        {
+            auto end = std::chrono::high_resolution_clock::now();
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+            std::cout << "host_reduce(" << size << ") " << d.count() * 1000 << " ms" << '\n';
+        }
+        return;
+    }
+
     auto number_of_blocks = (size + items_per_block - 1)/items_per_block;
     if(debug_synchronous)
     {
@@ -127,7 +156,7 @@ void reduce_impl(void * temporary_storage,
         auto nested_temp_storage_size = storage_size - (number_of_blocks * sizeof(result_type));
 
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-        reduce_impl<BlockSize, ItemsPerThread, WithInitialValue>(
+        reduce_impl<WithInitialValue, typename host_fallback::config>(
             nested_temp_storage,
             nested_temp_storage_size,
             block_prefixes, // input
@@ -176,6 +205,10 @@ void reduce_impl(void * temporary_storage,
 /// * Ranges specified by \p input must have at least \p size elements, while \p output
 /// only needs one element.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small reductions
+/// of host-accessible pointers are performed on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -246,6 +279,7 @@ void reduce_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class InitValueType,
@@ -262,10 +296,7 @@ void reduce(void * temporary_storage,
             hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
             bool debug_synchronous = false)
 {
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
-    return detail::reduce_impl<block_size, items_per_thread, true>(
+    return detail::reduce_impl<true, Config>(
         temporary_storage, storage_size,
         input, output, initial_value, size,
         reduce_op, acc_view, debug_synchronous
@@ -286,6 +317,10 @@ void reduce(void * temporary_storage,
 /// * Ranges specified by \p input must have at least \p size elements, while \p output
 /// only needs one element.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small reductions
+/// of host-accessible pointers are performed on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -346,6 +381,7 @@ void reduce(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>
@@ -360,10 +396,7 @@ void reduce(void * temporary_storage,
             hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
             bool debug_synchronous = false)
 {
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
-    return detail::reduce_impl<block_size, items_per_thread, false>(
+    return detail::reduce_impl<false, Config>(
         temporary_storage, storage_size,
         input, output, char(0), size,
         reduce_op, acc_view, debug_synchronous
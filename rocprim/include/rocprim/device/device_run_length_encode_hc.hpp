@@ -32,6 +32,7 @@
 #include "../iterator/discard_iterator.hpp"
 #include "../iterator/zip_iterator.hpp"
 
+#include "device_run_length_encode_config.hpp"
 #include "device_reduce_by_key_hc.hpp"
 #include "device_select_hc.hpp"
 
@@ -72,6 +73,8 @@ namespace detail
 /// * Ranges specified by \p unique_output and \p counts_output must have at least
 /// <tt>*runs_count_output</tt> (i.e. the number of runs) elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p run_length_encode_config or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam UniqueOutputIterator - random-access iterator type of the output range. Must meet the
@@ -139,6 +142,7 @@ namespace detail
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class UniqueOutputIterator,
     class CountsOutputIterator,
@@ -156,9 +160,15 @@ void run_length_encode(void * temporary_storage,
                        bool debug_synchronous = false)
 {
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    // Get default config if Config is default_config
+    using config = detail::default_or_custom_config<
+        Config,
+        detail::default_run_length_encode_config
+    >;
     using count_type = unsigned int;
 
-    ::rocprim::reduce_by_key(
+    ::rocprim::reduce_by_key<typename config::reduce_by_key>(
         temporary_storage, storage_size,
         input, make_constant_iterator<count_type>(1), size,
         unique_output, counts_output, runs_count_output,
@@ -183,6 +193,8 @@ void run_length_encode(void * temporary_storage,
 /// * Ranges specified by \p offsets_output and \p counts_output must have at least
 /// <tt>*runs_count_output</tt> (i.e. the number of non-trivial runs) elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p run_length_encode_config or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OffsetsOutputIterator - random-access iterator type of the output range. Must meet the
@@ -250,6 +262,7 @@ void run_length_encode(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OffsetsOutputIterator,
     class CountsOutputIterator,
@@ -267,6 +280,12 @@ void run_length_encode_non_trivial_runs(void * temporary_storage,
                                         bool debug_synchronous = false)
 {
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    // Get default config if Config is default_config
+    using config = detail::default_or_custom_config<
+        Config,
+        detail::default_run_length_encode_config
+    >;
     using offset_type = unsigned int;
     using count_type = unsigned int;
     using offset_count_pair = typename ::rocprim::tuple<offset_type, count_type>;
@@ -289,7 +308,7 @@ void run_length_encode_non_trivial_runs(void * temporary_storage,
 
     // Calculate size of temporary storage for reduce_by_key operation
     size_t reduce_by_key_bytes;
-    ::rocprim::reduce_by_key(
+    ::rocprim::reduce_by_key<typename config::reduce_by_key>(
         nullptr, reduce_by_key_bytes,
         input,
         ::rocprim::make_zip_iterator(
@@ -309,7 +328,7 @@ void run_length_encode_non_trivial_runs(void * temporary_storage,
 
     // Calculate size of temporary storage for select operation
     size_t select_bytes;
-    ::rocprim::select(
+    ::rocprim::select<typename config::select>(
         nullptr, select_bytes,
         ::rocprim::make_zip_iterator(::rocprim::make_tuple(offsets_tmp, counts_tmp)),
         ::rocprim::make_zip_iterator(::rocprim::make_tuple(offsets_output, counts_output)),
@@ -341,7 +360,7 @@ void run_length_encode_non_trivial_runs(void * temporary_storage,
     std::chrono::high_resolution_clock::time_point start;
 
     if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    ::rocprim::reduce_by_key(
+    ::rocprim::reduce_by_key<typename config::reduce_by_key>(
         temporary_storage, reduce_by_key_bytes,
         input,
         ::rocprim::make_zip_iterator(
@@ -366,7 +385,7 @@ void run_length_encode_non_trivial_runs(void * temporary_storage,
 
     // Select non-trivial runs
     if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    ::rocprim::select(
+    ::rocprim::select<typename config::select>(
         temporary_storage, select_bytes,
         ::rocprim::make_zip_iterator(::rocprim::make_tuple(offsets_tmp, counts_tmp)),
         ::rocprim::make_zip_iterator(::rocprim::make_tuple(offsets_output, counts_output)),
@@ -54,6 +54,8 @@ BEGIN_ROCPRIM_NAMESPACE
 /// * Ranges specified by \p keys_input, \p values_input, and \p values_output must have
 /// at least \p size elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. It can be
 /// a simple pointer type.
 /// \tparam ValuesInputIterator - random-access iterator type of the input range. It can be
@@ -129,6 +131,7 @@ BEGIN_ROCPRIM_NAMESPACE
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class ValuesInputIterator,
     class ValuesOutputIterator,
@@ -153,7 +156,7 @@ hipError_t inclusive_scan_by_key(void * temporary_storage,
         input_type, key_type, BinaryFunction, KeyCompareFunction
     >;
 
-    return inclusive_scan(
+    return inclusive_scan<Config>(
         temporary_storage, storage_size,
         make_zip_iterator(
             make_tuple(values_input, keys_input)
@@ -182,6 +185,8 @@ hipError_t inclusive_scan_by_key(void * temporary_storage,
 /// * Ranges specified by \p keys_input, \p values_input, and \p values_output must have
 /// at least \p size elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. It can be
 /// a simple pointer type.
 /// \tparam ValuesInputIterator - random-access iterator type of the input range. It can be
@@ -260,6 +265,7 @@ hipError_t inclusive_scan_by_key(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class ValuesInputIterator,
     class ValuesOutputIterator,
@@ -286,7 +292,7 @@ hipError_t exclusive_scan_by_key(void * temporary_storage,
         input_type, key_type, BinaryFunction, KeyCompareFunction
     >;
 
-    return inclusive_scan(
+    return inclusive_scan<Config>(
         temporary_storage, storage_size,
         make_transform_iterator(
             make_zip_iterator(
@@ -0,0 +1,113 @@
+// Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SCAN_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SCAN_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup devicemodule_configs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level segmented scan in the load-balanced mode.
+///
+/// By default every segment is scanned by one block. In the load-balanced mode segments
+/// of at most \p SmallSegmentSize items are scanned by a logical warp of \p WarpScanSize
+/// threads each, so many short segments are packed into one block. Longer segments are split
+/// into tiles of <tt>BlockSize * ItemsPerThread</tt> items, which are evenly distributed
+/// among blocks; segments spanning several blocks are reduced first, and the reductions
+/// are used as carries by the next blocks. Items are reduced in their order, so like in
+/// the one-block-per-segment mode the scan operator must be associative, but it is not
+/// required to be commutative.
+///
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam ItemsPerThread - number of items processed by each thread.
+/// \tparam WarpScanSize - size of logical warps scanning small segments. Must be a power
+/// of two not greater than the hardware warp size.
+/// \tparam SmallSegmentSize - size of the largest segment scanned by a logical warp.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int WarpScanSize = 32,
+    unsigned int SmallSegmentSize = 256
+>
+struct segmented_scan_config : kernel_config<BlockSize, ItemsPerThread>
+{
+    /// \brief Size of logical warps scanning small segments.
+    static constexpr unsigned int warp_scan_size = WarpScanSize;
+    /// \brief Size of the largest segment scanned by a logical warp.
+    static constexpr unsigned int small_segment_size = SmallSegmentSize;
+};
+
+namespace detail
+{
+
+// Default configuration of scan and segmented scan for values
+// of type Value
+template<class Value>
+struct default_scan_config
+    : scaled_kernel_config<256, 4, Value>
+{
+
+};
+
+template<class Value>
+struct default_segmented_scan_config
+    : scaled_kernel_config<256, 8, Value>
+{
+
+};
+
+// Segmented scan is load-balanced when Config has size classes of segments
+// (e.g. segmented_scan_config), otherwise every segment is scanned by one block
+template<class Config, class Enable = void>
+struct segmented_scan_load_balancing
+{
+    static constexpr bool enabled = false;
+    static constexpr unsigned int warp_scan_size = 1;
+    static constexpr unsigned int small_segment_size = 0;
+};
+
+template<class Config>
+struct segmented_scan_load_balancing<
+    Config,
+    typename std::enable_if<(sizeof(Config::warp_scan_size) + sizeof(Config::small_segment_size) > 0)>::type
+>
+{
+    static constexpr bool enabled = true;
+    static constexpr unsigned int warp_scan_size = Config::warp_scan_size;
+    static constexpr unsigned int small_segment_size = Config::small_segment_size;
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule_configs
+
+#endif // ROCPRIM_DEVICE_DEVICE_SCAN_CONFIG_HPP_
@@ -0,0 +1,313 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SCAN_CPU_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SCAN_CPU_HPP_
+
+#include <type_traits>
+#include <iterator>
+#include <chrono>
+#include <iostream>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../functional.hpp"
+
+#include "config_types.hpp"
+#include "cpu_types.hpp"
+#include "detail/cpu_thread_pool.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_cpu
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_CPU_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+// Scans [begin, end) starting with prefix (the first item is the prefix itself
+// for inclusive scan of the first block)
+template<
+    bool Exclusive,
+    class InputIterator,
+    class OutputIterator,
+    class ResultType,
+    class BinaryFunction
+>
+inline
+void cpu_scan_block(InputIterator input,
+                    OutputIterator output,
+                    size_t begin,
+                    const size_t end,
+                    ResultType prefix,
+                    const bool has_prefix,
+                    BinaryFunction scan_op)
+{
+    if(!has_prefix)
+    {
+        prefix = static_cast<ResultType>(input[begin]);
+        output[begin] = prefix;
+        begin++;
+    }
+    for(size_t i = begin; i < end; i++)
+    {
+        // Input is read before output is written, so scan can be in-place
+        const ResultType next = scan_op(prefix, input[i]);
+        output[i] = Exclusive ? prefix : next;
+        prefix = next;
+    }
+}
+
+template<
+    bool Exclusive,
+    class InputIterator,
+    class OutputIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+error_t scan_impl(void * temporary_storage,
+                  size_t& storage_size,
+                  InputIterator input,
+                  OutputIterator output,
+                  const InitValueType initial_value,
+                  const size_t size,
+                  BinaryFunction scan_op,
+                  stream_t /* stream */,
+                  bool debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<BinaryFunction, input_type, input_type>::type;
+    #else
+    using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
+    #endif
+
+    const cpu_partition partition(size);
+
+    // Calculate required temporary storage
+    if(temporary_storage == nullptr)
+    {
+        storage_size = ::rocprim::detail::align_size(partition.blocks * sizeof(result_type));
+        // Make sure user won't try to allocate 0 bytes memory
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return success;
+    }
+
+    if(size == 0) return success;
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        std::cout << "threads " << get_cpu_thread_pool().size() << '\n';
+        std::cout << "blocks " << partition.blocks << '\n';
+        std::cout << "block_size " << partition.block_size << '\n';
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    // Reduce all blocks except the last one
+    result_type * prefixes = reinterpret_cast<result_type *>(temporary_storage);
+    cpu_parallel_for(
+        partition.blocks - 1,
+        [&](size_t block)
+        {
+            const size_t begin = partition.begin(block);
+            result_type value = static_cast<result_type>(input[begin]);
+            for(size_t i = begin + 1; i < partition.end(block); i++)
+            {
+                value = scan_op(value, input[i]);
+            }
+            prefixes[block] = value;
+        }
+    );
+
+    // Exclusive prefixes of blocks, the first block of inclusive scan has no prefix
+    result_type prefix = static_cast<result_type>(initial_value);
+    for(size_t block = 0; block + 1 < partition.blocks; block++)
+    {
+        const result_type reduction = prefixes[block];
+        prefixes[block] = prefix;
+        prefix = (Exclusive || block > 0) ? scan_op(prefix, reduction) : reduction;
+    }
+    prefixes[partition.blocks - 1] = prefix;
+
+    cpu_parallel_for(
+        partition.blocks,
+        [&](size_t block)
+        {
+            cpu_scan_block<Exclusive>(
+                input, output,
+                partition.begin(block), partition.end(block),
+                prefixes[block], Exclusive || block > 0,
+                scan_op
+            );
+        }
+    );
+    ROCPRIM_DETAIL_CPU_SYNC("scan", size, start)
+    return success;
+}
+
+#undef ROCPRIM_DETAIL_CPU_SYNC
+
+} // end of detail namespace
+
+/// \brief CPU parallel inclusive scan primitive for device level.
+///
+/// inclusive_scan function performs a device-wide inclusive prefix scan operation
+/// using binary \p scan_op operator on host threads.
+///
+/// \par Overview
+/// * Supports non-commutative scan operators. However, a scan operator should be
+/// associative.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input and \p output must have at least \p size elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend, it is accepted so the same
+/// code can be compiled for HIP, HC and CPU.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of \p InputIterator.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to scan.
+/// \param [out] output - iterator to the first element in the output range. It can be
+/// same as \p input.
+/// \param [in] size - number of element in the input range.
+/// \param [in] scan_op - binary operation function object that will be used for scan.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>
+>
+inline
+error_t inclusive_scan(void * temporary_storage,
+                       size_t& storage_size,
+                       InputIterator input,
+                       OutputIterator output,
+                       const size_t size,
+                       BinaryFunction scan_op = BinaryFunction(),
+                       const stream_t stream = 0,
+                       const bool debug_synchronous = false)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<BinaryFunction, input_type, input_type>::type;
+    #else
+    using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
+    #endif
+
+    return detail::scan_impl<false>(
+        temporary_storage, storage_size,
+        // result_type() is a dummy initial value (not used)
+        input, output, result_type(), size,
+        scan_op, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel exclusive scan primitive for device level.
+///
+/// exclusive_scan function performs a device-wide exclusive prefix scan operation
+/// using binary \p scan_op operator on host threads.
+///
+/// \par Overview
+/// * Supports non-commutative scan operators. However, a scan operator should be
+/// associative.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input and \p output must have at least \p size elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam InitValueType - type of the initial value.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of \p InputIterator.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to scan.
+/// \param [out] output - iterator to the first element in the output range. It can be
+/// same as \p input.
+/// \param [in] initial_value - initial value to start the scan.
+/// \param [in] size - number of element in the input range.
+/// \param [in] scan_op - binary operation function object that will be used for scan.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class InitValueType,
+    class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>
+>
+inline
+error_t exclusive_scan(void * temporary_storage,
+                       size_t& storage_size,
+                       InputIterator input,
+                       OutputIterator output,
+                       const InitValueType initial_value,
+                       const size_t size,
+                       BinaryFunction scan_op = BinaryFunction(),
+                       const stream_t stream = 0,
+                       const bool debug_synchronous = false)
+{
+    return detail::scan_impl<true>(
+        temporary_storage, storage_size,
+        input, output, initial_value, size,
+        scan_op, stream, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule_cpu
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_SCAN_CPU_HPP_
@@ -27,7 +27,10 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 
+#include "device_scan_config.hpp"
 #include "detail/device_scan_reduce_then_scan.hpp"
+#include "detail/device_scan_lookback.hpp"
+#include "detail/device_host_fallback.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -50,9 +53,8 @@ namespace detail
     }
 
 template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
     bool Exclusive,
+    class Config,
     class InputIterator,
     class OutputIterator,
     class InitValueType,
@@ -76,14 +78,28 @@ void scan_impl(void * temporary_storage,
     using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
     #endif
 
-    constexpr unsigned int block_size = BlockSize;
-    constexpr unsigned int items_per_thread = ItemsPerThread;
+    using scan_state_type = detail::lookback_scan_state<result_type>;
+    using ordered_block_id_type = detail::ordered_block_id<unsigned int>;
+
+    // Small problems with host-accessible data may be processed on the host
+    using host_fallback = detail::host_fallback_traits<Config>;
+    using host_fallback_enabled = std::integral_constant<bool, (host_fallback::max_size > 0)>;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        typename host_fallback::config,
+        default_scan_config<result_type>
+    >;
+
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
     constexpr auto items_per_block = block_size * items_per_thread;
+    const unsigned int number_of_blocks = (size + items_per_block - 1)/items_per_block;
 
     // Calculate required temporary storage
     if(temporary_storage == nullptr)
     {
-        storage_size = scan_get_temporary_storage_bytes<result_type>(size, items_per_block);
+        storage_size = lookback_scan_get_temporary_storage_bytes<scan_state_type>(number_of_blocks);
         // Make sure user won't try to allocate 0 bytes memory, otherwise
         // user may again pass nullptr as temporary_storage
         storage_size = storage_size == 0 ? 4 : storage_size;
@@ -93,7 +109,24 @@ void scan_impl(void * temporary_storage,
     // Start point for time measurements
     std::chrono::high_resolution_clock::time_point start;
 
-    auto number_of_blocks = (size + items_per_block - 1)/items_per_block;
+    if(detail::use_host_fallback(host_fallback_enabled(), host_fallback::max_size, size, input, output))
+    {
+        // Results of preceding operations in the accelerator view must be visible on the host
+        acc_view.wait();
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        host_scan<Exclusive>(
+            host_fallback_enabled(),
+            input, output, size, static_cast<result_type>(initial_value), scan_op
+        );
+        if(debug_synchronous)
+        {
+            auto end = std::chrono::high_resolution_clock::now();
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+            std::cout << "host_scan(" << size << ") " << d.count() * 1000 << " ms" << '\n';
+        }
+        return;
+    }
+
     if(debug_synchronous)
     {
         std::cout << "block_size " << block_size << '\n';
@@ -104,47 +137,32 @@ void scan_impl(void * temporary_storage,
 
     if(number_of_blocks > 1)
     {
-        // Pointer to array with block_prefixes
-        result_type * block_prefixes = static_cast<result_type*>(temporary_storage);
+        // Create and initialize lookback_scan_state obj
+        auto scan_state = scan_state_type::create(temporary_storage, number_of_blocks);
+        // Create and initialize ordered_block_id obj
+        auto ptr = reinterpret_cast<char*>(temporary_storage);
+        auto ordered_bid = ordered_block_id_type::create(
+            reinterpret_cast<ordered_block_id_type::id_type*>(
+                ptr + ::rocprim::detail::align_size(scan_state_type::get_storage_size(number_of_blocks))
+            )
+        );
 
-        // Grid size for block_reduce_kernel, we don't need to calculate reduction
-        // of the last block as it will never be used as prefix for other blocks
-        auto grid_size = (number_of_blocks - 1) * block_size;
+        // Padding of look-back state must be initialized too
+        const unsigned int init_size = ::rocprim::max(number_of_blocks, ::rocprim::warp_size());
+        auto grid_size = ((init_size + block_size - 1)/block_size) * block_size;
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hc::parallel_for_each(
             acc_view,
             hc::tiled_extent<1>(grid_size, block_size),
             [=](hc::tiled_index<1>) [[hc]]
             {
-                block_reduce_kernel_impl<block_size, items_per_thread>(
-                    input, scan_op, block_prefixes
+                init_lookback_scan_state_kernel_impl(
+                    scan_state, number_of_blocks, ordered_bid
                 );
             }
         );
-        ROCPRIM_DETAIL_HC_SYNC("block_reduce_kernel", size, start)
-
-        // TODO: Performance may increase if for (number_of_blocks < 8192) (or some other
-        // threshold) we would just use CPU to calculate prefixes.
-
-        // Calculate size of temporary storage for nested device scan operation
-        void * nested_temp_storage = static_cast<void*>(block_prefixes + number_of_blocks);
-        auto nested_temp_storage_size = storage_size - (number_of_blocks * sizeof(result_type));
-
-        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-        scan_impl<BlockSize, ItemsPerThread, false>(
-            nested_temp_storage,
-            nested_temp_storage_size,
-            block_prefixes, // input
-            block_prefixes, // output
-            result_type(), // dummy initial value
-            number_of_blocks, // size
-            scan_op,
-            acc_view,
-            debug_synchronous
-        );
-        ROCPRIM_DETAIL_HC_SYNC("nested_device_scan", number_of_blocks, start)
+        ROCPRIM_DETAIL_HC_SYNC("init_lookback_scan_state_kernel", number_of_blocks, start)
 
-        // Grid size for final_scan_kernel
         grid_size = number_of_blocks * block_size;
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hc::parallel_for_each(
@@ -152,18 +170,18 @@ void scan_impl(void * temporary_storage,
             hc::tiled_extent<1>(grid_size, block_size),
             [=](hc::tiled_index<1>) [[hc]]
             {
-                final_scan_kernel_impl<block_size, items_per_thread, Exclusive>(
-                    input, size, output, static_cast<result_type>(initial_value),
-                    scan_op, block_prefixes
+                lookback_scan_kernel_impl<block_size, items_per_thread, Exclusive>(
+                    input, output, size, static_cast<result_type>(initial_value),
+                    scan_op, scan_state, number_of_blocks, ordered_bid
                 );
             }
         );
-        ROCPRIM_DETAIL_HC_SYNC("final_scan_kernel", size, start)
+        ROCPRIM_DETAIL_HC_SYNC("lookback_scan_kernel", size, start)
     }
     else
     {
-        constexpr unsigned int single_scan_bs = BlockSize;
-        constexpr unsigned int single_scan_ipt = ItemsPerThread;
+        constexpr unsigned int single_scan_bs = block_size;
+        constexpr unsigned int single_scan_ipt = items_per_thread;
 
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hc::parallel_for_each(
@@ -197,6 +215,10 @@ void scan_impl(void * temporary_storage,
 /// if \p temporary_storage in a null pointer.
 /// * Ranges specified by \p input and \p output must have at least \p size elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small scans
+/// of host-accessible pointers are performed on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -257,6 +279,7 @@ void scan_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>
@@ -278,10 +301,7 @@ void inclusive_scan(void * temporary_storage,
     using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
     #endif
 
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
-    return detail::scan_impl<block_size, items_per_thread, false>(
+    return detail::scan_impl<false, Config>(
         temporary_storage, storage_size,
         // result_type() is a dummy initial value (not used)
         input, output, result_type(), size,
@@ -302,6 +322,10 @@ void inclusive_scan(void * temporary_storage,
 /// if \p temporary_storage in a null pointer.
 /// * Ranges specified by \p input and \p output must have at least \p size elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small scans
+/// of host-accessible pointers are performed on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -372,6 +396,7 @@ void inclusive_scan(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class InitValueType,
@@ -388,10 +413,7 @@ void exclusive_scan(void * temporary_storage,
                     hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                     const bool debug_synchronous = false)
 {
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
-    return detail::scan_impl<block_size, items_per_thread, true>(
+    return detail::scan_impl<true, Config>(
         temporary_storage, storage_size,
         input, output, initial_value, size,
         scan_op, acc_view, debug_synchronous
@@ -27,7 +27,10 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 
+#include "device_scan_config.hpp"
 #include "detail/device_scan_reduce_then_scan.hpp"
+#include "detail/device_scan_lookback.hpp"
+#include "detail/device_host_fallback.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -58,22 +61,14 @@ void single_scan_kernel(InputIterator input,
     );
 }
 
-// Calculates block prefixes that will be used in final_scan_kernel
-// when performing block scan operations.
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class InputIterator,
-    class BinaryFunction,
-    class ResultType
->
+template<class LookbackScanState>
 __global__
-void block_reduce_kernel(InputIterator input,
-                         BinaryFunction scan_op,
-                         ResultType * block_prefixes)
+void init_lookback_scan_state_kernel(LookbackScanState lookback_scan_state,
+                                     const unsigned int number_of_blocks,
+                                     ordered_block_id<unsigned int> ordered_bid)
 {
-    block_reduce_kernel_impl<BlockSize, ItemsPerThread>(
-        input, scan_op, block_prefixes
+    init_lookback_scan_state_kernel_impl(
+        lookback_scan_state, number_of_blocks, ordered_bid
     );
 }
 
@@ -84,18 +79,22 @@ template<
     class InputIterator,
     class OutputIterator,
     class BinaryFunction,
-    class ResultType
+    class ResultType,
+    class LookbackScanState
 >
 __global__
-void final_scan_kernel(InputIterator input,
-                       const size_t size,
-                       OutputIterator output,
-                       const ResultType initial_value,
-                       BinaryFunction scan_op,
-                       ResultType * block_prefixes)
+void lookback_scan_kernel(InputIterator input,
+                          OutputIterator output,
+                          const size_t size,
+                          ResultType initial_value,
+                          BinaryFunction scan_op,
+                          LookbackScanState lookback_scan_state,
+                          const unsigned int number_of_blocks,
+                          ordered_block_id<unsigned int> ordered_bid)
 {
-    final_scan_kernel_impl<BlockSize, ItemsPerThread, Exclusive>(
-        input, size, output, initial_value, scan_op, block_prefixes
+    lookback_scan_kernel_impl<BlockSize, ItemsPerThread, Exclusive>(
+        input, output, size, initial_value, scan_op,
+        lookback_scan_state, number_of_blocks, ordered_bid
     );
 }
 
@@ -126,9 +125,8 @@ void final_scan_kernel(InputIterator input,
     }
 
 template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
     bool Exclusive,
+    class Config,
     class InputIterator,
     class OutputIterator,
     class InitValueType,
@@ -152,14 +150,28 @@ hipError_t scan_impl(void * temporary_storage,
     using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
     #endif
 
-    constexpr unsigned int block_size = BlockSize;
-    constexpr unsigned int items_per_thread = ItemsPerThread;
+    using scan_state_type = detail::lookback_scan_state<result_type>;
+    using ordered_block_id_type = detail::ordered_block_id<unsigned int>;
+
+    // Small problems with host-accessible data may be processed on the host
+    using host_fallback = detail::host_fallback_traits<Config>;
+    using host_fallback_enabled = std::integral_constant<bool, (host_fallback::max_size > 0)>;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        typename host_fallback::config,
+        default_scan_config<result_type>
+    >;
+
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
     constexpr auto items_per_block = block_size * items_per_thread;
+    const unsigned int number_of_blocks = (size + items_per_block - 1)/items_per_block;
 
     // Calculate required temporary storage
     if(temporary_storage == nullptr)
     {
-        storage_size = scan_get_temporary_storage_bytes<result_type>(size, items_per_block);
+        storage_size = lookback_scan_get_temporary_storage_bytes<scan_state_type>(number_of_blocks);
         // Make sure user won't try to allocate 0 bytes memory, because
         // hipMalloc will return nullptr when size is zero.
         storage_size = storage_size == 0 ? 4 : storage_size;
@@ -169,7 +181,25 @@ hipError_t scan_impl(void * temporary_storage,
     // Start point for time measurements
     std::chrono::high_resolution_clock::time_point start;
 
-    auto number_of_blocks = (size + items_per_block - 1)/items_per_block;
+    if(detail::use_host_fallback(host_fallback_enabled(), host_fallback::max_size, size, input, output))
+    {
+        // Results of preceding operations in the stream must be visible on the host
+        auto error = hipStreamSynchronize(stream);
+        if(error != hipSuccess) return error;
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        host_scan<Exclusive>(
+            host_fallback_enabled(),
+            input, output, size, static_cast<result_type>(initial_value), scan_op
+        );
+        if(debug_synchronous)
+        {
+            auto end = std::chrono::high_resolution_clock::now();
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+            std::cout << "host_scan(" << size << ") " << d.count() * 1000 << " ms" << '\n';
+        }
+        return hipSuccess;
+    }
+
     if(debug_synchronous)
     {
         std::cout << "block_size " << block_size << '\n';
@@ -179,69 +209,46 @@ hipError_t scan_impl(void * temporary_storage,
 
     if(number_of_blocks > 1)
     {
-        // Pointer to array with block_prefixes
-        result_type * block_prefixes = static_cast<result_type*>(temporary_storage);
+        // Create and initialize lookback_scan_state obj
+        auto scan_state = scan_state_type::create(temporary_storage, number_of_blocks);
+        // Create and initialize ordered_block_id obj
+        auto ptr = reinterpret_cast<char*>(temporary_storage);
+        auto ordered_bid = ordered_block_id_type::create(
+            reinterpret_cast<ordered_block_id_type::id_type*>(
+                ptr + ::rocprim::detail::align_size(scan_state_type::get_storage_size(number_of_blocks))
+            )
+        );
 
-        // Grid size for block_reduce_kernel, we don't need to calculate reduction
-        // of the last block as it will never be used as prefix for other blocks
-        auto grid_size = number_of_blocks - 1;
+        // Padding of look-back state must be initialized too
+        const unsigned int init_size = ::rocprim::max(number_of_blocks, ::rocprim::warp_size());
+        auto grid_size = (init_size + block_size - 1)/block_size;
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hipLaunchKernelGGL(
-            HIP_KERNEL_NAME(detail::block_reduce_kernel<
-                block_size, items_per_thread,
-                InputIterator, BinaryFunction, result_type
-            >),
+            HIP_KERNEL_NAME(init_lookback_scan_state_kernel<scan_state_type>),
             dim3(grid_size), dim3(block_size), 0, stream,
-            input, scan_op, block_prefixes
+            scan_state, number_of_blocks, ordered_bid
         );
-        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("block_reduce_kernel", size, start)
-
-        // TODO: Performance may increase if for (number_of_blocks < 8192) (or some other
-        // threshold) we would just use CPU to calculate prefixes.
-
-        // Calculate size of temporary storage for nested device scan operation
-        void * nested_temp_storage = static_cast<void*>(block_prefixes + number_of_blocks);
-        auto nested_temp_storage_size = storage_size - (number_of_blocks * sizeof(result_type));
-
-        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-        auto error = scan_impl<BlockSize, ItemsPerThread, false>(
-            nested_temp_storage,
-            nested_temp_storage_size,
-            block_prefixes, // input
-            block_prefixes, // output
-            result_type(), // dummy initial value
-            number_of_blocks, // input size
-            scan_op,
-            stream,
-            debug_synchronous
-        );
-        if(error != hipSuccess) return error;
-        ROCPRIM_DETAIL_HIP_SYNC("nested_device_scan", number_of_blocks, start);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state_kernel", number_of_blocks, start)
 
-        // Grid size for final_scan_kernel
         grid_size = number_of_blocks;
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hipLaunchKernelGGL(
-            HIP_KERNEL_NAME(detail::final_scan_kernel<
+            HIP_KERNEL_NAME(lookback_scan_kernel<
                 block_size, items_per_thread,
                 Exclusive, // flag for exclusive scan operation
                 InputIterator, OutputIterator,
-                BinaryFunction, result_type
+                BinaryFunction, result_type, scan_state_type
             >),
             dim3(grid_size), dim3(block_size), 0, stream,
-            input,
-            size,
-            output,
-            static_cast<result_type>(initial_value),
-            scan_op,
-            block_prefixes
+            input, output, size, static_cast<result_type>(initial_value),
+            scan_op, scan_state, number_of_blocks, ordered_bid
         );
-        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("final_scan_kernel", size, start);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("lookback_scan_kernel", size, start);
     }
     else
     {
-        constexpr unsigned int single_scan_bs = BlockSize;
-        constexpr unsigned int single_scan_itp = ItemsPerThread;
+        constexpr unsigned int single_scan_bs = block_size;
+        constexpr unsigned int single_scan_itp = items_per_thread;
 
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hipLaunchKernelGGL(
@@ -276,6 +283,10 @@ hipError_t scan_impl(void * temporary_storage,
 /// if \p temporary_storage in a null pointer.
 /// * Ranges specified by \p input and \p output must have at least \p size elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small scans
+/// of host-accessible pointers are performed on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -336,6 +347,7 @@ hipError_t scan_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>
@@ -357,10 +369,7 @@ hipError_t inclusive_scan(void * temporary_storage,
     using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
     #endif
 
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
-    return detail::scan_impl<block_size, items_per_thread, false>(
+    return detail::scan_impl<false, Config>(
         temporary_storage, storage_size,
         // result_type() is a dummy initial value (not used)
         input, output, result_type(), size,
@@ -381,6 +390,10 @@ hipError_t inclusive_scan(void * temporary_storage,
 /// if \p temporary_storage in a null pointer.
 /// * Ranges specified by \p input and \p output must have at least \p size elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small scans
+/// of host-accessible pointers are performed on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -451,6 +464,7 @@ hipError_t inclusive_scan(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class InitValueType,
@@ -467,10 +481,7 @@ hipError_t exclusive_scan(void * temporary_storage,
                           const hipStream_t stream = 0,
                           bool debug_synchronous = false)
 {
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
-    return detail::scan_impl<block_size, items_per_thread, true>(
+    return detail::scan_impl<true, Config>(
         temporary_storage, storage_size,
         input, output, initial_value, size,
         scan_op, stream, debug_synchronous
@@ -0,0 +1,604 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SEGMENTED_RADIX_SORT_CPU_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SEGMENTED_RADIX_SORT_CPU_HPP_
+
+#include <algorithm>
+#include <type_traits>
+#include <iterator>
+#include <chrono>
+#include <iostream>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../detail/radix_sort.hpp"
+#include "../types.hpp"
+
+#include "config_types.hpp"
+#include "cpu_types.hpp"
+#include "device_radix_sort_cpu.hpp"
+#include "detail/cpu_thread_pool.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_cpu
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_CPU_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+// Segments shorter than this are sorted with insertion sort
+constexpr size_t cpu_segmented_radix_sort_small_size = 32;
+// Segments of at least this size are sorted one by one, each by all threads
+constexpr size_t cpu_segmented_radix_sort_large_size = 1 << 16;
+
+// Stable insertion sort of [begin, end) of the output ranges by bits [begin_bit, end_bit)
+template<
+    class Codec,
+    bool WithValues,
+    class KeysIterator,
+    class ValuesIterator
+>
+inline
+void cpu_radix_insertion_sort(KeysIterator keys,
+                              ValuesIterator values,
+                              const size_t begin,
+                              const size_t end,
+                              const unsigned int begin_bit,
+                              const unsigned int end_bit)
+{
+    using key_type = typename std::iterator_traits<KeysIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesIterator>::value_type;
+    using bit_key_type = typename Codec::bit_key_type;
+
+    const unsigned int bits = end_bit - begin_bit;
+    const bit_key_type mask = bits < 8 * sizeof(bit_key_type)
+        ? (bit_key_type(1) << bits) - 1
+        : ~bit_key_type(0);
+    auto sort_key = [&](const key_type& key) -> bit_key_type
+    {
+        return (Codec::encode(key) >> begin_bit) & mask;
+    };
+
+    for(size_t i = begin + 1; i < end; i++)
+    {
+        const key_type key = keys[i];
+        const bit_key_type bit_key = sort_key(key);
+        size_t j = i;
+        if(WithValues)
+        {
+            const value_type value = values[i];
+            for(; j > begin && sort_key(keys[j - 1]) > bit_key; j--)
+            {
+                keys[j] = keys[j - 1];
+                values[j] = values[j - 1];
+            }
+            values[j] = value;
+        }
+        else
+        {
+            for(; j > begin && sort_key(keys[j - 1]) > bit_key; j--)
+            {
+                keys[j] = keys[j - 1];
+            }
+        }
+        keys[j] = key;
+    }
+}
+
+template<
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator
+>
+inline
+error_t segmented_radix_sort_impl(void * temporary_storage,
+                                  size_t& storage_size,
+                                  KeysInputIterator keys_input,
+                                  KeysOutputIterator keys_output,
+                                  ValuesInputIterator values_input,
+                                  ValuesOutputIterator values_output,
+                                  const size_t size,
+                                  const unsigned int segments,
+                                  OffsetIterator begin_offsets,
+                                  OffsetIterator end_offsets,
+                                  unsigned int begin_bit,
+                                  unsigned int end_bit,
+                                  const stream_t /* stream */,
+                                  const bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using codec = radix_key_codec<key_type, Descending>;
+
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    // Histograms for the largest number of blocks of a large segment
+    const size_t max_blocks = 4 * get_cpu_thread_pool().size();
+    const size_t histograms_bytes =
+        ::rocprim::detail::align_size(max_blocks * cpu_radix_size * sizeof(size_t));
+    const size_t keys_bytes = ::rocprim::detail::align_size(size * sizeof(key_type));
+    const size_t values_bytes = with_values ? ::rocprim::detail::align_size(size * sizeof(value_type)) : 0;
+    if(temporary_storage == nullptr)
+    {
+        storage_size = histograms_bytes + keys_bytes + values_bytes;
+        return success;
+    }
+
+    constexpr unsigned int key_bits = codec::key_bits;
+    end_bit = std::min(end_bit, key_bits);
+    begin_bit = std::min(begin_bit, end_bit);
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        std::cout << "threads " << get_cpu_thread_pool().size() << '\n';
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    size_t * histograms = reinterpret_cast<size_t *>(ptr);
+    ptr += histograms_bytes;
+    key_type * keys_tmp = reinterpret_cast<key_type *>(ptr);
+    ptr += keys_bytes;
+    value_type * values_tmp = reinterpret_cast<value_type *>(ptr);
+
+    // Small and medium segments, every segment is sorted by one thread
+    const cpu_partition partition(segments, 16);
+    cpu_parallel_for(
+        partition.blocks,
+        [&](size_t block)
+        {
+            size_t histogram[cpu_radix_size];
+            for(size_t segment = partition.begin(block); segment < partition.end(block); segment++)
+            {
+                const size_t begin = begin_offsets[segment];
+                const size_t end = end_offsets[segment];
+                if(end <= begin || end - begin >= cpu_segmented_radix_sort_large_size) continue;
+
+                if(end - begin < cpu_segmented_radix_sort_small_size && begin_bit < end_bit)
+                {
+                    std::copy(keys_input + begin, keys_input + end, keys_output + begin);
+                    if(with_values)
+                    {
+                        std::copy(values_input + begin, values_input + end, values_output + begin);
+                    }
+                    cpu_radix_insertion_sort<codec, with_values>(
+                        keys_output, values_output, begin, end, begin_bit, end_bit
+                    );
+                }
+                else
+                {
+                    // One block, passes of nested loops are executed by this thread
+                    cpu_radix_sort<codec, with_values>(
+                        keys_input, keys_tmp, keys_output, keys_output,
+                        values_input, values_tmp, values_output, values_output,
+                        begin, end, end - begin, histogram,
+                        begin_bit, end_bit
+                    );
+                }
+            }
+        }
+    );
+
+    // Large segments are sorted by all threads
+    for(size_t segment = 0; segment < segments; segment++)
+    {
+        const size_t begin = begin_offsets[segment];
+        const size_t end = end_offsets[segment];
+        if(end <= begin || end - begin < cpu_segmented_radix_sort_large_size) continue;
+
+        const cpu_partition segment_partition(end - begin);
+        cpu_radix_sort<codec, with_values>(
+            keys_input, keys_tmp, keys_output, keys_output,
+            values_input, values_tmp, values_output, values_output,
+            begin, end, segment_partition.block_size, histograms,
+            begin_bit, end_bit
+        );
+    }
+    ROCPRIM_DETAIL_CPU_SYNC("segmented_radix_sort", size, start)
+    return success;
+}
+
+#undef ROCPRIM_DETAIL_CPU_SYNC
+
+} // end namespace detail
+
+/// \brief CPU parallel ascending radix sort primitive for device level.
+///
+/// \p segmented_radix_sort_keys function performs a device-wide radix sort across multiple,
+/// non-overlapping sequences of keys on host threads. Function sorts input keys in
+/// ascending order.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * \p Key type must be an arithmetic type or a type with a specialization
+/// of \ref rocprim::radix_key_decomposer.
+/// * Ranges specified by \p keys_input and \p keys_output must have at least \p size elements.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam KeysInputIterator - random-access iterator type of the input range.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Default value: \p <tt>8 * sizeof(Key)</tt>.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class OffsetIterator,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+>
+inline
+error_t segmented_radix_sort_keys(void * temporary_storage,
+                                  size_t& storage_size,
+                                  KeysInputIterator keys_input,
+                                  KeysOutputIterator keys_output,
+                                  size_t size,
+                                  unsigned int segments,
+                                  OffsetIterator begin_offsets,
+                                  OffsetIterator end_offsets,
+                                  unsigned int begin_bit = 0,
+                                  unsigned int end_bit = 8 * sizeof(Key),
+                                  stream_t stream = 0,
+                                  bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::segmented_radix_sort_impl<false>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values, values,
+        size, segments, begin_offsets, end_offsets,
+        begin_bit, end_bit, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel descending radix sort primitive for device level.
+///
+/// \p segmented_radix_sort_keys_desc function performs a device-wide radix sort across
+/// multiple, non-overlapping sequences of keys on host threads. Function sorts input keys
+/// in descending order. Parameters are the same as in \p segmented_radix_sort_keys.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class OffsetIterator,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+>
+inline
+error_t segmented_radix_sort_keys_desc(void * temporary_storage,
+                                       size_t& storage_size,
+                                       KeysInputIterator keys_input,
+                                       KeysOutputIterator keys_output,
+                                       size_t size,
+                                       unsigned int segments,
+                                       OffsetIterator begin_offsets,
+                                       OffsetIterator end_offsets,
+                                       unsigned int begin_bit = 0,
+                                       unsigned int end_bit = 8 * sizeof(Key),
+                                       stream_t stream = 0,
+                                       bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::segmented_radix_sort_impl<true>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values, values,
+        size, segments, begin_offsets, end_offsets,
+        begin_bit, end_bit, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel ascending radix sort-by-key primitive for device level.
+///
+/// \p segmented_radix_sort_pairs function performs a device-wide radix sort across multiple,
+/// non-overlapping sequences of (key, value) pairs on host threads. Function sorts input
+/// pairs in ascending order of keys, the sort is stable.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input, \p keys_output, \p values_input and \p values_output must
+/// have at least \p size elements.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam KeysInputIterator - random-access iterator type of the input range.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] values_input - pointer to the first element in the range to sort.
+/// \param [out] values_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Default value: \p <tt>8 * sizeof(Key)</tt>.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+>
+inline
+error_t segmented_radix_sort_pairs(void * temporary_storage,
+                                   size_t& storage_size,
+                                   KeysInputIterator keys_input,
+                                   KeysOutputIterator keys_output,
+                                   ValuesInputIterator values_input,
+                                   ValuesOutputIterator values_output,
+                                   size_t size,
+                                   unsigned int segments,
+                                   OffsetIterator begin_offsets,
+                                   OffsetIterator end_offsets,
+                                   unsigned int begin_bit = 0,
+                                   unsigned int end_bit = 8 * sizeof(Key),
+                                   stream_t stream = 0,
+                                   bool debug_synchronous = false)
+{
+    return detail::segmented_radix_sort_impl<false>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output,
+        size, segments, begin_offsets, end_offsets,
+        begin_bit, end_bit, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel descending radix sort-by-key primitive for device level.
+///
+/// \p segmented_radix_sort_pairs_desc function performs a device-wide radix sort across
+/// multiple, non-overlapping sequences of (key, value) pairs on host threads. Function sorts
+/// input pairs in descending order of keys, the sort is stable.
+/// Parameters are the same as in \p segmented_radix_sort_pairs.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+>
+inline
+error_t segmented_radix_sort_pairs_desc(void * temporary_storage,
+                                        size_t& storage_size,
+                                        KeysInputIterator keys_input,
+                                        KeysOutputIterator keys_output,
+                                        ValuesInputIterator values_input,
+                                        ValuesOutputIterator values_output,
+                                        size_t size,
+                                        unsigned int segments,
+                                        OffsetIterator begin_offsets,
+                                        OffsetIterator end_offsets,
+                                        unsigned int begin_bit = 0,
+                                        unsigned int end_bit = 8 * sizeof(Key),
+                                        stream_t stream = 0,
+                                        bool debug_synchronous = false)
+{
+    return detail::segmented_radix_sort_impl<true>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output,
+        size, segments, begin_offsets, end_offsets,
+        begin_bit, end_bit, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel radix sort primitive for device level, double-buffer variant.
+///
+/// \p segmented_radix_sort_keys sorts keys from \p current() of the double-buffer into
+/// \p alternate() and swaps the buffer, so \p current() points to the sorted range
+/// after the call. The input range is not altered.
+/// Other parameters are the same as in \p segmented_radix_sort_keys.
+template<class Config = default_config, class Key, class OffsetIterator>
+inline
+error_t segmented_radix_sort_keys(void * temporary_storage,
+                                  size_t& storage_size,
+                                  double_buffer<Key>& keys,
+                                  size_t size,
+                                  unsigned int segments,
+                                  OffsetIterator begin_offsets,
+                                  OffsetIterator end_offsets,
+                                  unsigned int begin_bit = 0,
+                                  unsigned int end_bit = 8 * sizeof(Key),
+                                  stream_t stream = 0,
+                                  bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    const error_t error = detail::segmented_radix_sort_impl<false>(
+        temporary_storage, storage_size,
+        keys.current(), keys.alternate(), values, values,
+        size, segments, begin_offsets, end_offsets,
+        begin_bit, end_bit, stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr)
+    {
+        keys.swap();
+    }
+    return error;
+}
+
+/// \brief CPU parallel radix sort primitive for device level, double-buffer variant.
+///
+/// \p segmented_radix_sort_keys_desc sorts keys from \p current() of the double-buffer into
+/// \p alternate() and swaps the buffer, so \p current() points to the sorted range
+/// after the call. The input range is not altered.
+/// Other parameters are the same as in \p segmented_radix_sort_keys_desc.
+template<class Config = default_config, class Key, class OffsetIterator>
+inline
+error_t segmented_radix_sort_keys_desc(void * temporary_storage,
+                                       size_t& storage_size,
+                                       double_buffer<Key>& keys,
+                                       size_t size,
+                                       unsigned int segments,
+                                       OffsetIterator begin_offsets,
+                                       OffsetIterator end_offsets,
+                                       unsigned int begin_bit = 0,
+                                       unsigned int end_bit = 8 * sizeof(Key),
+                                       stream_t stream = 0,
+                                       bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    const error_t error = detail::segmented_radix_sort_impl<true>(
+        temporary_storage, storage_size,
+        keys.current(), keys.alternate(), values, values,
+        size, segments, begin_offsets, end_offsets,
+        begin_bit, end_bit, stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr)
+    {
+        keys.swap();
+    }
+    return error;
+}
+
+/// \brief CPU parallel radix sort primitive for device level, double-buffer variant.
+///
+/// \p segmented_radix_sort_pairs sorts (key, value) pairs from \p current() of the double-buffers into
+/// \p alternate() and swaps the buffers, so \p current() points to the sorted range
+/// after the call. The input range is not altered.
+/// Other parameters are the same as in \p segmented_radix_sort_pairs.
+template<class Config = default_config, class Key, class Value, class OffsetIterator>
+inline
+error_t segmented_radix_sort_pairs(void * temporary_storage,
+                                   size_t& storage_size,
+                                   double_buffer<Key>& keys,
+                                   double_buffer<Value>& values,
+                                   size_t size,
+                                   unsigned int segments,
+                                   OffsetIterator begin_offsets,
+                                   OffsetIterator end_offsets,
+                                   unsigned int begin_bit = 0,
+                                   unsigned int end_bit = 8 * sizeof(Key),
+                                   stream_t stream = 0,
+                                   bool debug_synchronous = false)
+{
+    const error_t error = detail::segmented_radix_sort_impl<false>(
+        temporary_storage, storage_size,
+        keys.current(), keys.alternate(), values.current(), values.alternate(),
+        size, segments, begin_offsets, end_offsets,
+        begin_bit, end_bit, stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr)
+    {
+        keys.swap();
+        values.swap();
+    }
+    return error;
+}
+
+/// \brief CPU parallel radix sort primitive for device level, double-buffer variant.
+///
+/// \p segmented_radix_sort_pairs_desc sorts (key, value) pairs from \p current() of the double-buffers into
+/// \p alternate() and swaps the buffers, so \p current() points to the sorted range
+/// after the call. The input range is not altered.
+/// Other parameters are the same as in \p segmented_radix_sort_pairs_desc.
+template<class Config = default_config, class Key, class Value, class OffsetIterator>
+inline
+error_t segmented_radix_sort_pairs_desc(void * temporary_storage,
+                                        size_t& storage_size,
+                                        double_buffer<Key>& keys,
+                                        double_buffer<Value>& values,
+                                        size_t size,
+                                        unsigned int segments,
+                                        OffsetIterator begin_offsets,
+                                        OffsetIterator end_offsets,
+                                        unsigned int begin_bit = 0,
+                                        unsigned int end_bit = 8 * sizeof(Key),
+                                        stream_t stream = 0,
+                                        bool debug_synchronous = false)
+{
+    const error_t error = detail::segmented_radix_sort_impl<true>(
+        temporary_storage, storage_size,
+        keys.current(), keys.alternate(), values.current(), values.alternate(),
+        size, segments, begin_offsets, end_offsets,
+        begin_bit, end_bit, stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr)
+    {
+        keys.swap();
+        values.swap();
+    }
+    return error;
+}
+
+/// @}
+// end of group devicemodule_cpu
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_SEGMENTED_RADIX_SORT_CPU_HPP_
@@ -25,6 +25,7 @@
 #include <iterator>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "../config.hpp"
 #include "../detail/various.hpp"
@@ -34,6 +35,12 @@
 #include "../functional.hpp"
 #include "../types.hpp"
 
+#include "../iterator/counting_iterator.hpp"
+
+#include "device_partition_hc.hpp"
+#include "device_radix_sort_config.hpp"
+#include "device_radix_sort_hc.hpp"
+#include "device_transform_hc.hpp"
 #include "detail/device_segmented_radix_sort.hpp"
 
 /// \addtogroup devicemodule_hc
@@ -57,6 +64,7 @@ namespace detail
     }
 
 template<
+    class Config,
     bool Descending,
     class KeysInputIterator,
     class KeysOutputIterator,
@@ -73,7 +81,7 @@ void segmented_radix_sort_impl(void * temporary_storage,
                                ValuesInputIterator values_input,
                                typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
                                ValuesOutputIterator values_output,
-                               unsigned int size,
+                               size_t size,
                                bool& is_result_in_output,
                                unsigned int segments,
                                OffsetIterator begin_offsets,
@@ -83,34 +91,112 @@ void segmented_radix_sort_impl(void * temporary_storage,
                                hc::accelerator_view& acc_view,
                                bool debug_synchronous)
 {
-    constexpr unsigned int radix_bits = 8;
-
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
 
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_segmented_radix_sort_config<key_type, value_type>
+    >;
+
+    constexpr unsigned int radix_bits = config::radix_bits;
+    constexpr unsigned int warp_sort_size = segmented_radix_sort_size_classes<config>::warp_sort_size;
+    constexpr size_t huge_segment_size = segmented_radix_sort_size_classes<config>::huge_segment_size;
+
     constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
 
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 11;
+    constexpr unsigned int block_size = config::sort::block_size;
+    constexpr unsigned int items_per_thread = config::sort::items_per_thread;
+    constexpr unsigned int medium_segment_size = block_size * items_per_thread;
+    constexpr unsigned int small_segments_per_block = block_size / warp_sort_size;
+
+    static_assert(
+        warp_sort_size <= ::rocprim::warp_size() && block_size % warp_sort_size == 0,
+        "warp_sort_size must not exceed the hardware warp size and must divide block_size"
+    );
+
+    // Huge segments are sorted by device-wide radix sort, it makes the same number of passes
+    using huge_config = radix_sort_config<
+        radix_bits, typename config::sort, radix_sort_chunk_size<config>::value
+    >;
 
+    // Bits above key_bits (e.g. padding of decomposed keys) are equal in all keys
+    constexpr unsigned int key_bits = radix_key_codec<key_type>::key_bits;
+    end_bit = ::rocprim::min(end_bit, key_bits);
+    begin_bit = ::rocprim::min(begin_bit, end_bit);
     const unsigned int iterations = ::rocprim::detail::ceiling_div(end_bit - begin_bit, radix_bits);
     const bool with_double_buffer = keys_tmp != nullptr;
 
+    // Segments are split into size classes: small ones are sorted by logical warps,
+    // medium ones by blocks in a single pass, large ones by blocks in multiple passes
+    // and huge ones by device-wide radix sort
+    using size_class_op = segment_size_greater<OffsetIterator>;
+    const size_class_op large_op { begin_offsets, end_offsets, medium_segment_size };
+    const size_class_op medium_op { begin_offsets, end_offsets, warp_sort_size };
+    unsigned int * large_indices = nullptr;
+    unsigned int * medium_indices = nullptr;
+    unsigned int * small_indices = nullptr;
+    unsigned int * counts = nullptr;
+
+    size_t partition_bytes;
+    ::rocprim::partition_three_way(
+        nullptr, partition_bytes,
+        ::rocprim::make_counting_iterator<unsigned int>(0),
+        large_indices, medium_indices, small_indices, counts,
+        segments, large_op, medium_op,
+        acc_view, debug_synchronous
+    );
+
     const size_t keys_bytes = ::rocprim::detail::align_size(size * sizeof(key_type));
     const size_t values_bytes = with_values ? ::rocprim::detail::align_size(size * sizeof(value_type)) : 0;
+
+    // Only inputs longer than huge_segment_size can have huge segments
+    const bool with_huge_segments = size > huge_segment_size;
+    size_t huge_sort_bytes = 0;
+    if(with_huge_segments)
+    {
+        bool ignored;
+        radix_sort<huge_config, Descending>(
+            nullptr, huge_sort_bytes,
+            keys_input, nullptr, keys_output,
+            values_input, nullptr, values_output,
+            size, ignored, begin_bit, end_bit,
+            acc_view, debug_synchronous
+        );
+        // Huge segments are sorted in the double buffer mode with keys_tmp and values_tmp,
+        // so device-wide radix sort does not need its own copies of keys and values
+        huge_sort_bytes -= keys_bytes + values_bytes;
+    }
+    // Numbers of segments in size classes are not read back to the host, kernels are
+    // launched for the maximum possible numbers and skip missing segments on the device.
+    // Large (medium) segments are longer than medium_segment_size (warp_sort_size)
+    const unsigned int max_large_segments =
+        static_cast<unsigned int>(::rocprim::min<size_t>(segments, size / (medium_segment_size + 1)));
+    const unsigned int max_medium_segments =
+        static_cast<unsigned int>(::rocprim::min<size_t>(segments, size / (warp_sort_size + 1)));
+    // Bounds of large segments are read back to find huge ones among them
+    const unsigned int max_bounds = with_huge_segments ? max_large_segments : 0;
+
+    const size_t nested_bytes = ::rocprim::detail::align_size(::rocprim::max(partition_bytes, huge_sort_bytes));
+    const size_t indices_bytes = ::rocprim::detail::align_size(segments * sizeof(unsigned int));
+    const size_t counts_bytes = ::rocprim::detail::align_size(2 * sizeof(unsigned int));
+    const size_t bounds_bytes = ::rocprim::detail::align_size(2 * max_bounds * sizeof(size_t));
     if(temporary_storage == nullptr)
     {
+        storage_size = nested_bytes + 3 * indices_bytes + counts_bytes + bounds_bytes;
         if(!with_double_buffer)
         {
-            storage_size = keys_bytes + values_bytes;
-        }
-        else
-        {
-            storage_size = 4;
+            storage_size += keys_bytes + values_bytes;
         }
         return;
     }
 
+    if(segments == 0 || iterations == 0)
+    {
+        return;
+    }
+
     if(debug_synchronous)
     {
         std::cout << "iterations " << iterations << '\n';
@@ -118,14 +204,130 @@ void segmented_radix_sort_impl(void * temporary_storage,
     }
 
     char * ptr = reinterpret_cast<char *>(temporary_storage);
+    void * nested_storage = ptr;
+    ptr += nested_bytes;
     if(!with_double_buffer)
     {
         keys_tmp = reinterpret_cast<key_type *>(ptr);
         ptr += keys_bytes;
         values_tmp = with_values ? reinterpret_cast<value_type *>(ptr) : nullptr;
+        ptr += values_bytes;
+    }
+    large_indices = reinterpret_cast<unsigned int *>(ptr);
+    ptr += indices_bytes;
+    medium_indices = reinterpret_cast<unsigned int *>(ptr);
+    ptr += indices_bytes;
+    small_indices = reinterpret_cast<unsigned int *>(ptr);
+    ptr += indices_bytes;
+    counts = reinterpret_cast<unsigned int *>(ptr);
+    ptr += counts_bytes;
+    size_t * large_bounds = reinterpret_cast<size_t *>(ptr);
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    ::rocprim::partition_three_way(
+        nested_storage, partition_bytes,
+        ::rocprim::make_counting_iterator<unsigned int>(0),
+        large_indices, medium_indices, small_indices, counts,
+        segments, large_op, medium_op,
+        acc_view, debug_synchronous
+    );
+
+    unsigned int h_counts[2];
+    if(debug_synchronous)
+    {
+        acc_view.wait();
+        hc::copy(hc::array<unsigned int>(hc::extent<1>(2), acc_view, counts), h_counts);
+        std::cout << "large segments " << h_counts[0] << '\n';
+        std::cout << "medium segments " << h_counts[1] << '\n';
+        std::cout << "small segments " << segments - h_counts[0] - h_counts[1] << '\n';
+    }
+
+    // All size classes must finish in the same buffer: keys_output after an odd number
+    // of passes over large segments in the double buffer mode, otherwise keys_output
+    const bool to_output = !with_double_buffer || iterations % 2 == 1;
+    is_result_in_output = to_output;
+
+    // Small and medium segments are sorted in one launch directly into the final buffer
+    {
+        const unsigned int grid_size = ::rocprim::detail::ceiling_div(segments, small_segments_per_block);
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        if(to_output)
+        {
+            hc::parallel_for_each(
+                acc_view,
+                hc::tiled_extent<1>(grid_size * block_size, block_size),
+                [=](hc::tiled_index<1>) [[hc]]
+                {
+                    segmented_sort_small<block_size, warp_sort_size, Descending>(
+                        keys_input, keys_output, values_input, values_output,
+                        small_indices, counts, segments, begin_offsets, end_offsets,
+                        begin_bit, end_bit
+                    );
+                }
+            );
+        }
+        else
+        {
+            hc::parallel_for_each(
+                acc_view,
+                hc::tiled_extent<1>(grid_size * block_size, block_size),
+                [=](hc::tiled_index<1>) [[hc]]
+                {
+                    segmented_sort_small<block_size, warp_sort_size, Descending>(
+                        keys_input, keys_tmp, values_input, values_tmp,
+                        small_indices, counts, segments, begin_offsets, end_offsets,
+                        begin_bit, end_bit
+                    );
+                }
+            );
+        }
+        ROCPRIM_DETAIL_HC_SYNC("segmented_sort_small", segments, start);
     }
 
-    bool to_output = with_double_buffer || (iterations - 1) % 2 == 0;
+    if(max_medium_segments > 0)
+    {
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        if(to_output)
+        {
+            hc::parallel_for_each(
+                acc_view,
+                hc::tiled_extent<1>(max_medium_segments * block_size, block_size),
+                [=](hc::tiled_index<1>) [[hc]]
+                {
+                    segmented_sort_medium<block_size, items_per_thread, Descending>(
+                        keys_input, keys_output, values_input, values_output,
+                        medium_indices, counts, begin_offsets, end_offsets,
+                        begin_bit, end_bit
+                    );
+                }
+            );
+        }
+        else
+        {
+            hc::parallel_for_each(
+                acc_view,
+                hc::tiled_extent<1>(max_medium_segments * block_size, block_size),
+                [=](hc::tiled_index<1>) [[hc]]
+                {
+                    segmented_sort_medium<block_size, items_per_thread, Descending>(
+                        keys_input, keys_tmp, values_input, values_tmp,
+                        medium_indices, counts, begin_offsets, end_offsets,
+                        begin_bit, end_bit
+                    );
+                }
+            );
+        }
+        ROCPRIM_DETAIL_HC_SYNC("segmented_sort_medium", max_medium_segments, start);
+    }
+
+    if(max_large_segments == 0)
+    {
+        return;
+    }
+
+    // Large segments (except huge ones) are sorted by blocks, one pass per launch
+    bool to_large_output = with_double_buffer || (iterations - 1) % 2 == 0;
     for(unsigned int bit = begin_bit; bit < end_bit; bit += radix_bits)
     {
         // Handle cases when (end_bit - bit) is not divisible by radix_bits, i.e. the last
@@ -134,21 +336,19 @@ void segmented_radix_sort_impl(void * temporary_storage,
 
         const bool is_first_iteration = (bit == begin_bit);
 
-        std::chrono::high_resolution_clock::time_point start;
-
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         if(is_first_iteration)
         {
-            if(to_output)
+            if(to_large_output)
             {
                 hc::parallel_for_each(
                     acc_view,
-                    hc::tiled_extent<1>(segments * block_size, block_size),
+                    hc::tiled_extent<1>(max_large_segments * block_size, block_size),
                     [=](hc::tiled_index<1>) [[hc]]
                     {
                         segmented_sort<block_size, items_per_thread, radix_bits, Descending>(
                             keys_input, keys_output, values_input, values_output,
-                            begin_offsets, end_offsets,
+                            large_indices, counts, begin_offsets, end_offsets, huge_segment_size,
                             bit, current_radix_bits
                         );
                     }
@@ -158,12 +358,12 @@ void segmented_radix_sort_impl(void * temporary_storage,
             {
                 hc::parallel_for_each(
                     acc_view,
-                    hc::tiled_extent<1>(segments * block_size, block_size),
+                    hc::tiled_extent<1>(max_large_segments * block_size, block_size),
                     [=](hc::tiled_index<1>) [[hc]]
                     {
                         segmented_sort<block_size, items_per_thread, radix_bits, Descending>(
                             keys_input, keys_tmp, values_input, values_tmp,
-                            begin_offsets, end_offsets,
+                            large_indices, counts, begin_offsets, end_offsets, huge_segment_size,
                             bit, current_radix_bits
                         );
                     }
@@ -172,16 +372,16 @@ void segmented_radix_sort_impl(void * temporary_storage,
         }
         else
         {
-            if(to_output)
+            if(to_large_output)
             {
                 hc::parallel_for_each(
                     acc_view,
-                    hc::tiled_extent<1>(segments * block_size, block_size),
+                    hc::tiled_extent<1>(max_large_segments * block_size, block_size),
                     [=](hc::tiled_index<1>) [[hc]]
                     {
                         segmented_sort<block_size, items_per_thread, radix_bits, Descending>(
                             keys_tmp, keys_output, values_tmp, values_output,
-                            begin_offsets, end_offsets,
+                            large_indices, counts, begin_offsets, end_offsets, huge_segment_size,
                             bit, current_radix_bits
                         );
                     }
@@ -191,22 +391,91 @@ void segmented_radix_sort_impl(void * temporary_storage,
             {
                 hc::parallel_for_each(
                     acc_view,
-                    hc::tiled_extent<1>(segments * block_size, block_size),
+                    hc::tiled_extent<1>(max_large_segments * block_size, block_size),
                     [=](hc::tiled_index<1>) [[hc]]
                     {
                         segmented_sort<block_size, items_per_thread, radix_bits, Descending>(
                             keys_output, keys_tmp, values_output, values_tmp,
-                            begin_offsets, end_offsets,
+                            large_indices, counts, begin_offsets, end_offsets, huge_segment_size,
                             bit, current_radix_bits
                         );
                     }
                 );
             }
         }
-        ROCPRIM_DETAIL_HC_SYNC("segmented_sort", segments, start);
+        ROCPRIM_DETAIL_HC_SYNC("segmented_sort", max_large_segments, start);
+
+        to_large_output = !to_large_output;
+    }
+
+    if(!with_huge_segments)
+    {
+        return;
+    }
+
+    // Huge segments are among the first max_large_segments large ones (because all
+    // large segments are longer than medium_segment_size)
+    constexpr unsigned int bounds_block_size = 256;
+    const unsigned int bounds_grid_size = ::rocprim::detail::ceiling_div(max_bounds, bounds_block_size);
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(bounds_grid_size * bounds_block_size, bounds_block_size),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            segmented_sort_large_bounds(
+                large_indices, counts, max_bounds,
+                begin_offsets, end_offsets,
+                large_bounds
+            );
+        }
+    );
+    ROCPRIM_DETAIL_HC_SYNC("segmented_sort_large_bounds", max_bounds, start);
 
-        is_result_in_output = to_output;
-        to_output = !to_output;
+    // The only read-back: the number of large segments and their bounds, it is needed
+    // only when the input is long enough to have huge segments
+    std::vector<size_t> h_bounds(2 * max_bounds);
+    acc_view.wait();
+    hc::copy(hc::array<unsigned int>(hc::extent<1>(2), acc_view, counts), h_counts);
+    hc::copy(hc::array<size_t>(hc::extent<1>(h_bounds.size()), acc_view, large_bounds), h_bounds.data());
+    const unsigned int bounds_count = ::rocprim::min(h_counts[0], max_bounds);
+
+    for(unsigned int i = 0; i < bounds_count; i++)
+    {
+        const size_t begin_offset = h_bounds[2 * i];
+        const size_t segment_size = h_bounds[2 * i + 1] - begin_offset;
+        if(segment_size <= huge_segment_size)
+        {
+            continue;
+        }
+
+        bool is_huge_result_in_output;
+        radix_sort<huge_config, Descending>(
+            nested_storage, huge_sort_bytes,
+            keys_input + begin_offset, keys_tmp + begin_offset, keys_output + begin_offset,
+            values_input + begin_offset, values_tmp + begin_offset, values_output + begin_offset,
+            segment_size, is_huge_result_in_output, begin_bit, end_bit,
+            acc_view, debug_synchronous
+        );
+
+        // Both sorts make the same number of passes, so the results can differ only
+        // when this sort is not in the double buffer mode and the number is even
+        if(to_output && !is_huge_result_in_output)
+        {
+            ::rocprim::transform(
+                keys_tmp + begin_offset, keys_output + begin_offset, segment_size,
+                segmented_sort_copy_op<key_type>(),
+                acc_view, debug_synchronous
+            );
+            if(with_values)
+            {
+                ::rocprim::transform(
+                    values_tmp + begin_offset, values_output + begin_offset, segment_size,
+                    segmented_sort_copy_op<value_type>(),
+                    acc_view, debug_synchronous
+                );
+            }
+        }
     }
 }
 
@@ -224,7 +493,8 @@ void segmented_radix_sort_impl(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 /// * \p Key type (a \p value_type of \p KeysInputIterator and \p KeysOutputIterator) must be
-/// an arithmetic type (that is, an integral type or a floating-point type).
+/// an arithmetic type (that is, an integral type or a floating-point type) or a type with
+/// a specialization of \ref rocprim::radix_key_decomposer.
 /// * Ranges specified by \p keys_input and \p keys_output must have at least \p size elements.
 /// * Ranges specified by \p begin_offsets and \p end_offsets must have
 /// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
@@ -233,7 +503,13 @@ void segmented_radix_sort_impl(void * temporary_storage,
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
+/// * The function is asynchronous with respect to the host, unless \p size is greater than
+/// the huge segment size of \p Config (<tt>1 << 17</tt> by default). Then it waits for
+/// \p acc_view once to read bounds of large segments back and sorts huge segments
+/// by device-wide radix sort.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_radix_sort_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
@@ -303,6 +579,7 @@ void segmented_radix_sort_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class OffsetIterator,
@@ -313,7 +590,7 @@ void segmented_radix_sort_keys(void * temporary_storage,
                                size_t& storage_size,
                                KeysInputIterator keys_input,
                                KeysOutputIterator keys_output,
-                               unsigned int size,
+                               size_t size,
                                unsigned int segments,
                                OffsetIterator begin_offsets,
                                OffsetIterator end_offsets,
@@ -324,7 +601,7 @@ void segmented_radix_sort_keys(void * temporary_storage,
 {
     empty_type * values = nullptr;
     bool ignored;
-    detail::segmented_radix_sort_impl<false>(
+    detail::segmented_radix_sort_impl<Config, false>(
         temporary_storage, storage_size,
         keys_input, nullptr, keys_output,
         values, nullptr, values,
@@ -345,7 +622,8 @@ void segmented_radix_sort_keys(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 /// * \p Key type (a \p value_type of \p KeysInputIterator and \p KeysOutputIterator) must be
-/// an arithmetic type (that is, an integral type or a floating-point type).
+/// an arithmetic type (that is, an integral type or a floating-point type) or a type with
+/// a specialization of \ref rocprim::radix_key_decomposer.
 /// * Ranges specified by \p keys_input and \p keys_output must have at least \p size elements.
 /// * Ranges specified by \p begin_offsets and \p end_offsets must have
 /// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
@@ -354,7 +632,13 @@ void segmented_radix_sort_keys(void * temporary_storage,
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
+/// * The function is asynchronous with respect to the host, unless \p size is greater than
+/// the huge segment size of \p Config (<tt>1 << 17</tt> by default). Then it waits for
+/// \p acc_view once to read bounds of large segments back and sorts huge segments
+/// by device-wide radix sort.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_radix_sort_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
@@ -424,6 +708,7 @@ void segmented_radix_sort_keys(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class OffsetIterator,
@@ -434,7 +719,7 @@ void segmented_radix_sort_keys_desc(void * temporary_storage,
                                     size_t& storage_size,
                                     KeysInputIterator keys_input,
                                     KeysOutputIterator keys_output,
-                                    unsigned int size,
+                                    size_t size,
                                     unsigned int segments,
                                     OffsetIterator begin_offsets,
                                     OffsetIterator end_offsets,
@@ -445,7 +730,7 @@ void segmented_radix_sort_keys_desc(void * temporary_storage,
 {
     empty_type * values = nullptr;
     bool ignored;
-    detail::segmented_radix_sort_impl<true>(
+    detail::segmented_radix_sort_impl<Config, true>(
         temporary_storage, storage_size,
         keys_input, nullptr, keys_output,
         values, nullptr, values,
@@ -466,7 +751,8 @@ void segmented_radix_sort_keys_desc(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 /// * \p Key type (a \p value_type of \p KeysInputIterator and \p KeysOutputIterator) must be
-/// an arithmetic type (that is, an integral type or a floating-point type).
+/// an arithmetic type (that is, an integral type or a floating-point type) or a type with
+/// a specialization of \ref rocprim::radix_key_decomposer.
 /// * Ranges specified by \p keys_input, \p keys_output, \p values_input and \p values_output must
 /// have at least \p size elements.
 /// * Ranges specified by \p begin_offsets and \p end_offsets must have
@@ -476,7 +762,13 @@ void segmented_radix_sort_keys_desc(void * temporary_storage,
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
+/// * The function is asynchronous with respect to the host, unless \p size is greater than
+/// the huge segment size of \p Config (<tt>1 << 17</tt> by default). Then it waits for
+/// \p acc_view once to read bounds of large segments back and sorts huge segments
+/// by device-wide radix sort.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_radix_sort_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
@@ -559,6 +851,7 @@ void segmented_radix_sort_keys_desc(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
@@ -573,7 +866,7 @@ void segmented_radix_sort_pairs(void * temporary_storage,
                                 KeysOutputIterator keys_output,
                                 ValuesInputIterator values_input,
                                 ValuesOutputIterator values_output,
-                                unsigned int size,
+                                size_t size,
                                 unsigned int segments,
                                 OffsetIterator begin_offsets,
                                 OffsetIterator end_offsets,
@@ -583,7 +876,7 @@ void segmented_radix_sort_pairs(void * temporary_storage,
                                 bool debug_synchronous = false)
 {
     bool ignored;
-    detail::segmented_radix_sort_impl<false>(
+    detail::segmented_radix_sort_impl<Config, false>(
         temporary_storage, storage_size,
         keys_input, nullptr, keys_output,
         values_input, nullptr, values_output,
@@ -604,7 +897,8 @@ void segmented_radix_sort_pairs(void * temporary_storage,
 /// * Returns the required size of \p temporary_storage in \p storage_size
 /// if \p temporary_storage in a null pointer.
 /// * \p Key type (a \p value_type of \p KeysInputIterator and \p KeysOutputIterator) must be
-/// an arithmetic type (that is, an integral type or a floating-point type).
+/// an arithmetic type (that is, an integral type or a floating-point type) or a type with
+/// a specialization of \ref rocprim::radix_key_decomposer.
 /// * Ranges specified by \p keys_input, \p keys_output, \p values_input and \p values_output must
 /// have at least \p size elements.
 /// * Ranges specified by \p begin_offsets and \p end_offsets must have
@@ -614,7 +908,13 @@ void segmented_radix_sort_pairs(void * temporary_storage,
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
+/// * The function is asynchronous with respect to the host, unless \p size is greater than
+/// the huge segment size of \p Config (<tt>1 << 17</tt> by default). Then it waits for
+/// \p acc_view once to read bounds of large segments back and sorts huge segments
+/// by device-wide radix sort.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_radix_sort_config or a custom class with the same members.
 /// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
@@ -695,6 +995,7 @@ void segmented_radix_sort_pairs(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
@@ -709,7 +1010,7 @@ void segmented_radix_sort_pairs_desc(void * temporary_storage,
                                      KeysOutputIterator keys_output,
                                      ValuesInputIterator values_input,
                                      ValuesOutputIterator values_output,
-                                     unsigned int size,
+                                     size_t size,
                                      unsigned int segments,
                                      OffsetIterator begin_offsets,
                                      OffsetIterator end_offsets,
@@ -719,7 +1020,7 @@ void segmented_radix_sort_pairs_desc(void * temporary_storage,
                                      bool debug_synchronous = false)
 {
     bool ignored;
-    detail::segmented_radix_sort_impl<true>(
+    detail::segmented_radix_sort_impl<Config, true>(
         temporary_storage, storage_size,
         keys_input, nullptr, keys_output,
         values_input, nullptr, values_output,
@@ -745,7 +1046,7 @@ void segmented_radix_sort_pairs_desc(void * temporary_storage,
 /// * The function requires small \p temporary_storage as it does not need
 /// a temporary buffer of \p size elements.
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
-/// type).
+/// type) or a type with a specialization of \ref rocprim::radix_key_decomposer.
 /// * Buffers of \p keys must have at least \p size elements.
 /// * Ranges specified by \p begin_offsets and \p end_offsets must have
 /// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
@@ -754,7 +1055,13 @@ void segmented_radix_sort_pairs_desc(void * temporary_storage,
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
+/// * The function is asynchronous with respect to the host, unless \p size is greater than
+/// the huge segment size of \p Config (<tt>1 << 17</tt> by default). Then it waits for
+/// \p acc_view once to read bounds of large segments back and sorts huge segments
+/// by device-wide radix sort.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_radix_sort_config or a custom class with the same members.
 /// \tparam Key - key type. Must be an integral type or a floating-point type.
 /// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
 /// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
@@ -820,12 +1127,12 @@ void segmented_radix_sort_pairs_desc(void * temporary_storage,
 /// // keys.current(): [0.3, 0.6, 0.65, 0.08, 0.2, 0.4, 0.7, 1]
 /// \endcode
 /// \endparblock
-template<class Key, class OffsetIterator>
+template<class Config = default_config, class Key, class OffsetIterator>
 inline
 void segmented_radix_sort_keys(void * temporary_storage,
                                size_t& storage_size,
                                double_buffer<Key>& keys,
-                               unsigned int size,
+                               size_t size,
                                unsigned int segments,
                                OffsetIterator begin_offsets,
                                OffsetIterator end_offsets,
@@ -836,7 +1143,7 @@ void segmented_radix_sort_keys(void * temporary_storage,
 {
     empty_type * values = nullptr;
     bool is_result_in_output;
-    detail::segmented_radix_sort_impl<false>(
+    detail::segmented_radix_sort_impl<Config, false>(
         temporary_storage, storage_size,
         keys.current(), keys.current(), keys.alternate(),
         values, values, values,
@@ -866,7 +1173,7 @@ void segmented_radix_sort_keys(void * temporary_storage,
 /// * The function requires small \p temporary_storage as it does not need
 /// a temporary buffer of \p size elements.
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
-/// type).
+/// type) or a type with a specialization of \ref rocprim::radix_key_decomposer.
 /// * Buffers of \p keys must have at least \p size elements.
 /// * Ranges specified by \p begin_offsets and \p end_offsets must have
 /// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
@@ -875,7 +1182,13 @@ void segmented_radix_sort_keys(void * temporary_storage,
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
+/// * The function is asynchronous with respect to the host, unless \p size is greater than
+/// the huge segment size of \p Config (<tt>1 << 17</tt> by default). Then it waits for
+/// \p acc_view once to read bounds of large segments back and sorts huge segments
+/// by device-wide radix sort.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_radix_sort_config or a custom class with the same members.
 /// \tparam Key - key type. Must be an integral type or a floating-point type.
 /// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
 /// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
@@ -941,12 +1254,12 @@ void segmented_radix_sort_keys(void * temporary_storage,
 /// // keys.current(): [6, 3, 5, 8, 7, 4, 2, 1]
 /// \endcode
 /// \endparblock
-template<class Key, class OffsetIterator>
+template<class Config = default_config, class Key, class OffsetIterator>
 inline
 void segmented_radix_sort_keys_desc(void * temporary_storage,
                                     size_t& storage_size,
                                     double_buffer<Key>& keys,
-                                    unsigned int size,
+                                    size_t size,
                                     unsigned int segments,
                                     OffsetIterator begin_offsets,
                                     OffsetIterator end_offsets,
@@ -957,7 +1270,7 @@ void segmented_radix_sort_keys_desc(void * temporary_storage,
 {
     empty_type * values = nullptr;
     bool is_result_in_output;
-    detail::segmented_radix_sort_impl<true>(
+    detail::segmented_radix_sort_impl<Config, true>(
         temporary_storage, storage_size,
         keys.current(), keys.current(), keys.alternate(),
         values, values, values,
@@ -987,7 +1300,7 @@ void segmented_radix_sort_keys_desc(void * temporary_storage,
 /// * The function requires small \p temporary_storage as it does not need
 /// a temporary buffer of \p size elements.
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
-/// type).
+/// type) or a type with a specialization of \ref rocprim::radix_key_decomposer.
 /// * Buffers of \p keys must have at least \p size elements.
 /// * Ranges specified by \p begin_offsets and \p end_offsets must have
 /// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
@@ -996,7 +1309,13 @@ void segmented_radix_sort_keys_desc(void * temporary_storage,
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
+/// * The function is asynchronous with respect to the host, unless \p size is greater than
+/// the huge segment size of \p Config (<tt>1 << 17</tt> by default). Then it waits for
+/// \p acc_view once to read bounds of large segments back and sorts huge segments
+/// by device-wide radix sort.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_radix_sort_config or a custom class with the same members.
 /// \tparam Key - key type. Must be an integral type or a floating-point type.
 /// \tparam Value - value type.
 /// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
@@ -1073,13 +1392,13 @@ void segmented_radix_sort_keys_desc(void * temporary_storage,
 /// // values.current(): [2, -5, -4, -1, -2, 3, 7, -8]
 /// \endcode
 /// \endparblock
-template<class Key, class Value, class OffsetIterator>
+template<class Config = default_config, class Key, class Value, class OffsetIterator>
 inline
 void segmented_radix_sort_pairs(void * temporary_storage,
                                 size_t& storage_size,
                                 double_buffer<Key>& keys,
                                 double_buffer<Value>& values,
-                                unsigned int size,
+                                size_t size,
                                 unsigned int segments,
                                 OffsetIterator begin_offsets,
                                 OffsetIterator end_offsets,
@@ -1089,7 +1408,7 @@ void segmented_radix_sort_pairs(void * temporary_storage,
                                 bool debug_synchronous = false)
 {
     bool is_result_in_output;
-    detail::segmented_radix_sort_impl<false>(
+    detail::segmented_radix_sort_impl<Config, false>(
         temporary_storage, storage_size,
         keys.current(), keys.current(), keys.alternate(),
         values.current(), values.current(), values.alternate(),
@@ -1120,7 +1439,7 @@ void segmented_radix_sort_pairs(void * temporary_storage,
 /// * The function requires small \p temporary_storage as it does not need
 /// a temporary buffer of \p size elements.
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
-/// type).
+/// type) or a type with a specialization of \ref rocprim::radix_key_decomposer.
 /// * Buffers of \p keys must have at least \p size elements.
 /// * Ranges specified by \p begin_offsets and \p end_offsets must have
 /// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
@@ -1129,7 +1448,13 @@ void segmented_radix_sort_pairs(void * temporary_storage,
 /// * If \p Key is an integer type and the range of keys is known in advance, the performance
 /// can be improved by setting \p begin_bit and \p end_bit, for example if all keys are in range
 /// [100, 10000], <tt>begin_bit = 0</tt> and <tt>end_bit = 14</tt> will cover the whole range.
+/// * The function is asynchronous with respect to the host, unless \p size is greater than
+/// the huge segment size of \p Config (<tt>1 << 17</tt> by default). Then it waits for
+/// \p acc_view once to read bounds of large segments back and sorts huge segments
+/// by device-wide radix sort.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_radix_sort_config or a custom class with the same members.
 /// \tparam Key - key type. Must be an integral type or a floating-point type.
 /// \tparam Value - value type.
 /// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
@@ -1202,13 +1527,13 @@ void segmented_radix_sort_pairs(void * temporary_storage,
 /// // values.current(): [-5, 2, -4, -8, 7, 3, -1, -2]
 /// \endcode
 /// \endparblock
-template<class Key, class Value, class OffsetIterator>
+template<class Config = default_config, class Key, class Value, class OffsetIterator>
 inline
 void segmented_radix_sort_pairs_desc(void * temporary_storage,
                                      size_t& storage_size,
                                      double_buffer<Key>& keys,
                                      double_buffer<Value>& values,
-                                     unsigned int size,
+                                     size_t size,
                                      unsigned int segments,
                                      OffsetIterator begin_offsets,
                                      OffsetIterator end_offsets,
@@ -1218,7 +1543,7 @@ void segmented_radix_sort_pairs_desc(void * temporary_storage,
                                      bool debug_synchronous = false)
 {
     bool is_result_in_output;
-    detail::segmented_radix_sort_impl<true>(
+    detail::segmented_radix_sort_impl<Config, true>(
         temporary_storage, storage_size,
         keys.current(), keys.current(), keys.alternate(),
         values.current(), values.current(), values.alternate(),
@@ -0,0 +1,203 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SEGMENTED_REDUCE_CPU_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SEGMENTED_REDUCE_CPU_HPP_
+
+#include <type_traits>
+#include <iterator>
+#include <chrono>
+#include <iostream>
+
+#include "../config.hpp"
+#include "../functional.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+#include "cpu_types.hpp"
+#include "device_reduce_config.hpp"
+#include "detail/cpu_thread_pool.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_cpu
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_CPU_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+error_t segmented_reduce_impl(void * temporary_storage,
+                              size_t& storage_size,
+                              InputIterator input,
+                              OutputIterator output,
+                              const unsigned int segments,
+                              OffsetIterator begin_offsets,
+                              OffsetIterator end_offsets,
+                              BinaryFunction reduce_op,
+                              const InitValueType initial_value,
+                              const stream_t /* stream */,
+                              const bool debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<BinaryFunction, input_type, input_type>::type;
+    #else
+    using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
+    #endif
+
+    if(temporary_storage == nullptr)
+    {
+        // No temporary storage is needed, but make sure user won't try to allocate 0 bytes memory
+        storage_size = 4;
+        return success;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        std::cout << "threads " << get_cpu_thread_pool().size() << '\n';
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    // Segments are small work items of different sizes, so they are taken in
+    // small groups to keep threads balanced
+    const cpu_partition partition(segments, 16);
+    cpu_parallel_for(
+        partition.blocks,
+        [&](size_t block)
+        {
+            for(size_t segment = partition.begin(block); segment < partition.end(block); segment++)
+            {
+                const auto begin = begin_offsets[segment];
+                const auto end = end_offsets[segment];
+                if(end <= begin)
+                {
+                    output[segment] = initial_value;
+                    continue;
+                }
+                result_type value = static_cast<result_type>(input[begin]);
+                for(auto i = begin + 1; i < end; i++)
+                {
+                    value = reduce_op(value, input[i]);
+                }
+                output[segment] = reduce_op(initial_value, value);
+            }
+        }
+    );
+    ROCPRIM_DETAIL_CPU_SYNC("segmented_reduce", segments, start)
+    return success;
+}
+
+#undef ROCPRIM_DETAIL_CPU_SYNC
+
+} // end of detail namespace
+
+/// \brief CPU parallel segmented reduction primitive for device level.
+///
+/// segmented_reduce function performs a device-wide reduction operation across multiple
+/// sequences of elements using binary \p reduce_op operator on host threads.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input must have at least \p size elements, \p output,
+/// \p begin_offsets and \p end_offsets must have at least \p segments elements.
+/// * Segments with <tt>end_offsets[i] <= begin_offsets[i]</tt> are reduced to \p initial_value.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets.
+/// \tparam BinaryFunction - type of binary function used for reduction. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of \p InputIterator.
+/// \tparam InitValueType - type of the initial value.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to reduce.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] reduce_op - binary operation function object that will be used for reduction.
+/// \param [in] initial_value - initial value to start the reduction.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>,
+    class InitValueType = typename std::iterator_traits<InputIterator>::value_type
+>
+inline
+error_t segmented_reduce(void * temporary_storage,
+                         size_t& storage_size,
+                         InputIterator input,
+                         OutputIterator output,
+                         unsigned int segments,
+                         OffsetIterator begin_offsets,
+                         OffsetIterator end_offsets,
+                         BinaryFunction reduce_op = BinaryFunction(),
+                         InitValueType initial_value = InitValueType(),
+                         stream_t stream = 0,
+                         bool debug_synchronous = false)
+{
+    return detail::segmented_reduce_impl(
+        temporary_storage, storage_size,
+        input, output,
+        segments, begin_offsets, end_offsets,
+        reduce_op, initial_value,
+        stream, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule_cpu
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_SEGMENTED_REDUCE_CPU_HPP_
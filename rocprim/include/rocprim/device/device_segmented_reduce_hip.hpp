@@ -28,7 +28,13 @@
 #include "../functional.hpp"
 #include "../detail/various.hpp"
 
+#include "../iterator/counting_iterator.hpp"
+#include "../iterator/transform_iterator.hpp"
+
+#include "device_reduce_config.hpp"
+#include "device_scan_hip.hpp"
 #include "detail/device_segmented_reduce.hpp"
+#include "detail/device_host_fallback.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -63,6 +69,85 @@ void segmented_reduce_kernel(InputIterator input,
     );
 }
 
+template<
+    unsigned int BlockSize,
+    unsigned int WarpReduceSize,
+    unsigned int SmallSegmentSize,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+__global__
+void segmented_reduce_small_kernel(InputIterator input,
+                                   OutputIterator output,
+                                   unsigned int segments,
+                                   OffsetIterator begin_offsets,
+                                   OffsetIterator end_offsets,
+                                   BinaryFunction reduce_op,
+                                   InitValueType initial_value)
+{
+    segmented_reduce_small<BlockSize, WarpReduceSize, SmallSegmentSize, ResultType>(
+        input, output,
+        segments, begin_offsets, end_offsets,
+        reduce_op, initial_value
+    );
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+__global__
+void segmented_reduce_tiles_kernel(InputIterator input,
+                                   OutputIterator output,
+                                   unsigned int segments,
+                                   OffsetIterator begin_offsets,
+                                   OffsetIterator end_offsets,
+                                   const unsigned int * tile_offsets,
+                                   ResultType * partials,
+                                   BinaryFunction reduce_op,
+                                   InitValueType initial_value)
+{
+    segmented_reduce_tiles<BlockSize, ItemsPerThread>(
+        input, output,
+        segments, begin_offsets, end_offsets,
+        tile_offsets, partials,
+        reduce_op, initial_value
+    );
+}
+
+template<
+    unsigned int BlockSize,
+    class ResultType,
+    class OutputIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+__global__
+void segmented_reduce_fixup_kernel(OutputIterator output,
+                                   unsigned int segments,
+                                   const unsigned int * tile_offsets,
+                                   unsigned int tiles_grid_size,
+                                   const ResultType * partials,
+                                   BinaryFunction reduce_op,
+                                   InitValueType initial_value)
+{
+    segmented_reduce_fixup<BlockSize>(
+        output,
+        segments, tile_offsets, tiles_grid_size, partials,
+        reduce_op, initial_value
+    );
+}
+
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
     { \
         auto error = hipPeekAtLastError(); \
@@ -78,7 +163,196 @@ void segmented_reduce_kernel(InputIterator input,
         } \
     }
 
+// One block per segment
 template<
+    class Config,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+hipError_t segmented_reduce_launch(std::false_type /* load balanced */,
+                                   void * temporary_storage,
+                                   size_t& storage_size,
+                                   InputIterator input,
+                                   OutputIterator output,
+                                   unsigned int segments,
+                                   OffsetIterator begin_offsets,
+                                   OffsetIterator end_offsets,
+                                   BinaryFunction reduce_op,
+                                   InitValueType initial_value,
+                                   hipStream_t stream,
+                                   bool debug_synchronous)
+{
+    constexpr unsigned int block_size = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+
+    if(temporary_storage == nullptr)
+    {
+        // Make sure user won't try to allocate 0 bytes memory, because
+        // hipMalloc will return nullptr when size is zero.
+        storage_size = 4;
+        return hipSuccess;
+    }
+
+    if(segments == 0)
+    {
+        return hipSuccess;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(segmented_reduce_kernel<block_size, items_per_thread, ResultType>),
+        dim3(segments), dim3(block_size), 0, stream,
+        input, output,
+        begin_offsets, end_offsets,
+        reduce_op, initial_value
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce", segments, start);
+
+    return hipSuccess;
+}
+
+// Small segments are reduced by logical warps, tiles of long segments are distributed
+// evenly among a fixed number of blocks
+template<
+    class Config,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+hipError_t segmented_reduce_launch(std::true_type /* load balanced */,
+                                   void * temporary_storage,
+                                   size_t& storage_size,
+                                   InputIterator input,
+                                   OutputIterator output,
+                                   unsigned int segments,
+                                   OffsetIterator begin_offsets,
+                                   OffsetIterator end_offsets,
+                                   BinaryFunction reduce_op,
+                                   InitValueType initial_value,
+                                   hipStream_t stream,
+                                   bool debug_synchronous)
+{
+    constexpr unsigned int block_size = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int warp_reduce_size = segmented_reduce_load_balancing<Config>::warp_reduce_size;
+    constexpr unsigned int small_segment_size = segmented_reduce_load_balancing<Config>::small_segment_size;
+    constexpr unsigned int items_per_tile = block_size * items_per_thread;
+    constexpr unsigned int small_segments_per_block = block_size / warp_reduce_size;
+    // Enough blocks to occupy all compute units while the tiles kernel runs
+    constexpr unsigned int tiles_blocks_per_compute_unit = 4;
+
+    static_assert(
+        warp_reduce_size <= ::rocprim::warp_size() && block_size % warp_reduce_size == 0,
+        "warp_reduce_size must not exceed the hardware warp size and must divide block_size"
+    );
+
+    int device_id;
+    hipError_t error = hipGetDevice(&device_id);
+    if(error != hipSuccess) return error;
+    int compute_units;
+    error = hipDeviceGetAttribute(&compute_units, hipDeviceAttributeMultiprocessorCount, device_id);
+    if(error != hipSuccess) return error;
+    const unsigned int tiles_grid_size = compute_units * tiles_blocks_per_compute_unit;
+
+    const segmented_reduce_tiles_op<OffsetIterator> tiles_op {
+        begin_offsets, end_offsets, segments, small_segment_size, items_per_tile
+    };
+    auto tiles_input = ::rocprim::make_transform_iterator(
+        ::rocprim::make_counting_iterator<unsigned int>(0), tiles_op
+    );
+    unsigned int * tile_offsets = nullptr;
+
+    size_t scan_bytes;
+    error = ::rocprim::exclusive_scan(
+        nullptr, scan_bytes,
+        tiles_input, tile_offsets, 0U, segments + 1,
+        ::rocprim::plus<unsigned int>(),
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    const size_t nested_bytes = ::rocprim::detail::align_size(scan_bytes);
+    const size_t tile_offsets_bytes = ::rocprim::detail::align_size((segments + 1) * sizeof(unsigned int));
+    const size_t partials_bytes = ::rocprim::detail::align_size(2 * tiles_grid_size * sizeof(ResultType));
+    if(temporary_storage == nullptr)
+    {
+        storage_size = nested_bytes + tile_offsets_bytes + partials_bytes;
+        return hipSuccess;
+    }
+
+    if(segments == 0)
+    {
+        return hipSuccess;
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    void * nested_storage = ptr;
+    ptr += nested_bytes;
+    tile_offsets = reinterpret_cast<unsigned int *>(ptr);
+    ptr += tile_offsets_bytes;
+    ResultType * partials = reinterpret_cast<ResultType *>(ptr);
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(segmented_reduce_small_kernel<
+            block_size, warp_reduce_size, small_segment_size, ResultType
+        >),
+        dim3(::rocprim::detail::ceiling_div(segments, small_segments_per_block)),
+        dim3(block_size), 0, stream,
+        input, output,
+        segments, begin_offsets, end_offsets,
+        reduce_op, initial_value
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce_small", segments, start);
+
+    error = ::rocprim::exclusive_scan(
+        nested_storage, scan_bytes,
+        tiles_input, tile_offsets, 0U, segments + 1,
+        ::rocprim::plus<unsigned int>(),
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(segmented_reduce_tiles_kernel<block_size, items_per_thread, ResultType>),
+        dim3(tiles_grid_size), dim3(block_size), 0, stream,
+        input, output,
+        segments, begin_offsets, end_offsets,
+        tile_offsets, partials,
+        reduce_op, initial_value
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce_tiles", tiles_grid_size, start);
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(segmented_reduce_fixup_kernel<block_size, ResultType>),
+        dim3(::rocprim::detail::ceiling_div(segments, block_size)),
+        dim3(block_size), 0, stream,
+        output,
+        segments, tile_offsets, tiles_grid_size, partials,
+        reduce_op, initial_value
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce_fixup", segments, start);
+
+    return hipSuccess;
+}
+
+template<
+    class Config,
     class InputIterator,
     class OutputIterator,
     class OffsetIterator,
@@ -105,30 +379,50 @@ hipError_t segmented_reduce_impl(void * temporary_storage,
     using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
     #endif
 
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 8;
+    // Small problems with host-accessible data may be processed on the host,
+    // their size is the number of segments
+    using host_fallback = detail::host_fallback_traits<Config>;
+    using host_fallback_enabled = std::integral_constant<bool, (host_fallback::max_size > 0)>;
 
-    if(temporary_storage == nullptr)
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        typename host_fallback::config,
+        default_segmented_reduce_config<result_type>
+    >;
+
+    if(temporary_storage != nullptr
+       && detail::use_host_fallback(
+           host_fallback_enabled(), host_fallback::max_size, segments,
+           input, output, begin_offsets, end_offsets
+       ))
     {
-        // Make sure user won't try to allocate 0 bytes memory, because
-        // hipMalloc will return nullptr when size is zero.
-        storage_size = 4;
+        // Results of preceding operations in the stream must be visible on the host
+        auto error = hipStreamSynchronize(stream);
+        if(error != hipSuccess) return error;
+        std::chrono::high_resolution_clock::time_point start;
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        host_segmented_reduce(
+            host_fallback_enabled(),
+            input, output, segments, begin_offsets, end_offsets,
+            static_cast<result_type>(initial_value), reduce_op
+        );
+        if(debug_synchronous)
+        {
+            auto end = std::chrono::high_resolution_clock::now();
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+            std::cout << "host_segmented_reduce(" << segments << ") " << d.count() * 1000 << " ms" << '\n';
+        }
         return hipSuccess;
     }
 
-    std::chrono::high_resolution_clock::time_point start;
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(segmented_reduce_kernel<block_size, items_per_thread, result_type>),
-        dim3(segments), dim3(block_size), 0, stream,
+    return segmented_reduce_launch<config, result_type>(
+        std::integral_constant<bool, segmented_reduce_load_balancing<config>::enabled>(),
+        temporary_storage, storage_size,
         input, output,
-        begin_offsets, end_offsets,
-        reduce_op, initial_value
+        segments, begin_offsets, end_offsets,
+        reduce_op, initial_value,
+        stream, debug_synchronous
     );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce", segments, start);
-
-    return hipSuccess;
 }
 
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
@@ -150,6 +444,12 @@ hipError_t segmented_reduce_impl(void * temporary_storage,
 /// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
 /// <tt>offsets + 1</tt> for \p end_offsets.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config (one block per segment), \p segmented_reduce_config (load-balanced
+/// mode for highly variable segment lengths) or a custom class with the same members.
+/// Wrapped in \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined),
+/// reductions of a small number of segments of host-accessible pointers are performed
+/// on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -228,6 +528,7 @@ hipError_t segmented_reduce_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class OffsetIterator,
@@ -247,7 +548,7 @@ hipError_t segmented_reduce(void * temporary_storage,
                             hipStream_t stream = 0,
                             bool debug_synchronous = false)
 {
-    return detail::segmented_reduce_impl(
+    return detail::segmented_reduce_impl<Config>(
         temporary_storage, storage_size,
         input, output,
         segments, begin_offsets, end_offsets,
@@ -0,0 +1,438 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SEGMENTED_SCAN_CPU_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SEGMENTED_SCAN_CPU_HPP_
+
+#include <type_traits>
+#include <iterator>
+#include <chrono>
+#include <iostream>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../iterator/zip_iterator.hpp"
+#include "../iterator/discard_iterator.hpp"
+#include "../iterator/transform_iterator.hpp"
+#include "../iterator/detail/replace_first_iterator.hpp"
+#include "../types/tuple.hpp"
+
+#include "config_types.hpp"
+#include "cpu_types.hpp"
+#include "device_scan_config.hpp"
+#include "device_scan_cpu.hpp"
+#include "detail/cpu_thread_pool.hpp"
+#include "detail/segmented_scan_flag_wrapper_op.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_cpu
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_CPU_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<
+    bool Exclusive,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+error_t segmented_scan_impl(void * temporary_storage,
+                            size_t& storage_size,
+                            InputIterator input,
+                            OutputIterator output,
+                            const unsigned int segments,
+                            OffsetIterator begin_offsets,
+                            OffsetIterator end_offsets,
+                            const InitValueType initial_value,
+                            BinaryFunction scan_op,
+                            const stream_t /* stream */,
+                            const bool debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<BinaryFunction, input_type, input_type>::type;
+    #else
+    using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
+    #endif
+
+    if(temporary_storage == nullptr)
+    {
+        // No temporary storage is needed, but make sure user won't try to allocate 0 bytes memory
+        storage_size = 4;
+        return success;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        std::cout << "threads " << get_cpu_thread_pool().size() << '\n';
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    const cpu_partition partition(segments, 16);
+    cpu_parallel_for(
+        partition.blocks,
+        [&](size_t block)
+        {
+            for(size_t segment = partition.begin(block); segment < partition.end(block); segment++)
+            {
+                const size_t begin = begin_offsets[segment];
+                const size_t end = end_offsets[segment];
+                if(end <= begin) continue;
+                cpu_scan_block<Exclusive>(
+                    input, output, begin, end,
+                    static_cast<result_type>(initial_value), Exclusive,
+                    scan_op
+                );
+            }
+        }
+    );
+    ROCPRIM_DETAIL_CPU_SYNC("segmented_scan", segments, start)
+    return success;
+}
+
+#undef ROCPRIM_DETAIL_CPU_SYNC
+
+} // end of detail namespace
+
+/// \brief CPU parallel segmented inclusive scan primitive for device level.
+///
+/// segmented_inclusive_scan function performs a device-wide inclusive scan operation
+/// across multiple sequences from \p input using binary \p scan_op operator on host threads.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input and \p output must have at least \p size elements.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of \p InputIterator.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to scan.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] scan_op - binary operation function object that will be used for scan.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>
+>
+inline
+error_t segmented_inclusive_scan(void * temporary_storage,
+                                 size_t& storage_size,
+                                 InputIterator input,
+                                 OutputIterator output,
+                                 unsigned int segments,
+                                 OffsetIterator begin_offsets,
+                                 OffsetIterator end_offsets,
+                                 BinaryFunction scan_op = BinaryFunction(),
+                                 stream_t stream = 0,
+                                 bool debug_synchronous = false)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<BinaryFunction, input_type, input_type>::type;
+    #else
+    using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
+    #endif
+
+    return detail::segmented_scan_impl<false>(
+        temporary_storage, storage_size,
+        input, output, segments, begin_offsets, end_offsets, result_type(),
+        scan_op, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel segmented exclusive scan primitive for device level.
+///
+/// segmented_exclusive_scan function performs a device-wide exclusive scan operation
+/// across multiple sequences from \p input using binary \p scan_op operator on host threads.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input and \p output must have at least \p size elements.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets.
+/// \tparam InitValueType - type of the initial value.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of \p InputIterator.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to scan.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] initial_value - initial value to start the scan of every segment.
+/// \param [in] scan_op - binary operation function object that will be used for scan.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>
+>
+inline
+error_t segmented_exclusive_scan(void * temporary_storage,
+                                 size_t& storage_size,
+                                 InputIterator input,
+                                 OutputIterator output,
+                                 unsigned int segments,
+                                 OffsetIterator begin_offsets,
+                                 OffsetIterator end_offsets,
+                                 const InitValueType initial_value,
+                                 BinaryFunction scan_op = BinaryFunction(),
+                                 stream_t stream = 0,
+                                 bool debug_synchronous = false)
+{
+    return detail::segmented_scan_impl<true>(
+        temporary_storage, storage_size,
+        input, output, segments, begin_offsets, end_offsets, initial_value,
+        scan_op, stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel segmented inclusive scan primitive for device level.
+///
+/// segmented_inclusive_scan function performs a device-wide inclusive scan operation
+/// across multiple sequences from \p input using binary \p scan_op operator on host threads.
+/// Beginnings of the segments should be marked by value convertible to \p true at
+/// corresponding position in \p flags range.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input, \p output, and \p flags must have at least \p size elements.
+/// * \p value_type of \p HeadFlagIterator iterator should be convertible to \p bool type.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam HeadFlagIterator - random-access iterator type of flags.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of \p InputIterator.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to scan.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] head_flags - iterator to the first element in the range of head flags marking
+/// beginnings of each segment in the input range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] scan_op - binary operation function object that will be used for scan.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class HeadFlagIterator,
+    class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>
+>
+inline
+error_t segmented_inclusive_scan(void * temporary_storage,
+                                 size_t& storage_size,
+                                 InputIterator input,
+                                 OutputIterator output,
+                                 HeadFlagIterator head_flags,
+                                 size_t size,
+                                 BinaryFunction scan_op = BinaryFunction(),
+                                 stream_t stream = 0,
+                                 bool debug_synchronous = false)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    using flag_type = typename std::iterator_traits<HeadFlagIterator>::value_type;
+    using segmented_scan_flag_wrapper_op_type =
+        detail::segmented_scan_flag_wrapper_op<
+            input_type, flag_type, BinaryFunction
+        >;
+
+    return inclusive_scan<Config>(
+        temporary_storage, storage_size,
+        ::rocprim::make_zip_iterator(::rocprim::make_tuple(input, head_flags)),
+        ::rocprim::make_zip_iterator(
+            ::rocprim::make_tuple(output, ::rocprim::make_discard_iterator())
+        ),
+        size, segmented_scan_flag_wrapper_op_type(scan_op),
+        stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel segmented exclusive scan primitive for device level.
+///
+/// segmented_exclusive_scan function performs a device-wide exclusive scan operation
+/// across multiple sequences from \p input using binary \p scan_op operator on host threads.
+/// Beginnings of the segments should be marked by value convertible to \p true at
+/// corresponding position in \p flags range.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input, \p output, and \p flags must have at least \p size elements.
+/// * \p value_type of \p HeadFlagIterator iterator should be convertible to \p bool type.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam InitValueType - type of the initial value.
+/// \tparam HeadFlagIterator - random-access iterator type of flags.
+/// \tparam BinaryFunction - type of binary function used for scan. Default type
+/// is \p rocprim::plus<T>, where \p T is a \p value_type of \p InputIterator.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the scan operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to scan.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] head_flags - iterator to the first element in the range of head flags marking
+/// beginnings of each segment in the input range.
+/// \param [in] initial_value - initial value to start the scan of every segment.
+/// \param [in] size - number of element in the input range.
+/// \param [in] scan_op - binary operation function object that will be used for scan.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class InitValueType,
+    class HeadFlagIterator,
+    class BinaryFunction = ::rocprim::plus<typename std::iterator_traits<InputIterator>::value_type>
+>
+inline
+error_t segmented_exclusive_scan(void * temporary_storage,
+                                 size_t& storage_size,
+                                 InputIterator input,
+                                 OutputIterator output,
+                                 HeadFlagIterator head_flags,
+                                 const InitValueType initial_value,
+                                 size_t size,
+                                 BinaryFunction scan_op = BinaryFunction(),
+                                 stream_t stream = 0,
+                                 bool debug_synchronous = false)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    using flag_type = typename std::iterator_traits<HeadFlagIterator>::value_type;
+    using segmented_scan_flag_wrapper_op_type =
+        detail::segmented_scan_flag_wrapper_op<
+            input_type, flag_type, BinaryFunction
+        >;
+
+    return inclusive_scan<Config>(
+        temporary_storage, storage_size,
+        // Shifts input one item to the right and replaces heads of segments with
+        // initial_value (see segmented_exclusive_scan of the HIP backend)
+        ::rocprim::make_transform_iterator(
+            ::rocprim::make_zip_iterator(
+                ::rocprim::make_tuple(
+                    detail::replace_first_iterator<InputIterator>(input - 1, initial_value),
+                    head_flags
+                )
+            ),
+            [initial_value](const ::rocprim::tuple<input_type, flag_type>& t)
+                -> ::rocprim::tuple<input_type, flag_type>
+            {
+                if(::rocprim::get<1>(t))
+                {
+                    return ::rocprim::make_tuple(
+                        static_cast<input_type>(initial_value),
+                        ::rocprim::get<1>(t)
+                    );
+                }
+                return t;
+            }
+        ),
+        ::rocprim::make_zip_iterator(
+            ::rocprim::make_tuple(output, ::rocprim::make_discard_iterator())
+        ),
+        size, segmented_scan_flag_wrapper_op_type(scan_op),
+        stream, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule_cpu
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_SEGMENTED_SCAN_CPU_HPP_
@@ -27,6 +27,7 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 
+#include "../iterator/counting_iterator.hpp"
 #include "../iterator/zip_iterator.hpp"
 #include "../iterator/discard_iterator.hpp"
 #include "../iterator/transform_iterator.hpp"
@@ -34,6 +35,7 @@
 #include "../types/tuple.hpp"
 
 #include "device_scan_hc.hpp"
+#include "device_scan_config.hpp"
 #include "detail/device_segmented_scan.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -56,10 +58,11 @@ namespace detail
         } \
     }
 
+// One block per segment
 template<
     bool Exclusive,
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
+    class Config,
+    class ResultType,
     class InputIterator,
     class OutputIterator,
     class OffsetIterator,
@@ -67,27 +70,21 @@ template<
     class BinaryFunction
 >
 inline
-void segmented_scan_impl(void * temporary_storage,
-                         size_t& storage_size,
-                         InputIterator input,
-                         OutputIterator output,
-                         unsigned int segments,
-                         OffsetIterator begin_offsets,
-                         OffsetIterator end_offsets,
-                         const InitValueType initial_value,
-                         BinaryFunction scan_op,
-                         hc::accelerator_view acc_view,
-                         const bool debug_synchronous)
+void segmented_scan_launch(std::false_type /* load balanced */,
+                           void * temporary_storage,
+                           size_t& storage_size,
+                           InputIterator input,
+                           OutputIterator output,
+                           unsigned int segments,
+                           OffsetIterator begin_offsets,
+                           OffsetIterator end_offsets,
+                           const InitValueType initial_value,
+                           BinaryFunction scan_op,
+                           hc::accelerator_view acc_view,
+                           const bool debug_synchronous)
 {
-    using input_type = typename std::iterator_traits<InputIterator>::value_type;
-    #ifdef __cpp_lib_is_invocable
-    using result_type = typename std::invoke_result<BinaryFunction, input_type, input_type>::type;
-    #else
-    using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
-    #endif
-
-    constexpr unsigned int block_size = BlockSize;
-    constexpr unsigned int items_per_thread = ItemsPerThread;
+    constexpr unsigned int block_size = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
 
     if(temporary_storage == nullptr)
     {
@@ -97,6 +94,11 @@ void segmented_scan_impl(void * temporary_storage,
         return;
     }
 
+    if(segments == 0)
+    {
+        return;
+    }
+
     std::chrono::high_resolution_clock::time_point start;
     if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
     hc::parallel_for_each(
@@ -104,16 +106,199 @@ void segmented_scan_impl(void * temporary_storage,
         hc::tiled_extent<1>(segments * block_size, block_size),
         [=](hc::tiled_index<1>) [[hc]]
         {
-            segmented_scan<Exclusive, block_size, items_per_thread, result_type>(
+            segmented_scan<Exclusive, block_size, items_per_thread, ResultType>(
                 input, output,
                 begin_offsets, end_offsets,
-                static_cast<result_type>(initial_value), scan_op
+                static_cast<ResultType>(initial_value), scan_op
             );
         }
     );
     ROCPRIM_DETAIL_HC_SYNC("segmented_scan", segments, start);
 }
 
+// Small segments are scanned by logical warps, tiles of long segments are distributed
+// evenly among a fixed number of blocks
+template<
+    bool Exclusive,
+    class Config,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+void segmented_scan_launch(std::true_type /* load balanced */,
+                           void * temporary_storage,
+                           size_t& storage_size,
+                           InputIterator input,
+                           OutputIterator output,
+                           unsigned int segments,
+                           OffsetIterator begin_offsets,
+                           OffsetIterator end_offsets,
+                           const InitValueType initial_value,
+                           BinaryFunction scan_op,
+                           hc::accelerator_view acc_view,
+                           const bool debug_synchronous)
+{
+    constexpr unsigned int block_size = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int warp_scan_size = segmented_scan_load_balancing<Config>::warp_scan_size;
+    constexpr unsigned int small_segment_size = segmented_scan_load_balancing<Config>::small_segment_size;
+    constexpr unsigned int items_per_tile = block_size * items_per_thread;
+    constexpr unsigned int small_segments_per_block = block_size / warp_scan_size;
+    // Enough blocks to occupy all compute units while the tiles kernels run
+    constexpr unsigned int tiles_blocks_per_compute_unit = 4;
+
+    static_assert(
+        warp_scan_size <= ::rocprim::warp_size() && block_size % warp_scan_size == 0,
+        "warp_scan_size must not exceed the hardware warp size and must divide block_size"
+    );
+
+    const unsigned int compute_units = acc_view.get_accelerator().get_cu_count();
+    const unsigned int tiles_grid_size = compute_units * tiles_blocks_per_compute_unit;
+
+    const segmented_reduce_tiles_op<OffsetIterator> tiles_op {
+        begin_offsets, end_offsets, segments, small_segment_size, items_per_tile
+    };
+    auto tiles_input = ::rocprim::make_transform_iterator(
+        ::rocprim::make_counting_iterator<unsigned int>(0), tiles_op
+    );
+    unsigned int * tile_offsets = nullptr;
+
+    size_t scan_bytes;
+    ::rocprim::exclusive_scan(
+        nullptr, scan_bytes,
+        tiles_input, tile_offsets, 0U, segments + 1,
+        ::rocprim::plus<unsigned int>(),
+        acc_view, debug_synchronous
+    );
+
+    const size_t nested_bytes = ::rocprim::detail::align_size(scan_bytes);
+    const size_t tile_offsets_bytes = ::rocprim::detail::align_size((segments + 1) * sizeof(unsigned int));
+    const size_t partials_bytes = ::rocprim::detail::align_size(tiles_grid_size * sizeof(ResultType));
+    if(temporary_storage == nullptr)
+    {
+        storage_size = nested_bytes + tile_offsets_bytes + partials_bytes;
+        return;
+    }
+
+    if(segments == 0)
+    {
+        return;
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    void * nested_storage = ptr;
+    ptr += nested_bytes;
+    tile_offsets = reinterpret_cast<unsigned int *>(ptr);
+    ptr += tile_offsets_bytes;
+    ResultType * partials = reinterpret_cast<ResultType *>(ptr);
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    const unsigned int small_grid_size = ::rocprim::detail::ceiling_div(segments, small_segments_per_block);
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(small_grid_size * block_size, block_size),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            segmented_scan_small<Exclusive, block_size, warp_scan_size, small_segment_size, ResultType>(
+                input, output,
+                segments, begin_offsets, end_offsets,
+                initial_value, scan_op
+            );
+        }
+    );
+    ROCPRIM_DETAIL_HC_SYNC("segmented_scan_small", segments, start);
+
+    ::rocprim::exclusive_scan(
+        nested_storage, scan_bytes,
+        tiles_input, tile_offsets, 0U, segments + 1,
+        ::rocprim::plus<unsigned int>(),
+        acc_view, debug_synchronous
+    );
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(tiles_grid_size * block_size, block_size),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            segmented_scan_tiles_reduce<block_size, items_per_thread>(
+                input,
+                segments, begin_offsets,
+                tile_offsets, partials,
+                scan_op
+            );
+        }
+    );
+    ROCPRIM_DETAIL_HC_SYNC("segmented_scan_tiles_reduce", tiles_grid_size, start);
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hc::parallel_for_each(
+        acc_view,
+        hc::tiled_extent<1>(tiles_grid_size * block_size, block_size),
+        [=](hc::tiled_index<1>) [[hc]]
+        {
+            segmented_scan_tiles<Exclusive, block_size, items_per_thread>(
+                input, output,
+                segments, begin_offsets, end_offsets,
+                tile_offsets, partials,
+                initial_value, scan_op
+            );
+        }
+    );
+    ROCPRIM_DETAIL_HC_SYNC("segmented_scan_tiles", tiles_grid_size, start);
+}
+
+template<
+    bool Exclusive,
+    class Config,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+void segmented_scan_impl(void * temporary_storage,
+                         size_t& storage_size,
+                         InputIterator input,
+                         OutputIterator output,
+                         unsigned int segments,
+                         OffsetIterator begin_offsets,
+                         OffsetIterator end_offsets,
+                         const InitValueType initial_value,
+                         BinaryFunction scan_op,
+                         hc::accelerator_view acc_view,
+                         const bool debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<BinaryFunction, input_type, input_type>::type;
+    #else
+    using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
+    #endif
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_segmented_scan_config<result_type>
+    >;
+
+    segmented_scan_launch<Exclusive, config, result_type>(
+        std::integral_constant<bool, segmented_scan_load_balancing<config>::enabled>(),
+        temporary_storage, storage_size,
+        input, output,
+        segments, begin_offsets, end_offsets,
+        initial_value, scan_op,
+        acc_view, debug_synchronous
+    );
+}
+
 #undef ROCPRIM_DETAIL_HC_SYNC
 
 } // end of detail namespace
@@ -132,6 +317,9 @@ void segmented_scan_impl(void * temporary_storage,
 /// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
 /// <tt>offsets + 1</tt> for \p end_offsets.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config (one block per segment), \p segmented_scan_config (load-balanced
+/// mode for highly variable segment lengths) or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -206,6 +394,7 @@ void segmented_scan_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class OffsetIterator,
@@ -230,10 +419,7 @@ void segmented_inclusive_scan(void * temporary_storage,
     using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
     #endif
 
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 8;
-    return detail::segmented_scan_impl<false, block_size, items_per_thread>(
+    return detail::segmented_scan_impl<false, Config>(
         temporary_storage, storage_size,
         input, output, segments, begin_offsets, end_offsets, result_type(),
         scan_op, acc_view, debug_synchronous
@@ -254,6 +440,9 @@ void segmented_inclusive_scan(void * temporary_storage,
 /// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
 /// <tt>offsets + 1</tt> for \p end_offsets.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config (one block per segment), \p segmented_scan_config (load-balanced
+/// mode for highly variable segment lengths) or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -331,6 +520,7 @@ void segmented_inclusive_scan(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class OffsetIterator,
@@ -350,10 +540,7 @@ void segmented_exclusive_scan(void * temporary_storage,
                               hc::accelerator_view acc_view = hc::accelerator().get_default_view(),
                               const bool debug_synchronous = false)
 {
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 8;
-    return detail::segmented_scan_impl<true, block_size, items_per_thread>(
+    return detail::segmented_scan_impl<true, Config>(
         temporary_storage, storage_size,
         input, output, segments, begin_offsets, end_offsets, initial_value,
         scan_op, acc_view, debug_synchronous
@@ -373,6 +560,8 @@ void segmented_exclusive_scan(void * temporary_storage,
 /// * Ranges specified by \p input, \p output, and \p flags must have at least \p size elements.
 /// * \p value_type of \p HeadFlagIterator iterator should be convertible to \p bool type.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -438,6 +627,7 @@ void segmented_exclusive_scan(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class HeadFlagIterator,
@@ -461,7 +651,7 @@ void segmented_inclusive_scan(void * temporary_storage,
             input_type, flag_type, BinaryFunction
         >;
 
-    return inclusive_scan(
+    return inclusive_scan<Config>(
         temporary_storage, storage_size,
         make_zip_iterator(make_tuple(input, head_flags)),
         make_zip_iterator(make_tuple(output, make_discard_iterator())),
@@ -483,6 +673,8 @@ void segmented_inclusive_scan(void * temporary_storage,
 /// * Ranges specified by \p input, \p output, and \p flags must have at least \p size elements.
 /// * \p value_type of \p HeadFlagIterator iterator should be convertible to \p bool type.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -551,6 +743,7 @@ void segmented_inclusive_scan(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class HeadFlagIterator,
@@ -576,7 +769,7 @@ void segmented_exclusive_scan(void * temporary_storage,
             input_type, flag_type, BinaryFunction
         >;
 
-    return inclusive_scan(
+    return inclusive_scan<Config>(
         temporary_storage, storage_size,
         // Using replace_first_iterator shifts input one item to left and replaces
         // first value with initial_value. Then transform_iterator replaces last
@@ -27,12 +27,15 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 
+#include "../iterator/counting_iterator.hpp"
 #include "../iterator/zip_iterator.hpp"
 #include "../iterator/discard_iterator.hpp"
 #include "../iterator/transform_iterator.hpp"
 #include "../iterator/detail/replace_first_iterator.hpp"
 #include "../types/tuple.hpp"
 
+#include "device_scan_config.hpp"
+#include "device_scan_hip.hpp"
 #include "detail/device_segmented_scan.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -69,6 +72,88 @@ void segmented_scan_kernel(InputIterator input,
     );
 }
 
+template<
+    bool Exclusive,
+    unsigned int BlockSize,
+    unsigned int WarpScanSize,
+    unsigned int SmallSegmentSize,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+__global__
+void segmented_scan_small_kernel(InputIterator input,
+                                 OutputIterator output,
+                                 unsigned int segments,
+                                 OffsetIterator begin_offsets,
+                                 OffsetIterator end_offsets,
+                                 InitValueType initial_value,
+                                 BinaryFunction scan_op)
+{
+    segmented_scan_small<Exclusive, BlockSize, WarpScanSize, SmallSegmentSize, ResultType>(
+        input, output,
+        segments, begin_offsets, end_offsets,
+        initial_value, scan_op
+    );
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class ResultType,
+    class InputIterator,
+    class OffsetIterator,
+    class BinaryFunction
+>
+__global__
+void segmented_scan_tiles_reduce_kernel(InputIterator input,
+                                        unsigned int segments,
+                                        OffsetIterator begin_offsets,
+                                        const unsigned int * tile_offsets,
+                                        ResultType * partials,
+                                        BinaryFunction scan_op)
+{
+    segmented_scan_tiles_reduce<BlockSize, ItemsPerThread>(
+        input,
+        segments, begin_offsets,
+        tile_offsets, partials,
+        scan_op
+    );
+}
+
+template<
+    bool Exclusive,
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+__global__
+void segmented_scan_tiles_kernel(InputIterator input,
+                                 OutputIterator output,
+                                 unsigned int segments,
+                                 OffsetIterator begin_offsets,
+                                 OffsetIterator end_offsets,
+                                 const unsigned int * tile_offsets,
+                                 const ResultType * partials,
+                                 InitValueType initial_value,
+                                 BinaryFunction scan_op)
+{
+    segmented_scan_tiles<Exclusive, BlockSize, ItemsPerThread>(
+        input, output,
+        segments, begin_offsets, end_offsets,
+        tile_offsets, partials,
+        initial_value, scan_op
+    );
+}
+
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
     { \
         auto error = hipPeekAtLastError(); \
@@ -84,10 +169,197 @@ void segmented_scan_kernel(InputIterator input,
         } \
     }
 
+// One block per segment
 template<
     bool Exclusive,
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
+    class Config,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+hipError_t segmented_scan_launch(std::false_type /* load balanced */,
+                                 void * temporary_storage,
+                                 size_t& storage_size,
+                                 InputIterator input,
+                                 OutputIterator output,
+                                 unsigned int segments,
+                                 OffsetIterator begin_offsets,
+                                 OffsetIterator end_offsets,
+                                 const InitValueType initial_value,
+                                 BinaryFunction scan_op,
+                                 hipStream_t stream,
+                                 bool debug_synchronous)
+{
+    constexpr unsigned int block_size = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+
+    if(temporary_storage == nullptr)
+    {
+        // Make sure user won't try to allocate 0 bytes memory, because
+        // hipMalloc will return nullptr when size is zero.
+        storage_size = 4;
+        return hipSuccess;
+    }
+
+    if(segments == 0)
+    {
+        return hipSuccess;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(segmented_scan_kernel<Exclusive, block_size, items_per_thread, ResultType>),
+        dim3(segments), dim3(block_size), 0, stream,
+        input, output,
+        begin_offsets, end_offsets,
+        initial_value, scan_op
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_scan", segments, start);
+    return hipSuccess;
+}
+
+// Small segments are scanned by logical warps, tiles of long segments are distributed
+// evenly among a fixed number of blocks
+template<
+    bool Exclusive,
+    class Config,
+    class ResultType,
+    class InputIterator,
+    class OutputIterator,
+    class OffsetIterator,
+    class InitValueType,
+    class BinaryFunction
+>
+inline
+hipError_t segmented_scan_launch(std::true_type /* load balanced */,
+                                 void * temporary_storage,
+                                 size_t& storage_size,
+                                 InputIterator input,
+                                 OutputIterator output,
+                                 unsigned int segments,
+                                 OffsetIterator begin_offsets,
+                                 OffsetIterator end_offsets,
+                                 const InitValueType initial_value,
+                                 BinaryFunction scan_op,
+                                 hipStream_t stream,
+                                 bool debug_synchronous)
+{
+    constexpr unsigned int block_size = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int warp_scan_size = segmented_scan_load_balancing<Config>::warp_scan_size;
+    constexpr unsigned int small_segment_size = segmented_scan_load_balancing<Config>::small_segment_size;
+    constexpr unsigned int items_per_tile = block_size * items_per_thread;
+    constexpr unsigned int small_segments_per_block = block_size / warp_scan_size;
+    // Enough blocks to occupy all compute units while the tiles kernels run
+    constexpr unsigned int tiles_blocks_per_compute_unit = 4;
+
+    static_assert(
+        warp_scan_size <= ::rocprim::warp_size() && block_size % warp_scan_size == 0,
+        "warp_scan_size must not exceed the hardware warp size and must divide block_size"
+    );
+
+    int device_id;
+    hipError_t error = hipGetDevice(&device_id);
+    if(error != hipSuccess) return error;
+    int compute_units;
+    error = hipDeviceGetAttribute(&compute_units, hipDeviceAttributeMultiprocessorCount, device_id);
+    if(error != hipSuccess) return error;
+    const unsigned int tiles_grid_size = compute_units * tiles_blocks_per_compute_unit;
+
+    const segmented_reduce_tiles_op<OffsetIterator> tiles_op {
+        begin_offsets, end_offsets, segments, small_segment_size, items_per_tile
+    };
+    auto tiles_input = ::rocprim::make_transform_iterator(
+        ::rocprim::make_counting_iterator<unsigned int>(0), tiles_op
+    );
+    unsigned int * tile_offsets = nullptr;
+
+    size_t scan_bytes;
+    error = ::rocprim::exclusive_scan(
+        nullptr, scan_bytes,
+        tiles_input, tile_offsets, 0U, segments + 1,
+        ::rocprim::plus<unsigned int>(),
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    const size_t nested_bytes = ::rocprim::detail::align_size(scan_bytes);
+    const size_t tile_offsets_bytes = ::rocprim::detail::align_size((segments + 1) * sizeof(unsigned int));
+    const size_t partials_bytes = ::rocprim::detail::align_size(tiles_grid_size * sizeof(ResultType));
+    if(temporary_storage == nullptr)
+    {
+        storage_size = nested_bytes + tile_offsets_bytes + partials_bytes;
+        return hipSuccess;
+    }
+
+    if(segments == 0)
+    {
+        return hipSuccess;
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    void * nested_storage = ptr;
+    ptr += nested_bytes;
+    tile_offsets = reinterpret_cast<unsigned int *>(ptr);
+    ptr += tile_offsets_bytes;
+    ResultType * partials = reinterpret_cast<ResultType *>(ptr);
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(segmented_scan_small_kernel<
+            Exclusive, block_size, warp_scan_size, small_segment_size, ResultType
+        >),
+        dim3(::rocprim::detail::ceiling_div(segments, small_segments_per_block)),
+        dim3(block_size), 0, stream,
+        input, output,
+        segments, begin_offsets, end_offsets,
+        initial_value, scan_op
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_scan_small", segments, start);
+
+    error = ::rocprim::exclusive_scan(
+        nested_storage, scan_bytes,
+        tiles_input, tile_offsets, 0U, segments + 1,
+        ::rocprim::plus<unsigned int>(),
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(segmented_scan_tiles_reduce_kernel<block_size, items_per_thread, ResultType>),
+        dim3(tiles_grid_size), dim3(block_size), 0, stream,
+        input,
+        segments, begin_offsets,
+        tile_offsets, partials,
+        scan_op
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_scan_tiles_reduce", tiles_grid_size, start);
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(segmented_scan_tiles_kernel<Exclusive, block_size, items_per_thread, ResultType>),
+        dim3(tiles_grid_size), dim3(block_size), 0, stream,
+        input, output,
+        segments, begin_offsets, end_offsets,
+        tile_offsets, partials,
+        initial_value, scan_op
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_scan_tiles", tiles_grid_size, start);
+
+    return hipSuccess;
+}
+
+template<
+    bool Exclusive,
+    class Config,
     class InputIterator,
     class OutputIterator,
     class OffsetIterator,
@@ -114,28 +386,20 @@ hipError_t segmented_scan_impl(void * temporary_storage,
     using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
     #endif
 
-    constexpr unsigned int block_size = BlockSize;
-    constexpr unsigned int items_per_thread = ItemsPerThread;
-
-    if(temporary_storage == nullptr)
-    {
-        // Make sure user won't try to allocate 0 bytes memory, because
-        // hipMalloc will return nullptr when size is zero.
-        storage_size = 4;
-        return hipSuccess;
-    }
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        Config,
+        default_segmented_scan_config<result_type>
+    >;
 
-    std::chrono::high_resolution_clock::time_point start;
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(segmented_scan_kernel<Exclusive, block_size, items_per_thread, result_type>),
-        dim3(segments), dim3(block_size), 0, stream,
+    return segmented_scan_launch<Exclusive, config, result_type>(
+        std::integral_constant<bool, segmented_scan_load_balancing<config>::enabled>(),
+        temporary_storage, storage_size,
         input, output,
-        begin_offsets, end_offsets,
-        initial_value, scan_op
+        segments, begin_offsets, end_offsets,
+        initial_value, scan_op,
+        stream, debug_synchronous
     );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_scan", segments, start);
-    return hipSuccess;
 }
 
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
@@ -156,6 +420,9 @@ hipError_t segmented_scan_impl(void * temporary_storage,
 /// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
 /// <tt>offsets + 1</tt> for \p end_offsets.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config (one block per segment), \p segmented_scan_config (load-balanced
+/// mode for highly variable segment lengths) or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -227,6 +494,7 @@ hipError_t segmented_scan_impl(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class OffsetIterator,
@@ -251,10 +519,7 @@ hipError_t segmented_inclusive_scan(void * temporary_storage,
     using result_type = typename std::result_of<BinaryFunction(input_type, input_type)>::type;
     #endif
 
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 8;
-    return detail::segmented_scan_impl<false, block_size, items_per_thread>(
+    return detail::segmented_scan_impl<false, Config>(
         temporary_storage, storage_size,
         input, output, segments, begin_offsets, end_offsets, result_type(),
         scan_op, stream, debug_synchronous
@@ -275,6 +540,9 @@ hipError_t segmented_inclusive_scan(void * temporary_storage,
 /// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
 /// <tt>offsets + 1</tt> for \p end_offsets.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config (one block per segment), \p segmented_scan_config (load-balanced
+/// mode for highly variable segment lengths) or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -351,6 +619,7 @@ hipError_t segmented_inclusive_scan(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class OffsetIterator,
@@ -370,10 +639,7 @@ hipError_t segmented_exclusive_scan(void * temporary_storage,
                                     hipStream_t stream = 0,
                                     bool debug_synchronous = false)
 {
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 8;
-    return detail::segmented_scan_impl<true, block_size, items_per_thread>(
+    return detail::segmented_scan_impl<true, Config>(
         temporary_storage, storage_size,
         input, output, segments, begin_offsets, end_offsets, initial_value,
         scan_op, stream, debug_synchronous
@@ -393,6 +659,8 @@ hipError_t segmented_exclusive_scan(void * temporary_storage,
 /// * Ranges specified by \p input, \p output, and \p flags must have at least \p size elements.
 /// * \p value_type of \p HeadFlagIterator iterator should be convertible to \p bool type.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -457,6 +725,7 @@ hipError_t segmented_exclusive_scan(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class HeadFlagIterator,
@@ -480,7 +749,7 @@ hipError_t segmented_inclusive_scan(void * temporary_storage,
             input_type, flag_type, BinaryFunction
         >;
 
-    return inclusive_scan(
+    return inclusive_scan<Config>(
         temporary_storage, storage_size,
         make_zip_iterator(make_tuple(input, head_flags)),
         make_zip_iterator(make_tuple(output, make_discard_iterator())),
@@ -502,6 +771,8 @@ hipError_t segmented_inclusive_scan(void * temporary_storage,
 /// * Ranges specified by \p input, \p output, and \p flags must have at least \p size elements.
 /// * \p value_type of \p HeadFlagIterator iterator should be convertible to \p bool type.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ RandomAccessIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -569,6 +840,7 @@ hipError_t segmented_inclusive_scan(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class InitValueType,
@@ -594,7 +866,7 @@ hipError_t segmented_exclusive_scan(void * temporary_storage,
             input_type, flag_type, BinaryFunction
         >;
 
-    return inclusive_scan(
+    return inclusive_scan<Config>(
         temporary_storage, storage_size,
         // input:                         [1, 2, 3, 4, 5, 6, 7, 8]
         // replace_first_iterator(input): [9, 1, 2, 3, 4, 5, 6, 7]
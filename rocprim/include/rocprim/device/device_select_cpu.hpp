@@ -0,0 +1,333 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SELECT_CPU_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SELECT_CPU_HPP_
+
+#include <type_traits>
+#include <iterator>
+#include <chrono>
+#include <iostream>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../functional.hpp"
+
+#include "config_types.hpp"
+#include "cpu_types.hpp"
+#include "detail/cpu_thread_pool.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule_cpu
+/// @{
+
+namespace detail
+{
+
+#define ROCPRIM_DETAIL_CPU_SYNC(name, size, start) \
+    { \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto end = std::chrono::high_resolution_clock::now(); \
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start); \
+            std::cout << " " << d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+// Copies input[i] for which is_selected(i) is true: selected items are counted
+// in every block, then blocks write them starting from prefix sums of their counts
+template<
+    class InputIterator,
+    class OutputIterator,
+    class SelectedCountOutputIterator,
+    class IsSelected
+>
+inline
+error_t select_impl(void * temporary_storage,
+                    size_t& storage_size,
+                    InputIterator input,
+                    OutputIterator output,
+                    SelectedCountOutputIterator selected_count_output,
+                    const size_t size,
+                    IsSelected is_selected,
+                    const char * name,
+                    const stream_t /* stream */,
+                    const bool debug_synchronous)
+{
+    const cpu_partition partition(size);
+
+    if(temporary_storage == nullptr)
+    {
+        storage_size = ::rocprim::detail::align_size(partition.blocks * sizeof(size_t));
+        // Make sure user won't try to allocate 0 bytes memory
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return success;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+    {
+        std::cout << "threads " << get_cpu_thread_pool().size() << '\n';
+        std::cout << "blocks " << partition.blocks << '\n';
+        std::cout << "block_size " << partition.block_size << '\n';
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    size_t * offsets = reinterpret_cast<size_t *>(temporary_storage);
+    cpu_parallel_for(
+        partition.blocks,
+        [&](size_t block)
+        {
+            size_t count = 0;
+            for(size_t i = partition.begin(block); i < partition.end(block); i++)
+            {
+                count += is_selected(i) ? 1 : 0;
+            }
+            offsets[block] = count;
+        }
+    );
+
+    size_t selected_count = 0;
+    for(size_t block = 0; block < partition.blocks; block++)
+    {
+        const size_t count = offsets[block];
+        offsets[block] = selected_count;
+        selected_count += count;
+    }
+
+    cpu_parallel_for(
+        partition.blocks,
+        [&](size_t block)
+        {
+            size_t offset = offsets[block];
+            for(size_t i = partition.begin(block); i < partition.end(block); i++)
+            {
+                if(is_selected(i))
+                {
+                    output[offset++] = input[i];
+                }
+            }
+        }
+    );
+    *selected_count_output = selected_count;
+    ROCPRIM_DETAIL_CPU_SYNC(name, size, start)
+    return success;
+}
+
+#undef ROCPRIM_DETAIL_CPU_SYNC
+
+} // end of detail namespace
+
+/// \brief CPU parallel select primitive for device level using range of flags.
+///
+/// Performs a device-wide selection based on input \p flags on host threads. If a value
+/// from \p input should be selected and copied into \p output range the corresponding
+/// item from \p flags range should be set to such value that can be implicitly converted
+/// to \p true (\p bool type).
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input and \p flags must have at least \p size elements.
+/// * Range specified by \p output must have at least so many elements, that all positively
+/// flagged values can be copied into it.
+/// * Relative order is preserved for the elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam FlagIterator - random-access iterator type of the flag range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam SelectedCountOutputIterator - random-access iterator type of the selected_count_output
+/// value.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the select operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to select values from.
+/// \param [in] flags - iterator to the selection flag corresponding to the first element from \p input range.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [out] selected_count_output - iterator to the total number of selected values (length of \p output).
+/// \param [in] size - number of element in the input range.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class FlagIterator,
+    class OutputIterator,
+    class SelectedCountOutputIterator
+>
+inline
+error_t select(void * temporary_storage,
+               size_t& storage_size,
+               InputIterator input,
+               FlagIterator flags,
+               OutputIterator output,
+               SelectedCountOutputIterator selected_count_output,
+               const size_t size,
+               const stream_t stream = 0,
+               const bool debug_synchronous = false)
+{
+    return detail::select_impl(
+        temporary_storage, storage_size,
+        input, output, selected_count_output, size,
+        [flags](size_t i) -> bool { return flags[i]; },
+        "select", stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel select primitive for device level using selection operator.
+///
+/// Performs a device-wide selection using selection operator on host threads. If a value
+/// \p x from \p input should be selected and copied into \p output range, then
+/// <tt>select_op(x)</tt> has to return \p true.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p input must have at least \p size elements.
+/// * Relative order is preserved for the elements.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam SelectedCountOutputIterator - random-access iterator type of the selected_count_output
+/// value.
+/// \tparam SelectOp - type of a unary selection operator.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the select operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to select values from.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [out] selected_count_output - iterator to the total number of selected values (length of \p output).
+/// \param [in] size - number of element in the input range.
+/// \param [in] select_op - unary function object which returns \p true if the element
+/// should be copied to \p output.
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class SelectedCountOutputIterator,
+    class SelectOp
+>
+inline
+error_t select(void * temporary_storage,
+               size_t& storage_size,
+               InputIterator input,
+               OutputIterator output,
+               SelectedCountOutputIterator selected_count_output,
+               const size_t size,
+               SelectOp select_op,
+               const stream_t stream = 0,
+               const bool debug_synchronous = false)
+{
+    return detail::select_impl(
+        temporary_storage, storage_size,
+        input, output, selected_count_output, size,
+        [input, select_op](size_t i) -> bool { return select_op(input[i]); },
+        "select", stream, debug_synchronous
+    );
+}
+
+/// \brief CPU parallel unique primitive for device level.
+///
+/// From given \p input range unique primitive eliminates all but the first element from every
+/// consecutive group of equivalent elements and copies them into \p output on host threads.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p input must have at least \p size elements.
+/// * Range specified by \p output must have at least so many elements, that all selected
+/// values can be copied into it.
+///
+/// \tparam Config - [optional] ignored by the CPU backend.
+/// \tparam InputIterator - random-access iterator type of the input range.
+/// \tparam OutputIterator - random-access iterator type of the output range.
+/// \tparam UniqueCountOutputIterator - random-access iterator type of the unique_count_output
+/// value.
+/// \tparam EqualityOp - type of an binary operator used to compare values for equality.
+///
+/// \param [in] temporary_storage - pointer to a temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the unique operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to select values from.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [out] unique_count_output - iterator to the total number of selected values (length of \p output).
+/// \param [in] size - number of element in the input range.
+/// \param [in] equality_op - [optional] binary function object used to compare input values for equality.
+/// The default value is \p EqualityOp().
+/// \param [in] stream - [optional] ignored by the CPU backend, it finishes all work
+/// before returning. Default is \p 0.
+/// \param [in] debug_synchronous - [optional] If true, execution time is printed.
+/// Default value is \p false.
+///
+/// \returns \p rocprim::success (\p 0), the CPU backend does not report errors.
+template<
+    class Config = default_config,
+    class InputIterator,
+    class OutputIterator,
+    class UniqueCountOutputIterator,
+    class EqualityOp = ::rocprim::equal_to<typename std::iterator_traits<InputIterator>::value_type>
+>
+inline
+error_t unique(void * temporary_storage,
+               size_t& storage_size,
+               InputIterator input,
+               OutputIterator output,
+               UniqueCountOutputIterator unique_count_output,
+               const size_t size,
+               EqualityOp equality_op = EqualityOp(),
+               const stream_t stream = 0,
+               const bool debug_synchronous = false)
+{
+    return detail::select_impl(
+        temporary_storage, storage_size,
+        input, output, unique_count_output, size,
+        [input, equality_op](size_t i) -> bool
+        {
+            return i == 0 || !equality_op(input[i - 1], input[i]);
+        },
+        "unique", stream, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule_cpu
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_SELECT_CPU_HPP_
@@ -27,9 +27,9 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 
-#include "../iterator/transform_iterator.hpp"
-
+#include "device_select_config.hpp"
 #include "detail/device_select.hpp"
+#include "detail/device_host_fallback.hpp"
 #include "device_scan_hip.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -41,70 +41,46 @@ namespace detail
 {
 
 template<
+    select_method SelectMethod,
+    bool OnlySelected,
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
     class InputIterator,
     class FlagIterator,
     class OutputIterator,
-    class SelectedCountOutputIterator
->
-__global__
-void scatter_kernel(InputIterator input,
-                    const size_t size,
-                    FlagIterator flags,
-                    unsigned int * indices,
-                    OutputIterator output,
-                    SelectedCountOutputIterator selected_count_output)
-{
-    detail::scatter_kernel_impl<BlockSize, ItemsPerThread>(
-        input, size, flags, indices,
-        output, selected_count_output
-    );
-}
-
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class InputIterator,
-    class OutputIterator,
     class SelectedCountOutputIterator,
-    class SelectOp
+    class SelectOp,
+    class InequalityOp,
+    class LookbackScanState
 >
 __global__
-void scatter_if_kernel(InputIterator input,
-                       const size_t size,
-                       unsigned int * indices,
-                       OutputIterator output,
-                       SelectedCountOutputIterator selected_count_output,
-                       SelectOp select_op)
+void partition_kernel(InputIterator input,
+                      FlagIterator flags,
+                      OutputIterator output,
+                      SelectedCountOutputIterator selected_count_output,
+                      const size_t size,
+                      SelectOp select_op,
+                      InequalityOp inequality_op,
+                      LookbackScanState lookback_scan_state,
+                      const unsigned int number_of_blocks,
+                      ordered_block_id<unsigned int> ordered_bid)
 {
-    detail::scatter_if_kernel_impl<BlockSize, ItemsPerThread>(
-        input, size, indices,
-        output, selected_count_output,
-        select_op
+    partition_kernel_impl<SelectMethod, OnlySelected, BlockSize, ItemsPerThread>(
+        input, flags, output, selected_count_output, size,
+        select_op, inequality_op, lookback_scan_state, number_of_blocks, ordered_bid
     );
 }
 
-template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    class InputIterator,
-    class OutputFlagIterator,
-    class InequalityOp
->
+template<unsigned int Count, class SelectedCountOutputIterator>
 __global__
-void flag_unique_kernel(InputIterator input,
-                        const size_t size,
-                        OutputFlagIterator flags,
-                        InequalityOp inequality_op)
+void partition_empty_kernel(SelectedCountOutputIterator selected_count_output)
 {
-    detail::flag_unique_kernel_impl<BlockSize, ItemsPerThread>(
-        input, size, flags, inequality_op
-    );
+    partition_empty_kernel_impl<Count>(selected_count_output);
 }
 
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
     { \
+        auto error = hipPeekAtLastError(); \
         if(error != hipSuccess) return error; \
         if(debug_synchronous) \
         { \
@@ -117,8 +93,154 @@ void flag_unique_kernel(InputIterator input,
         } \
     }
 
+template<
+    select_method SelectMethod,
+    bool OnlySelected,
+    class Config,
+    class InputIterator,
+    class FlagIterator,
+    class OutputIterator,
+    class SelectedCountOutputIterator,
+    class SelectOp,
+    class InequalityOp
+>
+inline
+hipError_t partition_impl(void * temporary_storage,
+                          size_t& storage_size,
+                          InputIterator input,
+                          FlagIterator flags,
+                          OutputIterator output,
+                          SelectedCountOutputIterator selected_count_output,
+                          const size_t size,
+                          SelectOp select_op,
+                          InequalityOp inequality_op,
+                          const hipStream_t stream,
+                          const bool debug_synchronous)
+{
+    using offset_type = unsigned int;
+    using scan_state_type = detail::lookback_scan_state<offset_type>;
+    using ordered_block_id_type = detail::ordered_block_id<unsigned int>;
+
+    // Small problems with host-accessible data may be processed on the host
+    using host_fallback = detail::host_fallback_traits<Config>;
+    using host_fallback_enabled = std::integral_constant<bool, (host_fallback::max_size > 0)>;
+
+    // Get default config if Config is default_config
+    using config = default_or_custom_config<
+        typename host_fallback::config,
+        default_select_config<
+            typename std::iterator_traits<InputIterator>::value_type
+        >
+    >;
+
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
+    constexpr auto items_per_block = block_size * items_per_thread;
+    const unsigned int number_of_blocks = (size + items_per_block - 1)/items_per_block;
+
+    // Calculate required temporary storage, only look-back state of blocks
+    // and ordered block id counter are needed
+    if(temporary_storage == nullptr)
+    {
+        storage_size = lookback_scan_get_temporary_storage_bytes<scan_state_type>(number_of_blocks);
+        // Make sure user won't try to allocate 0 bytes memory, otherwise
+        // user may again pass nullptr as temporary_storage
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return hipSuccess;
+    }
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(detail::use_host_fallback(
+           host_fallback_enabled(), host_fallback::max_size, size,
+           input, output, selected_count_output
+       )
+       && are_flags_host_accessible<SelectMethod>(flags))
+    {
+        // Results of preceding operations in the stream must be visible on the host
+        auto error = hipStreamSynchronize(stream);
+        if(error != hipSuccess) return error;
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        host_partition<SelectMethod, OnlySelected>(
+            host_fallback_enabled(),
+            input, flags, output, selected_count_output, size,
+            select_op, inequality_op
+        );
+        if(debug_synchronous)
+        {
+            auto end = std::chrono::high_resolution_clock::now();
+            auto d = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+            std::cout << "host_partition(" << size << ") " << d.count() * 1000 << " ms" << '\n';
+        }
+        return hipSuccess;
+    }
+
+    if(size == 0)
+    {
+        // Only the number of selected items (zero) is written for empty input
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(partition_empty_kernel<1, SelectedCountOutputIterator>),
+            dim3(1), dim3(1), 0, stream,
+            selected_count_output
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("partition_empty_kernel", size, start)
+        return hipSuccess;
+    }
+
+    if(debug_synchronous)
+    {
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "number of blocks " << number_of_blocks << '\n';
+        std::cout << "items_per_block " << items_per_block << '\n';
+        std::cout << "temporary storage size " << storage_size << '\n';
+    }
+
+    // Create and initialize lookback_scan_state obj
+    auto scan_state = scan_state_type::create(temporary_storage, number_of_blocks);
+    // Create and initialize ordered_block_id obj
+    auto ptr = reinterpret_cast<char*>(temporary_storage);
+    auto ordered_bid = ordered_block_id_type::create(
+        reinterpret_cast<ordered_block_id_type::id_type*>(
+            ptr + ::rocprim::detail::align_size(scan_state_type::get_storage_size(number_of_blocks))
+        )
+    );
+
+    // Padding of look-back state must be initialized too
+    const unsigned int init_size = ::rocprim::max(number_of_blocks, ::rocprim::warp_size());
+    auto grid_size = (init_size + block_size - 1)/block_size;
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(init_lookback_scan_state_kernel<scan_state_type>),
+        dim3(grid_size), dim3(block_size), 0, stream,
+        scan_state, number_of_blocks, ordered_bid
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state_kernel", number_of_blocks, start)
+
+    grid_size = number_of_blocks;
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(partition_kernel<
+            SelectMethod, OnlySelected, block_size, items_per_thread,
+            InputIterator, FlagIterator,
+            OutputIterator, SelectedCountOutputIterator,
+            SelectOp, InequalityOp, scan_state_type
+        >),
+        dim3(grid_size), dim3(block_size), 0, stream,
+        input, flags, output, selected_count_output, size,
+        select_op, inequality_op, scan_state, number_of_blocks, ordered_bid
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("partition_kernel", size, start)
+
+    return hipSuccess;
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
 } // end detail namespace
 
+
 /// \brief HIP parallel select primitive for device level using range of flags.
 ///
 /// Performs a device-wide selection based on input \p flags. If a value from \p input
@@ -135,6 +257,10 @@ void flag_unique_kernel(InputIterator input,
 /// * Range specified by \p selected_count_output must have at least 1 element.
 /// * Values of \p flag range should be implicitly convertible to `bool` type.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small selections
+/// of host-accessible pointers are performed on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. It can be
 /// a simple pointer type.
 /// \tparam FlagIterator - random-access iterator type of the flag range. It can be
@@ -197,6 +323,7 @@ void flag_unique_kernel(InputIterator input,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class FlagIterator,
     class OutputIterator,
@@ -213,76 +340,11 @@ hipError_t select(void * temporary_storage,
                   const hipStream_t stream = 0,
                   const bool debug_synchronous = false)
 {
-    // Get temporary storage required by scan operation
-    size_t scan_storage_size = 0;
-    unsigned int * dummy_ptr = nullptr;
-    auto error = ::rocprim::exclusive_scan(
-        nullptr, scan_storage_size,
-        flags, dummy_ptr, 0U, size, ::rocprim::plus<unsigned int>(),
-        stream, debug_synchronous
+    // Flags are loaded and converted to bool by the kernel
+    return detail::partition_impl<detail::select_method::flag, true, Config>(
+        temporary_storage, storage_size, input, flags, output, selected_count_output,
+        size, ::rocprim::empty_type(), ::rocprim::empty_type(), stream, debug_synchronous
     );
-    if(error != hipSuccess) return error;
-    // Align
-    scan_storage_size = ::rocprim::detail::align_size(scan_storage_size);
-
-    // Calculate required temporary storage
-    if(temporary_storage == nullptr)
-    {
-        storage_size = scan_storage_size;
-        // Add storage required for indexes
-        storage_size += size * sizeof(unsigned int);
-        // Make sure user won't try to allocate 0 bytes memory, otherwise
-        // user may again pass nullptr as temporary_storage
-        storage_size = storage_size == 0 ? 4 : storage_size;
-        return hipSuccess;
-    }
-
-    // Return for empty input
-    if(size == 0) return hipSuccess;
-
-    // Start point for time measurements
-    std::chrono::high_resolution_clock::time_point start;
-
-    // Calculate output indices to scatter selected values
-    auto indices = reinterpret_cast<unsigned int*>(
-        static_cast<unsigned char*>(temporary_storage) + scan_storage_size
-    );
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    error = ::rocprim::exclusive_scan(
-        temporary_storage, scan_storage_size,
-        flags, indices, 0U, size, ::rocprim::plus<unsigned int>(),
-        stream, debug_synchronous
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("rocprim::exclusive_scan", size, start)
-
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
-    constexpr auto items_per_block = block_size * items_per_thread;
-
-    auto number_of_blocks = (size + items_per_block - 1)/items_per_block;
-    if(debug_synchronous)
-    {
-        std::cout << "block_size " << block_size << '\n';
-        std::cout << "number of blocks " << number_of_blocks << '\n';
-        std::cout << "items_per_block " << items_per_block << '\n';
-        std::cout << "temporary storage size " << storage_size << '\n';
-    }
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(detail::scatter_kernel<
-            block_size, items_per_thread,
-            InputIterator, FlagIterator,
-            OutputIterator, SelectedCountOutputIterator
-        >),
-        dim3(number_of_blocks), dim3(block_size), 0, stream,
-        input, size, flags, indices, output, selected_count_output
-    );
-    error = hipPeekAtLastError();
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("scatter_kernel", size, start)
-
-    return hipSuccess;
 }
 
 /// \brief HIP parallel select primitive for device level using selection operator.
@@ -299,6 +361,10 @@ hipError_t select(void * temporary_storage,
 /// values can be copied into it.
 /// * Range specified by \p selected_count_output must have at least 1 element.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small selections
+/// of host-accessible pointers are performed on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. It can be
 /// a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. It can be
@@ -366,6 +432,7 @@ hipError_t select(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class SelectedCountOutputIterator,
@@ -382,79 +449,11 @@ hipError_t select(void * temporary_storage,
                   const hipStream_t stream = 0,
                   const bool debug_synchronous = false)
 {
-    // Get temporary storage required by scan operation
-    size_t scan_storage_size = 0;
-    unsigned char * dummy_in_ptr = nullptr;
-    unsigned int *  dummy_out_ptr = nullptr;
-    auto error = ::rocprim::exclusive_scan(
-        nullptr, scan_storage_size,
-        dummy_in_ptr, dummy_out_ptr,
-        0U, size, ::rocprim::plus<unsigned int>(),
-        stream, debug_synchronous
-    );
-    // Align
-    scan_storage_size = ::rocprim::detail::align_size(scan_storage_size);
-
-    // Calculate required temporary storage
-    if(temporary_storage == nullptr)
-    {
-        storage_size = scan_storage_size;
-        // Add storage required for indexes
-        storage_size += size * sizeof(unsigned int);
-        // Make sure user won't try to allocate 0 bytes memory, otherwise
-        // user may again pass nullptr as temporary_storage
-        storage_size = storage_size == 0 ? 4 : storage_size;
-        return hipSuccess;
-    }
-
-    // Return for empty input
-    if(size == 0) return hipSuccess;
-
-    // Start point for time measurements
-    std::chrono::high_resolution_clock::time_point start;
-
-    // Calculate output indices to scatter selected values
-    auto indices = reinterpret_cast<unsigned int*>(
-        static_cast<unsigned char*>(temporary_storage) + scan_storage_size
-    );
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    error = ::rocprim::exclusive_scan(
-        temporary_storage, scan_storage_size,
-        ::rocprim::make_transform_iterator(input, select_op),
-        indices, 0U, size, ::rocprim::plus<unsigned int>(),
-        stream, debug_synchronous
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("rocprim::exclusive_scan", size, start)
-
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
-    constexpr auto items_per_block = block_size * items_per_thread;
-
-    auto number_of_blocks = (size + items_per_block - 1)/items_per_block;
-    if(debug_synchronous)
-    {
-        std::cout << "block_size " << block_size << '\n';
-        std::cout << "number of blocks " << number_of_blocks << '\n';
-        std::cout << "items_per_block " << items_per_block << '\n';
-        std::cout << "temporary storage size " << storage_size << '\n';
-    }
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(detail::scatter_if_kernel<
-            block_size, items_per_thread,
-            InputIterator,
-            OutputIterator, SelectedCountOutputIterator,
-            SelectOp
-        >),
-        dim3(number_of_blocks), dim3(block_size), 0, stream,
-        input, size, indices, output, selected_count_output, select_op
+    // Flags are not used, input is passed as a dummy flag iterator
+    return detail::partition_impl<detail::select_method::predicate, true, Config>(
+        temporary_storage, storage_size, input, input, output, selected_count_output,
+        size, select_op, ::rocprim::empty_type(), stream, debug_synchronous
     );
-    error = hipPeekAtLastError();
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("scatter_if_kernel", size, start)
-
-    return hipSuccess;
 }
 
 /// \brief HIP device-level parallel unique primitive.
@@ -472,6 +471,10 @@ hipError_t select(void * temporary_storage,
 /// * By default <tt>InputIterator::value_type</tt>'s equality operator is used to check
 /// if elements are equivalent.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members. Wrapped in
+/// \p host_fallback_config (or with \p ROCPRIM_HOST_FALLBACK_SIZE defined), small selections
+/// of host-accessible pointers are performed on the host.
 /// \tparam InputIterator - random-access iterator type of the input range. It can be
 /// a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. It can be
@@ -532,6 +535,7 @@ hipError_t select(void * temporary_storage,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class UniqueCountOutputIterator,
@@ -550,81 +554,18 @@ hipError_t unique(void * temporary_storage,
 {
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
 
-    // Get temporary storage required by select operation
-    size_t select_storage_size = 0;
-    unsigned char * dummy_flags_ptr = nullptr;
-    auto error = ::rocprim::select(
-        static_cast<void*>(nullptr), select_storage_size,
-        input, dummy_flags_ptr, output, unique_count_output, size,
-        stream, debug_synchronous
-    );
-    // Align
-    select_storage_size = ::rocprim::detail::align_size(select_storage_size);
-
-    // Calculate required temporary storage
-    if(temporary_storage == nullptr)
-    {
-        storage_size = select_storage_size;
-        // Add storage required for flags
-        storage_size += size * sizeof(unsigned char);
-        // Make sure user won't try to allocate 0 bytes memory, otherwise
-        // user may again pass nullptr as temporary_storage
-        storage_size = storage_size == 0 ? 4 : storage_size;
-        return hipSuccess;
-    }
-
-    // Return for empty input
-    if(size == 0) return hipSuccess;
-
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
-    constexpr auto items_per_block = block_size * items_per_thread;
-
-    auto number_of_blocks = (size + items_per_block - 1)/items_per_block;
-    if(debug_synchronous)
-    {
-        std::cout << "block_size " << block_size << '\n';
-        std::cout << "number of blocks " << number_of_blocks << '\n';
-        std::cout << "items_per_block " << items_per_block << '\n';
-        std::cout << "temporary storage size " << storage_size << '\n';
-    }
-
-    // Start point for time measurements
-    std::chrono::high_resolution_clock::time_point start;
-
-    auto flags = static_cast<unsigned char*>(temporary_storage) + select_storage_size;
     auto inequality_op =
         [equality_op] __device__ (const input_type& a, const input_type& b) -> bool
         {
             return !equality_op(a, b);
         };
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(detail::flag_unique_kernel<
-            block_size, items_per_thread,
-            InputIterator, decltype(flags), decltype(inequality_op)
-        >),
-        dim3(number_of_blocks), dim3(block_size), 0, stream,
-        input, size, flags, inequality_op
+    // Flags are not used, input is passed as a dummy flag iterator
+    return detail::partition_impl<detail::select_method::unique, true, Config>(
+        temporary_storage, storage_size, input, input, output, unique_count_output,
+        size, ::rocprim::empty_type(), inequality_op, stream, debug_synchronous
     );
-    error = hipPeekAtLastError();
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("flag_unique_kernel", size, start)
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    // select unique values
-    error = ::rocprim::select(
-        temporary_storage, select_storage_size,
-        input, flags, output, unique_count_output, size,
-        stream, debug_synchronous
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("rocprim::select", size, start)
-
-    return hipSuccess;
 }
 
-#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
-
 /// @}
 // end of group devicemodule_hip
 
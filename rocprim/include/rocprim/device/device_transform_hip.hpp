@@ -29,6 +29,7 @@
 #include "../types/tuple.hpp"
 #include "../iterator/zip_iterator.hpp"
 
+#include "device_transform_config.hpp"
 #include "detail/device_transform.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -93,6 +94,8 @@ void transform_kernel(InputIterator input,
 /// \par Overview
 /// * Ranges specified by \p input and \p output must have at least \p size elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -138,6 +141,7 @@ void transform_kernel(InputIterator input,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator,
     class OutputIterator,
     class UnaryFunction
@@ -150,9 +154,21 @@ hipError_t transform(InputIterator input,
                      const hipStream_t stream = 0,
                      bool debug_synchronous = false)
 {
-    // TODO: Those values should depend on type size
-    constexpr unsigned int block_size = 256;
-    constexpr unsigned int items_per_thread = 4;
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<UnaryFunction, input_type>::type;
+    #else
+    using result_type = typename std::result_of<UnaryFunction(input_type)>::type;
+    #endif
+
+    // Get default config if Config is default_config
+    using config = detail::default_or_custom_config<
+        Config,
+        detail::default_transform_config<result_type>
+    >;
+
+    constexpr unsigned int block_size = config::block_size;
+    constexpr unsigned int items_per_thread = config::items_per_thread;
     constexpr auto items_per_block = block_size * items_per_thread;
 
     // Start point for time measurements
@@ -188,6 +204,8 @@ hipError_t transform(InputIterator input,
 /// \par Overview
 /// * Ranges specified by \p input1, \p input2, and \p output must have at least \p size elements.
 ///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p kernel_config or a custom class with the same members.
 /// \tparam InputIterator1 - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam InputIterator2 - random-access iterator type of the input range. Must meet the
@@ -237,6 +255,7 @@ hipError_t transform(InputIterator input,
 /// \endcode
 /// \endparblock
 template<
+    class Config = default_config,
     class InputIterator1,
     class InputIterator2,
     class OutputIterator,
@@ -253,7 +272,7 @@ hipError_t transform(InputIterator1 input1,
 {
     using value_type1 = typename std::iterator_traits<InputIterator1>::value_type;
     using value_type2 = typename std::iterator_traits<InputIterator2>::value_type;
-    return transform(
+    return transform<Config>(
         ::rocprim::make_zip_iterator(::rocprim::make_tuple(input1, input2)), output,
         size, detail::unpack_binary_op<value_type1, value_type2, BinaryFunction>(transform_op),
         stream, debug_synchronous
@@ -21,14 +21,172 @@
 #ifndef ROCPRIM_INTRINSICS_ATOMIC_HPP_
 #define ROCPRIM_INTRINSICS_ATOMIC_HPP_
 
+#include <type_traits>
+
 #include "../config.hpp"
 
+#ifdef ROCPRIM_HIP_API
+    #include <hip/hip_fp16.h>
+#endif
+
 BEGIN_ROCPRIM_NAMESPACE
 
 namespace detail
 {
+    // Device scope atomics use HIP and HC atomic functions
+    struct atomic_device_scope {};
+    // System scope atomics use GCC-style __atomic builtins, which are emitted with
+    // system synchronization scope (coherent with the host and other devices)
+    struct atomic_system_scope {};
+
+    // Prevents deduction of T from the value argument of atomic functions,
+    // T is deduced from the address only
+    template<class T>
+    struct atomic_value
+    {
+        using type = T;
+    };
+
+    // Unsigned integral type of the same size as T, used by compare-and-swap loops
+    template<class T>
+    struct atomic_bits
+    {
+        static_assert(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                      "Only 16-bit, 32-bit and 64-bit types are supported");
+        using type =
+            typename std::conditional<
+                sizeof(T) == 2,
+                unsigned short,
+                typename std::conditional<
+                    sizeof(T) == 4, unsigned int, unsigned long long
+                >::type
+            >::type;
+    };
+
+    template<class To, class From>
+    ROCPRIM_DEVICE inline
+    To atomic_bit_cast(From value)
+    {
+        static_assert(sizeof(To) == sizeof(From), "To and From must have the same size");
+        return *reinterpret_cast<To *>(&value);
+    }
+
+    // Compare-and-swap
+
+    ROCPRIM_DEVICE inline
+    unsigned int atomic_cas(atomic_device_scope,
+                            unsigned int * address, unsigned int compare, unsigned int value)
+    {
+        #ifdef ROCPRIM_HC_API
+            // compare is replaced with the current value if they are not equal
+            hc::atomic_compare_exchange(address, &compare, value);
+            return compare;
+        #else
+            return atomicCAS(address, compare, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned long long atomic_cas(atomic_device_scope,
+                                  unsigned long long * address,
+                                  unsigned long long compare,
+                                  unsigned long long value)
+    {
+        #ifdef ROCPRIM_HC_API
+            uint64_t expected = static_cast<uint64_t>(compare);
+            hc::atomic_compare_exchange(
+                reinterpret_cast<uint64_t*>(address), &expected, static_cast<uint64_t>(value)
+            );
+            return static_cast<unsigned long long>(expected);
+        #else
+            return atomicCAS(address, compare, value);
+        #endif
+    }
+
+    template<class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_cas(atomic_system_scope, T * address, T compare, T value)
+        -> typename std::enable_if<std::is_integral<T>::value, T>::type
+    {
+        __atomic_compare_exchange_n(
+            address, &compare, value, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED
+        );
+        return compare;
+    }
+
+    // Other types are swapped as unsigned integers of the same size
+    template<class Scope, class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_cas(Scope scope, T * address, T compare, T value)
+        -> typename std::enable_if<
+               !std::is_same<T, typename atomic_bits<T>::type>::value
+                   && (sizeof(T) == 4 || sizeof(T) == 8)
+                   && !(std::is_integral<T>::value && std::is_same<Scope, atomic_system_scope>::value),
+               T
+           >::type
+    {
+        using bits_type = typename atomic_bits<T>::type;
+        return atomic_bit_cast<T>(
+            atomic_cas(
+                scope, reinterpret_cast<bits_type *>(address),
+                atomic_bit_cast<bits_type>(compare), atomic_bit_cast<bits_type>(value)
+            )
+        );
+    }
+
+    // Replaces the value at address with update_op(old value) using a compare-and-swap
+    // loop, returns the old value. Bits are compared, so NaNs do not prevent progress.
+    template<class Scope, class T, class UpdateOp>
+    ROCPRIM_DEVICE inline
+    auto atomic_update(Scope scope, T * address, UpdateOp update_op)
+        -> typename std::enable_if<sizeof(T) == 4 || sizeof(T) == 8, T>::type
+    {
+        using bits_type = typename atomic_bits<T>::type;
+        bits_type * bits_address = reinterpret_cast<bits_type *>(address);
+
+        bits_type old_bits = *bits_address;
+        bits_type assumed_bits;
+        do
+        {
+            assumed_bits = old_bits;
+            const T new_value = update_op(atomic_bit_cast<T>(assumed_bits));
+            old_bits = atomic_cas(
+                scope, bits_address, assumed_bits, atomic_bit_cast<bits_type>(new_value)
+            );
+        } while(old_bits != assumed_bits);
+        return atomic_bit_cast<T>(old_bits);
+    }
+
+    // 16-bit values are updated with compare-and-swap of the aligned 32-bit word
+    // that contains them
+    template<class Scope, class T, class UpdateOp>
+    ROCPRIM_DEVICE inline
+    auto atomic_update(Scope scope, T * address, UpdateOp update_op)
+        -> typename std::enable_if<sizeof(T) == 2, T>::type
+    {
+        const size_t offset = reinterpret_cast<size_t>(address) & 3;
+        unsigned int * word_address =
+            reinterpret_cast<unsigned int *>(reinterpret_cast<char *>(address) - offset);
+        const unsigned int shift = offset * 8;
+
+        unsigned int old_word = *word_address;
+        unsigned int assumed_word;
+        do
+        {
+            assumed_word = old_word;
+            const unsigned short old_bits = static_cast<unsigned short>(assumed_word >> shift);
+            const T new_value = update_op(atomic_bit_cast<T>(old_bits));
+            const unsigned int new_bits = atomic_bit_cast<unsigned short>(new_value);
+            const unsigned int new_word = (assumed_word & ~(0xffffU << shift)) | (new_bits << shift);
+            old_word = atomic_cas(scope, word_address, assumed_word, new_word);
+        } while(old_word != assumed_word);
+        return atomic_bit_cast<T>(static_cast<unsigned short>(old_word >> shift));
+    }
+
+    // Add
+
     ROCPRIM_DEVICE inline
-    unsigned int atomic_add(unsigned int * address, unsigned int value)
+    unsigned int atomic_add(atomic_device_scope, unsigned int * address, unsigned int value)
     {
         #ifdef ROCPRIM_HC_API
             return hc::atomic_fetch_add(address, value);
@@ -38,7 +196,7 @@ namespace detail
     }
 
     ROCPRIM_DEVICE inline
-    int atomic_add(int * address, int value)
+    int atomic_add(atomic_device_scope, int * address, int value)
     {
         #ifdef ROCPRIM_HC_API
             return hc::atomic_fetch_add(address, value);
@@ -48,7 +206,7 @@ namespace detail
     }
 
     ROCPRIM_DEVICE inline
-    float atomic_add(float * address, float value)
+    float atomic_add(atomic_device_scope, float * address, float value)
     {
         #ifdef ROCPRIM_HC_API
             return hc::atomic_fetch_add(address, value);
@@ -56,9 +214,10 @@ namespace detail
             return atomicAdd(address, value);
         #endif
     }
-    
+
     ROCPRIM_DEVICE inline
-    unsigned long long atomic_add(unsigned long long * address, unsigned long long value)
+    unsigned long long atomic_add(atomic_device_scope,
+                                  unsigned long long * address, unsigned long long value)
     {
         #ifdef ROCPRIM_HC_API
             return hc::atomic_fetch_add(reinterpret_cast<uint64_t*>(address), static_cast<uint64_t>(value));
@@ -66,8 +225,532 @@ namespace detail
             return atomicAdd(address, value);
         #endif
     }
+
+    ROCPRIM_DEVICE inline
+    long long atomic_add(atomic_device_scope scope, long long * address, long long value)
+    {
+        // Two's complement addition is the same for signed and unsigned integers
+        return static_cast<long long>(
+            atomic_add(
+                scope, reinterpret_cast<unsigned long long *>(address),
+                static_cast<unsigned long long>(value)
+            )
+        );
+    }
+
+    template<class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_add(atomic_system_scope, T * address, T value)
+        -> typename std::enable_if<std::is_integral<T>::value, T>::type
+    {
+        return __atomic_fetch_add(address, value, __ATOMIC_RELAXED);
+    }
+
+    template<class Scope>
+    ROCPRIM_DEVICE inline
+    double atomic_add(Scope scope, double * address, double value)
+    {
+        return atomic_update(scope, address, [=](double x) { return x + value; });
+    }
+
+    ROCPRIM_DEVICE inline
+    float atomic_add(atomic_system_scope scope, float * address, float value)
+    {
+        return atomic_update(scope, address, [=](float x) { return x + value; });
+    }
+
+    #ifdef ROCPRIM_HIP_API
+    template<class Scope>
+    ROCPRIM_DEVICE inline
+    __half atomic_add(Scope scope, __half * address, __half value)
+    {
+        return atomic_update(
+            scope, address,
+            [=](__half x) { return __float2half(__half2float(x) + __half2float(value)); }
+        );
+    }
+    #endif
+
+    // Minimum and maximum
+
+    ROCPRIM_DEVICE inline
+    unsigned int atomic_min(atomic_device_scope, unsigned int * address, unsigned int value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_min(address, value);
+        #else
+            return atomicMin(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    int atomic_min(atomic_device_scope, int * address, int value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_min(address, value);
+        #else
+            return atomicMin(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned long long atomic_min(atomic_device_scope,
+                                  unsigned long long * address, unsigned long long value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_min(reinterpret_cast<uint64_t*>(address), static_cast<uint64_t>(value));
+        #else
+            return atomicMin(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned int atomic_max(atomic_device_scope, unsigned int * address, unsigned int value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_max(address, value);
+        #else
+            return atomicMax(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    int atomic_max(atomic_device_scope, int * address, int value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_max(address, value);
+        #else
+            return atomicMax(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned long long atomic_max(atomic_device_scope,
+                                  unsigned long long * address, unsigned long long value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_max(reinterpret_cast<uint64_t*>(address), static_cast<uint64_t>(value));
+        #else
+            return atomicMax(address, value);
+        #endif
+    }
+
+    // Other types (signed 64-bit integers, floating point types, system scope)
+    // use compare-and-swap loops
+    template<class Scope, class T>
+    ROCPRIM_DEVICE inline
+    T atomic_min(Scope scope, T * address, T value)
+    {
+        return atomic_update(scope, address, [=](T x) { return value < x ? value : x; });
+    }
+
+    template<class Scope, class T>
+    ROCPRIM_DEVICE inline
+    T atomic_max(Scope scope, T * address, T value)
+    {
+        return atomic_update(scope, address, [=](T x) { return x < value ? value : x; });
+    }
+
+    // Bitwise operations
+
+    ROCPRIM_DEVICE inline
+    unsigned int atomic_and(atomic_device_scope, unsigned int * address, unsigned int value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_and(address, value);
+        #else
+            return atomicAnd(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned long long atomic_and(atomic_device_scope,
+                                  unsigned long long * address, unsigned long long value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_and(reinterpret_cast<uint64_t*>(address), static_cast<uint64_t>(value));
+        #else
+            return atomicAnd(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned int atomic_or(atomic_device_scope, unsigned int * address, unsigned int value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_or(address, value);
+        #else
+            return atomicOr(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned long long atomic_or(atomic_device_scope,
+                                 unsigned long long * address, unsigned long long value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_or(reinterpret_cast<uint64_t*>(address), static_cast<uint64_t>(value));
+        #else
+            return atomicOr(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned int atomic_xor(atomic_device_scope, unsigned int * address, unsigned int value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_xor(address, value);
+        #else
+            return atomicXor(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned long long atomic_xor(atomic_device_scope,
+                                  unsigned long long * address, unsigned long long value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_fetch_xor(reinterpret_cast<uint64_t*>(address), static_cast<uint64_t>(value));
+        #else
+            return atomicXor(address, value);
+        #endif
+    }
+
+    // Signed integers are processed as unsigned integers of the same size
+    template<class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_and(atomic_device_scope scope, T * address, T value)
+        -> typename std::enable_if<std::is_signed<T>::value, T>::type
+    {
+        using bits_type = typename atomic_bits<T>::type;
+        return static_cast<T>(
+            atomic_and(scope, reinterpret_cast<bits_type *>(address), static_cast<bits_type>(value))
+        );
+    }
+
+    template<class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_or(atomic_device_scope scope, T * address, T value)
+        -> typename std::enable_if<std::is_signed<T>::value, T>::type
+    {
+        using bits_type = typename atomic_bits<T>::type;
+        return static_cast<T>(
+            atomic_or(scope, reinterpret_cast<bits_type *>(address), static_cast<bits_type>(value))
+        );
+    }
+
+    template<class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_xor(atomic_device_scope scope, T * address, T value)
+        -> typename std::enable_if<std::is_signed<T>::value, T>::type
+    {
+        using bits_type = typename atomic_bits<T>::type;
+        return static_cast<T>(
+            atomic_xor(scope, reinterpret_cast<bits_type *>(address), static_cast<bits_type>(value))
+        );
+    }
+
+    template<class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_and(atomic_system_scope, T * address, T value)
+        -> typename std::enable_if<std::is_integral<T>::value, T>::type
+    {
+        return __atomic_fetch_and(address, value, __ATOMIC_RELAXED);
+    }
+
+    template<class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_or(atomic_system_scope, T * address, T value)
+        -> typename std::enable_if<std::is_integral<T>::value, T>::type
+    {
+        return __atomic_fetch_or(address, value, __ATOMIC_RELAXED);
+    }
+
+    template<class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_xor(atomic_system_scope, T * address, T value)
+        -> typename std::enable_if<std::is_integral<T>::value, T>::type
+    {
+        return __atomic_fetch_xor(address, value, __ATOMIC_RELAXED);
+    }
+
+    // Exchange
+
+    ROCPRIM_DEVICE inline
+    unsigned int atomic_exch(atomic_device_scope, unsigned int * address, unsigned int value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_exchange(address, value);
+        #else
+            return atomicExch(address, value);
+        #endif
+    }
+
+    ROCPRIM_DEVICE inline
+    unsigned long long atomic_exch(atomic_device_scope,
+                                   unsigned long long * address, unsigned long long value)
+    {
+        #ifdef ROCPRIM_HC_API
+            return hc::atomic_exchange(reinterpret_cast<uint64_t*>(address), static_cast<uint64_t>(value));
+        #else
+            return atomicExch(address, value);
+        #endif
+    }
+
+    template<class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_exch(atomic_system_scope, T * address, T value)
+        -> typename std::enable_if<std::is_integral<T>::value, T>::type
+    {
+        return __atomic_exchange_n(address, value, __ATOMIC_RELAXED);
+    }
+
+    // Other types are exchanged as unsigned integers of the same size
+    template<class Scope, class T>
+    ROCPRIM_DEVICE inline
+    auto atomic_exch(Scope scope, T * address, T value)
+        -> typename std::enable_if<
+               !std::is_same<T, typename atomic_bits<T>::type>::value
+                   && (sizeof(T) == 4 || sizeof(T) == 8)
+                   && !(std::is_integral<T>::value && std::is_same<Scope, atomic_system_scope>::value),
+               T
+           >::type
+    {
+        using bits_type = typename atomic_bits<T>::type;
+        return atomic_bit_cast<T>(
+            atomic_exch(
+                scope, reinterpret_cast<bits_type *>(address), atomic_bit_cast<bits_type>(value)
+            )
+        );
+    }
+} // end namespace detail
+
+/// \addtogroup intrinsicsmodule
+/// @{
+
+/// \brief Atomically adds \p value to the value stored at \p address.
+///
+/// Supported types: \p int, \p unsigned \p int, \p long \p long, \p unsigned \p long \p long,
+/// \p float, \p double and \p __half (HIP only). The operation is atomic with respect to
+/// all threads of the device (device scope).
+///
+/// \param address - address of the value
+/// \param value - value to add
+/// \return the value stored at \p address before the operation.
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_add(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_add(detail::atomic_device_scope(), address, value);
+}
+
+/// \brief Atomically stores the minimum of \p value and the value stored at \p address.
+///
+/// Supported types: \p int, \p unsigned \p int, \p long \p long, \p unsigned \p long \p long,
+/// \p float and \p double. The operation is atomic with respect to all threads of the
+/// device (device scope).
+///
+/// \param address - address of the value
+/// \param value - value to compare with
+/// \return the value stored at \p address before the operation.
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_min(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_min(detail::atomic_device_scope(), address, value);
+}
+
+/// \brief Atomically stores the maximum of \p value and the value stored at \p address.
+///
+/// Supported types: \p int, \p unsigned \p int, \p long \p long, \p unsigned \p long \p long,
+/// \p float and \p double. The operation is atomic with respect to all threads of the
+/// device (device scope).
+///
+/// \param address - address of the value
+/// \param value - value to compare with
+/// \return the value stored at \p address before the operation.
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_max(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_max(detail::atomic_device_scope(), address, value);
+}
+
+/// \brief Atomically computes bitwise AND of \p value and the value stored at \p address.
+///
+/// Supported types: \p int, \p unsigned \p int, \p long \p long and \p unsigned \p long \p long.
+/// The operation is atomic with respect to all threads of the device (device scope).
+///
+/// \param address - address of the value
+/// \param value - operand
+/// \return the value stored at \p address before the operation.
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_and(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_and(detail::atomic_device_scope(), address, value);
+}
+
+/// \brief Atomically computes bitwise OR of \p value and the value stored at \p address.
+///
+/// Supported types: \p int, \p unsigned \p int, \p long \p long and \p unsigned \p long \p long.
+/// The operation is atomic with respect to all threads of the device (device scope).
+///
+/// \param address - address of the value
+/// \param value - operand
+/// \return the value stored at \p address before the operation.
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_or(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_or(detail::atomic_device_scope(), address, value);
+}
+
+/// \brief Atomically computes bitwise XOR of \p value and the value stored at \p address.
+///
+/// Supported types: \p int, \p unsigned \p int, \p long \p long and \p unsigned \p long \p long.
+/// The operation is atomic with respect to all threads of the device (device scope).
+///
+/// \param address - address of the value
+/// \param value - operand
+/// \return the value stored at \p address before the operation.
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_xor(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_xor(detail::atomic_device_scope(), address, value);
+}
+
+/// \brief Atomically replaces the value stored at \p address with \p value.
+///
+/// Supported types: \p int, \p unsigned \p int, \p long \p long, \p unsigned \p long \p long,
+/// \p float and \p double. The operation is atomic with respect to all threads of the
+/// device (device scope).
+///
+/// \param address - address of the value
+/// \param value - new value
+/// \return the value stored at \p address before the operation.
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_exch(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_exch(detail::atomic_device_scope(), address, value);
+}
+
+/// \brief Atomically replaces the value stored at \p address with \p value if it is
+/// equal to \p compare.
+///
+/// Supported types: \p int, \p unsigned \p int, \p long \p long, \p unsigned \p long \p long,
+/// \p float and \p double (values are compared bitwise). The operation is atomic with
+/// respect to all threads of the device (device scope).
+///
+/// \param address - address of the value
+/// \param compare - expected value
+/// \param value - new value
+/// \return the value stored at \p address before the operation, the operation succeeded
+/// if it is equal to \p compare.
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_cas(T * address,
+             typename detail::atomic_value<T>::type compare,
+             typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_cas(detail::atomic_device_scope(), address, compare, value);
+}
+
+/// \brief System scope version of atomic_add().
+///
+/// The operation is atomic with respect to the host and all devices, \p address must
+/// point to memory which is coherent between them (e.g. fine-grained host memory).
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_add_system(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_add(detail::atomic_system_scope(), address, value);
+}
+
+/// \brief System scope version of atomic_min().
+///
+/// The operation is atomic with respect to the host and all devices, \p address must
+/// point to memory which is coherent between them (e.g. fine-grained host memory).
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_min_system(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_min(detail::atomic_system_scope(), address, value);
+}
+
+/// \brief System scope version of atomic_max().
+///
+/// The operation is atomic with respect to the host and all devices, \p address must
+/// point to memory which is coherent between them (e.g. fine-grained host memory).
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_max_system(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_max(detail::atomic_system_scope(), address, value);
 }
 
+/// \brief System scope version of atomic_and().
+///
+/// The operation is atomic with respect to the host and all devices, \p address must
+/// point to memory which is coherent between them (e.g. fine-grained host memory).
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_and_system(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_and(detail::atomic_system_scope(), address, value);
+}
+
+/// \brief System scope version of atomic_or().
+///
+/// The operation is atomic with respect to the host and all devices, \p address must
+/// point to memory which is coherent between them (e.g. fine-grained host memory).
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_or_system(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_or(detail::atomic_system_scope(), address, value);
+}
+
+/// \brief System scope version of atomic_xor().
+///
+/// The operation is atomic with respect to the host and all devices, \p address must
+/// point to memory which is coherent between them (e.g. fine-grained host memory).
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_xor_system(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_xor(detail::atomic_system_scope(), address, value);
+}
+
+/// \brief System scope version of atomic_exch().
+///
+/// The operation is atomic with respect to the host and all devices, \p address must
+/// point to memory which is coherent between them (e.g. fine-grained host memory).
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_exch_system(T * address, typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_exch(detail::atomic_system_scope(), address, value);
+}
+
+/// \brief System scope version of atomic_cas().
+///
+/// The operation is atomic with respect to the host and all devices, \p address must
+/// point to memory which is coherent between them (e.g. fine-grained host memory).
+template<class T>
+ROCPRIM_DEVICE inline
+T atomic_cas_system(T * address,
+                    typename detail::atomic_value<T>::type compare,
+                    typename detail::atomic_value<T>::type value)
+{
+    return detail::atomic_cas(detail::atomic_system_scope(), address, compare, value);
+}
+
+/// @}
+// end of group intrinsicsmodule
+
 END_ROCPRIM_NAMESPACE
 
 #endif // ROCPRIM_INTRINSICS_ATOMIC_HPP_
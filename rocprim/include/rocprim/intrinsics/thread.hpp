@@ -137,6 +137,18 @@ void syncthreads()
 
 namespace detail
 {
+    /// \brief Memory fence for global memory, all writes issued before the fence
+    /// are visible to all threads of the device before writes issued after it.
+    ROCPRIM_DEVICE inline
+    void memory_fence_device()
+    {
+        #ifdef ROCPRIM_HC_API
+            __atomic_work_item_fence(CLK_GLOBAL_MEM_FENCE, __memory_order_seq_cst, __memory_scope_device);
+        #else // HIP
+            __threadfence();
+        #endif
+    }
+
     /// \brief Returns thread identifier in a multidimensional block (tile) by dimension.
     template<unsigned int Dim>
     ROCPRIM_DEVICE inline
@@ -171,6 +171,32 @@ T warp_shuffle_xor(T input, const int lane_mask, const int width = warp_size())
     );
 }
 
+namespace detail
+{
+
+// Moves \p input between lanes using DPP (data parallel primitives) of gfx8 and gfx9,
+// DppCtrl selects the pattern (e.g. 0x111 - row_shr:1, 0x142 - row_bcast:15,
+// 0x138 - wave_shr:1). Lanes without a valid source lane or disabled by
+// RowMask/BankMask obtain an undefined value.
+template<int DppCtrl, int RowMask = 0xf, int BankMask = 0xf, bool BoundCtrl = false, class T>
+ROCPRIM_DEVICE inline
+T warp_move_dpp(T input)
+{
+    return detail::warp_shuffle_op(
+        input,
+        [=](int v) -> int
+        {
+            #ifdef ROCPRIM_HC_API
+                return hc::__amdgcn_move_dpp(v, DppCtrl, RowMask, BankMask, BoundCtrl);
+            #else // HIP
+                return __hip_move_dpp(v, DppCtrl, RowMask, BankMask, BoundCtrl);
+            #endif
+        }
+    );
+}
+
+} // end namespace detail
+
 END_ROCPRIM_NAMESPACE
 
 #endif // ROCPRIM_INTRINSICS_WARP_SHUFFLE_HPP_
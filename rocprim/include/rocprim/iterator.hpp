@@ -32,6 +32,7 @@
 #include "iterator/texture_cache_iterator.hpp"
 #endif
 #include "iterator/transform_iterator.hpp"
+#include "iterator/transform_output_iterator.hpp"
 #include "iterator/zip_iterator.hpp"
 
 #endif // ROCPRIM_ITERATOR_HPP_
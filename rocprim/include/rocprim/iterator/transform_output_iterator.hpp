@@ -0,0 +1,279 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_ITERATOR_TRANSFORM_OUTPUT_ITERATOR_HPP_
+#define ROCPRIM_ITERATOR_TRANSFORM_OUTPUT_ITERATOR_HPP_
+
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+
+#include "../config.hpp"
+
+/// \addtogroup iteratormodule
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \class transform_output_iterator
+/// \brief A random-access output (write-only) iterator adaptor for transforming values
+/// assigned to it upon dereference.
+///
+/// \par Overview
+/// * A transform_output_iterator uses functor of type UnaryFunction to transform values
+/// assigned to it, results are written to the range pointed by the underlying iterator.
+/// * Using it as an output of an algorithm (e.g. scan or radix sort) fuses a following
+/// transformation into that algorithm, so the intermediate range is never stored in
+/// memory, which saves memory capacity and bandwidth.
+/// * The values can not be read back through transform_output_iterator, its
+/// \p value_type is \p void.
+///
+/// \tparam OutputIterator - type of the underlying random-access output iterator. Must be
+/// a random-access iterator.
+/// \tparam UnaryFunction - type of the transform functor.
+template<
+    class OutputIterator,
+    class UnaryFunction
+>
+class transform_output_iterator
+{
+private:
+    using output_category = typename std::iterator_traits<OutputIterator>::iterator_category;
+    static_assert(
+        std::is_same<output_category, std::random_access_iterator_tag>::value,
+        "OutputIterator must be a random-access iterator"
+    );
+
+public:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    class transform_reference
+    {
+    public:
+        ROCPRIM_HOST_DEVICE inline
+        transform_reference(OutputIterator iterator, UnaryFunction transform)
+            : iterator_(iterator), transform_(transform)
+        {
+        }
+
+        ROCPRIM_HOST_DEVICE inline
+        ~transform_reference() = default;
+
+        template<class T>
+        ROCPRIM_HOST_DEVICE inline
+        transform_reference& operator=(const T& value)
+        {
+            *iterator_ = transform_(value);
+            return *this;
+        }
+
+    private:
+        OutputIterator iterator_;
+        UnaryFunction transform_;
+    };
+#endif
+
+    /// The type of the value that can be obtained by dereferencing the iterator,
+    /// it's \p void since transform_output_iterator is a write-only iterator.
+    using value_type = void;
+    /// \brief A reference type returned by dereferencing the iterator, assigning a value
+    /// to it writes the transformed value to the underlying range.
+    using reference = transform_reference;
+    /// A pointer type, it's \p void since transform_output_iterator is a write-only iterator.
+    using pointer = void;
+    /// A type used for identify distance between iterators.
+    using difference_type = typename std::iterator_traits<OutputIterator>::difference_type;
+    /// The category of the iterator.
+    using iterator_category = std::random_access_iterator_tag;
+    /// The type of unary function used to transform assigned values.
+    using unary_function = UnaryFunction;
+
+    ROCPRIM_HOST_DEVICE inline
+    ~transform_output_iterator() = default;
+
+    /// \brief Creates a new transform_output_iterator.
+    ///
+    /// \param iterator output iterator to which transformed values are written.
+    /// \param transform unary function used to transform values assigned
+    /// to the iterator.
+    ROCPRIM_HOST_DEVICE inline
+    transform_output_iterator(OutputIterator iterator, UnaryFunction transform)
+        : iterator_(iterator), transform_(transform)
+    {
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    transform_output_iterator& operator++()
+    {
+        iterator_++;
+        return *this;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    transform_output_iterator operator++(int)
+    {
+        transform_output_iterator old = *this;
+        iterator_++;
+        return old;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    transform_output_iterator& operator--()
+    {
+        iterator_--;
+        return *this;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    transform_output_iterator operator--(int)
+    {
+        transform_output_iterator old = *this;
+        iterator_--;
+        return old;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    reference operator*() const
+    {
+        return reference(iterator_, transform_);
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    reference operator[](difference_type distance) const
+    {
+        return reference(iterator_ + distance, transform_);
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    transform_output_iterator operator+(difference_type distance) const
+    {
+        return transform_output_iterator(iterator_ + distance, transform_);
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    transform_output_iterator& operator+=(difference_type distance)
+    {
+        iterator_ += distance;
+        return *this;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    transform_output_iterator operator-(difference_type distance) const
+    {
+        return transform_output_iterator(iterator_ - distance, transform_);
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    transform_output_iterator& operator-=(difference_type distance)
+    {
+        iterator_ -= distance;
+        return *this;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    difference_type operator-(transform_output_iterator other) const
+    {
+        return iterator_ - other.iterator_;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    bool operator==(transform_output_iterator other) const
+    {
+        return iterator_ == other.iterator_;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    bool operator!=(transform_output_iterator other) const
+    {
+        return iterator_ != other.iterator_;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    bool operator<(transform_output_iterator other) const
+    {
+        return iterator_ < other.iterator_;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    bool operator<=(transform_output_iterator other) const
+    {
+        return iterator_ <= other.iterator_;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    bool operator>(transform_output_iterator other) const
+    {
+        return iterator_ > other.iterator_;
+    }
+
+    ROCPRIM_HOST_DEVICE inline
+    bool operator>=(transform_output_iterator other) const
+    {
+        return iterator_ >= other.iterator_;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const transform_output_iterator& /* iter */)
+    {
+        return os;
+    }
+
+private:
+    OutputIterator iterator_;
+    UnaryFunction transform_;
+};
+
+template<
+    class OutputIterator,
+    class UnaryFunction
+>
+ROCPRIM_HOST_DEVICE inline
+transform_output_iterator<OutputIterator, UnaryFunction>
+operator+(typename transform_output_iterator<OutputIterator, UnaryFunction>::difference_type distance,
+          const transform_output_iterator<OutputIterator, UnaryFunction>& iterator)
+{
+    return iterator + distance;
+}
+
+/// make_transform_output_iterator creates a transform_output_iterator using \p iterator as
+/// the underlying output iterator and \p transform as the unary function.
+///
+/// \tparam OutputIterator - type of the underlying random-access output iterator.
+/// \tparam UnaryFunction - type of the transform functor.
+///
+/// \param iterator - output iterator.
+/// \param transform - transform functor to use in created transform_output_iterator.
+/// \return A new transform_output_iterator object which transforms values assigned
+/// to it using \p transform functor and writes them to the range pointed by \p iterator.
+template<
+    class OutputIterator,
+    class UnaryFunction
+>
+ROCPRIM_HOST_DEVICE inline
+transform_output_iterator<OutputIterator, UnaryFunction>
+make_transform_output_iterator(OutputIterator iterator, UnaryFunction transform)
+{
+    return transform_output_iterator<OutputIterator, UnaryFunction>(iterator, transform);
+}
+
+/// @}
+// end of group iteratormodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_ITERATOR_TRANSFORM_OUTPUT_ITERATOR_HPP_
@@ -23,32 +23,51 @@
 
 /// \file
 ///
-/// Meta-header to include rocPRIM HC or HIP APIs.
+/// Meta-header to include rocPRIM HC, HIP or CPU APIs.
 
 // Meta configuration for rocPRIM
 #include "config.hpp"
 
 #include "rocprim_version.hpp"
 
-#include "intrinsics.hpp"
+#ifndef ROCPRIM_CPU_API
+    #include "intrinsics.hpp"
+#endif
 #include "functional.hpp"
 #include "types.hpp"
 #include "iterator.hpp"
 
-#include "warp/warp_reduce.hpp"
-#include "warp/warp_scan.hpp"
-#include "warp/warp_sort.hpp"
+// Warp- and block-level primitives are not available in the CPU backend
+#ifndef ROCPRIM_CPU_API
+    #include "warp/warp_reduce.hpp"
+    #include "warp/warp_scan.hpp"
+    #include "warp/warp_sort.hpp"
 
-#include "block/block_discontinuity.hpp"
-#include "block/block_exchange.hpp"
-#include "block/block_histogram.hpp"
-#include "block/block_load.hpp"
-#include "block/block_radix_sort.hpp"
-#include "block/block_scan.hpp"
-#include "block/block_store.hpp"
+    #include "block/block_discontinuity.hpp"
+    #include "block/block_exchange.hpp"
+    #include "block/block_histogram.hpp"
+    #include "block/block_load.hpp"
+    #include "block/block_radix_sort.hpp"
+    #include "block/block_scan.hpp"
+    #include "block/block_store.hpp"
+#endif
 
-#ifdef ROCPRIM_HC_API
+#if defined(ROCPRIM_CPU_API)
+    #include "device/device_histogram_cpu.hpp"
+    #include "device/device_radix_sort_cpu.hpp"
+    #include "device/device_reduce_by_key_cpu.hpp"
+    #include "device/device_scan_cpu.hpp"
+    #include "device/device_segmented_radix_sort_cpu.hpp"
+    #include "device/device_segmented_reduce_cpu.hpp"
+    #include "device/device_segmented_scan_cpu.hpp"
+    #include "device/device_select_cpu.hpp"
+#elif defined(ROCPRIM_HC_API)
+    #include "device/device_batched_hc.hpp"
     #include "device/device_histogram_hc.hpp"
+    #include "device/device_merge_hc.hpp"
+    #include "device/device_merge_sort_hc.hpp"
+    #include "device/device_partition_hc.hpp"
+    #include "device/device_radix_select_hc.hpp"
     #include "device/device_radix_sort_hc.hpp"
     #include "device/device_reduce_by_key_hc.hpp"
     #include "device/device_reduce_hc.hpp"
@@ -61,7 +80,12 @@
     #include "device/device_select_hc.hpp"
     #include "device/device_transform_hc.hpp"
 #else
+    #include "device/device_batched_hip.hpp"
     #include "device/device_histogram_hip.hpp"
+    #include "device/device_merge_hip.hpp"
+    #include "device/device_merge_sort_hip.hpp"
+    #include "device/device_partition_hip.hpp"
+    #include "device/device_radix_select_hip.hpp"
     #include "device/device_radix_sort_hip.hpp"
     #include "device/device_reduce_by_key_hip.hpp"
     #include "device/device_reduce_hip.hpp"
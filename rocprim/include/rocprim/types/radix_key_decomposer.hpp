@@ -0,0 +1,105 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_TYPES_RADIX_KEY_DECOMPOSER_HPP_
+#define ROCPRIM_TYPES_RADIX_KEY_DECOMPOSER_HPP_
+
+#include "../config.hpp"
+
+#include "integer_sequence.hpp"
+#include "tuple.hpp"
+
+/// \addtogroup utilsmodule
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Exposes bit fields of a custom key type to radix sort.
+///
+/// Radix sort primitives (block_radix_sort, radix_sort_keys, radix_sort_pairs,
+/// segmented_radix_sort_keys and segmented_radix_sort_pairs) accept keys of any type
+/// \p Key for which this template is specialized. The specialization must be
+/// default-constructible and provide a const <tt>ROCPRIM_HOST_DEVICE</tt> call operator
+/// taking <tt>Key&</tt> and returning a \ref rocprim::tuple of lvalue references
+/// to the key's fields, most significant field first (use \ref rocprim::tie).
+/// Every field must be an integral (except \p bool) or floating point type, or a type
+/// that is decomposable itself. The total number of bits of all fields must not
+/// exceed 64 (128 if the compiler supports 128-bit integers).
+///
+/// Keys are compared by their fields in lexicographic order, all fields are sorted
+/// in one run of the sort. \p Key must be default-constructible.
+///
+/// A specialization for \ref rocprim::tuple of supported types is provided.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// struct point { short x; float y; };
+///
+/// namespace rocprim {
+/// template<>
+/// struct radix_key_decomposer<point>
+/// {
+///     ROCPRIM_HOST_DEVICE
+///     rocprim::tuple<short&, float&> operator()(point& key) const
+///     {
+///         return rocprim::tie(key.x, key.y);
+///     }
+/// };
+/// }
+///
+/// // points are sorted by x and then by y, 48 bits are sorted instead of 64
+/// rocprim::radix_sort_keys(temporary_storage_ptr, temporary_storage_size_bytes,
+///                          points_input, points_output, input_size);
+/// \endcode
+/// \endparblock
+template<class Key, class Enable = void>
+struct radix_key_decomposer
+{
+};
+
+/// \brief Decomposes \ref rocprim::tuple keys into their elements.
+template<class... Types>
+struct radix_key_decomposer<::rocprim::tuple<Types...>>
+{
+    #ifndef DOXYGEN_SHOULD_SKIP_THIS
+    ROCPRIM_HOST_DEVICE inline
+    ::rocprim::tuple<Types&...> operator()(::rocprim::tuple<Types...>& key) const
+    {
+        return decompose(key, ::rocprim::index_sequence_for<Types...>());
+    }
+
+private:
+    template<size_t... Indices>
+    ROCPRIM_HOST_DEVICE inline
+    static ::rocprim::tuple<Types&...> decompose(::rocprim::tuple<Types...>& key,
+                                                 ::rocprim::index_sequence<Indices...>)
+    {
+        return ::rocprim::tie(::rocprim::get<Indices>(key)...);
+    }
+    #endif
+};
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group utilsmodule
+
+#endif // ROCPRIM_TYPES_RADIX_KEY_DECOMPOSER_HPP_
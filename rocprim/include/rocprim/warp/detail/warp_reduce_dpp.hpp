@@ -0,0 +1,91 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_WARP_DETAIL_WARP_REDUCE_DPP_HPP_
+#define ROCPRIM_WARP_DETAIL_WARP_REDUCE_DPP_HPP_
+
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../types.hpp"
+
+#include "warp_scan_dpp.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Reduction is the inclusive scan using DPP moves, the result is read from the last
+// (or last valid) lane of the logical warp and is available in all threads
+template<
+    class T,
+    unsigned int WarpSize,
+    bool UseAllReduce
+>
+class warp_reduce_dpp
+{
+public:
+    static_assert(detail::is_power_of_two(WarpSize), "WarpSize must be power of 2");
+
+    using storage_type = detail::empty_storage_type;
+
+    template<class BinaryFunction>
+    ROCPRIM_DEVICE inline
+    void reduce(T input, T& output, BinaryFunction reduce_op)
+    {
+        warp_scan_dpp<T, WarpSize>().inclusive_scan(input, output, reduce_op);
+        output = warp_shuffle(output, WarpSize - 1, WarpSize);
+    }
+
+    template<class BinaryFunction>
+    ROCPRIM_DEVICE inline
+    void reduce(T input, T& output, storage_type& storage, BinaryFunction reduce_op)
+    {
+        (void) storage; // disables unused parameter warning
+        this->reduce(input, output, reduce_op);
+    }
+
+    template<class BinaryFunction>
+    ROCPRIM_DEVICE inline
+    void reduce(T input, T& output, unsigned int valid_items, BinaryFunction reduce_op)
+    {
+        warp_scan_dpp<T, WarpSize>().inclusive_scan(input, output, reduce_op);
+        output = warp_shuffle(output, valid_items > 0 ? valid_items - 1 : 0, WarpSize);
+    }
+
+    template<class BinaryFunction>
+    ROCPRIM_DEVICE inline
+    void reduce(T input, T& output, unsigned int valid_items,
+                storage_type& storage, BinaryFunction reduce_op)
+    {
+        (void) storage; // disables unused parameter warning
+        this->reduce(input, output, valid_items, reduce_op);
+    }
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_WARP_DETAIL_WARP_REDUCE_DPP_HPP_
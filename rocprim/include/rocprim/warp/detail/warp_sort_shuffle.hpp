@@ -28,6 +28,7 @@
 
 #include "../../intrinsics.hpp"
 #include "../../functional.hpp"
+#include "../../types.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -37,7 +38,8 @@ namespace detail
 template<
     class Key,
     unsigned int WarpSize,
-    class Value
+    class Value,
+    unsigned int ItemsPerThread = 1
 >
 class warp_sort_shuffle
 {
@@ -130,8 +132,94 @@ private:
         swap<0,  BinaryFunction>(kv..., 1,  get_bit(id, 0), compare_function);
     }
 
+    template<class T>
+    ROCPRIM_DEVICE inline
+    static T shuffle_xor(const T& input, unsigned int lane_mask)
+    {
+        return warp_shuffle_xor(input, lane_mask, WarpSize);
+    }
+
+    // Keys-only sorts carry empty values, there is nothing to exchange
+    ROCPRIM_DEVICE inline
+    static empty_type shuffle_xor(const empty_type& input, unsigned int lane_mask)
+    {
+        (void) lane_mask;
+        return input;
+    }
+
+    // Bitonic network over WarpSize * ItemsPerThread items, item i of lane l has
+    // index l * ItemsPerThread + i. Exchanges between items closer than ItemsPerThread
+    // happen in registers, farther ones with shuffles between lanes.
+    template<class V, class BinaryFunction>
+    ROCPRIM_DEVICE inline
+    void bitonic_sort(Key (&keys)[ItemsPerThread],
+                      V (&values)[ItemsPerThread],
+                      BinaryFunction compare_function)
+    {
+        constexpr unsigned int items = WarpSize * ItemsPerThread;
+        const unsigned int lane = detail::logical_lane_id<WarpSize>();
+
+        // All loops are unrolled so indices into keys and values are known at compile
+        // time and both arrays stay in registers
+        #pragma unroll
+        for(unsigned int size = 2; size <= items; size *= 2)
+        {
+            #pragma unroll
+            for(unsigned int stride = size / 2; stride > 0; stride /= 2)
+            {
+                if(stride < ItemsPerThread)
+                {
+                    #pragma unroll
+                    for(unsigned int i = 0; i < ItemsPerThread; i++)
+                    {
+                        const unsigned int j = i ^ stride;
+                        if(j > i)
+                        {
+                            const bool ascending = ((lane * ItemsPerThread + i) & size) == 0;
+                            if(compare_function(keys[j], keys[i]) == ascending)
+                            {
+                                const Key k = keys[i];
+                                keys[i] = keys[j];
+                                keys[j] = k;
+                                const V v = values[i];
+                                values[i] = values[j];
+                                values[j] = v;
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    const unsigned int lane_mask = stride / ItemsPerThread;
+                    const bool lower = (lane & lane_mask) == 0;
+                    #pragma unroll
+                    for(unsigned int i = 0; i < ItemsPerThread; i++)
+                    {
+                        const bool ascending = ((lane * ItemsPerThread + i) & size) == 0;
+                        const Key k = shuffle_xor(keys[i], lane_mask);
+                        const V v = shuffle_xor(values[i], lane_mask);
+                        // The lower item of a pair keeps the minimum in ascending
+                        // sequences, the upper one keeps the maximum
+                        const bool take = (lower == ascending)
+                            ? compare_function(k, keys[i])
+                            : compare_function(keys[i], k);
+                        if(take)
+                        {
+                            keys[i] = k;
+                            values[i] = v;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
 public:
     static_assert(detail::is_power_of_two(WarpSize), "WarpSize must be power of 2");
+    static_assert(
+        detail::is_power_of_two(ItemsPerThread) && ItemsPerThread <= 16,
+        "ItemsPerThread must be power of 2 and not greater than 16"
+    );
 
     using storage_type = ::rocprim::detail::empty_storage_type;
 
@@ -166,7 +254,41 @@ public:
               storage_type& storage, BinaryFunction compare_function)
     {
         (void) storage;
-        return sort(compare_function, thread_key, thread_value);
+        sort(thread_key, thread_value, compare_function);
+    }
+
+    template<class BinaryFunction>
+    ROCPRIM_DEVICE inline
+    void sort(Key (&thread_keys)[ItemsPerThread], BinaryFunction compare_function)
+    {
+        empty_type values[ItemsPerThread];
+        bitonic_sort(thread_keys, values, compare_function);
+    }
+
+    template<class BinaryFunction>
+    ROCPRIM_DEVICE inline
+    void sort(Key (&thread_keys)[ItemsPerThread], storage_type& storage,
+              BinaryFunction compare_function)
+    {
+        (void) storage;
+        sort(thread_keys, compare_function);
+    }
+
+    template<class BinaryFunction>
+    ROCPRIM_DEVICE inline
+    void sort(Key (&thread_keys)[ItemsPerThread], Value (&thread_values)[ItemsPerThread],
+              BinaryFunction compare_function)
+    {
+        bitonic_sort(thread_keys, thread_values, compare_function);
+    }
+
+    template<class BinaryFunction>
+    ROCPRIM_DEVICE inline
+    void sort(Key (&thread_keys)[ItemsPerThread], Value (&thread_values)[ItemsPerThread],
+              storage_type& storage, BinaryFunction compare_function)
+    {
+        (void) storage;
+        sort(thread_keys, thread_values, compare_function);
     }
 };
 
@@ -30,6 +30,7 @@
 #include "../functional.hpp"
 #include "../types.hpp"
 
+#include "detail/warp_reduce_dpp.hpp"
 #include "detail/warp_reduce_shuffle.hpp"
 #include "detail/warp_reduce_shared_mem.hpp"
 
@@ -41,14 +42,24 @@ BEGIN_ROCPRIM_NAMESPACE
 namespace detail
 {
 
-// Select warp_reduce implementation based WarpSize
+// Cross-lane (DPP- or shuffle-based) warp_reduce implementation, it does not need
+// storage, but requires logical warp size to be a power of two.
+template<class T, unsigned int WarpSize, bool UseAllReduce>
+using warp_reduce_crosslane = typename std::conditional<
+    // can we use DPP-based implementation?
+    detail::is_warp_dpp_type<T>::value,
+    detail::warp_reduce_dpp<T, WarpSize, UseAllReduce>, // yes
+    detail::warp_reduce_shuffle<T, WarpSize, UseAllReduce> // no
+>::type;
+
+// Select warp_reduce implementation based WarpSize and T
 template<class T, unsigned int WarpSize, bool UseAllReduce>
 struct select_warp_reduce_impl
 {
     typedef typename std::conditional<
         // can we use shuffle-based implementation?
         detail::is_warpsize_shuffleable<WarpSize>::value,
-        detail::warp_reduce_shuffle<T, WarpSize, UseAllReduce>, // yes
+        detail::warp_reduce_crosslane<T, WarpSize, UseAllReduce>, // yes
         detail::warp_reduce_shared_mem<T, WarpSize, UseAllReduce> // no
     >::type type;
 };
@@ -30,6 +30,7 @@
 #include "../functional.hpp"
 #include "../types.hpp"
 
+#include "detail/warp_scan_dpp.hpp"
 #include "detail/warp_scan_shuffle.hpp"
 #include "detail/warp_scan_shared_mem.hpp"
 
@@ -41,14 +42,24 @@ BEGIN_ROCPRIM_NAMESPACE
 namespace detail
 {
 
-// Select warp_scan implementation based WarpSize
+// Cross-lane (DPP- or shuffle-based) warp_scan implementation, it does not need
+// storage, but requires logical warp size to be a power of two.
+template<class T, unsigned int WarpSize>
+using warp_scan_crosslane = typename std::conditional<
+    // can we use DPP-based implementation?
+    detail::is_warp_dpp_type<T>::value,
+    detail::warp_scan_dpp<T, WarpSize>, // yes
+    detail::warp_scan_shuffle<T, WarpSize> // no
+>::type;
+
+// Select warp_scan implementation based WarpSize and T
 template<class T, unsigned int WarpSize>
 struct select_warp_scan_impl
 {
     typedef typename std::conditional<
         // can we use shuffle-based implementation?
         detail::is_warpsize_shuffleable<WarpSize>::value,
-        detail::warp_scan_shuffle<T, WarpSize>, // yes
+        detail::warp_scan_crosslane<T, WarpSize>, // yes
         detail::warp_scan_shared_mem<T, WarpSize> // no
     >::type type;
 };
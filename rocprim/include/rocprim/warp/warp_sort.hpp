@@ -43,9 +43,15 @@ BEGIN_ROCPRIM_NAMESPACE
 /// \tparam Key Data type for parameter Key
 /// \tparam WarpSize [optional] The number of threads in a warp
 /// \tparam Value [optional] Data type for parameter Value. By default, it's empty_type
+/// \tparam ItemsPerThread [optional] The number of items each thread sorts when arrays
+/// of keys (and values) are passed. By default, it's 1
 ///
 /// \par Overview
 /// * \p WarpSize must be power of two.
+/// * \p ItemsPerThread must be power of two and not greater than 16. When sorting
+/// arrays, a logical warp sorts <tt>WarpSize * ItemsPerThread</tt> items and the result
+/// is blocked: thread \p i gets items from <tt>i * ItemsPerThread</tt> to
+/// <tt>(i + 1) * ItemsPerThread - 1</tt> of the sorted sequence.
 /// * \p WarpSize must be equal to or less than the size of hardware warp (see
 /// rocprim::warp_size()). If it is less, sort is performed separately within groups
 /// determined by WarpSize.
@@ -110,11 +116,12 @@ BEGIN_ROCPRIM_NAMESPACE
 template<
     class Key,
     unsigned int WarpSize = warp_size(),
-    class Value = empty_type
+    class Value = empty_type,
+    unsigned int ItemsPerThread = 1
 >
-class warp_sort : detail::warp_sort_shuffle<Key, WarpSize, Value>
+class warp_sort : detail::warp_sort_shuffle<Key, WarpSize, Value, ItemsPerThread>
 {
-    typedef typename detail::warp_sort_shuffle<Key, WarpSize, Value> base_type;
+    typedef typename detail::warp_sort_shuffle<Key, WarpSize, Value, ItemsPerThread> base_type;
 
     // Check if WarpSize is correct
     static_assert(WarpSize <= warp_size(), "WarpSize can't be greater than hardware warp size.");
@@ -259,6 +266,109 @@ public:
             thread_key, thread_value, storage, compare_function
         );
     }
+
+    /// \brief Warp sort for arrays of keys, each thread provides \p ItemsPerThread keys.
+    ///
+    /// \tparam BinaryFunction - type of binary function used for sort. Default type
+    /// is rocprim::less<T>.
+    ///
+    /// \param thread_keys - input/output keys of the thread, after the sort they hold
+    /// a blocked range of the sorted sequence
+    /// \param compare_function - binary operation function object that will be used for sort.
+    /// The signature of the function should be equivalent to the following:
+    /// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+    /// <tt>const &</tt>, but function object must not modify the objects passed to it.
+    ///
+    /// \par Example.
+    /// \code{.cpp}
+    /// __global__ void ExampleKernel(...)
+    /// {
+    ///     int keys[4];
+    ///     ...
+    ///     rocprim::warp_sort<int, 64, rocprim::empty_type, 4> wsort;
+    ///     // sorts 256 keys, thread i gets keys from 4 * i to 4 * i + 3
+    ///     wsort.sort(keys);
+    ///     ...
+    /// }
+    /// \endcode
+    template<class BinaryFunction = ::rocprim::less<Key>>
+    ROCPRIM_DEVICE inline
+    void sort(Key (&thread_keys)[ItemsPerThread],
+              BinaryFunction compare_function = BinaryFunction())
+    {
+        base_type::sort(thread_keys, compare_function);
+    }
+
+    /// \brief Warp sort for arrays of keys using temporary storage.
+    ///
+    /// \tparam BinaryFunction - type of binary function used for sort. Default type
+    /// is rocprim::less<T>.
+    ///
+    /// \param thread_keys - input/output keys of the thread
+    /// \param storage - temporary storage for inputs
+    /// \param compare_function - binary operation function object that will be used for sort.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() in HIP, \p tile_barrier::wait() in HC, or
+    /// universal rocprim::syncthreads().
+    template<class BinaryFunction = ::rocprim::less<Key>>
+    ROCPRIM_DEVICE inline
+    void sort(Key (&thread_keys)[ItemsPerThread],
+              storage_type& storage,
+              BinaryFunction compare_function = BinaryFunction())
+    {
+        base_type::sort(thread_keys, storage, compare_function);
+    }
+
+    /// \brief Warp sort by key for arrays of keys and values, each thread provides
+    /// \p ItemsPerThread pairs.
+    ///
+    /// \tparam BinaryFunction - type of binary function used for sort. Default type
+    /// is rocprim::less<T>.
+    ///
+    /// \param thread_keys - input/output keys of the thread
+    /// \param thread_values - input/output values of the thread
+    /// \param compare_function - binary operation function object that will be used for sort.
+    /// The signature of the function should be equivalent to the following:
+    /// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+    /// <tt>const &</tt>, but function object must not modify the objects passed to it.
+    template<class BinaryFunction = ::rocprim::less<Key>>
+    ROCPRIM_DEVICE inline
+    void sort(Key (&thread_keys)[ItemsPerThread],
+              Value (&thread_values)[ItemsPerThread],
+              BinaryFunction compare_function = BinaryFunction())
+    {
+        base_type::sort(
+            thread_keys, thread_values, compare_function
+        );
+    }
+
+    /// \brief Warp sort by key for arrays of keys and values using temporary storage.
+    ///
+    /// \tparam BinaryFunction - type of binary function used for sort. Default type
+    /// is rocprim::less<T>.
+    ///
+    /// \param thread_keys - input/output keys of the thread
+    /// \param thread_values - input/output values of the thread
+    /// \param storage - temporary storage for inputs
+    /// \param compare_function - binary operation function object that will be used for sort.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() in HIP, \p tile_barrier::wait() in HC, or
+    /// universal rocprim::syncthreads().
+    template<class BinaryFunction = ::rocprim::less<Key>>
+    ROCPRIM_DEVICE inline
+    void sort(Key (&thread_keys)[ItemsPerThread],
+              Value (&thread_values)[ItemsPerThread],
+              storage_type& storage,
+              BinaryFunction compare_function = BinaryFunction())
+    {
+        base_type::sort(
+            thread_keys, thread_values, storage, compare_function
+        );
+    }
 };
 
 END_ROCPRIM_NAMESPACE
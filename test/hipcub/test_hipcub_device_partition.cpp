@@ -0,0 +1,355 @@
+// MIT License
+//
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// hipCUB API
+#include <hipcub/hipcub.hpp>
+
+#include "test_utils.hpp"
+
+#define HIP_CHECK(error) ASSERT_EQ(static_cast<hipError_t>(error), hipSuccess)
+
+// Params for tests
+template<
+    class InputType,
+    class OutputType = InputType,
+    class FlagType = unsigned int
+>
+struct DevicePartitionParams
+{
+    using input_type = InputType;
+    using output_type = OutputType;
+    using flag_type = FlagType;
+};
+
+template<class Params>
+class HipcubDevicePartitionTests : public ::testing::Test
+{
+public:
+    using input_type = typename Params::input_type;
+    using output_type = typename Params::output_type;
+    using flag_type = typename Params::flag_type;
+    const bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<
+    DevicePartitionParams<int, long>,
+    DevicePartitionParams<unsigned char, float>
+> HipcubDevicePartitionTestsParams;
+
+std::vector<size_t> get_sizes()
+{
+    std::vector<size_t> sizes = {
+        2, 32, 64, 256,
+        1024, 2048,
+        3072, 4096,
+        27845, (1 << 18) + 1111
+    };
+    const std::vector<size_t> random_sizes = test_utils::get_random_data<size_t>(2, 1, 16384);
+    sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
+    std::sort(sizes.begin(), sizes.end());
+    return sizes;
+}
+
+TYPED_TEST_CASE(HipcubDevicePartitionTests, HipcubDevicePartitionTestsParams);
+
+TYPED_TEST(HipcubDevicePartitionTests, Flagged)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    using F = typename TestFixture::flag_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hipStream_t stream = 0; // default stream
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+        std::vector<F> flags = test_utils::get_random_data<F>(size, 0, 1);
+
+        T * d_input;
+        F * d_flags;
+        U * d_output;
+        unsigned int * d_selected_count_output;
+        HIP_CHECK(hipMalloc(&d_input, input.size() * sizeof(T)));
+        HIP_CHECK(hipMalloc(&d_flags, flags.size() * sizeof(F)));
+        HIP_CHECK(hipMalloc(&d_output, input.size() * sizeof(U)));
+        HIP_CHECK(hipMalloc(&d_selected_count_output, sizeof(unsigned int)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_input, input.data(),
+                input.size() * sizeof(T),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                d_flags, flags.data(),
+                flags.size() * sizeof(F),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Calculate expected results on host: selected values in order,
+        // then rejected values in reverse order
+        std::vector<U> expected_selected;
+        std::vector<U> expected_rejected;
+        for(size_t i = 0; i < input.size(); i++)
+        {
+            if(flags[i] != 0)
+            {
+                expected_selected.push_back(input[i]);
+            }
+            else
+            {
+                expected_rejected.push_back(input[i]);
+            }
+        }
+        std::vector<U> expected = expected_selected;
+        expected.insert(expected.end(), expected_rejected.rbegin(), expected_rejected.rend());
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            hipcub::DevicePartition::Flagged(
+                nullptr,
+                temp_storage_size_bytes,
+                d_input,
+                d_flags,
+                d_output,
+                d_selected_count_output,
+                input.size(),
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        void * d_temp_storage = nullptr;
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            hipcub::DevicePartition::Flagged(
+                d_temp_storage,
+                temp_storage_size_bytes,
+                d_input,
+                d_flags,
+                d_output,
+                d_selected_count_output,
+                input.size(),
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if number of selected value is as expected
+        unsigned int selected_count_output = 0;
+        HIP_CHECK(
+            hipMemcpy(
+                &selected_count_output, d_selected_count_output,
+                sizeof(unsigned int),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        ASSERT_EQ(selected_count_output, expected_selected.size());
+
+        // Check if output values are as expected
+        std::vector<U> output(input.size());
+        HIP_CHECK(
+            hipMemcpy(
+                output.data(), d_output,
+                output.size() * sizeof(U),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        for(size_t i = 0; i < expected.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(output[i], expected[i]);
+        }
+
+        hipFree(d_input);
+        hipFree(d_flags);
+        hipFree(d_output);
+        hipFree(d_selected_count_output);
+        hipFree(d_temp_storage);
+    }
+}
+
+struct TestSelectOp
+{
+    template<class T>
+    __host__ __device__ inline
+    bool operator()(const T& value) const
+    {
+        if(value == T(50)) return true;
+        return false;
+    }
+};
+
+TYPED_TEST(HipcubDevicePartitionTests, If)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hipStream_t stream = 0; // default stream
+
+    TestSelectOp select_op;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+
+        T * d_input;
+        U * d_output;
+        unsigned int * d_selected_count_output;
+        HIP_CHECK(hipMalloc(&d_input, input.size() * sizeof(T)));
+        HIP_CHECK(hipMalloc(&d_output, input.size() * sizeof(U)));
+        HIP_CHECK(hipMalloc(&d_selected_count_output, sizeof(unsigned int)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_input, input.data(),
+                input.size() * sizeof(T),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Calculate expected results on host
+        std::vector<U> expected_selected;
+        std::vector<U> expected_rejected;
+        for(size_t i = 0; i < input.size(); i++)
+        {
+            if(select_op(input[i]))
+            {
+                expected_selected.push_back(input[i]);
+            }
+            else
+            {
+                expected_rejected.push_back(input[i]);
+            }
+        }
+        std::vector<U> expected = expected_selected;
+        expected.insert(expected.end(), expected_rejected.rbegin(), expected_rejected.rend());
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            hipcub::DevicePartition::If(
+                nullptr,
+                temp_storage_size_bytes,
+                d_input,
+                d_output,
+                d_selected_count_output,
+                input.size(),
+                select_op,
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        void * d_temp_storage = nullptr;
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            hipcub::DevicePartition::If(
+                d_temp_storage,
+                temp_storage_size_bytes,
+                d_input,
+                d_output,
+                d_selected_count_output,
+                input.size(),
+                select_op,
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if number of selected value is as expected
+        unsigned int selected_count_output = 0;
+        HIP_CHECK(
+            hipMemcpy(
+                &selected_count_output, d_selected_count_output,
+                sizeof(unsigned int),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        ASSERT_EQ(selected_count_output, expected_selected.size());
+
+        // Check if output values are as expected
+        std::vector<U> output(input.size());
+        HIP_CHECK(
+            hipMemcpy(
+                output.data(), d_output,
+                output.size() * sizeof(U),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        for(size_t i = 0; i < expected.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(output[i], expected[i]);
+        }
+
+        hipFree(d_input);
+        hipFree(d_output);
+        hipFree(d_selected_count_output);
+        hipFree(d_temp_storage);
+    }
+}
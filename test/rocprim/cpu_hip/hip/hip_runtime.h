@@ -0,0 +1,116 @@
+// Copyright (c) 2017 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef TEST_ROCPRIM_CPU_HIP_HIP_RUNTIME_H_
+#define TEST_ROCPRIM_CPU_HIP_HIP_RUNTIME_H_
+
+// Host implementation of the part of HIP runtime API used by device-level tests,
+// so the same tests are built against the CPU backend of rocPRIM (ROCPRIM_CPU_API).
+// "Device" memory is host memory and all operations are synchronous.
+
+#include <cstdlib>
+#include <cstring>
+
+#include <rocprim/device/cpu_types.hpp>
+
+// Function qualifiers used by callables in tests, all of them run on the host
+#define __host__
+#define __device__
+#define __forceinline__ inline
+
+using hipError_t = ::rocprim::error_t;
+using hipStream_t = ::rocprim::stream_t;
+
+constexpr hipError_t hipSuccess = ::rocprim::success;
+constexpr hipError_t hipErrorInvalidValue = ::rocprim::invalid_value;
+
+enum hipMemcpyKind
+{
+    hipMemcpyHostToHost = 0,
+    hipMemcpyHostToDevice = 1,
+    hipMemcpyDeviceToHost = 2,
+    hipMemcpyDeviceToDevice = 3,
+    hipMemcpyDefault = 4
+};
+
+template<class T>
+inline
+hipError_t hipMalloc(T ** ptr, size_t size)
+{
+    // Allocate at least one byte, so a valid pointer is returned for empty ranges
+    *ptr = static_cast<T *>(std::malloc(size == 0 ? 1 : size));
+    return *ptr != nullptr ? hipSuccess : hipErrorInvalidValue;
+}
+
+template<class T>
+inline
+hipError_t hipHostMalloc(T ** ptr, size_t size, unsigned int /* flags */ = 0)
+{
+    return hipMalloc(ptr, size);
+}
+
+inline
+hipError_t hipFree(void * ptr)
+{
+    std::free(ptr);
+    return hipSuccess;
+}
+
+inline
+hipError_t hipHostFree(void * ptr)
+{
+    return hipFree(ptr);
+}
+
+inline
+hipError_t hipMemcpy(void * dst, const void * src, size_t size, hipMemcpyKind /* kind */)
+{
+    if(size > 0)
+    {
+        std::memcpy(dst, src, size);
+    }
+    return hipSuccess;
+}
+
+inline
+hipError_t hipDeviceSynchronize()
+{
+    return hipSuccess;
+}
+
+inline
+hipError_t hipStreamSynchronize(hipStream_t /* stream */)
+{
+    return hipSuccess;
+}
+
+inline
+hipError_t hipPeekAtLastError()
+{
+    return hipSuccess;
+}
+
+inline
+hipError_t hipGetLastError()
+{
+    return hipSuccess;
+}
+
+#endif // TEST_ROCPRIM_CPU_HIP_HIP_RUNTIME_H_
@@ -0,0 +1,351 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+// HC API
+#include <hcc/hc.hpp>
+// rocPRIM API
+#include <rocprim/rocprim.hpp>
+
+#include "test_utils.hpp"
+
+namespace rp = rocprim;
+
+template<
+    class InputType,
+    class OutputType = InputType
+>
+struct DeviceBatchedParams
+{
+    using input_type = InputType;
+    using output_type = OutputType;
+};
+
+template<class Params>
+class RocprimDeviceBatchedTests : public ::testing::Test
+{
+public:
+    using input_type = typename Params::input_type;
+    using output_type = typename Params::output_type;
+    const bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<
+    DeviceBatchedParams<int>,
+    DeviceBatchedParams<unsigned long>,
+    DeviceBatchedParams<short, int>,
+    DeviceBatchedParams<float, double>
+> RocprimDeviceBatchedTestsParams;
+
+TYPED_TEST_CASE(RocprimDeviceBatchedTests, RocprimDeviceBatchedTestsParams);
+
+// Mostly tiny problems, some of them are empty and some take many tiles
+std::vector<size_t> get_problem_sizes(unsigned int problems)
+{
+    std::random_device rd;
+    std::default_random_engine gen(rd());
+    std::uniform_int_distribution<size_t> small_dis(0, 300);
+    std::uniform_int_distribution<size_t> large_dis(0, 20000);
+    std::vector<size_t> sizes(problems);
+    for(unsigned int i = 0; i < problems; i++)
+    {
+        sizes[i] = i % 17 == 5 ? large_dis(gen) : small_dis(gen);
+    }
+    return sizes;
+}
+
+// Problems are placed in a single allocation in reverse order with gaps between them,
+// returns offsets of problems and the size of the allocation
+size_t get_problem_offsets(const std::vector<size_t>& sizes, std::vector<size_t>& offsets)
+{
+    offsets.resize(sizes.size());
+    size_t offset = 0;
+    for(size_t i = sizes.size(); i > 0; i--)
+    {
+        offsets[i - 1] = offset;
+        offset += sizes[i - 1] + 3;
+    }
+    return offset;
+}
+
+TYPED_TEST(RocprimDeviceBatchedTests, InclusiveScanSum)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    for(unsigned int problems : { 1u, 10u, 1000u })
+    {
+        SCOPED_TRACE(testing::Message() << "with problems = " << problems);
+
+        const std::vector<size_t> sizes = get_problem_sizes(problems);
+        std::vector<size_t> offsets;
+        const size_t total_size = get_problem_offsets(sizes, offsets);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(total_size, 1, 10);
+
+        hc::array<T> d_input(hc::extent<1>(total_size), input.begin(), acc_view);
+        hc::array<U> d_output(total_size, acc_view);
+
+        std::vector<T *> inputs(problems);
+        std::vector<U *> outputs(problems);
+        for(unsigned int i = 0; i < problems; i++)
+        {
+            inputs[i] = d_input.accelerator_pointer() + offsets[i];
+            outputs[i] = d_output.accelerator_pointer() + offsets[i];
+        }
+        hc::array<T *> d_inputs(hc::extent<1>(problems), inputs.begin(), acc_view);
+        hc::array<U *> d_outputs(hc::extent<1>(problems), outputs.begin(), acc_view);
+        acc_view.wait();
+
+        // scan function
+        ::rocprim::plus<U> plus_op;
+
+        // Calculate expected results on host
+        std::vector<U> expected(total_size, 0);
+        for(unsigned int i = 0; i < problems; i++)
+        {
+            test_utils::host_inclusive_scan(
+                input.begin() + offsets[i], input.begin() + offsets[i] + sizes[i],
+                expected.begin() + offsets[i], plus_op
+            );
+        }
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        rocprim::batched_inclusive_scan(
+            nullptr, temp_storage_size_bytes,
+            d_inputs.accelerator_pointer(), d_outputs.accelerator_pointer(), sizes.data(), problems,
+            plus_op, acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        hc::array<char> d_temp_storage(temp_storage_size_bytes, acc_view);
+        acc_view.wait();
+
+        // Run
+        rocprim::batched_inclusive_scan(
+            d_temp_storage.accelerator_pointer(), temp_storage_size_bytes,
+            d_inputs.accelerator_pointer(), d_outputs.accelerator_pointer(), sizes.data(), problems,
+            plus_op, acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // Check if output values are as expected
+        std::vector<U> output = d_output;
+        for(unsigned int i = 0; i < problems; i++)
+        {
+            for(size_t j = offsets[i]; j < offsets[i] + sizes[i]; j++)
+            {
+                SCOPED_TRACE(testing::Message() << "where problem = " << i << ", index = " << j);
+                auto diff = std::max<U>(std::abs(0.01f * expected[j]), U(0.01f));
+                if(std::is_integral<U>::value) diff = 0;
+                ASSERT_NEAR(output[j], expected[j], diff);
+            }
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceBatchedTests, ExclusiveScanSum)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    for(unsigned int problems : { 1u, 10u, 1000u })
+    {
+        SCOPED_TRACE(testing::Message() << "with problems = " << problems);
+
+        const std::vector<size_t> sizes = get_problem_sizes(problems);
+        std::vector<size_t> offsets;
+        const size_t total_size = get_problem_offsets(sizes, offsets);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(total_size, 1, 10);
+        const U initial_value = test_utils::get_random_value<U>(1, 100);
+
+        hc::array<T> d_input(hc::extent<1>(total_size), input.begin(), acc_view);
+        hc::array<U> d_output(total_size, acc_view);
+
+        std::vector<T *> inputs(problems);
+        std::vector<U *> outputs(problems);
+        for(unsigned int i = 0; i < problems; i++)
+        {
+            inputs[i] = d_input.accelerator_pointer() + offsets[i];
+            outputs[i] = d_output.accelerator_pointer() + offsets[i];
+        }
+        hc::array<T *> d_inputs(hc::extent<1>(problems), inputs.begin(), acc_view);
+        hc::array<U *> d_outputs(hc::extent<1>(problems), outputs.begin(), acc_view);
+        acc_view.wait();
+
+        // scan function
+        ::rocprim::plus<U> plus_op;
+
+        // Calculate expected results on host
+        std::vector<U> expected(total_size, 0);
+        for(unsigned int i = 0; i < problems; i++)
+        {
+            test_utils::host_exclusive_scan(
+                input.begin() + offsets[i], input.begin() + offsets[i] + sizes[i],
+                initial_value, expected.begin() + offsets[i], plus_op
+            );
+        }
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        rocprim::batched_exclusive_scan(
+            nullptr, temp_storage_size_bytes,
+            d_inputs.accelerator_pointer(), d_outputs.accelerator_pointer(), sizes.data(), problems,
+            initial_value, plus_op, acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        hc::array<char> d_temp_storage(temp_storage_size_bytes, acc_view);
+        acc_view.wait();
+
+        // Run
+        rocprim::batched_exclusive_scan(
+            d_temp_storage.accelerator_pointer(), temp_storage_size_bytes,
+            d_inputs.accelerator_pointer(), d_outputs.accelerator_pointer(), sizes.data(), problems,
+            initial_value, plus_op, acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // Check if output values are as expected
+        std::vector<U> output = d_output;
+        for(unsigned int i = 0; i < problems; i++)
+        {
+            for(size_t j = offsets[i]; j < offsets[i] + sizes[i]; j++)
+            {
+                SCOPED_TRACE(testing::Message() << "where problem = " << i << ", index = " << j);
+                auto diff = std::max<U>(std::abs(0.01f * expected[j]), U(0.01f));
+                if(std::is_integral<U>::value) diff = 0;
+                ASSERT_NEAR(output[j], expected[j], diff);
+            }
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceBatchedTests, ReduceSum)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    for(unsigned int problems : { 1u, 10u, 1000u })
+    {
+        SCOPED_TRACE(testing::Message() << "with problems = " << problems);
+
+        const std::vector<size_t> sizes = get_problem_sizes(problems);
+        std::vector<size_t> offsets;
+        const size_t total_size = get_problem_offsets(sizes, offsets);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(total_size, 1, 10);
+        const U initial_value = test_utils::get_random_value<U>(1, 100);
+
+        hc::array<T> d_input(hc::extent<1>(total_size), input.begin(), acc_view);
+        hc::array<U> d_output(problems, acc_view);
+
+        std::vector<T *> inputs(problems);
+        for(unsigned int i = 0; i < problems; i++)
+        {
+            inputs[i] = d_input.accelerator_pointer() + offsets[i];
+        }
+        hc::array<T *> d_inputs(hc::extent<1>(problems), inputs.begin(), acc_view);
+        acc_view.wait();
+
+        // reduce function
+        ::rocprim::plus<U> plus_op;
+
+        // Calculate expected results on host
+        std::vector<U> expected(problems);
+        for(unsigned int i = 0; i < problems; i++)
+        {
+            U accumulator = initial_value;
+            for(size_t j = offsets[i]; j < offsets[i] + sizes[i]; j++)
+            {
+                accumulator = plus_op(accumulator, static_cast<U>(input[j]));
+            }
+            expected[i] = accumulator;
+        }
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        rocprim::batched_reduce(
+            nullptr, temp_storage_size_bytes,
+            d_inputs.accelerator_pointer(), d_output.accelerator_pointer(), sizes.data(), problems,
+            initial_value, plus_op, acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        hc::array<char> d_temp_storage(temp_storage_size_bytes, acc_view);
+        acc_view.wait();
+
+        // Run
+        rocprim::batched_reduce(
+            d_temp_storage.accelerator_pointer(), temp_storage_size_bytes,
+            d_inputs.accelerator_pointer(), d_output.accelerator_pointer(), sizes.data(), problems,
+            initial_value, plus_op, acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // Check if output values are as expected
+        std::vector<U> output = d_output;
+        for(unsigned int i = 0; i < problems; i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where problem = " << i);
+            auto diff = std::max<U>(std::abs(0.01f * expected[i]), U(0.01f));
+            if(std::is_integral<U>::value) diff = 0;
+            ASSERT_NEAR(output[i], expected[i], diff);
+        }
+    }
+}
@@ -132,6 +132,7 @@ typedef ::testing::Types<
     params1<int, 10, 0, 10>,
     params1<int, 128, 0, 256>,
     params1<unsigned int, 12345, 10, 12355, short>,
+    params1<unsigned short, 4096, 0, 8192, int>,
     params1<unsigned short, 65536, 0, 65536, int>,
     params1<unsigned char, 10, 20, 240, unsigned char, unsigned int>,
     params1<unsigned char, 256, 0, 256, short>,
@@ -0,0 +1,247 @@
+// MIT License
+//
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// HC API
+#include <hcc/hc.hpp>
+// rocPRIM API
+#include <rocprim/rocprim.hpp>
+
+#include "test_utils.hpp"
+
+// Compares only x, so keys with equal x and different y are equivalent
+struct custom_test_type_less
+{
+    template<class T>
+    ROCPRIM_HOST_DEVICE
+    bool operator()(const test_utils::custom_test_type<T>& a,
+                    const test_utils::custom_test_type<T>& b) const
+    {
+        return a.x < b.x;
+    }
+};
+
+// Params for tests
+template<
+    class KeyType,
+    class ValueType,
+    class CompareFunction = rocprim::less<KeyType>
+>
+struct DeviceMergeSortParams
+{
+    using key_type = KeyType;
+    using value_type = ValueType;
+    using compare_function = CompareFunction;
+};
+
+template<class Params>
+class RocprimDeviceMergeSortTests : public ::testing::Test
+{
+public:
+    using key_type = typename Params::key_type;
+    using value_type = typename Params::value_type;
+    using compare_function = typename Params::compare_function;
+    const bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<
+    DeviceMergeSortParams<int, int>,
+    DeviceMergeSortParams<unsigned char, float, rocprim::greater<unsigned char>>,
+    DeviceMergeSortParams<double, unsigned int>,
+    DeviceMergeSortParams<test_utils::custom_test_type<int>, long, custom_test_type_less>
+> RocprimDeviceMergeSortTestsParams;
+
+std::vector<size_t> get_sizes()
+{
+    std::vector<size_t> sizes = {
+        1, 10, 53, 211,
+        1024, 2048, 5096,
+        34567, (1 << 17) - 1220, (1 << 20) + 1111
+    };
+    const std::vector<size_t> random_sizes = test_utils::get_random_data<size_t>(2, 1, 100000);
+    sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
+    std::sort(sizes.begin(), sizes.end());
+    return sizes;
+}
+
+// Keys with many duplicates, so the order of equivalent keys is checked
+template<class Key>
+std::vector<Key> get_keys(size_t size)
+{
+    const std::vector<int> random_keys = test_utils::get_random_data<int>(size, 0, 100);
+    std::vector<Key> keys(size);
+    for(size_t i = 0; i < size; i++)
+    {
+        keys[i] = Key(random_keys[i]);
+    }
+    return keys;
+}
+
+TYPED_TEST_CASE(RocprimDeviceMergeSortTests, RocprimDeviceMergeSortTestsParams);
+
+TYPED_TEST(RocprimDeviceMergeSortTests, SortKeys)
+{
+    using key_type = typename TestFixture::key_type;
+    using compare_function = typename TestFixture::compare_function;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<key_type> keys_input = get_keys<key_type>(size);
+
+        hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+        hc::array<key_type> d_keys_output(size, acc_view);
+        acc_view.wait();
+
+        // Calculate expected results on host
+        std::vector<key_type> expected(keys_input);
+        std::stable_sort(expected.begin(), expected.end(), compare_function());
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        rocprim::merge_sort(
+            nullptr, temp_storage_size_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(), size,
+            compare_function(), acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        hc::array<char> d_temp_storage(temp_storage_size_bytes, acc_view);
+        acc_view.wait();
+
+        // Run
+        rocprim::merge_sort(
+            d_temp_storage.accelerator_pointer(), temp_storage_size_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(), size,
+            compare_function(), acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // Check if output values are as expected
+        std::vector<key_type> keys_output = d_keys_output;
+        for(size_t i = 0; i < size; i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(keys_output[i], expected[i]);
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceMergeSortTests, SortPairs)
+{
+    using key_type = typename TestFixture::key_type;
+    using value_type = typename TestFixture::value_type;
+    using compare_function = typename TestFixture::compare_function;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data, values are original positions of keys
+        std::vector<key_type> keys_input = get_keys<key_type>(size);
+        std::vector<value_type> values_input(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            values_input[i] = static_cast<value_type>(i);
+        }
+
+        hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+        hc::array<key_type> d_keys_output(size, acc_view);
+        hc::array<value_type> d_values_input(hc::extent<1>(size), values_input.begin(), acc_view);
+        hc::array<value_type> d_values_output(size, acc_view);
+        acc_view.wait();
+
+        // Calculate expected results on host, the sort must be stable
+        std::vector<std::pair<key_type, value_type>> expected(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            expected[i] = std::make_pair(keys_input[i], values_input[i]);
+        }
+        std::stable_sort(
+            expected.begin(), expected.end(),
+            [](const std::pair<key_type, value_type>& a, const std::pair<key_type, value_type>& b)
+            {
+                return compare_function()(a.first, b.first);
+            }
+        );
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        rocprim::merge_sort(
+            nullptr, temp_storage_size_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+            d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(), size,
+            compare_function(), acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        hc::array<char> d_temp_storage(temp_storage_size_bytes, acc_view);
+        acc_view.wait();
+
+        // Run
+        rocprim::merge_sort(
+            d_temp_storage.accelerator_pointer(), temp_storage_size_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+            d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(), size,
+            compare_function(), acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        // Check if output values are as expected
+        std::vector<key_type> keys_output = d_keys_output;
+        std::vector<value_type> values_output = d_values_output;
+        for(size_t i = 0; i < size; i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(keys_output[i], expected[i].first);
+            ASSERT_EQ(values_output[i], expected[i].second);
+        }
+    }
+}
@@ -0,0 +1,494 @@
+// MIT License
+//
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include <utility>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// HC API
+#include <hcc/hc.hpp>
+// rocPRIM API
+#include <rocprim/rocprim.hpp>
+
+#include "test_utils.hpp"
+
+namespace rp = rocprim;
+
+template<
+    class Key,
+    class Value,
+    bool Largest,
+    int MaxKey = 100
+>
+struct params
+{
+    using key_type = Key;
+    using value_type = Value;
+    static constexpr bool largest = Largest;
+    static constexpr int max_key = MaxKey;
+};
+
+template<class Params>
+class RocprimDeviceRadixSelect : public ::testing::Test {
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<
+    params<int, int, true>,
+    params<int, float, false>,
+    params<unsigned char, int, true, 255>,
+    params<short, double, false, 10>,
+    params<unsigned long long, char, true, 1000000>,
+    params<float, int, true>,
+    params<double, unsigned int, false>
+> Params;
+
+TYPED_TEST_CASE(RocprimDeviceRadixSelect, Params);
+
+template<class Key>
+std::vector<Key> get_keys(size_t size, int max_key)
+{
+    // Many equal keys check that the first ones are selected
+    if(std::is_floating_point<Key>::value)
+    {
+        return test_utils::get_random_data<Key>(size, (Key)-max_key, (Key)max_key);
+    }
+    return test_utils::get_random_data<Key>(
+        size,
+        std::is_signed<Key>::value ? (Key)-max_key : (Key)0,
+        (Key)max_key
+    );
+}
+
+// Indices of selected items in the order of the selection without sorting:
+// items better than the k-th item and then the first items equal to it
+template<class Key>
+std::vector<size_t> get_expected_indices(const std::vector<Key>& keys, size_t k, bool largest, bool sorted)
+{
+    std::vector<size_t> indices(keys.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    auto better = [&](size_t a, size_t b)
+    {
+        return largest ? (keys[b] < keys[a]) : (keys[a] < keys[b]);
+    };
+    std::stable_sort(indices.begin(), indices.end(), better);
+    indices.resize(std::min(k, keys.size()));
+    if(!sorted)
+    {
+        std::sort(indices.begin(), indices.end());
+    }
+    return indices;
+}
+
+std::vector<size_t> get_sizes()
+{
+    std::vector<size_t> sizes = { 1, 10, 53, 211, 1024, 2345, 4096, 34567, (1 << 16) - 1220, (1 << 22) - 76543 };
+    const std::vector<size_t> random_sizes = test_utils::get_random_data<size_t>(5, 1, 100000);
+    sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
+    return sizes;
+}
+
+TYPED_TEST(RocprimDeviceRadixSelect, TopKKeys)
+{
+    using key_type = typename TestFixture::params::key_type;
+    constexpr bool largest = TestFixture::params::largest;
+    constexpr int max_key = TestFixture::params::max_key;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const bool debug_synchronous = false;
+
+    for(size_t size : get_sizes())
+    {
+        for(size_t k : { size_t(1), size_t(7), size_t(1000), size })
+        {
+            for(bool sorted : { false, true })
+            {
+                SCOPED_TRACE(testing::Message() << "with size = " << size);
+                SCOPED_TRACE(testing::Message() << "with k = " << k);
+                SCOPED_TRACE(testing::Message() << "with sorted = " << sorted);
+
+                const std::vector<key_type> keys_input = get_keys<key_type>(size, max_key);
+                const size_t selected = std::min(k, size);
+
+                hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+                hc::array<key_type> d_keys_output(selected, acc_view);
+
+                // Calculate expected results on host
+                const std::vector<size_t> indices = get_expected_indices(keys_input, k, largest, sorted);
+
+                size_t temporary_storage_bytes;
+                rp::topk_keys(
+                    nullptr, temporary_storage_bytes,
+                    d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+                    size, k, sorted
+                );
+
+                ASSERT_GT(temporary_storage_bytes, 0);
+
+                hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+                if(largest)
+                {
+                    rp::topk_keys(
+                        d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+                        d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+                        size, k, sorted,
+                        acc_view, debug_synchronous
+                    );
+                }
+                else
+                {
+                    rp::bottomk_keys(
+                        d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+                        d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+                        size, k, sorted,
+                        acc_view, debug_synchronous
+                    );
+                }
+                acc_view.wait();
+
+                std::vector<key_type> keys_output = d_keys_output;
+                for(size_t i = 0; i < selected; i++)
+                {
+                    ASSERT_EQ(keys_output[i], keys_input[indices[i]]);
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceRadixSelect, TopKPairs)
+{
+    using key_type = typename TestFixture::params::key_type;
+    using value_type = typename TestFixture::params::value_type;
+    constexpr bool largest = TestFixture::params::largest;
+    constexpr int max_key = TestFixture::params::max_key;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const bool debug_synchronous = false;
+
+    for(size_t size : get_sizes())
+    {
+        for(size_t k : { size_t(1), size_t(100), size_t(5000) })
+        {
+            for(bool sorted : { false, true })
+            {
+                SCOPED_TRACE(testing::Message() << "with size = " << size);
+                SCOPED_TRACE(testing::Message() << "with k = " << k);
+                SCOPED_TRACE(testing::Message() << "with sorted = " << sorted);
+
+                const std::vector<key_type> keys_input = get_keys<key_type>(size, max_key);
+                std::vector<value_type> values_input(size);
+                for(size_t i = 0; i < size; i++)
+                {
+                    values_input[i] = static_cast<value_type>(i);
+                }
+                const size_t selected = std::min(k, size);
+
+                hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+                hc::array<key_type> d_keys_output(selected, acc_view);
+                hc::array<value_type> d_values_input(hc::extent<1>(size), values_input.begin(), acc_view);
+                hc::array<value_type> d_values_output(selected, acc_view);
+
+                // Calculate expected results on host
+                const std::vector<size_t> indices = get_expected_indices(keys_input, k, largest, sorted);
+
+                size_t temporary_storage_bytes;
+                rp::topk_pairs(
+                    nullptr, temporary_storage_bytes,
+                    d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+                    d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+                    size, k, sorted
+                );
+
+                ASSERT_GT(temporary_storage_bytes, 0);
+
+                hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+                if(largest)
+                {
+                    rp::topk_pairs(
+                        d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+                        d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+                        d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+                        size, k, sorted,
+                        acc_view, debug_synchronous
+                    );
+                }
+                else
+                {
+                    rp::bottomk_pairs(
+                        d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+                        d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+                        d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+                        size, k, sorted,
+                        acc_view, debug_synchronous
+                    );
+                }
+                acc_view.wait();
+
+                std::vector<key_type> keys_output = d_keys_output;
+                std::vector<value_type> values_output = d_values_output;
+                for(size_t i = 0; i < selected; i++)
+                {
+                    ASSERT_EQ(keys_output[i], keys_input[indices[i]]);
+                    ASSERT_EQ(values_output[i], values_input[indices[i]]);
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceRadixSelect, SegmentedTopKPairs)
+{
+    using key_type = typename TestFixture::params::key_type;
+    using value_type = typename TestFixture::params::value_type;
+    using offset_type = unsigned int;
+    constexpr bool largest = TestFixture::params::largest;
+    constexpr int max_key = TestFixture::params::max_key;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const bool debug_synchronous = false;
+
+    std::random_device rd;
+    std::default_random_engine gen(rd());
+    std::uniform_int_distribution<size_t> segment_length_dis(0, 5000);
+
+    for(size_t size : get_sizes())
+    {
+        for(unsigned int k : { 1u, 10u, 300u })
+        {
+            for(bool sorted : { false, true })
+            {
+                SCOPED_TRACE(testing::Message() << "with size = " << size);
+                SCOPED_TRACE(testing::Message() << "with k = " << k);
+                SCOPED_TRACE(testing::Message() << "with sorted = " << sorted);
+
+                const std::vector<key_type> keys_input = get_keys<key_type>(size, max_key);
+                std::vector<value_type> values_input(size);
+                for(size_t i = 0; i < size; i++)
+                {
+                    values_input[i] = static_cast<value_type>(i);
+                }
+
+                std::vector<offset_type> offsets;
+                unsigned int segments_count = 0;
+                size_t offset = 0;
+                while(offset < size)
+                {
+                    const size_t segment_length = segment_length_dis(gen);
+                    offsets.push_back(offset);
+                    segments_count++;
+                    offset += segment_length;
+                }
+                offsets.push_back(size);
+
+                const size_t output_size = static_cast<size_t>(segments_count) * k;
+
+                hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+                hc::array<key_type> d_keys_output(output_size, acc_view);
+                hc::array<value_type> d_values_input(hc::extent<1>(size), values_input.begin(), acc_view);
+                hc::array<value_type> d_values_output(output_size, acc_view);
+                hc::array<offset_type> d_offsets(hc::extent<1>(segments_count + 1), offsets.begin(), acc_view);
+
+                size_t temporary_storage_bytes;
+                rp::segmented_topk_pairs(
+                    nullptr, temporary_storage_bytes,
+                    d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+                    d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+                    segments_count, d_offsets.accelerator_pointer(), d_offsets.accelerator_pointer() + 1,
+                    k, sorted
+                );
+
+                ASSERT_GT(temporary_storage_bytes, 0);
+
+                hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+                if(largest)
+                {
+                    rp::segmented_topk_pairs(
+                        d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+                        d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+                        d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+                        segments_count, d_offsets.accelerator_pointer(), d_offsets.accelerator_pointer() + 1,
+                        k, sorted,
+                        acc_view, debug_synchronous
+                    );
+                }
+                else
+                {
+                    rp::segmented_bottomk_pairs(
+                        d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+                        d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+                        d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+                        segments_count, d_offsets.accelerator_pointer(), d_offsets.accelerator_pointer() + 1,
+                        k, sorted,
+                        acc_view, debug_synchronous
+                    );
+                }
+                acc_view.wait();
+
+                std::vector<key_type> keys_output = d_keys_output;
+                std::vector<value_type> values_output = d_values_output;
+                for(unsigned int segment = 0; segment < segments_count; segment++)
+                {
+                    const std::vector<key_type> segment_keys(
+                        keys_input.begin() + offsets[segment],
+                        keys_input.begin() + offsets[segment + 1]
+                    );
+                    const std::vector<size_t> indices = get_expected_indices(segment_keys, k, largest, sorted);
+                    for(size_t i = 0; i < indices.size(); i++)
+                    {
+                        const size_t output_index = static_cast<size_t>(segment) * k + i;
+                        ASSERT_EQ(keys_output[output_index], segment_keys[indices[i]]);
+                        ASSERT_EQ(values_output[output_index], values_input[offsets[segment] + indices[i]]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceRadixSelect, NthElement)
+{
+    using key_type = typename TestFixture::params::key_type;
+    constexpr int max_key = TestFixture::params::max_key;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const bool debug_synchronous = false;
+
+    for(size_t size : get_sizes())
+    {
+        const std::vector<key_type> keys_input = get_keys<key_type>(size, max_key);
+
+        // Calculate expected results on host
+        std::vector<key_type> expected(keys_input);
+        std::sort(expected.begin(), expected.end());
+
+        hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+        hc::array<key_type> d_output(1, acc_view);
+
+        for(size_t n : { size_t(0), size / 3, size / 2, size - 1 })
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+            SCOPED_TRACE(testing::Message() << "with n = " << n);
+
+            size_t temporary_storage_bytes;
+            rp::nth_element(
+                nullptr, temporary_storage_bytes,
+                d_keys_input.accelerator_pointer(), d_output.accelerator_pointer(),
+                size, n
+            );
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+            rp::nth_element(
+                d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+                d_keys_input.accelerator_pointer(), d_output.accelerator_pointer(),
+                size, n,
+                acc_view, debug_synchronous
+            );
+            acc_view.wait();
+
+            std::vector<key_type> output = d_output;
+            ASSERT_EQ(output[0], expected[n]);
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceRadixSelect, Quantiles)
+{
+    using key_type = typename TestFixture::params::key_type;
+    constexpr int max_key = TestFixture::params::max_key;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const bool debug_synchronous = false;
+
+    const std::vector<double> probabilities = { 0.0, 0.25, 0.5, 0.9, 0.99, 0.999, 1.0 };
+    const unsigned int quantiles_count = probabilities.size();
+
+    for(size_t size : get_sizes())
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        const std::vector<key_type> keys_input = get_keys<key_type>(size, max_key);
+
+        // Calculate expected results on host
+        std::vector<key_type> sorted(keys_input);
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<key_type> expected(quantiles_count);
+        for(unsigned int i = 0; i < quantiles_count; i++)
+        {
+            const size_t rank = static_cast<size_t>(probabilities[i] * static_cast<double>(size - 1));
+            expected[i] = sorted[std::min(rank, size - 1)];
+        }
+
+        hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+        hc::array<key_type> d_output(quantiles_count, acc_view);
+
+        size_t temporary_storage_bytes;
+        rp::quantiles(
+            nullptr, temporary_storage_bytes,
+            d_keys_input.accelerator_pointer(), d_output.accelerator_pointer(),
+            size, probabilities.data(), quantiles_count
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+        rp::quantiles(
+            d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+            d_keys_input.accelerator_pointer(), d_output.accelerator_pointer(),
+            size, probabilities.data(), quantiles_count,
+            acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        std::vector<key_type> output = d_output;
+        for(unsigned int i = 0; i < quantiles_count; i++)
+        {
+            ASSERT_EQ(output[i], expected[i]);
+        }
+    }
+}
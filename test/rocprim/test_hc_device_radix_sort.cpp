@@ -119,6 +119,19 @@ struct key_value_comparator
     }
 };
 
+// Custom keys are sorted by y and then by x
+BEGIN_ROCPRIM_NAMESPACE
+template<>
+struct radix_key_decomposer<test_utils::custom_test_type<int>>
+{
+    ROCPRIM_HOST_DEVICE
+    rocprim::tuple<int&, int&> operator()(test_utils::custom_test_type<int>& key) const
+    {
+        return rocprim::tie(key.y, key.x);
+    }
+};
+END_ROCPRIM_NAMESPACE
+
 std::vector<size_t> get_sizes()
 {
     std::vector<size_t> sizes = { 1, 10, 53, 211, 1024, 2345, 4096, 34567, (1 << 16) - 1220, (1 << 23) - 76543 };
@@ -503,3 +516,291 @@ TYPED_TEST(RocprimDeviceRadixSort, SortPairsDoubleBuffer)
         }
     }
 }
+
+TEST(RocprimDeviceRadixSortDecomposed, SortPairsTuple)
+{
+    using key_type = rp::tuple<short, float>;
+    using value_type = unsigned int;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const bool debug_synchronous = false;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(size_t size : sizes)
+    {
+        if(size > (1 << 20)) continue;
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        const std::vector<short> first = test_utils::get_random_data<short>(size, -100, 100);
+        const std::vector<float> second = test_utils::get_random_data<float>(size, -1000, 1000);
+        std::vector<key_type> keys_input(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            keys_input[i] = key_type(first[i], second[i]);
+        }
+
+        std::vector<value_type> values_input(size);
+        std::iota(values_input.begin(), values_input.end(), 0);
+
+        hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+        hc::array<key_type> d_keys_output(size, acc_view);
+
+        hc::array<value_type> d_values_input(hc::extent<1>(size), values_input.begin(), acc_view);
+        hc::array<value_type> d_values_output(size, acc_view);
+
+        using key_value = std::pair<key_type, value_type>;
+
+        // Calculate expected results on host
+        std::vector<key_value> expected(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            expected[i] = key_value(keys_input[i], values_input[i]);
+        }
+        std::stable_sort(
+            expected.begin(), expected.end(),
+            [](const key_value& lhs, const key_value& rhs) { return lhs.first < rhs.first; }
+        );
+
+        size_t temporary_storage_bytes;
+        rp::radix_sort_pairs(
+            nullptr, temporary_storage_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+            d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+            size
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+        rp::radix_sort_pairs(
+            d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+            d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+            size,
+            0, 8 * sizeof(key_type),
+            acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        std::vector<key_type> keys_output = d_keys_output;
+        std::vector<value_type> values_output = d_values_output;
+
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(keys_output[i], expected[i].first);
+            ASSERT_EQ(values_output[i], expected[i].second);
+        }
+    }
+}
+
+TEST(RocprimDeviceRadixSortDecomposed, SortKeysCustomDescending)
+{
+    using key_type = test_utils::custom_test_type<int>;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const bool debug_synchronous = false;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(size_t size : sizes)
+    {
+        if(size > (1 << 20)) continue;
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        const std::vector<int> x = test_utils::get_random_data<int>(
+            size, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()
+        );
+        const std::vector<int> y = test_utils::get_random_data<int>(size, -10, 10);
+        std::vector<key_type> keys_input(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            keys_input[i] = key_type(x[i], y[i]);
+        }
+
+        hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+        hc::array<key_type> d_keys_output(size, acc_view);
+
+        // Calculate expected results on host
+        std::vector<key_type> expected(keys_input);
+        std::stable_sort(
+            expected.begin(), expected.end(),
+            [](const key_type& lhs, const key_type& rhs)
+            {
+                return rhs.y < lhs.y || (rhs.y == lhs.y && rhs.x < lhs.x);
+            }
+        );
+
+        size_t temporary_storage_bytes;
+        rp::radix_sort_keys_desc(
+            nullptr, temporary_storage_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+            size
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+        rp::radix_sort_keys_desc(
+            d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+            size,
+            0, 8 * sizeof(key_type),
+            acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        std::vector<key_type> keys_output = d_keys_output;
+
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(keys_output[i], expected[i]);
+        }
+    }
+}
+
+// A small chunk size forces sorting in many chunks, as for inputs of more than 4G keys
+using chunked_config = rp::radix_sort_config<4, rp::kernel_config<64, 2>, 1000>;
+
+TEST(RocprimDeviceRadixSortChunked, SortPairs)
+{
+    using key_type = unsigned int;
+    using value_type = unsigned int;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const bool debug_synchronous = false;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(size_t size : sizes)
+    {
+        if(size > (1 << 20)) continue;
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        const std::vector<key_type> keys_input = test_utils::get_random_data<key_type>(size, 0, 1000000);
+
+        std::vector<value_type> values_input(size);
+        std::iota(values_input.begin(), values_input.end(), 0);
+
+        hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
+        hc::array<key_type> d_keys_output(size, acc_view);
+
+        hc::array<value_type> d_values_input(hc::extent<1>(size), values_input.begin(), acc_view);
+        hc::array<value_type> d_values_output(size, acc_view);
+
+        using key_value = std::pair<key_type, value_type>;
+
+        // Calculate expected results on host
+        std::vector<key_value> expected(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            expected[i] = key_value(keys_input[i], values_input[i]);
+        }
+        std::stable_sort(
+            expected.begin(), expected.end(),
+            key_value_comparator<key_type, value_type, false, 0, sizeof(key_type) * 8>()
+        );
+
+        size_t temporary_storage_bytes;
+        rp::radix_sort_pairs<chunked_config>(
+            nullptr, temporary_storage_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+            d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+            size
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+        rp::radix_sort_pairs<chunked_config>(
+            d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+            d_keys_input.accelerator_pointer(), d_keys_output.accelerator_pointer(),
+            d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+            size,
+            0, 8 * sizeof(key_type),
+            acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        std::vector<key_type> keys_output = d_keys_output;
+        std::vector<value_type> values_output = d_values_output;
+
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(keys_output[i], expected[i].first);
+            ASSERT_EQ(values_output[i], expected[i].second);
+        }
+    }
+}
+
+TEST(RocprimDeviceRadixSortChunked, SortKeysDoubleBuffer)
+{
+    using key_type = int;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const bool debug_synchronous = false;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(size_t size : sizes)
+    {
+        if(size > (1 << 20)) continue;
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        const std::vector<key_type> keys_input = test_utils::get_random_data<key_type>(
+            size,
+            std::numeric_limits<key_type>::min(),
+            std::numeric_limits<key_type>::max()
+        );
+
+        hc::array<key_type> d_keys0(hc::extent<1>(size), keys_input.begin(), acc_view);
+        hc::array<key_type> d_keys1(size, acc_view);
+
+        // Calculate expected results on host
+        std::vector<key_type> expected(keys_input);
+        std::sort(expected.begin(), expected.end());
+
+        rp::double_buffer<key_type> d_keys(d_keys0.accelerator_pointer(), d_keys1.accelerator_pointer());
+
+        size_t temporary_storage_bytes;
+        rp::radix_sort_keys<chunked_config>(
+            nullptr, temporary_storage_bytes,
+            d_keys, size
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+        rp::radix_sort_keys<chunked_config>(
+            d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+            d_keys, size,
+            0, 8 * sizeof(key_type),
+            acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        hc::array<key_type> d_keys_output(hc::extent<1>(size), acc_view, d_keys.current());
+        std::vector<key_type> keys_output = d_keys_output;
+
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(keys_output[i], expected[i]);
+        }
+    }
+}
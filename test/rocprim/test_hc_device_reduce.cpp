@@ -40,12 +40,14 @@ namespace rp = rocprim;
 // Params for tests
 template<
     class InputType,
-    class OutputType = InputType
+    class OutputType = InputType,
+    class Config = rp::default_config
 >
 struct DeviceReduceParams
 {
     using input_type = InputType;
     using output_type = OutputType;
+    using config = Config;
 };
 
 // ---------------------------------------------------------
@@ -58,6 +60,7 @@ class RocprimDeviceReduceTests : public ::testing::Test
 public:
     using input_type = typename Params::input_type;
     using output_type = typename Params::output_type;
+    using config = typename Params::config;
     const bool debug_synchronous = false;
 };
 
@@ -66,7 +69,8 @@ typedef ::testing::Types<
     //
     // -----------------------------------------------------------------------
     DeviceReduceParams<int, long>,
-    DeviceReduceParams<unsigned char, float>
+    DeviceReduceParams<unsigned char, float>,
+    DeviceReduceParams<int, int, rp::kernel_config<64, 3>>
 > RocprimDeviceReduceTestsParams;
 
 std::vector<size_t> get_sizes()
@@ -88,6 +92,7 @@ TYPED_TEST(RocprimDeviceReduceTests, Reduce)
 {
     using T = typename TestFixture::input_type;
     using U = typename TestFixture::output_type;
+    using config = typename TestFixture::config;
     const bool debug_synchronous = TestFixture::debug_synchronous;
 
     hc::accelerator acc;
@@ -114,7 +119,7 @@ TYPED_TEST(RocprimDeviceReduceTests, Reduce)
         // temp storage
         size_t temp_storage_size_bytes;
         // Get size of d_temp_storage
-        rocprim::reduce(
+        rocprim::reduce<config>(
             nullptr,
             temp_storage_size_bytes,
             d_input.accelerator_pointer(),
@@ -134,7 +139,7 @@ TYPED_TEST(RocprimDeviceReduceTests, Reduce)
         acc_view.wait();
 
         // Run
-        rocprim::reduce(
+        rocprim::reduce<config>(
             d_temp_storage.accelerator_pointer(),
             temp_storage_size_bytes,
             d_input.accelerator_pointer(),
@@ -154,6 +159,98 @@ TYPED_TEST(RocprimDeviceReduceTests, Reduce)
     }
 }
 
+TYPED_TEST(RocprimDeviceReduceTests, ReduceHostFallback)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    // Reductions of at most 4096 items are performed on the host, larger ones on the device
+    using config = rp::host_fallback_config<4096>;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+
+        // Pinned host memory is accessible by both host and device
+        T * h_input = static_cast<T *>(hc::am_alloc(size * sizeof(T), acc, amHostPinned));
+        U * h_output = static_cast<U *>(hc::am_alloc(sizeof(U), acc, amHostPinned));
+        std::copy(input.begin(), input.end(), h_input);
+
+        // reduce function
+        ::rocprim::plus<U> plus_op;
+        // Calls of the reduce function made on the host are counted
+        unsigned int host_calls = 0;
+        test_utils::host_call_counter<::rocprim::plus<U>> counting_plus_op { plus_op, &host_calls };
+
+        // Calculate expected results on host
+        U initial_value = test_utils::get_random_value<U>(1, 100);
+        U expected = test_utils::host_reduce(input.begin(), input.end(), initial_value, plus_op);
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        rocprim::reduce<config>(
+            nullptr,
+            temp_storage_size_bytes,
+            h_input,
+            h_output,
+            initial_value,
+            input.size(),
+            counting_plus_op,
+            acc_view,
+            debug_synchronous
+        );
+        acc_view.wait();
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        hc::array<char> d_temp_storage(temp_storage_size_bytes, acc_view);
+        acc_view.wait();
+
+        // Run
+        rocprim::reduce<config>(
+            d_temp_storage.accelerator_pointer(),
+            temp_storage_size_bytes,
+            h_input,
+            h_output,
+            initial_value,
+            input.size(),
+            counting_plus_op,
+            acc_view,
+            debug_synchronous
+        );
+        acc_view.wait();
+
+        // Check if output values are as expected
+        auto diff = std::max<U>(std::abs(0.01f * expected), U(0.01f));
+        if(std::is_integral<U>::value) diff = 0;
+        ASSERT_NEAR(h_output[0], expected, diff);
+
+        // Only the host fallback calls the reduce function on the host
+        if(size <= config::max_size)
+        {
+            ASSERT_EQ(host_calls, size);
+        }
+        else
+        {
+            ASSERT_EQ(host_calls, 0U);
+        }
+
+        hc::am_free(h_input);
+        hc::am_free(h_output);
+    }
+}
+
 TYPED_TEST(RocprimDeviceReduceTests, ReduceMinimum)
 {
     using T = typename TestFixture::input_type;
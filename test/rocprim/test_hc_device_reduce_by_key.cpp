@@ -97,7 +97,7 @@ std::vector<size_t> get_sizes()
 {
     std::vector<size_t> sizes = {
         1024, 2048, 4096, 1792,
-        1, 10, 53, 211, 500,
+        0, 1, 10, 53, 211, 500,
         2345, 11001, 34567,
         100000,
         (1 << 16) - 1220, (1 << 23) - 76543
@@ -141,13 +141,13 @@ TYPED_TEST(RocprimDeviceReduceByKey, ReduceByKey)
         std::vector<value_type> aggregates_expected;
         size_t unique_count_expected = 0;
 
-        std::vector<key_type> keys_input(size);
+        std::vector<key_type> keys_input(std::max<size_t>(1, size));
         key_distribution_type key_delta_dis(1, 5);
         std::uniform_int_distribution<size_t> key_count_dis(
             TestFixture::params::min_segment_length,
             TestFixture::params::max_segment_length
         );
-        std::vector<value_type> values_input = test_utils::get_random_data<value_type>(size, 0, 100);
+        std::vector<value_type> values_input = test_utils::get_random_data<value_type>(std::max<size_t>(1, size), 0, 100);
 
         size_t offset = 0;
         key_type current_key = key_distribution_type(0, 100)(gen);
@@ -185,11 +185,11 @@ TYPED_TEST(RocprimDeviceReduceByKey, ReduceByKey)
             offset += key_count;
         }
 
-        hc::array<key_type> d_keys_input(hc::extent<1>(size), keys_input.begin(), acc_view);
-        hc::array<value_type> d_values_input(hc::extent<1>(size), values_input.begin(), acc_view);
+        hc::array<key_type> d_keys_input(hc::extent<1>(std::max<size_t>(1, size)), keys_input.begin(), acc_view);
+        hc::array<value_type> d_values_input(hc::extent<1>(std::max<size_t>(1, size)), values_input.begin(), acc_view);
 
-        hc::array<key_type> d_unique_output(unique_count_expected, acc_view);
-        hc::array<value_type> d_aggregates_output(unique_count_expected, acc_view);
+        hc::array<key_type> d_unique_output(std::max<size_t>(1, unique_count_expected), acc_view);
+        hc::array<value_type> d_aggregates_output(std::max<size_t>(1, unique_count_expected), acc_view);
         hc::array<unsigned int> d_unique_count_output(1, acc_view);
 
         size_t temporary_storage_bytes;
@@ -79,7 +79,7 @@ std::vector<size_t> get_sizes()
 {
     std::vector<size_t> sizes = {
         1024, 2048, 4096, 1792,
-        1, 10, 53, 211, 500,
+        0, 1, 10, 53, 211, 500,
         2345, 11001, 34567,
         100000,
         (1 << 16) - 1220, (1 << 21) - 76543
@@ -118,7 +118,7 @@ TYPED_TEST(RocprimDeviceRunLengthEncode, Encode)
         std::vector<count_type> counts_expected;
         size_t runs_count_expected = 0;
 
-        std::vector<key_type> input(size);
+        std::vector<key_type> input(std::max<size_t>(1, size));
         key_distribution_type key_delta_dis(1, 5);
         std::uniform_int_distribution<size_t> key_count_dis(
             TestFixture::params::min_segment_length,
@@ -147,10 +147,10 @@ TYPED_TEST(RocprimDeviceRunLengthEncode, Encode)
             offset += key_count;
         }
 
-        hc::array<key_type> d_input(hc::extent<1>(size), input.begin(), acc_view);
+        hc::array<key_type> d_input(hc::extent<1>(std::max<size_t>(1, size)), input.begin(), acc_view);
 
-        hc::array<key_type> d_unique_output(runs_count_expected, acc_view);
-        hc::array<count_type> d_counts_output(runs_count_expected, acc_view);
+        hc::array<key_type> d_unique_output(std::max<size_t>(1, runs_count_expected), acc_view);
+        hc::array<count_type> d_counts_output(std::max<size_t>(1, runs_count_expected), acc_view);
         hc::array<count_type> d_runs_count_output(1, acc_view);
 
         size_t temporary_storage_bytes = 0;
@@ -224,7 +224,7 @@ TYPED_TEST(RocprimDeviceRunLengthEncode, NonTrivialRuns)
         std::vector<count_type> counts_expected;
         size_t runs_count_expected = 0;
 
-        std::vector<key_type> input(size);
+        std::vector<key_type> input(std::max<size_t>(1, size));
         key_distribution_type key_delta_dis(1, 5);
         std::uniform_int_distribution<size_t> key_count_dis(
             TestFixture::params::min_segment_length,
@@ -266,7 +266,7 @@ TYPED_TEST(RocprimDeviceRunLengthEncode, NonTrivialRuns)
             offset += key_count;
         }
 
-        hc::array<key_type> d_input(hc::extent<1>(size), input.begin(), acc_view);
+        hc::array<key_type> d_input(hc::extent<1>(std::max<size_t>(1, size)), input.begin(), acc_view);
 
         hc::array<offset_type> d_offsets_output(std::max<size_t>(1, runs_count_expected), acc_view);
         hc::array<count_type> d_counts_output(std::max<size_t>(1, runs_count_expected), acc_view);
@@ -29,6 +29,7 @@
 
 // HC API
 #include <hcc/hc.hpp>
+#include <hcc/hc_am.hpp>
 // rocPRIM API
 #include <rocprim/rocprim.hpp>
 
@@ -70,7 +71,8 @@ std::vector<size_t> get_sizes()
     std::vector<size_t> sizes = {
         2, 32, 32, 32, 65, 378,
         1512, 3048, 4096,
-        27845, (1 << 18) + 1111
+        27845, (1 << 18) + 1111,
+        (1 << 20) + 2345
     };
     const std::vector<size_t> random_sizes = test_utils::get_random_data<size_t>(2, 1, 16384);
     sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
@@ -237,6 +239,105 @@ TYPED_TEST(RocprimDeviceScanTests, ExclusiveScanSum)
     }
 }
 
+TYPED_TEST(RocprimDeviceScanTests, ExclusiveScanHostFallback)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    // Scans of at most 4096 items are performed on the host, larger ones on the device
+    using config = rp::host_fallback_config<4096>;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+
+        // Pinned host memory is accessible by both host and device
+        T * h_input = static_cast<T *>(hc::am_alloc(size * sizeof(T), acc, amHostPinned));
+        U * h_output = static_cast<U *>(hc::am_alloc(size * sizeof(U), acc, amHostPinned));
+        std::copy(input.begin(), input.end(), h_input);
+
+        // scan function
+        ::rocprim::plus<T> plus_op;
+        // Calls of the scan function made on the host are counted
+        unsigned int host_calls = 0;
+        test_utils::host_call_counter<::rocprim::plus<T>> counting_plus_op { plus_op, &host_calls };
+
+        // Calculate expected results on host
+        std::vector<U> expected(input.size(), 0);
+        T initial_value = test_utils::get_random_value<T>(1, 100);
+        test_utils::host_exclusive_scan(
+            input.begin(), input.end(),
+            initial_value, expected.begin(), plus_op
+        );
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        rocprim::exclusive_scan<config>(
+            nullptr, temp_storage_size_bytes,
+            h_input,
+            h_output,
+            initial_value,
+            input.size(),
+            counting_plus_op,
+            acc_view,
+            debug_synchronous
+        );
+        acc_view.wait();
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        hc::array<char> d_temp_storage(temp_storage_size_bytes, acc_view);
+        acc_view.wait();
+
+        // Run
+        rocprim::exclusive_scan<config>(
+            d_temp_storage.accelerator_pointer(),
+            temp_storage_size_bytes,
+            h_input,
+            h_output,
+            initial_value,
+            input.size(),
+            counting_plus_op,
+            acc_view,
+            debug_synchronous
+        );
+        acc_view.wait();
+
+        // Check if output values are as expected
+        for(size_t i = 0; i < input.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            auto diff = std::max<U>(std::abs(0.01f * expected[i]), U(0.01f));
+            if(std::is_integral<U>::value) diff = 0;
+            ASSERT_NEAR(h_output[i], expected[i], diff);
+        }
+
+        // Only the host fallback calls the scan function on the host
+        if(size <= config::max_size)
+        {
+            ASSERT_EQ(host_calls, size);
+        }
+        else
+        {
+            ASSERT_EQ(host_calls, 0U);
+        }
+
+        hc::am_free(h_input);
+        hc::am_free(h_output);
+    }
+}
+
 TYPED_TEST(RocprimDeviceScanTests, InclusiveScanByKey)
 {
     using T = typename TestFixture::input_type;
@@ -43,7 +43,8 @@ template<
     class ScanOp = ::rocprim::plus<Input>,
     int Init = 0, // as only integral types supported, int is used here even for floating point inputs
     unsigned int MinSegmentLength = 0,
-    unsigned int MaxSegmentLength = 1000
+    unsigned int MaxSegmentLength = 1000,
+    class Config = ::rocprim::default_config
 >
 struct params
 {
@@ -53,6 +54,7 @@ struct params
     static constexpr input_type init = Init;
     static constexpr unsigned int min_segment_length = MinSegmentLength;
     static constexpr unsigned int max_segment_length = MaxSegmentLength;
+    using config = Config;
 };
 
 template<class Params>
@@ -67,7 +69,11 @@ typedef ::testing::Types<
     params<double, double, rocprim::minimum<double>, 1000, 0, 10000>,
     params<int, short, rocprim::maximum<int>, 10, 1000, 10000>,
     params<float, double, rocprim::maximum<double>, 50, 2, 10>,
-    params<float, float, rocprim::plus<float>, 123, 100, 200>
+    params<float, float, rocprim::plus<float>, 123, 100, 200>,
+    // Load-balanced mode
+    params<int, int, rocprim::plus<int>, -100, 0, 10000, rocprim::segmented_scan_config<256, 8>>,
+    params<float, double, rocprim::maximum<double>, 50, 0, 300, rocprim::segmented_scan_config<256, 4, 16, 64>>,
+    params<int, int, rocprim::plus<int>, 7, 100000, 1000000, rocprim::segmented_scan_config<128, 2>>
 > Params;
 
 TYPED_TEST_CASE(RocprimDeviceSegmentedScan, Params);
@@ -90,6 +96,7 @@ TYPED_TEST(RocprimDeviceSegmentedScan, InclusiveScan)
     using input_type = typename TestFixture::params::input_type;
     using output_type = typename TestFixture::params::output_type;
     using scan_op_type = typename TestFixture::params::scan_op_type;
+    using config = typename TestFixture::params::config;
 
     #ifdef __cpp_lib_is_invocable
     using result_type = typename std::invoke_result<scan_op_type, input_type, input_type>::type;
@@ -148,7 +155,7 @@ TYPED_TEST(RocprimDeviceSegmentedScan, InclusiveScan)
         hc::array<output_type> d_values_output(hc::extent<1>(size), acc_view);
 
         size_t temporary_storage_bytes;
-        rocprim::segmented_inclusive_scan(
+        rocprim::segmented_inclusive_scan<config>(
             nullptr, temporary_storage_bytes,
             d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
             segments_count,
@@ -160,7 +167,7 @@ TYPED_TEST(RocprimDeviceSegmentedScan, InclusiveScan)
         ASSERT_GT(temporary_storage_bytes, 0);
         hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
 
-        rocprim::segmented_inclusive_scan(
+        rocprim::segmented_inclusive_scan<config>(
             d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
             d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
             segments_count,
@@ -194,6 +201,7 @@ TYPED_TEST(RocprimDeviceSegmentedScan, ExclusiveScan)
     using input_type = typename TestFixture::params::input_type;
     using output_type = typename TestFixture::params::output_type;
     using scan_op_type = typename TestFixture::params::scan_op_type;
+    using config = typename TestFixture::params::config;
     constexpr input_type init = TestFixture::params::init;
 
     #ifdef __cpp_lib_is_invocable
@@ -253,7 +261,7 @@ TYPED_TEST(RocprimDeviceSegmentedScan, ExclusiveScan)
         hc::array<output_type> d_values_output(hc::extent<1>(size), acc_view);
 
         size_t temporary_storage_bytes;
-        rocprim::segmented_exclusive_scan(
+        rocprim::segmented_exclusive_scan<config>(
             nullptr, temporary_storage_bytes,
             d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
             segments_count,
@@ -265,7 +273,7 @@ TYPED_TEST(RocprimDeviceSegmentedScan, ExclusiveScan)
         ASSERT_GT(temporary_storage_bytes, 0);
         hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
 
-        rocprim::segmented_exclusive_scan(
+        rocprim::segmented_exclusive_scan<config>(
             d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
             d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
             segments_count,
@@ -539,3 +547,110 @@ TYPED_TEST(RocprimDeviceSegmentedScan, ExclusiveScanUsingHeadFlags)
         }
     }
 }
+
+// Composition of affine functions f(v) = x * v + y, it is associative but not commutative
+struct affine_compose
+{
+    using value_type = test_utils::custom_test_type<unsigned int>;
+
+    ROCPRIM_HOST_DEVICE inline
+    value_type operator()(const value_type& a, const value_type& b) const
+    {
+        return value_type(a.x * b.x, a.y * b.x + b.y);
+    }
+};
+
+TEST(RocprimDeviceSegmentedScanNonCommutative, InclusiveScan)
+{
+    using value_type = affine_compose::value_type;
+    // Small tiles, so parts of long segments are reduced by many blocks
+    using config = rocprim::segmented_scan_config<64, 2>;
+
+    using offset_type = unsigned int;
+    const bool debug_synchronous = false;
+    affine_compose scan_op;
+
+    std::random_device rd;
+    std::default_random_engine gen(rd());
+
+    std::uniform_int_distribution<size_t> segment_length_dis(0, 100000);
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(size_t size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data and calculate expected results
+        const std::vector<unsigned int> x = test_utils::get_random_data<unsigned int>(size, 0, 100);
+        const std::vector<unsigned int> y = test_utils::get_random_data<unsigned int>(size, 0, 100);
+        std::vector<value_type> values_input(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            values_input[i] = value_type(x[i], y[i]);
+        }
+
+        std::vector<value_type> values_expected(size);
+        std::vector<offset_type> offsets;
+        unsigned int segments_count = 0;
+        size_t offset = 0;
+        while(offset < size)
+        {
+            const size_t segment_length = segment_length_dis(gen);
+            offsets.push_back(offset);
+
+            const size_t end = std::min(size, offset + segment_length);
+            if(offset < end)
+            {
+                value_type aggregate = values_input[offset];
+                values_expected[offset] = aggregate;
+                for(size_t i = offset + 1; i < end; i++)
+                {
+                    aggregate = scan_op(aggregate, values_input[i]);
+                    values_expected[i] = aggregate;
+                }
+            }
+
+            segments_count++;
+            offset += segment_length;
+        }
+        offsets.push_back(size);
+
+        hc::array<value_type> d_values_input(hc::extent<1>(size), values_input.begin(), acc_view);
+        hc::array<offset_type> d_offsets(hc::extent<1>(segments_count + 1), offsets.begin(), acc_view);
+        hc::array<value_type> d_values_output(hc::extent<1>(size), acc_view);
+
+        size_t temporary_storage_bytes;
+        rocprim::segmented_inclusive_scan<config>(
+            nullptr, temporary_storage_bytes,
+            d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+            segments_count,
+            d_offsets.accelerator_pointer(), d_offsets.accelerator_pointer() + 1,
+            scan_op,
+            acc_view, debug_synchronous
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+        hc::array<char> d_temporary_storage(temporary_storage_bytes, acc_view);
+
+        rocprim::segmented_inclusive_scan<config>(
+            d_temporary_storage.accelerator_pointer(), temporary_storage_bytes,
+            d_values_input.accelerator_pointer(), d_values_output.accelerator_pointer(),
+            segments_count,
+            d_offsets.accelerator_pointer(), d_offsets.accelerator_pointer() + 1,
+            scan_op,
+            acc_view, debug_synchronous
+        );
+        acc_view.wait();
+
+        std::vector<value_type> values_output = d_values_output;
+        for(size_t i = 0; i < values_output.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "with index = " << i);
+            ASSERT_EQ(values_output[i].x, values_expected[i].x);
+            ASSERT_EQ(values_output[i].y, values_expected[i].y);
+        }
+    }
+}
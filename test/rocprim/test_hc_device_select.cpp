@@ -23,6 +23,7 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <iterator>
 
 // Google Test
 #include <gtest/gtest.h>
@@ -167,6 +168,111 @@ TYPED_TEST(RocprimDeviceSelectTests, Flagged)
     }
 }
 
+TYPED_TEST(RocprimDeviceSelectTests, SelectOpHostFallback)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    // Selections of at most 4096 items are performed on the host, larger ones on the device
+    using config = rocprim::host_fallback_config<4096>;
+
+    hc::accelerator acc;
+    hc::accelerator_view acc_view = acc.create_view();
+
+    auto select_op = [](const T& value) [[hc,cpu]] -> bool
+        {
+            if(value > 50) return true;
+            return false;
+        };
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+
+        // Pinned host memory is accessible by both host and device
+        T * h_input = static_cast<T *>(hc::am_alloc(size * sizeof(T), acc, amHostPinned));
+        U * h_output = static_cast<U *>(hc::am_alloc(size * sizeof(U), acc, amHostPinned));
+        unsigned int * h_selected_count_output =
+            static_cast<unsigned int *>(hc::am_alloc(sizeof(unsigned int), acc, amHostPinned));
+        std::copy(input.begin(), input.end(), h_input);
+
+        // Calls of the select predicate made on the host are counted
+        unsigned int host_calls = 0;
+        test_utils::host_call_counter<decltype(select_op)> counting_select_op { select_op, &host_calls };
+
+        // Calculate expected results on host
+        std::vector<U> expected;
+        expected.reserve(input.size());
+        std::copy_if(input.begin(), input.end(), std::back_inserter(expected), select_op);
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        rocprim::select<config>(
+            nullptr,
+            temp_storage_size_bytes,
+            h_input,
+            h_output,
+            h_selected_count_output,
+            input.size(),
+            counting_select_op,
+            acc_view,
+            debug_synchronous
+        );
+        acc_view.wait();
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        hc::array<char> d_temp_storage(temp_storage_size_bytes, acc_view);
+        acc_view.wait();
+
+        // Run
+        rocprim::select<config>(
+            d_temp_storage.accelerator_pointer(),
+            temp_storage_size_bytes,
+            h_input,
+            h_output,
+            h_selected_count_output,
+            input.size(),
+            counting_select_op,
+            acc_view,
+            debug_synchronous
+        );
+        acc_view.wait();
+
+        // Check if number of selected value is as expected
+        ASSERT_EQ(h_selected_count_output[0], expected.size());
+
+        // Check if output values are as expected
+        for(size_t i = 0; i < expected.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(h_output[i], expected[i]);
+        }
+
+        // Only the host fallback calls the select predicate on the host
+        if(size <= config::max_size)
+        {
+            ASSERT_EQ(host_calls, size);
+        }
+        else
+        {
+            ASSERT_EQ(host_calls, 0U);
+        }
+
+        hc::am_free(h_input);
+        hc::am_free(h_output);
+        hc::am_free(h_selected_count_output);
+    }
+}
+
 TYPED_TEST(RocprimDeviceSelectTests, SelectOp)
 {
     using T = typename TestFixture::input_type;
@@ -20,9 +20,11 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <limits>
 #include <tuple>
 
 // Google Test
@@ -454,3 +456,111 @@ TEST(RocprimIntrinsicsTests, WarpId)
         EXPECT_EQ(output[i], expected[i]);
     }
 }
+
+template<class T>
+class RocprimAtomicTests : public ::testing::Test
+{
+public:
+    using type = T;
+};
+
+typedef ::testing::Types<
+    int,
+    unsigned int,
+    long long,
+    unsigned long long,
+    float,
+    double
+> AtomicTestTypes;
+
+TYPED_TEST_CASE(RocprimAtomicTests, AtomicTestTypes);
+
+TYPED_TEST(RocprimAtomicTests, AddMinMax)
+{
+    using T = typename TestFixture::type;
+    const size_t block_size = 256;
+    const size_t size = block_size * 64;
+
+    // Integral values, so sums of floating point values are exact
+    std::vector<T> input = test_utils::get_random_data<T>(size, T(0), T(100));
+    for(auto& value : input)
+    {
+        value = static_cast<T>(static_cast<int>(value));
+    }
+    std::vector<T> output = {
+        T(0), std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(),
+        T(0), std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()
+    };
+
+    // Calculate expected results on host
+    T sum = 0;
+    for(auto value : input)
+    {
+        sum += value;
+    }
+    const T min = *std::min_element(input.begin(), input.end());
+    const T max = *std::max_element(input.begin(), input.end());
+    const std::vector<T> expected = { sum, min, max, sum, min, max };
+
+    hc::array_view<T, 1> d_input(input.size(), input.data());
+    hc::array_view<T, 1> d_output(output.size(), output.data());
+    hc::parallel_for_each(
+        hc::extent<1>(size).tile(block_size),
+        [=](hc::tiled_index<1> i) [[hc]]
+        {
+            const T value = d_input[i];
+            rp::atomic_add(&d_output[0], value);
+            rp::atomic_min(&d_output[1], value);
+            rp::atomic_max(&d_output[2], value);
+            rp::atomic_add_system(&d_output[3], value);
+            rp::atomic_min_system(&d_output[4], value);
+            rp::atomic_max_system(&d_output[5], value);
+        }
+    );
+
+    d_output.synchronize();
+    for(size_t i = 0; i < output.size(); i++)
+    {
+        SCOPED_TRACE(testing::Message() << "where index = " << i);
+        ASSERT_EQ(output[i], expected[i]);
+    }
+}
+
+TEST(RocprimAtomicTests, BitwiseExchCas)
+{
+    const size_t block_size = 256;
+    // Each bit is xor-ed an even number of times
+    const size_t size = 64 * 64;
+
+    std::vector<unsigned long long> output = { 0, ~0ULL, 0, size, 0 };
+
+    hc::array_view<unsigned long long, 1> d_output(output.size(), output.data());
+    hc::parallel_for_each(
+        hc::extent<1>(size).tile(block_size),
+        [=](hc::tiled_index<1> i) [[hc]]
+        {
+            const unsigned int index = i.global[0];
+            const unsigned long long bit = 1ULL << (index % 64);
+            rp::atomic_or(&d_output[0], bit);
+            rp::atomic_and(&d_output[1], ~bit);
+            rp::atomic_xor_system(&d_output[2], bit);
+            rp::atomic_exch(&d_output[3], static_cast<unsigned long long>(index));
+
+            // Increment using compare-and-swap loop
+            unsigned long long old_value = d_output[4];
+            unsigned long long assumed;
+            do
+            {
+                assumed = old_value;
+                old_value = rp::atomic_cas(&d_output[4], assumed, assumed + 1);
+            } while(old_value != assumed);
+        }
+    );
+
+    d_output.synchronize();
+    ASSERT_EQ(output[0], ~0ULL);
+    ASSERT_EQ(output[1], 0ULL);
+    ASSERT_EQ(output[2], 0ULL);
+    ASSERT_LT(output[3], size);
+    ASSERT_EQ(output[4], size);
+}
@@ -79,7 +79,12 @@ typedef ::testing::Types<
     params<float, 7U>,
     params<float, 15U>,
     params<float, 37U>,
-    params<float, 61U>
+    params<float, 61U>,
+
+    // 64-bit types
+    params<double, 16U>,
+    params<double, 64U>,
+    params<long long, 32U>
 
 > WarpScanTestParams;
 
@@ -159,3 +159,151 @@ TYPED_TEST(RocprimWarpSortShuffleBasedTests, SortKeyInt)
         EXPECT_EQ(d_output_value[i], expected[i].second);
     }
 }
+
+template<unsigned int WarpSize, unsigned int ItemsPerThread>
+struct items_params
+{
+    static constexpr unsigned int warp_size = WarpSize;
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+};
+
+template<typename Params>
+class RocprimWarpSortItemsTests : public ::testing::Test {
+public:
+    static constexpr unsigned int warp_size = Params::warp_size;
+    static constexpr unsigned int items_per_thread = Params::items_per_thread;
+};
+
+typedef ::testing::Types<
+    items_params<2U, 2U>,
+    items_params<4U, 16U>,
+    items_params<8U, 4U>,
+    items_params<16U, 8U>,
+    items_params<32U, 2U>,
+    items_params<64U, 1U>,
+    items_params<64U, 4U>,
+    items_params<64U, 16U>
+> WarpSizesItems;
+
+TYPED_TEST_CASE(RocprimWarpSortItemsTests, WarpSizesItems);
+
+TYPED_TEST(RocprimWarpSortItemsTests, SortInt)
+{
+    constexpr size_t logical_warp_size = TestFixture::warp_size;
+    constexpr size_t items_per_thread = TestFixture::items_per_thread;
+    constexpr size_t items_per_warp = logical_warp_size * items_per_thread;
+    const size_t block_size = std::max<size_t>(rp::warp_size(), 4 * logical_warp_size);
+    const size_t size = block_size * 4;
+
+    // Given warp size not supported
+    if(logical_warp_size > rp::warp_size())
+    {
+        return;
+    }
+
+    // Generate data
+    std::vector<int> output = test_utils::get_random_data<int>(size * items_per_thread, -100, 100);
+
+    // Calculate expected results on host
+    std::vector<int> expected(output);
+    for(size_t i = 0; i < output.size() / items_per_warp; i++)
+    {
+        std::sort(expected.begin() + (i * items_per_warp), expected.begin() + ((i + 1) * items_per_warp));
+    }
+
+    hc::array_view<int, 1> d_output(output.size(), output.data());
+    hc::parallel_for_each(
+        hc::extent<1>(size).tile(block_size),
+        [=](hc::tiled_index<1> i) [[hc]]
+        {
+            const unsigned int offset = i.global[0] * items_per_thread;
+            int keys[items_per_thread];
+            for(unsigned int j = 0; j < items_per_thread; j++)
+            {
+                keys[j] = d_output[offset + j];
+            }
+            rp::warp_sort<int, logical_warp_size, rp::empty_type, items_per_thread> wsort;
+            wsort.sort(keys);
+            for(unsigned int j = 0; j < items_per_thread; j++)
+            {
+                d_output[offset + j] = keys[j];
+            }
+        }
+    );
+
+    d_output.synchronize();
+    for(size_t i = 0; i < output.size(); i++)
+    {
+        EXPECT_EQ(output[i], expected[i]);
+    }
+}
+
+TYPED_TEST(RocprimWarpSortItemsTests, SortKeyIntDescending)
+{
+    constexpr size_t logical_warp_size = TestFixture::warp_size;
+    constexpr size_t items_per_thread = TestFixture::items_per_thread;
+    constexpr size_t items_per_warp = logical_warp_size * items_per_thread;
+    const size_t block_size = std::max<size_t>(rp::warp_size(), 4 * logical_warp_size);
+    const size_t size = block_size * 4;
+
+    // Given warp size not supported
+    if(logical_warp_size > rp::warp_size())
+    {
+        return;
+    }
+
+    // Generate data, keys are unique so the order of values is defined
+    std::vector<int> output_key(size * items_per_thread);
+    std::iota(output_key.begin(), output_key.end(), 0);
+    std::shuffle(output_key.begin(), output_key.end(), std::mt19937{std::random_device{}()});
+    std::vector<int> output_value = test_utils::get_random_data<int>(output_key.size(), -100, 100);
+
+    // Combine vectors to form pairs with key and value
+    std::vector<std::pair<int, int>> expected(output_key.size());
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+        expected[i] = std::make_pair(output_key[i], output_value[i]);
+    }
+
+    // Calculate expected results on host
+    for(size_t i = 0; i < expected.size() / items_per_warp; i++)
+    {
+        std::sort(
+            expected.begin() + (i * items_per_warp), expected.begin() + ((i + 1) * items_per_warp),
+            [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; }
+        );
+    }
+
+    hc::array_view<int, 1> d_output_key(output_key.size(), output_key.data());
+    hc::array_view<int, 1> d_output_value(output_value.size(), output_value.data());
+    hc::parallel_for_each(
+        hc::extent<1>(size).tile(block_size),
+        [=](hc::tiled_index<1> i) [[hc]]
+        {
+            const unsigned int offset = i.global[0] * items_per_thread;
+            int keys[items_per_thread];
+            int values[items_per_thread];
+            for(unsigned int j = 0; j < items_per_thread; j++)
+            {
+                keys[j] = d_output_key[offset + j];
+                values[j] = d_output_value[offset + j];
+            }
+            using warp_sort_type = rp::warp_sort<int, logical_warp_size, int, items_per_thread>;
+            tile_static typename warp_sort_type::storage_type storage;
+            warp_sort_type().sort(keys, values, storage, rp::greater<int>());
+            for(unsigned int j = 0; j < items_per_thread; j++)
+            {
+                d_output_key[offset + j] = keys[j];
+                d_output_value[offset + j] = values[j];
+            }
+        }
+    );
+
+    d_output_key.synchronize();
+    d_output_value.synchronize();
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(d_output_key[i], expected[i].first);
+        EXPECT_EQ(d_output_value[i], expected[i].second);
+    }
+}
@@ -135,6 +135,7 @@ typedef ::testing::Types<
     params1<int, 10, 0, 10>,
     params1<int, 128, 0, 256>,
     params1<unsigned int, 12345, 10, 12355, short>,
+    params1<unsigned short, 4096, 0, 8192, int>,
     params1<unsigned short, 65536, 0, 65536, int>,
     params1<unsigned char, 10, 20, 240, unsigned char, unsigned int>,
     params1<unsigned char, 256, 0, 256, short>,
@@ -297,6 +298,9 @@ TYPED_TEST(RocprimDeviceHistogramEven, Even)
     }
 }
 
+#ifndef ROCPRIM_CPU_API
+// The CPU backend provides histogram_even only
+
 template<
     class SampleType,
     unsigned int Bins,
@@ -1024,3 +1028,5 @@ TYPED_TEST(RocprimDeviceHistogramMultiRange, MultiRange)
         }
     }
 }
+
+#endif // ROCPRIM_CPU_API
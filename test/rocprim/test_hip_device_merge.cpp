@@ -0,0 +1,378 @@
+// MIT License
+//
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// HIP API
+#include <hip/hip_runtime.h>
+// rocPRIM API
+#include <rocprim/rocprim.hpp>
+
+#include "test_utils.hpp"
+
+
+#define HIP_CHECK(error) ASSERT_EQ(static_cast<hipError_t>(error),hipSuccess)
+
+// Compares only x, so keys with equal x and different y are equivalent
+struct custom_test_type_less
+{
+    template<class T>
+    ROCPRIM_HOST_DEVICE
+    bool operator()(const test_utils::custom_test_type<T>& a,
+                    const test_utils::custom_test_type<T>& b) const
+    {
+        return a.x < b.x;
+    }
+};
+
+// Params for tests
+template<
+    class KeyType,
+    class ValueType,
+    class CompareFunction = rocprim::less<KeyType>
+>
+struct DeviceMergeParams
+{
+    using key_type = KeyType;
+    using value_type = ValueType;
+    using compare_function = CompareFunction;
+};
+
+template<class Params>
+class RocprimDeviceMergeTests : public ::testing::Test
+{
+public:
+    using key_type = typename Params::key_type;
+    using value_type = typename Params::value_type;
+    using compare_function = typename Params::compare_function;
+    const bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<
+    DeviceMergeParams<int, int>,
+    DeviceMergeParams<unsigned char, float, rocprim::greater<unsigned char>>,
+    DeviceMergeParams<double, unsigned int>,
+    DeviceMergeParams<test_utils::custom_test_type<int>, long, custom_test_type_less>
+> RocprimDeviceMergeTestsParams;
+
+std::vector<std::pair<size_t, size_t>> get_sizes()
+{
+    std::vector<std::pair<size_t, size_t>> sizes = {
+        { 0, 1 }, { 1, 0 }, { 1, 1 },
+        { 10, 3000 }, { 2048, 2048 }, { 3000, 10 },
+        { 1234, 56789 }, { 100000, (1 << 17) + 1 },
+        { (1 << 20) + 123, 77 }
+    };
+    const std::vector<size_t> random_sizes = test_utils::get_random_data<size_t>(4, 1, 100000);
+    sizes.push_back({ random_sizes[0], random_sizes[1] });
+    sizes.push_back({ random_sizes[2], random_sizes[3] });
+    return sizes;
+}
+
+// Sorted keys with many duplicates, so the order of equivalent keys is checked
+template<class Key, class CompareFunction>
+std::vector<Key> get_sorted_keys(size_t size, CompareFunction compare_function)
+{
+    const std::vector<int> random_keys = test_utils::get_random_data<int>(size, 0, 100);
+    std::vector<Key> keys(size);
+    for(size_t i = 0; i < size; i++)
+    {
+        keys[i] = Key(random_keys[i]);
+    }
+    std::stable_sort(keys.begin(), keys.end(), compare_function);
+    return keys;
+}
+
+TYPED_TEST_CASE(RocprimDeviceMergeTests, RocprimDeviceMergeTestsParams);
+
+TYPED_TEST(RocprimDeviceMergeTests, MergeKeys)
+{
+    using key_type = typename TestFixture::key_type;
+    using compare_function = typename TestFixture::compare_function;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hipStream_t stream = 0; // default stream
+
+    for(auto sizes : get_sizes())
+    {
+        const size_t size1 = sizes.first;
+        const size_t size2 = sizes.second;
+        const size_t size = size1 + size2;
+        SCOPED_TRACE(testing::Message() << "with sizes = {" << size1 << ", " << size2 << "}");
+
+        // Generate data
+        std::vector<key_type> keys_input1 = get_sorted_keys<key_type>(size1, compare_function());
+        std::vector<key_type> keys_input2 = get_sorted_keys<key_type>(size2, compare_function());
+
+        key_type * d_keys_input1;
+        key_type * d_keys_input2;
+        key_type * d_keys_output;
+        HIP_CHECK(hipMalloc(&d_keys_input1, size1 * sizeof(key_type)));
+        HIP_CHECK(hipMalloc(&d_keys_input2, size2 * sizeof(key_type)));
+        HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(key_type)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys_input1, keys_input1.data(),
+                size1 * sizeof(key_type),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys_input2, keys_input2.data(),
+                size2 * sizeof(key_type),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Calculate expected results on host
+        std::vector<key_type> expected(size);
+        std::merge(
+            keys_input1.begin(), keys_input1.end(),
+            keys_input2.begin(), keys_input2.end(),
+            expected.begin(), compare_function()
+        );
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            rocprim::merge(
+                nullptr, temp_storage_size_bytes,
+                d_keys_input1, d_keys_input2, d_keys_output,
+                size1, size2,
+                compare_function(), stream, debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        void * d_temp_storage = nullptr;
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            rocprim::merge(
+                d_temp_storage, temp_storage_size_bytes,
+                d_keys_input1, d_keys_input2, d_keys_output,
+                size1, size2,
+                compare_function(), stream, debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if output values are as expected
+        std::vector<key_type> keys_output(size);
+        HIP_CHECK(
+            hipMemcpy(
+                keys_output.data(), d_keys_output,
+                size * sizeof(key_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        for(size_t i = 0; i < size; i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(keys_output[i], expected[i]);
+        }
+
+        hipFree(d_keys_input1);
+        hipFree(d_keys_input2);
+        hipFree(d_keys_output);
+        hipFree(d_temp_storage);
+    }
+}
+
+TYPED_TEST(RocprimDeviceMergeTests, MergePairs)
+{
+    using key_type = typename TestFixture::key_type;
+    using value_type = typename TestFixture::value_type;
+    using compare_function = typename TestFixture::compare_function;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hipStream_t stream = 0; // default stream
+
+    for(auto sizes : get_sizes())
+    {
+        const size_t size1 = sizes.first;
+        const size_t size2 = sizes.second;
+        const size_t size = size1 + size2;
+        SCOPED_TRACE(testing::Message() << "with sizes = {" << size1 << ", " << size2 << "}");
+
+        // Generate data, values are positions of keys in the concatenated input
+        std::vector<key_type> keys_input1 = get_sorted_keys<key_type>(size1, compare_function());
+        std::vector<key_type> keys_input2 = get_sorted_keys<key_type>(size2, compare_function());
+        std::vector<value_type> values_input1(size1);
+        std::vector<value_type> values_input2(size2);
+        for(size_t i = 0; i < size1; i++)
+        {
+            values_input1[i] = static_cast<value_type>(i);
+        }
+        for(size_t i = 0; i < size2; i++)
+        {
+            values_input2[i] = static_cast<value_type>(size1 + i);
+        }
+
+        key_type * d_keys_input1;
+        key_type * d_keys_input2;
+        key_type * d_keys_output;
+        value_type * d_values_input1;
+        value_type * d_values_input2;
+        value_type * d_values_output;
+        HIP_CHECK(hipMalloc(&d_keys_input1, size1 * sizeof(key_type)));
+        HIP_CHECK(hipMalloc(&d_keys_input2, size2 * sizeof(key_type)));
+        HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(key_type)));
+        HIP_CHECK(hipMalloc(&d_values_input1, size1 * sizeof(value_type)));
+        HIP_CHECK(hipMalloc(&d_values_input2, size2 * sizeof(value_type)));
+        HIP_CHECK(hipMalloc(&d_values_output, size * sizeof(value_type)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys_input1, keys_input1.data(),
+                size1 * sizeof(key_type),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys_input2, keys_input2.data(),
+                size2 * sizeof(key_type),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                d_values_input1, values_input1.data(),
+                size1 * sizeof(value_type),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                d_values_input2, values_input2.data(),
+                size2 * sizeof(value_type),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Calculate expected results on host, the merge must be stable
+        using key_value = std::pair<key_type, value_type>;
+        std::vector<key_value> input1(size1);
+        std::vector<key_value> input2(size2);
+        for(size_t i = 0; i < size1; i++)
+        {
+            input1[i] = key_value(keys_input1[i], values_input1[i]);
+        }
+        for(size_t i = 0; i < size2; i++)
+        {
+            input2[i] = key_value(keys_input2[i], values_input2[i]);
+        }
+        std::vector<key_value> expected(size);
+        std::merge(
+            input1.begin(), input1.end(),
+            input2.begin(), input2.end(),
+            expected.begin(),
+            [](const key_value& a, const key_value& b)
+            {
+                return compare_function()(a.first, b.first);
+            }
+        );
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            rocprim::merge(
+                nullptr, temp_storage_size_bytes,
+                d_keys_input1, d_keys_input2, d_keys_output,
+                d_values_input1, d_values_input2, d_values_output,
+                size1, size2,
+                compare_function(), stream, debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        void * d_temp_storage = nullptr;
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            rocprim::merge(
+                d_temp_storage, temp_storage_size_bytes,
+                d_keys_input1, d_keys_input2, d_keys_output,
+                d_values_input1, d_values_input2, d_values_output,
+                size1, size2,
+                compare_function(), stream, debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if output values are as expected
+        std::vector<key_type> keys_output(size);
+        std::vector<value_type> values_output(size);
+        HIP_CHECK(
+            hipMemcpy(
+                keys_output.data(), d_keys_output,
+                size * sizeof(key_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                values_output.data(), d_values_output,
+                size * sizeof(value_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        for(size_t i = 0; i < size; i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(keys_output[i], expected[i].first);
+            ASSERT_EQ(values_output[i], expected[i].second);
+        }
+
+        hipFree(d_keys_input1);
+        hipFree(d_keys_input2);
+        hipFree(d_keys_output);
+        hipFree(d_values_input1);
+        hipFree(d_values_input2);
+        hipFree(d_values_output);
+        hipFree(d_temp_storage);
+    }
+}
@@ -0,0 +1,527 @@
+// MIT License
+//
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+// Google Test
+#include <gtest/gtest.h>
+
+// HIP API
+#include <hip/hip_runtime.h>
+// rocPRIM API
+#include <rocprim/rocprim.hpp>
+
+#include "test_utils.hpp"
+
+#define HIP_CHECK(error) ASSERT_EQ(static_cast<hipError_t>(error),hipSuccess)
+
+// Params for tests
+template<
+    class InputType,
+    class OutputType = InputType,
+    class FlagType = unsigned int
+>
+struct DevicePartitionParams
+{
+    using input_type = InputType;
+    using output_type = OutputType;
+    using flag_type = FlagType;
+};
+
+template<class Params>
+class RocprimDevicePartitionTests : public ::testing::Test
+{
+public:
+    using input_type = typename Params::input_type;
+    using output_type = typename Params::output_type;
+    using flag_type = typename Params::flag_type;
+    const bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<
+    DevicePartitionParams<int, long>,
+    DevicePartitionParams<unsigned char, float>,
+    DevicePartitionParams<double, double, unsigned char>
+> RocprimDevicePartitionTestsParams;
+
+std::vector<size_t> get_sizes()
+{
+    std::vector<size_t> sizes = {
+        2, 32, 64, 256,
+        1024, 2048,
+        3072, 4096,
+        27845, (1 << 18) + 1111
+    };
+    const std::vector<size_t> random_sizes = test_utils::get_random_data<size_t>(2, 1, 16384);
+    sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
+    std::sort(sizes.begin(), sizes.end());
+    return sizes;
+}
+
+TYPED_TEST_CASE(RocprimDevicePartitionTests, RocprimDevicePartitionTestsParams);
+
+TYPED_TEST(RocprimDevicePartitionTests, Flagged)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    using F = typename TestFixture::flag_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hipStream_t stream = 0; // default stream
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+        std::vector<F> flags = test_utils::get_random_data<F>(size, 0, 1);
+
+        T * d_input;
+        F * d_flags;
+        U * d_output;
+        unsigned int * d_selected_count_output;
+        HIP_CHECK(hipMalloc(&d_input, input.size() * sizeof(T)));
+        HIP_CHECK(hipMalloc(&d_flags, flags.size() * sizeof(F)));
+        HIP_CHECK(hipMalloc(&d_output, input.size() * sizeof(U)));
+        HIP_CHECK(hipMalloc(&d_selected_count_output, sizeof(unsigned int)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_input, input.data(),
+                input.size() * sizeof(T),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                d_flags, flags.data(),
+                flags.size() * sizeof(F),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Calculate expected results on host: selected values in order,
+        // then rejected values in reverse order
+        std::vector<U> expected_selected;
+        std::vector<U> expected_rejected;
+        for(size_t i = 0; i < input.size(); i++)
+        {
+            if(flags[i] != 0)
+            {
+                expected_selected.push_back(input[i]);
+            }
+            else
+            {
+                expected_rejected.push_back(input[i]);
+            }
+        }
+        std::vector<U> expected = expected_selected;
+        expected.insert(expected.end(), expected_rejected.rbegin(), expected_rejected.rend());
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            rocprim::partition(
+                nullptr,
+                temp_storage_size_bytes,
+                d_input,
+                d_flags,
+                d_output,
+                d_selected_count_output,
+                input.size(),
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        void * d_temp_storage = nullptr;
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            rocprim::partition(
+                d_temp_storage,
+                temp_storage_size_bytes,
+                d_input,
+                d_flags,
+                d_output,
+                d_selected_count_output,
+                input.size(),
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if number of selected value is as expected
+        unsigned int selected_count_output = 0;
+        HIP_CHECK(
+            hipMemcpy(
+                &selected_count_output, d_selected_count_output,
+                sizeof(unsigned int),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        ASSERT_EQ(selected_count_output, expected_selected.size());
+
+        // Check if output values are as expected
+        std::vector<U> output(input.size());
+        HIP_CHECK(
+            hipMemcpy(
+                output.data(), d_output,
+                output.size() * sizeof(U),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        for(size_t i = 0; i < expected.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(output[i], expected[i]);
+        }
+
+        hipFree(d_input);
+        hipFree(d_flags);
+        hipFree(d_output);
+        hipFree(d_selected_count_output);
+        hipFree(d_temp_storage);
+    }
+}
+
+TYPED_TEST(RocprimDevicePartitionTests, PredicateOp)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hipStream_t stream = 0; // default stream
+
+    auto select_op = [] __host__ __device__ (const T& value) -> bool
+        {
+            if(value == T(50)) return true;
+            return false;
+        };
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+
+        T * d_input;
+        U * d_output;
+        unsigned int * d_selected_count_output;
+        HIP_CHECK(hipMalloc(&d_input, input.size() * sizeof(T)));
+        HIP_CHECK(hipMalloc(&d_output, input.size() * sizeof(U)));
+        HIP_CHECK(hipMalloc(&d_selected_count_output, sizeof(unsigned int)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_input, input.data(),
+                input.size() * sizeof(T),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Calculate expected results on host
+        std::vector<U> expected_selected;
+        std::vector<U> expected_rejected;
+        for(size_t i = 0; i < input.size(); i++)
+        {
+            if(select_op(input[i]))
+            {
+                expected_selected.push_back(input[i]);
+            }
+            else
+            {
+                expected_rejected.push_back(input[i]);
+            }
+        }
+        std::vector<U> expected = expected_selected;
+        expected.insert(expected.end(), expected_rejected.rbegin(), expected_rejected.rend());
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            rocprim::partition(
+                nullptr,
+                temp_storage_size_bytes,
+                d_input,
+                d_output,
+                d_selected_count_output,
+                input.size(),
+                select_op,
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        void * d_temp_storage = nullptr;
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            rocprim::partition(
+                d_temp_storage,
+                temp_storage_size_bytes,
+                d_input,
+                d_output,
+                d_selected_count_output,
+                input.size(),
+                select_op,
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if number of selected value is as expected
+        unsigned int selected_count_output = 0;
+        HIP_CHECK(
+            hipMemcpy(
+                &selected_count_output, d_selected_count_output,
+                sizeof(unsigned int),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        ASSERT_EQ(selected_count_output, expected_selected.size());
+
+        // Check if output values are as expected
+        std::vector<U> output(input.size());
+        HIP_CHECK(
+            hipMemcpy(
+                output.data(), d_output,
+                output.size() * sizeof(U),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        for(size_t i = 0; i < expected.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(output[i], expected[i]);
+        }
+
+        hipFree(d_input);
+        hipFree(d_output);
+        hipFree(d_selected_count_output);
+        hipFree(d_temp_storage);
+    }
+}
+
+TYPED_TEST(RocprimDevicePartitionTests, ThreeWay)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    hipStream_t stream = 0; // default stream
+
+    auto select_first_part_op = [] __host__ __device__ (const T& value) -> bool
+        {
+            return value < T(30);
+        };
+    auto select_second_part_op = [] __host__ __device__ (const T& value) -> bool
+        {
+            return value < T(70);
+        };
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+
+        T * d_input;
+        U * d_output_first;
+        U * d_output_second;
+        U * d_output_unselected;
+        unsigned int * d_selected_count_output;
+        HIP_CHECK(hipMalloc(&d_input, input.size() * sizeof(T)));
+        HIP_CHECK(hipMalloc(&d_output_first, input.size() * sizeof(U)));
+        HIP_CHECK(hipMalloc(&d_output_second, input.size() * sizeof(U)));
+        HIP_CHECK(hipMalloc(&d_output_unselected, input.size() * sizeof(U)));
+        HIP_CHECK(hipMalloc(&d_selected_count_output, 2 * sizeof(unsigned int)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_input, input.data(),
+                input.size() * sizeof(T),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Calculate expected results on host
+        std::vector<U> expected_first;
+        std::vector<U> expected_second;
+        std::vector<U> expected_unselected;
+        for(size_t i = 0; i < input.size(); i++)
+        {
+            if(select_first_part_op(input[i]))
+            {
+                expected_first.push_back(input[i]);
+            }
+            else if(select_second_part_op(input[i]))
+            {
+                expected_second.push_back(input[i]);
+            }
+            else
+            {
+                expected_unselected.push_back(input[i]);
+            }
+        }
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            rocprim::partition_three_way(
+                nullptr,
+                temp_storage_size_bytes,
+                d_input,
+                d_output_first,
+                d_output_second,
+                d_output_unselected,
+                d_selected_count_output,
+                input.size(),
+                select_first_part_op,
+                select_second_part_op,
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        void * d_temp_storage = nullptr;
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            rocprim::partition_three_way(
+                d_temp_storage,
+                temp_storage_size_bytes,
+                d_input,
+                d_output_first,
+                d_output_second,
+                d_output_unselected,
+                d_selected_count_output,
+                input.size(),
+                select_first_part_op,
+                select_second_part_op,
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if sizes of parts are as expected
+        unsigned int selected_count_output[2] = { 0, 0 };
+        HIP_CHECK(
+            hipMemcpy(
+                selected_count_output, d_selected_count_output,
+                2 * sizeof(unsigned int),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        ASSERT_EQ(selected_count_output[0], expected_first.size());
+        ASSERT_EQ(selected_count_output[1], expected_second.size());
+
+        // Check if output values are as expected
+        std::vector<U> output_first(input.size());
+        std::vector<U> output_second(input.size());
+        std::vector<U> output_unselected(input.size());
+        HIP_CHECK(
+            hipMemcpy(
+                output_first.data(), d_output_first,
+                output_first.size() * sizeof(U),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                output_second.data(), d_output_second,
+                output_second.size() * sizeof(U),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                output_unselected.data(), d_output_unselected,
+                output_unselected.size() * sizeof(U),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+        for(size_t i = 0; i < expected_first.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(output_first[i], expected_first[i]);
+        }
+        for(size_t i = 0; i < expected_second.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(output_second[i], expected_second[i]);
+        }
+        for(size_t i = 0; i < expected_unselected.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(output_unselected[i], expected_unselected[i]);
+        }
+
+        hipFree(d_input);
+        hipFree(d_output_first);
+        hipFree(d_output_second);
+        hipFree(d_output_unselected);
+        hipFree(d_selected_count_output);
+        hipFree(d_temp_storage);
+    }
+}
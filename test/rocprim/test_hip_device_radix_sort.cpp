@@ -122,6 +122,19 @@ struct key_value_comparator
     }
 };
 
+// Custom keys are sorted by y and then by x
+BEGIN_ROCPRIM_NAMESPACE
+template<>
+struct radix_key_decomposer<test_utils::custom_test_type<int>>
+{
+    ROCPRIM_HOST_DEVICE
+    rocprim::tuple<int&, int&> operator()(test_utils::custom_test_type<int>& key) const
+    {
+        return rocprim::tie(key.y, key.x);
+    }
+};
+END_ROCPRIM_NAMESPACE
+
 std::vector<size_t> get_sizes()
 {
     std::vector<size_t> sizes = { 1, 10, 53, 211, 1024, 2345, 4096, 34567, (1 << 16) - 1220, (1 << 23) - 76543 };
@@ -640,3 +653,417 @@ TYPED_TEST(RocprimDeviceRadixSort, SortPairsDoubleBuffer)
         }
     }
 }
+
+TEST(RocprimDeviceRadixSortDecomposed, SortPairsTuple)
+{
+    using key_type = rp::tuple<short, float>;
+    using value_type = unsigned int;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(size_t size : sizes)
+    {
+        if(size > (1 << 20)) continue;
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        const std::vector<short> first = test_utils::get_random_data<short>(size, -100, 100);
+        const std::vector<float> second = test_utils::get_random_data<float>(size, -1000, 1000);
+        std::vector<key_type> keys_input(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            keys_input[i] = key_type(first[i], second[i]);
+        }
+
+        std::vector<value_type> values_input(size);
+        std::iota(values_input.begin(), values_input.end(), 0);
+
+        key_type * d_keys_input;
+        key_type * d_keys_output;
+        HIP_CHECK(hipMalloc(&d_keys_input, size * sizeof(key_type)));
+        HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(key_type)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys_input, keys_input.data(),
+                size * sizeof(key_type),
+                hipMemcpyHostToDevice
+            )
+        );
+
+        value_type * d_values_input;
+        value_type * d_values_output;
+        HIP_CHECK(hipMalloc(&d_values_input, size * sizeof(value_type)));
+        HIP_CHECK(hipMalloc(&d_values_output, size * sizeof(value_type)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_values_input, values_input.data(),
+                size * sizeof(value_type),
+                hipMemcpyHostToDevice
+            )
+        );
+
+        using key_value = std::pair<key_type, value_type>;
+
+        // Calculate expected results on host
+        std::vector<key_value> expected(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            expected[i] = key_value(keys_input[i], values_input[i]);
+        }
+        std::stable_sort(
+            expected.begin(), expected.end(),
+            [](const key_value& lhs, const key_value& rhs) { return lhs.first < rhs.first; }
+        );
+
+        void * d_temporary_storage = nullptr;
+        size_t temporary_storage_bytes;
+        HIP_CHECK(
+            rp::radix_sort_pairs(
+                d_temporary_storage, temporary_storage_bytes,
+                d_keys_input, d_keys_output, d_values_input, d_values_output, size
+            )
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+
+        HIP_CHECK(
+            rp::radix_sort_pairs(
+                d_temporary_storage, temporary_storage_bytes,
+                d_keys_input, d_keys_output, d_values_input, d_values_output, size,
+                0, 8 * sizeof(key_type),
+                stream, debug_synchronous
+            )
+        );
+
+        HIP_CHECK(hipFree(d_temporary_storage));
+        HIP_CHECK(hipFree(d_keys_input));
+        HIP_CHECK(hipFree(d_values_input));
+
+        std::vector<key_type> keys_output(size);
+        HIP_CHECK(
+            hipMemcpy(
+                keys_output.data(), d_keys_output,
+                size * sizeof(key_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+
+        std::vector<value_type> values_output(size);
+        HIP_CHECK(
+            hipMemcpy(
+                values_output.data(), d_values_output,
+                size * sizeof(value_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+
+        HIP_CHECK(hipFree(d_keys_output));
+        HIP_CHECK(hipFree(d_values_output));
+
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(keys_output[i], expected[i].first);
+            ASSERT_EQ(values_output[i], expected[i].second);
+        }
+    }
+}
+
+TEST(RocprimDeviceRadixSortDecomposed, SortKeysCustomDescending)
+{
+    using key_type = test_utils::custom_test_type<int>;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(size_t size : sizes)
+    {
+        if(size > (1 << 20)) continue;
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        const std::vector<int> x = test_utils::get_random_data<int>(
+            size, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()
+        );
+        const std::vector<int> y = test_utils::get_random_data<int>(size, -10, 10);
+        std::vector<key_type> keys_input(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            keys_input[i] = key_type(x[i], y[i]);
+        }
+
+        key_type * d_keys_input;
+        key_type * d_keys_output;
+        HIP_CHECK(hipMalloc(&d_keys_input, size * sizeof(key_type)));
+        HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(key_type)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys_input, keys_input.data(),
+                size * sizeof(key_type),
+                hipMemcpyHostToDevice
+            )
+        );
+
+        // Calculate expected results on host
+        std::vector<key_type> expected(keys_input);
+        std::stable_sort(
+            expected.begin(), expected.end(),
+            [](const key_type& lhs, const key_type& rhs)
+            {
+                return rhs.y < lhs.y || (rhs.y == lhs.y && rhs.x < lhs.x);
+            }
+        );
+
+        size_t temporary_storage_bytes;
+        HIP_CHECK(
+            rp::radix_sort_keys_desc(
+                nullptr, temporary_storage_bytes,
+                d_keys_input, d_keys_output, size
+            )
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        void * d_temporary_storage;
+        HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+
+        HIP_CHECK(
+            rp::radix_sort_keys_desc(
+                d_temporary_storage, temporary_storage_bytes,
+                d_keys_input, d_keys_output, size,
+                0, 8 * sizeof(key_type),
+                stream, debug_synchronous
+            )
+        );
+
+        HIP_CHECK(hipFree(d_temporary_storage));
+        HIP_CHECK(hipFree(d_keys_input));
+
+        std::vector<key_type> keys_output(size);
+        HIP_CHECK(
+            hipMemcpy(
+                keys_output.data(), d_keys_output,
+                size * sizeof(key_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+
+        HIP_CHECK(hipFree(d_keys_output));
+
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(keys_output[i], expected[i]);
+        }
+    }
+}
+
+#ifndef ROCPRIM_CPU_API
+// A small chunk size forces sorting in many chunks, as for inputs of more than 4G keys
+using chunked_config = rp::radix_sort_config<4, rp::kernel_config<64, 2>, 1000>;
+
+TEST(RocprimDeviceRadixSortChunked, SortPairs)
+{
+    using key_type = unsigned int;
+    using value_type = unsigned int;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(size_t size : sizes)
+    {
+        if(size > (1 << 20)) continue;
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        const std::vector<key_type> keys_input = test_utils::get_random_data<key_type>(size, 0, 1000000);
+
+        std::vector<value_type> values_input(size);
+        std::iota(values_input.begin(), values_input.end(), 0);
+
+        key_type * d_keys_input;
+        key_type * d_keys_output;
+        HIP_CHECK(hipMalloc(&d_keys_input, size * sizeof(key_type)));
+        HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(key_type)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys_input, keys_input.data(),
+                size * sizeof(key_type),
+                hipMemcpyHostToDevice
+            )
+        );
+
+        value_type * d_values_input;
+        value_type * d_values_output;
+        HIP_CHECK(hipMalloc(&d_values_input, size * sizeof(value_type)));
+        HIP_CHECK(hipMalloc(&d_values_output, size * sizeof(value_type)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_values_input, values_input.data(),
+                size * sizeof(value_type),
+                hipMemcpyHostToDevice
+            )
+        );
+
+        using key_value = std::pair<key_type, value_type>;
+
+        // Calculate expected results on host
+        std::vector<key_value> expected(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            expected[i] = key_value(keys_input[i], values_input[i]);
+        }
+        std::stable_sort(
+            expected.begin(), expected.end(),
+            key_value_comparator<key_type, value_type, false, 0, sizeof(key_type) * 8>()
+        );
+
+        void * d_temporary_storage = nullptr;
+        size_t temporary_storage_bytes;
+        HIP_CHECK(
+            rp::radix_sort_pairs<chunked_config>(
+                d_temporary_storage, temporary_storage_bytes,
+                d_keys_input, d_keys_output, d_values_input, d_values_output, size
+            )
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+
+        HIP_CHECK(
+            rp::radix_sort_pairs<chunked_config>(
+                d_temporary_storage, temporary_storage_bytes,
+                d_keys_input, d_keys_output, d_values_input, d_values_output, size,
+                0, 8 * sizeof(key_type),
+                stream, debug_synchronous
+            )
+        );
+
+        HIP_CHECK(hipFree(d_temporary_storage));
+        HIP_CHECK(hipFree(d_keys_input));
+        HIP_CHECK(hipFree(d_values_input));
+
+        std::vector<key_type> keys_output(size);
+        HIP_CHECK(
+            hipMemcpy(
+                keys_output.data(), d_keys_output,
+                size * sizeof(key_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+
+        std::vector<value_type> values_output(size);
+        HIP_CHECK(
+            hipMemcpy(
+                values_output.data(), d_values_output,
+                size * sizeof(value_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+
+        HIP_CHECK(hipFree(d_keys_output));
+        HIP_CHECK(hipFree(d_values_output));
+
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(keys_output[i], expected[i].first);
+            ASSERT_EQ(values_output[i], expected[i].second);
+        }
+    }
+}
+
+TEST(RocprimDeviceRadixSortChunked, SortKeysDoubleBuffer)
+{
+    using key_type = int;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(size_t size : sizes)
+    {
+        if(size > (1 << 20)) continue;
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        const std::vector<key_type> keys_input = test_utils::get_random_data<key_type>(
+            size,
+            std::numeric_limits<key_type>::min(),
+            std::numeric_limits<key_type>::max()
+        );
+
+        key_type * d_keys_input;
+        key_type * d_keys_output;
+        HIP_CHECK(hipMalloc(&d_keys_input, size * sizeof(key_type)));
+        HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(key_type)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys_input, keys_input.data(),
+                size * sizeof(key_type),
+                hipMemcpyHostToDevice
+            )
+        );
+
+        // Calculate expected results on host
+        std::vector<key_type> expected(keys_input);
+        std::sort(expected.begin(), expected.end());
+
+        rp::double_buffer<key_type> d_keys(d_keys_input, d_keys_output);
+
+        size_t temporary_storage_bytes;
+        HIP_CHECK(
+            rp::radix_sort_keys<chunked_config>(
+                nullptr, temporary_storage_bytes,
+                d_keys, size
+            )
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        void * d_temporary_storage;
+        HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+
+        HIP_CHECK(
+            rp::radix_sort_keys<chunked_config>(
+                d_temporary_storage, temporary_storage_bytes,
+                d_keys, size,
+                0, 8 * sizeof(key_type),
+                stream, debug_synchronous
+            )
+        );
+
+        HIP_CHECK(hipFree(d_temporary_storage));
+
+        std::vector<key_type> keys_output(size);
+        HIP_CHECK(
+            hipMemcpy(
+                keys_output.data(), d_keys.current(),
+                size * sizeof(key_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+
+        HIP_CHECK(hipFree(d_keys_input));
+        HIP_CHECK(hipFree(d_keys_output));
+
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(keys_output[i], expected[i]);
+        }
+    }
+}
+
+#endif // ROCPRIM_CPU_API
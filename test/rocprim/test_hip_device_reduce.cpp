@@ -43,12 +43,14 @@ namespace rp = rocprim;
 // Params for tests
 template<
     class InputType,
-    class OutputType = InputType
+    class OutputType = InputType,
+    class Config = rp::default_config
 >
 struct DeviceReduceParams
 {
     using input_type = InputType;
     using output_type = OutputType;
+    using config = Config;
 };
 
 // ---------------------------------------------------------
@@ -61,6 +63,7 @@ class RocprimDeviceReduceTests : public ::testing::Test
 public:
     using input_type = typename Params::input_type;
     using output_type = typename Params::output_type;
+    using config = typename Params::config;
     const bool debug_synchronous = false;
 };
 
@@ -71,7 +74,9 @@ typedef ::testing::Types<
     DeviceReduceParams<int>,
     DeviceReduceParams<unsigned long>,
     DeviceReduceParams<short, int>,
-    DeviceReduceParams<int, float>
+    DeviceReduceParams<int, float>,
+    DeviceReduceParams<int, int, rp::kernel_config<64, 3>>,
+    DeviceReduceParams<short, float, rp::kernel_config<128, 1>>
 > RocprimDeviceReduceTestsParams;
 
 std::vector<size_t> get_sizes()
@@ -93,6 +98,7 @@ TYPED_TEST(RocprimDeviceReduceTests, Reduce)
 {
     using T = typename TestFixture::input_type;
     using U = typename TestFixture::output_type;
+    using config = typename TestFixture::config;
     const bool debug_synchronous = TestFixture::debug_synchronous;
 
     const std::vector<size_t> sizes = get_sizes();
@@ -129,7 +135,7 @@ TYPED_TEST(RocprimDeviceReduceTests, Reduce)
         void * d_temp_storage = nullptr;
         // Get size of d_temp_storage
         HIP_CHECK(
-            rocprim::reduce(
+            rocprim::reduce<config>(
                 d_temp_storage, temp_storage_size_bytes,
                 d_input, d_output, input.size(),
                 plus_op, stream, debug_synchronous
@@ -145,7 +151,7 @@ TYPED_TEST(RocprimDeviceReduceTests, Reduce)
 
         // Run
         HIP_CHECK(
-            rocprim::reduce(
+            rocprim::reduce<config>(
                 d_temp_storage, temp_storage_size_bytes,
                 d_input, d_output, input.size(),
                 plus_op, stream, debug_synchronous
@@ -175,6 +181,93 @@ TYPED_TEST(RocprimDeviceReduceTests, Reduce)
     }
 }
 
+TYPED_TEST(RocprimDeviceReduceTests, ReduceHostFallback)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    // Reductions of at most 4096 items are performed on the host, larger ones on the device
+    using config = rp::host_fallback_config<4096>;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        hipStream_t stream = 0; // default
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+
+        // Pinned host memory is accessible by both host and device
+        T * h_input;
+        U * h_output;
+        HIP_CHECK(hipHostMalloc(&h_input, input.size() * sizeof(T)));
+        HIP_CHECK(hipHostMalloc(&h_output, sizeof(U)));
+        std::copy(input.begin(), input.end(), h_input);
+
+        // reduce function
+        ::rocprim::plus<U> plus_op;
+        // Calls of the reduce function made on the host are counted
+        unsigned int host_calls = 0;
+        test_utils::host_call_counter<::rocprim::plus<U>> counting_plus_op { plus_op, &host_calls };
+
+        // Calculate expected results on host
+        U initial_value = test_utils::get_random_value<U>(1, 100);
+        U expected = test_utils::host_reduce(input.begin(), input.end(), initial_value, plus_op);
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        void * d_temp_storage = nullptr;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            rocprim::reduce<config>(
+                d_temp_storage, temp_storage_size_bytes,
+                h_input, h_output, initial_value, input.size(),
+                counting_plus_op, stream, debug_synchronous
+            )
+        );
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            rocprim::reduce<config>(
+                d_temp_storage, temp_storage_size_bytes,
+                h_input, h_output, initial_value, input.size(),
+                counting_plus_op, stream, debug_synchronous
+            )
+        );
+        HIP_CHECK(hipPeekAtLastError());
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if output values are as expected
+        auto diff = std::max<U>(std::abs(0.01f * expected), U(0.01f));
+        if(std::is_integral<U>::value) diff = 0;
+        ASSERT_NEAR(h_output[0], expected, diff);
+
+        // Only the host fallback calls the reduce function on the host
+        if(size <= config::max_size)
+        {
+            ASSERT_EQ(host_calls, size);
+        }
+        else
+        {
+            ASSERT_EQ(host_calls, 0U);
+        }
+
+        hipHostFree(h_input);
+        hipHostFree(h_output);
+        hipFree(d_temp_storage);
+    }
+}
+
 TYPED_TEST(RocprimDeviceReduceTests, ReduceMinimum)
 {
     using T = typename TestFixture::input_type;
@@ -74,7 +74,8 @@ std::vector<size_t> get_sizes()
     std::vector<size_t> sizes = {
         1, 10, 53, 211,
         1024, 2048, 5096,
-        34567, (1 << 18) - 1220
+        34567, (1 << 18) - 1220,
+        (1 << 20) - 123
     };
     const std::vector<size_t> random_sizes = test_utils::get_random_data<size_t>(2, 1, 16384);
     sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
@@ -276,6 +277,107 @@ TYPED_TEST(RocprimDeviceScanTests, ExclusiveScanSum)
     }
 }
 
+#ifndef ROCPRIM_CPU_API
+// The CPU backend runs all primitives on the host, there is no fallback to check
+TYPED_TEST(RocprimDeviceScanTests, ExclusiveScanHostFallback)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    // Scans of at most 4096 items are performed on the host, larger ones on the device
+    using config = rp::host_fallback_config<4096>;
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        hipStream_t stream = 0; // default
+
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 10);
+
+        // Pinned host memory is accessible by both host and device
+        T * h_input;
+        U * h_output;
+        HIP_CHECK(hipHostMalloc(&h_input, input.size() * sizeof(T)));
+        HIP_CHECK(hipHostMalloc(&h_output, input.size() * sizeof(U)));
+        std::copy(input.begin(), input.end(), h_input);
+
+        // scan function
+        ::rocprim::plus<U> plus_op;
+        // Calls of the scan function made on the host are counted
+        unsigned int host_calls = 0;
+        test_utils::host_call_counter<::rocprim::plus<U>> counting_plus_op { plus_op, &host_calls };
+
+        // Calculate expected results on host
+        std::vector<U> expected(input.size());
+        T initial_value = test_utils::get_random_value<T>(1, 100);
+        test_utils::host_exclusive_scan(
+            input.begin(), input.end(),
+            initial_value, expected.begin(),
+            plus_op
+        );
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        void * d_temp_storage = nullptr;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            rocprim::exclusive_scan<config>(
+                d_temp_storage, temp_storage_size_bytes,
+                h_input, h_output, initial_value, input.size(),
+                counting_plus_op, stream, debug_synchronous
+            )
+        );
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            rocprim::exclusive_scan<config>(
+                d_temp_storage, temp_storage_size_bytes,
+                h_input, h_output, initial_value, input.size(),
+                counting_plus_op, stream, debug_synchronous
+            )
+        );
+        HIP_CHECK(hipPeekAtLastError());
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if output values are as expected
+        for(size_t i = 0; i < input.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            auto diff = std::max<U>(std::abs(0.01f * expected[i]), U(0.01f));
+            if(std::is_integral<U>::value) diff = 0;
+            ASSERT_NEAR(h_output[i], expected[i], diff);
+        }
+
+        // Only the host fallback calls the scan function on the host
+        if(size <= config::max_size)
+        {
+            ASSERT_EQ(host_calls, size);
+        }
+        else
+        {
+            ASSERT_EQ(host_calls, 0U);
+        }
+
+        hipHostFree(h_input);
+        hipHostFree(h_output);
+        hipFree(d_temp_storage);
+    }
+}
+#endif // ROCPRIM_CPU_API
+
+#ifndef ROCPRIM_CPU_API
+// The CPU backend does not provide scans by key
 TYPED_TEST(RocprimDeviceScanTests, InclusiveScanByKey)
 {
     using T = typename TestFixture::input_type;
@@ -517,3 +619,5 @@ TYPED_TEST(RocprimDeviceScanTests, ExclusiveScanByKey)
         hipFree(d_temp_storage);
     }
 }
+
+#endif // ROCPRIM_CPU_API
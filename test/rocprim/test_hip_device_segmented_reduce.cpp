@@ -48,7 +48,8 @@ template<
     class ReduceOp = ::rocprim::plus<Input>,
     int Init = 0, // as only integral types supported, int is used here even for floating point inputs
     unsigned int MinSegmentLength = 0,
-    unsigned int MaxSegmentLength = 1000
+    unsigned int MaxSegmentLength = 1000,
+    class Config = rp::default_config
 >
 struct params
 {
@@ -58,6 +59,7 @@ struct params
     static constexpr input_type init = Init;
     static constexpr unsigned int min_segment_length = MinSegmentLength;
     static constexpr unsigned int max_segment_length = MaxSegmentLength;
+    using config = Config;
 };
 
 template<class Params>
@@ -72,7 +74,11 @@ typedef ::testing::Types<
     params<double, double, rp::minimum<double>, 1000, 0, 10000>,
     params<int, short, rp::maximum<int>, 10, 1000, 10000>,
     params<float, double, rp::maximum<double>, 50, 2, 10>,
-    params<float, float, rp::plus<float>, 123, 100, 200>
+    params<float, float, rp::plus<float>, 123, 100, 200>,
+    // Load-balanced mode
+    params<int, int, rp::plus<int>, 0, 0, 10000, rp::segmented_reduce_config<256, 8>>,
+    params<float, double, rp::maximum<double>, 50, 0, 300, rp::segmented_reduce_config<256, 4, 16, 64>>,
+    params<int, int, rp::plus<int>, 7, 100000, 1000000, rp::segmented_reduce_config<128, 2>>
 > Params;
 
 TYPED_TEST_CASE(RocprimDeviceSegmentedReduce, Params);
@@ -97,6 +103,7 @@ TYPED_TEST(RocprimDeviceSegmentedReduce, Reduce)
     using output_type = typename TestFixture::params::output_type;
     using reduce_op_type = typename TestFixture::params::reduce_op_type;
     constexpr input_type init = TestFixture::params::init;
+    using config = typename TestFixture::params::config;
 
     #ifdef __cpp_lib_is_invocable
     using result_type = typename std::invoke_result<reduce_op_type, input_type, input_type>::type;
@@ -178,7 +185,7 @@ TYPED_TEST(RocprimDeviceSegmentedReduce, Reduce)
         size_t temporary_storage_bytes;
 
         HIP_CHECK(
-            rp::segmented_reduce(
+            rp::segmented_reduce<config>(
                 nullptr, temporary_storage_bytes,
                 d_values_input, d_aggregates_output,
                 segments_count,
@@ -194,7 +201,7 @@ TYPED_TEST(RocprimDeviceSegmentedReduce, Reduce)
         HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
 
         HIP_CHECK(
-            rp::segmented_reduce(
+            rp::segmented_reduce<config>(
                 d_temporary_storage, temporary_storage_bytes,
                 d_values_input, d_aggregates_output,
                 segments_count,
@@ -233,3 +240,140 @@ TYPED_TEST(RocprimDeviceSegmentedReduce, Reduce)
         }
     }
 }
+
+#ifndef ROCPRIM_CPU_API
+// The CPU backend runs all primitives on the host, there is no fallback to check
+TYPED_TEST(RocprimDeviceSegmentedReduce, ReduceHostFallback)
+{
+    using input_type = typename TestFixture::params::input_type;
+    using output_type = typename TestFixture::params::output_type;
+    using reduce_op_type = typename TestFixture::params::reduce_op_type;
+    constexpr input_type init = TestFixture::params::init;
+
+    // Reductions of at most 4096 segments are performed on the host, larger ones on the device
+    using config = rp::host_fallback_config<4096>;
+
+    #ifdef __cpp_lib_is_invocable
+    using result_type = typename std::invoke_result<reduce_op_type, input_type, input_type>::type;
+    #else
+    using result_type = typename std::result_of<reduce_op_type(input_type, input_type)>::type;
+    #endif
+
+    using offset_type = unsigned int;
+
+    const bool debug_synchronous = false;
+
+    reduce_op_type reduce_op;
+
+    const std::vector<size_t> sizes = get_sizes();
+
+    std::random_device rd;
+    std::default_random_engine gen(rd());
+
+    std::uniform_int_distribution<size_t> segment_length_dis(
+        TestFixture::params::min_segment_length,
+        TestFixture::params::max_segment_length
+    );
+
+    for(size_t size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        hipStream_t stream = 0; // default
+
+        // Generate data
+        std::vector<input_type> values_input = test_utils::get_random_data<input_type>(size, 0, 100);
+
+        std::vector<offset_type> offsets;
+        size_t offset = 0;
+        while(offset < size)
+        {
+            offsets.push_back(offset);
+            offset += segment_length_dis(gen);
+        }
+        offsets.push_back(size);
+        const unsigned int segments_count = offsets.size() - 1;
+
+        // Calculate expected results on host
+        std::vector<output_type> aggregates_expected(segments_count);
+        test_utils::host_segmented_reduce(
+            values_input.begin(), offsets.begin(), offsets.begin() + 1,
+            segments_count, result_type(init), aggregates_expected.begin(),
+            reduce_op
+        );
+
+        // Calls of the reduce function made on the host are counted
+        unsigned int host_calls = 0;
+        test_utils::host_call_counter<reduce_op_type> counting_reduce_op { reduce_op, &host_calls };
+
+        // Pinned host memory is accessible by both host and device
+        input_type * h_values_input;
+        offset_type * h_offsets;
+        output_type * h_aggregates_output;
+        HIP_CHECK(hipHostMalloc(&h_values_input, size * sizeof(input_type)));
+        HIP_CHECK(hipHostMalloc(&h_offsets, (segments_count + 1) * sizeof(offset_type)));
+        HIP_CHECK(hipHostMalloc(&h_aggregates_output, segments_count * sizeof(output_type)));
+        std::copy(values_input.begin(), values_input.end(), h_values_input);
+        std::copy(offsets.begin(), offsets.end(), h_offsets);
+
+        size_t temporary_storage_bytes;
+
+        HIP_CHECK(
+            rp::segmented_reduce<config>(
+                nullptr, temporary_storage_bytes,
+                h_values_input, h_aggregates_output,
+                segments_count,
+                h_offsets, h_offsets + 1,
+                counting_reduce_op, init,
+                stream, debug_synchronous
+            )
+        );
+
+        ASSERT_GT(temporary_storage_bytes, 0);
+
+        void * d_temporary_storage;
+        HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+
+        HIP_CHECK(
+            rp::segmented_reduce<config>(
+                d_temporary_storage, temporary_storage_bytes,
+                h_values_input, h_aggregates_output,
+                segments_count,
+                h_offsets, h_offsets + 1,
+                counting_reduce_op, init,
+                stream, debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        HIP_CHECK(hipFree(d_temporary_storage));
+
+        for(size_t i = 0; i < segments_count; i++)
+        {
+            if(std::is_integral<output_type>::value)
+            {
+                ASSERT_EQ(h_aggregates_output[i], aggregates_expected[i]);
+            }
+            else
+            {
+                auto diff = std::max<output_type>(std::abs(0.01 * aggregates_expected[i]), 0.01);
+                ASSERT_NEAR(h_aggregates_output[i], aggregates_expected[i], diff);
+            }
+        }
+
+        // Only the host fallback calls the reduce function on the host
+        if(segments_count <= config::max_size)
+        {
+            ASSERT_EQ(host_calls, size);
+        }
+        else
+        {
+            ASSERT_EQ(host_calls, 0U);
+        }
+
+        HIP_CHECK(hipHostFree(h_values_input));
+        HIP_CHECK(hipHostFree(h_offsets));
+        HIP_CHECK(hipHostFree(h_aggregates_output));
+    }
+}
+#endif // ROCPRIM_CPU_API
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <iterator>
 
 // Google Test
 #include <gtest/gtest.h>
@@ -211,6 +212,121 @@ TYPED_TEST(RocprimDeviceSelectTests, Flagged)
     }
 }
 
+#ifndef ROCPRIM_CPU_API
+// The CPU backend runs all primitives on the host, there is no fallback to check
+TYPED_TEST(RocprimDeviceSelectTests, SelectOpHostFallback)
+{
+    using T = typename TestFixture::input_type;
+    using U = typename TestFixture::output_type;
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    // Selections of at most 4096 items are performed on the host, larger ones on the device
+    using config = rocprim::host_fallback_config<4096>;
+
+    hipStream_t stream = 0; // default stream
+
+    auto select_op = [] __host__ __device__ (const T& value) -> bool
+        {
+            if(value > 50) return true;
+            return false;
+        };
+
+    const std::vector<size_t> sizes = get_sizes();
+    for(auto size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<T> input = test_utils::get_random_data<T>(size, 1, 100);
+
+        // Pinned host memory is accessible by both host and device
+        T * h_input;
+        U * h_output;
+        unsigned int * h_selected_count_output;
+        HIP_CHECK(hipHostMalloc(&h_input, input.size() * sizeof(T)));
+        HIP_CHECK(hipHostMalloc(&h_output, input.size() * sizeof(U)));
+        HIP_CHECK(hipHostMalloc(&h_selected_count_output, sizeof(unsigned int)));
+        std::copy(input.begin(), input.end(), h_input);
+
+        // Calls of the select predicate made on the host are counted
+        unsigned int host_calls = 0;
+        test_utils::host_call_counter<decltype(select_op)> counting_select_op { select_op, &host_calls };
+
+        // Calculate expected results on host
+        std::vector<U> expected;
+        expected.reserve(input.size());
+        std::copy_if(input.begin(), input.end(), std::back_inserter(expected), select_op);
+
+        // temp storage
+        size_t temp_storage_size_bytes;
+        // Get size of d_temp_storage
+        HIP_CHECK(
+            rocprim::select<config>(
+                nullptr,
+                temp_storage_size_bytes,
+                h_input,
+                h_output,
+                h_selected_count_output,
+                input.size(),
+                counting_select_op,
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // temp_storage_size_bytes must be >0
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        // allocate temporary storage
+        void * d_temp_storage = nullptr;
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Run
+        HIP_CHECK(
+            rocprim::select<config>(
+                d_temp_storage,
+                temp_storage_size_bytes,
+                h_input,
+                h_output,
+                h_selected_count_output,
+                input.size(),
+                counting_select_op,
+                stream,
+                debug_synchronous
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Check if number of selected value is as expected
+        ASSERT_EQ(h_selected_count_output[0], expected.size());
+
+        // Check if output values are as expected
+        for(size_t i = 0; i < expected.size(); i++)
+        {
+            SCOPED_TRACE(testing::Message() << "where index = " << i);
+            ASSERT_EQ(h_output[i], expected[i]);
+        }
+
+        // Only the host fallback calls the select predicate on the host
+        if(size <= config::max_size)
+        {
+            ASSERT_EQ(host_calls, size);
+        }
+        else
+        {
+            ASSERT_EQ(host_calls, 0U);
+        }
+
+        hipHostFree(h_input);
+        hipHostFree(h_output);
+        hipHostFree(h_selected_count_output);
+        hipFree(d_temp_storage);
+    }
+}
+#endif // ROCPRIM_CPU_API
+
 TYPED_TEST(RocprimDeviceSelectTests, SelectOp)
 {
     using T = typename TestFixture::input_type;
@@ -20,9 +20,11 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <limits>
 
 // Google Test
 #include <gtest/gtest.h>
@@ -559,3 +561,171 @@ TEST(RocprimIntrinsicsTests, ShuffleUpCustomAlignedStruct)
     }
     hipFree(device_data);
 }
+
+template<class Params>
+class RocprimAtomicTests : public ::testing::Test
+{
+public:
+    using type = typename Params::type;
+};
+
+typedef ::testing::Types<
+    params<int>,
+    params<unsigned int>,
+    params<long long>,
+    params<unsigned long long>,
+    params<float>,
+    params<double>
+> AtomicTestParams;
+
+TYPED_TEST_CASE(RocprimAtomicTests, AtomicTestParams);
+
+template<class T>
+__global__
+void atomic_add_min_max_kernel(const T* input, T* output)
+{
+    const unsigned int index = (hipBlockIdx_x * hipBlockDim_x) + hipThreadIdx_x;
+    const T value = input[index];
+    rocprim::atomic_add(&output[0], value);
+    rocprim::atomic_min(&output[1], value);
+    rocprim::atomic_max(&output[2], value);
+    rocprim::atomic_add_system(&output[3], value);
+    rocprim::atomic_min_system(&output[4], value);
+    rocprim::atomic_max_system(&output[5], value);
+}
+
+TYPED_TEST(RocprimAtomicTests, AddMinMax)
+{
+    using T = typename TestFixture::type;
+    const size_t block_size = 256;
+    const size_t size = block_size * 64;
+
+    // Integral values, so sums of floating point values are exact
+    std::vector<T> input = test_utils::get_random_data<T>(size, T(0), T(100));
+    for(auto& value : input)
+    {
+        value = static_cast<T>(static_cast<int>(value));
+    }
+    std::vector<T> output = {
+        T(0), std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(),
+        T(0), std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()
+    };
+
+    // Calculate expected results on host
+    T sum = 0;
+    for(auto value : input)
+    {
+        sum += value;
+    }
+    const T min = *std::min_element(input.begin(), input.end());
+    const T max = *std::max_element(input.begin(), input.end());
+    const std::vector<T> expected = { sum, min, max, sum, min, max };
+
+    T * device_input;
+    HIP_CHECK(hipMalloc(&device_input, input.size() * sizeof(T)));
+    T * device_output;
+    HIP_CHECK(hipMalloc(&device_output, output.size() * sizeof(T)));
+
+    HIP_CHECK(
+        hipMemcpy(
+            device_input, input.data(),
+            input.size() * sizeof(T),
+            hipMemcpyHostToDevice
+        )
+    );
+    HIP_CHECK(
+        hipMemcpy(
+            device_output, output.data(),
+            output.size() * sizeof(T),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(atomic_add_min_max_kernel<T>),
+        dim3(size / block_size), dim3(block_size), 0, 0,
+        device_input, device_output
+    );
+    HIP_CHECK(hipPeekAtLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    HIP_CHECK(
+        hipMemcpy(
+            output.data(), device_output,
+            output.size() * sizeof(T),
+            hipMemcpyDeviceToHost
+        )
+    );
+
+    for(size_t i = 0; i < output.size(); i++)
+    {
+        SCOPED_TRACE(testing::Message() << "where index = " << i);
+        ASSERT_EQ(output[i], expected[i]);
+    }
+
+    HIP_CHECK(hipFree(device_input));
+    HIP_CHECK(hipFree(device_output));
+}
+
+__global__
+void atomic_bitwise_exch_cas_kernel(unsigned long long* output)
+{
+    const unsigned int index = (hipBlockIdx_x * hipBlockDim_x) + hipThreadIdx_x;
+    const unsigned long long bit = 1ULL << (index % 64);
+    rocprim::atomic_or(&output[0], bit);
+    rocprim::atomic_and(&output[1], ~bit);
+    rocprim::atomic_xor_system(&output[2], bit);
+    rocprim::atomic_exch(&output[3], static_cast<unsigned long long>(index));
+
+    // Increment using compare-and-swap loop
+    unsigned long long old_value = output[4];
+    unsigned long long assumed;
+    do
+    {
+        assumed = old_value;
+        old_value = rocprim::atomic_cas(&output[4], assumed, assumed + 1);
+    } while(old_value != assumed);
+}
+
+TEST(RocprimAtomicTests, BitwiseExchCas)
+{
+    const size_t block_size = 256;
+    // Each bit is xor-ed an even number of times
+    const size_t size = 64 * 64;
+
+    std::vector<unsigned long long> output = { 0, ~0ULL, 0, size, 0 };
+
+    unsigned long long * device_output;
+    HIP_CHECK(hipMalloc(&device_output, output.size() * sizeof(unsigned long long)));
+    HIP_CHECK(
+        hipMemcpy(
+            device_output, output.data(),
+            output.size() * sizeof(unsigned long long),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(atomic_bitwise_exch_cas_kernel),
+        dim3(size / block_size), dim3(block_size), 0, 0,
+        device_output
+    );
+    HIP_CHECK(hipPeekAtLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    HIP_CHECK(
+        hipMemcpy(
+            output.data(), device_output,
+            output.size() * sizeof(unsigned long long),
+            hipMemcpyDeviceToHost
+        )
+    );
+
+    ASSERT_EQ(output[0], ~0ULL);
+    ASSERT_EQ(output[1], 0ULL);
+    ASSERT_EQ(output[2], 0ULL);
+    ASSERT_LT(output[3], size);
+    ASSERT_EQ(output[4], size);
+
+    HIP_CHECK(hipFree(device_output));
+}
@@ -0,0 +1,360 @@
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+
+// Google Test
+#include <gtest/gtest.h>
+// HIP API
+#include <hip/hip_runtime.h>
+// rocPRIM API
+#include <rocprim/rocprim.hpp>
+
+#include "test_utils.hpp"
+
+#define HIP_CHECK(error) ASSERT_EQ(static_cast<hipError_t>(error),hipSuccess)
+
+template<class T>
+struct times_two
+{
+    ROCPRIM_HOST_DEVICE
+    T operator()(const T& value) const
+    {
+        return 2 * value;
+    }
+};
+
+template<class T>
+struct plus_ten
+{
+    ROCPRIM_HOST_DEVICE
+    T operator()(const T& value) const
+    {
+        return value + 10;
+    }
+};
+
+// Params for tests
+template<
+    class InputType,
+    class UnaryFunction = times_two<InputType>,
+    class ValueType = InputType
+>
+struct RocprimTransformOutputIteratorParams
+{
+    using input_type = InputType;
+    using value_type = ValueType;
+    using unary_function = UnaryFunction;
+};
+
+template<class Params>
+class RocprimTransformOutputIteratorTests : public ::testing::Test
+{
+public:
+    using input_type = typename Params::input_type;
+    using value_type = typename Params::value_type;
+    using unary_function = typename Params::unary_function;
+    const bool debug_synchronous = false;
+};
+
+typedef ::testing::Types<
+    RocprimTransformOutputIteratorParams<int, plus_ten<long>, long>,
+    RocprimTransformOutputIteratorParams<unsigned int>,
+    RocprimTransformOutputIteratorParams<unsigned long>,
+    RocprimTransformOutputIteratorParams<float, plus_ten<double>, double>
+> RocprimTransformOutputIteratorTestsParams;
+
+TYPED_TEST_CASE(RocprimTransformOutputIteratorTests, RocprimTransformOutputIteratorTestsParams);
+
+TYPED_TEST(RocprimTransformOutputIteratorTests, Assign)
+{
+    using input_type = typename TestFixture::input_type;
+    using value_type = typename TestFixture::value_type;
+    using unary_function = typename TestFixture::unary_function;
+    using iterator_type = typename rocprim::transform_output_iterator<
+        value_type*, unary_function
+    >;
+
+    std::vector<input_type> input =
+        test_utils::get_random_data<input_type>(5, 1, 200);
+    std::vector<value_type> output(5);
+    unary_function transform;
+
+    iterator_type x(output.data(), transform);
+    iterator_type y = x;
+    for(size_t i = 0; i < 5; i++)
+    {
+        x[i] = input[i];
+    }
+    for(size_t i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(output[i], static_cast<value_type>(transform(input[i])));
+    }
+
+    x += 100;
+    for(size_t i = 0; i < 100; i++)
+    {
+        y++;
+    }
+    ASSERT_EQ(x, y);
+}
+
+TYPED_TEST(RocprimTransformOutputIteratorTests, TransformScan)
+{
+    using input_type = typename TestFixture::input_type;
+    using value_type = typename TestFixture::value_type;
+    using unary_function = typename TestFixture::unary_function;
+    using iterator_type = typename rocprim::transform_output_iterator<
+        value_type*, unary_function
+    >;
+
+    hipStream_t stream = 0; // default
+
+    const size_t size = 1024;
+    // Generate data
+    std::vector<input_type> input = test_utils::get_random_data<input_type>(size, 1, 200);
+    std::vector<value_type> output(size);
+
+    input_type * d_input;
+    value_type * d_output;
+    HIP_CHECK(hipMalloc(&d_input, input.size() * sizeof(input_type)));
+    HIP_CHECK(hipMalloc(&d_output, output.size() * sizeof(value_type)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_input, input.data(),
+            input.size() * sizeof(input_type),
+            hipMemcpyHostToDevice
+        )
+    );
+    HIP_CHECK(hipDeviceSynchronize());
+
+    auto scan_op = rocprim::plus<input_type>();
+    unary_function transform;
+
+    // Calculate expected results on host
+    std::vector<value_type> expected(size);
+    input_type sum = input_type(0);
+    for(size_t i = 0; i < size; i++)
+    {
+        sum = scan_op(sum, input[i]);
+        expected[i] = transform(sum);
+    }
+
+    auto d_iter = iterator_type(d_output, transform);
+    // temp storage
+    size_t temp_storage_size_bytes;
+    // Get size of d_temp_storage
+    HIP_CHECK(
+        rocprim::inclusive_scan(
+            nullptr,
+            temp_storage_size_bytes,
+            d_input,
+            d_iter,
+            input.size(),
+            scan_op,
+            stream
+        )
+    );
+
+    // temp_storage_size_bytes must be >0
+    ASSERT_GT(temp_storage_size_bytes, 0);
+
+    // allocate temporary storage
+    void * d_temp_storage = nullptr;
+    HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Run
+    HIP_CHECK(
+        rocprim::inclusive_scan(
+            d_temp_storage,
+            temp_storage_size_bytes,
+            d_input,
+            d_iter,
+            input.size(),
+            scan_op,
+            stream,
+            TestFixture::debug_synchronous
+        )
+    );
+    HIP_CHECK(hipPeekAtLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    HIP_CHECK(
+        hipMemcpy(
+            output.data(), d_output,
+            output.size() * sizeof(value_type),
+            hipMemcpyDeviceToHost
+        )
+    );
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Check if output values are as expected
+    for(size_t i = 0; i < size; i++)
+    {
+        if(std::is_integral<value_type>::value)
+        {
+            ASSERT_EQ(output[i], expected[i]) << "where index = " << i;
+        }
+        else if(std::is_floating_point<value_type>::value)
+        {
+            auto tolerance = std::max<value_type>(std::abs(0.1f * expected[i]), value_type(0.01f));
+            ASSERT_NEAR(output[i], expected[i], tolerance) << "where index = " << i;
+        }
+    }
+
+    hipFree(d_input);
+    hipFree(d_output);
+    hipFree(d_temp_storage);
+}
+
+TYPED_TEST(RocprimTransformOutputIteratorTests, TransformRadixSortPairs)
+{
+    using input_type = typename TestFixture::input_type;
+    using value_type = typename TestFixture::value_type;
+    using unary_function = typename TestFixture::unary_function;
+    using input_iterator_type = typename rocprim::transform_iterator<
+        input_type*, times_two<input_type>, input_type
+    >;
+    using output_iterator_type = typename rocprim::transform_output_iterator<
+        value_type*, unary_function
+    >;
+
+    hipStream_t stream = 0; // default
+
+    const bool debug_synchronous = TestFixture::debug_synchronous;
+
+    const std::vector<size_t> sizes = { 1, 10, 1000, 12345, 100000 };
+    for(size_t size : sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Generate data
+        std::vector<input_type> keys_input = test_utils::get_random_data<input_type>(size, 1, 200);
+        std::vector<unsigned int> values_input(size);
+        std::iota(values_input.begin(), values_input.end(), 0);
+
+        input_type * d_keys_input;
+        value_type * d_keys_output;
+        unsigned int * d_values_input;
+        unsigned int * d_values_output;
+        HIP_CHECK(hipMalloc(&d_keys_input, size * sizeof(input_type)));
+        HIP_CHECK(hipMalloc(&d_keys_output, size * sizeof(value_type)));
+        HIP_CHECK(hipMalloc(&d_values_input, size * sizeof(unsigned int)));
+        HIP_CHECK(hipMalloc(&d_values_output, size * sizeof(unsigned int)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys_input, keys_input.data(),
+                size * sizeof(input_type),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                d_values_input, values_input.data(),
+                size * sizeof(unsigned int),
+                hipMemcpyHostToDevice
+            )
+        );
+        HIP_CHECK(hipDeviceSynchronize());
+
+        unary_function transform;
+
+        // Calculate expected results on host
+        std::vector<std::pair<input_type, unsigned int>> sorted(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            sorted[i] = std::make_pair(times_two<input_type>()(keys_input[i]), values_input[i]);
+        }
+        std::stable_sort(
+            sorted.begin(), sorted.end(),
+            [](const std::pair<input_type, unsigned int>& a, const std::pair<input_type, unsigned int>& b)
+            {
+                return a.first < b.first;
+            }
+        );
+
+        // Keys are doubled on load and transformed on store, values are scaled on store
+        input_iterator_type d_keys_iter(d_keys_input, times_two<input_type>());
+        output_iterator_type d_keys_output_iter(d_keys_output, transform);
+        auto d_values_output_iter = rocprim::make_transform_output_iterator(
+            d_values_output, times_two<unsigned int>()
+        );
+
+        size_t temp_storage_size_bytes;
+        HIP_CHECK(
+            rocprim::radix_sort_pairs(
+                nullptr, temp_storage_size_bytes,
+                d_keys_iter, d_keys_output_iter, d_values_input, d_values_output_iter, size,
+                0, sizeof(input_type) * 8,
+                stream, debug_synchronous
+            )
+        );
+
+        ASSERT_GT(temp_storage_size_bytes, 0);
+
+        void * d_temp_storage;
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+
+        HIP_CHECK(
+            rocprim::radix_sort_pairs(
+                d_temp_storage, temp_storage_size_bytes,
+                d_keys_iter, d_keys_output_iter, d_values_input, d_values_output_iter, size,
+                0, sizeof(input_type) * 8,
+                stream, debug_synchronous
+            )
+        );
+        HIP_CHECK(hipPeekAtLastError());
+        HIP_CHECK(hipDeviceSynchronize());
+
+        std::vector<value_type> keys_output(size);
+        std::vector<unsigned int> values_output(size);
+        HIP_CHECK(
+            hipMemcpy(
+                keys_output.data(), d_keys_output,
+                size * sizeof(value_type),
+                hipMemcpyDeviceToHost
+            )
+        );
+        HIP_CHECK(
+            hipMemcpy(
+                values_output.data(), d_values_output,
+                size * sizeof(unsigned int),
+                hipMemcpyDeviceToHost
+            )
+        );
+
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_EQ(keys_output[i], static_cast<value_type>(transform(sorted[i].first)));
+            ASSERT_EQ(values_output[i], 2 * sorted[i].second);
+        }
+
+        HIP_CHECK(hipFree(d_keys_input));
+        HIP_CHECK(hipFree(d_keys_output));
+        HIP_CHECK(hipFree(d_values_input));
+        HIP_CHECK(hipFree(d_values_output));
+        HIP_CHECK(hipFree(d_temp_storage));
+    }
+}
@@ -67,6 +67,10 @@ typedef ::testing::Types<
     params<float, 16U>,
     params<float, 32U>,
     params<float, 64U>,
+    // 64-bit types
+    params<double, 16U>,
+    params<double, 64U>,
+    params<long long, 32U>,
     // shared memory reduce
     params<int, 3U>,
     params<int, 7U>,
@@ -74,6 +74,11 @@ typedef ::testing::Types<
     params<float, 32U>,
     params<float, 64U>,
 
+    // 64-bit types
+    params<double, 16U>,
+    params<double, 64U>,
+    params<long long, 32U>,
+
     // shared memory scan
     // Integer
     params<int, 3U>,
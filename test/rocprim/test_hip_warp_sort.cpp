@@ -0,0 +1,463 @@
+// MIT License
+//
+// Copyright (c) 2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Google Test
+#include <gtest/gtest.h>
+// rocPRIM API
+#include <rocprim/rocprim.hpp>
+
+#include "test_utils.hpp"
+
+#define HIP_CHECK(error) ASSERT_EQ(static_cast<hipError_t>(error),hipSuccess)
+
+namespace rp = rocprim;
+
+template<unsigned int WarpSize>
+struct params
+{
+    static constexpr unsigned int warp_size = WarpSize;
+};
+
+template<typename Params>
+class RocprimWarpSortShuffleBasedTests : public ::testing::Test {
+public:
+    static constexpr unsigned int warp_size = Params::warp_size;
+};
+
+typedef ::testing::Types<
+    params<2U>,
+    params<4U>,
+    params<8U>,
+    params<16U>,
+    params<32U>,
+    params<64U>
+> WarpSizes;
+
+TYPED_TEST_CASE(RocprimWarpSortShuffleBasedTests, WarpSizes);
+
+template<unsigned int LogicalWarpSize>
+__global__
+void warp_sort_kernel(int * device_output)
+{
+    const unsigned int index = hipThreadIdx_x + (hipBlockIdx_x * hipBlockDim_x);
+
+    int value = device_output[index];
+    rp::warp_sort<int, LogicalWarpSize> wsort;
+    wsort.sort(value);
+    device_output[index] = value;
+}
+
+TYPED_TEST(RocprimWarpSortShuffleBasedTests, SortInt)
+{
+    // logical warp side for warp primitive, execution warp size is always rp::warp_size()
+    constexpr size_t logical_warp_size = TestFixture::warp_size;
+    constexpr size_t block_size = rp::max<size_t>(rp::warp_size(), 4 * logical_warp_size);
+    const unsigned int grid_size = 4;
+    const size_t size = block_size * grid_size;
+
+    // Given warp size not supported
+    if(logical_warp_size > rp::warp_size() || !rp::detail::is_power_of_two(logical_warp_size))
+    {
+        return;
+    }
+
+    // Generate data
+    std::vector<int> output = test_utils::get_random_data<int>(size, -100, 100);
+
+    // Calculate expected results on host
+    std::vector<int> expected(output);
+    for(size_t i = 0; i < output.size() / logical_warp_size; i++)
+    {
+        std::sort(expected.begin() + (i * logical_warp_size), expected.begin() + ((i + 1) * logical_warp_size));
+    }
+
+    int * device_output;
+    HIP_CHECK(hipMalloc(&device_output, output.size() * sizeof(int)));
+    HIP_CHECK(
+        hipMemcpy(
+            device_output, output.data(),
+            output.size() * sizeof(int),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    // Launching kernel
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(warp_sort_kernel<logical_warp_size>),
+        dim3(grid_size), dim3(block_size), 0, 0,
+        device_output
+    );
+
+    HIP_CHECK(hipPeekAtLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Read from device memory
+    HIP_CHECK(
+        hipMemcpy(
+            output.data(), device_output,
+            output.size() * sizeof(int),
+            hipMemcpyDeviceToHost
+        )
+    );
+
+    for(size_t i = 0; i < output.size(); i++)
+    {
+        EXPECT_EQ(output[i], expected[i]);
+    }
+
+    HIP_CHECK(hipFree(device_output));
+}
+
+template<unsigned int LogicalWarpSize>
+__global__
+void warp_sort_key_value_kernel(int * device_key, int * device_value)
+{
+    const unsigned int index = hipThreadIdx_x + (hipBlockIdx_x * hipBlockDim_x);
+
+    int key = device_key[index];
+    int value = device_value[index];
+    rp::warp_sort<int, LogicalWarpSize, int> wsort;
+    wsort.sort(key, value);
+    device_key[index] = key;
+    device_value[index] = value;
+}
+
+TYPED_TEST(RocprimWarpSortShuffleBasedTests, SortKeyInt)
+{
+    // logical warp side for warp primitive, execution warp size is always rp::warp_size()
+    constexpr size_t logical_warp_size = TestFixture::warp_size;
+    constexpr size_t block_size = rp::max<size_t>(rp::warp_size(), 4 * logical_warp_size);
+    const unsigned int grid_size = 4;
+    const size_t size = block_size * grid_size;
+
+    // Given warp size not supported
+    if(logical_warp_size > rp::warp_size() || !rp::detail::is_power_of_two(logical_warp_size))
+    {
+        return;
+    }
+
+    // Generate data, keys are unique so the order of values is defined
+    std::vector<int> output_key(size);
+    std::iota(output_key.begin(), output_key.end(), 0);
+    std::shuffle(output_key.begin(), output_key.end(), std::mt19937{std::random_device{}()});
+    std::vector<int> output_value = test_utils::get_random_data<int>(size, -100, 100);
+
+    // Combine vectors to form pairs with key and value
+    std::vector<std::pair<int, int>> expected(size);
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+        expected[i] = std::make_pair(output_key[i], output_value[i]);
+    }
+
+    // Calculate expected results on host
+    for(size_t i = 0; i < expected.size() / logical_warp_size; i++)
+    {
+        std::sort(expected.begin() + (i * logical_warp_size), expected.begin() + ((i + 1) * logical_warp_size));
+    }
+
+    int * device_key;
+    int * device_value;
+    HIP_CHECK(hipMalloc(&device_key, output_key.size() * sizeof(int)));
+    HIP_CHECK(hipMalloc(&device_value, output_value.size() * sizeof(int)));
+    HIP_CHECK(
+        hipMemcpy(
+            device_key, output_key.data(),
+            output_key.size() * sizeof(int),
+            hipMemcpyHostToDevice
+        )
+    );
+    HIP_CHECK(
+        hipMemcpy(
+            device_value, output_value.data(),
+            output_value.size() * sizeof(int),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    // Launching kernel
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(warp_sort_key_value_kernel<logical_warp_size>),
+        dim3(grid_size), dim3(block_size), 0, 0,
+        device_key, device_value
+    );
+
+    HIP_CHECK(hipPeekAtLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Read from device memory
+    HIP_CHECK(
+        hipMemcpy(
+            output_key.data(), device_key,
+            output_key.size() * sizeof(int),
+            hipMemcpyDeviceToHost
+        )
+    );
+    HIP_CHECK(
+        hipMemcpy(
+            output_value.data(), device_value,
+            output_value.size() * sizeof(int),
+            hipMemcpyDeviceToHost
+        )
+    );
+
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(output_key[i], expected[i].first);
+        EXPECT_EQ(output_value[i], expected[i].second);
+    }
+
+    HIP_CHECK(hipFree(device_key));
+    HIP_CHECK(hipFree(device_value));
+}
+
+template<unsigned int WarpSize, unsigned int ItemsPerThread>
+struct items_params
+{
+    static constexpr unsigned int warp_size = WarpSize;
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+};
+
+template<typename Params>
+class RocprimWarpSortItemsTests : public ::testing::Test {
+public:
+    static constexpr unsigned int warp_size = Params::warp_size;
+    static constexpr unsigned int items_per_thread = Params::items_per_thread;
+};
+
+typedef ::testing::Types<
+    items_params<2U, 2U>,
+    items_params<4U, 16U>,
+    items_params<8U, 4U>,
+    items_params<16U, 8U>,
+    items_params<32U, 2U>,
+    items_params<64U, 1U>,
+    items_params<64U, 4U>,
+    items_params<64U, 16U>
+> WarpSizesItems;
+
+TYPED_TEST_CASE(RocprimWarpSortItemsTests, WarpSizesItems);
+
+template<unsigned int LogicalWarpSize, unsigned int ItemsPerThread>
+__global__
+void warp_sort_items_kernel(int * device_output)
+{
+    const unsigned int offset = (hipThreadIdx_x + (hipBlockIdx_x * hipBlockDim_x)) * ItemsPerThread;
+
+    int keys[ItemsPerThread];
+    for(unsigned int j = 0; j < ItemsPerThread; j++)
+    {
+        keys[j] = device_output[offset + j];
+    }
+    rp::warp_sort<int, LogicalWarpSize, rp::empty_type, ItemsPerThread> wsort;
+    wsort.sort(keys);
+    for(unsigned int j = 0; j < ItemsPerThread; j++)
+    {
+        device_output[offset + j] = keys[j];
+    }
+}
+
+TYPED_TEST(RocprimWarpSortItemsTests, SortInt)
+{
+    constexpr size_t logical_warp_size = TestFixture::warp_size;
+    constexpr size_t items_per_thread = TestFixture::items_per_thread;
+    constexpr size_t items_per_warp = logical_warp_size * items_per_thread;
+    constexpr size_t block_size = rp::max<size_t>(rp::warp_size(), 4 * logical_warp_size);
+    const unsigned int grid_size = 4;
+    const size_t size = block_size * grid_size;
+
+    // Given warp size not supported
+    if(logical_warp_size > rp::warp_size())
+    {
+        return;
+    }
+
+    // Generate data
+    std::vector<int> output = test_utils::get_random_data<int>(size * items_per_thread, -100, 100);
+
+    // Calculate expected results on host
+    std::vector<int> expected(output);
+    for(size_t i = 0; i < output.size() / items_per_warp; i++)
+    {
+        std::sort(expected.begin() + (i * items_per_warp), expected.begin() + ((i + 1) * items_per_warp));
+    }
+
+    int * device_output;
+    HIP_CHECK(hipMalloc(&device_output, output.size() * sizeof(int)));
+    HIP_CHECK(
+        hipMemcpy(
+            device_output, output.data(),
+            output.size() * sizeof(int),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    // Launching kernel
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(warp_sort_items_kernel<logical_warp_size, items_per_thread>),
+        dim3(grid_size), dim3(block_size), 0, 0,
+        device_output
+    );
+
+    HIP_CHECK(hipPeekAtLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Read from device memory
+    HIP_CHECK(
+        hipMemcpy(
+            output.data(), device_output,
+            output.size() * sizeof(int),
+            hipMemcpyDeviceToHost
+        )
+    );
+
+    for(size_t i = 0; i < output.size(); i++)
+    {
+        EXPECT_EQ(output[i], expected[i]);
+    }
+
+    HIP_CHECK(hipFree(device_output));
+}
+
+template<unsigned int BlockSize, unsigned int LogicalWarpSize, unsigned int ItemsPerThread>
+__global__
+void warp_sort_items_key_value_desc_kernel(int * device_key, int * device_value)
+{
+    constexpr unsigned int warps_no = BlockSize / LogicalWarpSize;
+    const unsigned int warp_id = rp::detail::logical_warp_id<LogicalWarpSize>();
+    const unsigned int offset = (hipThreadIdx_x + (hipBlockIdx_x * hipBlockDim_x)) * ItemsPerThread;
+
+    int keys[ItemsPerThread];
+    int values[ItemsPerThread];
+    for(unsigned int j = 0; j < ItemsPerThread; j++)
+    {
+        keys[j] = device_key[offset + j];
+        values[j] = device_value[offset + j];
+    }
+    using warp_sort_type = rp::warp_sort<int, LogicalWarpSize, int, ItemsPerThread>;
+    __shared__ typename warp_sort_type::storage_type storage[warps_no];
+    warp_sort_type().sort(keys, values, storage[warp_id], rp::greater<int>());
+    for(unsigned int j = 0; j < ItemsPerThread; j++)
+    {
+        device_key[offset + j] = keys[j];
+        device_value[offset + j] = values[j];
+    }
+}
+
+TYPED_TEST(RocprimWarpSortItemsTests, SortKeyIntDescending)
+{
+    constexpr size_t logical_warp_size = TestFixture::warp_size;
+    constexpr size_t items_per_thread = TestFixture::items_per_thread;
+    constexpr size_t items_per_warp = logical_warp_size * items_per_thread;
+    constexpr size_t block_size = rp::max<size_t>(rp::warp_size(), 4 * logical_warp_size);
+    const unsigned int grid_size = 4;
+    const size_t size = block_size * grid_size;
+
+    // Given warp size not supported
+    if(logical_warp_size > rp::warp_size())
+    {
+        return;
+    }
+
+    // Generate data, keys are unique so the order of values is defined
+    std::vector<int> output_key(size * items_per_thread);
+    std::iota(output_key.begin(), output_key.end(), 0);
+    std::shuffle(output_key.begin(), output_key.end(), std::mt19937{std::random_device{}()});
+    std::vector<int> output_value = test_utils::get_random_data<int>(output_key.size(), -100, 100);
+
+    // Combine vectors to form pairs with key and value
+    std::vector<std::pair<int, int>> expected(output_key.size());
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+        expected[i] = std::make_pair(output_key[i], output_value[i]);
+    }
+
+    // Calculate expected results on host
+    for(size_t i = 0; i < expected.size() / items_per_warp; i++)
+    {
+        std::sort(
+            expected.begin() + (i * items_per_warp), expected.begin() + ((i + 1) * items_per_warp),
+            [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; }
+        );
+    }
+
+    int * device_key;
+    int * device_value;
+    HIP_CHECK(hipMalloc(&device_key, output_key.size() * sizeof(int)));
+    HIP_CHECK(hipMalloc(&device_value, output_value.size() * sizeof(int)));
+    HIP_CHECK(
+        hipMemcpy(
+            device_key, output_key.data(),
+            output_key.size() * sizeof(int),
+            hipMemcpyHostToDevice
+        )
+    );
+    HIP_CHECK(
+        hipMemcpy(
+            device_value, output_value.data(),
+            output_value.size() * sizeof(int),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    // Launching kernel
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(warp_sort_items_key_value_desc_kernel<
+            block_size, logical_warp_size, items_per_thread
+        >),
+        dim3(grid_size), dim3(block_size), 0, 0,
+        device_key, device_value
+    );
+
+    HIP_CHECK(hipPeekAtLastError());
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Read from device memory
+    HIP_CHECK(
+        hipMemcpy(
+            output_key.data(), device_key,
+            output_key.size() * sizeof(int),
+            hipMemcpyDeviceToHost
+        )
+    );
+    HIP_CHECK(
+        hipMemcpy(
+            output_value.data(), device_value,
+            output_value.size() * sizeof(int),
+            hipMemcpyDeviceToHost
+        )
+    );
+
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(output_key[i], expected[i].first);
+        EXPECT_EQ(output_value[i], expected[i].second);
+    }
+
+    HIP_CHECK(hipFree(device_key));
+    HIP_CHECK(hipFree(device_value));
+}
@@ -60,7 +60,7 @@ size_t get_max_block_size()
 }
 #endif
 
-#if defined(ROCPRIM_HC_API) || defined(ROCPRIM_HIP_API)
+#if defined(ROCPRIM_HC_API) || defined(ROCPRIM_HIP_API) || defined(ROCPRIM_CPU_API)
 // Custom type used in tests
 template<class T>
 struct custom_test_type
@@ -71,6 +71,9 @@ struct custom_test_type
     ROCPRIM_HOST_DEVICE
     custom_test_type(T xx = 0, T yy = 0) : x(xx), y(yy) {}
 
+    ROCPRIM_HOST_DEVICE
+    custom_test_type(const custom_test_type& other) : x(other.x), y(other.y) {}
+
     ROCPRIM_HOST_DEVICE
     ~custom_test_type() {}
 
@@ -96,6 +99,41 @@ struct custom_test_type
 };
 #endif
 
+#if defined(ROCPRIM_HC_API) || defined(ROCPRIM_HIP_API)
+// Wraps operator Op and counts its calls made on the host (calls on the device
+// are not counted), tests of host fallback use it to check which path was taken
+template<class Op>
+struct host_call_counter
+{
+    Op op;
+    unsigned int * host_calls;
+
+    template<class T>
+    ROCPRIM_HOST_DEVICE
+    auto operator()(const T& a) const -> decltype(op(a))
+    {
+        count_host_call();
+        return op(a);
+    }
+
+    template<class T, class U>
+    ROCPRIM_HOST_DEVICE
+    auto operator()(const T& a, const U& b) const -> decltype(op(a, b))
+    {
+        count_host_call();
+        return op(a, b);
+    }
+
+    ROCPRIM_HOST_DEVICE
+    void count_host_call() const
+    {
+        #if !defined(__HCC_ACCELERATOR__) && !defined(__HIP_DEVICE_COMPILE__)
+        (*host_calls)++;
+        #endif
+    }
+};
+#endif
+
 } // end test_utils namespace
 
 #endif // TEST_TEST_UTILS_HPP_
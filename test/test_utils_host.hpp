@@ -165,6 +165,33 @@ OutputIt host_exclusive_scan_by_key(InputIt first, InputIt last, KeyIt k_first,
     return ++d_first;
 }
 
+template<class InputIt, class T, class BinaryOperation>
+T host_reduce(InputIt first, InputIt last, T initial_value, BinaryOperation op)
+{
+    T sum = initial_value;
+    for(; first != last; first++)
+    {
+        sum = op(sum, *first);
+    }
+    return sum;
+}
+
+// Results of empty segments are initial_value
+template<class InputIt, class OffsetIt, class T, class OutputIt, class BinaryOperation>
+OutputIt host_segmented_reduce(InputIt first, OffsetIt begin_offsets, OffsetIt end_offsets,
+                               size_t segments, T initial_value, OutputIt d_first,
+                               BinaryOperation op)
+{
+    for(size_t segment = 0; segment < segments; segment++)
+    {
+        *d_first++ = host_reduce(
+            first + begin_offsets[segment], first + end_offsets[segment],
+            initial_value, op
+        );
+    }
+    return d_first;
+}
+
 } // end test_utils namespace
 
 #endif // TEST_TEST_UTILS_HOST_HPP_